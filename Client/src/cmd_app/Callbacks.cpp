@@ -101,7 +101,7 @@ void CLI_DC3LogCallback(
 {
    /* Break apart the log msg from DC3 so we can make it look like the rest of
     * the log messages. Its format looks like this:
-    * DBG-01:00:58:069-CommStackMgr_Idle():385:No payload detected
+    * DBG-01:00:58:069123-CommStackMgr_Idle():385:No payload detected
     * */
    string message(msg);
 
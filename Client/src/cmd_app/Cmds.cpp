@@ -13,6 +13,8 @@
 #include <cstring>
 #include <vector>
 #include <iterator>
+#include <fstream>
+#include <algorithm>
 
 /* Boost includes */
 #include <boost/program_options.hpp>
@@ -21,6 +23,7 @@
 #include "Cmds.hpp"
 #include "ArgParse.hpp"
 #include "CliDbgModules.hpp"
+#include "QsTrace.hpp"
 
 /* Namespaces ----------------------------------------------------------------*/
 using namespace std;
@@ -29,7 +32,19 @@ using namespace po;
 
 /* Compile-time called macros ------------------------------------------------*/
 /* Private typedefs ----------------------------------------------------------*/
+
+/**
+ * @brief   Everything get_profile collects about a single Active Object.
+ */
+typedef struct {
+   string   name;                                       /**< Task name of AO */
+   uint32_t stats[DC3_PROF_AO_STATS_LEN];        /**< See DC3ProfAoStat_t */
+   uint32_t hist[DC3_PROF_HIST_BUCKETS];          /**< Dispatch histogram */
+   uint32_t waitHist[DC3_PROF_HIST_BUCKETS];    /**< Queue wait histogram */
+} CmdProfAo_t;
+
 /* Private defines -----------------------------------------------------------*/
+#define CMD_DISCOVER_MAX_BOARDS  254  /**< Max boards discover lists, a /24 */
 /* Private macros ------------------------------------------------------------*/
 CLI_MODULE_NAME( CLI_DBG_MODULE_CMD );
 
@@ -45,8 +60,180 @@ CLI_MODULE_NAME( CLI_DBG_MODULE_CMD );
  */
 static void CMD_dbgModulesToStream( stringstream& ss, uint32_t dbgModules);
 
+/**
+ * @brief   Output the value of a DB element to a human readable stringstream
+ * @param [in|out]: stringstream ref to output to.
+ * @param [in] elem: DC3DBElem_t element the data belongs to.
+ * @param [in] *pData: const uint8_t pointer to the value of the element.
+ * @param [in] dataLen: size_t length of the value of the element.
+ *
+ * @return: None
+ */
+static void CMD_dbElemToStream(
+      stringstream& ss,
+      const DC3DBElem_t elem,
+      const uint8_t* const pData,
+      const size_t dataLen
+);
+
+/**
+ * @brief   Output a profiling histogram to a human readable stringstream
+ * @param [in|out]: stringstream ref to output to.
+ * @param [in] title: const string ref of what the histogram is of.
+ * @param [in] *pHist: const uint32_t pointer to DC3_PROF_HIST_BUCKETS counts.
+ * @param [in] tickHz: const uint32_t ticks per second of the DC3 profiling.
+ *
+ * @return: None
+ */
+static void CMD_profHistToStream(
+      stringstream& ss,
+      const string& title,
+      const uint32_t* const pHist,
+      const uint32_t tickHz
+);
+
+/**
+ * @brief   Convert profiling ticks to microseconds
+ * @param [in] ticks: uint32_t time in ticks.
+ * @param [in] tickHz: uint32_t ticks per second.
+ *
+ * @return: double time in microseconds.
+ */
+static double CMD_profTicksToUs( const uint32_t ticks, const uint32_t tickHz );
+
+/**
+ * @brief   Sort order of profiling signal records, longest dispatch first
+ * @param [in] a: const vector<uint32_t> ref to a DC3ProfSigStat_t record.
+ * @param [in] b: const vector<uint32_t> ref to a DC3ProfSigStat_t record.
+ *
+ * @return: bool true if a goes before b.
+ */
+static bool CMD_profSigByMax(
+      const vector<uint32_t>& a,
+      const vector<uint32_t>& b
+);
+
+/**
+ * @brief   Sort order of discover answers, lowest IP address first
+ * @param [in] a: const DC3DiscoverPayloadMsg ref to an answer.
+ * @param [in] b: const DC3DiscoverPayloadMsg ref to an answer.
+ *
+ * @return: bool true if a goes before b.
+ */
+static bool CMD_discoverByIp(
+      const struct DC3DiscoverPayloadMsg& a,
+      const struct DC3DiscoverPayloadMsg& b
+);
+
 /* Private functions ---------------------------------------------------------*/
 
+/******************************************************************************/
+static double CMD_profTicksToUs( const uint32_t ticks, const uint32_t tickHz )
+{
+   return( 0 == tickHz ? 0.0 : (double)ticks * 1000000.0 / (double)tickHz );
+}
+
+/******************************************************************************/
+static bool CMD_profSigByMax(
+      const vector<uint32_t>& a,
+      const vector<uint32_t>& b
+)
+{
+   return( a[DC3_PROF_SIG_MAX] > b[DC3_PROF_SIG_MAX] );
+}
+
+/******************************************************************************/
+static bool CMD_discoverByIp(
+      const struct DC3DiscoverPayloadMsg& a,
+      const struct DC3DiscoverPayloadMsg& b
+)
+{
+   return( a._ipAddr < b._ipAddr );
+}
+
+/******************************************************************************/
+static void CMD_profHistToStream(
+      stringstream& ss,
+      const string& title,
+      const uint32_t* const pHist,
+      const uint32_t tickHz
+)
+{
+   const size_t maxBar = 40;
+   uint32_t maxCount = 0;
+   for ( size_t i = 0; i < DC3_PROF_HIST_BUCKETS; i++ ) {
+      maxCount = max( maxCount, pHist[i] );
+   }
+   if ( 0 == maxCount ) {
+      return;                                     // Nothing to draw
+   }
+
+   ss << "***    " << title << ":" << endl;
+   for ( size_t i = 0; i < DC3_PROF_HIST_BUCKETS; i++ ) {
+      if ( 0 == pHist[i] ) {
+         continue;
+      }
+
+      // Bucket i holds times under 2^(i + MIN_BITS) ticks (see DC3CommApi.h)
+      const uint32_t upper = ( i + DC3_PROF_HIST_MIN_BITS < 32 ) ?
+            (1UL << (i + DC3_PROF_HIST_MIN_BITS)) : 0xFFFFFFFFUL;
+      ss << "***      ";
+      if ( DC3_PROF_HIST_BUCKETS - 1 == i ) {
+         ss << ">=" << setw(10) << setfill(' ') << fixed << setprecision(1)
+               << CMD_profTicksToUs( upper >> 1, tickHz ) << "us ";
+      } else {
+         ss << " <" << setw(10) << setfill(' ') << fixed << setprecision(1)
+               << CMD_profTicksToUs( upper, tickHz ) << "us ";
+      }
+      ss << setw(10) << pHist[i] << " "
+            << string( (size_t)(((uint64_t)pHist[i] * maxBar + maxCount - 1) / maxCount), '#' )
+            << endl;
+   }
+}
+
+
+/******************************************************************************/
+static void CMD_dbElemToStream(
+      stringstream& ss,
+      const DC3DBElem_t elem,
+      const uint8_t* const pData,
+      const size_t dataLen
+)
+{
+   ss << "*** DB element " << enumToString(elem) << " value = ***" << endl;
+
+   ss << "*** Raw bytes: [ ";
+   for ( unsigned int i = 0; i < dataLen; i++ ) {
+      ss << "0x" << hex << setfill('0') << setw(2) << unsigned(pData[i]) << " ";
+   }
+   ss << " ]" << dec;
+
+   // Some elements can be printed as strings
+   if( elem == _DC3_DB_BOOT_BUILD_DATETIME ||
+       elem == _DC3_DB_APPL_BUILD_DATETIME ||
+       elem == _DC3_DB_FPGA_BUILD_DATETIME ) {
+      ss << " ***" << endl << "*** As string: " << string((const char *)pData, dataLen);
+   } else if ( elem == _DC3_DB_IP_ADDR ) {
+      ss << " ***" << endl << "*** As IP address: [ ";
+      for ( unsigned int i = 0; i < dataLen; i++ ) {
+         ss << unsigned(pData[i]);
+         if ( i < (dataLen - 1) ) {
+            ss << ".";
+         }
+      }
+      ss << " ]" << dec;
+   } else if ( elem == _DC3_DB_MAC_ADDR ) {
+      ss << " ***" << endl << "*** As MAC Address: [ ";
+      for ( unsigned int i = 0; i < dataLen; i++ ) {
+         ss << hex << setfill('0') << setw(2) << unsigned(pData[i]);
+         if ( i < (dataLen - 1) ) {
+            ss << ":";
+         }
+      }
+      ss << " ]" << dec;
+   }
+}
+
 /******************************************************************************/
 static void CMD_dbgModulesToStream( stringstream& ss, uint32_t dbgModules)
 {
@@ -229,6 +416,52 @@ APIError_t CMD_runFlash(
    return( statusAPI );
 }
 
+/******************************************************************************/
+APIError_t CMD_runStageFW(
+      ClientApi* client,
+      DC3Error_t* statusDC3,
+      DC3BootMode_t type,
+      const string& file
+)
+{
+   APIError_t statusAPI = API_ERR_NONE;
+
+   // Only allow Application FW image since that's the only staged slot.
+   if ( _DC3_Application != type ) {
+      ERR_out << "Only " << enumToString(_DC3_Application) << " FW images can be staged.";
+      return( API_ERR_UNIMPLEMENTED );
+   }
+
+   string cmd = "stage"; // This is the name of the command we are running
+
+   stringstream ss;
+   ss << "*** Starting " << cmd << " command to stage "
+         << enumToString(_DC3_Application) << " FW image on the DC3... ***";
+   CON_print(ss.str());
+   ss.str(std::string()); // It's the only way to actually clear the stringstream
+
+   ss << "*** "; // Prepend so start and end of command output are easily visible
+
+   // Execute (and block) on this command
+   if( API_ERR_NONE == (statusAPI = client->DC3_stageFW(statusDC3, type, file.c_str() )) ) {
+      ss << "Finished " << cmd << ". Command ";
+      if (ERR_NONE == *statusDC3) {
+         ss << "completed with no errors. DC3 " << enumToString(type)
+               << " FW image is staged and will be installed on the next reboot.";
+      } else {
+         ss << "FAILED with ERROR: 0x" << setw(8) << setfill('0') << hex << *statusDC3 << dec;
+      }
+   } else {
+      ss << "Unable to complete " << cmd << " cmd to DC3 due to API error: "
+            << "0x" << setw(8) << setfill('0') << hex << statusAPI << dec;
+   }
+
+   ss << " ***"; // Append so start and end of command output are easily visible
+   CON_print(ss.str());                                      // output to screen
+
+   return( statusAPI );
+}
+
 /******************************************************************************/
 APIError_t CMD_runReadI2C(
       ClientApi* client,
@@ -276,6 +509,122 @@ APIError_t CMD_runReadI2C(
    return( statusAPI );
 }
 
+/******************************************************************************/
+APIError_t CMD_runDumpI2C(
+      ClientApi* client,
+      DC3Error_t* statusDC3,
+      const string& filename,
+      const size_t nBytesToRead,
+      const size_t nStart,
+      const DC3I2CDevice_t dev,
+      const DC3AccessType_t  acc
+)
+{
+   APIError_t statusAPI = API_ERR_NONE;
+   string cmd = "dump_i2c"; // This is the name of the command we are running
+
+   stringstream ss;
+   ss << "*** Starting " << cmd << " command to dump an I2C device on DC3 to "
+         << filename << "... ***";
+   CON_print(ss.str());
+   ss.str(std::string()); // It's the only way to actually clear the stringstream
+
+   ss << "*** "; // Prepend so start and end of command output are easily visible
+
+   vector<uint8_t> data( nBytesToRead + 1 );
+   size_t bytesRead = 0;
+
+   // Execute (and block) on this command
+   if( API_ERR_NONE == (statusAPI = client->DC3_readI2CRange( statusDC3,
+         &bytesRead, &data[0], data.size(), nBytesToRead, nStart, dev, acc) )) {
+      ss << "Finished " << cmd << ". Command ";
+      if (ERR_NONE == *statusDC3) {
+         ofstream file( filename.c_str(), ios::out | ios::binary );
+         file.write( (const char *)&data[0], bytesRead );
+         if ( file.good() ) {
+            ss << "completed with no errors. ***" << endl << "*** Wrote "
+                  << bytesRead << " bytes to " << filename;
+         } else {
+            statusAPI = API_ERR_MEM_UNABLE_TO_WRITE_FILE;
+            ss << "FAILED to write " << filename << " with API error: "
+                  << "0x" << setw(8) << setfill('0') << hex << statusAPI << dec;
+         }
+      } else {
+         ss << "FAILED with ERROR: 0x" << setw(8) << setfill('0') << hex << *statusDC3 << dec;
+      }
+   } else {
+      ss << "Unable to complete " << cmd << " cmd to DC3 due to API error: "
+            << "0x" << setw(8) << setfill('0') << hex << statusAPI << dec;
+   }
+
+   ss << " ***"; // Append so start and end of command output are easily visible
+   CON_print(ss.str());                                      // output to screen
+
+   return( statusAPI );
+}
+
+/******************************************************************************/
+APIError_t CMD_runRestoreI2C(
+      ClientApi* client,
+      DC3Error_t* statusDC3,
+      const string& filename,
+      const size_t nStart,
+      const DC3I2CDevice_t dev,
+      const DC3AccessType_t  acc
+)
+{
+   APIError_t statusAPI = API_ERR_NONE;
+   string cmd = "restore_i2c"; // This is the name of the command we are running
+
+   stringstream ss;
+   ss << "*** Starting " << cmd << " command to restore an I2C device on DC3 from "
+         << filename << "... ***";
+   CON_print(ss.str());
+   ss.str(std::string()); // It's the only way to actually clear the stringstream
+
+   ss << "*** "; // Prepend so start and end of command output are easily visible
+
+   ifstream file( filename.c_str(), ios::in | ios::binary );
+   vector<uint8_t> data(
+         (istreambuf_iterator<char>(file)),
+         istreambuf_iterator<char>()
+   );
+   vector<uint8_t> readBack( data.size() + 1 );
+   size_t bytesRead = 0;
+
+   // Write the whole image and then read it back to make sure it took
+   if( data.empty() ) {
+      statusAPI = API_ERR_MEM_BUFFER_LEN;
+      ss << filename << " is empty. API error: "
+            << "0x" << setw(8) << setfill('0') << hex << statusAPI << dec;
+   } else if( API_ERR_NONE == (statusAPI = client->DC3_writeI2CRange( statusDC3,
+         &data[0], data.size(), nStart, dev, acc )) && ERR_NONE == *statusDC3 &&
+         API_ERR_NONE == (statusAPI = client->DC3_readI2CRange( statusDC3,
+         &bytesRead, &readBack[0], readBack.size(), data.size(), nStart, dev, acc )) ) {
+      ss << "Finished " << cmd << " cmd. Command ";
+      if (ERR_NONE != *statusDC3) {
+         ss << "FAILED with ERROR: 0x" << setw(8) << setfill('0') << hex << *statusDC3 << dec;
+      } else if ( bytesRead != data.size() ||
+                  !std::equal( data.begin(), data.end(), readBack.begin() ) ) {
+         ss << "FAILED. Data read back from DC3 doesn't match " << filename;
+      } else {
+         ss << "completed with no errors. ***" << endl << "*** Wrote and verified "
+               << data.size() << " bytes from " << filename;
+      }
+   } else if ( API_ERR_NONE == statusAPI ) {
+      ss << "Finished " << cmd << " cmd. Command ";
+      ss << "FAILED with ERROR: 0x" << setw(8) << setfill('0') << hex << *statusDC3 << dec;
+   } else {
+      ss << "Unable to complete " << cmd << " cmd to DC3 due to API error: "
+            << "0x" << setw(8) << setfill('0') << hex << statusAPI << dec;
+   }
+
+   ss << " ***"; // Append so start and end of command output are easily visible
+   CON_print(ss.str());                                      // output to screen
+
+   return( statusAPI );
+}
+
 /******************************************************************************/
 APIError_t CMD_runWriteI2C(
       ClientApi* client,
@@ -537,39 +886,730 @@ APIError_t CMD_runGetDbElem(
       ss << "Finished " << cmd << ". Command " << endl;
       if (ERR_NONE == *statusDC3) {
          ss << "completed with no errors. ***" << endl;
-         ss << "*** DB element " << enumToString(elem) << " value = ***" << endl;
+         CMD_dbElemToStream( ss, elem, pBuffer, *pBytesInBuffer );
+      } else {
+         ss << "FAILED with ERROR: 0x" << setw(8) << setfill('0') << hex << *statusDC3 << dec;
+      }
 
-         ss << "*** Raw bytes: [ ";
-         for ( unsigned int i = 0; i < *pBytesInBuffer; i++ ) {
-            ss << "0x" << hex << setfill('0') << setw(2) << unsigned(pBuffer[i]) << " ";
+   } else {
+      ss << "Unable to complete " << cmd << " cmd to DC3 due to API error: "
+            << "0x" << setw(8) << setfill('0') << hex << statusAPI << dec;
+
+   }
+
+   ss << " ***"; // Append so start and end of command output are easily visible
+   CON_print(ss.str());                                      // output to screen
+
+   return( statusAPI );
+}
+/******************************************************************************/
+APIError_t CMD_runGetBoardInfo(
+      ClientApi* client,
+      DC3Error_t* statusDC3
+)
+{
+   APIError_t statusAPI = API_ERR_NONE;
+   stringstream ss;
+   string cmd = "get_board_info"; // This is the name of the command we are running
+   ss << "*** Starting "<< cmd << " command to get DC3 board information ***";
+   CON_print(ss.str());
+
+   ss.str(std::string()); // It's the only way to actually clear the stringstream
+
+   ss << "*** "; // Prepend so start and end of command output are easily visible
+
+   // Everything that identifies the board.  All of it comes back in one request.
+   const DC3DBElem_t elems[] = {
+         _DC3_DB_SN,
+         _DC3_DB_MAC_ADDR,
+         _DC3_DB_IP_ADDR,
+         _DC3_DB_BOOT_MAJ,
+         _DC3_DB_BOOT_MIN,
+         _DC3_DB_BOOT_BUILD_DATETIME,
+         _DC3_DB_APPL_MAJ,
+         _DC3_DB_APPL_MIN,
+         _DC3_DB_APPL_BUILD_DATETIME,
+         _DC3_DB_FPGA_MAJ,
+         _DC3_DB_FPGA_MIN,
+         _DC3_DB_FPGA_BUILD_DATETIME,
+   };
+   const size_t nElems = sizeof(elems) / sizeof(elems[0]);
+   size_t elemLens[nElems];
+   uint8_t buffer[DC3_DB_ELEMS_MAX_DATA_LEN];
+   size_t bytesInBuffer = 0;
+
+   // Execute (and block) on this command
+   if( API_ERR_NONE == (statusAPI = client->DC3_getDbElems(statusDC3, elems,
+         nElems, _DC3_ACCESS_QPC, sizeof(buffer), buffer, elemLens, &bytesInBuffer ))) {
+
+      ss << "Finished " << cmd << ". Command " << endl;
+      if (ERR_NONE == *statusDC3) {
+         ss << "completed with no errors. ***" << endl;
+
+         // The elements come back packed in the order they were asked for
+         size_t offset = 0;
+         for ( size_t i = 0; i < nElems && offset + elemLens[i] <= bytesInBuffer; i++ ) {
+            CMD_dbElemToStream( ss, elems[i], &buffer[offset], elemLens[i] );
+            ss << " ***" << endl;
+            offset += elemLens[i];
+         }
+         ss << "*** Read " << nElems << " elements (" << bytesInBuffer << " bytes)";
+      } else {
+         ss << "FAILED with ERROR: 0x" << setw(8) << setfill('0') << hex << *statusDC3 << dec;
+      }
+
+   } else {
+      ss << "Unable to complete " << cmd << " cmd to DC3 due to API error: "
+            << "0x" << setw(8) << setfill('0') << hex << statusAPI << dec;
+
+   }
+
+   ss << " ***"; // Append so start and end of command output are easily visible
+   CON_print(ss.str());                                      // output to screen
+
+   return( statusAPI );
+}
+
+/******************************************************************************/
+APIError_t CMD_runDiscover(
+      ClientApi* client,
+      const uint16_t windowMs
+)
+{
+   APIError_t statusAPI = API_ERR_NONE;
+   stringstream ss;
+   string cmd = "discover";       // This is the name of the command we are running
+   ss << "*** Starting "<< cmd << " command to find the DC3 boards on the subnet ***";
+   CON_print(ss.str());
+
+   ss.str(std::string()); // It's the only way to actually clear the stringstream
+
+   ss << "*** "; // Prepend so start and end of command output are easily visible
+
+   vector<struct DC3DiscoverPayloadMsg> boards( CMD_DISCOVER_MAX_BOARDS );
+   size_t nBoards = 0;
+
+   // Execute (and block) on this command.  Running out of room still returns
+   // the boards that fit so print those.
+   statusAPI = client->DC3_discover( &boards[0], boards.size(), &nBoards, windowMs );
+   if( API_ERR_NONE == statusAPI || API_ERR_MEM_BUFFER_LEN == statusAPI ) {
+      boards.resize( nBoards );
+      sort( boards.begin(), boards.end(), CMD_discoverByIp );
+
+      ss << "Finished " << cmd << ". Command " << endl;
+      ss << "completed with " << nBoards << " boards answering within "
+            << windowMs << " ms ***" << endl;
+
+      ss << "*** " << left << setw(16) << "IP" << setw(18) << "MAC"
+            << setw(12) << "Mode" << setw(33) << "SN" << setw(22) << "Bootloader"
+            << setw(22) << "Application" << setw(22) << "FPGA" << "Status"
+            << right << " ***";
+
+      for ( size_t i = 0; i < nBoards; i++ ) {
+         const struct DC3DiscoverPayloadMsg& b = boards[i];
+         stringstream ip, mac, sn, boot, appl, fpga;
+
+         ip << ( b._ipAddr >> 24 & 0xFF ) << "." << ( b._ipAddr >> 16 & 0xFF )
+               << "." << ( b._ipAddr >> 8 & 0xFF ) << "." << ( b._ipAddr & 0xFF );
+         for ( int j = 0; j < b._mac_len; j++ ) {
+            mac << hex << setfill('0') << setw(2) << unsigned(b._mac[j])
+                  << ( j < b._mac_len - 1 ? ":" : "" );
+         }
+         for ( int j = 0; j < b._sn_len; j++ ) {
+            sn << hex << setfill('0') << setw(2) << unsigned(b._sn[j]);
+         }
+         boot << b._bootMaj << "." << b._bootMin << " "
+               << string((const char *)b._bootBuildDT, b._bootBuildDT_len);
+         appl << b._applMaj << "." << b._applMin << " "
+               << string((const char *)b._applBuildDT, b._applBuildDT_len);
+         fpga << b._fpgaMaj << "." << b._fpgaMin << " "
+               << string((const char *)b._fpgaBuildDT, b._fpgaBuildDT_len);
+
+         ss << endl << "*** " << left << setw(16) << ip.str()
+               << setw(18) << mac.str() << setw(12) << enumToString(b._bootMode)
+               << setw(33) << sn.str() << setw(22) << boot.str()
+               << setw(22) << appl.str() << setw(22) << fpga.str() << right;
+         if ( ERR_NONE == b._errorCode ) {
+            ss << "OK";
+         } else {
+            ss << "0x" << setw(8) << setfill('0') << hex << b._errorCode
+                  << dec << setfill(' ');
+         }
+         ss << " ***";
+      }
+
+      if ( API_ERR_MEM_BUFFER_LEN == statusAPI ) {
+         ss << endl << "*** More than " << CMD_DISCOVER_MAX_BOARDS
+               << " boards answered, the rest are not listed";
+      } else {
+         ss << endl << "*** Found " << nBoards << " boards";
+      }
+   } else {
+      ss << "Unable to complete " << cmd << " cmd to DC3 due to API error: "
+            << "0x" << setw(8) << setfill('0') << hex << statusAPI << dec;
+
+   }
+
+   ss << " ***"; // Append so start and end of command output are easily visible
+   CON_print(ss.str());                                      // output to screen
+
+   return( statusAPI );
+}
+
+/******************************************************************************/
+APIError_t CMD_runGetProfile(
+      ClientApi* client,
+      DC3Error_t* statusDC3,
+      const bool bReset
+)
+{
+   APIError_t statusAPI = API_ERR_NONE;
+   stringstream ss;
+   string cmd = "get_profile";    // This is the name of the command we are running
+   ss << "*** Starting "<< cmd << " command to get the DC3 Active Object profile ***";
+   CON_print(ss.str());
+
+   ss.str(std::string()); // It's the only way to actually clear the stringstream
+
+   ss << "*** "; // Prepend so start and end of command output are easily visible
+
+   vector<CmdProfAo_t> aos;
+   vector<vector<uint32_t> > sigs;
+   uint16_t nRecs  = 0;
+   uint32_t tickHz = 0;
+   char name[MAX_STRING_LEN + 1];
+   uint32_t stats[MAX_REPEATED_LEN];
+   size_t statsLen = 0;
+
+   // One AO summary and both of its histograms at a time.  The DC3 says how many
+   // there are in the first response.
+   *statusDC3 = ERR_NONE;
+   for ( uint16_t i = 0; API_ERR_NONE == statusAPI && ERR_NONE == *statusDC3 &&
+         ( 0 == i || i < nRecs ); i++ ) {
+      CmdProfAo_t ao;
+      memset( ao.stats, 0, sizeof(ao.stats) );
+      memset( ao.hist, 0, sizeof(ao.hist) );
+      memset( ao.waitHist, 0, sizeof(ao.waitHist) );
+
+      statusAPI = client->DC3_getProfRecs( statusDC3, _DC3_PROF_AO, i, false,
+            &nRecs, &tickHz, name, sizeof(name), stats, MAX_REPEATED_LEN, &statsLen );
+      if ( API_ERR_NONE != statusAPI || ERR_NONE != *statusDC3 ) {
+         // No AO ran anything yet is not an error
+         if ( ERR_PROF_INVALID_INDEX == *statusDC3 && 0 == nRecs ) {
+            *statusDC3 = ERR_NONE;
+         }
+         break;
+      }
+      ao.name = name;
+      memcpy( ao.stats, stats, min(statsLen, (size_t)DC3_PROF_AO_STATS_LEN) * sizeof(uint32_t) );
+
+      statusAPI = client->DC3_getProfRecs( statusDC3, _DC3_PROF_AO_HIST, i, false,
+            &nRecs, &tickHz, name, sizeof(name), stats, MAX_REPEATED_LEN, &statsLen );
+      if ( API_ERR_NONE == statusAPI && ERR_NONE == *statusDC3 && statsLen > 1 ) {
+         memcpy( ao.hist, &stats[1], min(statsLen - 1, (size_t)DC3_PROF_HIST_BUCKETS) * sizeof(uint32_t) );
+      }
+
+      statusAPI = client->DC3_getProfRecs( statusDC3, _DC3_PROF_AO_WAIT_HIST, i, false,
+            &nRecs, &tickHz, name, sizeof(name), stats, MAX_REPEATED_LEN, &statsLen );
+      if ( API_ERR_NONE == statusAPI && ERR_NONE == *statusDC3 && statsLen > 1 ) {
+         memcpy( ao.waitHist, &stats[1], min(statsLen - 1, (size_t)DC3_PROF_HIST_BUCKETS) * sizeof(uint32_t) );
+      }
+
+      aos.push_back( ao );
+   }
+
+   // Signals come DC3_PROF_SIGS_PER_MSG at a time
+   nRecs = 0;
+   for ( uint16_t i = 0; API_ERR_NONE == statusAPI && ERR_NONE == *statusDC3 &&
+         ( 0 == i || i < nRecs ); i += DC3_PROF_SIGS_PER_MSG ) {
+      statusAPI = client->DC3_getProfRecs( statusDC3, _DC3_PROF_SIG, i, false,
+            &nRecs, &tickHz, name, sizeof(name), stats, MAX_REPEATED_LEN, &statsLen );
+      if ( API_ERR_NONE != statusAPI || ERR_NONE != *statusDC3 ) {
+         if ( ERR_PROF_INVALID_INDEX == *statusDC3 && 0 == nRecs ) {
+            *statusDC3 = ERR_NONE;
          }
-         ss << " ]" << dec;
-
-         // Some elements can be printed as strings
-         if( elem == _DC3_DB_BOOT_BUILD_DATETIME ||
-             elem == _DC3_DB_APPL_BUILD_DATETIME ||
-             elem == _DC3_DB_FPGA_BUILD_DATETIME ) {
-            ss << " ***" << endl << "*** As string: " << pBuffer;
-         } else if ( elem == _DC3_DB_IP_ADDR ) {
-            ss << " ***" << endl << "*** As IP address: [ ";
-            for ( unsigned int i = 0; i < *pBytesInBuffer; i++ ) {
-               ss << unsigned(pBuffer[i]);
-               if ( i < ((*pBytesInBuffer) - 1) ) {
-                  ss << ".";
+         break;
+      }
+      for ( size_t j = 0; j + DC3_PROF_SIG_STATS_LEN <= statsLen; j += DC3_PROF_SIG_STATS_LEN ) {
+         sigs.push_back( vector<uint32_t>( &stats[j], &stats[j + DC3_PROF_SIG_STATS_LEN] ) );
+      }
+   }
+
+   // Clearing is done with its own request once everything has been read out
+   if ( bReset && API_ERR_NONE == statusAPI && ERR_NONE == *statusDC3 ) {
+      statusAPI = client->DC3_getProfRecs( statusDC3, _DC3_PROF_AO, 0, true,
+            &nRecs, &tickHz, name, sizeof(name), stats, MAX_REPEATED_LEN, &statsLen );
+      if ( ERR_PROF_INVALID_INDEX == *statusDC3 ) {
+         *statusDC3 = ERR_NONE;
+      }
+   }
+
+   if( API_ERR_NONE == statusAPI ) {
+
+      ss << "Finished " << cmd << ". Command " << endl;
+      if (ERR_NONE == *statusDC3) {
+         ss << "completed with no errors. ***" << endl;
+         ss << "*** All times in microseconds (" << tickHz << " ticks/s) ***" << endl;
+
+         ss << "*** " << left << setw(12) << setfill(' ') << "AO" << right
+               << setw(5) << "prio" << setw(10) << "count"
+               << setw(10) << "min" << setw(10) << "avg" << setw(10) << "max"
+               << setw(10) << "waits" << setw(10) << "wait min"
+               << setw(10) << "wait avg" << setw(10) << "wait max"
+               << setw(9) << "untimed" << " ***" << endl;
+         ss << fixed << setprecision(1);
+         for ( vector<CmdProfAo_t>::iterator it = aos.begin(); it != aos.end(); ++it ) {
+            ss << "*** " << left << setw(12) << it->name.substr(0, 11) << right
+                  << setw(5)  << it->stats[DC3_PROF_AO_PRIO]
+                  << setw(10) << it->stats[DC3_PROF_AO_COUNT]
+                  << setw(10) << CMD_profTicksToUs( it->stats[DC3_PROF_AO_MIN], tickHz )
+                  << setw(10) << CMD_profTicksToUs( it->stats[DC3_PROF_AO_AVG], tickHz )
+                  << setw(10) << CMD_profTicksToUs( it->stats[DC3_PROF_AO_MAX], tickHz )
+                  << setw(10) << it->stats[DC3_PROF_AO_WAIT_COUNT]
+                  << setw(10) << CMD_profTicksToUs( it->stats[DC3_PROF_AO_WAIT_MIN], tickHz )
+                  << setw(10) << CMD_profTicksToUs( it->stats[DC3_PROF_AO_WAIT_AVG], tickHz )
+                  << setw(10) << CMD_profTicksToUs( it->stats[DC3_PROF_AO_WAIT_MAX], tickHz )
+                  << setw(9)  << it->stats[DC3_PROF_AO_WAIT_UNTIMED] << " ***" << endl;
+         }
+
+         for ( vector<CmdProfAo_t>::iterator it = aos.begin(); it != aos.end(); ++it ) {
+            CMD_profHistToStream( ss, it->name + " dispatch", it->hist, tickHz );
+            CMD_profHistToStream( ss, it->name + " queue wait", it->waitHist, tickHz );
+         }
+
+         // Worst offenders first
+         sort( sigs.begin(), sigs.end(), CMD_profSigByMax );
+         ss << "*** " << left << setw(12) << "AO" << right
+               << setw(5) << "prio" << setw(6) << "sig" << setw(10) << "count"
+               << setw(10) << "min" << setw(10) << "avg" << setw(10) << "max"
+               << " ***" << endl;
+         for ( vector<vector<uint32_t> >::iterator it = sigs.begin(); it != sigs.end(); ++it ) {
+            string aoName = "";
+            for ( vector<CmdProfAo_t>::iterator ao = aos.begin(); ao != aos.end(); ++ao ) {
+               if ( ao->stats[DC3_PROF_AO_PRIO] == (*it)[DC3_PROF_SIG_PRIO] ) {
+                  aoName = ao->name;
                }
             }
-            ss << " ]" << dec;
-         } else if ( elem == _DC3_DB_MAC_ADDR ) {
-            ss << " ***" << endl << "*** As MAC Address: [ ";
-            for ( unsigned int i = 0; i < *pBytesInBuffer; i++ ) {
-               ss << hex << setfill('0') << setw(2) << unsigned(pBuffer[i]);
-               if ( i < ((*pBytesInBuffer) - 1) ) {
-                  ss << ":";
+            ss << "*** " << left << setw(12) << aoName.substr(0, 11) << right
+                  << setw(5)  << (*it)[DC3_PROF_SIG_PRIO]
+                  << setw(6)  << (*it)[DC3_PROF_SIG_SIG]
+                  << setw(10) << (*it)[DC3_PROF_SIG_COUNT]
+                  << setw(10) << CMD_profTicksToUs( (*it)[DC3_PROF_SIG_MIN], tickHz )
+                  << setw(10) << CMD_profTicksToUs( (*it)[DC3_PROF_SIG_AVG], tickHz )
+                  << setw(10) << CMD_profTicksToUs( (*it)[DC3_PROF_SIG_MAX], tickHz )
+                  << " ***" << endl;
+         }
+         ss << "*** Got " << aos.size() << " AOs and " << sigs.size() << " signals";
+         if ( bReset ) {
+            ss << ". Profile was reset";
+         }
+      } else {
+         ss << "FAILED with ERROR: 0x" << setw(8) << setfill('0') << hex << *statusDC3 << dec;
+      }
+
+   } else {
+      ss << "Unable to complete " << cmd << " cmd to DC3 due to API error: "
+            << "0x" << setw(8) << setfill('0') << hex << statusAPI << dec;
+
+   }
+
+   ss << " ***"; // Append so start and end of command output are easily visible
+   CON_print(ss.str());                                      // output to screen
+
+   return( statusAPI );
+}
+
+/******************************************************************************/
+APIError_t CMD_runGetMemStats(
+      ClientApi* client,
+      DC3Error_t* statusDC3
+)
+{
+   APIError_t statusAPI = API_ERR_NONE;
+   stringstream ss;
+   string cmd = "get_mem_stats";  // This is the name of the command we are running
+   ss << "*** Starting "<< cmd << " command to get the DC3 pool, queue, and stack usage ***";
+   CON_print(ss.str());
+
+   ss.str(std::string()); // It's the only way to actually clear the stringstream
+
+   ss << "*** "; // Prepend so start and end of command output are easily visible
+
+   vector<DC3MemStatsKind_t> kinds;
+   vector<string> names;
+   vector<vector<uint32_t> > recs;
+   uint16_t nRecs = 0;
+   DC3MemStatsKind_t kind = _DC3_MEM_STATS_MAX;
+   char name[MAX_STRING_LEN + 1];
+   uint32_t stats[MAX_REPEATED_LEN];
+   size_t statsLen = 0;
+
+   // One pool or queue at a time.  The DC3 says how many there are in the first
+   // response.
+   *statusDC3 = ERR_NONE;
+   for ( uint16_t i = 0; API_ERR_NONE == statusAPI && ERR_NONE == *statusDC3 &&
+         ( 0 == i || i < nRecs ); i++ ) {
+      statusAPI = client->DC3_getMemStats( statusDC3, i, &nRecs, &kind,
+            name, sizeof(name), stats, MAX_REPEATED_LEN, &statsLen );
+      if ( API_ERR_NONE != statusAPI || ERR_NONE != *statusDC3 ) {
+         break;
+      }
+      vector<uint32_t> rec( DC3_MEM_STATS_LEN, 0 );
+      for ( size_t j = 0; j < statsLen && j < DC3_MEM_STATS_LEN; j++ ) {
+         rec[j] = stats[j];
+      }
+      kinds.push_back( kind );
+      names.push_back( name );
+      recs.push_back( rec );
+   }
+
+   if( API_ERR_NONE == statusAPI ) {
+
+      ss << "Finished " << cmd << ". Command " << endl;
+      if (ERR_NONE == *statusDC3) {
+         ss << "completed with no errors. ***" << endl;
+
+         ss << "*** " << left << setw(10) << setfill(' ') << "kind"
+               << setw(16) << "name" << right
+               << setw(6) << "blk" << setw(8) << "total"
+               << setw(8) << "free" << setw(9) << "min free"
+               << setw(7) << "peak%" << setw(10) << "gets"
+               << setw(8) << "fails" << " ***" << endl;
+         for ( size_t i = 0; i < recs.size(); i++ ) {
+            const vector<uint32_t>& rec = recs[i];
+            stringstream label;
+            string kindStr;
+            switch( kinds[i] ) {
+               case _DC3_MEM_STATS_EVT_POOL:
+                  kindStr = "evt pool";
+                  label << "Event pool " << rec[DC3_MEM_STAT_ID];
+                  break;
+               case _DC3_MEM_STATS_MEM_POOL:
+                  kindStr = "mem pool";
+                  break;
+               case _DC3_MEM_STATS_AO_QUEUE:
+                  kindStr = "AO queue";
+                  label << "prio " << rec[DC3_MEM_STAT_ID];
+                  break;
+               case _DC3_MEM_STATS_EVT_QUEUE:
+                  kindStr = "evt queue";
+                  break;
+               case _DC3_MEM_STATS_TASK_STACK:
+                  kindStr = "task stk";
+                  label << "prio " << rec[DC3_MEM_STAT_ID];
+                  break;
+               case _DC3_MEM_STATS_MAIN_STACK:
+                  kindStr = "main stk";
+                  break;
+               default:
+                  kindStr = "unknown";
+                  break;
+            }
+            if ( !names[i].empty() ) {
+               label.str( names[i] );
+            }
+
+            const uint32_t total = rec[DC3_MEM_STAT_TOTAL];
+            const uint32_t peak  = total - min( total, rec[DC3_MEM_STAT_MIN_FREE] );
+            const bool bIsPool   = ( _DC3_MEM_STATS_EVT_POOL == kinds[i] ||
+                  _DC3_MEM_STATS_MEM_POOL == kinds[i] );
+
+            ss << "*** " << left << setw(10) << kindStr
+                  << setw(16) << label.str().substr(0, 15) << right;
+            if ( bIsPool ) {
+               ss << setw(6) << rec[DC3_MEM_STAT_BLK_SIZE];
+            } else {
+               ss << setw(6) << "-";
+            }
+            ss << setw(8) << total
+                  << setw(8) << rec[DC3_MEM_STAT_FREE]
+                  << setw(9) << rec[DC3_MEM_STAT_MIN_FREE]
+                  << setw(7) << ( 0 == total ? 0 : peak * 100 / total );
+            if ( bIsPool ) {
+               ss << setw(10) << rec[DC3_MEM_STAT_GETS]
+                     << setw(8) << rec[DC3_MEM_STAT_GET_FAILS];
+            } else {
+               ss << setw(10) << "-" << setw(8) << "-";
+            }
+            ss << " ***" << endl;
+         }
+         ss << "*** Got " << recs.size() << " pools, queues, and stacks";
+      } else {
+         ss << "FAILED with ERROR: 0x" << setw(8) << setfill('0') << hex << *statusDC3 << dec;
+      }
+
+   } else {
+      ss << "Unable to complete " << cmd << " cmd to DC3 due to API error: "
+            << "0x" << setw(8) << setfill('0') << hex << statusAPI << dec;
+
+   }
+
+   ss << " ***"; // Append so start and end of command output are easily visible
+   CON_print(ss.str());                                      // output to screen
+
+   return( statusAPI );
+}
+
+/******************************************************************************/
+APIError_t CMD_runHealthTop(
+      ClientApi* client,
+      DC3Error_t* statusDC3,
+      const uint32_t intervalMs,
+      const uint32_t count
+)
+{
+   APIError_t statusAPI = API_ERR_NONE;
+   stringstream ss;
+   string cmd = "health_top";  // This is the name of the command we are running
+   ss << "*** Starting "<< cmd << " command to watch the DC3 health stream ***";
+   CON_print(ss.str());
+
+   ss.str(std::string()); // It's the only way to actually clear the stringstream
+
+   ss << "*** "; // Prepend so start and end of command output are easily visible
+
+   // The names of the pools and queues don't change so they are only read once
+   // instead of being sent with every pushed msg.
+   vector<string> names;
+   uint16_t nRecs = 0;
+   DC3MemStatsKind_t kind = _DC3_MEM_STATS_MAX;
+   char name[MAX_STRING_LEN + 1];
+   uint32_t stats[MAX_REPEATED_LEN];
+   size_t statsLen = 0;
+
+   *statusDC3 = ERR_NONE;
+   for ( uint16_t i = 0; 0 != intervalMs && API_ERR_NONE == statusAPI &&
+         ERR_NONE == *statusDC3 && ( 0 == i || i < nRecs ) &&
+         i < DC3_HEALTH_MAX_MEM_RECS; i++ ) {
+      statusAPI = client->DC3_getMemStats( statusDC3, i, &nRecs, &kind,
+            name, sizeof(name), stats, MAX_REPEATED_LEN, &statsLen );
+      if ( API_ERR_NONE != statusAPI || ERR_NONE != *statusDC3 ) {
+         break;
+      }
+      // Stacks come after the pools and queues and aren't in the stream
+      if ( _DC3_MEM_STATS_TASK_STACK == kind ||
+           _DC3_MEM_STATS_MAIN_STACK == kind ) {
+         break;
+      }
+      stringstream label;
+      if ( 0 != name[0] ) {
+         label << name;
+      } else if ( _DC3_MEM_STATS_EVT_POOL == kind ) {
+         label << "Event pool " << stats[DC3_MEM_STAT_ID];
+      } else if ( _DC3_MEM_STATS_AO_QUEUE == kind ) {
+         label << "prio " << stats[DC3_MEM_STAT_ID];
+      } else {
+         label << "#" << i;
+      }
+      names.push_back( label.str() );
+   }
+
+   if ( API_ERR_NONE == statusAPI && ERR_NONE == *statusDC3 ) {
+      statusAPI = client->DC3_subscribeHealth( statusDC3, intervalMs, 0 );
+   }
+
+   if ( API_ERR_NONE != statusAPI || ERR_NONE != *statusDC3 || 0 == intervalMs ) {
+      if( API_ERR_NONE == statusAPI ) {
+         ss << "Finished " << cmd << ". Command " << endl;
+         if (ERR_NONE == *statusDC3) {
+            ss << "completed with no errors. Health stream stopped.";
+         } else {
+            ss << "FAILED with ERROR: 0x" << setw(8) << setfill('0') << hex << *statusDC3 << dec;
+         }
+      } else {
+         ss << "Unable to complete " << cmd << " cmd to DC3 due to API error: "
+               << "0x" << setw(8) << setfill('0') << hex << statusAPI << dec;
+      }
+      ss << " ***"; // Append so start and end of command output are easily visible
+      CON_print(ss.str());                                   // output to screen
+      return( statusAPI );
+   }
+
+   // Give the DC3 a couple of intervals before deciding the stream is gone
+   const uint16_t timeoutSecs = (uint16_t)( 2 * intervalMs / 1000 + 2 );
+   uint32_t seq = 0;
+   uint32_t seqLast = 0;
+   uint32_t uptimeMs = 0;
+   uint32_t nLost = 0;
+   uint32_t nGot = 0;
+
+   while ( 0 == count || nGot < count ) {
+      statusAPI = client->DC3_waitForHealth( &seq, &uptimeMs, stats,
+            MAX_REPEATED_LEN, &statsLen, timeoutSecs );
+      if ( API_ERR_NONE != statusAPI ) {
+         break;
+      }
+      if ( statsLen < DC3_HEALTH_HDR_LEN ) {
+         continue;
+      }
+      if ( 0 != nGot && seq > seqLast + 1 ) {
+         nLost += seq - seqLast - 1;
+      }
+      seqLast = seq;
+      nGot++;
+
+      stringstream top;
+      top << "*** seq " << seq << " (" << nLost << " lost)  up "
+            << uptimeMs / 1000 << "." << setw(3) << setfill('0')
+            << uptimeMs % 1000 << setfill(' ') << " s  CPU ";
+      if ( DC3_HEALTH_STAT_NA == stats[DC3_HEALTH_CPU_LOAD] ) {
+         top << "n/a";
+      } else {
+         top << stats[DC3_HEALTH_CPU_LOAD] / 100 << "." << setw(2)
+               << setfill('0') << stats[DC3_HEALTH_CPU_LOAD] % 100
+               << setfill(' ') << "%";
+      }
+      top << " ***" << endl;
+
+      top << "*** I2C errs/recoveries " << stats[DC3_HEALTH_I2C_ERRS] << "/"
+            << stats[DC3_HEALTH_I2C_RECOVERIES]
+            << "  serial rx/tx drops " << stats[DC3_HEALTH_SER_RX_DROPS] << "/"
+            << stats[DC3_HEALTH_SER_TX_DROPS] << " ***" << endl;
+
+      top << "*** eth rx/tx/drops " << stats[DC3_HEALTH_ETH_RX] << "/"
+            << stats[DC3_HEALTH_ETH_TX] << "/" << stats[DC3_HEALTH_ETH_DROPS]
+            << "  ip/udp/tcp drops " << stats[DC3_HEALTH_IP_DROPS] << "/"
+            << stats[DC3_HEALTH_UDP_DROPS] << "/" << stats[DC3_HEALTH_TCP_DROPS]
+            << "  lwip mem errs " << stats[DC3_HEALTH_LWIP_MEM_ERRS]
+            << " ***" << endl;
+
+      top << "*** udp sessions " << stats[DC3_HEALTH_ETH_SESSIONS]
+            << "  session drops " << stats[DC3_HEALTH_ETH_SESSION_DROPS]
+            << " ***" << endl;
+
+      top << "*** " << left << setw(20) << "pool/queue" << right
+            << setw(8) << "free" << setw(9) << "min free" << " ***";
+      for ( size_t i = DC3_HEALTH_HDR_LEN; i < statsLen; i++ ) {
+         const size_t iRec = i - DC3_HEALTH_HDR_LEN;
+         top << endl << "*** " << left << setw(20)
+               << ( iRec < names.size() ? names[iRec].substr(0, 19) : "?" )
+               << right << setw(8) << DC3_HEALTH_MEM_FREE( stats[i] )
+               << setw(9) << DC3_HEALTH_MEM_MIN_FREE( stats[i] ) << " ***";
+      }
+      CON_print(top.str());                                  // output to screen
+   }
+
+   // Don't leave the DC3 pushing to a port nobody is listening on
+   DC3Error_t statusStop = ERR_NONE;
+   APIError_t statusAPIStop = client->DC3_subscribeHealth( &statusStop, 0, 0 );
+
+   if ( API_ERR_TIMEOUT_WAITING_FOR_RESP == statusAPI && 0 == count ) {
+      statusAPI = API_ERR_NONE;   // Running until the stream stops is expected
+   }
+   if ( API_ERR_NONE == statusAPI ) {
+      statusAPI = statusAPIStop;
+      *statusDC3 = statusStop;
+   }
+
+   if( API_ERR_NONE == statusAPI ) {
+
+      ss << "Finished " << cmd << ". Command " << endl;
+      if (ERR_NONE == *statusDC3) {
+         ss << "completed with no errors. ***" << endl;
+         ss << "*** Got " << nGot << " health msgs, " << nLost << " lost";
+      } else {
+         ss << "FAILED with ERROR: 0x" << setw(8) << setfill('0') << hex << *statusDC3 << dec;
+      }
+
+   } else {
+      ss << "Unable to complete " << cmd << " cmd to DC3 due to API error: "
+            << "0x" << setw(8) << setfill('0') << hex << statusAPI << dec;
+
+   }
+
+   ss << " ***"; // Append so start and end of command output are easily visible
+   CON_print(ss.str());                                      // output to screen
+
+   return( statusAPI );
+}
+
+/******************************************************************************/
+APIError_t CMD_runGetCpuLoad(
+      ClientApi* client,
+      DC3Error_t* statusDC3,
+      const bool bReset
+)
+{
+   APIError_t statusAPI = API_ERR_NONE;
+   stringstream ss;
+   string cmd = "get_cpu_load";   // This is the name of the command we are running
+   ss << "*** Starting "<< cmd << " command to get the DC3 CPU load ***";
+   CON_print(ss.str());
+
+   ss.str(std::string()); // It's the only way to actually clear the stringstream
+
+   ss << "*** "; // Prepend so start and end of command output are easily visible
+
+   vector<string> names;
+   vector<vector<uint32_t> > recs;
+   uint16_t nRecs  = 0;
+   uint32_t tickHz = 0;
+   char name[MAX_STRING_LEN + 1];
+   uint32_t stats[MAX_REPEATED_LEN];
+   size_t statsLen = 0;
+
+   // One priority at a time.  The DC3 says how many there are in the first
+   // response.
+   *statusDC3 = ERR_NONE;
+   for ( uint16_t i = 0; API_ERR_NONE == statusAPI && ERR_NONE == *statusDC3 &&
+         ( 0 == i || i < nRecs ); i++ ) {
+      statusAPI = client->DC3_getProfRecs( statusDC3, _DC3_PROF_CPU, i, false,
+            &nRecs, &tickHz, name, sizeof(name), stats, MAX_REPEATED_LEN, &statsLen );
+      if ( API_ERR_NONE != statusAPI || ERR_NONE != *statusDC3 ) {
+         break;
+      }
+      vector<uint32_t> rec( DC3_PROF_CPU_STATS_LEN, DC3_HEALTH_STAT_NA );
+      for ( size_t j = 0; j < statsLen && j < DC3_PROF_CPU_STATS_LEN; j++ ) {
+         rec[j] = stats[j];
+      }
+      names.push_back( name );
+      recs.push_back( rec );
+   }
+
+   // Clearing is done with its own request once everything has been read out
+   if ( bReset && API_ERR_NONE == statusAPI && ERR_NONE == *statusDC3 ) {
+      statusAPI = client->DC3_getProfRecs( statusDC3, _DC3_PROF_CPU, 0, true,
+            &nRecs, &tickHz, name, sizeof(name), stats, MAX_REPEATED_LEN, &statsLen );
+   }
+
+   if( API_ERR_NONE == statusAPI ) {
+
+      ss << "Finished " << cmd << ". Command " << endl;
+      if (ERR_NONE == *statusDC3) {
+         ss << "completed with no errors. ***" << endl;
+
+         ss << "*** " << left << setw(12) << setfill(' ') << "task" << right
+               << setw(5) << "prio" << setw(9) << "1 s %"
+               << setw(9) << "10 s %" << setw(9) << "peak %" << " ***" << endl;
+         for ( size_t i = 0; i < recs.size(); i++ ) {
+            ss << "*** " << left << setw(12) << names[i].substr(0, 11) << right
+                  << setw(5) << recs[i][DC3_PROF_CPU_PRIO];
+            for ( int j = DC3_PROF_CPU_LOAD_1S; j <= DC3_PROF_CPU_LOAD_PEAK; j++ ) {
+               if ( DC3_HEALTH_STAT_NA == recs[i][j] ) {
+                  ss << setw(9) << "n/a";
+               } else {
+                  ss << setw(6) << recs[i][j] / 100 << "." << setw(2)
+                        << setfill('0') << recs[i][j] % 100 << setfill(' ');
                }
             }
-            ss << " ]" << dec;
+            ss << " ***" << endl;
          }
 
+         // Idle is priority 0 and comes first.  Everything else is load.
+         if ( !recs.empty() && 0 == recs[0][DC3_PROF_CPU_PRIO] &&
+              DC3_HEALTH_STAT_NA != recs[0][DC3_PROF_CPU_LOAD_1S] ) {
+            const uint32_t total1s  = 10000 - recs[0][DC3_PROF_CPU_LOAD_1S];
+            const uint32_t total10s = 10000 - recs[0][DC3_PROF_CPU_LOAD_10S];
+            ss << "*** Total load " << total1s / 100 << "." << setw(2)
+                  << setfill('0') << total1s % 100 << "% over 1 s, "
+                  << total10s / 100 << "." << setw(2) << total10s % 100
+                  << setfill(' ') << "% over 10 s. Peak is the second the CPLR "
+                  << "task was busiest ***" << endl;
+         }
+         ss << "*** Got " << recs.size() << " task priorities";
+         if ( bReset ) {
+            ss << ". Peak was reset";
+         }
       } else {
          ss << "FAILED with ERROR: 0x" << setw(8) << setfill('0') << hex << *statusDC3 << dec;
       }
@@ -585,6 +1625,68 @@ APIError_t CMD_runGetDbElem(
 
    return( statusAPI );
 }
+
+/******************************************************************************/
+APIError_t CMD_runQsTrace(
+      const string& ipAddress,
+      const string& filename,
+      const uint32_t secs,
+      const string& dictFilename
+)
+{
+   APIError_t statusAPI = API_ERR_NONE;
+   stringstream ss;
+   string cmd = "qs_trace";     // This is the name of the command we are running
+   ss << "*** Starting "<< cmd << " command to capture the DC3 QS trace ***";
+   CON_print(ss.str());
+
+   ss.str(std::string()); // It's the only way to actually clear the stringstream
+
+   ss << "*** "; // Prepend so start and end of command output are easily visible
+
+   size_t bytes = 0;
+   if ( 0 != secs ) {
+      statusAPI = QS_TRACE_capture( ipAddress, filename, secs, &bytes );
+   }
+
+   QsTraceStats_t stats;
+   const string timelineFilename = filename + ".timeline.txt";
+   stringstream summary;
+   if ( API_ERR_NONE == statusAPI ) {
+      ofstream timeline( timelineFilename.c_str(), ios::out );
+      if ( !timeline.good() ) {
+         statusAPI = API_ERR_MEM_UNABLE_TO_WRITE_FILE;
+      } else {
+         statusAPI = QS_TRACE_convert( filename, dictFilename, timeline,
+               summary, &stats );
+      }
+   }
+
+   if( API_ERR_NONE == statusAPI ) {
+      ss << "Finished " << cmd << ". Command completed with no errors. ***"
+            << endl;
+      if ( 0 != secs ) {
+         ss << "*** Captured " << bytes << " bytes in " << secs << " s to "
+               << filename << " ***" << endl;
+      }
+      ss << summary.str();
+      ss << "*** " << stats.nRecs << " records, " << stats.nBadRecs << " bad, "
+            << stats.nLostRecs << " lost. " << stats.nSteps
+            << " steps written to " << timelineFilename;
+      if ( 0 == stats.nSteps ) {
+         ss << ". No steps: is the Application built with CONF=spy?";
+      }
+   } else {
+      ss << "Unable to complete " << cmd << " cmd due to API error: "
+            << "0x" << setw(8) << setfill('0') << hex << statusAPI << dec;
+   }
+
+   ss << " ***"; // Append so start and end of command output are easily visible
+   CON_print(ss.str());                                      // output to screen
+
+   return( statusAPI );
+}
+
 /* Private class prototypes --------------------------------------------------*/
 /* Private classes -----------------------------------------------------------*/
 
@@ -104,6 +104,27 @@ APIError_t CMD_runFlash(
       const string& file
 );
 
+/**
+ * @brief   Wrapper around the UI for stage command
+ *
+ * @param [in] *client: ClientApi pointer to the API object to provide access to
+ * the DC3
+ * @param [out] *statusDC3: DC3Error_t status returned from DC3.
+ *    @arg  ERR_NONE: success.
+ *    other error codes if failure.
+ * @param [in] type: DC3BootMode_t type of fw image
+ * @param [in] file: string that contains a verified path to the FW image file.
+ * @return  ApiError_t:
+ *    @arg API_ERR_NONE: if no error occurred
+ *    @arg API_ERR_XXXX: other error codes indicating the error that occurred.
+ */
+APIError_t CMD_runStageFW(
+      ClientApi* client,
+      DC3Error_t* statusDC3,
+      DC3BootMode_t type,
+      const string& file
+);
+
 /**
  * @brief   Wrapper around the UI for read_i2c command
  *
@@ -146,6 +167,66 @@ APIError_t CMD_runReadI2C(
       const DC3AccessType_t  acc
 );
 
+/**
+ * @brief   Wrapper around the UI for dump_i2c command
+ *
+ * @param [in] *client: ClientApi pointer to the API object to provide access
+ * to the DC3
+ * @param [out] *statusDC3: DC3Error_t status returned from DC3.
+ *    @arg  ERR_NONE: success.
+ *    other error codes if failure.
+ * @param [in] &filename: const string reference to the file where to write the
+ * data read from the device.
+ * @param [in] nBytesToRead: number of bytes to read
+ * @param [in] nStart: where to start reading from
+ * @param [in] dev: DC3I2CDevice_t type that specifies the I2C device to read
+ * @param [in] acc: DC3AccessType_t  type that specifies the access to use to get
+ * at the I2C bus.
+ *
+ * @return: APIError_t status of the client executing the command.
+ *    @arg  API_ERR_NONE: success
+ *    other error codes if failures.
+ */
+APIError_t CMD_runDumpI2C(
+      ClientApi* client,
+      DC3Error_t* statusDC3,
+      const string& filename,
+      const size_t nBytesToRead,
+      const size_t nStart,
+      const DC3I2CDevice_t dev,
+      const DC3AccessType_t  acc
+);
+
+/**
+ * @brief   Wrapper around the UI for restore_i2c command
+ *
+ * Writes the whole file to the device and reads it back to verify it.
+ *
+ * @param [in] *client: ClientApi pointer to the API object to provide access
+ * to the DC3
+ * @param [out] *statusDC3: DC3Error_t status returned from DC3.
+ *    @arg  ERR_NONE: success.
+ *    other error codes if failure.
+ * @param [in] &filename: const string reference to the file with the data to
+ * write to the device.
+ * @param [in] nStart: where to start writing to
+ * @param [in] dev: DC3I2CDevice_t type that specifies the I2C device to write
+ * @param [in] acc: DC3AccessType_t  type that specifies the access to use to get
+ * at the I2C bus.
+ *
+ * @return: APIError_t status of the client executing the command.
+ *    @arg  API_ERR_NONE: success
+ *    other error codes if failures.
+ */
+APIError_t CMD_runRestoreI2C(
+      ClientApi* client,
+      DC3Error_t* statusDC3,
+      const string& filename,
+      const size_t nStart,
+      const DC3I2CDevice_t dev,
+      const DC3AccessType_t  acc
+);
+
 /**
  * @brief   Wrapper around the UI for write_i2c command
  *
@@ -348,6 +429,165 @@ APIError_t CMD_runGetDbElem(
       uint8_t* const pBuffer,
       size_t* pBytesInBuffer
 );
+
+/**
+ * @brief   Wrapper around the UI for get_board_info command.
+ *
+ * Gets the serial number, addresses, and all the FW versions of the DC3 with a
+ * single multi-element DB request.
+ *
+ * @param [in] *client: ClientApi pointer to the API object to provide access
+ * to the DC3
+ * @param [out] *statusDC3: DC3Error_t status returned from DC3.
+ *    @arg  ERR_NONE: success.
+ *    other error codes if failure.
+ * @return: APIError_t status of the client executing the command.
+ *    @arg  API_ERR_NONE: success
+ *    other error codes if failure.
+ */
+APIError_t CMD_runGetBoardInfo(
+      ClientApi* client,
+      DC3Error_t* statusDC3
+);
+
+/**
+ * @brief   Wrapper around the UI for discover command.
+ *
+ * Sends a single discover request and prints every DC3 that answered within
+ * the window as a table: IP and MAC addresses, boot mode, serial number, and
+ * the versions of all the FW images.  Connect to the broadcast address of the
+ * subnet to find every DC3 on it with one request.
+ *
+ * @param [in] *client: ClientApi pointer to the API object to provide access
+ * to the DC3(s)
+ * @param [in] windowMs: const uint16_t how long to collect answers for.
+ * @return: APIError_t status of the client executing the command.
+ *    @arg  API_ERR_NONE: success, even if no DC3 answered.
+ *    other error codes if failure.
+ */
+APIError_t CMD_runDiscover(
+      ClientApi* client,
+      const uint16_t windowMs
+);
+
+/**
+ * @brief   Wrapper around the UI for get_profile command.
+ *
+ * Gets the dispatch and queue wait times of every Active Object, their
+ * histograms, and the dispatch times of every signal of every AO, and prints
+ * them as tables.  Signals are sorted by their longest dispatch.
+ *
+ * @param [in] *client: ClientApi pointer to the API object to provide access
+ * to the DC3
+ * @param [out] *statusDC3: DC3Error_t status returned from DC3.
+ *    @arg  ERR_NONE: success.
+ *    other error codes if failure.
+ * @param [in] bReset: const bool whether to clear the profile on the DC3 once
+ * it's been read out.
+ * @return: APIError_t status of the client executing the command.
+ *    @arg  API_ERR_NONE: success
+ *    other error codes if failure.
+ */
+APIError_t CMD_runGetProfile(
+      ClientApi* client,
+      DC3Error_t* statusDC3,
+      const bool bReset
+);
+
+/**
+ * @brief   Wrapper around the UI for get_mem_stats command.
+ *
+ * Gets the usage of every event pool, memory pool, event queue, and stack on
+ * the DC3 and prints them as a table.
+ *
+ * @param [in] *client: ClientApi pointer to the API object to provide access
+ * to the DC3
+ * @param [out] *statusDC3: DC3Error_t status returned from DC3.
+ *    @arg  ERR_NONE: success.
+ *    other error codes if failure.
+ * @return: APIError_t status of the client executing the command.
+ *    @arg  API_ERR_NONE: success
+ *    other error codes if failure.
+ */
+APIError_t CMD_runGetMemStats(
+      ClientApi* client,
+      DC3Error_t* statusDC3
+);
+
+/**
+ * @brief   Wrapper around the UI for health_top command.
+ *
+ * Starts the health stream of the DC3 and prints every msg pushed by it until
+ * enough of them came in or they stop coming.  Stops the stream before
+ * returning.
+ *
+ * @param [in] *client: ClientApi pointer to the API object to provide access
+ * to the DC3
+ * @param [out] *statusDC3: DC3Error_t status returned from DC3.
+ *    @arg  ERR_NONE: success.
+ *    other error codes if failure.
+ * @param [in] intervalMs: const uint32_t time between pushed msgs in ms.  0
+ * only stops a stream that's still running.
+ * @param [in] count: const uint32_t number of msgs to print.  0 to keep going
+ * until they stop coming.
+ * @return: APIError_t status of the client executing the command.
+ *    @arg  API_ERR_NONE: success
+ *    other error codes if failure.
+ */
+APIError_t CMD_runHealthTop(
+      ClientApi* client,
+      DC3Error_t* statusDC3,
+      const uint32_t intervalMs,
+      const uint32_t count
+);
+
+/**
+ * @brief   Wrapper around the UI for get_cpu_load command.
+ *
+ * Gets the CPU load of every FreeRTOS task priority on the DC3 and prints them
+ * as a table along with the total.
+ *
+ * @param [in] *client: ClientApi pointer to the API object to provide access
+ * to the DC3
+ * @param [out] *statusDC3: DC3Error_t status returned from DC3.
+ *    @arg  ERR_NONE: success.
+ *    other error codes if failure.
+ * @param [in] bReset: const bool that specifies whether to forget the peak
+ * once it's been read out.
+ * @return: APIError_t status of the client executing the command.
+ *    @arg  API_ERR_NONE: success
+ *    other error codes if failure.
+ */
+APIError_t CMD_runGetCpuLoad(
+      ClientApi* client,
+      DC3Error_t* statusDC3,
+      const bool bReset
+);
+
+/**
+ * @brief   Wrapper around the UI for qs_trace command.
+ *
+ * Captures the QS software trace the DC3 streams over UDP into a file and then
+ * converts it into a timeline of every state machine step (written next to the
+ * capture) and a summary of the queue wait and run times of every AO (printed).
+ * Doesn't go through the ClientApi connection since the trace has its own port.
+ *
+ * @param [in] ipAddress: const string& IP address of the DC3.
+ * @param [in] filename: const string& name of the file for the raw stream.
+ * @param [in] secs: const uint32_t how long to capture for.  0 only converts a
+ * capture that's already in the file.
+ * @param [in] dictFilename: const string& name of an earlier capture to take
+ * the AO and state names from.  Empty if none.
+ * @return: APIError_t status of the client executing the command.
+ *    @arg  API_ERR_NONE: success
+ *    other error codes if failure.
+ */
+APIError_t CMD_runQsTrace(
+      const string& ipAddress,
+      const string& filename,
+      const uint32_t secs,
+      const string& dictFilename
+);
 /* Exported classes ----------------------------------------------------------*/
 
 
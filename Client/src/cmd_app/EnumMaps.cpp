@@ -158,6 +158,7 @@ template<> std::map<ApiDbgModuleId_t, std::string> enumStrings<ApiDbgModuleId_t>
       { MODULE_COM     , "Com"   },
       { MODULE_API     , "Api"   },
       { MODULE_MSG     , "Msg"   },
+      { MODULE_TCP     , "Tcp"   },
 };
 
 /**
@@ -119,6 +119,29 @@ void HELP_printCmdSpecific(
       prototype += enumToString(_DC3_Bootloader);
       prototype += "]";
 
+      example = appName + " -i 207.27.0.75 --" + parsed_cmd +
+            " file=../../DC3Appl_v01.03_20150715142540.bin " + "type=";
+      example += enumToString(_DC3_Application);
+   } else if (  0 == parsed_cmd.compare("stage") ) {           // stage cmd help
+      description = parsed_cmd + " command transfers a FW image to the DC3 "
+            "while it keeps running the Application. The image is written to "
+            "the staged flash slot and the Bootloader installs it on the next "
+            "reboot (--set_mode Bootloader followed by --set_mode Application). "
+            "The options for the FW image type are: ";
+
+      ss_params.str(string());
+      ss_params << " * [type=" << enumToString(_DC3_Application) << "]";
+      cmd_arg_options.push_back(ss_params.str());
+
+      cmd_arg_options.push_back(" * [file=path/to/filename.bin]");
+      cmd_arg_options.push_back(" --- Note that the filename must follow the "
+            "format of DC3<Name>_vYY.ZZ_YYYYMMDDhhmmss.bin.");
+
+      prototype = appName + " [connection options] --" + parsed_cmd
+            + " [file=<relative path to *.bin file>] " + "[type=";
+      prototype += enumToString(_DC3_Application);
+      prototype += "]";
+
       example = appName + " -i 207.27.0.75 --" + parsed_cmd +
             " file=../../DC3Appl_v01.03_20150715142540.bin " + "type=";
       example += enumToString(_DC3_Application);
@@ -316,6 +339,74 @@ void HELP_printCmdSpecific(
       example += enumToString(_DC3_EEPROM);
       example += " data=\"0x00,0x01,0x02,0x03\"";
 
+   } else if (  0 == parsed_cmd.compare("dump_i2c") ) {     // dump_i2c cmd help
+      description = parsed_cmd + " command reads an I2C device into a binary "
+            "file. You have to specify the I2C device (dev=) and the file "
+            "(file=). By default the whole device is read but an offset "
+            "(start=) and number of bytes (bytes=) can be specified.";
+
+      ss_params.str(string());
+      ss_params << "* [dev=<" << enumToString(_DC3_EEPROM)
+                << "|" << enumToString(_DC3_SNROM)
+                << "|" << enumToString(_DC3_EUIROM) << ">]";
+      cmd_arg_options.push_back(ss_params.str());
+      cmd_arg_options.push_back("* [file=<path to a file>] where to write the data.");
+      cmd_arg_options.push_back("* {start=<0 - N>} where N depends on the device. 0 by default.");
+      cmd_arg_options.push_back("* {bytes=<1 - N>} where N depends on the device and "
+            "'start' param. The rest of the device by default.");
+
+      ss_params.str(string());
+      ss_params << "* {acc=<(" << enumToString(_DC3_ACCESS_QPC) << ")"
+                << "|" << enumToString(_DC3_ACCESS_FRT)
+                << "|" << enumToString(_DC3_ACCESS_BARE) << ">}";
+      cmd_arg_options.push_back(ss_params.str());
+
+      prototype = appName + " [connection options] --" + parsed_cmd
+            + " [file=<path>] {start=<0 - 255>} {bytes=<1 - 256>} ";
+      ss_params.str(string());
+      ss_params << "[dev=<" << enumToString(_DC3_EEPROM)
+                << "|" << enumToString(_DC3_SNROM)
+                << "|" << enumToString(_DC3_EUIROM) << ">]";
+      prototype += ss_params.str();
+
+      example = appName + " -i 207.27.0.75 --" + parsed_cmd +
+            " file=eeprom.bin " + "dev=";
+      example += enumToString(_DC3_EEPROM);
+
+   } else if (  0 == parsed_cmd.compare("restore_i2c") ) { // restore_i2c cmd help
+      description = parsed_cmd + " command writes a binary file (usually made "
+            "by dump_i2c) to an I2C device and then reads it back to verify it. "
+            "You have to specify the I2C device (dev=) and the file (file=). The "
+            "file is written starting at the beginning of the device unless an "
+            "offset (start=) is specified.";
+
+      ss_params.str(string());
+      ss_params << "* [dev=<" << enumToString(_DC3_EEPROM)<< ">]";
+      cmd_arg_options.push_back(ss_params.str());
+      cmd_arg_options.push_back("* [file=<path to a file>] with the data to write.");
+      cmd_arg_options.push_back("* {start=<0 - N>} where N depends on the device. 0 by default.");
+
+      ss_params.str(string());
+      ss_params << " --- " << " start + size of the file should be less than the "
+            "maximum storage size of the devices";
+      cmd_arg_options.push_back(ss_params.str());
+
+      ss_params.str(string());
+      ss_params << "* {acc=<(" << enumToString(_DC3_ACCESS_QPC) << ")"
+                << "|" << enumToString(_DC3_ACCESS_FRT)
+                << "|" << enumToString(_DC3_ACCESS_BARE) << ">}";
+      cmd_arg_options.push_back(ss_params.str());
+
+      prototype = appName + " [connection options] --" + parsed_cmd
+            + " [file=<path>] {start=<0 - 255>} ";
+      ss_params.str(string());
+      ss_params << "[dev=<" << enumToString(_DC3_EEPROM) << ">]";
+      prototype += ss_params.str();
+
+      example = appName + " -i 207.27.0.75 --" + parsed_cmd +
+            " file=eeprom.bin " + "dev=";
+      example += enumToString(_DC3_EEPROM);
+
    } else if( 0 == parsed_cmd.compare("ram_test") ) {       // ram_test cmd help
       description = parsed_cmd + " command sends a request to the DC3 to run "
             "a test on the external RAM. The RAM test checks the integrity of "
@@ -334,6 +425,87 @@ void HELP_printCmdSpecific(
       description += ss_params.str();
       prototype = appName + " [connection options] --" + parsed_cmd;
       example = appName + " -i 207.27.0.75 --" + parsed_cmd;
+   } else if( 0 == parsed_cmd.compare("get_board_info") ) { // get_board_info help
+      description = parsed_cmd + " command sends a single request to the DC3 "
+            "to get the serial number, MAC and IP addresses, and the major and "
+            "minor versions and build datetimes of the Bootloader, Application, "
+            "and FPGA images from the settings DB. The DC3 reads all of these "
+            "with one access per storage device so this is much faster than "
+            "getting the elements one at a time.";
+      prototype = appName + " [connection options] --" + parsed_cmd;
+      example = appName + " -i 207.27.0.75 --" + parsed_cmd;
+   } else if( 0 == parsed_cmd.compare("discover") ) {     // discover help
+      description = parsed_cmd + " command sends a single discover request and "
+            "lists every DC3 that answers within window ms (1000 if not given): "
+            "the IP and MAC addresses, whether it's running the Bootloader or "
+            "the Application, the serial number, and the major and minor "
+            "versions and build datetimes of the Bootloader, Application, and "
+            "FPGA images. Give the broadcast address of the subnet as the IP "
+            "address to find every DC3 on it at once instead of trying one "
+            "address at a time. Both the Bootloader and the Application answer.";
+      prototype = appName + " -i [broadcast address] --" + parsed_cmd + " {window=[ms]}";
+      example = appName + " -i 207.27.0.255 --" + parsed_cmd + " window=500";
+   } else if( 0 == parsed_cmd.compare("get_profile") ) { // get_profile help
+      description = parsed_cmd + " command gets the Active Object dispatch "
+            "profile from the DC3. For every AO it prints how many events it "
+            "dispatched, the shortest, average, and longest dispatch, the same "
+            "for the time events waited in the queue of the AO, and a log2 "
+            "histogram of both. After that it prints the dispatch times of "
+            "every signal of every AO, longest first. All times are in "
+            "microseconds. Only the Application built with AO_PROF=1 keeps a "
+            "profile. The optional reset=1 clears the profile on the DC3 after "
+            "it's been read out.";
+      prototype = appName + " [connection options] --" + parsed_cmd + " {reset=[0|1]}";
+      example = appName + " -i 207.27.0.75 --" + parsed_cmd + " reset=1";
+   } else if( 0 == parsed_cmd.compare("get_mem_stats") ) { // get_mem_stats help
+      description = parsed_cmd + " command gets the usage of every event pool, "
+            "memory pool, event queue, and stack on the DC3. For each one it "
+            "prints the block size (pools only), how many blocks or entries it "
+            "has, how many are free now, the fewest that were ever free, and the "
+            "peak usage in percent. Pools also print how many allocations were "
+            "made from them and how many of those failed. Stacks are in bytes "
+            "and only know the fewest that were ever free: one for every task "
+            "(the idle task, every AO, and the CPLR task) and one for the main "
+            "stack the ISRs run on. Use it to size the pools, queues, and "
+            "stacks in main.c. Only the Application supports it.";
+      prototype = appName + " [connection options] --" + parsed_cmd;
+      example = appName + " -i 207.27.0.75 --" + parsed_cmd;
+   } else if( 0 == parsed_cmd.compare("get_cpu_load") ) { // get_cpu_load help
+      description = parsed_cmd + " command gets the CPU load of every FreeRTOS "
+            "task priority on the DC3 over the last second and the last 10 "
+            "seconds, and during the second the CPLR task was busiest (peak). "
+            "The idle task is priority 0 and the total load is 100% minus its "
+            "load. ISR time is counted in the task the ISR interrupted. Use "
+            "reset=1 to forget the peak once it's been read out. Only the "
+            "Application supports it.";
+      prototype = appName + " [connection options] --" + parsed_cmd + " {reset=[0|1]}";
+      example = appName + " -i 207.27.0.75 --" + parsed_cmd + " reset=1";
+   } else if( 0 == parsed_cmd.compare("health_top") ) { // health_top help
+      description = parsed_cmd + " command starts the health stream of the DC3 "
+            "and prints every msg it pushes: CPU load, I2C bus errors and "
+            "recoveries, serial drops, ethernet and lwIP counters, and how full "
+            "each pool and queue is. interval is the time between msgs in ms ("
+            "100 to 3600000). It stops after count msgs, or when they stop "
+            "coming if count is 0, and stops the stream on the DC3. interval=0 "
+            "only stops a stream that's still running. Needs an ethernet "
+            "connection and only the Application supports it.";
+      prototype = appName + " [connection options] --" + parsed_cmd + " interval=[ms] {count=[n]}";
+      example = appName + " -i 207.27.0.75 --" + parsed_cmd + " interval=1000 count=10";
+   } else if( 0 == parsed_cmd.compare("qs_trace") ) { // qs_trace help
+      description = parsed_cmd + " command captures the QS software trace of "
+            "the DC3 for secs seconds into file and converts it into a timeline "
+            "of every state machine step of every AO, written to file with "
+            ".timeline.txt appended: when the event was dispatched, which "
+            "signal, how long it waited in the queue of the AO, how long it "
+            "took to process, and which transition it took. A summary of the "
+            "wait and run times per AO and per signal is printed at the end. "
+            "All times are in microseconds. The DC3 only sends the names of "
+            "the AOs and states to the first capture after it boots so use "
+            "dict= to borrow them from that capture. secs=0 only converts an "
+            "existing capture. Needs an ethernet connection and only the "
+            "Application built with CONF=spy supports it.";
+      prototype = appName + " -i [ip address] --" + parsed_cmd + " file=[filename] secs=[secs] {dict=[filename]}";
+      example = appName + " -i 207.27.0.75 --" + parsed_cmd + " file=trace.qs secs=10 dict=first.qs";
    } else {
       ERR_out << "Unable to find cmd specific help for " << parsed_cmd;
       EXIT_LOG_FLUSH(0);
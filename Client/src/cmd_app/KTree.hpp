@@ -179,6 +179,11 @@ typedef enum MenuActions {
    MENU_DB_RESET_DBG_MOD,
    MENU_DB_GET_ELEM,
    MENU_DB_SET_ELEM,
+   MENU_DB_GET_BOARD_INFO,
+   MENU_GET_PROFILE,
+   MENU_GET_MEM_STATS,
+   MENU_HEALTH_TOP,
+   MENU_GET_CPU_LOAD,
    MENU_DB_RESET,
 } MenuAction_t;
 
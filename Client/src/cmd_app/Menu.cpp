@@ -130,6 +130,11 @@ APIError_t MENU_run( ClientApi *client )
    root->findChild("SYS")->findChild("MDE")->addChild( "SEA", "(Se)t DC3 boot mode to (A)pplication", MENU_SET_APPL );
    root->findChild("SYS")->findChild("MDE")->addChild( "SEB", "(Se)t DC3 boot mode to (B)ootloader", MENU_SET_BOOT );
 
+   root->findChild("SYS")->addChild( "PRF", "Get Active Object dispatch (pr)o(f)ile", MENU_GET_PROFILE );
+   root->findChild("SYS")->addChild( "MEM", "Get pool, queue, and stack (mem)ory usage", MENU_GET_MEM_STATS );
+   root->findChild("SYS")->addChild( "HLT", "Watch the (h)ea(lt)h stream for 10 s", MENU_HEALTH_TOP );
+   root->findChild("SYS")->addChild( "CPU", "Get (CPU) load of each task", MENU_GET_CPU_LOAD );
+
    root->findChild("SYS")->addChild( "I2C", "I2C tests" );
    root->findChild("SYS")->findChild("I2C")->addChild( "REE", "(R)ead (EE)PROM on I2C" );
    root->findChild("SYS")->findChild("I2C")->findChild("REE")->addChild( "DEF", "Read EEPROM on I2C with (def)ault start and number of bytes", MENU_I2C_READ_TEST_DEF );
@@ -145,6 +150,7 @@ APIError_t MENU_run( ClientApi *client )
    root->findChild("SYS")->findChild("DBS")->addChild( "RDM", "(R)estore DC3 debug module settings to defaults in DB", MENU_DB_RESET_DBG_MOD );
    root->findChild("SYS")->findChild("DBS")->addChild( "GET", "(Get) an element in the DC3 DB", MENU_DB_GET_ELEM );
    root->findChild("SYS")->findChild("DBS")->addChild( "SET", "(Set) an element in the DC3 DB", MENU_DB_SET_ELEM );
+   root->findChild("SYS")->findChild("DBS")->addChild( "INF", "Get DC3 board (inf)o (SN, addresses, and FW versions) in one request", MENU_DB_GET_BOARD_INFO );
    root->findChild("SYS")->findChild("DBS")->addChild( "RST", "(R)e(s)e(t) DC3 settings Database (!!!WARNING, this wipes the EEPROM!!!)", MENU_DB_RESET );
 
 
@@ -611,6 +617,21 @@ APIError_t MENU_parseAndExecAction(
          }
          break;
       }
+      case MENU_DB_GET_BOARD_INFO:
+         status = CMD_runGetBoardInfo( client, &statusDC3 );
+         break;
+      case MENU_GET_PROFILE:
+         status = CMD_runGetProfile( client, &statusDC3, false );
+         break;
+      case MENU_GET_MEM_STATS:
+         status = CMD_runGetMemStats( client, &statusDC3 );
+         break;
+      case MENU_HEALTH_TOP:
+         status = CMD_runHealthTop( client, &statusDC3, 1000, 10 );
+         break;
+      case MENU_GET_CPU_LOAD:
+         status = CMD_runGetCpuLoad( client, &statusDC3, false );
+         break;
       case MENU_DB_RESET:
          status = CMD_runResetDB( client, &statusDC3 );
          break;
@@ -0,0 +1,676 @@
+/**
+ * @file    QsTrace.cpp
+ * Collector for the QS software trace the DC3 streams over UDP.
+ *
+ * See QsTrace.hpp for the description.
+ *
+ * The record layouts are the ones of QP/C 5.3.1 with the sizes the DC3 is
+ * built with: 4 byte timestamps, object and function pointers, 2 byte signals
+ * and 1 byte queue counters, all little endian.
+ *
+ * @date    10/19/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+/* System includes */
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <deque>
+#include <map>
+#include <algorithm>
+#include <cstring>
+
+/* Boost includes */
+#include <boost/asio.hpp>
+#include <boost/thread.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+/* App includes */
+#include "QsTrace.hpp"
+
+/* Namespaces ----------------------------------------------------------------*/
+using namespace std;
+using boost::asio::ip::udp;
+
+/* Compile-time called macros ------------------------------------------------*/
+/* Private typedefs ----------------------------------------------------------*/
+
+/**
+ * @brief   QS record types used here.  Numbers from enum QSpyRecords in qs.h.
+ */
+typedef enum {
+   QS_TRACE_QEP_INIT_TRAN        = 4,
+   QS_TRACE_QEP_INTERN_TRAN      = 5,
+   QS_TRACE_QEP_TRAN             = 6,
+   QS_TRACE_QEP_IGNORED          = 7,
+   QS_TRACE_QEP_DISPATCH         = 8,
+   QS_TRACE_QF_ACTIVE_POST_FIFO  = 14,
+   QS_TRACE_QF_ACTIVE_POST_LIFO  = 15,
+   QS_TRACE_QF_ACTIVE_GET        = 16,
+   QS_TRACE_QF_ACTIVE_GET_LAST   = 17,
+   QS_TRACE_QF_ACTIVE_POST_ATTEMPT = 45,
+   QS_TRACE_SIG_DICT             = 60,
+   QS_TRACE_OBJ_DICT             = 61,
+   QS_TRACE_FUN_DICT             = 62,
+   QS_TRACE_ASSERT_FAIL          = 69,
+} QsTraceRec_t;
+
+/**
+ * @brief   Wait and run times of a set of RTC steps.  All times in us.
+ */
+typedef struct {
+   uint32_t n;                                           /**< Steps counted */
+   uint32_t nWait;                      /**< Steps whose post was captured */
+   uint64_t waitSum;                      /**< Total time spent in queues */
+   uint32_t waitMax;                      /**< Longest time spent in queue */
+   uint64_t runSum;                      /**< Total time spent processing */
+   uint32_t runMax;                      /**< Longest time spent processing */
+   uint32_t nTran;                                 /**< Steps that took a tran */
+   uint32_t nIgnored;                      /**< Steps where sig was ignored */
+} QsTraceTimes_t;
+
+/**
+ * @brief   What's known about an AO while going through the stream.
+ */
+typedef struct {
+   deque<uint32_t> posts;      /**< Post times of events still in its queue */
+   bool     bInStep;                        /**< A dispatch started already */
+   uint32_t getTime;                     /**< When it got the current event */
+   uint32_t waitTime;          /**< How long the current event was queued */
+   bool     bWaitKnown;        /**< The post of current event was captured */
+   uint32_t dispatchTime;              /**< When the current dispatch began */
+} QsTraceAo_t;
+
+/**
+ * @brief   State of a conversion.
+ */
+typedef struct {
+   map<uint32_t, string> objs;                      /**< Object dictionary */
+   map<uint32_t, string> funs;                    /**< Function dictionary */
+   map<uint16_t, string> sigs;                      /**< Signal dictionary */
+   map<uint32_t, QsTraceAo_t> aos;                   /**< AOs seen so far */
+   map<uint32_t, QsTraceTimes_t> aoTimes;                 /**< Per AO times */
+   map<pair<uint32_t, uint16_t>, QsTraceTimes_t> sigTimes; /**< Per AO+sig */
+   bool     bSeqSet;                     /**< A sequence number came in yet */
+   uint8_t  seq;                             /**< Last sequence number seen */
+   QsTraceStats_t stats;                          /**< What was found so far */
+} QsTraceParser_t;
+
+/**
+ * @brief   Reads the fields out of a single record.
+ */
+typedef struct {
+   const uint8_t *p;                                  /**< Next byte to read */
+   const uint8_t *end;                         /**< One past the last byte */
+   bool bOk;                 /**< All the reads so far were within the rec */
+} QsTraceRecReader_t;
+
+/* Private defines -----------------------------------------------------------*/
+#define QS_TRACE_FRAME        0x7E           /**< HDLC flag between records */
+#define QS_TRACE_ESC          0x7D                  /**< HDLC escape byte */
+#define QS_TRACE_ESC_XOR      0x20     /**< XOR to undo an escaped byte */
+#define QS_TRACE_GOOD_CHKSUM  0xFF    /**< Sum of a record with its chksum */
+#define QS_TRACE_CMD_START    0x01    /**< Any byte but 0 starts the stream */
+#define QS_TRACE_CMD_STOP     0x00           /**< QS_UDP_CMD_STOP on the DC3 */
+
+/* Private macros ------------------------------------------------------------*/
+/* Private variables and Local objects ---------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+
+/**
+ * @brief   Read a little endian number of a given size out of a record.
+ * @param [in|out] *pRd: QsTraceRecReader_t pointer to the reader.
+ * @param [in] size: const size_t number of bytes in the number.
+ * @return: uint32_t the number or 0 if the record is too short.
+ */
+static uint32_t QS_TRACE_readNum( QsTraceRecReader_t *pRd, const size_t size );
+
+/**
+ * @brief   Read a zero terminated string out of a record.
+ * @param [in|out] *pRd: QsTraceRecReader_t pointer to the reader.
+ * @return: string that was read.
+ */
+static string QS_TRACE_readStr( QsTraceRecReader_t *pRd );
+
+/**
+ * @brief   Name of an object, function, or signal from the dictionaries.
+ * @param [in] dict: const map& dictionary to look in.
+ * @param [in] key: the address or signal to look up.
+ * @param [in] bHex: const bool whether to print unknown keys in hex.
+ * @return: string the name or the key if it's not in the dictionary.
+ */
+template<typename T> static string QS_TRACE_name(
+      const map<T, string>& dict,
+      const T key,
+      const bool bHex
+);
+
+/**
+ * @brief   Add an RTC step to a set of times.
+ * @param [in|out] *pTimes: QsTraceTimes_t pointer to the set to add to.
+ * @param [in] *pAo: const QsTraceAo_t pointer to the AO that ran the step.
+ * @param [in] run: const uint32_t how long it took to process in us.
+ * @param [in] rec: const uint8_t record that ended the step.
+ * @return: None
+ */
+static void QS_TRACE_addTimes(
+      QsTraceTimes_t *pTimes,
+      const QsTraceAo_t *pAo,
+      const uint32_t run,
+      const uint8_t rec
+);
+
+/**
+ * @brief   Print a set of times as a row of the summary.
+ * @param [out] os: ostream& to print to.
+ * @param [in] name: const string& name of the row.
+ * @param [in] t: const QsTraceTimes_t& times to print.
+ * @return: None
+ */
+static void QS_TRACE_printTimes(
+      ostream& os,
+      const string& name,
+      const QsTraceTimes_t& t
+);
+
+/**
+ * @brief   Handle a single good record.
+ * @param [in|out] *pParser: QsTraceParser_t pointer to the conversion state.
+ * @param [in] rec: const vector& of the record bytes (seq, type, data).
+ * @param [in] bDictOnly: const bool whether to only take dictionaries.
+ * @param [out] timeline: ostream& to write the timeline to.
+ * @return: None
+ */
+static void QS_TRACE_onRec(
+      QsTraceParser_t *pParser,
+      const vector<uint8_t>& rec,
+      const bool bDictOnly,
+      ostream& timeline
+);
+
+/**
+ * @brief   Break a raw stream into records and handle each one.
+ * @param [in|out] *pParser: QsTraceParser_t pointer to the conversion state.
+ * @param [in] filename: const string& name of the file with the raw stream.
+ * @param [in] bDictOnly: const bool whether to only take dictionaries.
+ * @param [out] timeline: ostream& to write the timeline to.
+ * @return: bool true if the file could be read.
+ */
+static bool QS_TRACE_parseFile(
+      QsTraceParser_t *pParser,
+      const string& filename,
+      const bool bDictOnly,
+      ostream& timeline
+);
+
+/* Private functions ---------------------------------------------------------*/
+/******************************************************************************/
+static uint32_t QS_TRACE_readNum( QsTraceRecReader_t *pRd, const size_t size )
+{
+   if ( !pRd->bOk || (size_t)(pRd->end - pRd->p) < size ) {
+      pRd->bOk = false;
+      return( 0 );
+   }
+
+   uint32_t num = 0;
+   for ( size_t i = 0; i < size; i++ ) {
+      num |= (uint32_t)pRd->p[i] << ( 8 * i );
+   }
+   pRd->p += size;
+   return( num );
+}
+
+/******************************************************************************/
+static string QS_TRACE_readStr( QsTraceRecReader_t *pRd )
+{
+   const uint8_t *pEnd = find( pRd->p, pRd->end, (uint8_t)0 );
+   if ( !pRd->bOk || pEnd == pRd->end ) {
+      pRd->bOk = false;
+      return( string() );
+   }
+
+   string str( (const char *)pRd->p, pEnd - pRd->p );
+   pRd->p = pEnd + 1;
+   return( str );
+}
+
+/******************************************************************************/
+template<typename T> static string QS_TRACE_name(
+      const map<T, string>& dict,
+      const T key,
+      const bool bHex
+)
+{
+   typename map<T, string>::const_iterator it = dict.find( key );
+   if ( it != dict.end() ) {
+      return( it->second );
+   }
+
+   stringstream ss;
+   if ( bHex ) {
+      ss << "0x" << hex << setw(8) << setfill('0') << key;
+   } else {
+      ss << key;
+   }
+   return( ss.str() );
+}
+
+/******************************************************************************/
+static void QS_TRACE_addTimes(
+      QsTraceTimes_t *pTimes,
+      const QsTraceAo_t *pAo,
+      const uint32_t run,
+      const uint8_t rec
+)
+{
+   pTimes->n++;
+   if ( pAo->bWaitKnown ) {
+      pTimes->nWait++;
+      pTimes->waitSum += pAo->waitTime;
+      pTimes->waitMax  = max( pTimes->waitMax, pAo->waitTime );
+   }
+   pTimes->runSum += run;
+   pTimes->runMax  = max( pTimes->runMax, run );
+   if ( QS_TRACE_QEP_TRAN == rec ) {
+      pTimes->nTran++;
+   } else if ( QS_TRACE_QEP_IGNORED == rec ) {
+      pTimes->nIgnored++;
+   }
+}
+
+/******************************************************************************/
+static void QS_TRACE_printTimes(
+      ostream& os,
+      const string& name,
+      const QsTraceTimes_t& t
+)
+{
+   os << left << setw(32) << name << right
+         << setw(8) << t.n
+         << setw(8) << t.nTran
+         << setw(8) << t.nIgnored;
+   if ( 0 != t.nWait ) {
+      os << setw(12) << t.waitSum / t.nWait << setw(12) << t.waitMax;
+   } else {
+      os << setw(12) << "-" << setw(12) << "-";
+   }
+   os << setw(12) << ( ( 0 != t.n ) ? t.runSum / t.n : 0 )
+         << setw(12) << t.runMax << endl;
+}
+
+/******************************************************************************/
+static void QS_TRACE_onRec(
+      QsTraceParser_t *pParser,
+      const vector<uint8_t>& rec,
+      const bool bDictOnly,
+      ostream& timeline
+)
+{
+   QsTraceRecReader_t rd = { &rec[2], &rec[0] + rec.size(), true };
+   const uint8_t type = rec[1];
+
+   /* Dictionaries first since they're all a dictionary only pass wants */
+   if ( QS_TRACE_OBJ_DICT == type ) {
+      const uint32_t obj = QS_TRACE_readNum( &rd, 4 );
+      string name = QS_TRACE_readStr( &rd );
+      if ( 0 == name.compare( 0, 3, "&l_" ) ) {      /* "&l_CommMgr" etc. */
+         name = name.substr( 3 );
+      }
+      if ( rd.bOk ) {
+         pParser->objs[obj] = name;
+      }
+      return;
+   } else if ( QS_TRACE_FUN_DICT == type ) {
+      const uint32_t fun = QS_TRACE_readNum( &rd, 4 );
+      string name = QS_TRACE_readStr( &rd );
+      if ( 0 == name.compare( 0, 1, "&" ) ) {
+         name = name.substr( 1 );
+      }
+      if ( rd.bOk ) {
+         pParser->funs[fun] = name;
+      }
+      return;
+   } else if ( QS_TRACE_SIG_DICT == type ) {
+      const uint16_t sig = (uint16_t)QS_TRACE_readNum( &rd, 2 );
+      QS_TRACE_readNum( &rd, 4 );                      /* obj (unused here) */
+      const string name = QS_TRACE_readStr( &rd );
+      if ( rd.bOk ) {
+         pParser->sigs[sig] = name;
+      }
+      return;
+   } else if ( bDictOnly ) {
+      return;
+   }
+
+   const uint32_t time = QS_TRACE_readNum( &rd, 4 );
+   switch ( type ) {
+      case QS_TRACE_QF_ACTIVE_POST_FIFO:
+      case QS_TRACE_QF_ACTIVE_POST_LIFO: {
+         if ( QS_TRACE_QF_ACTIVE_POST_FIFO == type ) {
+            QS_TRACE_readNum( &rd, 4 );                             /* sender */
+         }
+         QS_TRACE_readNum( &rd, 2 );                                   /* sig */
+         const uint32_t obj = QS_TRACE_readNum( &rd, 4 );
+         if ( rd.bOk ) {
+            deque<uint32_t>& posts = pParser->aos[obj].posts;
+            if ( QS_TRACE_QF_ACTIVE_POST_FIFO == type ) {
+               posts.push_back( time );
+            } else {
+               posts.push_front( time );       /* recalled events jump ahead */
+            }
+         }
+         break;
+      }
+
+      case QS_TRACE_QF_ACTIVE_GET:
+      case QS_TRACE_QF_ACTIVE_GET_LAST: {
+         QS_TRACE_readNum( &rd, 2 );                                   /* sig */
+         const uint32_t obj = QS_TRACE_readNum( &rd, 4 );
+         if ( rd.bOk ) {
+            QsTraceAo_t& ao = pParser->aos[obj];
+            ao.getTime    = time;
+            ao.bWaitKnown = !ao.posts.empty();
+            if ( ao.bWaitKnown ) {
+               ao.waitTime = time - ao.posts.front();    /* wraps are fine */
+               ao.posts.pop_front();
+            }
+            if ( QS_TRACE_QF_ACTIVE_GET_LAST == type ) {
+               ao.posts.clear();           /* queue is empty on the board */
+            }
+         }
+         break;
+      }
+
+      case QS_TRACE_QEP_DISPATCH: {
+         QS_TRACE_readNum( &rd, 2 );                                   /* sig */
+         const uint32_t obj = QS_TRACE_readNum( &rd, 4 );
+         if ( rd.bOk ) {
+            pParser->aos[obj].bInStep      = true;
+            pParser->aos[obj].dispatchTime = time;
+         }
+         break;
+      }
+
+      case QS_TRACE_QEP_TRAN:
+      case QS_TRACE_QEP_INTERN_TRAN:
+      case QS_TRACE_QEP_IGNORED: {
+         const uint16_t sig = (uint16_t)QS_TRACE_readNum( &rd, 2 );
+         const uint32_t obj = QS_TRACE_readNum( &rd, 4 );
+         const uint32_t src = QS_TRACE_readNum( &rd, 4 );
+         const uint32_t tgt = ( QS_TRACE_QEP_TRAN == type ) ?
+               QS_TRACE_readNum( &rd, 4 ) : 0;
+         if ( !rd.bOk ) {
+            break;
+         }
+
+         QsTraceAo_t& ao = pParser->aos[obj];
+         if ( !ao.bInStep ) {       /* dispatch was before the capture began */
+            break;
+         }
+         ao.bInStep = false;
+
+         const uint32_t run = time - ao.dispatchTime;
+         QS_TRACE_addTimes( &pParser->aoTimes[obj], &ao, run, type );
+         QS_TRACE_addTimes(
+               &pParser->sigTimes[make_pair( obj, sig )], &ao, run, type
+         );
+         pParser->stats.nSteps++;
+
+         timeline << setw(12) << ao.dispatchTime << " "
+               << left << setw(14) << QS_TRACE_name( pParser->objs, obj, true )
+               << " sig=" << setw(20) << QS_TRACE_name( pParser->sigs, sig, false )
+               << right << " wait=";
+         if ( ao.bWaitKnown ) {
+            timeline << setw(8) << ao.waitTime;
+         } else {
+            timeline << setw(8) << "?";
+         }
+         timeline << " run=" << setw(8) << run << "  "
+               << QS_TRACE_name( pParser->funs, src, true );
+         if ( QS_TRACE_QEP_TRAN == type ) {
+            timeline << " -> " << QS_TRACE_name( pParser->funs, tgt, true );
+         } else if ( QS_TRACE_QEP_IGNORED == type ) {
+            timeline << " (ignored)";
+         }
+         timeline << endl;
+         break;
+      }
+
+      case QS_TRACE_QEP_INIT_TRAN: {
+         const uint32_t obj = QS_TRACE_readNum( &rd, 4 );
+         const uint32_t tgt = QS_TRACE_readNum( &rd, 4 );
+         if ( rd.bOk ) {
+            timeline << setw(12) << time << " "
+                  << left << setw(14) << QS_TRACE_name( pParser->objs, obj, true )
+                  << right << " init -> "
+                  << QS_TRACE_name( pParser->funs, tgt, true ) << endl;
+         }
+         break;
+      }
+
+      case QS_TRACE_QF_ACTIVE_POST_ATTEMPT: {
+         QS_TRACE_readNum( &rd, 4 );                                /* sender */
+         const uint16_t sig = (uint16_t)QS_TRACE_readNum( &rd, 2 );
+         const uint32_t obj = QS_TRACE_readNum( &rd, 4 );
+         if ( rd.bOk ) {
+            timeline << setw(12) << time << " "
+                  << left << setw(14) << QS_TRACE_name( pParser->objs, obj, true )
+                  << " sig=" << QS_TRACE_name( pParser->sigs, sig, false )
+                  << right << " NOT POSTED (queue full)" << endl;
+         }
+         break;
+      }
+
+      case QS_TRACE_ASSERT_FAIL: {
+         const uint32_t loc = QS_TRACE_readNum( &rd, 2 );
+         const string module = QS_TRACE_readStr( &rd );
+         timeline << setw(12) << time << " ASSERT FAILED in " << module
+               << " at " << loc << endl;
+         break;
+      }
+
+      default:
+         break;                    /* Not something the timeline cares about */
+   }
+
+   if ( !rd.bOk ) {
+      pParser->stats.nBadRecs++;
+   }
+}
+
+/******************************************************************************/
+static bool QS_TRACE_parseFile(
+      QsTraceParser_t *pParser,
+      const string& filename,
+      const bool bDictOnly,
+      ostream& timeline
+)
+{
+   ifstream file( filename.c_str(), ios::in | ios::binary );
+   if ( !file.good() ) {
+      return( false );
+   }
+
+   vector<uint8_t> rec;
+   uint8_t chksum = 0;
+   bool bEsc = false;
+   char c;
+
+   /* Starts out of sync since a capture can begin in the middle of a record */
+   bool bSynced = false;
+   while ( file.get( c ) ) {
+      uint8_t b = (uint8_t)c;
+      if ( QS_TRACE_FRAME == b ) {
+         if ( bSynced && !rec.empty() ) {
+            if ( rec.size() < 3 || QS_TRACE_GOOD_CHKSUM != chksum ) {
+               pParser->stats.nBadRecs++;
+            } else {
+               rec.pop_back();                           /* drop the chksum */
+               if ( !bDictOnly ) {
+                  const uint8_t expected = pParser->seq + 1;
+                  if ( pParser->bSeqSet && rec[0] != expected ) {
+                     pParser->stats.nLostRecs += (uint8_t)( rec[0] - expected );
+
+                     /* Lost posts and gets would throw off all the waits */
+                     map<uint32_t, QsTraceAo_t>::iterator it;
+                     for ( it = pParser->aos.begin(); it != pParser->aos.end(); ++it ) {
+                        it->second.posts.clear();
+                        it->second.bInStep = false;
+                     }
+                  }
+                  pParser->seq     = rec[0];
+                  pParser->bSeqSet = true;
+                  pParser->stats.nRecs++;
+               }
+               QS_TRACE_onRec( pParser, rec, bDictOnly, timeline );
+            }
+         }
+         bSynced = true;
+         rec.clear();
+         chksum = 0;
+         bEsc   = false;
+      } else if ( QS_TRACE_ESC == b ) {
+         bEsc = true;
+      } else {
+         if ( bEsc ) {
+            b ^= QS_TRACE_ESC_XOR;
+            bEsc = false;
+         }
+         chksum += b;
+         rec.push_back( b );
+      }
+   }
+   return( true );
+}
+
+/* Public functions ----------------------------------------------------------*/
+/******************************************************************************/
+APIError_t QS_TRACE_capture(
+      const string& ipAddress,
+      const string& filename,
+      const uint32_t secs,
+      size_t *pBytes
+)
+{
+   *pBytes = 0;
+
+   ofstream file( filename.c_str(), ios::out | ios::binary );
+   if ( !file.good() ) {
+      return( API_ERR_MEM_UNABLE_TO_WRITE_FILE );
+   }
+
+   try {
+      boost::asio::io_service io;
+      udp::resolver resolver( io );
+      udp::endpoint board = *resolver.resolve(
+            udp::resolver::query( udp::v4(), ipAddress, QS_TRACE_PORT )
+      );
+      udp::socket socket( io, udp::endpoint( udp::v4(), 0 ) );
+      socket.non_blocking( true );
+
+      const uint8_t start = QS_TRACE_CMD_START;
+      const uint8_t stop  = QS_TRACE_CMD_STOP;
+      vector<char> buf( 2048 );
+
+      const boost::posix_time::ptime end =
+            boost::posix_time::microsec_clock::universal_time() +
+            boost::posix_time::seconds( secs );
+      boost::posix_time::ptime nextStart =
+            boost::posix_time::microsec_clock::universal_time();
+
+      boost::posix_time::ptime now;
+      while ( ( now = boost::posix_time::microsec_clock::universal_time() ) < end ) {
+         if ( now >= nextStart ) {
+            socket.send_to( boost::asio::buffer( &start, 1 ), board );
+            nextStart = now + boost::posix_time::seconds( 1 );
+         }
+
+         boost::system::error_code ec;
+         udp::endpoint sender;
+         const size_t n = socket.receive_from(
+               boost::asio::buffer( buf ), sender, 0, ec
+         );
+         if ( boost::asio::error::would_block == ec ) {
+            boost::this_thread::sleep( boost::posix_time::milliseconds( 5 ) );
+            continue;
+         } else if ( ec ) {
+            throw boost::system::system_error( ec );
+         }
+
+         if ( sender.address() == board.address() ) {
+            file.write( &buf[0], n );
+            *pBytes += n;
+         }
+      }
+
+      socket.send_to( boost::asio::buffer( &stop, 1 ), board );
+   } catch ( exception &e ) {
+      return( API_ERR_UDP_EXCEPTION_CAUGHT );
+   }
+
+   return( file.good() ? API_ERR_NONE : API_ERR_MEM_UNABLE_TO_WRITE_FILE );
+}
+
+/******************************************************************************/
+APIError_t QS_TRACE_convert(
+      const string& filename,
+      const string& dictFilename,
+      ostream& timeline,
+      ostream& summary,
+      QsTraceStats_t *pStats
+)
+{
+   QsTraceParser_t parser;
+   parser.bSeqSet = false;
+   parser.seq     = 0;
+   memset( &parser.stats, 0, sizeof(parser.stats) );
+
+   if ( !dictFilename.empty() &&
+        !QS_TRACE_parseFile( &parser, dictFilename, true, timeline ) ) {
+      return( API_ERR_FW_UNABLE_TO_OPEN );
+   }
+
+   timeline << setw(12) << "time(us)" << " " << left << setw(14) << "AO"
+         << " " << "signal / queue wait(us) / run(us) / transition"
+         << right << endl;
+   if ( !QS_TRACE_parseFile( &parser, filename, false, timeline ) ) {
+      return( API_ERR_FW_UNABLE_TO_OPEN );
+   }
+
+   stringstream hdr;
+   hdr << left << setw(32) << "AO / signal" << right
+         << setw(8) << "steps" << setw(8) << "trans" << setw(8) << "ignored"
+         << setw(12) << "avg wait" << setw(12) << "max wait"
+         << setw(12) << "avg run" << setw(12) << "max run";
+
+   summary << hdr.str() << "   (us)" << endl;
+   map<uint32_t, QsTraceTimes_t>::const_iterator itAo;
+   for ( itAo = parser.aoTimes.begin(); itAo != parser.aoTimes.end(); ++itAo ) {
+      QS_TRACE_printTimes(
+            summary, QS_TRACE_name( parser.objs, itAo->first, true ),
+            itAo->second
+      );
+
+      map<pair<uint32_t, uint16_t>, QsTraceTimes_t>::const_iterator itSig;
+      for ( itSig = parser.sigTimes.begin(); itSig != parser.sigTimes.end();
+            ++itSig ) {
+         if ( itSig->first.first == itAo->first ) {
+            QS_TRACE_printTimes(
+                  summary,
+                  "   sig " + QS_TRACE_name( parser.sigs, itSig->first.second, false ),
+                  itSig->second
+            );
+         }
+      }
+   }
+
+   *pStats = parser.stats;
+   return( API_ERR_NONE );
+}
+
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
@@ -0,0 +1,103 @@
+/**
+ * @file    QsTrace.hpp
+ * Collector for the QS software trace the DC3 streams over UDP.
+ *
+ * The Application built with Q_SPY streams its QS trace to whoever sends a
+ * datagram to port 1503 on it.  The datagrams are the raw (HDLC framed) QS
+ * stream, which is written to disk as is and can be converted later into:
+ *    - a timeline of every RTC step of every AO: which signal, how long it
+ *    waited in the queue of the AO, how long it took to process, and which
+ *    transition it took.
+ *    - a summary of the wait and run times per AO and per AO and signal.
+ *
+ * Timestamps on the DC3 are in us.  Signals are numbers (see DC3Signals.h)
+ * unless the DC3 sent a signal dictionary.  AOs and states are named by the
+ * dictionaries the DC3 sends to the first host after it boots, so a later
+ * capture can borrow them from the first one.
+ *
+ * @date    10/19/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef QSTRACE_HPP_
+#define QSTRACE_HPP_
+
+/* Includes ------------------------------------------------------------------*/
+/* System includes */
+#include <iostream>
+#include <string>
+#include <stdint.h>
+
+/* App includes */
+#include "ApiErrorCodes.h"
+
+/* Namespaces ----------------------------------------------------------------*/
+/* Exported defines ----------------------------------------------------------*/
+#define QS_TRACE_PORT        "1503"  /**< Port the DC3 streams the trace from */
+
+/* Exported macros -----------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief   What a conversion found in a raw QS stream.
+ */
+typedef struct {
+   uint32_t nRecs;                        /**< Good records in the stream */
+   uint32_t nBadRecs;               /**< Records with a bad checksum/length */
+   uint32_t nLostRecs;         /**< Records missing from the sequence nums */
+   uint32_t nSteps;                    /**< RTC steps put on the timeline */
+} QsTraceStats_t;
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief   Capture the QS trace of a DC3 into a file.
+ *
+ * Blocks for the whole capture.  Asks the DC3 to start the stream (again every
+ * second in case the request got lost) and asks it to stop at the end.
+ *
+ * @param [in] ipAddress: const string& IP address of the DC3.
+ * @param [in] filename: const string& name of the file to write the raw stream
+ * to.
+ * @param [in] secs: const uint32_t how long to capture for.
+ * @param [out] *pBytes: size_t pointer to where to put the bytes captured.
+ * @return: APIError_t status:
+ *    @arg  API_ERR_NONE: success
+ *    @arg  API_ERR_UDP_EXCEPTION_CAUGHT: socket error
+ *    @arg  API_ERR_MEM_UNABLE_TO_WRITE_FILE: file error
+ */
+APIError_t QS_TRACE_capture(
+      const std::string& ipAddress,
+      const std::string& filename,
+      const uint32_t secs,
+      size_t *pBytes
+);
+
+/**
+ * @brief   Convert a raw QS stream into a timeline and a summary.
+ *
+ * @param [in] filename: const string& name of the file with the raw stream.
+ * @param [in] dictFilename: const string& name of an earlier raw stream to
+ * take the dictionaries from first.  Empty if none.
+ * @param [out] timeline: ostream& to write the timeline to.
+ * @param [out] summary: ostream& to write the summary to.
+ * @param [out] *pStats: QsTraceStats_t pointer to what was found.
+ * @return: APIError_t status:
+ *    @arg  API_ERR_NONE: success
+ *    @arg  API_ERR_FW_UNABLE_TO_OPEN: unable to read one of the files.
+ */
+APIError_t QS_TRACE_convert(
+      const std::string& filename,
+      const std::string& dictFilename,
+      std::ostream& timeline,
+      std::ostream& summary,
+      QsTraceStats_t *pStats
+);
+
+/* Exported classes ----------------------------------------------------------*/
+
+#endif                                                        /* QSTRACE_HPP_ */
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
@@ -151,6 +151,10 @@ int main(int argc, char *argv[])
          ("local_port,l", po::value<string>(&m_local_port)->default_value("50249"),
             "Set local port number")
 
+         ("tcp,t", "Connect to the TCP sys port of the DC3 instead of the UDP "
+            "port.  Same cmds but FW images are sent several packets at a "
+            "time.  Ignores remote_port and local_port")
+
          ("serial_dev,s", po::value<string>(&m_serial_dev),
             "Set the name of the serial device to connect to instead of "
             "using an IP connection (in the form of /dev/ttySx on cygwin/linux, "
@@ -165,6 +169,11 @@ int main(int argc, char *argv[])
             "Example: --flash file=../some/path/DC3Appl.bin type=Application"
             "Example: --flash file=../some/path/DC3Boot.bin type=Bootloader")
 
+         ("stage", po::value<vector<string>>(&m_command)->multitoken(),
+            "Stage FW on the DC3 while it keeps running the Application. "
+            "Installed on the next reboot. "
+            "Example: --stage file=../some/path/DC3Appl.bin type=Application")
+
          ("get_mode", po::value<vector<string>>(&m_command)->zero_tokens(),
             "Get current operating mode of the DC3. (Bootloader or Application) "
             "Example: --get_mode ")
@@ -178,6 +187,50 @@ int main(int argc, char *argv[])
             "Run a test of the external RAM on the DC3."
             "Example: --ram_test ")
 
+         ("get_board_info", po::value<vector<string>>(&m_command)->zero_tokens(),
+            "Get the serial number, addresses, and FW versions of the DC3 in "
+            "a single request. "
+            "Example: --get_board_info ")
+
+         ("discover", po::value<vector<string>>(&m_command)->multitoken()->zero_tokens(),
+            "Find every DC3 that can hear the given IP address, which can be "
+            "the broadcast address of the subnet, and list their serial "
+            "numbers, addresses, boot modes, and FW versions (ethernet only). "
+            "Example: --discover "
+            "Example: --discover window=500 ")
+
+         ("get_profile", po::value<vector<string>>(&m_command)->multitoken()->zero_tokens(),
+            "Get the dispatch and queue wait times of all the Active Objects "
+            "on the DC3 (Application only). "
+            "Example: --get_profile "
+            "Example: --get_profile reset=1 ")
+
+         ("get_mem_stats", po::value<vector<string>>(&m_command)->zero_tokens(),
+            "Get the usage and low-water marks of the event pools, event "
+            "queues, and stacks on the DC3 (Application only). "
+            "Example: --get_mem_stats ")
+
+         ("get_cpu_load", po::value<vector<string>>(&m_command)->multitoken()->zero_tokens(),
+            "Get the CPU load of every task on the DC3 over the last 1 and 10 "
+            "seconds (Application only). "
+            "Example: --get_cpu_load "
+            "Example: --get_cpu_load reset=1 ")
+
+         ("health_top", po::value<vector<string>>(&m_command)->multitoken(),
+            "Start the periodic health stream of the DC3 and print it as it "
+            "comes in (Application only, ethernet only). "
+            "Example: --health_top interval=1000 "
+            "Example: --health_top interval=500 count=20 "
+            "Example: --health_top interval=0 ")
+
+         ("qs_trace", po::value<vector<string>>(&m_command)->multitoken(),
+            "Capture the QS software trace of the DC3 into a file and convert "
+            "it into a timeline of every state machine step (Application built "
+            "with CONF=spy only, ethernet only). "
+            "Example: --qs_trace file=trace.qs secs=10 "
+            "Example: --qs_trace file=trace.qs secs=10 dict=first.qs "
+            "Example: --qs_trace file=trace.qs secs=0 ")
+
          ("read_i2c", po::value<vector<string>>(&m_command)->multitoken(),
             "Read data from an I2C device."
             "Example: --read_i2c dev=EEPROM bytes=3 start=0 "
@@ -193,6 +246,16 @@ int main(int argc, char *argv[])
             "Example: --write_i2c dev=EEPROM start=0 {data='0x23 0x43 0xA0 ...'}'"
             "Example: --write_i2c dev=EEPROM start=0 {data='A0 23 4b 3A ...'} {acc=FRT}"
             "Example: --write_i2c dev=EEPROM bytes=6 start=0 {acc=BARE}")
+
+         ("dump_i2c", po::value<vector<string>>(&m_command)->multitoken(),
+            "Read a whole I2C device (or part of it) into a binary file."
+            "Example: --dump_i2c dev=EEPROM file=eeprom.bin "
+            "Example: --dump_i2c dev=EEPROM file=eeprom.bin start=16 bytes=64 {acc=FRT}")
+
+         ("restore_i2c", po::value<vector<string>>(&m_command)->multitoken(),
+            "Write a binary file to an I2C device and read it back to verify it."
+            "Example: --restore_i2c dev=EEPROM file=eeprom.bin "
+            "Example: --restore_i2c dev=EEPROM file=eeprom.bin start=16 {acc=FRT}")
       ; // End of add_options()
 
       DBG_out << "Parsing cmdline arguments...";
@@ -207,7 +270,24 @@ int main(int argc, char *argv[])
 
       // Serial and IP connections are mutually exclusive so treat them as such
       // on the cmdline.
-      if (m_vm.count("ip_address") && !m_vm.count("serial_dev")) {
+      if (m_vm.count("ip_address") && !m_vm.count("serial_dev") &&
+          m_vm.count("tcp")) {
+         stringstream port;
+         port << DC3_ETH_SYS_PORT;
+         LOG_out << "TCP connection to: "
+               << m_vm["ip_address"].as<string>() << ":" << port.str() << endl;
+
+         status = client->setNewTcpConnection(
+               m_vm["ip_address"].as<string>().c_str(),
+               port.str().c_str()
+         );
+
+         if ( API_ERR_NONE != status ) {
+            ERR_out << "Unable to open TCP connection. Error: 0x"
+                  << setfill('0') << setw(8) << hex << status;
+            EXIT_LOG_FLUSH(1);
+         }
+      } else if (m_vm.count("ip_address") && !m_vm.count("serial_dev")) {
          LOG_out << "UDP connection to: "
                << m_vm["ip_address"].as<string>() << ":"
                << m_vm["remote_port"].as<string>()
@@ -336,6 +416,36 @@ int main(int argc, char *argv[])
          // function so there's no need to do it here
          status = CMD_runFlash( client, &statusDC3, type, filename );
 
+      } else if (m_vm.count("stage")) {                  // "stage" cmd handling
+         m_parsed_cmd = "stage";
+
+         // Check for command specific help req
+         ARG_checkCmdSpecificHelp( m_parsed_cmd, appName, m_vm, client->isConnected() );
+
+         statusDC3 = ERR_NONE;
+         DC3BootMode_t type = _DC3_NoBootMode;
+         string filename = "";
+
+         try {                      // Extract the value from the arg=value pair
+            ARG_parseEnumStr( &type, "type", m_parsed_cmd, appName,
+                  m_vm[m_parsed_cmd].as<vector<string>>() );
+         } catch (exception& e) {
+            ERR_out << "Caught exception parsing arguments: " << e.what();
+            HELP_printCmdSpecific( m_parsed_cmd, appName );
+         }
+
+         try {      // Extract and validate the filename from the arg=value pair
+            ARG_parseFilenameStr( filename, "file", m_parsed_cmd, appName,
+                  m_vm[m_parsed_cmd].as<vector<string>>() );
+         } catch (exception& e) {
+            ERR_out << "Caught exception parsing arguments: " << e.what();
+            HELP_printCmdSpecific( m_parsed_cmd, appName );
+         }
+
+         // All the error handling and output to console happens inside this
+         // function so there's no need to do it here
+         status = CMD_runStageFW( client, &statusDC3, type, filename );
+
       } else if (m_vm.count("read_i2c")) {            // "read_i2c" cmd handling
          m_parsed_cmd = "read_i2c";
 
@@ -459,6 +569,102 @@ int main(int argc, char *argv[])
 
          delete[] data;
 
+      } else if (m_vm.count("dump_i2c")) {            // "dump_i2c" cmd handling
+         m_parsed_cmd = "dump_i2c";
+
+         // Check for command specific help req
+         ARG_checkCmdSpecificHelp( m_parsed_cmd, appName, m_vm, client->isConnected() );
+
+         int bytes = -1, start = -1;
+         DC3I2CDevice_t dev = _DC3_MaxI2CDev;
+         DC3AccessType_t  acc = _DC3_ACCESS_QPC;       // set to a default arg of QPC
+         string filename = "";
+
+         try {                      // Extract the value from the arg=value pair
+            ARG_parseEnumStr( &dev, "dev", m_parsed_cmd, appName,
+                  m_vm[m_parsed_cmd].as<vector<string>>() );
+            // This call passes in a default value for an optional argument
+            ARG_parseEnumStr( &acc, _DC3_ACCESS_QPC, "acc", m_parsed_cmd,
+                  appName, m_vm[m_parsed_cmd].as<vector<string>>() );
+            // This call passes in a default value for an optional argument
+            ARG_parseNumStr( &start, "0", "start", m_parsed_cmd, appName,
+                  m_vm[m_parsed_cmd].as<vector<string>>() );
+         } catch (exception& e) {
+            ERR_out << "Caught exception parsing arguments: " << e.what();
+            HELP_printCmdSpecific( m_parsed_cmd, appName );
+         }
+
+         // The file doesn't have to exist yet so just grab the name
+         if ( !ARG_getValue( filename, "file", m_vm[m_parsed_cmd].as<vector<string>>() ) ) {
+            ERR_out << "No file specified";
+            HELP_printCmdSpecific( m_parsed_cmd, appName );
+         }
+
+         // Default to the rest of the device
+         stringstream ss_bytes;
+         ss_bytes << (int)I2C_DEVICE_SIZE( dev ) - start;
+         try {
+            // This call passes in a default value for an optional argument
+            ARG_parseNumStr( &bytes, ss_bytes.str(), "bytes", m_parsed_cmd,
+                  appName, m_vm[m_parsed_cmd].as<vector<string>>() );
+         } catch (exception& e) {
+            ERR_out << "Caught exception parsing arguments: " << e.what();
+            HELP_printCmdSpecific( m_parsed_cmd, appName );
+         }
+
+         // Don't allow negatives in our numeric input
+         if ( start < 0 ) {
+            ERR_out << "Invalid start specified: " << start;
+            HELP_printCmdSpecific( m_parsed_cmd, appName );
+         } else if ( bytes < 0 ) {
+            ERR_out << "Invalid number of bytes specified: " << bytes;
+            HELP_printCmdSpecific( m_parsed_cmd, appName );
+         }
+
+         status = CMD_runDumpI2C( client, &statusDC3, filename, bytes, start,
+               dev, acc );
+
+      } else if (m_vm.count("restore_i2c")) {      // "restore_i2c" cmd handling
+         m_parsed_cmd = "restore_i2c";
+
+         // Check for command specific help req
+         ARG_checkCmdSpecificHelp( m_parsed_cmd, appName, m_vm, client->isConnected() );
+
+         int start = -1;
+         DC3I2CDevice_t dev = _DC3_MaxI2CDev;
+         DC3AccessType_t  acc = _DC3_ACCESS_QPC;       // set to a default arg of QPC
+         string filename = "";
+
+         try {                      // Extract the value from the arg=value pair
+            ARG_parseEnumStr( &dev, "dev", m_parsed_cmd, appName,
+                  m_vm[m_parsed_cmd].as<vector<string>>() );
+            // This call passes in a default value for an optional argument
+            ARG_parseEnumStr( &acc, _DC3_ACCESS_QPC, "acc", m_parsed_cmd,
+                  appName, m_vm[m_parsed_cmd].as<vector<string>>() );
+            // This call passes in a default value for an optional argument
+            ARG_parseNumStr( &start, "0", "start", m_parsed_cmd, appName,
+                  m_vm[m_parsed_cmd].as<vector<string>>() );
+         } catch (exception& e) {
+            ERR_out << "Caught exception parsing arguments: " << e.what();
+            HELP_printCmdSpecific( m_parsed_cmd, appName );
+         }
+
+         try {      // Extract and validate the filename from the arg=value pair
+            ARG_parseFilenameStr( filename, "file", m_parsed_cmd, appName,
+                  m_vm[m_parsed_cmd].as<vector<string>>() );
+         } catch (exception& e) {
+            ERR_out << "Caught exception parsing arguments: " << e.what();
+            HELP_printCmdSpecific( m_parsed_cmd, appName );
+         }
+
+         // Don't allow negatives in our numeric input
+         if ( start < 0 ) {
+            ERR_out << "Invalid start specified: " << start;
+            HELP_printCmdSpecific( m_parsed_cmd, appName );
+         }
+
+         status = CMD_runRestoreI2C( client, &statusDC3, filename, start, dev, acc );
+
       } else if (m_vm.count("ram_test")) {            // "ram_test" cmd handling
          m_parsed_cmd = "ram_test";
 
@@ -469,6 +675,148 @@ int main(int argc, char *argv[])
 
          // Execute (and block) on this command
          status = CMD_runRamTest( client, &statusDC3 );
+
+      } else if (m_vm.count("get_board_info")) {  // "get_board_info" cmd handling
+         m_parsed_cmd = "get_board_info";
+
+         // Check for command specific help req
+         ARG_checkCmdSpecificHelp( m_parsed_cmd, appName, m_vm, client->isConnected() );
+
+         // No need to extract the value from the arg=value pair for this cmd.
+
+         // Execute (and block) on this command
+         status = CMD_runGetBoardInfo( client, &statusDC3 );
+
+      } else if (m_vm.count("discover")) {              // "discover" cmd handling
+         m_parsed_cmd = "discover";
+
+         // Check for command specific help req
+         ARG_checkCmdSpecificHelp( m_parsed_cmd, appName, m_vm, client->isConnected() );
+
+         uint16_t window = 0;
+         try {                      // Extract the value from the arg=value pair
+            // This call passes in a default value for an optional argument
+            ARG_parseNumStr( &window, "1000", "window", m_parsed_cmd, appName,
+                  m_vm[m_parsed_cmd].as<vector<string>>() );
+         } catch (exception& e) {
+            ERR_out << "Caught exception parsing arguments: " << e.what();
+            HELP_printCmdSpecific( m_parsed_cmd, appName );
+         }
+
+         // Only UDP can reach more than one board
+         if ( !m_vm.count("ip_address") || m_vm.count("tcp") ) {
+            ERR_out << "Boards can only be discovered over UDP";
+            HELP_printCmdSpecific( m_parsed_cmd, appName );
+         }
+
+         // Execute (and block) on this command
+         status = CMD_runDiscover( client, window );
+
+      } else if (m_vm.count("get_profile")) {        // "get_profile" cmd handling
+         m_parsed_cmd = "get_profile";
+
+         // Check for command specific help req
+         ARG_checkCmdSpecificHelp( m_parsed_cmd, appName, m_vm, client->isConnected() );
+
+         int reset = 0;
+         try {                      // Extract the value from the arg=value pair
+            // This call passes in a default value for an optional argument
+            ARG_parseNumStr( &reset, "0", "reset", m_parsed_cmd, appName,
+                  m_vm[m_parsed_cmd].as<vector<string>>() );
+         } catch (exception& e) {
+            ERR_out << "Caught exception parsing arguments: " << e.what();
+            HELP_printCmdSpecific( m_parsed_cmd, appName );
+         }
+
+         // Execute (and block) on this command
+         status = CMD_runGetProfile( client, &statusDC3, 0 != reset );
+
+      } else if (m_vm.count("get_mem_stats")) {    // "get_mem_stats" cmd handling
+         m_parsed_cmd = "get_mem_stats";
+
+         // Check for command specific help req
+         ARG_checkCmdSpecificHelp( m_parsed_cmd, appName, m_vm, client->isConnected() );
+
+         // No need to extract the value from the arg=value pair for this cmd.
+
+         // Execute (and block) on this command
+         status = CMD_runGetMemStats( client, &statusDC3 );
+
+      } else if (m_vm.count("get_cpu_load")) {      // "get_cpu_load" cmd handling
+         m_parsed_cmd = "get_cpu_load";
+
+         // Check for command specific help req
+         ARG_checkCmdSpecificHelp( m_parsed_cmd, appName, m_vm, client->isConnected() );
+
+         int reset = 0;
+         try {                      // Extract the value from the arg=value pair
+            // This call passes in a default value for an optional argument
+            ARG_parseNumStr( &reset, "0", "reset", m_parsed_cmd, appName,
+                  m_vm[m_parsed_cmd].as<vector<string>>() );
+         } catch (exception& e) {
+            ERR_out << "Caught exception parsing arguments: " << e.what();
+            HELP_printCmdSpecific( m_parsed_cmd, appName );
+         }
+
+         // Execute (and block) on this command
+         status = CMD_runGetCpuLoad( client, &statusDC3, 0 != reset );
+
+      } else if (m_vm.count("health_top")) {          // "health_top" cmd handling
+         m_parsed_cmd = "health_top";
+
+         // Check for command specific help req
+         ARG_checkCmdSpecificHelp( m_parsed_cmd, appName, m_vm, client->isConnected() );
+
+         uint32_t interval = 0;
+         uint32_t count = 0;
+         try {                      // Extract the value from the arg=value pair
+            ARG_parseNumStr( &interval, "interval", m_parsed_cmd, appName,
+                  m_vm[m_parsed_cmd].as<vector<string>>() );
+            // This call passes in a default value for an optional argument
+            ARG_parseNumStr( &count, "0", "count", m_parsed_cmd, appName,
+                  m_vm[m_parsed_cmd].as<vector<string>>() );
+         } catch (exception& e) {
+            ERR_out << "Caught exception parsing arguments: " << e.what();
+            HELP_printCmdSpecific( m_parsed_cmd, appName );
+         }
+
+         // Execute (and block) on this command
+         status = CMD_runHealthTop( client, &statusDC3, interval, count );
+
+      } else if (m_vm.count("qs_trace")) {              // "qs_trace" cmd handling
+         m_parsed_cmd = "qs_trace";
+
+         // Check for command specific help req
+         ARG_checkCmdSpecificHelp( m_parsed_cmd, appName, m_vm, client->isConnected() );
+
+         uint32_t secs = 0;
+         string filename = "";
+         string dictFilename = "";
+         try {                      // Extract the value from the arg=value pair
+            ARG_parseNumStr( &secs, "secs", m_parsed_cmd, appName,
+                  m_vm[m_parsed_cmd].as<vector<string>>() );
+         } catch (exception& e) {
+            ERR_out << "Caught exception parsing arguments: " << e.what();
+            HELP_printCmdSpecific( m_parsed_cmd, appName );
+         }
+
+         // The file doesn't have to exist yet unless it's only being converted
+         if ( !ARG_getValue( filename, "file", m_vm[m_parsed_cmd].as<vector<string>>() ) ) {
+            ERR_out << "No file specified";
+            HELP_printCmdSpecific( m_parsed_cmd, appName );
+         }
+
+         // The dictionary file is optional
+         ARG_getValue( dictFilename, "dict", m_vm[m_parsed_cmd].as<vector<string>>() );
+
+         // The trace has its own UDP port so it doesn't go through the client
+         if ( 0 != secs && !m_vm.count("ip_address") ) {
+            ERR_out << "The trace can only be captured over ethernet";
+            HELP_printCmdSpecific( m_parsed_cmd, appName );
+         }
+
+         // Execute (and block) on this command
+         status = CMD_runQsTrace( m_ip_address, filename, secs, dictFilename );
       }
 
       // Now check if the user requested general help.  This has to be done
@@ -75,6 +75,7 @@ typedef enum API_DBG_MODULES {
    MODULE_COM   = 0x00000020, /**< Comm interface module */
    MODULE_API   = 0x00000040, /**< ClientApi module */
    MODULE_MSG   = 0x00000080, /**< Msg interface module */
+   MODULE_TCP   = 0x00000100, /**< TCP ethernet module debugging. */
 } ApiDbgModuleId_t;
 
 /**
@@ -67,8 +67,9 @@ typedef enum APIErrors
    API_ERR_SER_EXCEPTION_CAUGHT                                = 0x00010000,
    API_ERR_SER_MSG_BASE64_ENC_FAILED                           = 0x00010001,
 
-   /* UDP error category.                        0x00020000 - 0x0002FFFF */
+   /* Ethernet (UDP and TCP) error category.     0x00020000 - 0x0002FFFF */
    API_ERR_UDP_EXCEPTION_CAUGHT                                = 0x00020000,
+   API_ERR_TCP_EXCEPTION_CAUGHT                                = 0x00020001,
 
    /* Comm error category                        0x00030000 - 0x0003FFFF */
    API_ERR_COMM_NOT_SET                                        = 0x00030000,
@@ -82,10 +83,14 @@ typedef enum APIErrors
    API_ERR_MSG_MISSING_EXPECTED_PAYLOAD                        = 0x00040005,
    API_ERR_MSG_UNKNOWN_PAYLOAD                                 = 0x00040006,
    API_ERR_MSG_UNABLE_TO_GET_FROM_QUEUE                        = 0x00040007,
+   API_ERR_MSG_OUT_OF_SEQUENCE                                 = 0x00040008,
+   API_ERR_MSG_INVALID_CRC                                     = 0x00040009,
 
    /* Memory error category                      0x00050000 - 0x0005FFFF */
    API_ERR_MEM_NULL_VALUE                                      = 0x00050000,
    API_ERR_MEM_BUFFER_LEN                                      = 0x00050001,
+   API_ERR_MEM_UNABLE_TO_WRITE_FILE                            = 0x00050002,
+   API_ERR_MEM_OUT_OF_RANGE                                    = 0x00050003,
 
    /* FW loader error category                   0x00060000 - 0x0006FFFF */
    API_ERR_FW_FILENAME_INVALID                                 = 0x00060000,
@@ -13,6 +13,10 @@
 #include <boost/thread/thread.hpp>
 #include <boost/atomic.hpp>
 #include <boost/lockfree/queue.hpp>
+#include <boost/crc.hpp>
+#include <vector>
+#include <deque>
+#include <utility>
 
 /* Lib includes */
 #include "ClientApi.h"
@@ -34,9 +38,39 @@ using namespace std;
 MODULE_NAME( MODULE_API );
 
 /* Private typedefs ----------------------------------------------------------*/
+
+/**
+ * @brief   A single I2C Req sent as part of reading or writing a range.
+ */
+typedef struct {
+   unsigned int msgId;                   /**< Msg ID the Req was sent with */
+   size_t offset;                /**< Offset of the chunk into the range */
+   size_t len;                                 /**< Length of the chunk */
+} I2CChunk_t;
+
+/**
+ * @brief   A single FW data packet sent as part of a FW image.
+ */
+typedef struct {
+   unsigned int msgId;                   /**< Msg ID the Req was sent with */
+   uint16_t seqNum;                   /**< Sequence number of the packet */
+   size_t len;                                /**< Length of the packet */
+   uint32_t crc;                                 /**< CRC of the packet */
+} FWPacket_t;
+
 /* Private defines -----------------------------------------------------------*/
 #define TIME_POLLING_MSEC  1  /**< Number of ms to wait between polling queue */
 
+/**< Number of I2C Reqs to keep in flight when reading or writing a range.  DC3
+ * holds on to the ones it can't get to yet so this has to stay below the depth
+ * of the deferred queue in its CommMgr. */
+#define I2C_RANGE_MAX_IN_FLIGHT  4
+
+/**< Number of FW data packets to keep in flight over the TCP sys port.  DC3
+ * only takes a few of them off the connection at a time and leaves the rest to
+ * the TCP window so this can be deeper than the deferred queue in CommMgr. */
+#define FW_TCP_MAX_IN_FLIGHT     16
+
 /* Private macros ------------------------------------------------------------*/
 /* Private variables and Local objects ---------------------------------------*/
 
@@ -206,12 +240,8 @@ APIError_t ClientApi::DC3_flashFW(
    this->disableMsgCallbacks(); /* There are too many msgs flying about for us
    to log all of them so just turn this off */
 
-   /* These will be used for responses */
-   DC3BasicMsg basicMsg;
-   DC3PayloadMsgUnion_t payloadMsgUnion;
    APIError_t clientStatus = API_ERR_NONE;
 
-
    /* First, check if DC3 is in bootloader mode and if not, send a SetMode cmd
     * so that the user doesn't have to worry about doing it */
    DC3BootMode_t currentBootMode = _DC3_NoBootMode;
@@ -246,6 +276,151 @@ APIError_t ClientApi::DC3_flashFW(
       }
    }
 
+   return( this->sendFWImage(status, type, filename, true) );
+}
+
+/******************************************************************************/
+APIError_t ClientApi::DC3_stageFW(
+      DC3Error_t *status,
+      DC3BootMode_t type,
+      const char* filename
+)
+{
+   /* Staging only makes sense while the Application is running.  Don't reset
+    * DC3 here since the whole point is to keep it in service. */
+   DC3BootMode_t currentBootMode = _DC3_NoBootMode;
+   APIError_t clientStatus = this->DC3_getMode(status, &currentBootMode);
+   if ( clientStatus != API_ERR_NONE ) {
+      ERR_printf(m_pLog, "Unable to get current DC3 bootmode. Client Error: 0x%08x", clientStatus);
+      return clientStatus;
+   }
+   if ( *status != ERR_NONE ) {
+      ERR_printf(m_pLog, "DC3 returned error 0x%08x when attempting to get current bootmode", *status);
+      return clientStatus;
+   }
+   if ( currentBootMode != _DC3_Application ) {
+      *status = ERR_MSG_UNSUPPORTED_IN_BOOTLOADER;
+      ERR_printf(m_pLog, "DC3 has to be in Application mode to stage FW. Use flash instead.");
+      return clientStatus;
+   }
+
+   this->disableMsgCallbacks(); /* There are too many msgs flying about for us
+   to log all of them so just turn this off */
+
+   clientStatus = this->sendFWImage(status, type, filename, false);
+   if ( API_ERR_NONE == clientStatus && ERR_NONE == *status ) {
+      LOG_printf(m_pLog, "FW image staged. It will be installed on the next DC3 reboot.");
+   }
+   return( clientStatus );
+}
+
+/******************************************************************************/
+APIError_t ClientApi::DC3_getFWSectorCRCs(
+      DC3Error_t *status,
+      DC3BootMode_t type,
+      uint32_t imageSize,
+      uint32_t *pCrcs,
+      uint32_t *pSizes,
+      const size_t arraySize,
+      size_t *pNumSectors
+)
+{
+   this->enableMsgCallbacks();
+
+   /* These will be used for responses */
+   DC3BasicMsg basicMsg;
+   DC3PayloadMsgUnion_t payloadMsgUnion;
+
+   *pNumSectors = 0;
+
+   /* Common settings for most messages */
+   this->m_basicMsg._msgID       = this->m_msgId;
+   this->m_basicMsg._msgReqProg  = (unsigned long)this->m_bRequestProg;
+   this->m_basicMsg._msgRoute    = this->m_msgRoute;
+   this->m_basicMsg._msgType     = _DC3_Req;
+   this->m_basicMsg._msgName     = _DC3FlashSectorCrcMsg;
+   this->m_basicMsg._msgPayload  = _DC3FlashSectorCrcPayloadMsg;
+
+   memset(&m_flashSectorCrcPayloadMsg, 0, sizeof(m_flashSectorCrcPayloadMsg));
+   this->m_flashSectorCrcPayloadMsg._errorCode = ERR_NONE; // Ignored in Req msgs.
+   this->m_flashSectorCrcPayloadMsg._imageType = type;
+   this->m_flashSectorCrcPayloadMsg._imageSize = imageSize;
+
+   size_t size = DC3_MAX_MSG_LEN;
+   uint8_t *buffer = new uint8_t[size];                       // Allocate buffer
+   unsigned int bufferLen = 0;
+   bufferLen = DC3BasicMsg_write_delimited_to(&m_basicMsg, buffer, 0);
+   bufferLen = DC3FlashSectorCrcPayloadMsg_write_delimited_to(&m_flashSectorCrcPayloadMsg, buffer, bufferLen);
+   l_pComm->write_some((char *)buffer, bufferLen);                   // Send Req
+
+   delete[] buffer;                                             // Delete buffer
+
+   memset(&basicMsg, 0, sizeof(basicMsg));
+   memset(&payloadMsgUnion, 0, sizeof(payloadMsgUnion));
+   APIError_t clientStatus = waitForResp(                        // Wait for Ack
+         &basicMsg,
+         &payloadMsgUnion,
+         HL_MAX_TOUT_SEC_CLI_WAIT_FOR_ACK
+   );
+
+   if ( API_ERR_NONE != clientStatus ) {                       // Check response
+      ERR_printf(m_pLog,
+            "Waiting for Ack received client Error: 0x%08x", clientStatus);
+      return clientStatus;
+   }
+
+   memset(&basicMsg, 0, sizeof(basicMsg));
+   memset(&payloadMsgUnion, 0, sizeof(payloadMsgUnion));
+   clientStatus = waitForResp(                                 // Check response
+         &basicMsg,
+         &payloadMsgUnion,
+         HL_MAX_TOUT_SEC_CLI_WAIT_FOR_SIMPLE_MSG_DONE
+   );
+   if ( API_ERR_NONE != clientStatus ) {                       // Check response
+      ERR_printf(m_pLog,
+            "Waiting for Done received client Error: 0x%08x", clientStatus);
+      return clientStatus;
+   }
+
+   /* DC3 responds with a status payload if it doesn't support this msg */
+   if ( _DC3FlashSectorCrcPayloadMsg != basicMsg._msgPayload ) {
+      *status = (DC3Error_t)payloadMsgUnion.statusPayload._errorCode;
+      return clientStatus;
+   }
+
+   *status = (DC3Error_t)payloadMsgUnion.flashSectorCrcPayload._errorCode;
+
+   /* The generated repeated fields are unsigned long which is 64 bits on some
+    * hosts so copy these one at a time instead of using memcpy. */
+   size_t nSectors = payloadMsgUnion.flashSectorCrcPayload._sectorCrc_repeated_len;
+   if ( nSectors > (size_t)payloadMsgUnion.flashSectorCrcPayload._sectorSize_repeated_len ) {
+      nSectors = payloadMsgUnion.flashSectorCrcPayload._sectorSize_repeated_len;
+   }
+   if ( nSectors > arraySize ) {
+      nSectors = arraySize;
+   }
+   for ( size_t i = 0; i < nSectors; i++ ) {
+      pCrcs[i]  = (uint32_t)payloadMsgUnion.flashSectorCrcPayload._sectorCrc[i];
+      pSizes[i] = (uint32_t)payloadMsgUnion.flashSectorCrcPayload._sectorSize[i];
+   }
+   *pNumSectors = nSectors;
+
+   return clientStatus;
+}
+
+/******************************************************************************/
+APIError_t ClientApi::sendFWImage(
+      DC3Error_t *status,
+      DC3BootMode_t type,
+      const char* filename,
+      bool bDelta
+)
+{
+   /* These will be used for responses */
+   DC3BasicMsg basicMsg;
+   DC3PayloadMsgUnion_t payloadMsgUnion;
+   APIError_t clientStatus = API_ERR_NONE;
+
    FWLdr *fw = NULL;
    try {
       fw = new FWLdr( m_pLog );
@@ -261,6 +436,107 @@ APIError_t ClientApi::DC3_flashFW(
 
    uint8_t chunkSize = 112; /* This is the safest amount of data to send */
 
+   /* Parts of the FW image to send as (offset, length) pairs.  This is the
+    * whole image unless only the flash sectors that changed are sent. */
+   vector< pair<size_t, size_t> > ranges;
+   uint32_t sectorMask = 0;
+   bool bCompress = true;
+
+   if ( bDelta ) {
+      uint32_t sectorCrcs[MAX_REPEATED_LEN];
+      uint32_t sectorSizes[MAX_REPEATED_LEN];
+      size_t nSectors = 0;
+      size_t offset = 0;
+      DC3Error_t sectorStatus = ERR_NONE;
+      APIError_t sectorClientStatus = this->DC3_getFWSectorCRCs(
+            &sectorStatus,
+            type,
+            fw->getSize(),
+            sectorCrcs,
+            sectorSizes,
+            MAX_REPEATED_LEN,
+            &nSectors
+      );
+      this->disableMsgCallbacks();   /* Re-enabled by DC3_getFWSectorCRCs() */
+
+      if ( API_ERR_NONE == sectorClientStatus && ERR_NONE == sectorStatus ) {
+         for ( size_t i = 0; i < nSectors && i < 32; i++ ) {
+            if ( sectorCrcs[i] != fw->getRangeCRC32( offset, sectorSizes[i] ) ) {
+               sectorMask |= ( 1UL << i );
+               ranges.push_back( make_pair( offset, (size_t)sectorSizes[i] ) );
+            }
+            offset += sectorSizes[i];
+         }
+      }
+
+      if ( offset != fw->getSize() ) {
+         WRN_printf(
+               m_pLog,
+               "Unable to compare FW image to flash sectors on DC3 (client "
+               "error: 0x%08x, DC3 error: 0x%08x).  Sending the entire image.",
+               sectorClientStatus, sectorStatus
+         );
+         sectorMask = 0;
+         ranges.clear();
+         bCompress = false; /* Older Bootloaders can't decompress either */
+      } else if ( 0 == sectorMask ) {
+         /* Nothing changed but the metadata still has to be rewritten */
+         sectorMask = 1;
+         ranges.push_back( make_pair( (size_t)0, (size_t)sectorSizes[0] ) );
+      }
+   }
+
+   if ( ranges.empty() ) {
+      ranges.push_back( make_pair( (size_t)0, fw->getSize() ) );
+   }
+
+   /* Split the ranges into FW data packets.  Each range is compressed on its
+    * own and compression is only used if it actually saves some packets. */
+   size_t nBytesToSend = 0;
+   size_t nRawPackets = 0;
+   for ( size_t r = 0; r < ranges.size(); r++ ) {
+      nBytesToSend += ranges[r].second;
+      nRawPackets += ( ranges[r].second + chunkSize - 1 ) / chunkSize;
+   }
+
+   vector< vector<uint8_t> > packets;
+   DC3Compression_t compression = _DC3_COMPRESSION_NONE;
+   if ( bCompress ) {
+      size_t nCompressedBytes = 0;
+      for ( size_t r = 0; r < ranges.size(); r++ ) {
+         nCompressedBytes += fw->compressRange(
+               ranges[r].first,
+               ranges[r].second,
+               chunkSize,
+               packets
+         );
+      }
+
+      if ( packets.size() < nRawPackets ) {
+         compression = _DC3_COMPRESSION_LZSS;
+         LOG_printf(m_pLog, "Compressed %d bytes of FW image data to %d bytes (%d packets instead of %d)",
+               nBytesToSend, nCompressedBytes, packets.size(), nRawPackets);
+      } else {
+         packets.clear();
+      }
+   }
+
+   if ( packets.empty() ) {
+      for ( size_t r = 0; r < ranges.size(); r++ ) {
+         size_t rangeEnd = ranges[r].first + ranges[r].second;
+         fw->setFWChunkIndex( ranges[r].first );
+         while ( fw->getFWChunkIndex() < rangeEnd ) {
+            size_t packetSize = rangeEnd - fw->getFWChunkIndex();
+            if ( packetSize > chunkSize ) {
+               packetSize = chunkSize;
+            }
+            vector<uint8_t> packet( packetSize );
+            fw->getChunk( packetSize, &packet[0] );
+            packets.push_back( packet );
+         }
+      }
+   }
+
    /* Common settings for most messages */
    this->m_basicMsg._msgID       = this->m_msgId;
    this->m_basicMsg._msgReqProg  = 0;
@@ -278,7 +554,10 @@ APIError_t ClientApi::DC3_flashFW(
    this->m_flashMetaPayloadMsg._imageMaj = fw->getMajVer();
    this->m_flashMetaPayloadMsg._imageMin = fw->getMinVer();
    this->m_flashMetaPayloadMsg._imageSize = fw->getSize();
-   this->m_flashMetaPayloadMsg._imageNumPackets = fw->calcNumberOfPackets( chunkSize );
+   this->m_flashMetaPayloadMsg._imageNumPackets = packets.size();
+   this->m_flashMetaPayloadMsg._imageSectorMask = sectorMask;
+   this->m_flashMetaPayloadMsg._imageCompression = compression;
+   this->m_flashMetaPayloadMsg._imageResumeSeq = 0; // Only used in responses
    this->m_flashMetaPayloadMsg._imageDatetime_len = fw->getDatetimeLen();
    memcpy(
          this->m_flashMetaPayloadMsg._imageDatetime,
@@ -290,6 +569,10 @@ APIError_t ClientApi::DC3_flashFW(
    LOG_printf(m_pLog, "FW image built on: %s", this->m_flashMetaPayloadMsg._imageDatetime);
    LOG_printf(m_pLog, "FW image CRC is: 0x%08x", this->m_flashMetaPayloadMsg._imageCrc);
    LOG_printf(m_pLog, "FW image size is: %d", this->m_flashMetaPayloadMsg._imageSize);
+   if ( 0 != sectorMask ) {
+      LOG_printf(m_pLog, "Only sending changed flash sectors (mask 0x%08x, %d of %d bytes)",
+            sectorMask, nBytesToSend, this->m_flashMetaPayloadMsg._imageSize);
+   }
 
    /* Buffer and counter to use for sending messages. We could allocated when
     * needed but it's a lot slower */
@@ -332,117 +615,157 @@ APIError_t ClientApi::DC3_flashFW(
       ERR_printf(m_pLog,
             "Waiting for Done received client Error: 0x%08x", clientStatus);
       return clientStatus;
+   }
+
+   /* DC3 echoes the metadata back with the last packet it already has if a
+    * previous attempt to flash this same image was aborted. */
+   uint16_t nResumeSeqNum = 0;
+   if ( _DC3FlashMetaPayloadMsg == basicMsg._msgPayload ) {
+      *status = (DC3Error_t)payloadMsgUnion.flashMetaPayload._errorCode;
+      nResumeSeqNum = payloadMsgUnion.flashMetaPayload._imageResumeSeq;
    } else {
       *status = (DC3Error_t)payloadMsgUnion.statusPayload._errorCode;
-      if ( ERR_NONE != *status ) {
-         ERR_printf(m_pLog, "Status from DC3: 0x%08x", *status);
-         return clientStatus;
-      }
    }
 
-   /* 4. Cycle through the FW image and send out FW data packets until done. */
+   if ( ERR_NONE != *status ) {
+      ERR_printf(m_pLog, "Status from DC3: 0x%08x", *status);
+      return clientStatus;
+   }
+
+   /* 4. Cycle through the FW data packets and send them out until done. */
+   if ( nResumeSeqNum > 0 && nResumeSeqNum < packets.size() ) {
+      LOG_printf(m_pLog,
+            "Resuming FW transfer after packet %d of %d total...",
+            nResumeSeqNum, this->m_flashMetaPayloadMsg._imageNumPackets);
+   } else {
+      nResumeSeqNum = 0;
+   }
+
+   /* Over the TCP sys port, several packets are kept in flight at once since
+    * DC3 handles them in order and TCP takes care of getting them there.  Every
+    * other connection sends one packet at a time. */
+   size_t nMaxInFlight = ( _DC3_EthSys == this->m_msgRoute ) ? FW_TCP_MAX_IN_FLIGHT : 1;
+   std::deque<FWPacket_t> inFlight;
+   size_t nextPacket = nResumeSeqNum;
    size_t bytesTransferred = 0;
-   uint16_t nPacketSeqNum = 0;
-   while ( bytesTransferred < this->m_flashMetaPayloadMsg._imageSize ) {
-
-      this->m_msgId++;                  /* Increment msg id for every new send*/
-      nPacketSeqNum++; /* Increment right away so the first packet is 1 not 0 */
-
-      /* Set up the basic msg */
-      this->m_basicMsg._msgID       = this->m_msgId;
-      this->m_basicMsg._msgReqProg  = 0;
-      this->m_basicMsg._msgRoute    = this->m_msgRoute;
-      this->m_basicMsg._msgType     = _DC3_Req;
-      this->m_basicMsg._msgName     = _DC3FlashMsg;
-      this->m_basicMsg._msgPayload  = _DC3FlashDataPayloadMsg;
-
-      uint32_t crc = 0;
-      /* Set up the payload */
-      memset(&m_flashDataPayloadMsg, 0, sizeof(m_flashDataPayloadMsg));
-      m_flashDataPayloadMsg._dataBuf_len = fw->getChunkAndCRC( chunkSize, (uint8_t *)(m_flashDataPayloadMsg._dataBuf), &crc );
-      m_flashDataPayloadMsg._dataCrc = crc;
-      m_flashDataPayloadMsg._seqCurr = nPacketSeqNum;
-
-      /* Only log every 100th packet since it gets way too chatty otherwise */
-      if ( nPacketSeqNum % 100 == 0 ) {
-         LOG_printf(m_pLog,
-               "Sending FW data packet %d of %d total...",
-               nPacketSeqNum, this->m_flashMetaPayloadMsg._imageNumPackets);
-      }
+   while ( nextPacket < packets.size() || !inFlight.empty() ) {
+
+      /* Keep the pipeline full as long as everything is going fine */
+      while ( nextPacket < packets.size() && inFlight.size() < nMaxInFlight &&
+              API_ERR_NONE == clientStatus && ERR_NONE == *status ) {
+         FWPacket_t packet;
+         packet.seqNum = nextPacket + 1;  /* The first packet is 1, not 0 */
+         packet.msgId = ++this->m_msgId;  /* Increment msg id for every new send*/
+         packet.len = packets[nextPacket].size();
+
+         /* Set up the basic msg */
+         this->m_basicMsg._msgID       = packet.msgId;
+         this->m_basicMsg._msgReqProg  = 0;
+         this->m_basicMsg._msgRoute    = this->m_msgRoute;
+         this->m_basicMsg._msgType     = _DC3_Req;
+         this->m_basicMsg._msgName     = _DC3FlashMsg;
+         this->m_basicMsg._msgPayload  = _DC3FlashDataPayloadMsg;
+
+         /* Set up the payload */
+         memset(&m_flashDataPayloadMsg, 0, sizeof(m_flashDataPayloadMsg));
+         m_flashDataPayloadMsg._dataBuf_len = packet.len;
+         memcpy(m_flashDataPayloadMsg._dataBuf, &packets[nextPacket][0], packet.len);
+         packet.crc = fw->calcCRC32( &packets[nextPacket][0], packet.len );
+         m_flashDataPayloadMsg._dataCrc = packet.crc;
+         m_flashDataPayloadMsg._seqCurr = packet.seqNum;
+
+         /* Only log every 100th packet since it gets way too chatty otherwise */
+         if ( packet.seqNum % 100 == 0 ) {
+            LOG_printf(m_pLog,
+                  "Sending FW data packet %d of %d total...",
+                  packet.seqNum, this->m_flashMetaPayloadMsg._imageNumPackets);
+         }
 
-      /* 5. Send the Flashmsg wih FlashDataPayloadMsg */
-      memset(buffer, 0, sizeof(buffer));
-      bufferLen = 0;
-      bufferLen = DC3BasicMsg_write_delimited_to(&m_basicMsg, buffer, 0);
-      bufferLen = DC3FlashDataPayloadMsg_write_delimited_to(&m_flashDataPayloadMsg, buffer, bufferLen);
-//      DBG_printf(m_pLog, "BufferLen is %d", bufferLen);
-      l_pComm->write_some((char *)buffer, bufferLen);                // Send Req
+         /* 5. Send the Flashmsg wih FlashDataPayloadMsg */
+         memset(buffer, 0, sizeof(buffer));
+         bufferLen = 0;
+         bufferLen = DC3BasicMsg_write_delimited_to(&m_basicMsg, buffer, 0);
+         bufferLen = DC3FlashDataPayloadMsg_write_delimited_to(&m_flashDataPayloadMsg, buffer, bufferLen);
+         l_pComm->write_some((char *)buffer, bufferLen);             // Send Req
 
-      /* 6. Wait for Ack */
-      memset(&basicMsg, 0, sizeof(basicMsg));
-      memset(&payloadMsgUnion, 0, sizeof(payloadMsgUnion));
-      clientStatus = waitForResp(                               // Wait for Done
-            &basicMsg,
-            &payloadMsgUnion,
-            HL_MAX_TOUT_SEC_CLI_WAIT_FOR_ACK
-      );
+         inFlight.push_back( packet );
+         nextPacket++;
+      }
 
-      if ( API_ERR_NONE != clientStatus ) {                    // Check response
-         ERR_printf(m_pLog,
-               "Waiting for Ack received client Error: 0x%08x", clientStatus);
-         return clientStatus;
+      if ( inFlight.empty() ) {
+         break;                   /* Stopped early and nothing left to drain */
       }
 
-      /* 7. Wait for Done */
+      /* 6. Wait for the Ack and the Done of the oldest packet */
       memset(&basicMsg, 0, sizeof(basicMsg));
       memset(&payloadMsgUnion, 0, sizeof(payloadMsgUnion));
-      clientStatus = waitForResp(
+      APIError_t respStatus = waitForResp(
             &basicMsg,
             &payloadMsgUnion,
             5
       );
 
       /* Make sure there were no intenal client errors. */
-      if ( API_ERR_NONE != clientStatus ) {
+      if ( API_ERR_NONE != respStatus ) {
          ERR_printf(
                m_pLog,
                "DC3 client failed with error 0x%08x during FW update while "
                "trying to send FW data packet %d of %d total with CRC 0x%08x",
-               clientStatus, nPacketSeqNum,
-               m_flashMetaPayloadMsg._imageNumPackets, crc
+               respStatus, inFlight.front().seqNum,
+               m_flashMetaPayloadMsg._imageNumPackets, inFlight.front().crc
          );
-         return( clientStatus );
+         return( respStatus );
       }
 
-      /* Make sure the status of the done msg has no errors */
+      /* Only the Done msgs matter.  The Acks just say that DC3 got to the Req. */
+      if ( _DC3_Done != basicMsg._msgType ) {
+         continue;
+      }
+
+      FWPacket_t packet = inFlight.front();
+      inFlight.pop_front();
+
+      if ( packet.msgId != basicMsg._msgID ) {
+         clientStatus = API_ERR_MSG_OUT_OF_SEQUENCE;
+         ERR_printf(m_pLog, "Expected Done for msgId %d but got %d. Error: 0x%08x",
+               packet.msgId, basicMsg._msgID, clientStatus);
+         continue;
+      }
+
+      /* Once something went wrong, just drain whatever was already on its way */
+      if ( API_ERR_NONE != clientStatus || ERR_NONE != *status ) {
+         continue;
+      }
+
+      /* 7. Make sure the status of the done msg has no errors */
       *status = (DC3Error_t)payloadMsgUnion.statusPayload._errorCode;
       if ( ERR_NONE != *status ) {
          ERR_printf(
                m_pLog,
                "DC3 failed with error 0x%08x during FW update while trying to "
                "write FW data packet %d of %d total with CRC 0x%08x",
-               *status, nPacketSeqNum,
-               m_flashMetaPayloadMsg._imageNumPackets, crc
+               *status, packet.seqNum,
+               m_flashMetaPayloadMsg._imageNumPackets, packet.crc
          );
-         return( clientStatus );
+         continue;
       }
 
       /* If we got here, everything is ok so far and we can either loop back
        * around and do the next packet or exit depending if everything has been
        * transfered. */
-      bytesTransferred += m_flashDataPayloadMsg._dataBuf_len;
+      bytesTransferred += packet.len;
 
-      if ( nPacketSeqNum == m_flashMetaPayloadMsg._imageNumPackets ) { // Last packet
+      if ( packet.seqNum == m_flashMetaPayloadMsg._imageNumPackets ) { // Last packet
          DBG_printf(
                m_pLog,
                "This should be the last packet (%d of %d total)...",
-               nPacketSeqNum, this->m_flashMetaPayloadMsg._imageNumPackets
+               packet.seqNum, this->m_flashMetaPayloadMsg._imageNumPackets
          );
          DBG_printf(
                m_pLog,
-               "bytesTransferred: %d (of %d total), nPacketSeqNum %d (of %d total)",
-               bytesTransferred, m_flashMetaPayloadMsg._imageSize,
-               nPacketSeqNum, m_flashMetaPayloadMsg._imageNumPackets
+               "bytesTransferred: %d (%d bytes of FW image), nPacketSeqNum %d (of %d total)",
+               bytesTransferred, nBytesToSend,
+               packet.seqNum, m_flashMetaPayloadMsg._imageNumPackets
          );
       }
    }
@@ -613,6 +936,53 @@ APIError_t ClientApi::DC3_writeI2C(
    return clientStatus;
 }
 
+/******************************************************************************/
+APIError_t ClientApi::DC3_readI2CRange(
+      DC3Error_t *status,
+      size_t *pBytesRead,
+      uint8_t *pBuffer,
+      const size_t bufferSize,
+      const size_t bytes,
+      const int start,
+      const DC3I2CDevice_t dev,
+      const DC3AccessType_t  acc
+)
+{
+   *pBytesRead = 0;
+   if ( NULL == pBuffer ) {
+      ERR_printf(m_pLog, "Buffer to read I2C data into is NULL");
+      return API_ERR_MEM_NULL_VALUE;
+   }
+   if ( bufferSize < bytes ) {
+      ERR_printf(m_pLog, "Buffer of %d bytes can't hold %d bytes of I2C data",
+            bufferSize, bytes);
+      return API_ERR_MEM_BUFFER_LEN;
+   }
+
+   return this->xferI2CRange( status, NULL, pBuffer, bytes, start, dev, acc,
+         pBytesRead );
+}
+
+/******************************************************************************/
+APIError_t ClientApi::DC3_writeI2CRange(
+      DC3Error_t *status,
+      const uint8_t* const pBuffer,
+      const size_t bytes,
+      const int start,
+      const DC3I2CDevice_t dev,
+      const DC3AccessType_t  acc
+)
+{
+   if ( NULL == pBuffer ) {
+      ERR_printf(m_pLog, "Buffer with I2C data to write is NULL");
+      return API_ERR_MEM_NULL_VALUE;
+   }
+
+   size_t bytesWritten = 0;
+   return this->xferI2CRange( status, pBuffer, NULL, bytes, start, dev, acc,
+         &bytesWritten );
+}
+
 /******************************************************************************/
 APIError_t ClientApi::DC3_ramTest(
       DC3Error_t *status,
@@ -681,39 +1051,59 @@ APIError_t ClientApi::DC3_ramTest(
 }
 
 /******************************************************************************/
-APIError_t ClientApi::DC3_getDbgModules(
+APIError_t ClientApi::DC3_readMem(
       DC3Error_t *status,
-      uint32_t* dbgModules
+      DC3MemSpace_t memSpace,
+      uint32_t offset,
+      uint32_t length,
+      uint8_t *pBuffer,
+      const size_t bufferSize,
+      size_t *pBytesRead
 )
 {
+   *pBytesRead = 0;
+   if ( NULL == pBuffer ) {
+      ERR_printf(m_pLog, "Buffer to read memory into is NULL");
+      return API_ERR_MEM_NULL_VALUE;
+   }
+   if ( bufferSize < length ) {
+      ERR_printf(m_pLog, "Buffer of %d bytes can't hold %d bytes of memory",
+            bufferSize, length);
+      return API_ERR_MEM_BUFFER_LEN;
+   }
 
-   this->enableMsgCallbacks();
+   this->disableMsgCallbacks(); /* There are too many msgs flying about for us
+   to log all of them so just turn this off */
 
    /* These will be used for responses */
    DC3BasicMsg basicMsg;
    DC3PayloadMsgUnion_t payloadMsgUnion;
 
-   /* Common settings for most messages */
+   /* The credit msgs reuse this msg ID so it has to be a new one */
+   this->m_msgId++;
    this->m_basicMsg._msgID       = this->m_msgId;
-   this->m_basicMsg._msgReqProg  = (unsigned long)this->m_bRequestProg;
+   this->m_basicMsg._msgReqProg  = 0;
    this->m_basicMsg._msgRoute    = this->m_msgRoute;
-
-   /* Settings specific to this message */
    this->m_basicMsg._msgType     = _DC3_Req;
-   this->m_basicMsg._msgName     = _DC3DbgGetCurrentMsg;
-   this->m_basicMsg._msgPayload  = _DC3NoMsg;
+   this->m_basicMsg._msgName     = _DC3MemReadMsg;
+   this->m_basicMsg._msgPayload  = _DC3MemDataPayloadMsg;
 
-   size_t size = DC3_MAX_MSG_LEN;
-   uint8_t *buffer = new uint8_t[size];                       // Allocate buffer
+   memset(&m_memDataPayloadMsg, 0, sizeof(m_memDataPayloadMsg));
+   this->m_memDataPayloadMsg._errorCode = ERR_NONE; // Ignored in Req msgs.
+   this->m_memDataPayloadMsg._memSpace  = memSpace;
+   this->m_memDataPayloadMsg._offset    = offset;
+   this->m_memDataPayloadMsg._length    = length;
+   this->m_memDataPayloadMsg._credits   = DC3_MEM_READ_MAX_CREDITS;
+
+   uint8_t buffer[DC3_MAX_MSG_LEN];
    unsigned int bufferLen = 0;
    bufferLen = DC3BasicMsg_write_delimited_to(&m_basicMsg, buffer, 0);
+   bufferLen = DC3MemDataPayloadMsg_write_delimited_to(&m_memDataPayloadMsg, buffer, bufferLen);
    l_pComm->write_some((char *)buffer, bufferLen);                   // Send Req
 
-   delete[] buffer;                                             // Delete buffer
-
    memset(&basicMsg, 0, sizeof(basicMsg));
    memset(&payloadMsgUnion, 0, sizeof(payloadMsgUnion));
-   APIError_t clientStatus = waitForResp(                     // Wait for Ack
+   APIError_t clientStatus = waitForResp(                        // Wait for Ack
          &basicMsg,
          &payloadMsgUnion,
          HL_MAX_TOUT_SEC_CLI_WAIT_FOR_ACK
@@ -725,37 +1115,781 @@ APIError_t ClientApi::DC3_getDbgModules(
       return clientStatus;
    }
 
-   memset(&basicMsg, 0, sizeof(basicMsg));
-   memset(&payloadMsgUnion, 0, sizeof(payloadMsgUnion));
-   clientStatus = waitForResp(                                 // Check response
-         &basicMsg,
-         &payloadMsgUnion,
-         HL_MAX_TOUT_SEC_CLI_WAIT_FOR_SIMPLE_MSG_DONE
-   );
-   if ( API_ERR_NONE != clientStatus ) {                       // Check response
-      ERR_printf(m_pLog,
-            "Waiting for Done received client Error: 0x%08x", clientStatus);
-      return clientStatus;
-   } else {
-      *status = (DC3Error_t)payloadMsgUnion.dbgPayload._errorCode;
-      *dbgModules = payloadMsgUnion.dbgPayload._dbgSettings;
-   }
+   /* The data comes back as Prog msgs followed by a single Done.  More credits
+    * are handed out every half a window so DC3 doesn't have to stop and wait
+    * for them.  None are sent once DC3 has enough to finish since it would
+    * take a late one for a brand new request. */
+   APIError_t frameStatus = API_ERR_NONE;
+   uint32_t seqExpected = 1;
+   uint16_t creditsUsed = 0;
+   uint32_t framesTotal = (length + DC3_MEM_READ_FRAME_LEN - 1) / DC3_MEM_READ_FRAME_LEN;
+   uint32_t framesGranted = DC3_MEM_READ_MAX_CREDITS;
+   while ( true ) {
+      memset(&basicMsg, 0, sizeof(basicMsg));
+      memset(&payloadMsgUnion, 0, sizeof(payloadMsgUnion));
+      clientStatus = waitForResp(
+            &basicMsg,
+            &payloadMsgUnion,
+            LL_MAX_TOUT_SEC_COMM_MEM_READ_CREDIT
+      );
 
-   return clientStatus;
+      if ( API_ERR_NONE != clientStatus ) {                    // Check response
+         ERR_printf(m_pLog,
+               "Waiting for memory frame %d received client Error: 0x%08x",
+               seqExpected, clientStatus);
+         return clientStatus;
+      }
 
-}
+      if ( _DC3_Done == basicMsg._msgType ) {
+         break;
+      }
 
-/******************************************************************************/
-APIError_t ClientApi::DC3_setDbgModules(
-      DC3Error_t* status,
-      uint32_t* dbgModuleSet,
-      bool bEnable,
-      bool bOverWrite
-)
-{
-   this->enableMsgCallbacks();
+      /* Once the read is aborted, just drain whatever was already on its way */
+      if ( _DC3_Prog != basicMsg._msgType ||
+           _DC3MemDataPayloadMsg != basicMsg._msgPayload ||
+           API_ERR_NONE != frameStatus ) {
+         continue;
+      }
 
-   /* These will be used for responses */
+      struct DC3MemDataPayloadMsg *pFrame = &payloadMsgUnion.memDataPayload;
+      boost::crc_32_type crc;
+      crc.process_bytes( pFrame->_dataBuf, pFrame->_dataBuf_len );
+
+      if ( seqExpected != pFrame->_seqCurr ) {
+         frameStatus = API_ERR_MSG_OUT_OF_SEQUENCE;
+         ERR_printf(m_pLog, "Expected memory frame %d but got %d. Error: 0x%08x",
+               seqExpected, pFrame->_seqCurr, frameStatus);
+      } else if ( crc.checksum() != pFrame->_dataCrc ) {
+         frameStatus = API_ERR_MSG_INVALID_CRC;
+         ERR_printf(m_pLog, "Memory frame %d CRC 0x%08x doesn't match 0x%08x. Error: 0x%08x",
+               seqExpected, pFrame->_dataCrc, crc.checksum(), frameStatus);
+      } else if ( pFrame->_offset < offset ||
+                  pFrame->_offset - offset + pFrame->_dataBuf_len > length ) {
+         frameStatus = API_ERR_MEM_BUFFER_LEN;
+         ERR_printf(m_pLog, "Memory frame %d at offset 0x%08x is out of range. Error: 0x%08x",
+               seqExpected, pFrame->_offset, frameStatus);
+      }
+
+      if ( API_ERR_NONE != frameStatus ) {
+         this->sendMemReadCredits( 0, true );
+         continue;
+      }
+
+      memcpy(&pBuffer[pFrame->_offset - offset], pFrame->_dataBuf, pFrame->_dataBuf_len);
+      *pBytesRead += pFrame->_dataBuf_len;
+      seqExpected++;
+
+      if ( ++creditsUsed >= DC3_MEM_READ_MAX_CREDITS / 2 &&
+           framesGranted < framesTotal ) {
+         this->sendMemReadCredits( creditsUsed, false );
+         framesGranted += creditsUsed;
+         creditsUsed = 0;
+      }
+   }
+
+   /* DC3 responds with a status payload if the request itself was bad */
+   if ( _DC3MemDataPayloadMsg == basicMsg._msgPayload ) {
+      *status = (DC3Error_t)payloadMsgUnion.memDataPayload._errorCode;
+      DBG_printf(m_pLog, "DC3 sent %d bytes in %d frames, client got %d bytes",
+            payloadMsgUnion.memDataPayload._length,
+            payloadMsgUnion.memDataPayload._seqCurr, *pBytesRead);
+   } else {
+      *status = (DC3Error_t)payloadMsgUnion.statusPayload._errorCode;
+   }
+
+   return frameStatus;
+}
+
+/******************************************************************************/
+APIError_t ClientApi::DC3_readMemToFile(
+      DC3Error_t *status,
+      DC3MemSpace_t memSpace,
+      uint32_t offset,
+      uint32_t length,
+      const char *filename
+)
+{
+   std::vector<uint8_t> data(length);
+   size_t bytesRead = 0;
+   APIError_t clientStatus = this->DC3_readMem(
+         status,
+         memSpace,
+         offset,
+         length,
+         &data[0],
+         data.size(),
+         &bytesRead
+   );
+
+   if ( API_ERR_NONE != clientStatus || ERR_NONE != *status ) {
+      return clientStatus;
+   }
+
+   std::ofstream file(filename, std::ios::out | std::ios::binary);
+   if ( !file.is_open() ) {
+      clientStatus = API_ERR_MEM_UNABLE_TO_WRITE_FILE;
+      ERR_printf(m_pLog, "Unable to open %s for writing. Error: 0x%08x",
+            filename, clientStatus);
+      return clientStatus;
+   }
+
+   file.write( (const char *)&data[0], bytesRead );
+   if ( !file.good() ) {
+      clientStatus = API_ERR_MEM_UNABLE_TO_WRITE_FILE;
+      ERR_printf(m_pLog, "Unable to write %d bytes to %s. Error: 0x%08x",
+            bytesRead, filename, clientStatus);
+   } else {
+      LOG_printf(m_pLog, "Wrote %d bytes of memory to %s", bytesRead, filename);
+   }
+
+   return clientStatus;
+}
+
+/******************************************************************************/
+APIError_t ClientApi::xferI2CRange(
+      DC3Error_t *status,
+      const uint8_t *pWrData,
+      uint8_t *pRdData,
+      const size_t bytes,
+      const int start,
+      const DC3I2CDevice_t dev,
+      const DC3AccessType_t acc,
+      size_t *pBytesDone
+)
+{
+   *status = ERR_NONE;
+   *pBytesDone = 0;
+   if ( start < 0 || start + bytes > I2C_DEVICE_SIZE( dev ) ) {
+      ERR_printf(m_pLog, "Range of %d bytes at %d doesn't fit into I2C dev %d. Error: 0x%08x",
+            bytes, start, dev, API_ERR_MEM_OUT_OF_RANGE);
+      return API_ERR_MEM_OUT_OF_RANGE;
+   }
+
+   this->disableMsgCallbacks(); /* There are too many msgs flying about for us
+   to log all of them so just turn this off */
+
+   /* These will be used for responses */
+   DC3BasicMsg basicMsg;
+   DC3PayloadMsgUnion_t payloadMsgUnion;
+
+   APIError_t clientStatus = API_ERR_NONE;
+   std::deque<I2CChunk_t> inFlight;
+   size_t bytesSent = 0;
+   while ( bytesSent < bytes || !inFlight.empty() ) {
+
+      /* Keep the pipeline full as long as everything is going fine.  The first
+       * chunk only goes up to a page boundary so the rest of them line up with
+       * the EEPROM pages and DC3 doesn't have to split them up. */
+      while ( bytesSent < bytes && inFlight.size() < I2C_RANGE_MAX_IN_FLIGHT &&
+              API_ERR_NONE == clientStatus && ERR_NONE == *status ) {
+         I2CChunk_t chunk;
+         chunk.offset = bytesSent;
+         chunk.len = DC3_I2C_MAX_XFER_LEN - ((start + bytesSent) % DC3_I2C_PAGE_SIZE);
+         if ( chunk.len > bytes - bytesSent ) {
+            chunk.len = bytes - bytesSent;
+         }
+         chunk.msgId = ++this->m_msgId;
+
+         this->m_basicMsg._msgID       = chunk.msgId;
+         this->m_basicMsg._msgReqProg  = 0;
+         this->m_basicMsg._msgRoute    = this->m_msgRoute;
+         this->m_basicMsg._msgType     = _DC3_Req;
+         this->m_basicMsg._msgName     = ( NULL != pWrData ) ? _DC3I2CWriteMsg : _DC3I2CReadMsg;
+         this->m_basicMsg._msgPayload  = _DC3I2CDataPayloadMsg;
+
+         this->m_i2cDataPayloadMsg._accType   = acc;
+         this->m_i2cDataPayloadMsg._i2cDev    = dev;
+         this->m_i2cDataPayloadMsg._nBytes    = chunk.len;
+         this->m_i2cDataPayloadMsg._start     = start + chunk.offset;
+         this->m_i2cDataPayloadMsg._errorCode = ERR_NONE; // Ignored in Req msgs.
+         this->m_i2cDataPayloadMsg._dataBuf_len = 0;
+         if ( NULL != pWrData ) {
+            this->m_i2cDataPayloadMsg._dataBuf_len = chunk.len;
+            memcpy( this->m_i2cDataPayloadMsg._dataBuf, &pWrData[chunk.offset], chunk.len );
+         }
+
+         uint8_t buffer[DC3_MAX_MSG_LEN];
+         unsigned int bufferLen = 0;
+         bufferLen = DC3BasicMsg_write_delimited_to(&m_basicMsg, buffer, 0);
+         bufferLen = DC3I2CDataPayloadMsg_write_delimited_to(&m_i2cDataPayloadMsg, buffer, bufferLen);
+         l_pComm->write_some((char *)buffer, bufferLen);             // Send Req
+
+         inFlight.push_back( chunk );
+         bytesSent += chunk.len;
+      }
+
+      if ( inFlight.empty() ) {
+         break;                   /* Stopped early and nothing left to drain */
+      }
+
+      memset(&basicMsg, 0, sizeof(basicMsg));
+      memset(&payloadMsgUnion, 0, sizeof(payloadMsgUnion));
+      APIError_t respStatus = waitForResp(
+            &basicMsg,
+            &payloadMsgUnion,
+            HL_MAX_TOUT_SEC_CLI_WAIT_FOR_SIMPLE_MSG_DONE
+      );
+
+      if ( API_ERR_NONE != respStatus ) {                      // Check response
+         ERR_printf(m_pLog,
+               "Waiting for I2C chunk at offset %d received client Error: 0x%08x",
+               inFlight.front().offset, respStatus);
+         return respStatus;
+      }
+
+      /* Only the Done msgs matter.  The Acks just say that DC3 got to the Req. */
+      if ( _DC3_Done != basicMsg._msgType ) {
+         continue;
+      }
+
+      I2CChunk_t chunk = inFlight.front();
+      inFlight.pop_front();
+
+      if ( chunk.msgId != basicMsg._msgID ) {
+         clientStatus = API_ERR_MSG_OUT_OF_SEQUENCE;
+         ERR_printf(m_pLog, "Expected Done for msgId %d but got %d. Error: 0x%08x",
+               chunk.msgId, basicMsg._msgID, clientStatus);
+         continue;
+      }
+
+      /* Once something went wrong, just drain whatever was already on its way */
+      if ( API_ERR_NONE != clientStatus || ERR_NONE != *status ) {
+         continue;
+      }
+
+      /* DC3 responds with a status payload if the request itself was bad */
+      if ( _DC3I2CDataPayloadMsg == basicMsg._msgPayload ) {
+         *status = (DC3Error_t)payloadMsgUnion.i2cDataPayload._errorCode;
+      } else {
+         *status = (DC3Error_t)payloadMsgUnion.statusPayload._errorCode;
+      }
+
+      if ( ERR_NONE != *status ) {
+         ERR_printf(m_pLog, "I2C chunk of %d bytes at %d failed. Error: 0x%08x",
+               chunk.len, start + chunk.offset, *status);
+         continue;
+      }
+
+      if ( NULL != pRdData ) {
+         if ( payloadMsgUnion.i2cDataPayload._dataBuf_len != chunk.len ) {
+            clientStatus = API_ERR_MEM_BUFFER_LEN;
+            ERR_printf(m_pLog, "Expected %d bytes at %d but got %d. Error: 0x%08x",
+                  chunk.len, start + chunk.offset,
+                  payloadMsgUnion.i2cDataPayload._dataBuf_len, clientStatus);
+            continue;
+         }
+         memcpy( &pRdData[chunk.offset], payloadMsgUnion.i2cDataPayload._dataBuf, chunk.len );
+      }
+      *pBytesDone += chunk.len;
+   }
+
+   DBG_printf(m_pLog, "Transferred %d of %d bytes of I2C dev %d", *pBytesDone, bytes, dev);
+   return clientStatus;
+}
+
+/******************************************************************************/
+void ClientApi::sendMemReadCredits( uint16_t credits, bool bAbort )
+{
+   /* Same msg ID as the original request so DC3 knows these go together */
+   this->m_basicMsg._msgType     = _DC3_Req;
+   this->m_basicMsg._msgName     = _DC3MemReadMsg;
+   this->m_basicMsg._msgPayload  = _DC3MemDataPayloadMsg;
+
+   /* A length of 0 tells DC3 to stop sending */
+   uint32_t length = this->m_memDataPayloadMsg._length;
+   if ( bAbort ) {
+      this->m_memDataPayloadMsg._length = 0;
+   }
+   this->m_memDataPayloadMsg._credits = credits;
+
+   uint8_t buffer[DC3_MAX_MSG_LEN];
+   unsigned int bufferLen = 0;
+   bufferLen = DC3BasicMsg_write_delimited_to(&m_basicMsg, buffer, 0);
+   bufferLen = DC3MemDataPayloadMsg_write_delimited_to(&m_memDataPayloadMsg, buffer, bufferLen);
+   l_pComm->write_some((char *)buffer, bufferLen);                   // Send Req
+
+   this->m_memDataPayloadMsg._length = length;
+}
+
+/******************************************************************************/
+APIError_t ClientApi::DC3_getDbgModules(
+      DC3Error_t *status,
+      uint32_t* dbgModules
+)
+{
+
+   this->enableMsgCallbacks();
+
+   /* These will be used for responses */
+   DC3BasicMsg basicMsg;
+   DC3PayloadMsgUnion_t payloadMsgUnion;
+
+   /* Common settings for most messages */
+   this->m_basicMsg._msgID       = this->m_msgId;
+   this->m_basicMsg._msgReqProg  = (unsigned long)this->m_bRequestProg;
+   this->m_basicMsg._msgRoute    = this->m_msgRoute;
+
+   /* Settings specific to this message */
+   this->m_basicMsg._msgType     = _DC3_Req;
+   this->m_basicMsg._msgName     = _DC3DbgGetCurrentMsg;
+   this->m_basicMsg._msgPayload  = _DC3NoMsg;
+
+   size_t size = DC3_MAX_MSG_LEN;
+   uint8_t *buffer = new uint8_t[size];                       // Allocate buffer
+   unsigned int bufferLen = 0;
+   bufferLen = DC3BasicMsg_write_delimited_to(&m_basicMsg, buffer, 0);
+   l_pComm->write_some((char *)buffer, bufferLen);                   // Send Req
+
+   delete[] buffer;                                             // Delete buffer
+
+   memset(&basicMsg, 0, sizeof(basicMsg));
+   memset(&payloadMsgUnion, 0, sizeof(payloadMsgUnion));
+   APIError_t clientStatus = waitForResp(                     // Wait for Ack
+         &basicMsg,
+         &payloadMsgUnion,
+         HL_MAX_TOUT_SEC_CLI_WAIT_FOR_ACK
+   );
+
+   if ( API_ERR_NONE != clientStatus ) {                       // Check response
+      ERR_printf(m_pLog,
+            "Waiting for Ack received client Error: 0x%08x", clientStatus);
+      return clientStatus;
+   }
+
+   memset(&basicMsg, 0, sizeof(basicMsg));
+   memset(&payloadMsgUnion, 0, sizeof(payloadMsgUnion));
+   clientStatus = waitForResp(                                 // Check response
+         &basicMsg,
+         &payloadMsgUnion,
+         HL_MAX_TOUT_SEC_CLI_WAIT_FOR_SIMPLE_MSG_DONE
+   );
+   if ( API_ERR_NONE != clientStatus ) {                       // Check response
+      ERR_printf(m_pLog,
+            "Waiting for Done received client Error: 0x%08x", clientStatus);
+      return clientStatus;
+   } else {
+      *status = (DC3Error_t)payloadMsgUnion.dbgPayload._errorCode;
+      *dbgModules = payloadMsgUnion.dbgPayload._dbgSettings;
+   }
+
+   return clientStatus;
+
+}
+
+/******************************************************************************/
+APIError_t ClientApi::DC3_setDbgModules(
+      DC3Error_t* status,
+      uint32_t* dbgModuleSet,
+      bool bEnable,
+      bool bOverWrite
+)
+{
+   this->enableMsgCallbacks();
+
+   /* These will be used for responses */
+   DC3BasicMsg basicMsg;
+   DC3PayloadMsgUnion_t payloadMsgUnion;
+
+   /* Common settings for most messages */
+   this->m_basicMsg._msgID       = this->m_msgId;
+   this->m_basicMsg._msgReqProg  = (unsigned long)this->m_bRequestProg;
+   this->m_basicMsg._msgRoute    = this->m_msgRoute;
+
+   /* Settings specific to this message */
+   this->m_basicMsg._msgType     = _DC3_Req;
+   if ( bOverWrite ) {
+      this->m_basicMsg._msgName     = _DC3DbgSetCurrentMsg;
+   } else {
+      this->m_basicMsg._msgName  = (true == bEnable) ? _DC3DbgEnableMsg : _DC3DbgDisableMsg;
+   }
+
+   this->m_basicMsg._msgPayload  = _DC3DbgPayloadMsg;
+
+   this->m_dbgPayloadMsg._dbgSettings = *dbgModuleSet;
+   this->m_dbgPayloadMsg._errorCode = ERR_NONE; // This field is ignored in Req msgs.
+
+   size_t size = DC3_MAX_MSG_LEN;
+   uint8_t *buffer = new uint8_t[size];                       // Allocate buffer
+   unsigned int bufferLen = 0;
+   bufferLen = DC3BasicMsg_write_delimited_to(&m_basicMsg, buffer, 0);
+   bufferLen = DC3DbgPayloadMsg_write_delimited_to(&m_dbgPayloadMsg, buffer, bufferLen);
+   l_pComm->write_some((char *)buffer, bufferLen);                   // Send Req
+
+   delete[] buffer;                                             // Delete buffer
+
+   memset(&basicMsg, 0, sizeof(basicMsg));
+   memset(&payloadMsgUnion, 0, sizeof(payloadMsgUnion));
+   APIError_t clientStatus = waitForResp(                        // Wait for Ack
+         &basicMsg,
+         &payloadMsgUnion,
+         HL_MAX_TOUT_SEC_CLI_WAIT_FOR_ACK
+   );
+
+   if ( API_ERR_NONE != clientStatus ) {                       // Check response
+      ERR_printf(m_pLog,
+            "Waiting for Ack received client Error: 0x%08x", clientStatus);
+      return clientStatus;
+   }
+
+   memset(&basicMsg, 0, sizeof(basicMsg));
+   memset(&payloadMsgUnion, 0, sizeof(payloadMsgUnion));
+   clientStatus = waitForResp(                                 // Check response
+         &basicMsg,
+         &payloadMsgUnion,
+         HL_MAX_TOUT_SEC_CLI_WAIT_FOR_SIMPLE_MSG_DONE
+   );
+   if ( API_ERR_NONE != clientStatus ) {                       // Check response
+      ERR_printf(m_pLog,
+            "Waiting for Done received client Error: 0x%08x", clientStatus);
+      return clientStatus;
+   } else {
+      *status = (DC3Error_t)payloadMsgUnion.dbgPayload._errorCode;
+      *dbgModuleSet = payloadMsgUnion.dbgPayload._dbgSettings;
+   }
+
+   return clientStatus;
+}
+
+/******************************************************************************/
+APIError_t ClientApi::DC3_setDbgDevice(
+      DC3Error_t* status,
+      DC3MsgRoute_t device,
+      bool bEnable
+)
+{
+   this->enableMsgCallbacks();
+
+   /* These will be used for responses */
+   DC3BasicMsg basicMsg;
+   DC3PayloadMsgUnion_t payloadMsgUnion;
+
+   /* Common settings for most messages */
+   this->m_basicMsg._msgID       = this->m_msgId;
+   this->m_basicMsg._msgReqProg  = (unsigned long)this->m_bRequestProg;
+   this->m_basicMsg._msgRoute    = this->m_msgRoute;
+
+   /* Settings specific to this message */
+   this->m_basicMsg._msgType     = _DC3_Req;
+
+   if ( _DC3_EthCli == device ) {
+      this->m_basicMsg._msgName = (true == bEnable) ? _DC3DbgEnableEthMsg : _DC3DbgDisableEthMsg;
+   } else if ( _DC3_Serial == device ) {
+      this->m_basicMsg._msgName = (true == bEnable) ? _DC3DbgEnableSerMsg : _DC3DbgDisableSerMsg;
+   } else {
+      return API_ERR_DEV_INVALID_DEBUG_OUTPUT;
+   }
+
+   this->m_basicMsg._msgPayload  = _DC3NoMsg;
+
+   size_t size = DC3_MAX_MSG_LEN;
+   uint8_t *buffer = new uint8_t[size];                       // Allocate buffer
+   unsigned int bufferLen = 0;
+   bufferLen = DC3BasicMsg_write_delimited_to(&m_basicMsg, buffer, 0);
+   l_pComm->write_some((char *)buffer, bufferLen);                   // Send Req
+
+   delete[] buffer;                                             // Delete buffer
+
+   memset(&basicMsg, 0, sizeof(basicMsg));
+   memset(&payloadMsgUnion, 0, sizeof(payloadMsgUnion));
+   APIError_t clientStatus = waitForResp(                        // Wait for Ack
+         &basicMsg,
+         &payloadMsgUnion,
+         HL_MAX_TOUT_SEC_CLI_WAIT_FOR_ACK
+   );
+
+   if ( API_ERR_NONE != clientStatus ) {                       // Check response
+      ERR_printf(m_pLog,
+            "Waiting for Ack received client Error: 0x%08x", clientStatus);
+      return clientStatus;
+   }
+
+   memset(&basicMsg, 0, sizeof(basicMsg));
+   memset(&payloadMsgUnion, 0, sizeof(payloadMsgUnion));
+   clientStatus = waitForResp(                                 // Check response
+         &basicMsg,
+         &payloadMsgUnion,
+         HL_MAX_TOUT_SEC_CLI_WAIT_FOR_SIMPLE_MSG_DONE
+   );
+   if ( API_ERR_NONE != clientStatus ) {                       // Check response
+      ERR_printf(m_pLog,
+            "Waiting for Done received client Error: 0x%08x", clientStatus);
+      return clientStatus;
+   } else {
+      *status = (DC3Error_t)payloadMsgUnion.statusPayload._errorCode;
+   }
+
+   return clientStatus;
+}
+
+/******************************************************************************/
+APIError_t ClientApi::DC3_resetDB( DC3Error_t* status )
+{
+   this->enableMsgCallbacks();
+
+   /* These will be used for responses */
+   DC3BasicMsg basicMsg;
+   DC3PayloadMsgUnion_t payloadMsgUnion;
+
+   /* Common settings for most messages */
+   this->m_basicMsg._msgID       = this->m_msgId;
+   this->m_basicMsg._msgReqProg  = (unsigned long)this->m_bRequestProg;
+   this->m_basicMsg._msgRoute    = this->m_msgRoute;
+
+   /* Settings specific to this message */
+   this->m_basicMsg._msgType     = _DC3_Req;
+   this->m_basicMsg._msgName     = _DC3DBFullResetMsg;
+   this->m_basicMsg._msgPayload  = _DC3NoMsg;
+
+   size_t size = DC3_MAX_MSG_LEN;
+   uint8_t *buffer = new uint8_t[size];                       // Allocate buffer
+   unsigned int bufferLen = 0;
+   bufferLen = DC3BasicMsg_write_delimited_to(&m_basicMsg, buffer, 0);
+   l_pComm->write_some((char *)buffer, bufferLen);                   // Send Req
+
+   delete[] buffer;                                             // Delete buffer
+
+   memset(&basicMsg, 0, sizeof(basicMsg));
+   memset(&payloadMsgUnion, 0, sizeof(payloadMsgUnion));
+   APIError_t clientStatus = waitForResp(                        // Wait for Ack
+         &basicMsg,
+         &payloadMsgUnion,
+         HL_MAX_TOUT_SEC_CLI_WAIT_FOR_ACK
+   );
+
+   if ( API_ERR_NONE != clientStatus ) {                       // Check response
+      ERR_printf(m_pLog,
+            "Waiting for Ack received client Error: 0x%08x", clientStatus);
+      return clientStatus;
+   }
+
+   memset(&basicMsg, 0, sizeof(basicMsg));
+   memset(&payloadMsgUnion, 0, sizeof(payloadMsgUnion));
+   clientStatus = waitForResp(                                 // Check response
+         &basicMsg,
+         &payloadMsgUnion,
+         HL_MAX_TOUT_SEC_CLI_WAIT_FOR_SIMPLE_MSG_DONE
+   );
+   if ( API_ERR_NONE != clientStatus ) {                       // Check response
+      ERR_printf(m_pLog,
+            "Waiting for Done received client Error: 0x%08x", clientStatus);
+      return clientStatus;
+   } else {
+      *status = (DC3Error_t)payloadMsgUnion.statusPayload._errorCode;
+   }
+
+   return clientStatus;
+}
+
+
+/******************************************************************************/
+APIError_t ClientApi::DC3_getDbElem(
+      DC3Error_t* status,
+      const DC3DBElem_t elem,
+      const DC3AccessType_t  acc,
+      const size_t bufferSize,
+      uint8_t* const pBuffer,
+      size_t* pBytesInBuffer
+)
+{
+   this->enableMsgCallbacks();
+
+   /* These will be used for responses */
+   DC3BasicMsg basicMsg;
+   DC3PayloadMsgUnion_t payloadMsgUnion;
+
+   /* Common settings for most messages */
+   this->m_basicMsg._msgID       = this->m_msgId;
+   this->m_basicMsg._msgReqProg  = (unsigned long)this->m_bRequestProg;
+   this->m_basicMsg._msgRoute    = this->m_msgRoute;
+   this->m_basicMsg._msgName     = _DC3DBGetElemMsg;
+   this->m_basicMsg._msgPayload  = _DC3DBDataPayloadMsg;
+
+   this->m_dbPayloadMsg._errorCode  = ERR_NONE; // This field is ignored in Req msgs.
+   this->m_dbPayloadMsg._accType    = acc;
+   this->m_dbPayloadMsg._elem       = elem;
+
+   size_t size = DC3_MAX_MSG_LEN;
+   uint8_t *buffer = new uint8_t[size];                       // Allocate buffer
+   unsigned int bufferLen = 0;
+   bufferLen = DC3BasicMsg_write_delimited_to(&m_basicMsg, buffer, 0);
+   bufferLen = DC3DBDataPayloadMsg_write_delimited_to(&m_dbPayloadMsg, buffer, bufferLen);
+   l_pComm->write_some((char *)buffer, bufferLen);                   // Send Req
+
+   delete[] buffer;                                             // Delete buffer
+
+   memset(&basicMsg, 0, sizeof(basicMsg));
+   memset(&payloadMsgUnion, 0, sizeof(payloadMsgUnion));
+   APIError_t clientStatus = waitForResp(                        // Wait for Ack
+         &basicMsg,
+         &payloadMsgUnion,
+         HL_MAX_TOUT_SEC_CLI_WAIT_FOR_ACK
+   );
+
+   if ( API_ERR_NONE != clientStatus ) {                       // Check response
+      ERR_printf(m_pLog,
+            "Waiting for Ack received client Error: 0x%08x", clientStatus);
+      return clientStatus;
+   }
+
+   memset(&basicMsg, 0, sizeof(basicMsg));
+   memset(&payloadMsgUnion, 0, sizeof(payloadMsgUnion));
+   clientStatus = waitForResp(                                 // Check response
+         &basicMsg,
+         &payloadMsgUnion,
+         HL_MAX_TOUT_SEC_CLI_WAIT_FOR_SIMPLE_MSG_DONE
+   );
+   if ( API_ERR_NONE != clientStatus ) {                       // Check response
+      ERR_printf(m_pLog,
+            "Waiting for Done received client Error: 0x%08x", clientStatus);
+      return clientStatus;
+   } else {
+      *status = (DC3Error_t)payloadMsgUnion.dbDataPayload._errorCode;
+      *pBytesInBuffer = payloadMsgUnion.dbDataPayload._dataBuf_len;
+      memcpy(pBuffer, payloadMsgUnion.dbDataPayload._dataBuf, *pBytesInBuffer);
+   }
+
+   return clientStatus;
+}
+
+
+/******************************************************************************/
+APIError_t ClientApi::DC3_getDbElems(
+      DC3Error_t* status,
+      const DC3DBElem_t* const pElems,
+      const size_t nElems,
+      const DC3AccessType_t  acc,
+      const size_t bufferSize,
+      uint8_t* const pBuffer,
+      size_t* const pElemLens,
+      size_t* pBytesInBuffer
+)
+{
+   if ( NULL == pElems || NULL == pBuffer || NULL == pElemLens ) {
+      ERR_printf(m_pLog, "NULL pointer passed in for elements or buffers");
+      return API_ERR_MEM_NULL_VALUE;
+   }
+
+   if ( 0 == nElems || nElems > _DC3_DB_MAX_ELEM ) {
+      ERR_printf(m_pLog, "Invalid number of elements: %d", nElems);
+      return API_ERR_MEM_OUT_OF_RANGE;
+   }
+
+   this->enableMsgCallbacks();
+
+   /* These will be used for responses */
+   DC3BasicMsg basicMsg;
+   DC3PayloadMsgUnion_t payloadMsgUnion;
+
+   /* Common settings for most messages */
+   this->m_basicMsg._msgID       = this->m_msgId;
+   this->m_basicMsg._msgReqProg  = (unsigned long)this->m_bRequestProg;
+   this->m_basicMsg._msgRoute    = this->m_msgRoute;
+   this->m_basicMsg._msgName     = _DC3DBGetElemsMsg;
+   this->m_basicMsg._msgPayload  = _DC3DBElemsPayloadMsg;
+
+   memset(&m_dbElemsPayloadMsg, 0, sizeof(m_dbElemsPayloadMsg));
+   this->m_dbElemsPayloadMsg._errorCode  = ERR_NONE; // This field is ignored in Req msgs.
+   this->m_dbElemsPayloadMsg._accType    = acc;
+   for ( size_t i = 0; i < nElems; i++ ) {
+      this->m_dbElemsPayloadMsg._elem[i] = pElems[i];
+   }
+   this->m_dbElemsPayloadMsg._elem_repeated_len = nElems;
+
+   size_t size = DC3_MAX_MSG_LEN;
+   uint8_t *buffer = new uint8_t[size];                       // Allocate buffer
+   unsigned int bufferLen = 0;
+   bufferLen = DC3BasicMsg_write_delimited_to(&m_basicMsg, buffer, 0);
+   bufferLen = DC3DBElemsPayloadMsg_write_delimited_to(&m_dbElemsPayloadMsg, buffer, bufferLen);
+   l_pComm->write_some((char *)buffer, bufferLen);                   // Send Req
+
+   delete[] buffer;                                             // Delete buffer
+
+   memset(&basicMsg, 0, sizeof(basicMsg));
+   memset(&payloadMsgUnion, 0, sizeof(payloadMsgUnion));
+   APIError_t clientStatus = waitForResp(                        // Wait for Ack
+         &basicMsg,
+         &payloadMsgUnion,
+         HL_MAX_TOUT_SEC_CLI_WAIT_FOR_ACK
+   );
+
+   if ( API_ERR_NONE != clientStatus ) {                       // Check response
+      ERR_printf(m_pLog,
+            "Waiting for Ack received client Error: 0x%08x", clientStatus);
+      return clientStatus;
+   }
+
+   memset(&basicMsg, 0, sizeof(basicMsg));
+   memset(&payloadMsgUnion, 0, sizeof(payloadMsgUnion));
+   clientStatus = waitForResp(                                 // Check response
+         &basicMsg,
+         &payloadMsgUnion,
+         HL_MAX_TOUT_SEC_CLI_WAIT_FOR_SIMPLE_MSG_DONE
+   );
+   if ( API_ERR_NONE != clientStatus ) {                       // Check response
+      ERR_printf(m_pLog,
+            "Waiting for Done received client Error: 0x%08x", clientStatus);
+      return clientStatus;
+   }
+
+   if ( _DC3DBElemsPayloadMsg != basicMsg._msgPayload ) {
+      /* DC3 rejected the request before it got to the DB and only sent a status */
+      *status = (DC3Error_t)payloadMsgUnion.statusPayload._errorCode;
+      *pBytesInBuffer = 0;
+      return clientStatus;
+   }
+
+   *status = (DC3Error_t)payloadMsgUnion.dbElemsPayload._errorCode;
+   if ( payloadMsgUnion.dbElemsPayload._dataBuf_len > bufferSize ) {
+      ERR_printf(m_pLog,
+            "Buffer of %d bytes is too small for %d bytes of DB data",
+            bufferSize, payloadMsgUnion.dbElemsPayload._dataBuf_len);
+      return API_ERR_MEM_BUFFER_LEN;
+   }
+
+   for ( size_t i = 0; i < nElems; i++ ) {
+      pElemLens[i] = ( i < (size_t)payloadMsgUnion.dbElemsPayload._elemLen_repeated_len ) ?
+            payloadMsgUnion.dbElemsPayload._elemLen[i] : 0;
+   }
+   *pBytesInBuffer = payloadMsgUnion.dbElemsPayload._dataBuf_len;
+   memcpy(pBuffer, payloadMsgUnion.dbElemsPayload._dataBuf, *pBytesInBuffer);
+
+   return clientStatus;
+}
+
+/******************************************************************************/
+APIError_t ClientApi::DC3_setDbElems(
+      DC3Error_t* status,
+      const DC3DBElem_t* const pElems,
+      const size_t nElems,
+      const DC3AccessType_t  acc,
+      const uint8_t* const pBuffer,
+      const size_t* const pElemLens
+)
+{
+   if ( NULL == pElems || NULL == pBuffer || NULL == pElemLens ) {
+      ERR_printf(m_pLog, "NULL pointer passed in for elements or buffers");
+      return API_ERR_MEM_NULL_VALUE;
+   }
+
+   if ( 0 == nElems || nElems > _DC3_DB_MAX_ELEM ) {
+      ERR_printf(m_pLog, "Invalid number of elements: %d", nElems);
+      return API_ERR_MEM_OUT_OF_RANGE;
+   }
+
+   size_t dataLen = 0;
+   for ( size_t i = 0; i < nElems; i++ ) {
+      dataLen += pElemLens[i];
+   }
+   if ( dataLen > DC3_DB_ELEMS_MAX_DATA_LEN ) {
+      ERR_printf(m_pLog,
+            "%d bytes of DB data don't fit into a single request (max %d)",
+            dataLen, DC3_DB_ELEMS_MAX_DATA_LEN);
+      return API_ERR_MEM_BUFFER_LEN;
+   }
+
+   this->enableMsgCallbacks();
+
+   /* These will be used for responses */
    DC3BasicMsg basicMsg;
    DC3PayloadMsgUnion_t payloadMsgUnion;
 
@@ -763,25 +1897,26 @@ APIError_t ClientApi::DC3_setDbgModules(
    this->m_basicMsg._msgID       = this->m_msgId;
    this->m_basicMsg._msgReqProg  = (unsigned long)this->m_bRequestProg;
    this->m_basicMsg._msgRoute    = this->m_msgRoute;
-
-   /* Settings specific to this message */
-   this->m_basicMsg._msgType     = _DC3_Req;
-   if ( bOverWrite ) {
-      this->m_basicMsg._msgName     = _DC3DbgSetCurrentMsg;
-   } else {
-      this->m_basicMsg._msgName  = (true == bEnable) ? _DC3DbgEnableMsg : _DC3DbgDisableMsg;
+   this->m_basicMsg._msgName     = _DC3DBSetElemsMsg;
+   this->m_basicMsg._msgPayload  = _DC3DBElemsPayloadMsg;
+
+   memset(&m_dbElemsPayloadMsg, 0, sizeof(m_dbElemsPayloadMsg));
+   this->m_dbElemsPayloadMsg._errorCode  = ERR_NONE; // This field is ignored in Req msgs.
+   this->m_dbElemsPayloadMsg._accType    = acc;
+   for ( size_t i = 0; i < nElems; i++ ) {
+      this->m_dbElemsPayloadMsg._elem[i]    = pElems[i];
+      this->m_dbElemsPayloadMsg._elemLen[i] = pElemLens[i];
    }
-
-   this->m_basicMsg._msgPayload  = _DC3DbgPayloadMsg;
-
-   this->m_dbgPayloadMsg._dbgSettings = *dbgModuleSet;
-   this->m_dbgPayloadMsg._errorCode = ERR_NONE; // This field is ignored in Req msgs.
+   this->m_dbElemsPayloadMsg._elem_repeated_len    = nElems;
+   this->m_dbElemsPayloadMsg._elemLen_repeated_len = nElems;
+   this->m_dbElemsPayloadMsg._dataBuf_len          = dataLen;
+   memcpy(this->m_dbElemsPayloadMsg._dataBuf, pBuffer, dataLen);
 
    size_t size = DC3_MAX_MSG_LEN;
    uint8_t *buffer = new uint8_t[size];                       // Allocate buffer
    unsigned int bufferLen = 0;
    bufferLen = DC3BasicMsg_write_delimited_to(&m_basicMsg, buffer, 0);
-   bufferLen = DC3DbgPayloadMsg_write_delimited_to(&m_dbgPayloadMsg, buffer, bufferLen);
+   bufferLen = DC3DBElemsPayloadMsg_write_delimited_to(&m_dbElemsPayloadMsg, buffer, bufferLen);
    l_pComm->write_some((char *)buffer, bufferLen);                   // Send Req
 
    delete[] buffer;                                             // Delete buffer
@@ -811,21 +1946,37 @@ APIError_t ClientApi::DC3_setDbgModules(
       ERR_printf(m_pLog,
             "Waiting for Done received client Error: 0x%08x", clientStatus);
       return clientStatus;
+   }
+
+   if ( _DC3DBElemsPayloadMsg != basicMsg._msgPayload ) {
+      *status = (DC3Error_t)payloadMsgUnion.statusPayload._errorCode;
    } else {
-      *status = (DC3Error_t)payloadMsgUnion.dbgPayload._errorCode;
-      *dbgModuleSet = payloadMsgUnion.dbgPayload._dbgSettings;
+      *status = (DC3Error_t)payloadMsgUnion.dbElemsPayload._errorCode;
    }
 
    return clientStatus;
 }
 
 /******************************************************************************/
-APIError_t ClientApi::DC3_setDbgDevice(
+APIError_t ClientApi::DC3_getProfRecs(
       DC3Error_t* status,
-      DC3MsgRoute_t device,
-      bool bEnable
+      const DC3ProfRec_t recType,
+      const uint16_t index,
+      const bool bReset,
+      uint16_t* pNRecs,
+      uint32_t* pTickHz,
+      char* const pName,
+      const size_t nameSize,
+      uint32_t* const pStats,
+      const size_t statsSize,
+      size_t* pStatsLen
 )
 {
+   if ( NULL == pName || 0 == nameSize || NULL == pStats ) {
+      ERR_printf(m_pLog, "NULL pointer passed in for name or stats buffers");
+      return API_ERR_MEM_NULL_VALUE;
+   }
+
    this->enableMsgCallbacks();
 
    /* These will be used for responses */
@@ -836,24 +1987,20 @@ APIError_t ClientApi::DC3_setDbgDevice(
    this->m_basicMsg._msgID       = this->m_msgId;
    this->m_basicMsg._msgReqProg  = (unsigned long)this->m_bRequestProg;
    this->m_basicMsg._msgRoute    = this->m_msgRoute;
+   this->m_basicMsg._msgName     = _DC3ProfMsg;
+   this->m_basicMsg._msgPayload  = _DC3ProfPayloadMsg;
 
-   /* Settings specific to this message */
-   this->m_basicMsg._msgType     = _DC3_Req;
-
-   if ( _DC3_EthCli == device ) {
-      this->m_basicMsg._msgName = (true == bEnable) ? _DC3DbgEnableEthMsg : _DC3DbgDisableEthMsg;
-   } else if ( _DC3_Serial == device ) {
-      this->m_basicMsg._msgName = (true == bEnable) ? _DC3DbgEnableSerMsg : _DC3DbgDisableSerMsg;
-   } else {
-      return API_ERR_DEV_INVALID_DEBUG_OUTPUT;
-   }
-
-   this->m_basicMsg._msgPayload  = _DC3NoMsg;
+   memset(&m_profPayloadMsg, 0, sizeof(m_profPayloadMsg));
+   this->m_profPayloadMsg._errorCode = ERR_NONE; // This field is ignored in Req msgs.
+   this->m_profPayloadMsg._recType   = recType;
+   this->m_profPayloadMsg._index     = index;
+   this->m_profPayloadMsg._reset     = bReset ? 1 : 0;
 
    size_t size = DC3_MAX_MSG_LEN;
    uint8_t *buffer = new uint8_t[size];                       // Allocate buffer
    unsigned int bufferLen = 0;
    bufferLen = DC3BasicMsg_write_delimited_to(&m_basicMsg, buffer, 0);
+   bufferLen = DC3ProfPayloadMsg_write_delimited_to(&m_profPayloadMsg, buffer, bufferLen);
    l_pComm->write_some((char *)buffer, bufferLen);                   // Send Req
 
    delete[] buffer;                                             // Delete buffer
@@ -883,16 +2030,62 @@ APIError_t ClientApi::DC3_setDbgDevice(
       ERR_printf(m_pLog,
             "Waiting for Done received client Error: 0x%08x", clientStatus);
       return clientStatus;
-   } else {
+   }
+
+   pName[0]   = '\0';
+   *pStatsLen = 0;
+
+   if ( _DC3ProfPayloadMsg != basicMsg._msgPayload ) {
+      /* The Bootloader doesn't do profiling and only sends a status back */
       *status = (DC3Error_t)payloadMsgUnion.statusPayload._errorCode;
+      *pNRecs = 0;
+      return clientStatus;
+   }
+
+   *status  = (DC3Error_t)payloadMsgUnion.profPayload._errorCode;
+   *pNRecs  = (uint16_t)payloadMsgUnion.profPayload._nRecs;
+   *pTickHz = payloadMsgUnion.profPayload._tickHz;
+
+   if ( (size_t)payloadMsgUnion.profPayload._stats_repeated_len > statsSize ) {
+      ERR_printf(m_pLog,
+            "Buffer of %d values is too small for %d profiling values",
+            statsSize, payloadMsgUnion.profPayload._stats_repeated_len);
+      return API_ERR_MEM_BUFFER_LEN;
+   }
+
+   size_t nameLen = payloadMsgUnion.profPayload._name_len;
+   if ( nameLen > nameSize - 1 ) {
+      nameLen = nameSize - 1;
+   }
+   memcpy(pName, payloadMsgUnion.profPayload._name, nameLen);
+   pName[nameLen] = '\0';
+
+   for ( int i = 0; i < payloadMsgUnion.profPayload._stats_repeated_len; i++ ) {
+      pStats[i] = (uint32_t)payloadMsgUnion.profPayload._stats[i];
    }
+   *pStatsLen = payloadMsgUnion.profPayload._stats_repeated_len;
 
    return clientStatus;
 }
 
 /******************************************************************************/
-APIError_t ClientApi::DC3_resetDB( DC3Error_t* status )
+APIError_t ClientApi::DC3_getMemStats(
+      DC3Error_t* status,
+      const uint16_t index,
+      uint16_t* pNRecs,
+      DC3MemStatsKind_t* pKind,
+      char* const pName,
+      const size_t nameSize,
+      uint32_t* const pStats,
+      const size_t statsSize,
+      size_t* pStatsLen
+)
 {
+   if ( NULL == pName || 0 == nameSize || NULL == pStats ) {
+      ERR_printf(m_pLog, "NULL pointer passed in for name or stats buffers");
+      return API_ERR_MEM_NULL_VALUE;
+   }
+
    this->enableMsgCallbacks();
 
    /* These will be used for responses */
@@ -903,16 +2096,19 @@ APIError_t ClientApi::DC3_resetDB( DC3Error_t* status )
    this->m_basicMsg._msgID       = this->m_msgId;
    this->m_basicMsg._msgReqProg  = (unsigned long)this->m_bRequestProg;
    this->m_basicMsg._msgRoute    = this->m_msgRoute;
+   this->m_basicMsg._msgName     = _DC3MemStatsMsg;
+   this->m_basicMsg._msgPayload  = _DC3MemStatsPayloadMsg;
 
-   /* Settings specific to this message */
-   this->m_basicMsg._msgType     = _DC3_Req;
-   this->m_basicMsg._msgName     = _DC3DBFullResetMsg;
-   this->m_basicMsg._msgPayload  = _DC3NoMsg;
+   memset(&m_memStatsPayloadMsg, 0, sizeof(m_memStatsPayloadMsg));
+   this->m_memStatsPayloadMsg._errorCode = ERR_NONE; // This field is ignored in Req msgs.
+   this->m_memStatsPayloadMsg._index     = index;
+   this->m_memStatsPayloadMsg._kind      = _DC3_MEM_STATS_MAX;
 
    size_t size = DC3_MAX_MSG_LEN;
    uint8_t *buffer = new uint8_t[size];                       // Allocate buffer
    unsigned int bufferLen = 0;
    bufferLen = DC3BasicMsg_write_delimited_to(&m_basicMsg, buffer, 0);
+   bufferLen = DC3MemStatsPayloadMsg_write_delimited_to(&m_memStatsPayloadMsg, buffer, bufferLen);
    l_pComm->write_some((char *)buffer, bufferLen);                   // Send Req
 
    delete[] buffer;                                             // Delete buffer
@@ -942,22 +2138,49 @@ APIError_t ClientApi::DC3_resetDB( DC3Error_t* status )
       ERR_printf(m_pLog,
             "Waiting for Done received client Error: 0x%08x", clientStatus);
       return clientStatus;
-   } else {
+   }
+
+   pName[0]   = '\0';
+   *pStatsLen = 0;
+
+   if ( _DC3MemStatsPayloadMsg != basicMsg._msgPayload ) {
+      /* The Bootloader doesn't support this and only sends a status back */
       *status = (DC3Error_t)payloadMsgUnion.statusPayload._errorCode;
+      *pNRecs = 0;
+      return clientStatus;
+   }
+
+   *status = (DC3Error_t)payloadMsgUnion.memStatsPayload._errorCode;
+   *pNRecs = (uint16_t)payloadMsgUnion.memStatsPayload._nRecs;
+   *pKind  = payloadMsgUnion.memStatsPayload._kind;
+
+   if ( (size_t)payloadMsgUnion.memStatsPayload._stats_repeated_len > statsSize ) {
+      ERR_printf(m_pLog,
+            "Buffer of %d values is too small for %d pool/queue values",
+            statsSize, payloadMsgUnion.memStatsPayload._stats_repeated_len);
+      return API_ERR_MEM_BUFFER_LEN;
+   }
+
+   size_t nameLen = payloadMsgUnion.memStatsPayload._name_len;
+   if ( nameLen > nameSize - 1 ) {
+      nameLen = nameSize - 1;
+   }
+   memcpy(pName, payloadMsgUnion.memStatsPayload._name, nameLen);
+   pName[nameLen] = '\0';
+
+   for ( int i = 0; i < payloadMsgUnion.memStatsPayload._stats_repeated_len; i++ ) {
+      pStats[i] = (uint32_t)payloadMsgUnion.memStatsPayload._stats[i];
    }
+   *pStatsLen = payloadMsgUnion.memStatsPayload._stats_repeated_len;
 
    return clientStatus;
 }
 
-
 /******************************************************************************/
-APIError_t ClientApi::DC3_getDbElem(
+APIError_t ClientApi::DC3_subscribeHealth(
       DC3Error_t* status,
-      const DC3DBElem_t elem,
-      const DC3AccessType_t  acc,
-      const size_t bufferSize,
-      uint8_t* const pBuffer,
-      size_t* pBytesInBuffer
+      const uint32_t intervalMs,
+      const uint16_t port
 )
 {
    this->enableMsgCallbacks();
@@ -966,26 +2189,26 @@ APIError_t ClientApi::DC3_getDbElem(
    DC3BasicMsg basicMsg;
    DC3PayloadMsgUnion_t payloadMsgUnion;
 
-   /* Common settings for most messages */
+   /* The pushed msgs reuse this msg ID so it has to be a new one */
+   this->m_msgId++;
    this->m_basicMsg._msgID       = this->m_msgId;
-   this->m_basicMsg._msgReqProg  = (unsigned long)this->m_bRequestProg;
+   this->m_basicMsg._msgReqProg  = 0;
    this->m_basicMsg._msgRoute    = this->m_msgRoute;
-   this->m_basicMsg._msgName     = _DC3DBGetElemMsg;
-   this->m_basicMsg._msgPayload  = _DC3DBDataPayloadMsg;
+   this->m_basicMsg._msgType     = _DC3_Req;
+   this->m_basicMsg._msgName     = _DC3HealthMsg;
+   this->m_basicMsg._msgPayload  = _DC3HealthPayloadMsg;
 
-   this->m_dbPayloadMsg._errorCode  = ERR_NONE; // This field is ignored in Req msgs.
-   this->m_dbPayloadMsg._accType    = acc;
-   this->m_dbPayloadMsg._elem       = elem;
+   memset(&m_healthPayloadMsg, 0, sizeof(m_healthPayloadMsg));
+   this->m_healthPayloadMsg._errorCode  = ERR_NONE; // Ignored in Req msgs.
+   this->m_healthPayloadMsg._intervalMs = intervalMs;
+   this->m_healthPayloadMsg._port       = port;
 
-   size_t size = DC3_MAX_MSG_LEN;
-   uint8_t *buffer = new uint8_t[size];                       // Allocate buffer
+   uint8_t buffer[DC3_MAX_MSG_LEN];
    unsigned int bufferLen = 0;
    bufferLen = DC3BasicMsg_write_delimited_to(&m_basicMsg, buffer, 0);
-   bufferLen = DC3DBDataPayloadMsg_write_delimited_to(&m_dbPayloadMsg, buffer, bufferLen);
+   bufferLen = DC3HealthPayloadMsg_write_delimited_to(&m_healthPayloadMsg, buffer, bufferLen);
    l_pComm->write_some((char *)buffer, bufferLen);                   // Send Req
 
-   delete[] buffer;                                             // Delete buffer
-
    memset(&basicMsg, 0, sizeof(basicMsg));
    memset(&payloadMsgUnion, 0, sizeof(payloadMsgUnion));
    APIError_t clientStatus = waitForResp(                        // Wait for Ack
@@ -1000,26 +2223,181 @@ APIError_t ClientApi::DC3_getDbElem(
       return clientStatus;
    }
 
-   memset(&basicMsg, 0, sizeof(basicMsg));
-   memset(&payloadMsgUnion, 0, sizeof(payloadMsgUnion));
-   clientStatus = waitForResp(                                 // Check response
-         &basicMsg,
-         &payloadMsgUnion,
-         HL_MAX_TOUT_SEC_CLI_WAIT_FOR_SIMPLE_MSG_DONE
-   );
-   if ( API_ERR_NONE != clientStatus ) {                       // Check response
-      ERR_printf(m_pLog,
-            "Waiting for Done received client Error: 0x%08x", clientStatus);
+   /* A push from a stream that was already running can sneak in ahead of the
+    * Done so skip those. */
+   do {
+      memset(&basicMsg, 0, sizeof(basicMsg));
+      memset(&payloadMsgUnion, 0, sizeof(payloadMsgUnion));
+      clientStatus = waitForResp(                              // Check response
+            &basicMsg,
+            &payloadMsgUnion,
+            HL_MAX_TOUT_SEC_CLI_WAIT_FOR_SIMPLE_MSG_DONE
+      );
+      if ( API_ERR_NONE != clientStatus ) {                    // Check response
+         ERR_printf(m_pLog,
+               "Waiting for Done received client Error: 0x%08x", clientStatus);
+         return clientStatus;
+      }
+   } while ( _DC3_Prog == basicMsg._msgType );
+
+   if ( _DC3HealthPayloadMsg != basicMsg._msgPayload ) {
+      /* The Bootloader doesn't support this and only sends a status back */
+      *status = (DC3Error_t)payloadMsgUnion.statusPayload._errorCode;
       return clientStatus;
-   } else {
-      *status = (DC3Error_t)payloadMsgUnion.dbDataPayload._errorCode;
-      *pBytesInBuffer = payloadMsgUnion.dbDataPayload._dataBuf_len;
-      memcpy(pBuffer, payloadMsgUnion.dbDataPayload._dataBuf, *pBytesInBuffer);
    }
 
+   *status = (DC3Error_t)payloadMsgUnion.healthPayload._errorCode;
    return clientStatus;
 }
 
+/******************************************************************************/
+APIError_t ClientApi::DC3_waitForHealth(
+      uint32_t* pSeq,
+      uint32_t* pUptimeMs,
+      uint32_t* const pStats,
+      const size_t statsSize,
+      size_t* pStatsLen,
+      const uint16_t timeoutSecs
+)
+{
+   if ( NULL == pStats ) {
+      ERR_printf(m_pLog, "NULL pointer passed in for stats buffer");
+      return API_ERR_MEM_NULL_VALUE;
+   }
+
+   /* These will be used for responses */
+   DC3BasicMsg basicMsg;
+   DC3PayloadMsgUnion_t payloadMsgUnion;
+
+   *pStatsLen = 0;
+
+   while ( true ) {
+      memset(&basicMsg, 0, sizeof(basicMsg));
+      memset(&payloadMsgUnion, 0, sizeof(payloadMsgUnion));
+      APIError_t clientStatus = waitForResp(
+            &basicMsg,
+            &payloadMsgUnion,
+            timeoutSecs
+      );
+
+      if ( API_ERR_NONE != clientStatus ) {
+         return clientStatus;
+      }
+
+      if ( _DC3_Prog == basicMsg._msgType &&
+           _DC3HealthMsg == basicMsg._msgName &&
+           _DC3HealthPayloadMsg == basicMsg._msgPayload ) {
+         break;
+      }
+   }
+
+   struct DC3HealthPayloadMsg *pHealth = &payloadMsgUnion.healthPayload;
+   if ( (size_t)pHealth->_stats_repeated_len > statsSize ) {
+      ERR_printf(m_pLog,
+            "Buffer of %d values is too small for %d health values",
+            statsSize, pHealth->_stats_repeated_len);
+      return API_ERR_MEM_BUFFER_LEN;
+   }
+
+   *pSeq      = (uint32_t)pHealth->_seq;
+   *pUptimeMs = (uint32_t)pHealth->_uptimeMs;
+   for ( int i = 0; i < pHealth->_stats_repeated_len; i++ ) {
+      pStats[i] = (uint32_t)pHealth->_stats[i];
+   }
+   *pStatsLen = pHealth->_stats_repeated_len;
+
+   return API_ERR_NONE;
+}
+
+/******************************************************************************/
+APIError_t ClientApi::DC3_discover(
+      struct DC3DiscoverPayloadMsg* const pBoards,
+      const size_t boardsSize,
+      size_t* pNBoards,
+      const uint16_t windowMs
+)
+{
+   if ( NULL == pBoards ) {
+      ERR_printf(m_pLog, "NULL pointer passed in for boards buffer");
+      return API_ERR_MEM_NULL_VALUE;
+   }
+
+   this->enableMsgCallbacks();
+
+   /* These will be used for responses */
+   DC3BasicMsg basicMsg;
+   DC3PayloadMsgUnion_t payloadMsgUnion;
+
+   /* Every board answers with the ID of this request so it has to be a new one
+    * to tell the answers apart from anything left over from before */
+   this->m_msgId++;
+   this->m_basicMsg._msgID       = this->m_msgId;
+   this->m_basicMsg._msgReqProg  = 0;
+   this->m_basicMsg._msgRoute    = this->m_msgRoute;
+   this->m_basicMsg._msgType     = _DC3_Req;
+   this->m_basicMsg._msgName     = _DC3DiscoverMsg;
+   this->m_basicMsg._msgPayload  = _DC3NoMsg;
+
+   uint8_t buffer[DC3_MAX_MSG_LEN];
+   unsigned int bufferLen = 0;
+   bufferLen = DC3BasicMsg_write_delimited_to(&m_basicMsg, buffer, 0);
+   l_pComm->write_some((char *)buffer, bufferLen);                   // Send Req
+
+   *pNBoards = 0;
+   size_t nDropped = 0;
+
+   /* There's no telling how many boards there are so there's no last Done to
+    * wait for.  Take whatever comes in until the window closes. */
+   const boost::posix_time::ptime end =
+         boost::posix_time::microsec_clock::universal_time() +
+         boost::posix_time::milliseconds(windowMs);
+   while ( boost::posix_time::microsec_clock::universal_time() < end ) {
+      memset(&basicMsg, 0, sizeof(basicMsg));
+      memset(&payloadMsgUnion, 0, sizeof(payloadMsgUnion));
+      APIError_t clientStatus = pollForResp( &basicMsg, &payloadMsgUnion );
+      if ( API_ERR_MSG_WAITING_FOR_RESP == clientStatus ) {
+         boost::this_thread::sleep(boost::posix_time::milliseconds(TIME_POLLING_MSEC));
+         continue;
+      }
+
+      /* Skip the Acks, the Dones of boards that don't know the msg, and
+       * anything that isn't an answer to this request. */
+      if ( API_ERR_NONE != clientStatus ||
+           _DC3_Done != basicMsg._msgType ||
+           _DC3DiscoverMsg != basicMsg._msgName ||
+           _DC3DiscoverPayloadMsg != basicMsg._msgPayload ||
+           this->m_msgId != basicMsg._msgID ) {
+         continue;
+      }
+
+      struct DC3DiscoverPayloadMsg *pBoard = &payloadMsgUnion.discoverPayload;
+      bool bSeen = false;
+      for ( size_t i = 0; i < *pNBoards && !bSeen; i++ ) {
+         bSeen = pBoards[i]._ipAddr == pBoard->_ipAddr &&
+               pBoards[i]._mac_len == pBoard->_mac_len &&
+               0 == memcmp(pBoards[i]._mac, pBoard->_mac, pBoard->_mac_len);
+      }
+      if ( bSeen ) {
+         continue;
+      }
+
+      if ( *pNBoards < boardsSize ) {
+         pBoards[(*pNBoards)++] = *pBoard;
+      } else {
+         nDropped++;
+      }
+   }
+
+   if ( 0 != nDropped ) {
+      ERR_printf(m_pLog,
+            "Buffer of %d boards is too small, %d more boards answered",
+            boardsSize, nDropped);
+      return API_ERR_MEM_BUFFER_LEN;
+   }
+
+   return API_ERR_NONE;
+}
+
 
 /******************************************************************************/
 APIError_t ClientApi::setNewConnection(
@@ -1042,6 +2420,26 @@ APIError_t ClientApi::setNewConnection(
    return( API_ERR_NONE );
 }
 
+/******************************************************************************/
+APIError_t ClientApi::setNewTcpConnection(
+      const char* ipAddress,
+      const char* pRemPort
+)
+{
+   try {
+      l_pComm = new Comm(m_pLog, ipAddress, pRemPort, &queue);
+   } catch  ( exception &e ) {
+      ERR_printf(
+            m_pLog,"Exception trying to open TCP connection: %s",
+            e.what()
+      );
+      return( API_ERR_TCP_EXCEPTION_CAUGHT );
+   }
+
+   m_msgRoute = _DC3_EthSys;
+   return( API_ERR_NONE );
+}
+
 /******************************************************************************/
 APIError_t ClientApi::setNewConnection(
       const char *dev_name,
@@ -1176,6 +2574,15 @@ APIError_t ClientApi::pollForResp(
                   offset
             );
             break;
+         case _DC3FlashMetaPayloadMsg:
+            status = API_ERR_NONE;
+            DBG_printf( m_pLog, "FlashMeta payload detected");
+            DC3FlashMetaPayloadMsg_read_delimited_from(
+                  (void*)msg.dataBuf,
+                  &(payloadMsgUnion->flashMetaPayload),
+                  offset
+            );
+            break;
          case _DC3DBDataPayloadMsg:
             status = API_ERR_NONE;
             DBG_printf( m_pLog, "DBDatapayload detected");
@@ -1185,6 +2592,64 @@ APIError_t ClientApi::pollForResp(
                   offset
             );
             break;
+         case _DC3FlashSectorCrcPayloadMsg:
+            status = API_ERR_NONE;
+            DBG_printf( m_pLog, "FlashSectorCrc payload detected");
+            DC3FlashSectorCrcPayloadMsg_read_delimited_from(
+                  (void*)msg.dataBuf,
+                  &(payloadMsgUnion->flashSectorCrcPayload),
+                  offset
+            );
+            break;
+         case _DC3DBElemsPayloadMsg:
+            status = API_ERR_NONE;
+            DBG_printf( m_pLog, "DBElems payload detected");
+            DC3DBElemsPayloadMsg_read_delimited_from(
+                  (void*)msg.dataBuf,
+                  &(payloadMsgUnion->dbElemsPayload),
+                  offset
+            );
+            break;
+         case _DC3MemDataPayloadMsg:
+            status = API_ERR_NONE;
+            DC3MemDataPayloadMsg_read_delimited_from(
+                  (void*)msg.dataBuf,
+                  &(payloadMsgUnion->memDataPayload),
+                  offset
+            );
+            break;
+         case _DC3ProfPayloadMsg:
+            status = API_ERR_NONE;
+            DC3ProfPayloadMsg_read_delimited_from(
+                  (void*)msg.dataBuf,
+                  &(payloadMsgUnion->profPayload),
+                  offset
+            );
+            break;
+         case _DC3MemStatsPayloadMsg:
+            status = API_ERR_NONE;
+            DC3MemStatsPayloadMsg_read_delimited_from(
+                  (void*)msg.dataBuf,
+                  &(payloadMsgUnion->memStatsPayload),
+                  offset
+            );
+            break;
+         case _DC3HealthPayloadMsg:
+            status = API_ERR_NONE;
+            DC3HealthPayloadMsg_read_delimited_from(
+                  (void*)msg.dataBuf,
+                  &(payloadMsgUnion->healthPayload),
+                  offset
+            );
+            break;
+         case _DC3DiscoverPayloadMsg:
+            status = API_ERR_NONE;
+            DC3DiscoverPayloadMsg_read_delimited_from(
+                  (void*)msg.dataBuf,
+                  &(payloadMsgUnion->discoverPayload),
+                  offset
+            );
+            break;
          default:
             status = API_ERR_MSG_UNKNOWN_PAYLOAD;
             ERR_printf( m_pLog, "Unknown payload detected. Error: 0x%08x", status);
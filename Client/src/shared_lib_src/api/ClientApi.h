@@ -65,7 +65,7 @@ private:
 
    unsigned int m_msgId;   /* Msg ID incrementing counter for unique msg ids. */
    bool m_bRequestProg;     /* Flag to see if progress messages are requested */
-   DC3MsgRoute_t m_msgRoute; /* This is set based on the connection used (UDP vs Serial) */
+   DC3MsgRoute_t m_msgRoute; /* This is set based on the connection used (UDP vs TCP vs Serial) */
 
    boost::thread m_workerThread;          /**< Thread to start MainMgr and QF */
 
@@ -79,6 +79,12 @@ private:
    struct DC3I2CDataPayloadMsg   m_i2cDataPayloadMsg;
    struct DC3DbgPayloadMsg       m_dbgPayloadMsg;
    struct DC3DBDataPayloadMsg    m_dbPayloadMsg;
+   struct DC3FlashSectorCrcPayloadMsg m_flashSectorCrcPayloadMsg;
+   struct DC3MemDataPayloadMsg   m_memDataPayloadMsg;
+   struct DC3DBElemsPayloadMsg   m_dbElemsPayloadMsg;
+   struct DC3ProfPayloadMsg      m_profPayloadMsg;
+   struct DC3MemStatsPayloadMsg  m_memStatsPayloadMsg;
+   struct DC3HealthPayloadMsg    m_healthPayloadMsg;
 
    uint8_t dataBuf[1000];
    int dataLen;
@@ -118,6 +124,78 @@ private:
          uint16_t timeoutSecs
    );
 
+   /**
+    * @brief   Sends a FW image to DC3 as a FlashMetaPayloadMsg followed by as
+    * many FlashDataPayloadMsgs as it takes.  Doesn't care what mode DC3 is in;
+    * callers are responsible for that.
+    * @param [out] *status: DC3Error_t pointer to the returned status of from
+    * the DC3 board.
+    *    @arg  ERR_NONE: success.
+    *    other error codes if failure.
+    * @param [in] type: DC3BootMode_t that specifies the FW image type.
+    * @param [in] *filename: const char pointer to a path and file where the
+    * FW image file can be found.
+    * @param [in] bDelta: bool that specifies whether to compare the flash
+    * sector CRCs of the image already on DC3 and only send the sectors that
+    * changed.  Falls back to sending the entire image if DC3 can't do it.
+    * @return: APIError_t status of the client executing the command.
+    *    @arg  API_ERR_NONE: success
+    *    other error codes if failure.
+    */
+   APIError_t sendFWImage(
+         DC3Error_t *status,
+         DC3BootMode_t type,
+         const char *filename,
+         bool bDelta
+   );
+
+   /**
+    * @brief   Sends another DC3MemReadMsg Req for the memory read that's
+    * currently running.  Uses the msg ID and payload of the original request.
+    * @param [in] credits: uint16_t how many more frames DC3 is allowed to send.
+    * @param [in] bAbort: bool that specifies whether to tell DC3 to stop
+    * sending frames instead.
+    * @return  None
+    */
+   void sendMemReadCredits( uint16_t credits, bool bAbort );
+
+   /**
+    * @brief   Reads or writes a range of an I2C device as a series of
+    * DC3I2CReadMsg or DC3I2CWriteMsg Reqs.
+    *
+    * The range is split up so that every Req after the first one starts on an
+    * EEPROM page boundary.  Several Reqs are kept in flight at once and DC3
+    * handles them in order so the Done msgs are matched up with the Reqs by
+    * their msg IDs.  Once a Req fails, no more are sent and the ones already
+    * on their way are drained.
+    *
+    * @param [out] *status: DC3Error_t pointer to the returned status of from
+    * the DC3 board.  This is the status of the first Req that failed.
+    * @param [in] *pWrData: const uint8_t pointer to the data to write.  NULL if
+    * reading.
+    * @param [out] *pRdData: uint8_t pointer to where to put the data that's
+    * read.  NULL if writing.
+    * @param [in] bytes: size_t size of the range.
+    * @param [in] start: int offset into the device where the range starts.
+    * @param [in] dev: DC3I2CDevice_t I2C device to access.
+    * @param [in] acc: DC3AccessType_t access to use to get at the I2C bus.
+    * @param [out] *pBytesDone: size_t pointer to how many bytes of the range
+    * were read or written.
+    * @return: APIError_t status of the client executing the command.
+    *    @arg  API_ERR_NONE: success
+    *    other error codes if failure.
+    */
+   APIError_t xferI2CRange(
+         DC3Error_t *status,
+         const uint8_t *pWrData,
+         uint8_t *pRdData,
+         const size_t bytes,
+         const int start,
+         const DC3I2CDevice_t dev,
+         const DC3AccessType_t acc,
+         size_t *pBytesDone
+   );
+
 public:
 
    /****************************************************************************
@@ -162,6 +240,12 @@ public:
 
    /**
     * @brief   Blocking cmd to get the current boot mode of DC3.
+    *
+    * Only the flash sectors whose contents differ from the new FW image get
+    * erased and written (see DC3_getFWSectorCRCs()).  The CRC of the entire
+    * image is still checked by DC3 once the transfer is done.  The data is
+    * sent LZSS compressed whenever that takes fewer packets.
+    *
     * @param [out] *status: DC3Error_t pointer to the returned status of from
     * the DC3 board.
     *    @arg  ERR_NONE: success.
@@ -186,6 +270,74 @@ public:
          const char *filename
    );
 
+   /**
+    * @brief   Blocking cmd to stage a FW image on the DC3 while it keeps
+    * running the Application.
+    *
+    * Unlike DC3_flashFW(), DC3 is not reset and stays in service while the
+    * image is transferred into the staged flash slot.  The Bootloader
+    * installs the staged image on the next reboot (e.g. DC3_setMode() to
+    * _DC3_Bootloader followed by DC3_setMode() to _DC3_Application).
+    *
+    * @param [out] *status: DC3Error_t pointer to the returned status of from
+    * the DC3 board.
+    *    @arg  ERR_NONE: success.
+    *    @arg  ERR_MSG_UNSUPPORTED_IN_BOOTLOADER: DC3 is not running the
+    *    Application.  Use DC3_flashFW() instead.
+    *    other error codes if failure.
+    * @note: unless this variable is set to ERR_NONE at the completion, the
+    * results of other returned data should not be trusted.
+    *
+    * @param [in] type: DC3BootMode_t that specifies where the FW image will be
+    * staged to
+    *    @arg  _DC3_Application: stage the FW image for the application space.
+    * @param [in] *filename: const char pointer to a path and file where the
+    * FW image file can be found.
+    *
+    * @return: APIError_t status of the client executing the command.
+    *    @arg  API_ERR_NONE: success
+    *    other error codes if failure.
+    */
+   APIError_t DC3_stageFW(
+         DC3Error_t *status,
+         DC3BootMode_t type,
+         const char *filename
+   );
+
+   /**
+    * @brief   Blocking cmd to get the CRC of each flash sector holding the FW
+    * image currently on DC3.  Only supported by the Bootloader.
+    * @param [out] *status: DC3Error_t pointer to the returned status of from
+    * the DC3 board.
+    *    @arg  ERR_NONE: success.
+    *    other error codes if failure.
+    * @note: unless this variable is set to ERR_NONE at the completion, the
+    * results of other returned data should not be trusted.
+    *
+    * @param [in] type: DC3BootMode_t that specifies which FW image to check.
+    *    @arg  _DC3_Application: the application FW image.
+    * @param [in] imageSize: uint32_t size of the (new) FW image.  The last CRC
+    * only covers the flash up to this many bytes from the start of the image.
+    * @param [out] *pCrcs: uint32_t pointer to the array where the CRCs will be
+    * stored.
+    * @param [out] *pSizes: uint32_t pointer to the array where the number of
+    * bytes covered by each CRC will be stored.
+    * @param [in] arraySize: size_t size of the pCrcs and pSizes arrays.
+    * @param [out] *pNumSectors: size_t pointer to how many CRCs were stored.
+    * @return: APIError_t status of the client executing the command.
+    *    @arg  API_ERR_NONE: success
+    *    other error codes if failure.
+    */
+   APIError_t DC3_getFWSectorCRCs(
+         DC3Error_t *status,
+         DC3BootMode_t type,
+         uint32_t imageSize,
+         uint32_t *pCrcs,
+         uint32_t *pSizes,
+         const size_t arraySize,
+         size_t *pNumSectors
+   );
+
    /**
     * @brief   Blocking cmd to read I2C device on the DC3.
     * @param [out] *status: DC3Error_t pointer to the returned status of from
@@ -260,6 +412,83 @@ public:
          const DC3AccessType_t  acc
    );
 
+   /**
+    * @brief   Blocking cmd to read a range of an I2C device on the DC3 that
+    * may be bigger than what fits into a single msg.
+    *
+    * The range is read in chunks of up to DC3_I2C_MAX_XFER_LEN bytes with
+    * several chunks in flight at once so the whole EEPROM can be read in about
+    * the time it takes DC3 to do the I2C accesses.
+    *
+    * @param [out] *status: DC3Error_t pointer to the returned status of from
+    * the DC3 board.
+    *    @arg  ERR_NONE: success.
+    *    other error codes if failure.
+    * @note: unless this variable is set to ERR_NONE at the completion, the
+    * results of other returned data should not be trusted.
+    * @param [out] *pBytesRead: size_t pointer to number of bytes read.
+    * @param [out] *pBuffer: pointer to buffer where data will be stored.
+    * @param [in] bufferSize: size_t size of *pBuffer storage area.
+    * @param [in] bytes: size_t number of bytes to read.
+    * @param [in] start: where to start reading from
+    * @param [in] dev: DC3I2CDevice_t type that specifies the I2C device to read
+    *    @arg _DC3_EEPROM: read from the EEPROM on I2C bus 1.
+    *    @arg _DC3_SNROM: read from the RO SerialNumber ROM on I2C bus 1.
+    *    @arg _DC3_EUIROM: read from the RO Unique number ROM on I2C bus 1.
+    * @param [in] acc: DC3AccessType_t  type that specifies the access to use to get
+    * at the I2C bus.
+    *    @arg _DC3_ACCESS_BARE: bare metal access. Blocking and slow. For testing only.
+    *    @arg _DC3_ACCESS_QPC: use event driven QPC access.
+    *    @arg _DC3_ACCESS_FRT: use event driven FreeRTOS access.  Available in
+    *    Application only.
+    *
+    * @return: APIError_t status of the client executing the command.
+    *    @arg  API_ERR_NONE: success
+    *    other error codes if failures.
+    */
+   APIError_t DC3_readI2CRange(
+         DC3Error_t *status,
+         size_t *pBytesRead,
+         uint8_t *pBuffer,
+         const size_t bufferSize,
+         const size_t bytes,
+         const int start,
+         const DC3I2CDevice_t dev,
+         const DC3AccessType_t  acc
+   );
+
+   /**
+    * @brief   Blocking cmd to write a range of an I2C device on the DC3 that
+    * may be bigger than what fits into a single msg.
+    *
+    * The range is split up at EEPROM page boundaries into chunks of up to
+    * DC3_I2C_MAX_XFER_LEN bytes with several chunks in flight at once.
+    *
+    * @param [out] *status: DC3Error_t pointer to the returned status of from
+    * the DC3 board.
+    *    @arg  ERR_NONE: success.
+    *    other error codes if failure.
+    * @param [in] *pBuffer: pointer to buffer where data to write is stored.
+    * @param [in] bytes: size_t number of bytes to write
+    * @param [in] start: where to start writing to (offset)
+    * @param [in] dev: DC3I2CDevice_t type that specifies the I2C device to
+    * write.  Only _DC3_EEPROM is writable.
+    * @param [in] acc: DC3AccessType_t  type that specifies the access to use to get
+    * at the I2C bus.
+    *
+    * @return: APIError_t status of the client executing the command.
+    *    @arg  API_ERR_NONE: success
+    *    other error codes if failures.
+    */
+   APIError_t DC3_writeI2CRange(
+         DC3Error_t *status,
+         const uint8_t* const pBuffer,
+         const size_t bytes,
+         const int start,
+         const DC3I2CDevice_t dev,
+         const DC3AccessType_t  acc
+   );
+
    /**
     * @brief   Blocking cmd to start a test of external RAM of DC3.
     * @param [out] *status: DC3Error_t pointer to the returned status of from
@@ -289,6 +518,69 @@ public:
          uint32_t* addr
    );
 
+   /**
+    * @brief   Blocking cmd to read a range of flash, NOR, or SDRAM from DC3.
+    *
+    * DC3 streams the data back as a series of Prog msgs without waiting for an
+    * Ack for each one.  Every frame is checked for its sequence number and CRC
+    * and the read is aborted on the first bad one.
+    *
+    * @param [out] *status: DC3Error_t pointer to the returned status of from
+    * the DC3 board.
+    *    @arg  ERR_NONE: success.
+    *    other error codes if failure.
+    * @note: unless this variable is set to ERR_NONE at the completion, the
+    * results of other returned data should not be trusted.
+    * @param [in] memSpace: DC3MemSpace_t memory to read.
+    *    @arg _DC3_MEM_FLASH: internal flash, starting at 0x08000000.
+    *    @arg _DC3_MEM_NOR: external NOR flash.  Application only.
+    *    @arg _DC3_MEM_SDRAM: external SDRAM.
+    * @param [in] offset: uint32_t offset into the memory where to start
+    * reading.  Has to be 4 byte aligned.
+    * @param [in] length: uint32_t number of bytes to read.
+    * @param [out] *pBuffer: uint8_t pointer to buffer where data will be stored.
+    * @param [in] bufferSize: size_t size of *pBuffer storage area.
+    * @param [out] *pBytesRead: size_t pointer to number of bytes read.
+    * @return: APIError_t status of the client executing the command.
+    *    @arg  API_ERR_NONE: success
+    *    other error codes if failure.
+    */
+   APIError_t DC3_readMem(
+         DC3Error_t *status,
+         DC3MemSpace_t memSpace,
+         uint32_t offset,
+         uint32_t length,
+         uint8_t *pBuffer,
+         const size_t bufferSize,
+         size_t *pBytesRead
+   );
+
+   /**
+    * @brief   Blocking cmd to dump a range of flash, NOR, or SDRAM from DC3 to
+    * a binary file.  See DC3_readMem() for details.
+    *
+    * @param [out] *status: DC3Error_t pointer to the returned status of from
+    * the DC3 board.
+    *    @arg  ERR_NONE: success.
+    *    other error codes if failure.
+    * @param [in] memSpace: DC3MemSpace_t memory to read.
+    * @param [in] offset: uint32_t 4 byte aligned offset into the memory where
+    * to start reading.
+    * @param [in] length: uint32_t number of bytes to read.
+    * @param [in] *filename: const char pointer to a path and file where to
+    * write the data.
+    * @return: APIError_t status of the client executing the command.
+    *    @arg  API_ERR_NONE: success
+    *    other error codes if failure.
+    */
+   APIError_t DC3_readMemToFile(
+         DC3Error_t *status,
+         DC3MemSpace_t memSpace,
+         uint32_t offset,
+         uint32_t length,
+         const char *filename
+   );
+
 
    /**
     * @brief   Blocking cmd to get the DBG module status from DC3.
@@ -464,6 +756,262 @@ public:
          size_t* pBytesInBuffer
    );
 
+   /**
+    * @brief   Blocking cmd to get several elements from DB settings on the DC3
+    * in a single request.
+    *
+    * The DC3 reads all the requested elements that live on the same device
+    * with a single access so this is much faster than calling DC3_getDbElem()
+    * for each one.
+    *
+    * @param [out] *status: DC3Error_t pointer to the returned status of from
+    * the DC3 board.
+    *    @arg  ERR_NONE: success.
+    *    other error codes if failure.
+    * @note: unless this variable is set to ERR_NONE at the completion, the
+    * results of other returned data should not be trusted.
+    *
+    * @param [in] *pElems: const DC3DBElem_t pointer to the elements to get.
+    * @param [in] nElems: const size_t number of elements in pElems.
+    * @param [in] acc: const DC3AccessType_t specifying the access type to use.
+    * @param [in] bufferSize: const size_t specifying the max size of the buffer
+    * where to write the data to.
+    * @param [in|out] *pBuffer: uint8_t const pointer to the storage where to
+    * store the retrieved DB element data.  The elements are packed back to back
+    * in the same order as pElems.
+    * @param [out] *pElemLens: size_t pointer to an array of at least nElems
+    * where the length of each element in pBuffer is returned.
+    * @param [in|out] *pBytesInBuffer: size_t pointer to how many bytes are in
+    * the buffer upon successful DB element read.
+    *
+    * @return: APIError_t status of the client executing the command.
+    *    @arg  API_ERR_NONE: success
+    *    other error codes if failure.
+    */
+   APIError_t DC3_getDbElems(
+         DC3Error_t* status,
+         const DC3DBElem_t* const pElems,
+         const size_t nElems,
+         const DC3AccessType_t  acc,
+         const size_t bufferSize,
+         uint8_t* const pBuffer,
+         size_t* const pElemLens,
+         size_t* pBytesInBuffer
+   );
+
+   /**
+    * @brief   Blocking cmd to set several elements in DB settings on the DC3
+    * in a single request.
+    *
+    * The DC3 writes all the elements to the EEPROM with a single write.
+    *
+    * @param [out] *status: DC3Error_t pointer to the returned status of from
+    * the DC3 board.
+    *    @arg  ERR_NONE: success.
+    *    other error codes if failure.
+    *
+    * @param [in] *pElems: const DC3DBElem_t pointer to the elements to set.
+    * @param [in] nElems: const size_t number of elements in pElems.
+    * @param [in] acc: const DC3AccessType_t specifying the access type to use.
+    * @param [in] *pBuffer: const uint8_t pointer to the new values of all the
+    * elements packed back to back in the same order as pElems.
+    * @param [in] *pElemLens: const size_t pointer to the length of each
+    * element in pBuffer.  These have to match the sizes of the elements.
+    *
+    * @return: APIError_t status of the client executing the command.
+    *    @arg  API_ERR_NONE: success
+    *    other error codes if failure.
+    */
+   APIError_t DC3_setDbElems(
+         DC3Error_t* status,
+         const DC3DBElem_t* const pElems,
+         const size_t nElems,
+         const DC3AccessType_t  acc,
+         const uint8_t* const pBuffer,
+         const size_t* const pElemLens
+   );
+
+   /**
+    * @brief   Blocking cmd to get a page of Active Object dispatch profiling
+    * records from the DC3.
+    *
+    * Only the Application keeps these and only if it was built with
+    * AO_PROF=1.  See DC3CommApi.h for the layout of each kind of record.
+    *
+    * @param [out] *status: DC3Error_t pointer to the returned status of from
+    * the DC3 board.
+    *    @arg  ERR_NONE: success.
+    *    other error codes if failure.
+    * @note: unless this variable is set to ERR_NONE at the completion, the
+    * results of other returned data should not be trusted.
+    *
+    * @param [in] recType: const DC3ProfRec_t kind of records to get.
+    * @param [in] index: const uint16_t index of the first record to get.
+    * @param [in] bReset: const bool whether to clear all the stats on the DC3
+    * once this page is filled in.
+    * @param [out] *pNRecs: uint16_t pointer to the total number of records of
+    * recType that the DC3 has.
+    * @param [out] *pTickHz: uint32_t pointer to the ticks per second of all
+    * the times in the records.
+    * @param [out] *pName: char pointer to a buffer where to write the NULL
+    * terminated name of the AO for _DC3_PROF_AO records.  Empty otherwise.
+    * @param [in] nameSize: const size_t size of the pName buffer.
+    * @param [out] *pStats: uint32_t pointer to where to write the record(s).
+    * @param [in] statsSize: const size_t max number of values in pStats.
+    * @param [out] *pStatsLen: size_t pointer to the number of values written
+    * to pStats.
+    *
+    * @return: APIError_t status of the client executing the command.
+    *    @arg  API_ERR_NONE: success
+    *    other error codes if failure.
+    */
+   APIError_t DC3_getProfRecs(
+         DC3Error_t* status,
+         const DC3ProfRec_t recType,
+         const uint16_t index,
+         const bool bReset,
+         uint16_t* pNRecs,
+         uint32_t* pTickHz,
+         char* const pName,
+         const size_t nameSize,
+         uint32_t* const pStats,
+         const size_t statsSize,
+         size_t* pStatsLen
+   );
+
+   /**
+    * @brief   Blocking cmd to get the usage of one event pool, memory pool, or
+    * event queue from the DC3.
+    *
+    * Only the Application supports this.  See DC3CommApi.h for the layout of
+    * the record.
+    *
+    * @param [out] *status: DC3Error_t pointer to the returned status of from
+    * the DC3 board.
+    *    @arg  ERR_NONE: success.
+    *    other error codes if failure.
+    * @note: unless this variable is set to ERR_NONE at the completion, the
+    * results of other returned data should not be trusted.
+    *
+    * @param [in] index: const uint16_t index of the record to get.
+    * @param [out] *pNRecs: uint16_t pointer to the total number of records
+    * that the DC3 has.
+    * @param [out] *pKind: DC3MemStatsKind_t pointer to what the record
+    * describes.
+    * @param [out] *pName: char pointer to a buffer where to write the NULL
+    * terminated name of the pool or queue.  Empty if it doesn't have one.
+    * @param [in] nameSize: const size_t size of the pName buffer.
+    * @param [out] *pStats: uint32_t pointer to where to write the record.
+    * @param [in] statsSize: const size_t max number of values in pStats.
+    * @param [out] *pStatsLen: size_t pointer to the number of values written
+    * to pStats.
+    *
+    * @return: APIError_t status of the client executing the command.
+    *    @arg  API_ERR_NONE: success
+    *    other error codes if failure.
+    */
+   APIError_t DC3_getMemStats(
+         DC3Error_t* status,
+         const uint16_t index,
+         uint16_t* pNRecs,
+         DC3MemStatsKind_t* pKind,
+         char* const pName,
+         const size_t nameSize,
+         uint32_t* const pStats,
+         const size_t statsSize,
+         size_t* pStatsLen
+   );
+
+   /**
+    * @brief   Blocking cmd to start or stop the health stream of the DC3.
+    *
+    * Once started, the DC3 pushes a DC3HealthMsg Prog msg every intervalMs to
+    * the host that sent this, without being asked.  Use DC3_waitForHealth() to
+    * get them.  Only the Application supports this and only over UDP.
+    *
+    * @param [out] *status: DC3Error_t pointer to the returned status of from
+    * the DC3 board.
+    *    @arg  ERR_NONE: success.
+    *    other error codes if failure.
+    * @note: unless this variable is set to ERR_NONE at the completion, the
+    * results of other returned data should not be trusted.
+    *
+    * @param [in] intervalMs: const uint32_t time between pushed msgs in ms.
+    * 0 stops the stream.
+    * @param [in] port: const uint16_t UDP port to push to.  0 for the port
+    * this client is using, which is what DC3_waitForHealth() expects.
+    *
+    * @return: APIError_t status of the client executing the command.
+    *    @arg  API_ERR_NONE: success
+    *    other error codes if failure.
+    */
+   APIError_t DC3_subscribeHealth(
+         DC3Error_t* status,
+         const uint32_t intervalMs,
+         const uint16_t port
+   );
+
+   /**
+    * @brief   Blocks until the next msg of the health stream comes in.
+    *
+    * Anything else that comes in while waiting is dropped.  See DC3CommApi.h
+    * for the layout of the stats.
+    *
+    * @param [out] *pSeq: uint32_t pointer to the sequence number of the msg.
+    * Gaps in it are pushed msgs that were lost.
+    * @param [out] *pUptimeMs: uint32_t pointer to the time since the DC3 booted
+    * in ms.
+    * @param [out] *pStats: uint32_t pointer to where to write the stats.
+    * @param [in] statsSize: const size_t max number of values in pStats.
+    * @param [out] *pStatsLen: size_t pointer to the number of values written
+    * to pStats.
+    * @param [in] timeoutSecs: const uint16_t how long to wait for it.
+    *
+    * @return: APIError_t status of the client executing the command.
+    *    @arg  API_ERR_NONE: success
+    *    @arg  API_ERR_TIMEOUT_WAITING_FOR_RESP: no msg came in time.
+    *    other error codes if failure.
+    */
+   APIError_t DC3_waitForHealth(
+         uint32_t* pSeq,
+         uint32_t* pUptimeMs,
+         uint32_t* const pStats,
+         const size_t statsSize,
+         size_t* pStatsLen,
+         const uint16_t timeoutSecs
+   );
+
+   /**
+    * @brief   Blocking cmd to find all the DC3 boards that can hear this client.
+    *
+    * Sends a single DC3DiscoverMsg and collects every answer that comes back
+    * for windowMs.  Set up the connection with the broadcast address of the
+    * subnet (or 255.255.255.255) to hear from every board on it at once.  Any
+    * other connection only finds the one board it's connected to.  Boards that
+    * answer more than once are only listed once.  Boards running FW that
+    * doesn't know the msg are skipped.
+    *
+    * @param [out] *pBoards: DC3DiscoverPayloadMsg pointer to where to write the
+    * answers.  The errorCode field of each says whether everything about that
+    * board could be read.
+    * @param [in] boardsSize: const size_t max number of answers in pBoards.
+    * @param [out] *pNBoards: size_t pointer to the number of answers written
+    * to pBoards.
+    * @param [in] windowMs: const uint16_t how long to collect answers for.
+    *
+    * @return: APIError_t status of the client executing the command.
+    *    @arg  API_ERR_NONE: success, even if no board answered.
+    *    @arg  API_ERR_MEM_BUFFER_LEN: more boards answered than fit in pBoards.
+    *    The ones that fit are still returned.
+    *    other error codes if failure.
+    */
+   APIError_t DC3_discover(
+         struct DC3DiscoverPayloadMsg* const pBoards,
+         const size_t boardsSize,
+         size_t* pNBoards,
+         const uint16_t windowMs
+   );
+
    /****************************************************************************
     *                    Client control functionality
     ***************************************************************************/
@@ -480,6 +1028,19 @@ public:
          const char* pLocPort
    );
 
+   /**
+    * @brief   Sets up a new ethernet connection to the TCP sys port.
+    * The msgs are the same as over UDP but TCP takes care of getting them
+    * there so FW images are sent several packets at a time.
+    * @param[in]   *ipAddress: pointer to the remote IP address string.
+    * @param[in]   *pRemPort: pointer to the remote port number string.
+    * @return  None.
+    */
+   APIError_t setNewTcpConnection(
+         const char* ipAddress,
+         const char* pRemPort
+   );
+
    /**
     * @brief   Sets up a new serial connection
     * @param[in]   dev_name: serial device name.  /dev/ttyS10 or COMX
@@ -44,6 +44,8 @@ APIError_t Comm::write_some( char* message, uint16_t len )
       this->m_pSer->write_some( enDataBuf, encDataLen );
    } else if ( this->m_pUdp ) {
       this->m_pUdp->write_some( message, len );
+   } else if ( this->m_pTcp ) {
+      this->m_pTcp->write_some( message, len );
    } else {
       ERR_printf(this->m_pLog, "No comm interface have been set up.");
       return API_ERR_COMM_NOT_SET;
@@ -60,6 +62,8 @@ void Comm::setLogging( LogStub *log )
       this->m_pSer->setLogging( log);
    } else if ( this->m_pUdp ) {
       this->m_pUdp->setLogging( log );
+   } else if ( this->m_pTcp ) {
+      this->m_pTcp->setLogging( log );
    } else {
       WRN_printf(this->m_pLog, "No active connections to set logging for");
    }
@@ -72,7 +76,7 @@ Comm::Comm(
       int baud_rate,
       bool bDFUSEComm,
       boost::lockfree::queue<MsgData_t> *pQueue
-) : m_pLog(NULL), m_pUdp(NULL), m_pSer(NULL)
+) : m_pLog(NULL), m_pUdp(NULL), m_pTcp(NULL), m_pSer(NULL)
 {
    this->m_pLog = log;
    this->m_pSer = new Serial( dev_name, baud_rate, bDFUSEComm, pQueue);
@@ -86,18 +90,32 @@ Comm::Comm(
       const char *pRemPort,
       const char *pLocPort,
       boost::lockfree::queue<MsgData_t> *pQueue
-) : m_pLog(NULL), m_pUdp(NULL), m_pSer(NULL)
+) : m_pLog(NULL), m_pUdp(NULL), m_pTcp(NULL), m_pSer(NULL)
 {
    this->m_pLog = log;
    this->m_pUdp = new Udp( ipAddress, pRemPort, pLocPort, pQueue);
    this->m_pUdp->setLogging( log );
 }
 
+/******************************************************************************/
+Comm::Comm(
+      LogStub *log,
+      const char *ipAddress,
+      const char *pRemPort,
+      boost::lockfree::queue<MsgData_t> *pQueue
+) : m_pLog(NULL), m_pUdp(NULL), m_pTcp(NULL), m_pSer(NULL)
+{
+   this->m_pLog = log;
+   this->m_pTcp = new Tcp( ipAddress, pRemPort, pQueue);
+   this->m_pTcp->setLogging( log );
+}
+
 /******************************************************************************/
 Comm::~Comm( void )
 {
    delete[] this->m_pLog;
    delete[] this->m_pSer;
    delete[] this->m_pUdp;
+   delete[] this->m_pTcp;
 }
 /******** Copyright (C) 2015 Harry Rostovtsev. All rights reserved *****END OF FILE****/
@@ -17,6 +17,7 @@
 #include "LogStub.h"
 #include "serial.h"
 #include "udp.h"
+#include "tcp.h"
 
 #include <boost/lockfree/queue.hpp>
 #include "msg_utils.h"
@@ -32,15 +33,16 @@
  *
  * @brief This class abstracts various communication channels
  *
- * This class is responsible for abstracting serial, ethernet (UDP) (and
- * possibly others) in with an interface that provides the same interface to all
- * the different ways to access the FW.
+ * This class is responsible for abstracting serial, ethernet (UDP and TCP)
+ * (and possibly others) in with an interface that provides the same interface
+ * to all the different ways to access the FW.
  */
 class Comm {
 
 private:
    LogStub *m_pLog; /**< Pointer to LogStub instance used for logging */
    Udp     *m_pUdp; /**< Pointer to an Udp object */
+   Tcp     *m_pTcp; /**< Pointer to a Tcp object */
    Serial  *m_pSer; /**< Pointer to a Serial object */
 
 public:
@@ -103,6 +105,23 @@ public:
          boost::lockfree::queue<MsgData_t> *pQueue
    );
 
+   /**
+    * @brief  Constructor that initializes a TCP ethernet interface and logging.
+    * @param [in] *log: LogStub pointer to the class that has the proper
+    *                   callbacks set up for logging.
+    * @param[in]   *ipAddress: pointer to the remote IP address string.
+    * @param[in]   *pRemPort: pointer to the remote port number string.
+    * @param [in] *pQueue: pointer to boost lockfree queue to insert recvd data
+    * into.
+    * @return None.
+    */
+   Comm(
+         LogStub *log,
+         const char *ipAddress,
+         const char *pRemPort,
+         boost::lockfree::queue<MsgData_t> *pQueue
+   );
+
    /**
     * @brief  Default destructor.
     */
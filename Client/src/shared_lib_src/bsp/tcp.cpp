@@ -0,0 +1,169 @@
+/**
+ * @file    tcp.cpp
+ * Class that implements boost asio asynchronous TCP IO with the DC3 msgs
+ * framed by their length.
+ *
+ * @date    10/19/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "tcp.h"
+#include "LogHelper.h"
+
+/* Namespaces ----------------------------------------------------------------*/
+/* Compile-time called macros ------------------------------------------------*/
+MODULE_NAME( MODULE_TCP );
+
+/* Private typedefs ----------------------------------------------------------*/
+/* Private defines -----------------------------------------------------------*/
+/* Private macros ------------------------------------------------------------*/
+/* Private variables and Local objects ---------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+/* Private class prototypes --------------------------------------------------*/
+/* Private class methods -----------------------------------------------------*/
+
+/******************************************************************************/
+void Tcp::read_hdr_handler(
+      const boost::system::error_code& error,
+      size_t bytes_transferred
+)
+{
+   if ( error ) {
+      ERR_printf(this->m_pLog, "TCP connection lost: %s", error.message().c_str());
+      return;                          /* Nothing more is coming on this socket */
+   }
+
+   uint16_t msgLen = ((uint16_t)read_hdr_[0] << 8) | read_hdr_[1];
+   if ( 0 == msgLen || msgLen > DC3_MAX_MSG_LEN ) {
+      ERR_printf(this->m_pLog, "Bad msg length %d, dropping TCP connection", msgLen);
+      m_socket.close();
+      return;
+   }
+
+   boost::asio::async_read(
+         m_socket,
+         boost::asio::buffer(read_msg_, msgLen),
+         boost::bind(
+               &Tcp::read_msg_handler,
+               this,
+               boost::asio::placeholders::error,
+               boost::asio::placeholders::bytes_transferred
+         )
+   );
+}
+
+/******************************************************************************/
+void Tcp::read_msg_handler(
+      const boost::system::error_code& error,
+      size_t bytes_transferred
+)
+{
+   if ( error ) {
+      ERR_printf(this->m_pLog, "TCP connection lost: %s", error.message().c_str());
+      return;                          /* Nothing more is coming on this socket */
+   }
+
+   /* Construct a new msg event indicating that a msg has been received */
+   MsgData_t msg;
+   memset(&msg, 0, sizeof(msg));
+   msg.src = _DC3_EthSys;
+   msg.dst = _DC3_EthSys;
+   msg.dataLen = bytes_transferred;
+   memcpy( msg.dataBuf, read_msg_, msg.dataLen );
+
+   /* Put the data into the queue for ClientApi to read */
+   if(!this->m_pQueue->push(msg)) {
+      ERR_printf( m_pLog, "Unable to push data into queue.");
+   }
+
+   read_some();                                           /* Continue reading */
+}
+
+/******************************************************************************/
+void Tcp::read_some( void )
+{
+   boost::asio::async_read(
+         m_socket,
+         boost::asio::buffer(read_hdr_, DC3_ETH_FRAME_HDR_LEN),
+         boost::bind(
+               &Tcp::read_hdr_handler,
+               this,
+               boost::asio::placeholders::error,
+               boost::asio::placeholders::bytes_transferred
+         )
+   );
+}
+
+/******************************************************************************/
+void Tcp::write_some(const char* message, uint16_t len)
+{
+   uint8_t hdr[DC3_ETH_FRAME_HDR_LEN];
+   hdr[0] = (uint8_t)( len >> 8 );
+   hdr[1] = (uint8_t)( len );
+
+   /* Header and msg go out with a single gathered write */
+   boost::array<boost::asio::const_buffer, 2> bufs = {{
+         boost::asio::buffer( hdr, DC3_ETH_FRAME_HDR_LEN ),
+         boost::asio::buffer( message, len )
+   }};
+
+   boost::system::error_code error;
+   boost::mutex::scoped_lock lock(m_writeMutex);
+   boost::asio::write( m_socket, bufs, error );
+   if (error) {
+      ERR_printf(
+            this->m_pLog,
+            "Send error: %s.  Unable to write %d byte msg",
+            error.message().c_str(),
+            len
+      );
+   }
+}
+
+/******************************************************************************/
+void Tcp::setLogging( LogStub *log )
+{
+   this->m_pLog = log;
+   DBG_printf(this->m_pLog,"Logging setup successful.");
+}
+
+/******************************************************************************/
+Tcp::Tcp(
+      const char *ipAddress,
+      const char *pRemPort,
+      boost::lockfree::queue<MsgData_t> *pQueue
+)  : m_pQueue(NULL),
+     m_io(),
+     m_socket( m_io ),
+     m_rem_endpoint(boost::asio::ip::address::from_string(ipAddress), atoi(pRemPort))
+
+{
+   boost::system::error_code myError;
+
+   m_socket.connect( m_rem_endpoint, myError );
+   if (myError) {
+      std::cout << "Connect - " << myError.message() << std::endl;
+      exit(1);
+   }
+
+   /* Msgs are small and mostly wait on each other so don't let Nagle hold
+    * them back */
+   m_socket.set_option( boost::asio::ip::tcp::no_delay(true), myError );
+
+   this->m_pQueue = pQueue;                  /* Set the pointer to the queue */
+
+   read_some();
+
+   // run the IO service as a separate thread, so the main thread can do others
+   boost::thread t(boost::bind(&boost::asio::io_service::run, &m_io));
+}
+
+/******************************************************************************/
+Tcp::~Tcp(  )
+{
+   m_socket.close();
+}
@@ -0,0 +1,141 @@
+/**
+ * @file    tcp.h
+ * Class that implements boost asio asynchronous TCP IO with the DC3 msgs
+ * framed by their length.
+ *
+ * @date    10/19/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef TCP_H
+#define TCP_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <unistd.h>
+#include <iostream>
+
+#include <boost/asio.hpp>
+#include <boost/system/error_code.hpp>
+#include <boost/system/system_error.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+#include <boost/lockfree/queue.hpp>
+#include <boost/array.hpp>
+
+#include "LogHelper.h"
+#include "LogStub.h"
+#include "ApiShared.h"
+#include "msg_utils.h"
+
+/* Exported defines ----------------------------------------------------------*/
+/* Exported macros -----------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+/* Exported classes ----------------------------------------------------------*/
+/**
+ * @class Tcp
+ * @brief This class handles sending and receiving msgs over the TCP sys port.
+ *
+ * Unlike UDP, TCP is a stream so every msg goes out behind a
+ * DC3_ETH_FRAME_HDR_LEN byte header that holds its length (MSB first) and
+ * incoming msgs are put back together the same way before they get queued up.
+ */
+class Tcp {
+
+private:
+   LogStub *m_pLog;         /**< Pointer to LogStub instance used for logging */
+   boost::lockfree::queue<MsgData_t> *m_pQueue; /**< Pointer to the queue where
+                                                     to put read data */
+   uint8_t read_hdr_[DC3_ETH_FRAME_HDR_LEN]; /**< buffer to hold msg headers */
+   char read_msg_[DC3_MAX_MSG_LEN];          /**< buffer to hold incoming msgs */
+   boost::mutex m_writeMutex;          /**< keeps whole msgs together on writes */
+
+   boost::asio::io_service m_io;/**< internal instance of boost's io_service  */
+   boost::asio::ip::tcp::socket m_socket;/**< internal instance of boost's socket */
+   boost::asio::ip::tcp::endpoint m_rem_endpoint; /**< internal instance of a remote TCP endpoint */
+
+   /**
+    * @brief Handler for the header read started by read_some().
+    *
+    * @param[in|out]   error: Error that can occur during a read
+    * @param[in|out]   bytes_transferred: number of bytes transferred
+    *
+    * @return      None.
+    */
+   void read_hdr_handler(
+         const boost::system::error_code& error,
+         size_t bytes_transferred
+   );
+
+   /**
+    * @brief Handler for the msg read started by read_hdr_handler().
+    *
+    * @param[in|out]   error: Error that can occur during a read
+    * @param[in|out]   bytes_transferred: number of bytes transferred
+    *
+    * @return      None.
+    */
+   void read_msg_handler(
+         const boost::system::error_code& error,
+         size_t bytes_transferred
+   );
+
+   /**
+    * @brief This method initiates async read of the next msg header from the
+    * TCP connection and launches the read_hdr_handler() when it's there.
+    *
+    * @param       None.
+    * @return      None.
+    */
+   void read_some( void );
+
+public:
+   /**
+    * @brief Write a msg to the TCP connection.
+    *
+    * The write blocks until the msg is handed to the OS so it doesn't need to
+    * be kept around by the caller or here.
+    *
+    * @param[in]   message: pointer to the buffer containing the msg to write.
+    * @param[in]   len: number of bytes in the buffer that need to be sent.
+    *
+    * @return      None.
+    */
+   void write_some( const char* message, uint16_t len );
+
+   /**
+    * @brief   Sets a new LogStub pointer.
+    * @param [in]  *log: LogStub pointer to a LogStub instance.
+    * @return: None.
+    */
+   void setLogging( LogStub *log );
+
+   /**
+    * @brief Constructor that connects to the TCP sys port of the DC3
+    *
+    * @param[in]   *ipAddress: pointer to the remote IP address string.
+    * @param[in]   *pRemPort: pointer to the remote port number string.
+    * @param [in] *pQueue: pointer to boost lockfree queue to insert recvd data
+    * into.
+    * @return      None.
+    */
+   Tcp(
+         const char *ipAddress,
+         const char *pRemPort,
+         boost::lockfree::queue<MsgData_t> *pQueue
+   );
+
+   /**
+    * @brief Destructor (default) that closes the TCP socket
+    *
+    * @param       None.
+    * @return      None.
+    */
+   ~Tcp( void );
+};
+
+#endif                                                               /* TCP_H */
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
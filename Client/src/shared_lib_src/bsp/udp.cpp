@@ -129,6 +129,14 @@ Udp::Udp(
       exit(1);
    }
 
+   /* Lets the client talk to every DC3 on a subnet at once (DC3DiscoverMsg) when
+    * it's given the broadcast address */
+   m_socket.set_option( boost::asio::socket_base::broadcast(true), myError );
+   if (myError) {
+      std::cout << "Broadcast - " << myError.message() << std::endl;
+      exit(1);
+   }
+
    m_socket.bind( m_loc_endpoint, myError );
    if (myError) {
       std::cout << "Bind - " << myError.message() << std::endl;
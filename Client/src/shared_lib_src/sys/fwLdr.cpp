@@ -15,6 +15,7 @@
 #include "LogHelper.h"
 #include "msg_utils.h"
 #include "ApiShared.h"
+#include "lzss.h"
 
 /* Namespaces ----------------------------------------------------------------*/
 using namespace std;
@@ -207,6 +208,66 @@ size_t FWLdr::getChunk( size_t size, uint8_t *buffer )
 	}
 }
 
+/******************************************************************************/
+void FWLdr::setFWChunkIndex( size_t index )
+{
+   m_chunk_index = ( index < m_size ) ? index : m_size;
+}
+
+/******************************************************************************/
+uint32_t FWLdr::getRangeCRC32( size_t offset, size_t size )
+{
+   if ( offset >= m_size ) {
+      return calcCRC32( m_buffer, 0 );
+   }
+   if ( size > m_size - offset ) {
+      size = m_size - offset;
+   }
+   return calcCRC32( &m_buffer[offset], size );
+}
+
+/******************************************************************************/
+size_t FWLdr::compressRange(
+      size_t offset,
+      size_t size,
+      size_t blockSize,
+      vector< vector<uint8_t> > &blocks
+)
+{
+   if ( offset >= m_size ) {
+      return 0;
+   }
+   if ( size > m_size - offset ) {
+      size = m_size - offset;
+   }
+
+   /* Too big to keep on the stack */
+   LzssEncoder_t *enc = new LzssEncoder_t;
+   LZSS_initEncoder( enc );
+
+   vector<uint8_t> block( blockSize );
+   size_t pos = 0;
+   size_t total = 0;
+   while ( pos < size ) {
+      size_t decodedLen = 0;
+      size_t blockLen = LZSS_encodeBlock(
+            enc,
+            &m_buffer[offset],
+            size,
+            pos,
+            &block[0],
+            blockSize,
+            &decodedLen
+      );
+      blocks.push_back( vector<uint8_t>( block.begin(), block.begin() + blockLen ) );
+      pos += decodedLen;
+      total += blockLen;
+   }
+
+   delete enc;
+   return total;
+}
+
 /******************************************************************************/
 size_t FWLdr::getChunkAndCRC( size_t size, uint8_t *buffer, uint32_t *crc )
 {
@@ -18,6 +18,7 @@
 #include <fstream>
 #include <assert.h>
 #include <stdint.h>
+#include <vector>
 
 #include "LogStub.h"
 /* Namespaces ----------------------------------------------------------------*/
@@ -164,6 +165,46 @@ public:
     */
    size_t getChunk(size_t size, uint8_t *buffer );
 
+   /**
+    * @brief Moves the internal offset that keeps track of where to get the
+    * next chunk of data.  Used to skip over the parts of the loaded FW image
+    * that don't need to be sent (e.g. when resuming an aborted FW upgrade or
+    * only sending the flash sectors that changed).
+    *
+    * @param[in]  index: size_t offset from the start of the FW image.
+    * @return  None.
+    */
+   void setFWChunkIndex( size_t index );
+
+   /**
+    * @brief Gets the CRC of a range of the loaded FW image.
+    *
+    * @param[in]  offset: size_t offset from the start of the FW image.
+    * @param[in]  size: size_t number of bytes.  Gets clipped to the end of the
+    * FW image.
+    * @return  CRC checksum of the range.
+    */
+   uint32_t getRangeCRC32( size_t offset, size_t size );
+
+   /**
+    * @brief Compresses a range of the loaded FW image into LZSS blocks (see
+    * lzss.h) that each fit into a single FW data packet.  The range is
+    * compressed on its own so none of its blocks depend on data outside of it.
+    *
+    * @param[in]  offset: size_t offset from the start of the FW image.
+    * @param[in]  size: size_t number of bytes.  Gets clipped to the end of the
+    * FW image.
+    * @param[in]  blockSize: size_t max size of each compressed block.
+    * @param[out] blocks: vector where the compressed blocks get appended.
+    * @return  total number of compressed bytes.
+    */
+   size_t compressRange(
+         size_t offset,
+         size_t size,
+         size_t blockSize,
+         vector< vector<uint8_t> > &blocks
+   );
+
    /**
     * @brief Gets the next chunk from the loaded FW image and its CRC.
     * Uses the user specified size to update the internal offset that keeps
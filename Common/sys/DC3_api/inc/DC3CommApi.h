@@ -38,6 +38,19 @@ extern "C" {
  * encoded) or UDP from the client. */
 #define DC3_MAX_MSG_LEN 300
 
+/**
+ * @brief   TCP port DC3 takes framed msgs on
+ * Every msg on this port starts with a header that holds the length of the msg
+ * that follows it.  The msgs themselves are the same ones that go over UDP (not
+ * base64 encoded) and can be pipelined since TCP holds off the sender when DC3
+ * can't keep up. */
+#define DC3_ETH_SYS_PORT 1500
+
+/**
+ * @brief   Length of the header in front of every msg on DC3_ETH_SYS_PORT
+ * The header is the length of the msg in bytes, most significant byte first. */
+#define DC3_ETH_FRAME_HDR_LEN 2
+
 /**
  * @brief   Length of a datetime string
  * The format of this string is always:
@@ -50,6 +63,71 @@ extern "C" {
  * This is the MAX length of memory in a block that can be gotten from QMPool. */
 #define DC3_MAX_MEM_BLK_SIZE 256U
 
+/**
+ * @brief   Max number of data bytes in a single DC3MemReadMsg frame
+ * This is the same as the max length of a bytes field in DC3 msgs. */
+#define DC3_MEM_READ_FRAME_LEN 112
+
+/**
+ * @brief   Max number of DC3MemReadMsg frames DC3 will have in flight
+ * Credits given by the client beyond this are ignored since every frame in
+ * flight holds on to a large event until it's sent out. */
+#define DC3_MEM_READ_MAX_CREDITS 32
+
+/**
+ * @brief   Size of a page of the I2C EEPROM
+ * Writes that cross a page boundary get split up by DC3 into one write per page
+ * (see I2C_calcPageWriteSizes()) so clients should line up writes with pages. */
+#define DC3_I2C_PAGE_SIZE 8
+
+/**
+ * @brief   Max number of bytes in a single DC3I2CReadMsg or DC3I2CWriteMsg
+ * This is the max length of a bytes field in DC3 msgs and is a whole number of
+ * I2C EEPROM pages. */
+#define DC3_I2C_MAX_XFER_LEN 112
+
+/**
+ * @brief   Max number of data bytes all the elements of a single
+ * DC3DBGetElemsMsg or DC3DBSetElemsMsg can take up together.
+ * This is less than the max length of a bytes field so that a msg with a full
+ * list of elements still fits into a base64 encoded serial msg. */
+#define DC3_DB_ELEMS_MAX_DATA_LEN 96
+
+/**
+ * @brief   Number of buckets in the dispatch and queue wait time histograms
+ * sent back by DC3ProfMsg. */
+#define DC3_PROF_HIST_BUCKETS 16
+
+/**
+ * @brief   Bit length of the times that go into the first histogram bucket.
+ * Bucket 0 counts times (in ticks) under 2^DC3_PROF_HIST_MIN_BITS and every
+ * bucket after that is twice as wide as the one before it, so bucket n counts
+ * times from 2^(n + DC3_PROF_HIST_MIN_BITS - 1) up to (but not including)
+ * 2^(n + DC3_PROF_HIST_MIN_BITS).  The last bucket also counts anything
+ * longer. */
+#define DC3_PROF_HIST_MIN_BITS 8
+
+/**
+ * @brief   Max number of signal records in a single DC3ProfMsg
+ * Keeps a msg full of records with large counters within what fits into a
+ * base64 encoded serial msg. */
+#define DC3_PROF_SIGS_PER_MSG 4
+
+/**
+ * @brief   Shortest and longest allowed interval of the health stream in ms */
+#define DC3_HEALTH_MIN_INTERVAL_MS 100
+#define DC3_HEALTH_MAX_INTERVAL_MS 3600000
+
+/**
+ * @brief   Max number of pool and queue records in a single DC3HealthMsg
+ * Keeps a msg with large counters within DC3_MAX_MSG_LEN.  Records past this
+ * are left out and can still be read with DC3MemStatsMsg. */
+#define DC3_HEALTH_MAX_MEM_RECS 24
+
+/**
+ * @brief   Value of a health stat that isn't available in this build */
+#define DC3_HEALTH_STAT_NA 0xFFFFFFFF
+
 /* Exported macros -----------------------------------------------------------*/
 
 /**
@@ -78,6 +156,54 @@ extern "C" {
    (DEV) == _DC3_EEPROM                                                       \
 )
 
+/**
+ * @brief   Macro to get the size of an I2C device
+ * @param [in] DEV:  DC3I2CDevice_t type I2C device specifier.
+ * @retval
+ *    size of the device in bytes or 0 if the device isn't defined.
+ */
+#define I2C_DEVICE_SIZE( DEV )                                                \
+(                                                                             \
+   (DEV) == _DC3_EEPROM ? 256U :                                              \
+   (DEV) == _DC3_SNROM  ? 16U  :                                              \
+   (DEV) == _DC3_EUIROM ? 8U   : 0U                                           \
+)
+
+/**
+ * @brief   Macro to determine if a memory space can be read by DC3MemReadMsg
+ * @param [in] MEM:  DC3MemSpace_t type memory space specifier.
+ * @retval
+ *    1: Memory space exists and is valid
+ *    0: Memory space doesn't exist or isn't defined
+ */
+#define IS_MEM_SPACE( MEM )                                                   \
+(                                                                             \
+   (MEM) == _DC3_MEM_FLASH ||                                                 \
+   (MEM) == _DC3_MEM_NOR ||                                                   \
+   (MEM) == _DC3_MEM_SDRAM                                                    \
+)
+
+/**
+ * @brief   Macro to pack a pool or queue record of a DC3HealthMsg
+ * @param [in] FREE:  blocks or entries free right now.
+ * @param [in] MIN_FREE:  fewest blocks or entries ever free.
+ * @retval
+ *    uint32_t with FREE in the upper and MIN_FREE in the lower 16 bits.
+ */
+#define DC3_HEALTH_MEM_REC( FREE, MIN_FREE )                                  \
+(                                                                             \
+   ((uint32_t)((FREE) & 0xFFFFU) << 16) | ((uint32_t)(MIN_FREE) & 0xFFFFU)    \
+)
+
+/**
+ * @brief   Macros to unpack a pool or queue record of a DC3HealthMsg
+ * @param [in] REC:  uint32_t record made with DC3_HEALTH_MEM_REC().
+ * @retval
+ *    blocks or entries free right now or the fewest ever free.
+ */
+#define DC3_HEALTH_MEM_FREE( REC )      ( ((uint32_t)(REC) >> 16) & 0xFFFFU )
+#define DC3_HEALTH_MEM_MIN_FREE( REC )  ( (uint32_t)(REC) & 0xFFFFU )
+
 /* Exported types ------------------------------------------------------------*/
 /**
  * \addtogroup autogenerated_enumerations
@@ -147,6 +273,21 @@ typedef enum DC3DbgLevel_t       DC3DbgLevel_t;
  */
 typedef enum DC3DBElem_t         DC3DBElem_t;
 
+/*! \enum DC3MemSpace_t
+ * These are the memories that can be read back with a DC3MemReadMsg.
+ */
+typedef enum DC3MemSpace_t       DC3MemSpace_t;
+
+/*! \enum DC3ProfRec_t
+ * These are the kinds of dispatch profiling records a DC3ProfMsg can get.
+ */
+typedef enum DC3ProfRec_t        DC3ProfRec_t;
+
+/*! \enum DC3MemStatsKind_t
+ * These are the kinds of pools and queues a DC3MemStatsMsg record describes.
+ */
+typedef enum DC3MemStatsKind_t   DC3MemStatsKind_t;
+
 /**@} end of autogenerated_enumerations group*/
 
 /*! \enum DC3DbgModule_t
@@ -195,6 +336,121 @@ typedef enum DBG_MODULES {
  */
 typedef enum DC3DbgDeviceSetting_t       DC3DbgDeviceSetting_t;
 
+/*! \enum DC3ProfAoStat_t
+ * Layout of the stats field of a DC3ProfPayloadMsg carrying a _DC3_PROF_AO
+ * record.  All times are in ticks of the tickHz field of the same msg.
+ *
+ * _DC3_PROF_AO_HIST and _DC3_PROF_AO_WAIT_HIST records have the priority of
+ * the AO first, followed by DC3_PROF_HIST_BUCKETS counters.
+ */
+typedef enum DC3ProfAoStats {
+   DC3_PROF_AO_PRIO = 0,               /**< QF priority of the AO */
+   DC3_PROF_AO_COUNT,                  /**< Number of events dispatched */
+   DC3_PROF_AO_MIN,                    /**< Shortest dispatch */
+   DC3_PROF_AO_MAX,                    /**< Longest dispatch */
+   DC3_PROF_AO_AVG,                    /**< Average dispatch */
+   DC3_PROF_AO_WAIT_COUNT,             /**< Number of timed queue waits */
+   DC3_PROF_AO_WAIT_MIN,               /**< Shortest wait, post to dispatch */
+   DC3_PROF_AO_WAIT_MAX,               /**< Longest wait, post to dispatch */
+   DC3_PROF_AO_WAIT_AVG,               /**< Average wait, post to dispatch */
+   DC3_PROF_AO_WAIT_UNTIMED,           /**< Events dispatched without a post
+                                            timestamp (queue deeper than the
+                                            timestamp ring) */
+   DC3_PROF_AO_STATS_LEN               /**< Number of stats. ALWAYS LAST */
+} DC3ProfAoStat_t;
+
+/*! \enum DC3ProfSigStat_t
+ * Layout of each record in the stats field of a DC3ProfPayloadMsg carrying
+ * _DC3_PROF_SIG records.  There are up to DC3_PROF_SIGS_PER_MSG of these back
+ * to back in a single msg.
+ */
+typedef enum DC3ProfSigStats {
+   DC3_PROF_SIG_PRIO = 0,              /**< QF priority of the AO */
+   DC3_PROF_SIG_SIG,                   /**< Signal of the dispatched events */
+   DC3_PROF_SIG_COUNT,                 /**< Number of events dispatched */
+   DC3_PROF_SIG_MIN,                   /**< Shortest dispatch */
+   DC3_PROF_SIG_MAX,                   /**< Longest dispatch */
+   DC3_PROF_SIG_AVG,                   /**< Average dispatch */
+   DC3_PROF_SIG_STATS_LEN              /**< Number of stats. ALWAYS LAST */
+} DC3ProfSigStat_t;
+
+/*! \enum DC3ProfCpuStat_t
+ * Layout of the stats field of a DC3ProfPayloadMsg carrying a _DC3_PROF_CPU
+ * record.  There is one record for every FreeRTOS priority a task ran at,
+ * idle (0) first, and the name field has the name of the task.  Loads are in
+ * 0.01% of the CPU or DC3_HEALTH_STAT_NA if the first second isn't over yet.
+ * ISR time is counted in whatever task the ISR interrupted.  The total load
+ * is 100% minus the load of idle.
+ */
+typedef enum DC3ProfCpuStats {
+   DC3_PROF_CPU_PRIO = 0,              /**< FreeRTOS priority of the task */
+   DC3_PROF_CPU_LOAD_1S,               /**< Load over the last second */
+   DC3_PROF_CPU_LOAD_10S,              /**< Load over the last 10 seconds */
+   DC3_PROF_CPU_LOAD_PEAK,             /**< Load in the second the CPLR task
+                                            was busiest since the last reset */
+   DC3_PROF_CPU_STATS_LEN              /**< Number of stats. ALWAYS LAST */
+} DC3ProfCpuStat_t;
+
+/*! \enum DC3MemStat_t
+ * Layout of the stats field of a DC3MemStatsPayloadMsg.  Pools count blocks,
+ * queues count entries, and stacks count bytes.  A queue of an Active Object
+ * has one more entry than its ring buffer since QF keeps the front event
+ * outside of it.  Stacks only know their high-water mark so their FREE is the
+ * same as their MIN_FREE.
+ */
+typedef enum DC3MemStats {
+   DC3_MEM_STAT_ID = 0,                /**< QF pool ID of an event pool, QF
+                                            priority of an AO, or FreeRTOS
+                                            priority of a task.  0 otherwise */
+   DC3_MEM_STAT_BLK_SIZE,              /**< Bytes per block.  0 for queues
+                                            and stacks */
+   DC3_MEM_STAT_TOTAL,                 /**< Number of blocks, entries, or
+                                            bytes */
+   DC3_MEM_STAT_FREE,                  /**< Free right now */
+   DC3_MEM_STAT_MIN_FREE,              /**< Fewest ever free (high-water) */
+   DC3_MEM_STAT_GETS,                  /**< Blocks handed out.  0 for queues
+                                            and stacks */
+   DC3_MEM_STAT_GET_FAILS,             /**< Allocations that didn't fit.  0
+                                            for queues and stacks */
+   DC3_MEM_STATS_LEN                   /**< Number of stats. ALWAYS LAST */
+} DC3MemStat_t;
+
+/*! \enum DC3HealthStat_t
+ * Layout of the start of the stats field of a DC3HealthPayloadMsg.  Counters
+ * count up from boot and wrap.  Right after DC3_HEALTH_HDR_LEN come
+ * DC3_HEALTH_N_POOLS + DC3_HEALTH_N_QUEUES records, one uint32 each, in the
+ * same order as the DC3MemStatsMsg records (pools first, then queues).  See
+ * DC3_HEALTH_MEM_REC() for how they are packed.  The names of the
+ * pools and queues aren't sent since they don't change and can be read once
+ * with DC3MemStatsMsg.
+ */
+typedef enum DC3HealthStats {
+   DC3_HEALTH_CPU_LOAD = 0,            /**< CPU load over the last second in
+                                            0.01% or DC3_HEALTH_STAT_NA */
+   DC3_HEALTH_I2C_ERRS,                /**< I2C bus errors, all buses */
+   DC3_HEALTH_I2C_RECOVERIES,          /**< I2C bus recoveries, all buses */
+   DC3_HEALTH_SER_RX_DROPS,            /**< Serial msgs dropped coming in */
+   DC3_HEALTH_SER_TX_DROPS,            /**< Serial msgs dropped going out */
+   DC3_HEALTH_ETH_RX,                  /**< Ethernet frames received */
+   DC3_HEALTH_ETH_TX,                  /**< Ethernet frames sent */
+   DC3_HEALTH_ETH_DROPS,               /**< Ethernet frames dropped or lost to
+                                            RX errors */
+   DC3_HEALTH_IP_DROPS,                /**< IP packets dropped by lwIP */
+   DC3_HEALTH_UDP_DROPS,               /**< UDP datagrams dropped by lwIP */
+   DC3_HEALTH_TCP_DROPS,               /**< TCP segments dropped by lwIP */
+   DC3_HEALTH_LWIP_MEM_ERRS,           /**< lwIP heap allocation failures */
+   DC3_HEALTH_ETH_SESSIONS,            /**< UDP clients in the session table */
+   DC3_HEALTH_ETH_SESSION_DROPS,       /**< UDP msgs dropped because the client
+                                            had too many waiting or there was
+                                            no room for it */
+   DC3_HEALTH_N_POOLS,                 /**< Number of pool records after the
+                                            header */
+   DC3_HEALTH_N_QUEUES,                /**< Number of queue records after the
+                                            pool records */
+   DC3_HEALTH_HDR_LEN                  /**< Number of stats before the records.
+                                            ALWAYS LAST */
+} DC3HealthStat_t;
+
 /**
  * @brief   A Union of all the payload structs.
  * This union allows for some fairly significant space savings in FW since only
@@ -211,6 +467,13 @@ typedef union DC3PayloadMsgs {
    struct DC3RamTestPayloadMsg   ramTestPayload;
    struct DC3DbgPayloadMsg       dbgPayload;
    struct DC3DBDataPayloadMsg    dbDataPayload;
+   struct DC3FlashSectorCrcPayloadMsg flashSectorCrcPayload;
+   struct DC3MemDataPayloadMsg   memDataPayload;
+   struct DC3DBElemsPayloadMsg   dbElemsPayload;
+   struct DC3ProfPayloadMsg      profPayload;
+   struct DC3MemStatsPayloadMsg  memStatsPayload;
+   struct DC3HealthPayloadMsg    healthPayload;
+   struct DC3DiscoverPayloadMsg  discoverPayload;
 } DC3PayloadMsgUnion_t;
 
 
@@ -82,11 +82,20 @@ typedef enum DC3Errors
    ERR_SDRAM_DATA_BUS_TEST_TIMEOUT                             = 0x00010015,
    ERR_SDRAM_ADDR_BUS_TEST_TIMEOUT                             = 0x00010016,
    ERR_SDRAM_DEVICE_INTEGRITY_TEST_TIMEOUT                     = 0x00010017,
+   ERR_FLASH_STAGED_IMAGE_INVALID                              = 0x00010018,
+   ERR_FLASH_SECTOR_MASK_INVALID                               = 0x00010019,
+   ERR_FLASH_COMPRESSION_INVALID                               = 0x0001001A,
+   ERR_FLASH_INVALID_FW_PACKET_DATA                            = 0x0001001B,
 
    /* NOR error category                         0x00030000 - 0x0003FFFF */
    ERR_NOR_ERROR                                               = 0x00030000,
    ERR_NOR_TIMEOUT                                             = 0x00030001,
    ERR_NOR_BUSY                                                = 0x00030002,
+   ERR_NOR_LOG_INVALID_PARAMS                                  = 0x00030003,
+   ERR_NOR_LOG_NOT_FOUND                                       = 0x00030004,
+   ERR_NOR_LOG_CRC_MISMATCH                                    = 0x00030005,
+   ERR_NOR_LOG_CORRUPT_RECORD                                  = 0x00030006,
+   ERR_NOR_LOG_FULL                                            = 0x00030007,
 
    /* CommMgr error category                     0x00040000 - 0x0004FFFF */
    ERR_COMM_UNKNOWN_MSG_SOURCE                                 = 0x00040000,
@@ -99,6 +108,10 @@ typedef enum DC3Errors
    ERR_COMM_INVALID_BOOTMODE_REQUESTED                         = 0x00040007,
    ERR_COMM_I2C_READ_CMD_TIMEOUT                               = 0x00040008,
    ERR_COMM_DB_ACCESS_CMD_TIMEOUT                              = 0x00040009,
+   ERR_COMM_MEM_SPACE_INVALID                                  = 0x0004000A,
+   ERR_COMM_MEM_RANGE_INVALID                                  = 0x0004000B,
+   ERR_COMM_MEM_READ_CREDIT_TIMEOUT                            = 0x0004000C,
+   ERR_COMM_MEM_READ_ABORTED                                   = 0x0004000D,
 
    /* Application CommMgr error category          0x00050000 - 0x0005FFFF */
    ERR_MENU_NODE_STORAGE_ALLOC_NULL                            = 0x00050000,
@@ -124,6 +137,10 @@ typedef enum DC3Errors
    ERR_I2CBUS_RXNE_FLAG_TIMEOUT                                = 0x0006000D,
    ERR_I2CBUS_STOP_BIT_TIMEOUT                                 = 0x0006000E,
    ERR_I2CBUS_WRITE_BYTE_TIMEOUT                               = 0x0006000F,
+   ERR_I2CBUS_NACK                                             = 0x00060010,
+   ERR_I2CBUS_ARB_LOST                                         = 0x00060011,
+   ERR_I2CBUS_BUS_ERROR                                        = 0x00060012,
+   ERR_I2CBUS_INVALID_PARAMS_FOR_XFER                          = 0x00060013,
 
    /* I2C1Dev error category                     0x00070000 - 0x0007FFFF */
    ERR_I2C1DEV_CHECK_BUS_TIMEOUT                               = 0x00070000,
@@ -166,6 +183,10 @@ typedef enum DC3Errors
    ERR_SPI_TXE_FLAG_TIMEOUT                                    = 0x00090000,
    ERR_SPI_RXE_FLAG_TIMEOUT                                    = 0x00090001,
    ERR_SPI_RX_TX_LENGTH_MISMATCH                               = 0x00090002,
+   ERR_SPI_INVALID_PARAMS_FOR_XFER                             = 0x00090003,
+   ERR_SPI_DMA_TIMEOUT                                         = 0x00090004,
+   ERR_SPI_DMA_TRANSFER_ERROR                                  = 0x00090005,
+   ERR_SPI_BUSY                                                = 0x00090006,
 
    /* Msg device error category                  0x000A0000 - 0x000AFFFF */
    ERR_MSG_ROUTE_INVALID                                       = 0x000A0000,
@@ -177,6 +198,23 @@ typedef enum DC3Errors
    /* Memory error category                      0x000B0000 - 0x000BFFFF */
    ERR_MEM_NULL_VALUE                                          = 0x000B0000,
    ERR_MEM_BUFFER_LEN                                          = 0x000B0001,
+   ERR_MEM_DMA_INVALID_PARAMS                                  = 0x000B0002,
+   ERR_MEM_DMA_INVALID_ADDR                                    = 0x000B0003,
+   ERR_MEM_DMA_QUEUE_FULL                                      = 0x000B0004,
+   ERR_MEM_DMA_TRANSFER_ERROR                                  = 0x000B0005,
+
+   /* Dispatch profiling error category          0x000C0000 - 0x000CFFFF */
+   ERR_PROF_NOT_ENABLED                                        = 0x000C0000,
+   ERR_PROF_INVALID_REC_TYPE                                   = 0x000C0001,
+   ERR_PROF_INVALID_INDEX                                      = 0x000C0002,
+
+   /* Pool and queue usage error category        0x000D0000 - 0x000DFFFF */
+   ERR_MEM_STATS_INVALID_INDEX                                 = 0x000D0000,
+
+   /* Health stream error category               0x000E0000 - 0x000EFFFF */
+   ERR_HEALTH_INVALID_INTERVAL                                 = 0x000E0000,
+   ERR_HEALTH_ROUTE_NOT_UDP                                    = 0x000E0001,
+   ERR_HEALTH_INVALID_PORT                                     = 0x000E0002,
 
    /* Reserved errors                            0xFFFFFFFE - 0xFFFFFFFF */
    ERR_UNIMPLEMENTED                                           = 0xFFFFFFFE,
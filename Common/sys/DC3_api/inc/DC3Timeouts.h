@@ -81,6 +81,12 @@
    #define HL_MAX_TIME_MS_I2C_POST_WRITE                                      5.0 // 5ms post write wait on the I2C EEPROM.
    /*@} I2C1Dev Timeouts and Times. */
 
+   /** \name SPI Bus Timeouts and Times.
+    * These are the timeouts used by the low level SPIBusMgr AO.
+    *@{*/
+   #define LL_MAX_TOUT_SEC_SPI_XFER                                           0.1  /**< Max DMA transaction is well under 1ms */
+   /*@} SPI Timeouts */
+
    /** \name ETH Timeouts and Times.
     * These are the timeouts used by the low level LWIPMgr AO.
     *@{*/
@@ -106,6 +112,7 @@
    #define LL_MAX_TOUT_SEC_COMM_MSG_VALIDATE_MSG_OP                           1.0
    #define LL_MAX_TOUT_SEC_COMM_MSG_FLASH_OP                                  3.0
    #define HL_MAX_TOUT_SEC_COMM_DB_VALIDATE                                   3.0
+   #define LL_MAX_TOUT_SEC_COMM_MEM_READ_CREDIT                               3.0
 
    /*@} CommMgr Timeouts and Times.*/
 
@@ -117,6 +124,7 @@
    #define LL_MAX_TOUT_SEC_DB_ACCESS                                          3.0
    #define LL_MAX_TIME_SEC_BETWEEN_RETRIES                                    0.5
    #define HL_MAX_TOUT_SEC_DB_FULL_RESET                                      1.0
+   #define LL_MAX_TIME_MS_DB_WRITE_COMBINE                                   50.0 // Collect DB writes this long before writing EEPROM.
 
    /*@} SysMgr Timeouts and Times.*/
 
@@ -0,0 +1,264 @@
+/**
+ * @file    lzss.c
+ * @brief   Small LZSS codec used to compress FW images sent to the DC3 board.
+ *
+ * See lzss.h for the description of the block format.
+ *
+ * @date    10/18/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "lzss.h"
+
+/* Compile-time called macros ------------------------------------------------*/
+/* Private typedefs ----------------------------------------------------------*/
+/* Private defines -----------------------------------------------------------*/
+#define LZSS_TOKENS_PER_GROUP                                                  8
+
+/* Private macros ------------------------------------------------------------*/
+/* Private variables and Local objects ---------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+
+/**
+ * @brief   Hash the next LZSS_MIN_MATCH bytes.
+ * @param [in] *p: const uint8_t pointer to the data to hash.
+ * @return  uint16_t: hash value less than LZSS_HASH_SIZE.
+ */
+static uint16_t LZSS_hash( const uint8_t *p );
+
+/**
+ * @brief   Add all the positions up to (not including) upTo to the hash chains.
+ * @param [in|out] *pEnc: LzssEncoder_t pointer to the encoder state.
+ * @param [in] *pData: const uint8_t pointer to the start of the range.
+ * @param [in] dataLen: size_t length of the range.
+ * @param [in] upTo: size_t position to stop at.
+ * @return  None
+ */
+static void LZSS_insert(
+      LzssEncoder_t *pEnc,
+      const uint8_t *pData,
+      const size_t dataLen,
+      const size_t upTo
+);
+
+/**
+ * @brief   Find the longest match for the data at pos within the window.
+ * @param [in] *pEnc: const LzssEncoder_t pointer to the encoder state.
+ * @param [in] *pData: const uint8_t pointer to the start of the range.
+ * @param [in] pos: size_t position to find a match for.
+ * @param [in] maxLen: size_t longest match to look for.
+ * @param [out] *pDist: size_t pointer to how far back the match starts.
+ * @return  size_t: length of the match.  0 if none was found.
+ */
+static size_t LZSS_findMatch(
+      const LzssEncoder_t *pEnc,
+      const uint8_t *pData,
+      const size_t pos,
+      const size_t maxLen,
+      size_t *pDist
+);
+
+/* Private functions ---------------------------------------------------------*/
+/******************************************************************************/
+static uint16_t LZSS_hash( const uint8_t *p )
+{
+   return( (uint16_t)(((p[0] << 8) ^ (p[1] << 4) ^ p[2]) & (LZSS_HASH_SIZE - 1)) );
+}
+
+/******************************************************************************/
+static void LZSS_insert(
+      LzssEncoder_t *pEnc,
+      const uint8_t *pData,
+      const size_t dataLen,
+      const size_t upTo
+)
+{
+   while ( pEnc->hashedPos < upTo ) {
+      size_t p = pEnc->hashedPos++;
+      if ( p + LZSS_MIN_MATCH <= dataLen ) {
+         uint16_t h = LZSS_hash( &pData[p] );
+         pEnc->prev[p & (LZSS_WINDOW_SIZE - 1)] = pEnc->head[h];
+         pEnc->head[h] = (int32_t)p;
+      }
+   }
+}
+
+/******************************************************************************/
+static size_t LZSS_findMatch(
+      const LzssEncoder_t *pEnc,
+      const uint8_t *pData,
+      const size_t pos,
+      const size_t maxLen,
+      size_t *pDist
+)
+{
+   size_t bestLen = 0;
+   if ( maxLen < LZSS_MIN_MATCH ) {
+      return( 0 );
+   }
+
+   int32_t cand = pEnc->head[LZSS_hash( &pData[pos] )];
+   uint16_t chain = 0;
+   while ( cand >= 0 && pos - (size_t)cand <= LZSS_WINDOW_SIZE &&
+         chain++ < LZSS_MAX_CHAIN ) {
+      size_t len = 0;
+      while ( len < maxLen && pData[cand + len] == pData[pos + len] ) {
+         len++;
+      }
+      if ( len > bestLen ) {
+         bestLen = len;
+         *pDist = pos - (size_t)cand;
+         if ( len == maxLen ) {
+            break;
+         }
+      }
+
+      /* Chains always go back in time.  If they don't, the slot got reused by
+       * a newer position and the rest of the chain is gone. */
+      int32_t next = pEnc->prev[cand & (LZSS_WINDOW_SIZE - 1)];
+      if ( next >= cand ) {
+         break;
+      }
+      cand = next;
+   }
+
+   return( bestLen );
+}
+
+/* Public functions ----------------------------------------------------------*/
+/******************************************************************************/
+LzssStatus_t LZSS_decodeBlock(
+      const uint8_t *pIn,
+      const size_t inLen,
+      const uint8_t *pHistory,
+      const size_t historyLen,
+      uint8_t *pOut,
+      const size_t outSize,
+      size_t *pOutLen
+)
+{
+   size_t i = 0;
+   size_t o = 0;
+   *pOutLen = 0;
+
+   while ( i < inLen ) {
+      uint8_t flags = pIn[i++];
+      for ( uint8_t bit = 0; bit < LZSS_TOKENS_PER_GROUP && i < inLen; bit++ ) {
+         if ( flags & (1 << bit) ) {                               /* Literal */
+            if ( o >= outSize ) {
+               return( LZSS_ERR_OUT_FULL );
+            }
+            pOut[o++] = pIn[i++];
+         } else {                                                    /* Match */
+            if ( i + 1 >= inLen ) {
+               return( LZSS_ERR_TRUNCATED );
+            }
+            size_t dist = (((size_t)pIn[i] << 4) | (pIn[i + 1] >> 4)) + 1;
+            size_t len  = (pIn[i + 1] & 0x0F) + LZSS_MIN_MATCH;
+            i += 2;
+
+            if ( dist > o + historyLen ) {
+               return( LZSS_ERR_DISTANCE );
+            }
+            if ( o + len > outSize ) {
+               return( LZSS_ERR_OUT_FULL );
+            }
+
+            /* Copy a byte at a time since matches can overlap themselves */
+            for ( size_t k = 0; k < len; k++, o++ ) {
+               if ( dist > o ) {
+                  pOut[o] = pHistory[historyLen - (dist - o)];
+               } else {
+                  pOut[o] = pOut[o - dist];
+               }
+            }
+         }
+      }
+   }
+
+   *pOutLen = o;
+   return( LZSS_OK );
+}
+
+/******************************************************************************/
+void LZSS_initEncoder( LzssEncoder_t *pEnc )
+{
+   for ( size_t i = 0; i < LZSS_HASH_SIZE; i++ ) {
+      pEnc->head[i] = -1;
+   }
+   for ( size_t i = 0; i < LZSS_WINDOW_SIZE; i++ ) {
+      pEnc->prev[i] = -1;
+   }
+   pEnc->hashedPos = 0;
+}
+
+/******************************************************************************/
+size_t LZSS_encodeBlock(
+      LzssEncoder_t *pEnc,
+      const uint8_t *pData,
+      const size_t dataLen,
+      const size_t pos,
+      uint8_t *pOut,
+      const size_t outSize,
+      size_t *pDecodedLen
+)
+{
+   size_t outLen = 0;
+   size_t flagIdx = 0;
+   uint8_t nTokens = LZSS_TOKENS_PER_GROUP;  /* Start a group on first token */
+   size_t cur = pos;
+   *pDecodedLen = 0;
+
+   while ( cur < dataLen ) {
+      size_t maxLen = dataLen - cur;
+      if ( maxLen > LZSS_MAX_MATCH ) {
+         maxLen = LZSS_MAX_MATCH;
+      }
+      if ( maxLen > LZSS_MAX_BLOCK_DECODED_LEN - *pDecodedLen ) {
+         maxLen = LZSS_MAX_BLOCK_DECODED_LEN - *pDecodedLen;
+      }
+      if ( 0 == maxLen ) {
+         break;                   /* Block decodes to as much as it's allowed */
+      }
+
+      size_t room = outSize - outLen;
+      size_t flagLen = ( LZSS_TOKENS_PER_GROUP == nTokens ) ? 1 : 0;
+
+      LZSS_insert( pEnc, pData, dataLen, cur );
+      size_t dist = 0;
+      size_t len = LZSS_findMatch( pEnc, pData, cur, maxLen, &dist );
+
+      if ( len >= LZSS_MIN_MATCH && room >= flagLen + 2 ) {
+         if ( flagLen ) {
+            flagIdx = outLen;
+            pOut[outLen++] = 0;
+            nTokens = 0;
+         }
+         pOut[outLen++] = (uint8_t)((dist - 1) >> 4);
+         pOut[outLen++] = (uint8_t)((((dist - 1) & 0x0F) << 4) |
+               (len - LZSS_MIN_MATCH));
+      } else if ( room >= flagLen + 1 ) {
+         if ( flagLen ) {
+            flagIdx = outLen;
+            pOut[outLen++] = 0;
+            nTokens = 0;
+         }
+         pOut[flagIdx] |= (uint8_t)(1 << nTokens);
+         pOut[outLen++] = pData[cur];
+         len = 1;
+      } else {
+         break;                                       /* No more room left */
+      }
+
+      nTokens++;
+      cur += len;
+      *pDecodedLen += len;
+   }
+
+   return( outLen );
+}
+
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
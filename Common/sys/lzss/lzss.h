@@ -0,0 +1,143 @@
+/**
+ * @file    lzss.h
+ * @brief   Small LZSS codec used to compress FW images sent to the DC3 board.
+ *
+ * The client compresses a FW image into blocks that each fit into a single FW
+ * data packet.  The DC3 FlashMgr decodes every block as soon as its packet
+ * arrives and writes the result to flash.  Back references that reach past the
+ * start of a block are resolved from the output that came before it.  On DC3
+ * that output is already sitting in (memory mapped) flash right in front of
+ * where the block is going so the decoder doesn't need a RAM window or heap.
+ *
+ * Block format:
+ * Each block is a sequence of groups.  Every group starts with a flag byte
+ * followed by up to 8 tokens.  Bit N (LSB first) of the flag byte describes
+ * token N:
+ *    1 - literal: 1 byte that gets copied to the output as is.
+ *    0 - match:   2 bytes [dddddddd][ddddllll] that copy (l + LZSS_MIN_MATCH)
+ *                 bytes starting (d + 1) bytes back from the current output.
+ * A group (and a token) never spans two blocks and a block never decodes to
+ * more than LZSS_MAX_BLOCK_DECODED_LEN bytes.
+ *
+ * This file has no dependencies on the STM32 hardware so it's shared between
+ * the DC3 FW and the client.
+ *
+ * @date    10/18/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef LZSS_H_
+#define LZSS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+/* Exported defines ----------------------------------------------------------*/
+#define LZSS_WINDOW_SIZE                                                    4096
+#define LZSS_MIN_MATCH                                                         3
+#define LZSS_MAX_MATCH                                    (LZSS_MIN_MATCH + 15)
+#define LZSS_MAX_BLOCK_DECODED_LEN                                          1024
+
+#define LZSS_HASH_SIZE                                                      4096
+#define LZSS_MAX_CHAIN                                                       128
+
+/* Exported macros -----------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief   Results of decoding a block.
+ */
+typedef enum {
+   LZSS_OK = 0,                                     /**< Block decoded fine */
+   LZSS_ERR_OUT_FULL,         /**< Block decodes to more than the out buffer */
+   LZSS_ERR_TRUNCATED,                      /**< Block ends in a partial match */
+   LZSS_ERR_DISTANCE,       /**< Match reaches further back than the history */
+} LzssStatus_t;
+
+/**
+ * @brief   Encoder state.  This is only needed by whoever compresses the image
+ * (the client) and is too big to keep on a small stack.
+ */
+typedef struct {
+   int32_t head[LZSS_HASH_SIZE];   /**< Last position seen for each hash value */
+   int32_t prev[LZSS_WINDOW_SIZE];  /**< Previous position with the same hash */
+   size_t  hashedPos;   /**< Positions before this one are already in the hash */
+} LzssEncoder_t;
+
+/* Exported constants --------------------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief   Decode a single block.
+ *
+ * @param [in] *pIn: const uint8_t pointer to the encoded block.
+ * @param [in] inLen: size_t length of the encoded block.
+ * @param [in] *pHistory: const uint8_t pointer to the output that precedes
+ * this block.  Its last byte is the byte right before the first byte of pOut.
+ * @param [in] historyLen: size_t how many bytes of history are available.
+ * @param [out] *pOut: uint8_t pointer to the buffer where to put the decoded
+ * data.
+ * @param [in] outSize: size_t size of the pOut buffer.
+ * @param [out] *pOutLen: size_t pointer to how many bytes were decoded.
+ * @return  LzssStatus_t: LZSS_OK if the block decoded fine, error otherwise.
+ */
+LzssStatus_t LZSS_decodeBlock(
+      const uint8_t *pIn,
+      const size_t inLen,
+      const uint8_t *pHistory,
+      const size_t historyLen,
+      uint8_t *pOut,
+      const size_t outSize,
+      size_t *pOutLen
+);
+
+/**
+ * @brief   Reset the encoder before compressing a new range of data.
+ *
+ * Every range is compressed on its own so matches never reach back past the
+ * start of the range.
+ *
+ * @param [out] *pEnc: LzssEncoder_t pointer to the encoder state.
+ * @return  None
+ */
+void LZSS_initEncoder( LzssEncoder_t *pEnc );
+
+/**
+ * @brief   Encode the next block of a range.
+ *
+ * @param [in|out] *pEnc: LzssEncoder_t pointer to the encoder state.
+ * @param [in] *pData: const uint8_t pointer to the start of the range.
+ * @param [in] dataLen: size_t length of the range.
+ * @param [in] pos: size_t offset into the range where this block starts.  This
+ * has to be where the previous block left off.
+ * @param [out] *pOut: uint8_t pointer to the buffer where to put the block.
+ * @param [in] outSize: size_t max size of the encoded block.  Has to be at
+ * least 3 bytes.
+ * @param [out] *pDecodedLen: size_t pointer to how many bytes of the range
+ * the block covers.
+ * @return  size_t: length of the encoded block.
+ */
+size_t LZSS_encodeBlock(
+      LzssEncoder_t *pEnc,
+      const uint8_t *pData,
+      const size_t dataLen,
+      const size_t pos,
+      uint8_t *pOut,
+      const size_t outSize,
+      size_t *pDecodedLen
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif                                                              /* LZSS_H_ */
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
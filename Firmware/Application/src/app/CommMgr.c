@@ -44,11 +44,19 @@
 #include "version.h"                               /* For version information */
 #include "i2c_dev.h"                          /* For I2C device functionality */
 #include "serial.h"                               /* For serial functionality */
+#include "flash.h"                          /* For Flash device functionality */
+#include "nor.h"                                    /* For NOR memory reads */
+#include "sdram.h"                                /* For SDRAM memory reads */
 
 #include "I2C1DevMgr.h"                                  /* For I2C Evt types */
 #include "LWIPMgr.h"                           /* For ethernet events and AOs */
 #include "SerialMgr.h"                           /* For serial events and AOs */
 #include "SysMgr.h"                 /* For Database and SysMgr events and AOs */
+#include "FlashMgr.h"                          /* For FlashMgr events and AOs */
+#include "ao_prof.h"                              /* For AO dispatch profiling */
+#include "mem_stats.h"                    /* For pool and queue usage records */
+#include "health.h"                                  /* For the health stream */
+#include "cpu_load.h"                                   /* For CPU load stats */
 
 /* Compile-time called macros ------------------------------------------------*/
 Q_DEFINE_THIS_FILE;                 /* For QSPY to know the name of this file */
@@ -94,6 +102,10 @@ typedef struct {
      * this is even needed.*/
     DC3MsgRoute_t cliEvtDst;
 
+    /**< Keep track of the UDP session the CLI_RECEIVED_SIG event came from so the
+     * replies go back to the same client on the same comm channel */
+    uint8_t cliEvtSession;
+
     /**< Keep track of errors that may occur in the AO */
     DC3Error_t errorCode;
 
@@ -112,6 +124,44 @@ typedef struct {
 
     /**< Timer for timing out the individual operations in CommMgr AO. */
     QTimeEvt commOpTimerEvt;
+
+    /**< Native QF queue for deferring msgs that arrive while another msg is being
+     * processed.  This lets the client keep several requests in flight. */
+    QEQueue deferredEvtQueue;
+
+    /**< Storage for deferred event queue. */
+    QEvt const * deferredEvtQSto[8];
+
+    /**< Memory space being streamed back to the client by a DC3MemReadMsg */
+    DC3MemSpace_t memReadSpace;
+
+    /**< Offset where the memory read started.  Reported back in the Done msg */
+    uint32_t memReadOffsetStart;
+
+    /**< Offset of the next frame to send to the client */
+    uint32_t memReadOffsetCurr;
+
+    /**< Offset right after the last byte to send to the client */
+    uint32_t memReadOffsetEnd;
+
+    /**< Sequence number of the last frame sent to the client */
+    uint32_t memReadSeqCurr;
+
+    /**< How many more frames the client is ready to receive */
+    uint16_t memReadCredits;
+
+    /**< Timer for pushing the health stream to the client */
+    QTimeEvt healthTimerEvt;
+
+    /**< Basic msg the health stream is pushed with.  Kept apart from basicMsg so a
+     * push doesn't clobber a msg that's being processed. */
+    struct DC3BasicMsg healthBasicMsg;
+
+    /**< Payload the health stream is pushed with.  Also holds the interval and port */
+    struct DC3HealthPayloadMsg healthPayload;
+
+    /**< Sequence number of the last pushed health msg */
+    uint32_t healthSeq;
 } CommMgr;
 
 /* protected: */
@@ -186,6 +236,29 @@ static QState CommMgr_WaitForRespFromI2C(CommMgr * const me, QEvt const * const
  */
 static QState CommMgr_WaitForRespFromSysMgr(CommMgr * const me, QEvt const * const e);
 
+/**
+ * @brief    State that waits for a response from FlashMgr AO.
+ *
+ * @param  [in|out] me: Pointer to the state machine
+ * @param  [in|out]  e:  Pointer to the event being processed.
+ * @return status: QState type that specifies where the state
+ * machine is going next.
+ */
+static QState CommMgr_WaitForRespFromFlashMgr(CommMgr * const me, QEvt const * const e);
+
+/**
+ * @brief    State that streams a range of memory back to the client.
+ * Every frame is sent as a Prog msg but only while the client has credits left
+ * for it.  The client hands out more credits (or aborts the read) by sending
+ * more DC3MemReadMsg Req msgs with the same msgID while this state is running.
+ *
+ * @param  [in|out] me: Pointer to the state machine
+ * @param  [in|out]  e:  Pointer to the event being processed.
+ * @return status: QState type that specifies where the state
+ * machine is going next.
+ */
+static QState CommMgr_StreamMem(CommMgr * const me, QEvt const * const e);
+
 
 /* Private defines -----------------------------------------------------------*/
 /* Private macros ------------------------------------------------------------*/
@@ -211,8 +284,18 @@ QActive * const AO_CommMgr = (QActive *)&l_CommMgr;  /* "opaque" AO pointer */
 void CommMgr_ctor(void) {
     CommMgr *me = &l_CommMgr;
     QActive_ctor(&me->super, (QStateHandler)&CommMgr_initial);
+
+    /* Initialize the deferred event queue and storage for it */
+    QEQueue_init(
+        &me->deferredEvtQueue,
+        (QEvt const **)( me->deferredEvtQSto ),
+        Q_DIM(me->deferredEvtQSto)
+    );
+    MEM_STATS_regQueue( &me->deferredEvtQueue, "CommMgrDefer" );
+
     QTimeEvt_ctor(&me->commMgrTimerEvt, COMM_MGR_TIMEOUT_SIG);
     QTimeEvt_ctor(&me->commOpTimerEvt, COMM_OP_TIMEOUT_SIG);
+    QTimeEvt_ctor(&me->healthTimerEvt, COMM_HEALTH_TIMEOUT_SIG);
 }
 
 /**
@@ -266,6 +349,293 @@ DC3Error_t Comm_sendToClient(LrgDataEvt* evt) {
     return status;
 }
 
+/**
+ * @brief   Check that a range can be streamed back with a DC3MemReadMsg.
+ * The offset has to be word aligned since SDRAM and NOR are read a word (or
+ * half-word) at a time.
+ * @param [in] memSpace: DC3MemSpace_t memory to read from.
+ * @param [in] offset: uint32_t offset into the memory where to start reading.
+ * @param [in] length: uint32_t number of bytes to read.
+ * @return: DC3Error_t indicating status of operation.
+ */
+/*${AOs::Comm_checkMemRan~} ................................................*/
+DC3Error_t Comm_checkMemRange(DC3MemSpace_t memSpace, uint32_t offset, uint32_t length) {
+    DC3Error_t status = ERR_NONE;
+    uint32_t memSize = 0;
+
+    switch( memSpace ) {
+        case _DC3_MEM_FLASH:
+            memSize = FLASH_LAST_ADDR - FLASH_BOOT_START_ADDR + 1;
+            break;
+        case _DC3_MEM_NOR:
+            memSize = NOR_MEM_SIZE;
+            break;
+        case _DC3_MEM_SDRAM:
+            memSize = SDRAM_MEM_SIZE;
+            break;
+        default:
+            status = ERR_COMM_MEM_SPACE_INVALID;
+            break;
+    }
+
+    /* Written so offset + length can't overflow */
+    if ( ERR_NONE == status &&
+         ( 0 != (offset & 0x03) || 0 == length || offset >= memSize || length > memSize - offset ) ) {
+        status = ERR_COMM_MEM_RANGE_INVALID;
+    }
+
+    return status;
+}
+
+/**
+ * @brief   Read a single frame from one of the memories readable by DC3MemReadMsg.
+ * The range should already have been checked by Comm_checkMemRange().
+ * @param [in] memSpace: DC3MemSpace_t memory to read from.
+ * @param [in] offset: uint32_t word aligned offset into the memory.
+ * @param [in] len: uint16_t number of bytes to read.
+ * @param [out] *pBuf: uint32_t pointer to a buffer that can hold len bytes
+ * rounded up to a whole word.
+ * @return: DC3Error_t indicating status of operation.
+ */
+/*${AOs::Comm_readMem} .....................................................*/
+DC3Error_t Comm_readMem(DC3MemSpace_t memSpace, uint32_t offset, uint16_t len, uint32_t* pBuf) {
+    DC3Error_t status = ERR_NONE;
+
+    switch( memSpace ) {
+        case _DC3_MEM_FLASH:                          /* Flash is memory mapped */
+            MEMCPY( pBuf, (uint8_t *)(FLASH_BOOT_START_ADDR + offset), len );
+            break;
+        case _DC3_MEM_NOR:
+            NOR_ReadBuffer( (uint16_t *)pBuf, offset, (len + 1) / 2 );
+            break;
+        case _DC3_MEM_SDRAM:
+            SDRAM_ReadBuffer( pBuf, offset, (len + 3) / 4 );
+            break;
+        default:
+            status = ERR_COMM_MEM_SPACE_INVALID;
+            break;
+    }
+
+    return status;
+}
+
+/**
+ * @brief   Fill in the Done payload of a DC3ProfMsg from the AO profiling.
+ * Uses the recType, index, and reset fields of the request that's already in
+ * the payload and overwrites the rest.
+ * @param [in|out] pMsg: DC3ProfPayloadMsg pointer to the payload.
+ * @return: DC3Error_t indicating status of operation.  Also put into the
+ * errorCode field of the payload.
+ */
+/*${AOs::Comm_getProf} .....................................................*/
+DC3Error_t Comm_getProf(struct DC3ProfPayloadMsg* pMsg) {
+    DC3Error_t status = ERR_NONE;
+    AOProfAo_t ao;
+    AOProfSig_t sig;
+    CpuLoadRec_t cpu;
+
+    pMsg->_nRecs              = 0;
+    pMsg->_tickHz             = AO_PROF_getTickHz();
+    pMsg->_name_len           = 0;
+    pMsg->_stats_repeated_len = 0;
+
+    switch( pMsg->_recType ) {
+        case _DC3_PROF_AO:                             /* Intentionally fall through */
+        case _DC3_PROF_AO_HIST:                        /* Intentionally fall through */
+        case _DC3_PROF_AO_WAIT_HIST:
+            pMsg->_nRecs = AO_PROF_getAoCount();
+            status = ( pMsg->_index > UINT16_MAX ) ? ERR_PROF_INVALID_INDEX :
+                AO_PROF_getAo( (uint16_t)pMsg->_index, &ao );
+            if ( ERR_NONE != status ) {
+                break;
+            }
+
+            pMsg->_name_len = ( NULL == ao.name ) ? 0 : MIN(strlen(ao.name), sizeof(pMsg->_name));
+            MEMCPY( pMsg->_name, ao.name, pMsg->_name_len );
+
+            if ( _DC3_PROF_AO == pMsg->_recType ) {
+                pMsg->_stats[DC3_PROF_AO_PRIO]         = ao.prio;
+                pMsg->_stats[DC3_PROF_AO_COUNT]        = ao.dispatch.count;
+                pMsg->_stats[DC3_PROF_AO_MIN]          = ao.dispatch.min;
+                pMsg->_stats[DC3_PROF_AO_MAX]          = ao.dispatch.max;
+                pMsg->_stats[DC3_PROF_AO_AVG]          = ( 0 == ao.dispatch.count ) ? 0 :
+                    (uint32_t)(ao.dispatch.total / ao.dispatch.count);
+                pMsg->_stats[DC3_PROF_AO_WAIT_COUNT]   = ao.wait.count;
+                pMsg->_stats[DC3_PROF_AO_WAIT_MIN]     = ao.wait.min;
+                pMsg->_stats[DC3_PROF_AO_WAIT_MAX]     = ao.wait.max;
+                pMsg->_stats[DC3_PROF_AO_WAIT_AVG]     = ( 0 == ao.wait.count ) ? 0 :
+                    (uint32_t)(ao.wait.total / ao.wait.count);
+                pMsg->_stats[DC3_PROF_AO_WAIT_UNTIMED] = ao.waitUntimed;
+                pMsg->_stats_repeated_len              = DC3_PROF_AO_STATS_LEN;
+            } else {
+                const uint32_t *pHist = ( _DC3_PROF_AO_HIST == pMsg->_recType ) ?
+                    ao.dispatch.hist : ao.wait.hist;
+                pMsg->_stats[0] = ao.prio;
+                for ( uint8_t i = 0; i < DC3_PROF_HIST_BUCKETS; i++ ) {
+                    pMsg->_stats[1 + i] = pHist[i];
+                }
+                pMsg->_stats_repeated_len = 1 + DC3_PROF_HIST_BUCKETS;
+            }
+            break;
+
+        case _DC3_PROF_SIG:
+            pMsg->_nRecs = AO_PROF_getSigCount();
+            for ( uint8_t n = 0; n < DC3_PROF_SIGS_PER_MSG; n++ ) {
+                status = ( pMsg->_index + n > UINT16_MAX ) ? ERR_PROF_INVALID_INDEX :
+                    AO_PROF_getSig( (uint16_t)(pMsg->_index + n), &sig );
+                if ( ERR_NONE != status ) {
+                    break;
+                }
+
+                const int base = pMsg->_stats_repeated_len;
+                pMsg->_stats[base + DC3_PROF_SIG_PRIO]  = sig.prio;
+                pMsg->_stats[base + DC3_PROF_SIG_SIG]   = sig.sig;
+                pMsg->_stats[base + DC3_PROF_SIG_COUNT] = sig.count;
+                pMsg->_stats[base + DC3_PROF_SIG_MIN]   = sig.min;
+                pMsg->_stats[base + DC3_PROF_SIG_MAX]   = sig.max;
+                pMsg->_stats[base + DC3_PROF_SIG_AVG]   = (uint32_t)(sig.total / sig.count);
+                pMsg->_stats_repeated_len += DC3_PROF_SIG_STATS_LEN;
+            }
+
+            /* Only the first record has to be there.  The rest just ran off the end. */
+            if ( 0 != pMsg->_stats_repeated_len ) {
+                status = ERR_NONE;
+            }
+            break;
+
+        case _DC3_PROF_CPU:
+            pMsg->_nRecs = CPU_LOAD_getCount();
+            status = ( pMsg->_index > UINT16_MAX ) ? ERR_PROF_INVALID_INDEX :
+                CPU_LOAD_get( (uint16_t)pMsg->_index, &cpu );
+            if ( ERR_NONE != status ) {
+                break;
+            }
+
+            pMsg->_name_len = ( NULL == cpu.name ) ? 0 : MIN(strlen(cpu.name), sizeof(pMsg->_name));
+            MEMCPY( pMsg->_name, cpu.name, pMsg->_name_len );
+
+            pMsg->_stats[DC3_PROF_CPU_PRIO]      = cpu.prio;
+            pMsg->_stats[DC3_PROF_CPU_LOAD_1S]   = ( CPU_LOAD_NA == cpu.load1s ) ?
+                DC3_HEALTH_STAT_NA : cpu.load1s;
+            pMsg->_stats[DC3_PROF_CPU_LOAD_10S]  = ( CPU_LOAD_NA == cpu.load10s ) ?
+                DC3_HEALTH_STAT_NA : cpu.load10s;
+            pMsg->_stats[DC3_PROF_CPU_LOAD_PEAK] = ( CPU_LOAD_NA == cpu.loadPeak ) ?
+                DC3_HEALTH_STAT_NA : cpu.loadPeak;
+            pMsg->_stats_repeated_len            = DC3_PROF_CPU_STATS_LEN;
+            break;
+
+        default:
+            status = ERR_PROF_INVALID_REC_TYPE;
+            break;
+    }
+
+    /* The client sets this on the last request so it doesn't lose anything in between */
+    if ( 0 != pMsg->_reset ) {
+        AO_PROF_reset();
+        CPU_LOAD_reset();
+    }
+
+    pMsg->_errorCode = status;
+    return status;
+}
+
+/**
+ * @brief   Fill in the Done payload of a DC3MemStatsMsg.
+ * Uses the index field of the request that's already in the payload and
+ * overwrites the rest.
+ * @param [in|out] pMsg: DC3MemStatsPayloadMsg pointer to the payload.
+ * @return: DC3Error_t indicating status of operation.  Also put into the
+ * errorCode field of the payload.
+ */
+/*${AOs::Comm_getMemStats} .................................................*/
+DC3Error_t Comm_getMemStats(struct DC3MemStatsPayloadMsg* pMsg) {
+    DC3Error_t status = ERR_NONE;
+    MemStatsRec_t rec;
+
+    pMsg->_nRecs              = MEM_STATS_getCount();
+    pMsg->_kind               = _DC3_MEM_STATS_MAX;
+    pMsg->_name_len           = 0;
+    pMsg->_stats_repeated_len = 0;
+
+    status = ( pMsg->_index > UINT16_MAX ) ? ERR_MEM_STATS_INVALID_INDEX :
+        MEM_STATS_get( (uint16_t)pMsg->_index, &rec );
+    if ( ERR_NONE == status ) {
+        pMsg->_kind     = rec.kind;
+        pMsg->_name_len = ( NULL == rec.name ) ? 0 : MIN(strlen(rec.name), sizeof(pMsg->_name));
+        MEMCPY( pMsg->_name, rec.name, pMsg->_name_len );
+        for ( uint8_t i = 0; i < DC3_MEM_STATS_LEN; i++ ) {
+            pMsg->_stats[i] = rec.stats[i];
+        }
+        pMsg->_stats_repeated_len = DC3_MEM_STATS_LEN;
+    }
+
+    pMsg->_errorCode = status;
+    return status;
+}
+
+/**
+ * @brief   Fill in the Done payload of a DC3DiscoverMsg.
+ * Everything comes from the RAM copy of the DB (or from flash) so nothing here
+ * waits on the I2C bus.  A field that can't be read is left empty and the rest
+ * still get filled in.
+ * @param [out] pMsg: DC3DiscoverPayloadMsg pointer to the payload.
+ * @return: DC3Error_t indicating status of operation.  The first error if
+ * some of the fields couldn't be read.  Also put into the errorCode field of
+ * the payload.
+ */
+/*${AOs::Comm_getDiscover} .................................................*/
+DC3Error_t Comm_getDiscover(struct DC3DiscoverPayloadMsg* pMsg) {
+    DC3Error_t status = ERR_NONE;
+    DC3Error_t elemStatus = ERR_NONE;
+    uint8_t ver[6] = { 0 };
+    uint16_t len = 0;
+
+    memset( pMsg, 0, sizeof(*pMsg) );
+    pMsg->_bootMode = _DC3_Application;
+    pMsg->_ipAddr   = ETH_getIpAddr();
+
+    /* Identity of the board */
+    elemStatus = DB_readCached( _DC3_DB_SN, sizeof(pMsg->_sn), pMsg->_sn, &len );
+    pMsg->_sn_len = len;
+    status = ( ERR_NONE == status ) ? elemStatus : status;
+    elemStatus = DB_readCached( _DC3_DB_MAC_ADDR, sizeof(pMsg->_mac), pMsg->_mac, &len );
+    pMsg->_mac_len = len;
+    status = ( ERR_NONE == status ) ? elemStatus : status;
+
+    /* Versions of all the FW images */
+    elemStatus = DB_readCached( _DC3_DB_BOOT_MAJ, 1, &ver[0], &len );
+    status = ( ERR_NONE == status ) ? elemStatus : status;
+    elemStatus = DB_readCached( _DC3_DB_BOOT_MIN, 1, &ver[1], &len );
+    status = ( ERR_NONE == status ) ? elemStatus : status;
+    elemStatus = DB_readCached( _DC3_DB_BOOT_BUILD_DATETIME, sizeof(pMsg->_bootBuildDT), pMsg->_bootBuildDT, &len );
+    pMsg->_bootBuildDT_len = len;
+    status = ( ERR_NONE == status ) ? elemStatus : status;
+    elemStatus = DB_readCached( _DC3_DB_APPL_MAJ, 1, &ver[2], &len );
+    status = ( ERR_NONE == status ) ? elemStatus : status;
+    elemStatus = DB_readCached( _DC3_DB_APPL_MIN, 1, &ver[3], &len );
+    status = ( ERR_NONE == status ) ? elemStatus : status;
+    elemStatus = DB_readCached( _DC3_DB_APPL_BUILD_DATETIME, sizeof(pMsg->_applBuildDT), pMsg->_applBuildDT, &len );
+    pMsg->_applBuildDT_len = len;
+    status = ( ERR_NONE == status ) ? elemStatus : status;
+    elemStatus = DB_readCached( _DC3_DB_FPGA_MAJ, 1, &ver[4], &len );
+    status = ( ERR_NONE == status ) ? elemStatus : status;
+    elemStatus = DB_readCached( _DC3_DB_FPGA_MIN, 1, &ver[5], &len );
+    status = ( ERR_NONE == status ) ? elemStatus : status;
+    elemStatus = DB_readCached( _DC3_DB_FPGA_BUILD_DATETIME, sizeof(pMsg->_fpgaBuildDT), pMsg->_fpgaBuildDT, &len );
+    pMsg->_fpgaBuildDT_len = len;
+    status = ( ERR_NONE == status ) ? elemStatus : status;
+
+    pMsg->_bootMaj = ver[0];
+    pMsg->_bootMin = ver[1];
+    pMsg->_applMaj = ver[2];
+    pMsg->_applMin = ver[3];
+    pMsg->_fpgaMaj = ver[4];
+    pMsg->_fpgaMin = ver[5];
+
+    pMsg->_errorCode = status;
+    return status;
+}
+
 /**
  * \brief CommMgr "class"
  */
@@ -279,9 +649,18 @@ static QState CommMgr_initial(CommMgr * const me, QEvt const * const e) {
     QS_FUN_DICTIONARY(&QHsm_top);
     QS_FUN_DICTIONARY(&CommMgr_initial);
     QS_FUN_DICTIONARY(&CommMgr_Active);
+    QS_FUN_DICTIONARY(&CommMgr_Idle);
+    QS_FUN_DICTIONARY(&CommMgr_Busy);
+    QS_FUN_DICTIONARY(&CommMgr_ValidateMsg);
+    QS_FUN_DICTIONARY(&CommMgr_WaitForRespFromI2C);
+    QS_FUN_DICTIONARY(&CommMgr_WaitForRespFromSysMgr);
+    QS_FUN_DICTIONARY(&CommMgr_WaitForRespFromFlashMgr);
+    QS_FUN_DICTIONARY(&CommMgr_StreamMem);
 
     QActive_subscribe((QActive *)me, SER_RECEIVED_SIG);
     QActive_subscribe((QActive *)me, CLI_RECEIVED_SIG);
+    QActive_subscribe((QActive *)me, DB_GET_ELEMS_DONE_SIG);
+    QActive_subscribe((QActive *)me, DB_SET_ELEMS_DONE_SIG);
 
 
     return Q_TRAN(&CommMgr_Idle);
@@ -327,6 +706,29 @@ static QState CommMgr_Active(CommMgr * const me, QEvt const * const e) {
             status_ = Q_HANDLED();
             break;
         }
+        /* ${AOs::CommMgr::SM::Active::COMM_HEALTH_TIMEOUT} */
+        case COMM_HEALTH_TIMEOUT_SIG: {
+            /* Push the next health msg.  Sequence numbers keep counting even if the push
+             * gets dropped so the client can tell how many it missed. */
+            uint8_t healthBuf[DC3_MAX_MSG_LEN];
+            me->healthPayload._errorCode = ERR_NONE;
+            me->healthPayload._seq       = ++me->healthSeq;
+            HEALTH_fill( &(me->healthPayload) );
+
+            uint16_t healthLen = DC3BasicMsg_write_delimited_to(
+                (void*)&(me->healthBasicMsg),
+                healthBuf,
+                0
+            );
+            healthLen = DC3HealthPayloadMsg_write_delimited_to(
+                (void*)&(me->healthPayload),
+                healthBuf,
+                healthLen
+            );
+            ETH_pushUdp( healthBuf, healthLen );
+            status_ = Q_HANDLED();
+            break;
+        }
         default: {
             status_ = Q_SUPER(&QHsm_top);
             break;
@@ -357,6 +759,7 @@ static QState CommMgr_Idle(CommMgr * const me, QEvt const * const e) {
             me->msgId           = 0;
             me->cliEvtSrc       = _DC3_NoRoute;
             me->cliEvtDst       = _DC3_NoRoute;
+            me->cliEvtSession   = ETH_NO_SESSION;
             me->msgRoute        = _DC3_NoRoute;
             me->msgPayloadName  = _DC3NoMsg;
             me->msgReqProg      = false;
@@ -364,6 +767,12 @@ static QState CommMgr_Idle(CommMgr * const me, QEvt const * const e) {
             memset(&me->basicMsg, 0, sizeof(me->basicMsg));
             memset(&me->payloadMsgUnion, 0, sizeof(me->payloadMsgUnion));
             memset(me->dataBuf, 0, sizeof(me->dataBuf));
+
+            /* recall the next msg (if any) that came in while we were busy */
+            QActive_recall(
+                (QActive *)me,
+                &me->deferredEvtQueue
+            );
             status_ = Q_HANDLED();
             break;
         }
@@ -379,6 +788,7 @@ static QState CommMgr_Idle(CommMgr * const me, QEvt const * const e) {
 
             cliEvt->src = ((LrgDataEvt const *) e)->src;
             cliEvt->dst = ((LrgDataEvt const *) e)->dst;
+            cliEvt->session = ETH_NO_SESSION;
 
             QACTIVE_POST(
                 AO_CommMgr,
@@ -402,6 +812,7 @@ static QState CommMgr_Idle(CommMgr * const me, QEvt const * const e) {
              * information will be lost. */
             me->cliEvtSrc = ((LrgDataEvt const *) e)->src;
             me->cliEvtDst = ((LrgDataEvt const *) e)->dst;
+            me->cliEvtSession = ((LrgDataEvt const *) e)->session;
 
             /* Store the basic msg elements locally since they are needed to send back all the
              * ack, prog, and done replies. */
@@ -422,6 +833,20 @@ static QState CommMgr_Idle(CommMgr * const me, QEvt const * const e) {
                         me->basicMsgOffset
                     );
                     break;
+                case _DC3FlashMetaPayloadMsg:
+                    DC3FlashMetaPayloadMsg_read_delimited_from(
+                        ((LrgDataEvt *) e)->dataBuf,
+                        &(me->payloadMsgUnion.flashMetaPayload),
+                        me->basicMsgOffset
+                    );
+                    break;
+                case _DC3FlashDataPayloadMsg:
+                    DC3FlashDataPayloadMsg_read_delimited_from(
+                        ((LrgDataEvt *) e)->dataBuf,
+                        &(me->payloadMsgUnion.flashDataPayload),
+                        me->basicMsgOffset
+                    );
+                    break;
                 case _DC3I2CDataPayloadMsg:
                     DC3I2CDataPayloadMsg_read_delimited_from(
                         ((LrgDataEvt *) e)->dataBuf,
@@ -443,6 +868,41 @@ static QState CommMgr_Idle(CommMgr * const me, QEvt const * const e) {
                         me->basicMsgOffset
                     );
                     break;
+                case _DC3DBElemsPayloadMsg:
+                    DC3DBElemsPayloadMsg_read_delimited_from(
+                        ((LrgDataEvt *) e)->dataBuf,
+                        &(me->payloadMsgUnion.dbElemsPayload),
+                        me->basicMsgOffset
+                    );
+                    break;
+                case _DC3MemDataPayloadMsg:
+                    DC3MemDataPayloadMsg_read_delimited_from(
+                        ((LrgDataEvt *) e)->dataBuf,
+                        &(me->payloadMsgUnion.memDataPayload),
+                        me->basicMsgOffset
+                    );
+                    break;
+                case _DC3ProfPayloadMsg:
+                    DC3ProfPayloadMsg_read_delimited_from(
+                        ((LrgDataEvt *) e)->dataBuf,
+                        &(me->payloadMsgUnion.profPayload),
+                        me->basicMsgOffset
+                    );
+                    break;
+                case _DC3MemStatsPayloadMsg:
+                    DC3MemStatsPayloadMsg_read_delimited_from(
+                        ((LrgDataEvt *) e)->dataBuf,
+                        &(me->payloadMsgUnion.memStatsPayload),
+                        me->basicMsgOffset
+                    );
+                    break;
+                case _DC3HealthPayloadMsg:
+                    DC3HealthPayloadMsg_read_delimited_from(
+                        ((LrgDataEvt *) e)->dataBuf,
+                        &(me->payloadMsgUnion.healthPayload),
+                        me->basicMsgOffset
+                    );
+                    break;
                 case _DC3StatusPayloadMsg:             /* Intentionally fall through */
                 case _DC3VersionPayloadMsg:            /* Intentionally fall through */
                 default:
@@ -498,6 +958,7 @@ static QState CommMgr_Busy(CommMgr * const me, QEvt const * const e) {
              * to where it originally came from. */
             evt->dst = me->cliEvtSrc;
             evt->src = me->cliEvtDst;
+            evt->session = me->cliEvtSession;
             evt->dataLen = DC3BasicMsg_write_delimited_to(&(me->basicMsg), evt->dataBuf, 0);
             me->errorCode = Comm_sendToClient( evt );
 
@@ -529,6 +990,7 @@ static QState CommMgr_Busy(CommMgr * const me, QEvt const * const e) {
              * to where it originally came from. */
             evt->dst = me->cliEvtSrc;
             evt->src = me->cliEvtDst;
+            evt->session = me->cliEvtSession;
             evt->dataLen = DC3BasicMsg_write_delimited_to(&(me->basicMsg), evt->dataBuf, 0);
 
             /* Append payload msg if needed */
@@ -556,6 +1018,20 @@ static QState CommMgr_Busy(CommMgr * const me, QEvt const * const e) {
                         evt->dataLen
                     );
                     break;
+                case _DC3FlashMetaPayloadMsg:
+                    evt->dataLen = DC3FlashMetaPayloadMsg_write_delimited_to(
+                        (void*)&(me->payloadMsgUnion.flashMetaPayload),
+                        evt->dataBuf,
+                        evt->dataLen
+                    );
+                    break;
+                case _DC3FlashDataPayloadMsg:
+                    evt->dataLen = DC3FlashDataPayloadMsg_write_delimited_to(
+                        (void*)&(me->payloadMsgUnion.flashDataPayload),
+                        evt->dataBuf,
+                        evt->dataLen
+                    );
+                    break;
                 case _DC3I2CDataPayloadMsg:
                     DBG_printf("Sending I2CData payload\n");
                     evt->dataLen = DC3I2CDataPayloadMsg_write_delimited_to(
@@ -564,6 +1040,48 @@ static QState CommMgr_Busy(CommMgr * const me, QEvt const * const e) {
                         evt->dataLen
                     );
                     break;
+                case _DC3DBElemsPayloadMsg:
+                    evt->dataLen = DC3DBElemsPayloadMsg_write_delimited_to(
+                        (void*)&(me->payloadMsgUnion.dbElemsPayload),
+                        evt->dataBuf,
+                        evt->dataLen
+                    );
+                    break;
+                case _DC3MemDataPayloadMsg:
+                    evt->dataLen = DC3MemDataPayloadMsg_write_delimited_to(
+                        (void*)&(me->payloadMsgUnion.memDataPayload),
+                        evt->dataBuf,
+                        evt->dataLen
+                    );
+                    break;
+                case _DC3ProfPayloadMsg:
+                    evt->dataLen = DC3ProfPayloadMsg_write_delimited_to(
+                        (void*)&(me->payloadMsgUnion.profPayload),
+                        evt->dataBuf,
+                        evt->dataLen
+                    );
+                    break;
+                case _DC3MemStatsPayloadMsg:
+                    evt->dataLen = DC3MemStatsPayloadMsg_write_delimited_to(
+                        (void*)&(me->payloadMsgUnion.memStatsPayload),
+                        evt->dataBuf,
+                        evt->dataLen
+                    );
+                    break;
+                case _DC3HealthPayloadMsg:
+                    evt->dataLen = DC3HealthPayloadMsg_write_delimited_to(
+                        (void*)&(me->payloadMsgUnion.healthPayload),
+                        evt->dataBuf,
+                        evt->dataLen
+                    );
+                    break;
+                case _DC3DiscoverPayloadMsg:
+                    evt->dataLen = DC3DiscoverPayloadMsg_write_delimited_to(
+                        (void*)&(me->payloadMsgUnion.discoverPayload),
+                        evt->dataBuf,
+                        evt->dataLen
+                    );
+                    break;
                 case _DC3NoMsg:
                     WRN_printf("Not sending payload as part of Done msg.\n");
                     break;
@@ -592,6 +1110,9 @@ static QState CommMgr_Busy(CommMgr * const me, QEvt const * const e) {
                 "Error sending Done, attempting to continue. Error 0x%08x\n",
                 me->errorCode
             );
+
+            /* LWIPMgr holds off the next msgs from the same client until this one is done */
+            ETH_msgDone( me->cliEvtSrc, me->cliEvtSession );
             status_ = Q_HANDLED();
             break;
         }
@@ -611,6 +1132,44 @@ static QState CommMgr_Busy(CommMgr * const me, QEvt const * const e) {
             status_ = Q_TRAN(&CommMgr_Idle);
             break;
         }
+        /* ${AOs::CommMgr::SM::Active::Busy::CLI_RECEIVED} */
+        case CLI_RECEIVED_SIG: {
+            if (QEQueue_getNFree(&me->deferredEvtQueue) > 0) {
+               /* defer the msg - this event will be handled when the state machine goes
+                * back to Idle state */
+               QActive_defer((QActive *)me, &me->deferredEvtQueue, e);
+            } else {
+               ERR_printf("Unable to defer msg, dropping it\n");
+               ETH_msgDone(
+                   ((LrgDataEvt const *)e)->src,
+                   ((LrgDataEvt const *)e)->session
+               );
+            }
+            status_ = Q_HANDLED();
+            break;
+        }
+        /* ${AOs::CommMgr::SM::Active::Busy::SER_RECEIVED} */
+        case SER_RECEIVED_SIG: {
+            LrgDataEvt *cliEvt = Q_NEW(LrgDataEvt, CLI_RECEIVED_SIG);
+            cliEvt->dataLen = base64_decode(
+                (char *)((LrgDataEvt const *) e)->dataBuf,
+                ((LrgDataEvt const *) e)->dataLen,
+                (char *)cliEvt->dataBuf,
+                DC3_MAX_MSG_LEN
+            );
+
+            cliEvt->src = ((LrgDataEvt const *) e)->src;
+            cliEvt->dst = ((LrgDataEvt const *) e)->dst;
+            cliEvt->session = ETH_NO_SESSION;
+
+            QACTIVE_POST(
+                AO_CommMgr,
+                (QEvt *)(cliEvt),
+                AO_CommMgr
+            );
+            status_ = Q_HANDLED();
+            break;
+        }
         default: {
             status_ = Q_SUPER(&CommMgr_Active);
             break;
@@ -676,9 +1235,81 @@ static QState CommMgr_ValidateMsg(CommMgr * const me, QEvt const * const e) {
             }
             /* ${AOs::CommMgr::SM::Active::Busy::ValidateMsg::MSG_PROCESS::[Flash?]} */
             else if (_DC3FlashMsg == me->basicMsg._msgName) {
-                me->errorCode = ERR_MSG_UNSUPPORTED_IN_APPLICATION;
+                me->errorCode = ERR_NONE;
 
-                status_ = Q_TRAN(&CommMgr_Idle);
+                /* ${AOs::CommMgr::SM::Active::Busy::ValidateMsg::MSG_PROCESS::[Flash?]::[FlashMetaPayloa~} */
+                if (_DC3FlashMetaPayloadMsg == me->msgPayloadName) {
+                    /* The flash meta payload is the start of the FW update.  The meta payload contains
+                     * all the information about the coming fw data.  We need to store this so it can be
+                     * used to keep track of the FW flash process.  In the Application, the image goes
+                     * into the staged slot and is only installed by the Bootloader on next reboot. */
+
+                    /* 1. Create a FWMetaEvt and send it along to FlashMgr AO to prep the flash */
+                    FWMetaEvt *evt = Q_NEW(FWMetaEvt, FLASH_OP_START_SIG);
+                    evt->imageCRC  = me->payloadMsgUnion.flashMetaPayload._imageCrc;
+                    evt->imageMaj  = me->payloadMsgUnion.flashMetaPayload._imageMaj;
+                    evt->imageMin  = me->payloadMsgUnion.flashMetaPayload._imageMin;
+                    evt->imageSize = me->payloadMsgUnion.flashMetaPayload._imageSize;
+                    evt->imageType = me->payloadMsgUnion.flashMetaPayload._imageType;
+                    evt->imageNumPackets = me->payloadMsgUnion.flashMetaPayload._imageNumPackets;
+                    evt->imageSectorMask = me->payloadMsgUnion.flashMetaPayload._imageSectorMask;
+                    evt->imageCompression = me->payloadMsgUnion.flashMetaPayload._imageCompression;
+
+                    evt->imageDatetimeLen = me->payloadMsgUnion.flashMetaPayload._imageDatetime_len;
+                    MEMCPY(
+                        evt->imageDatetime,
+                        me->payloadMsgUnion.flashMetaPayload._imageDatetime,
+                        evt->imageDatetimeLen
+                    );
+                    QACTIVE_POST(AO_FlashMgr, (QEvt *)(evt), AO_CommMgr);
+
+                    /* Compose Done response.  The metadata is echoed back along with the packet the client
+                     * should resume from (0 if starting over) so the payload msg is left as is.  The fields
+                     * specific to this response get set once FlashMgr responds. */
+                    me->msgPayloadName = _DC3FlashMetaPayloadMsg;
+
+                    /* Don't change the basicMsg name since it should be the same in all cases. */
+                    me->basicMsg._msgPayload = me->msgPayloadName;
+                    status_ = Q_TRAN(&CommMgr_WaitForRespFromFlashMgr);
+                }
+                /* ${AOs::CommMgr::SM::Active::Busy::ValidateMsg::MSG_PROCESS::[Flash?]::[FlashDataPayloa~} */
+                else if (_DC3FlashDataPayloadMsg == me->msgPayloadName) {
+                    /* The flash data payload is used to transfer the FW data packets to FlashMgr AO. */
+
+                    /* 1. Create a FWMetaEvt and send it along to FlashMgr AO to prep the flash */
+                    FWDataEvt *evt = Q_NEW(FWDataEvt, FLASH_DATA_SIG);
+                    evt->dataCRC  = me->payloadMsgUnion.flashDataPayload._dataCrc;
+                    evt->dataLen  = me->payloadMsgUnion.flashDataPayload._dataBuf_len;
+                    evt->seqCurr  = me->payloadMsgUnion.flashDataPayload._seqCurr;
+                    MEMCPY(
+                        evt->dataBuf,
+                        me->payloadMsgUnion.flashDataPayload._dataBuf,
+                        evt->dataLen
+                    );
+                    QACTIVE_POST(AO_FlashMgr, (QEvt *)(evt), AO_CommMgr);
+
+                    /* Compose Done response.  We can re-use the current structure and it will be used by
+                     * the exit action of the parent state to send the msg.  Here, we only set up fields
+                     * that are specific to this response. We can also destructively change the payload
+                     * name since we are sending a response right after this. */
+                    me->msgPayloadName = _DC3StatusPayloadMsg;
+
+                    /* Don't change the basicMsg name since it should be the same in all cases. */
+                    me->basicMsg._msgPayload = me->msgPayloadName;
+                    status_ = Q_TRAN(&CommMgr_WaitForRespFromFlashMgr);
+                }
+                /* ${AOs::CommMgr::SM::Active::Busy::ValidateMsg::MSG_PROCESS::[Flash?]::[else]} */
+                else {
+                    me->errorCode = ERR_MSG_UNEXPECTED_PAYLOAD;
+                    ERR_printf("Unexpected payload %s (%d) msg for basic msg: %s (%d). Error: 0x%08x\n",
+                        CON_msgNameToStr(me->msgPayloadName), me->msgPayloadName,
+                        CON_msgNameToStr(me->basicMsg._msgName), me->basicMsg._msgName, me->errorCode);
+
+                    /* Has to be set after checking for a valid payload */
+                    me->msgPayloadName = _DC3StatusPayloadMsg;
+                    me->basicMsg._msgPayload = me->msgPayloadName;
+                    status_ = Q_TRAN(&CommMgr_Idle);
+                }
             }
             /* ${AOs::CommMgr::SM::Active::Busy::ValidateMsg::MSG_PROCESS::[SetBootMode?]} */
             else if (_DC3SetBootModeMsg == me->basicMsg._msgName) {
@@ -759,6 +1390,7 @@ static QState CommMgr_ValidateMsg(CommMgr * const me, QEvt const * const e) {
                         i2cReadReqEvt->start          = me->payloadMsgUnion.i2cDataPayload._start;
                         i2cReadReqEvt->bytes          = me->payloadMsgUnion.i2cDataPayload._nBytes;
                         i2cReadReqEvt->accessType     = me->payloadMsgUnion.i2cDataPayload._accType;
+                        i2cReadReqEvt->priority       = I2C_PRIO_BULK;
                         QACTIVE_POST(AO_I2C1DevMgr, (QEvt *)(i2cReadReqEvt), me);
                         status_ = Q_TRAN(&CommMgr_WaitForRespFromI2C);
                     }
@@ -796,6 +1428,16 @@ static QState CommMgr_ValidateMsg(CommMgr * const me, QEvt const * const e) {
                               (uint8_t *)me->payloadMsgUnion.i2cDataPayload._dataBuf,
                               (uint16_t *)&(me->payloadMsgUnion.i2cDataPayload._dataBuf_len)
                         );
+
+                        /* Keep the RAM shadow of the DB in sync with what's now in EEPROM */
+                        if ( ERR_NONE == me->payloadMsgUnion.i2cDataPayload._errorCode ) {
+                            DB_syncShadow(
+                                me->payloadMsgUnion.i2cDataPayload._i2cDev,
+                                me->payloadMsgUnion.i2cDataPayload._start,
+                                me->payloadMsgUnion.i2cDataPayload._dataBuf_len,
+                                (uint8_t *)me->payloadMsgUnion.i2cDataPayload._dataBuf
+                            );
+                        }
                         status_ = Q_TRAN(&CommMgr_Idle);
                     }
                     /* ${AOs::CommMgr::SM::Active::Busy::ValidateMsg::MSG_PROCESS::[I2CWrite?]::[ValidPayload?]::[else]} */
@@ -805,6 +1447,7 @@ static QState CommMgr_ValidateMsg(CommMgr * const me, QEvt const * const e) {
                         i2cWriteReqEvt->i2cDev         = me->payloadMsgUnion.i2cDataPayload._i2cDev;
                         i2cWriteReqEvt->start          = me->payloadMsgUnion.i2cDataPayload._start;
                         i2cWriteReqEvt->accessType     = me->payloadMsgUnion.i2cDataPayload._accType;
+                        i2cWriteReqEvt->priority       = I2C_PRIO_BULK;
                         i2cWriteReqEvt->bytes          = me->payloadMsgUnion.i2cDataPayload._nBytes;
                         MEMCPY(
                             i2cWriteReqEvt->dataBuf,
@@ -1048,6 +1691,302 @@ static QState CommMgr_ValidateMsg(CommMgr * const me, QEvt const * const e) {
                     status_ = Q_TRAN(&CommMgr_Idle);
                 }
             }
+            /* ${AOs::CommMgr::SM::Active::Busy::ValidateMsg::MSG_PROCESS::[FlashSectorCrc?]} */
+            else if (_DC3FlashSectorCrcMsg == me->basicMsg._msgName) {
+                me->errorCode = ERR_MSG_UNSUPPORTED_IN_APPLICATION;
+                ERR_printf("%s (%d) msg is only supported by the Bootloader. Error: 0x%08x\n",
+                    CON_msgNameToStr(me->basicMsg._msgName), me->basicMsg._msgName, me->errorCode);
+
+                /* The Application runs from the sectors being checked so it can't do partial updates */
+                me->msgPayloadName = _DC3StatusPayloadMsg;
+                me->basicMsg._msgPayload = me->msgPayloadName;
+                me->payloadMsgUnion.statusPayload._errorCode = me->errorCode;
+                status_ = Q_TRAN(&CommMgr_Idle);
+            }
+            /* ${AOs::CommMgr::SM::Active::Busy::ValidateMsg::MSG_PROCESS::[MemRead?]} */
+            else if (_DC3MemReadMsg == me->basicMsg._msgName) {
+                /* ${AOs::CommMgr::SM::Active::Busy::ValidateMsg::MSG_PROCESS::[MemRead?]::[ValidPayload?]} */
+                if (_DC3MemDataPayloadMsg == me->msgPayloadName) {
+                    /* Has to be set after checking for a valid payload.  The Prog msgs carrying the data
+                     * and the Done msg all use the same payload as the request. */
+                    me->basicMsg._msgPayload = me->msgPayloadName;
+                    me->errorCode = Comm_checkMemRange(
+                        me->payloadMsgUnion.memDataPayload._memSpace,
+                        me->payloadMsgUnion.memDataPayload._offset,
+                        me->payloadMsgUnion.memDataPayload._length
+                    );
+                    /* ${AOs::CommMgr::SM::Active::Busy::ValidateMsg::MSG_PROCESS::[MemRead?]::[ValidPayload?]::[ValidRange?]} */
+                    if (ERR_NONE == me->errorCode) {
+                        me->memReadSpace       = me->payloadMsgUnion.memDataPayload._memSpace;
+                        me->memReadOffsetStart = me->payloadMsgUnion.memDataPayload._offset;
+                        me->memReadOffsetCurr  = me->memReadOffsetStart;
+                        me->memReadOffsetEnd   = me->memReadOffsetStart + me->payloadMsgUnion.memDataPayload._length;
+                        me->memReadSeqCurr     = 0;
+                        me->memReadCredits     = me->payloadMsgUnion.memDataPayload._credits;
+                        if ( me->memReadCredits > DC3_MEM_READ_MAX_CREDITS ) {
+                            me->memReadCredits = DC3_MEM_READ_MAX_CREDITS;
+                        }
+                        status_ = Q_TRAN(&CommMgr_StreamMem);
+                    }
+                    /* ${AOs::CommMgr::SM::Active::Busy::ValidateMsg::MSG_PROCESS::[MemRead?]::[ValidPayload?]::[else]} */
+                    else {
+                        ERR_printf("Can't read %d bytes at offset 0x%08x of memSpace %d. Error: 0x%08x\n",
+                            me->payloadMsgUnion.memDataPayload._length, me->payloadMsgUnion.memDataPayload._offset,
+                            me->payloadMsgUnion.memDataPayload._memSpace, me->errorCode);
+                        me->payloadMsgUnion.memDataPayload._errorCode   = me->errorCode;
+                        me->payloadMsgUnion.memDataPayload._length      = 0;
+                        me->payloadMsgUnion.memDataPayload._credits     = 0;
+                        me->payloadMsgUnion.memDataPayload._dataBuf_len = 0;
+                        status_ = Q_TRAN(&CommMgr_Idle);
+                    }
+                }
+                /* ${AOs::CommMgr::SM::Active::Busy::ValidateMsg::MSG_PROCESS::[MemRead?]::[else]} */
+                else {
+                    me->errorCode = ERR_MSG_UNEXPECTED_PAYLOAD;
+                    ERR_printf("Unexpected payload %s (%d) msg for basic msg: %s (%d). Error: 0x%08x\n",
+                        CON_msgNameToStr(me->msgPayloadName), me->msgPayloadName,
+                        CON_msgNameToStr(me->basicMsg._msgName), me->basicMsg._msgName, me->errorCode);
+
+                    /* Has to be set after checking for a valid payload */
+                    me->msgPayloadName = _DC3StatusPayloadMsg;
+                    me->basicMsg._msgPayload = me->msgPayloadName;
+                    status_ = Q_TRAN(&CommMgr_Idle);
+                }
+            }
+            /* ${AOs::CommMgr::SM::Active::Busy::ValidateMsg::MSG_PROCESS::[DBGetElems?]} */
+            else if (_DC3DBGetElemsMsg == me->basicMsg._msgName) {
+                /* ${AOs::CommMgr::SM::Active::Busy::ValidateMsg::MSG_PROCESS::[DBGetElems?]::[ValidPayload?]} */
+                if (_DC3DBElemsPayloadMsg == me->msgPayloadName) {
+                    /* Has to be set after checking for a valid payload */
+                    me->msgPayloadName = _DC3DBElemsPayloadMsg;
+                    me->basicMsg._msgPayload = me->msgPayloadName;
+
+                    /* Create the event and directly post it to the right AO.  SysMgr checks the list
+                     * itself so only make sure not to copy past the end of the event here. */
+                    DBElemsEvt *dbElemsEvt = Q_NEW(DBElemsEvt, DB_GET_ELEMS_SIG);
+                    dbElemsEvt->elemList.accessType = me->payloadMsgUnion.dbElemsPayload._accType;
+                    dbElemsEvt->elemList.nElems     = me->payloadMsgUnion.dbElemsPayload._elem_repeated_len;
+                    for ( uint8_t i = 0; i < MIN(dbElemsEvt->elemList.nElems, _DC3_DB_MAX_ELEM); i++ ) {
+                        dbElemsEvt->elemList.elems[i] = (DC3DBElem_t)me->payloadMsgUnion.dbElemsPayload._elem[i];
+                    }
+                    /* Ignore the _elemLen and _dataBuf parts of the msg since they are not needed
+                     * for a read */
+                    QACTIVE_POST(AO_SysMgr, (QEvt *)(dbElemsEvt), me);
+                    status_ = Q_TRAN(&CommMgr_WaitForRespFromSysMgr);
+                }
+                /* ${AOs::CommMgr::SM::Active::Busy::ValidateMsg::MSG_PROCESS::[DBGetElems?]::[else]} */
+                else {
+                    me->errorCode = ERR_MSG_UNEXPECTED_PAYLOAD;
+                    ERR_printf("Unexpected payload %s (%d) msg for basic msg: %s (%d). Error: 0x%08x\n",
+                        CON_msgNameToStr(me->msgPayloadName), me->msgPayloadName,
+                        CON_msgNameToStr(me->basicMsg._msgName), me->basicMsg._msgName, me->errorCode);
+
+                    /* Has to be set after checking for a valid payload */
+                    me->msgPayloadName = _DC3StatusPayloadMsg;
+                    me->basicMsg._msgPayload = me->msgPayloadName;
+                    status_ = Q_TRAN(&CommMgr_Idle);
+                }
+            }
+            /* ${AOs::CommMgr::SM::Active::Busy::ValidateMsg::MSG_PROCESS::[DBSetElems?]} */
+            else if (_DC3DBSetElemsMsg == me->basicMsg._msgName) {
+                /* ${AOs::CommMgr::SM::Active::Busy::ValidateMsg::MSG_PROCESS::[DBSetElems?]::[ValidPayload?]} */
+                if (_DC3DBElemsPayloadMsg == me->msgPayloadName) {
+                    /* Has to be set after checking for a valid payload */
+                    me->msgPayloadName = _DC3DBElemsPayloadMsg;
+                    me->basicMsg._msgPayload = me->msgPayloadName;
+
+                    /* Create the event and directly post it to the right AO.  SysMgr checks the list
+                     * (including the length of every element) so only make sure not to copy past the
+                     * end of the event here. */
+                    DBElemsEvt *dbElemsEvt = Q_NEW(DBElemsEvt, DB_SET_ELEMS_SIG);
+                    dbElemsEvt->elemList.accessType = me->payloadMsgUnion.dbElemsPayload._accType;
+                    dbElemsEvt->elemList.nElems     = me->payloadMsgUnion.dbElemsPayload._elem_repeated_len;
+                    for ( uint8_t i = 0; i < MIN(dbElemsEvt->elemList.nElems, _DC3_DB_MAX_ELEM); i++ ) {
+                        dbElemsEvt->elemList.elems[i]   = (DC3DBElem_t)me->payloadMsgUnion.dbElemsPayload._elem[i];
+                        dbElemsEvt->elemList.elemLen[i] = ( i < me->payloadMsgUnion.dbElemsPayload._elemLen_repeated_len ) ?
+                            (uint8_t)me->payloadMsgUnion.dbElemsPayload._elemLen[i] : 0;
+                    }
+                    dbElemsEvt->elemList.dataLen = MIN(
+                        me->payloadMsgUnion.dbElemsPayload._dataBuf_len,
+                        DC3_DB_ELEMS_MAX_DATA_LEN
+                    );
+                    MEMCPY(
+                        dbElemsEvt->elemList.dataBuf,
+                        me->payloadMsgUnion.dbElemsPayload._dataBuf,
+                        dbElemsEvt->elemList.dataLen
+                    );
+
+                    QACTIVE_POST(AO_SysMgr, (QEvt *)(dbElemsEvt), me);
+                    status_ = Q_TRAN(&CommMgr_WaitForRespFromSysMgr);
+                }
+                /* ${AOs::CommMgr::SM::Active::Busy::ValidateMsg::MSG_PROCESS::[DBSetElems?]::[else]} */
+                else {
+                    me->errorCode = ERR_MSG_UNEXPECTED_PAYLOAD;
+                    ERR_printf("Unexpected payload %s (%d) msg for basic msg: %s (%d). Error: 0x%08x\n",
+                        CON_msgNameToStr(me->msgPayloadName), me->msgPayloadName,
+                        CON_msgNameToStr(me->basicMsg._msgName), me->basicMsg._msgName, me->errorCode);
+
+                    /* Has to be set after checking for a valid payload */
+                    me->msgPayloadName = _DC3StatusPayloadMsg;
+                    me->basicMsg._msgPayload = me->msgPayloadName;
+                    status_ = Q_TRAN(&CommMgr_Idle);
+                }
+            }
+            /* ${AOs::CommMgr::SM::Active::Busy::ValidateMsg::MSG_PROCESS::[Prof?]} */
+            else if (_DC3ProfMsg == me->basicMsg._msgName) {
+                /* ${AOs::CommMgr::SM::Active::Busy::ValidateMsg::MSG_PROCESS::[Prof?]::[ValidPayload?]} */
+                if (_DC3ProfPayloadMsg == me->msgPayloadName) {
+                    /* Has to be set after checking for a valid payload.  The Done uses the same payload
+                     * as the request. */
+                    me->basicMsg._msgPayload = me->msgPayloadName;
+
+                    /* The records are all in memory so there is nothing to wait for */
+                    me->errorCode = Comm_getProf( &(me->payloadMsgUnion.profPayload) );
+
+                    /* Only print error if something went wrong */
+                    ERR_COND_OUTPUT(
+                        me->errorCode,
+                        _DC3_ACCESS_QPC,
+                        "Unable to get profiling records. Error: 0x%08x\n",
+                        me->errorCode
+                    );
+                    status_ = Q_TRAN(&CommMgr_Idle);
+                }
+                /* ${AOs::CommMgr::SM::Active::Busy::ValidateMsg::MSG_PROCESS::[Prof?]::[else]} */
+                else {
+                    me->errorCode = ERR_MSG_UNEXPECTED_PAYLOAD;
+                    ERR_printf("Unexpected payload %s (%d) msg for basic msg: %s (%d). Error: 0x%08x\n",
+                        CON_msgNameToStr(me->msgPayloadName), me->msgPayloadName,
+                        CON_msgNameToStr(me->basicMsg._msgName), me->basicMsg._msgName, me->errorCode);
+
+                    /* Has to be set after checking for a valid payload */
+                    me->msgPayloadName = _DC3StatusPayloadMsg;
+                    me->basicMsg._msgPayload = me->msgPayloadName;
+                    status_ = Q_TRAN(&CommMgr_Idle);
+                }
+            }
+            /* ${AOs::CommMgr::SM::Active::Busy::ValidateMsg::MSG_PROCESS::[MemStats?]} */
+            else if (_DC3MemStatsMsg == me->basicMsg._msgName) {
+                /* ${AOs::CommMgr::SM::Active::Busy::ValidateMsg::MSG_PROCESS::[MemStats?]::[ValidPayload?]} */
+                if (_DC3MemStatsPayloadMsg == me->msgPayloadName) {
+                    /* Has to be set after checking for a valid payload.  The Done uses the same payload
+                     * as the request. */
+                    me->basicMsg._msgPayload = me->msgPayloadName;
+
+                    /* The counters are all in memory so there is nothing to wait for */
+                    me->errorCode = Comm_getMemStats( &(me->payloadMsgUnion.memStatsPayload) );
+
+                    /* Only print error if something went wrong */
+                    ERR_COND_OUTPUT(
+                        me->errorCode,
+                        _DC3_ACCESS_QPC,
+                        "Unable to get pool and queue usage record. Error: 0x%08x\n",
+                        me->errorCode
+                    );
+                    status_ = Q_TRAN(&CommMgr_Idle);
+                }
+                /* ${AOs::CommMgr::SM::Active::Busy::ValidateMsg::MSG_PROCESS::[MemStats?]::[else]} */
+                else {
+                    me->errorCode = ERR_MSG_UNEXPECTED_PAYLOAD;
+                    ERR_printf("Unexpected payload %s (%d) msg for basic msg: %s (%d). Error: 0x%08x\n",
+                        CON_msgNameToStr(me->msgPayloadName), me->msgPayloadName,
+                        CON_msgNameToStr(me->basicMsg._msgName), me->basicMsg._msgName, me->errorCode);
+
+                    /* Has to be set after checking for a valid payload */
+                    me->msgPayloadName = _DC3StatusPayloadMsg;
+                    me->basicMsg._msgPayload = me->msgPayloadName;
+                    status_ = Q_TRAN(&CommMgr_Idle);
+                }
+            }
+            /* ${AOs::CommMgr::SM::Active::Busy::ValidateMsg::MSG_PROCESS::[Health?]} */
+            else if (_DC3HealthMsg == me->basicMsg._msgName) {
+                /* ${AOs::CommMgr::SM::Active::Busy::ValidateMsg::MSG_PROCESS::[Health?]::[ValidPayload?]} */
+                if (_DC3HealthPayloadMsg == me->msgPayloadName) {
+                    /* Has to be set after checking for a valid payload.  The Done uses the same payload
+                     * as the request. */
+                    me->basicMsg._msgPayload = me->msgPayloadName;
+                    me->errorCode = ERR_NONE;
+
+                    struct DC3HealthPayloadMsg *pReq = &(me->payloadMsgUnion.healthPayload);
+                    if ( _DC3_EthCli != me->cliEvtSrc ) {
+                        me->errorCode = ERR_HEALTH_ROUTE_NOT_UDP;    /* Pushes only go out over UDP */
+                    } else if ( 0 != pReq->_intervalMs &&
+                                ( pReq->_intervalMs < DC3_HEALTH_MIN_INTERVAL_MS ||
+                                  pReq->_intervalMs > DC3_HEALTH_MAX_INTERVAL_MS ) ) {
+                        me->errorCode = ERR_HEALTH_INVALID_INTERVAL;
+                    } else if ( pReq->_port > UINT16_MAX ) {
+                        me->errorCode = ERR_HEALTH_INVALID_PORT;
+                    }
+
+                    if ( ERR_NONE == me->errorCode ) {
+                        QTimeEvt_disarm( &me->healthTimerEvt );
+                        if ( 0 == pReq->_intervalMs ) {
+                            me->errorCode = ETH_unsubscribeUdpPush();
+                        } else {
+                            /* Pushes carry the ID of this request and go to the host it came from */
+                            me->healthBasicMsg             = me->basicMsg;
+                            me->healthBasicMsg._msgType    = _DC3_Prog;
+                            me->healthBasicMsg._msgReqProg = 0;
+                            me->healthPayload._intervalMs  = pReq->_intervalMs;
+                            me->healthPayload._port        = pReq->_port;
+                            me->healthSeq                  = 0;
+                            me->errorCode = ETH_subscribeUdpPush(
+                                me->cliEvtSession,
+                                (uint16_t)pReq->_port
+                            );
+                            QTimeEvt_postEvery(
+                                &me->healthTimerEvt,
+                                (QActive *)me,
+                                MS_TO_TICKS( pReq->_intervalMs )
+                            );
+                        }
+                    }
+
+                    pReq->_errorCode          = me->errorCode;
+                    pReq->_seq                = me->healthSeq;
+                    pReq->_uptimeMs           = HEALTH_getUptimeMs();
+                    pReq->_stats_repeated_len = 0;
+
+                    /* Only print error if something went wrong */
+                    ERR_COND_OUTPUT(
+                        me->errorCode,
+                        _DC3_ACCESS_QPC,
+                        "Unable to set up the health stream. Error: 0x%08x\n",
+                        me->errorCode
+                    );
+                    status_ = Q_TRAN(&CommMgr_Idle);
+                }
+                /* ${AOs::CommMgr::SM::Active::Busy::ValidateMsg::MSG_PROCESS::[Health?]::[else]} */
+                else {
+                    me->errorCode = ERR_MSG_UNEXPECTED_PAYLOAD;
+                    ERR_printf("Unexpected payload %s (%d) msg for basic msg: %s (%d). Error: 0x%08x\n",
+                        CON_msgNameToStr(me->msgPayloadName), me->msgPayloadName,
+                        CON_msgNameToStr(me->basicMsg._msgName), me->basicMsg._msgName, me->errorCode);
+
+                    /* Has to be set after checking for a valid payload */
+                    me->msgPayloadName = _DC3StatusPayloadMsg;
+                    me->basicMsg._msgPayload = me->msgPayloadName;
+                    status_ = Q_TRAN(&CommMgr_Idle);
+                }
+            }
+            /* ${AOs::CommMgr::SM::Active::Busy::ValidateMsg::MSG_PROCESS::[Discover?]} */
+            else if (_DC3DiscoverMsg == me->basicMsg._msgName) {
+                me->errorCode = Comm_getDiscover( &(me->payloadMsgUnion.discoverPayload) );
+
+                /* Even with some of the fields missing, the host still wants to know the board is there
+                 * so always send back the discover payload */
+                me->msgPayloadName = _DC3DiscoverPayloadMsg;
+                me->basicMsg._msgPayload = me->msgPayloadName;
+
+                /* Only print error if something went wrong */
+                ERR_COND_OUTPUT(
+                    me->errorCode,
+                    _DC3_ACCESS_QPC,
+                    "Unable to read some of the discover fields. Error: 0x%08x\n",
+                    me->errorCode
+                );
+                status_ = Q_TRAN(&CommMgr_Idle);
+            }
             /* ${AOs::CommMgr::SM::Active::Busy::ValidateMsg::MSG_PROCESS::[else]} */
             else {
                 me->errorCode = ERR_MSG_UNKNOWN_BASIC;
@@ -1137,6 +2076,17 @@ static QState CommMgr_WaitForRespFromI2C(CommMgr * const me, QEvt const * const
         /* ${AOs::CommMgr::SM::Active::Busy::WaitForRespFromI~::I2C1_DEV_WRITE_D~} */
         case I2C1_DEV_WRITE_DONE_SIG: {
             me->errorCode = ((I2CWriteDoneEvt const *) e)->status;
+
+            /* Keep the RAM shadow of the DB in sync with what's now in EEPROM.  This has
+             * to happen before the status overwrites the payload union. */
+            if ( ERR_NONE == me->errorCode ) {
+                DB_syncShadow(
+                    me->payloadMsgUnion.i2cDataPayload._i2cDev,
+                    me->payloadMsgUnion.i2cDataPayload._start,
+                    ((I2CWriteDoneEvt const *) e)->bytes,
+                    (uint8_t *)me->payloadMsgUnion.i2cDataPayload._dataBuf
+                );
+            }
             if ( ERR_NONE == me->errorCode ) {
                 DBG_printf("Got I2C1_DEV_WRITE_DONE with %d bytes\n", ((I2CWriteDoneEvt const *) e)->bytes);
             }
@@ -1218,6 +2168,307 @@ static QState CommMgr_WaitForRespFromSysMgr(CommMgr * const me, QEvt const * con
             status_ = Q_TRAN(&CommMgr_Idle);
             break;
         }
+        /* ${AOs::CommMgr::SM::Active::Busy::WaitForRespFromS~::DB_GET_ELEMS_DON~} */
+        case DB_GET_ELEMS_DONE_SIG: /* intentionally fall through */
+        case DB_SET_ELEMS_DONE_SIG: {
+            DB_ElemList_t const *pList = &((DBElemsEvt const *) e)->elemList;
+            uint8_t nElems = MIN(pList->nElems, _DC3_DB_MAX_ELEM);
+
+            me->errorCode = ((DBElemsEvt const *) e)->status;
+            me->payloadMsgUnion.dbElemsPayload._errorCode = me->errorCode;
+            me->payloadMsgUnion.dbElemsPayload._accType   = pList->accessType;
+            me->payloadMsgUnion.dbElemsPayload._elem_repeated_len    = nElems;
+            me->payloadMsgUnion.dbElemsPayload._elemLen_repeated_len = nElems;
+            for ( uint8_t i = 0; i < nElems; i++ ) {
+                me->payloadMsgUnion.dbElemsPayload._elem[i]    = pList->elems[i];
+                me->payloadMsgUnion.dbElemsPayload._elemLen[i] = pList->elemLen[i];
+            }
+
+            /* Only a successful get sends data back.  Everything else would be invalid data
+             * or just an echo of what the client sent. */
+            if ( DB_GET_ELEMS_DONE_SIG == e->sig && ERR_NONE == me->errorCode ) {
+                me->payloadMsgUnion.dbElemsPayload._dataBuf_len = pList->dataLen;
+                MEMCPY(
+                    me->payloadMsgUnion.dbElemsPayload._dataBuf,
+                    pList->dataBuf,
+                    me->payloadMsgUnion.dbElemsPayload._dataBuf_len
+                );
+            } else {
+                me->payloadMsgUnion.dbElemsPayload._dataBuf_len = 0;
+            }
+            status_ = Q_TRAN(&CommMgr_Idle);
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&CommMgr_Busy);
+            break;
+        }
+    }
+    return status_;
+}
+
+/**
+ * @brief    State that waits for a response from FlashMgr AO.
+ *
+ * @param  [in|out] me: Pointer to the state machine
+ * @param  [in|out]  e:  Pointer to the event being processed.
+ * @return status: QState type that specifies where the state
+ * machine is going next.
+ */
+/*${AOs::CommMgr::SM::Active::Busy::WaitForRespFromF~} .....................*/
+static QState CommMgr_WaitForRespFromFlashMgr(CommMgr * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        /* ${AOs::CommMgr::SM::Active::Busy::WaitForRespFromF~} */
+        case Q_ENTRY_SIG: {
+            QTimeEvt_rearm(                                       /* Re-arm timer on entry */
+                &me->commOpTimerEvt,
+                SEC_TO_TICKS( LL_MAX_TOUT_SEC_COMM_MSG_FLASH_OP )
+            );
+
+            me->errorCode = ERR_COMM_FLASHMGR_TIMEOUT; /* Set the error in case we timeout */
+            status_ = Q_HANDLED();
+            break;
+        }
+        /* ${AOs::CommMgr::SM::Active::Busy::WaitForRespFromF~} */
+        case Q_EXIT_SIG: {
+            QTimeEvt_disarm(&me->commOpTimerEvt);                  /* Disarm timer on exit */
+
+            /* Only print error if something went wrong */
+            ERR_COND_OUTPUT(
+                me->errorCode,
+                _DC3_ACCESS_QPC,
+                "Leaving WaitForRespFromFlashMgr state with error 0x%08x\n",
+                me->errorCode
+            );
+            status_ = Q_HANDLED();
+            break;
+        }
+        /* ${AOs::CommMgr::SM::Active::Busy::WaitForRespFromF~::FLASH_OP_DONE} */
+        case FLASH_OP_DONE_SIG: {
+            me->errorCode = ((FlashStatusEvt const *)e)->errorCode;
+            if (_DC3FlashMetaPayloadMsg == me->msgPayloadName) {
+                /* Start of a FW upgrade: let the client know which packet to (re)start from */
+                me->payloadMsgUnion.flashMetaPayload._errorCode      = me->errorCode;
+                me->payloadMsgUnion.flashMetaPayload._imageResumeSeq = ((FlashStatusEvt const *)e)->seqCurr;
+            } else {
+                me->payloadMsgUnion.statusPayload._errorCode = me->errorCode;
+            }
+            status_ = Q_TRAN(&CommMgr_Idle);
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&CommMgr_Busy);
+            break;
+        }
+    }
+    return status_;
+}
+
+/**
+ * @brief    State that streams a range of memory back to the client.
+ * Every frame is sent as a Prog msg but only while the client has credits left
+ * for it.  The client hands out more credits (or aborts the read) by sending
+ * more DC3MemReadMsg Req msgs with the same msgID while this state is running.
+ *
+ * @param  [in|out] me: Pointer to the state machine
+ * @param  [in|out]  e:  Pointer to the event being processed.
+ * @return status: QState type that specifies where the state
+ * machine is going next.
+ */
+/*${AOs::CommMgr::SM::Active::Busy::StreamMem} .............................*/
+static QState CommMgr_StreamMem(CommMgr * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        /* ${AOs::CommMgr::SM::Active::Busy::StreamMem} */
+        case Q_ENTRY_SIG: {
+            QTimeEvt_rearm(                                       /* Re-arm timer on entry */
+                &me->commOpTimerEvt,
+                SEC_TO_TICKS( LL_MAX_TOUT_SEC_COMM_MEM_READ_CREDIT )
+            );
+
+            me->errorCode = ERR_NONE;
+
+            /* Each frame is sent from its own event so the msgs with more credits from the client
+             * can get processed in between frames. */
+            QEvt *evt = Q_NEW(QEvt, MEM_READ_NEXT_SIG);
+            QACTIVE_POST(AO_CommMgr, (QEvt *)(evt), AO_CommMgr);
+            status_ = Q_HANDLED();
+            break;
+        }
+        /* ${AOs::CommMgr::SM::Active::Busy::StreamMem} */
+        case Q_EXIT_SIG: {
+            QTimeEvt_disarm(&me->commOpTimerEvt);                  /* Disarm timer on exit */
+
+            /* Let the client know how much of the requested memory made it out */
+            me->payloadMsgUnion.memDataPayload._errorCode   = me->errorCode;
+            me->payloadMsgUnion.memDataPayload._memSpace    = me->memReadSpace;
+            me->payloadMsgUnion.memDataPayload._offset      = me->memReadOffsetStart;
+            me->payloadMsgUnion.memDataPayload._length      = me->memReadOffsetCurr - me->memReadOffsetStart;
+            me->payloadMsgUnion.memDataPayload._seqCurr     = me->memReadSeqCurr;
+            me->payloadMsgUnion.memDataPayload._credits     = 0;
+            me->payloadMsgUnion.memDataPayload._dataCrc     = 0;
+            me->payloadMsgUnion.memDataPayload._dataBuf_len = 0;
+
+            /* Only print error if something went wrong */
+            ERR_COND_OUTPUT(
+                me->errorCode,
+                _DC3_ACCESS_QPC,
+                "Leaving StreamMem state with error 0x%08x\n",
+                me->errorCode
+            );
+            status_ = Q_HANDLED();
+            break;
+        }
+        /* ${AOs::CommMgr::SM::Active::Busy::StreamMem::MEM_READ_NEXT} */
+        case MEM_READ_NEXT_SIG: {
+            if ( ERR_NONE == me->errorCode && me->memReadCredits > 0 &&
+                 me->memReadOffsetCurr < me->memReadOffsetEnd ) {
+                uint32_t frameBuf[DC3_MEM_READ_FRAME_LEN / 4];     /* Keep SDRAM reads word aligned */
+                uint16_t frameLen = DC3_MEM_READ_FRAME_LEN;
+                if ( me->memReadOffsetEnd - me->memReadOffsetCurr < frameLen ) {
+                    frameLen = (uint16_t)(me->memReadOffsetEnd - me->memReadOffsetCurr);
+                }
+
+                me->errorCode = Comm_readMem( me->memReadSpace, me->memReadOffsetCurr, frameLen, frameBuf );
+                if ( ERR_NONE == me->errorCode ) {
+                    me->memReadSeqCurr++;
+                    me->payloadMsgUnion.memDataPayload._errorCode   = ERR_NONE;
+                    me->payloadMsgUnion.memDataPayload._memSpace    = me->memReadSpace;
+                    me->payloadMsgUnion.memDataPayload._offset      = me->memReadOffsetCurr;
+                    me->payloadMsgUnion.memDataPayload._length      = frameLen;
+                    me->payloadMsgUnion.memDataPayload._seqCurr     = me->memReadSeqCurr;
+                    me->payloadMsgUnion.memDataPayload._credits     = 0;
+                    me->payloadMsgUnion.memDataPayload._dataBuf_len = frameLen;
+                    MEMCPY( me->payloadMsgUnion.memDataPayload._dataBuf, frameBuf, frameLen );
+                    CRC_ResetDR();
+                    me->payloadMsgUnion.memDataPayload._dataCrc = CRC32_Calc( (uint8_t *)frameBuf, frameLen );
+
+                    /* The data goes out as Prog msgs regardless of whether the client asked for them */
+                    me->basicMsg._msgType    = _DC3_Prog;
+                    me->basicMsg._msgRoute   = me->msgRoute;
+                    me->basicMsg._msgID      = me->msgId;
+                    me->basicMsg._msgReqProg = (unsigned long)me->msgReqProg;
+
+                    LrgDataEvt *evt = Q_NEW(LrgDataEvt, CLI_SEND_DATA_SIG);
+                    /* The src and dst are swapped on purpose since we have to tell the message to go
+                     * to where it originally came from. */
+                    evt->dst = me->cliEvtSrc;
+                    evt->src = me->cliEvtDst;
+                    evt->session = me->cliEvtSession;
+                    evt->dataLen = DC3BasicMsg_write_delimited_to(&(me->basicMsg), evt->dataBuf, 0);
+                    evt->dataLen = DC3MemDataPayloadMsg_write_delimited_to(
+                        (void*)&(me->payloadMsgUnion.memDataPayload),
+                        evt->dataBuf,
+                        evt->dataLen
+                    );
+                    me->errorCode = Comm_sendToClient( evt );
+
+                    me->memReadOffsetCurr += frameLen;
+                    me->memReadCredits--;
+                }
+            }
+            /* ${AOs::CommMgr::SM::Active::Busy::StreamMem::MEM_READ_NEXT::[Failed?]} */
+            if (ERR_NONE != me->errorCode) {
+                status_ = Q_TRAN(&CommMgr_Idle);
+            }
+            /* ${AOs::CommMgr::SM::Active::Busy::StreamMem::MEM_READ_NEXT::[Done?]} */
+            else if (me->memReadOffsetCurr >= me->memReadOffsetEnd) {
+                status_ = Q_TRAN(&CommMgr_Idle);
+            }
+            /* ${AOs::CommMgr::SM::Active::Busy::StreamMem::MEM_READ_NEXT::[else]} */
+            else {
+                /* Keep going as long as the client has room.  Otherwise, wait for more credits. */
+                if ( me->memReadCredits > 0 ) {
+                    QEvt *evt = Q_NEW(QEvt, MEM_READ_NEXT_SIG);
+                    QACTIVE_POST(AO_CommMgr, (QEvt *)(evt), AO_CommMgr);
+                }
+                status_ = Q_HANDLED();
+            }
+            break;
+        }
+        /* ${AOs::CommMgr::SM::Active::Busy::StreamMem::COMM_OP_TIMEOUT} */
+        case COMM_OP_TIMEOUT_SIG: {
+            me->errorCode = ERR_COMM_MEM_READ_CREDIT_TIMEOUT;
+            ERR_printf("No credits from client for %d sec after sending frame %d. Error: 0x%08x\n",
+                (int)LL_MAX_TOUT_SEC_COMM_MEM_READ_CREDIT, me->memReadSeqCurr, me->errorCode);
+            status_ = Q_TRAN(&CommMgr_Idle);
+            break;
+        }
+        /* ${AOs::CommMgr::SM::Active::Busy::StreamMem::CLI_RECEIVED} */
+        case CLI_RECEIVED_SIG: {
+            /* Use a local basicMsg since the one in me is still needed for the frames and the Done */
+            struct DC3BasicMsg basicMsg;
+            memset(&basicMsg, 0, sizeof(basicMsg));
+            uint16_t basicMsgOffset = DC3BasicMsg_read_delimited_from(
+                (void*)((LrgDataEvt const *) e)->dataBuf,
+                &basicMsg,
+                0
+            );
+
+            /* The only msgs handled while streaming are more credits for this same read.
+             * MsgIDs are only unique per client so the credits have to come from the same
+             * one. */
+            if ( _DC3MemReadMsg == basicMsg._msgName && me->msgId == basicMsg._msgID &&
+                 me->cliEvtSrc == ((LrgDataEvt const *)e)->src &&
+                 me->cliEvtSession == ((LrgDataEvt const *)e)->session &&
+                 _DC3MemDataPayloadMsg == basicMsg._msgPayload ) {
+                struct DC3MemDataPayloadMsg creditPayload;
+                memset(&creditPayload, 0, sizeof(creditPayload));
+                DC3MemDataPayloadMsg_read_delimited_from(
+                    ((LrgDataEvt *) e)->dataBuf,
+                    &creditPayload,
+                    basicMsgOffset
+                );
+
+                bool bStalled = (0 == me->memReadCredits);
+                if ( 0 == creditPayload._length ) {
+                    me->errorCode = ERR_COMM_MEM_READ_ABORTED;
+                    WRN_printf("Client aborted memory read after frame %d\n", me->memReadSeqCurr);
+                } else {
+                    me->memReadCredits += creditPayload._credits;
+                    if ( me->memReadCredits > DC3_MEM_READ_MAX_CREDITS ) {
+                        me->memReadCredits = DC3_MEM_READ_MAX_CREDITS;
+                    }
+                }
+
+                /* The client is still there so give it more time */
+                QTimeEvt_rearm(
+                    &me->commOpTimerEvt,
+                    SEC_TO_TICKS( LL_MAX_TOUT_SEC_COMM_MEM_READ_CREDIT )
+                );
+                QTimeEvt_rearm(
+                    &me->commMgrTimerEvt,
+                    SEC_TO_TICKS( HL_MAX_TOUT_SEC_COMM_MSG_PROCESS )
+                );
+
+                /* A MEM_READ_NEXT is already on its way unless we ran out of credits */
+                if ( bStalled ) {
+                    QEvt *evt = Q_NEW(QEvt, MEM_READ_NEXT_SIG);
+                    QACTIVE_POST(AO_CommMgr, (QEvt *)(evt), AO_CommMgr);
+                }
+
+                /* Credits never get a Done of their own */
+                ETH_msgDone(
+                    ((LrgDataEvt const *)e)->src,
+                    ((LrgDataEvt const *)e)->session
+                );
+            } else {
+                /* Anything else gets handled once the read is done */
+                if (QEQueue_getNFree(&me->deferredEvtQueue) > 0) {
+                   QActive_defer((QActive *)me, &me->deferredEvtQueue, e);
+                } else {
+                   ERR_printf("Unable to defer %s (%d) msg, dropping it\n",
+                       CON_msgNameToStr(basicMsg._msgName), basicMsg._msgName);
+                   ETH_msgDone(
+                       ((LrgDataEvt const *)e)->src,
+                       ((LrgDataEvt const *)e)->session
+                   );
+                }
+            }
+            status_ = Q_HANDLED();
+            break;
+        }
         default: {
             status_ = Q_SUPER(&CommMgr_Busy);
             break;
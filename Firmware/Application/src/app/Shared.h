@@ -33,6 +33,8 @@
 enum AO_Priorities {
    NEVER_USE_ZERO_PRIORITY = 0,   /**< Never use this.  It breaks everything. */
 
+   FLASH_MGR_PRIORITY,  /**< Priority of FlashMgr AO.  Lowest since flash erase
+                             and CRC of the staged image block for a while. */
    SYS_MGR_PRIORITY,                             /**< Priority of MenuMgr AO. */
    COMM_MGR_PRIORITY,                       /**< Priority of CommStackMgr AO. */
 
@@ -49,6 +51,9 @@ enum AO_Priorities {
     * all together since there's a loop that iterates through them and will
     * take up the next priority if one is not added here.  You will end up with
     * clashing priorities for your AOs.*/
+   SPIBUS5MGR_PRIORITY,                        /**< Priority of SPIBusMgr AO. */
+   /* Same as with the I2C busses, all the SPI bus priorities have to be kept
+    * together since there's a loop that starts them. */
 
    ETH_PRIORITY,       /**< Priority of LWIP AO which handles ethernet comms. */
 };
@@ -17,6 +17,8 @@
 #include "cplr.h"
 #include "LWIPMgr.h"
 #include "i2c_frt.h"                                 /* For I2C functionality */
+#include "nor.h"                                       /* For NOR flash access */
+#include "crc32compat.h"                                   /* For CRC32_Calc() */
 
 /* Compile-time called macros ------------------------------------------------*/
 Q_DEFINE_THIS_FILE                  /* For QSPY to know the name of this file */
@@ -29,6 +31,19 @@ DBG_DEFINE_THIS_MODULE( DC3_DBG_MODL_CPLR );/* For debug system to ID this modul
 QEQueue CPLR_evtQueue;         /**< raw queue to talk between FreeRTOS and QP */
 
 TaskHandle_t xHandle_CPLR;                       /**< Handle to the CPLR task */
+
+NorLog_t CPLR_norLog;             /**< Log store in the upper half of the NOR */
+
+/** Where the NOR log store lives and how to get to it */
+static const NorLogCfg_t l_norLogCfg = {
+   NOR_ReadBytes,
+   NOR_WriteBytes,
+   NOR_EraseBlock,
+   CRC32_Calc,
+   NOR_LOG_START_ADDR,
+   NOR_BLOCK_SIZE,
+   NOR_LOG_N_BLOCKS
+};
 /* Private function prototypes -----------------------------------------------*/
 /* Private functions ---------------------------------------------------------*/
 
@@ -48,6 +63,17 @@ void CPLR_Task( void* pvParameters )
                                      to something other than ERR_NONE, it will
                                      be printed out at the end of the for loop*/
 
+   /* Rebuild the index of the NOR log store.  This only reads the record
+    * headers so it's fast enough to do before processing any events. */
+   status = NOR_LOG_init( &CPLR_norLog, &l_norLogCfg );
+   ERR_COND_OUTPUT(
+         status,
+         _DC3_ACCESS_FRT,
+         "Error 0x%08x initializing NOR log store\n",
+         status
+   );
+   status = ERR_NONE;
+
    for (;;) {                         /* Beginning of the thread forever loop */
       /* Check if there's data in the queue and process it if there. */
 
@@ -157,6 +183,17 @@ CPLR_Task_ERR_HANDLE:             /* Handle any error that may have occurred. */
                         processing the event.  After this, any data to which
                         this pointer points to may not be valid and should not
                         be referenced. */
+      } else if ( NOR_LOG_isGcNeeded( &CPLR_norLog ) ) {
+         /* Nothing else to do so reclaim one NOR block in the background.
+          * Erases are slow so do at most one per pass. */
+         status = NOR_LOG_gcStep( &CPLR_norLog );
+         ERR_COND_OUTPUT(
+               status,
+               _DC3_ACCESS_FRT,
+               "Error 0x%08x collecting NOR log store\n",
+               status
+         );
+         status = ERR_NONE;
       }
 
 //      vTaskSuspend(NULL);
@@ -20,12 +20,14 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "qequeue.h"                             /* For QE "raw" event queues */
+#include "nor_log.h"                                   /* For NOR log store */
 
 /* Exported defines ----------------------------------------------------------*/
 /* Exported macros -----------------------------------------------------------*/
 /* Exported types ------------------------------------------------------------*/
 extern QEQueue CPLR_evtQueue; /**< Global raw queue to talk between FreeRTOS and QP */
 extern TaskHandle_t xHandle_CPLR; /**< Globally accessible handle to the CPLR task */
+extern NorLog_t CPLR_norLog; /**< NOR log store.  Only use from the CPLR task */
 /* Exported constants --------------------------------------------------------*/
 /* Exported functions --------------------------------------------------------*/
 
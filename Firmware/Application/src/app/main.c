@@ -17,8 +17,10 @@
 #include "SerialMgr.h"                           /* for starting SerialMgr AO */
 #include "I2CBusMgr.h"                           /* for starting I2CBusMgr AO */
 #include "I2C1DevMgr.h"                         /* for starting I2C1DevMgr AO */
+#include "SPIBusMgr.h"                           /* for starting SPIBusMgr AO */
 #include "cplr.h"                               /* for starting the CPLR task */
 #include "SysMgr.h"                                 /* for starting SysMgr AO */
+#include "FlashMgr.h"                             /* for starting FlashMgr AO */
 
 #include "project_includes.h"           /* Includes common to entire project. */
 #include "Shared.h"
@@ -29,6 +31,10 @@
 #include "bsp_defs.h"
 #include "bsp.h"
 #include "db.h"                                       /* for settings support */
+#include "dma_mem.h"                            /* for memory DMA event types */
+#include "ao_prof.h"                              /* for AO dispatch profiling */
+#include "mem_stats.h"                            /* for pool and queue usage */
+#include "cpu_load.h"                                   /* for CPU load stats */
 
 /* Compile-time called macros ------------------------------------------------*/
 Q_DEFINE_THIS_FILE                  /* For QSPY to know the name of this file */
@@ -45,8 +51,10 @@ static QEvt const    *l_CommMgrQueueSto[30];        /**< Storage for CommStackMg
 static QEvt const    *l_LWIPMgrQueueSto[200];       /**< Storage for LWIPMgr event Queue */
 static QEvt const    *l_SerialMgrQueueSto[200];     /**< Storage for SerialMgr event Queue */
 static QEvt const    *l_I2CBusMgrQueueSto[30][MAX_I2C_BUS];    /**< Storage for I2CBusMgr event Queue */
+static QEvt const    *l_SPIBusMgrQueueSto[MAX_SPI_BUS][30];    /**< Storage for SPIBusMgr event Queue */
 static QEvt const    *l_I2C1DevMgrQueueSto[30];     /**< Storage for I2C1DevMgr event Queue */
 static QEvt const    *l_SysMgrQueueSto[10];           /**< Storage for SysMgr event Queue */
+static QEvt const    *l_FlashMgrQueueSto[30];       /**< Storage for FlashMgr event Queue */
 static QSubscrList   l_subscrSto[MAX_PUB_SIG];      /**< Storage for subscribe/publish event Queue */
 
 static QEvt const    *l_CPLRQueueSto[10]; /**< Storage for raw QE queue for communicating with CPLR task */
@@ -72,6 +80,8 @@ static union SmallEvents {
    uint8_t e5[sizeof(I2CReadMemReqEvt)];
    uint8_t e6[sizeof(DBWriteDoneEvt)];
    uint8_t e7[sizeof(DBReadReqEvt)];
+   uint8_t e8[sizeof(FlashStatusEvt)];
+   uint8_t e9[sizeof(DMAMemDoneEvt)];
 } l_smlPoolSto[50];                     /* storage for the small event pool */
 
 /**
@@ -84,6 +94,7 @@ static union MediumEvents {
    uint8_t e2[sizeof(I2CReadDoneEvt)];
    uint8_t e3[sizeof(DBWriteReqEvt)];
    uint8_t e4[sizeof(DBReadDoneEvt)];
+   uint8_t e5[sizeof(FWMetaEvt)];
 } l_medPoolSto[10];                    /* storage for the medium event pool */
 
 /**
@@ -94,6 +105,10 @@ static union LargeEvents {
    void   *e0;                                       /* minimum event size */
    uint8_t e1[sizeof(EthEvt)];
    uint8_t e2[sizeof(LrgDataEvt)];
+   uint8_t e3[sizeof(FWDataEvt)];
+   uint8_t e4[sizeof(DBElemsEvt)];
+   uint8_t e5[sizeof(SPIXferReqEvt)];
+   uint8_t e6[sizeof(SPIXferDoneEvt)];
 } l_lrgPoolSto[100];                    /* storage for the large event pool */
 
 
@@ -111,6 +126,10 @@ int main(void)
     */
 
 
+   /* Fill the main stack before anything gets a chance to use it.  After the
+    * scheduler starts only the ISRs run on it. */
+   MEM_STATS_paintMainStack();
+
    /* Enable debugging for select modules - Note: this has no effect in rel
     * builds since all DBG level logging is disabled and only LOG and up msgs
     * will get printed. */
@@ -135,13 +154,32 @@ int main(void)
       I2CBusMgr_ctor( i );      /* Start this instance of AO for this bus. */
    }
 
+   /* Same for the SPI busses and the SPIBusMgr AO. */
+   for( uint8_t i = 0; i < MAX_SPI_BUS; ++i ) {
+      SPIBusMgr_ctor( i );      /* Start this instance of AO for this bus. */
+   }
+
    I2C1DevMgr_ctor();
    CommMgr_ctor();
+   FlashMgr_ctor();
    SysMgr_ctor();
 
    dbg_slow_printf("Initializing QF\n");
    QF_init();       /* initialize the framework and the underlying RT kernel */
 
+   /* Has to run before any AO is started since their first post gets timed */
+   AO_PROF_init();
+
+   /* Keep the breakdown of the second the CPLR task was busiest */
+   CPU_LOAD_init();
+   CPU_LOAD_setWatchPrio( CPLR_PRIORITY + tskIDLE_PRIORITY );
+
+   /* Start QS before any dictionary gets output, here or in the initial
+    * transitions of the AOs.  Does nothing unless built with Q_SPY. */
+   if ( !QS_INIT( (void *)0 ) ) {
+      Q_ERROR();
+   }
+
    /* object dictionaries... */
    dbg_slow_printf("Initializing object dictionaries for QSPY\n");
    QS_OBJ_DICTIONARY(l_smlPoolSto);
@@ -150,9 +188,11 @@ int main(void)
    QS_OBJ_DICTIONARY(l_SerialMgrQueueSto);
    QS_OBJ_DICTIONARY(l_LWIPMgrQueueSto);
    QS_OBJ_DICTIONARY(l_I2CBusMgrQueueSto);
+   QS_OBJ_DICTIONARY(l_SPIBusMgrQueueSto);
    QS_OBJ_DICTIONARY(l_I2C1DevMgrQueueSto);
    QS_OBJ_DICTIONARY(l_CommMgrQueueSto);
    QS_OBJ_DICTIONARY(l_SysMgrQueueSto);
+   QS_OBJ_DICTIONARY(l_FlashMgrQueueSto);
 
    QF_psInit(l_subscrSto, Q_DIM(l_subscrSto));     /* init publish-subscribe */
 
@@ -164,6 +204,7 @@ int main(void)
          sizeof(l_memPoolSto),
          DC3_MAX_MEM_BLK_SIZE
    );
+   MEM_STATS_regPool( p_glbMemPool, "glbMemPool" );
 
    /* initialize event pools... */
    dbg_slow_printf("Initializing event storage pools\n");
@@ -173,9 +214,11 @@ int main(void)
 
    /* initialize the raw queues */
    QEQueue_init(&CPLR_evtQueue, l_CPLRQueueSto, Q_DIM(l_CPLRQueueSto));
+   MEM_STATS_regQueue( &CPLR_evtQueue, "CPLR" );
 
    /* Start Active objects */
    dbg_slow_printf("Starting Active Objects\n");
+   MEM_STATS_setAoStackSize( THREAD_STACK_SIZE );
 
    QACTIVE_START(AO_SerialMgr,
          SERIAL_MGR_PRIORITY,                                    /* priority */
@@ -208,6 +251,17 @@ int main(void)
       );
    }
 
+   /* Same for the SPI busses.  Same WARNING applies. */
+   for( uint8_t i = 0; i < MAX_SPI_BUS; ++i ) {
+      QACTIVE_START(AO_SPIBusMgr[i],
+            SPIBUS5MGR_PRIORITY + i,                                /* priority */
+            l_SPIBusMgrQueueSto[i], Q_DIM(l_SPIBusMgrQueueSto[i]), /* evt queue */
+            (void *)0, THREAD_STACK_SIZE,              /* per-thread stack size */
+            (QEvt *)0,                               /* no initialization event */
+            "SPIBusMgr"                                     /* Name of the task */
+      );
+   }
+
    QACTIVE_START(AO_I2C1DevMgr,
          I2C1DEVMGR_PRIORITY,                                    /* priority */
          l_I2C1DevMgrQueueSto, Q_DIM(l_I2C1DevMgrQueueSto),     /* evt queue */
@@ -224,6 +278,8 @@ int main(void)
          CPLR_PRIORITY,                                          /* priority */
          ( xTaskHandle * ) &xHandle_CPLR                      /* Task handle */
    );
+   /* xTaskCreate() takes words, not bytes like QACTIVE_START() */
+   MEM_STATS_regTask( xHandle_CPLR, THREAD_STACK_SIZE * sizeof(StackType_t) );
 
    QACTIVE_START(AO_CommMgr,
          COMM_MGR_PRIORITY,                                      /* priority */
@@ -241,6 +297,14 @@ int main(void)
          "SysMgr"                                        /* Name of the task */
    );
 
+   QACTIVE_START(AO_FlashMgr,
+         FLASH_MGR_PRIORITY,                                     /* priority */
+         l_FlashMgrQueueSto, Q_DIM(l_FlashMgrQueueSto),         /* evt queue */
+         (void *)0, THREAD_STACK_SIZE,              /* per-thread stack size */
+         (QEvt *)0,                               /* no initialization event */
+         "FlashMgr"                                      /* Name of the task */
+   );
+
    log_slow_printf("Starting QPC. All logging from here on out shouldn't show 'SLOW'!!!\n\n");
    QF_run();                                       /* run the QF application */
 
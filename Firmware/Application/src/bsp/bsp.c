@@ -26,8 +26,11 @@
 #include "serial.h"
 #include "nor.h"                               /* M29WV128G NOR Flash support */
 #include "sdram.h"                          /* MT48LC2M3B2B5-7E SDRAM support */
+#include "dma_mem.h"                          /* Memory-to-memory DMA support */
 #include "projdefs.h"                          /* FreeRTOS base types support */
 #include "task.h"
+#include "cpu_load.h"                                    /* For CPU load */
+#include "qs_udp.h"                                /* QS trace output over UDP */
 
 /* Compile-time called macros ------------------------------------------------*/
 Q_DEFINE_THIS_FILE                  /* For QSPY to know the name of this file */
@@ -43,11 +46,9 @@ __IO uint32_t TS_Pressed;
 
 #ifdef Q_SPY
 static uint8_t  l_SysTick_Handler;
-QSTimeCtr QS_tickTime_;
-QSTimeCtr QS_tickPeriod_;
 
-
-#define QS_BUF_SIZE   (2*1024)
+/* Has to hold all the dictionaries from startup until a host connects */
+#define QS_BUF_SIZE   (4*1024)
 #define QS_BAUD_RATE  115200
 
 #endif
@@ -110,7 +111,10 @@ void BSP_init( void )
    SDRAM_Init();
     */
 
-   /* 7. Initialize the touchscreen */
+   /* 7. Initialize the memory-to-memory DMA */
+   DMA_MEM_init();
+
+   /* 8. Initialize the touchscreen */
 //   dbg_slow_printf("Starting initializing touch screen\n");
 //   BSP_TSC_Init();
 //   dbg_slow_printf("Finished initializing touch screen\n");
@@ -296,59 +300,8 @@ uint8_t QS_onStartup(void const *arg) {
    static uint8_t qsBuf[QS_BUF_SIZE];            /* buffer for Quantum Spy */
    QS_initBuf(qsBuf, sizeof(qsBuf));
 
-   /* USART3 and GPIOA/AFIO clocks are already enabled by this point */
-
-
-   QS_tickPeriod_ = (QSTimeCtr)(SystemCoreClock / BSP_TICKS_PER_SEC);
-   QS_tickTime_ = QS_tickPeriod_;        /* to start the timestamp at zero */
-
-   /* setup the QS filters... */
-   QS_FILTER_ON(QS_ALL_RECORDS);
-
-   //    QS_FILTER_OFF(QS_QEP_STATE_EMPTY);
-   //    QS_FILTER_OFF(QS_QEP_STATE_ENTRY);
-   //    QS_FILTER_OFF(QS_QEP_STATE_EXIT);
-   //    QS_FILTER_OFF(QS_QEP_STATE_INIT);
-   //    QS_FILTER_OFF(QS_QEP_INIT_TRAN);
-   //    QS_FILTER_OFF(QS_QEP_INTERN_TRAN);
-   //    QS_FILTER_OFF(QS_QEP_TRAN);
-   //    QS_FILTER_OFF(QS_QEP_IGNORED);
-
-   QS_FILTER_OFF(QS_QF_ACTIVE_ADD);
-   QS_FILTER_OFF(QS_QF_ACTIVE_REMOVE);
-   QS_FILTER_OFF(QS_QF_ACTIVE_SUBSCRIBE);
-   QS_FILTER_OFF(QS_QF_ACTIVE_UNSUBSCRIBE);
-   QS_FILTER_OFF(QS_QF_ACTIVE_POST_FIFO);
-   QS_FILTER_OFF(QS_QF_ACTIVE_POST_LIFO);
-   QS_FILTER_OFF(QS_QF_ACTIVE_GET);
-   QS_FILTER_OFF(QS_QF_ACTIVE_GET_LAST);
-   QS_FILTER_OFF(QS_QF_EQUEUE_INIT);
-   QS_FILTER_OFF(QS_QF_EQUEUE_POST_FIFO);
-   QS_FILTER_OFF(QS_QF_EQUEUE_POST_LIFO);
-   QS_FILTER_OFF(QS_QF_EQUEUE_GET);
-   QS_FILTER_OFF(QS_QF_EQUEUE_GET_LAST);
-   QS_FILTER_OFF(QS_QF_MPOOL_INIT);
-   QS_FILTER_OFF(QS_QF_MPOOL_GET);
-   QS_FILTER_OFF(QS_QF_MPOOL_PUT);
-   QS_FILTER_OFF(QS_QF_PUBLISH);
-   QS_FILTER_OFF(QS_QF_NEW);
-   QS_FILTER_OFF(QS_QF_GC_ATTEMPT);
-   QS_FILTER_OFF(QS_QF_GC);
-   //    QS_FILTER_OFF(QS_QF_TICK);
-   QS_FILTER_OFF(QS_QF_TIMEEVT_ARM);
-   QS_FILTER_OFF(QS_QF_TIMEEVT_AUTO_DISARM);
-   QS_FILTER_OFF(QS_QF_TIMEEVT_DISARM_ATTEMPT);
-   QS_FILTER_OFF(QS_QF_TIMEEVT_DISARM);
-   QS_FILTER_OFF(QS_QF_TIMEEVT_REARM);
-   QS_FILTER_OFF(QS_QF_TIMEEVT_POST);
-   QS_FILTER_OFF(QS_QF_CRIT_ENTRY);
-   QS_FILTER_OFF(QS_QF_CRIT_EXIT);
-   QS_FILTER_OFF(QS_QF_ISR_ENTRY);
-   QS_FILTER_OFF(QS_QF_ISR_EXIT);
-
-   //    QS_FILTER_OFF(QS_QK_MUTEX_LOCK);
-   //    QS_FILTER_OFF(QS_QK_MUTEX_UNLOCK);
-   QS_FILTER_OFF(QS_QK_SCHEDULE);
+   /* Only the dictionaries until a host connects to collect the trace */
+   QS_UDP_setFilters( false );
 
    return (uint8_t)1;                                    /* return success */
 }
@@ -378,15 +331,10 @@ void QS_onCleanup(void) {
  * @note 1: this function only exists on QSPY builds.
  *
  * @param   None
- * @return  tickTime: QSTimeCtr time structure (in BSP ticks).
+ * @return  QSTimeCtr: low 32 bits of the TIME_getTimestamp() in us.
  */
 QSTimeCtr QS_onGetTime(void) {            /* invoked with interrupts locked */
-   if ((SysTick->CTRL & 0x00010000) == 0) {               /* COUNT no set? */
-      return QS_tickTime_ - (QSTimeCtr)SysTick->VAL;
-   }
-   else {     /* the rollover occured, but the SysTick_ISR did not run yet */
-      return QS_tickTime_ + QS_tickPeriod_ - (QSTimeCtr)SysTick->VAL;
-   }
+   return (QSTimeCtr)TIME_getTimestamp();       /* us, wraps every ~71 min */
 }
 
 /******************************************************************************/
@@ -447,12 +395,8 @@ void vApplicationTickHook(void)
 
    QF_ISR_ENTRY(intStat);                        /* inform QF about ISR entry */
 
-#ifdef Q_SPY
-   {
-      uint32_t dummy = SysTick->CTRL; /* clear SysTick_CTRL_COUNTFLAG */
-      QS_tickTime_ += QS_tickPeriod_; /* account for the clock rollover */
-   }
-#endif
+   CPU_LOAD_onTick();                        /* close the CPU load window */
+   TIME_onTick();                         /* tie the timestamps to the RTC */
 
    QF_TICK_X(0U, &l_SysTick_Handler);  /* process all armed time events */
 
@@ -475,6 +419,10 @@ void vApplicationTickHook(void)
  *
  * This function can also be used to visualize idle activity.
  *
+ * @note: the time spent here is the idle share of the CPU load (see
+ * cpu_load.h).  It isn't counted directly since the cycle counter stops in
+ * __WFI().  It's what's left after all the other tasks are counted.
+ *
  * @param   None
  * @return  None
  */
@@ -482,17 +430,8 @@ void vApplicationIdleHook( void )
 {
 #ifdef Q_SPY
 
-   if ((USART1->SR & USART_FLAG_TXE) != 0) {              /* is TXE empty? */
-      uint16_t b;
-
-      QF_INT_DISABLE();
-      b = QS_getByte();
-      QF_INT_ENABLE();
-
-      if (b != QS_EOD) {                              /* not End-Of-Data? */
-         USART1->DR = (b & 0xFF);             /* put into the DR register */
-      }
-   }
+   /* USART1 is the debug console so the trace goes out over ethernet */
+   QS_UDP_onIdle();
 
 #elif defined NDEBUG
    __WFI();                                          /* wait for interrupt */
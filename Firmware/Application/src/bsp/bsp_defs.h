@@ -104,6 +104,9 @@ Q_ASSERT_COMPILE(MAX_KERNEL_UNAWARE_CMSIS_PRI <= configLIBRARY_MAX_SYSCALL_INTER
 typedef enum KernelAwareISRs {   /* ISR priorities starting from the highest urgency */
 	SYSTICK_PRIO = configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY, /* see NOTE01 */
 	DMA2_Stream7_PRIO,
+	DMA2_Stream4_PRIO,
+	DMA2_Stream3_PRIO,
+	DMA2_Stream0_PRIO,
 	DMA1_Stream6_PRIO,
 	DMA1_Stream0_PRIO,
 	USART1_PRIO,
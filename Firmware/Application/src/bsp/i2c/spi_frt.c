@@ -0,0 +1,123 @@
+/**
+ * @file    spi_frt.c
+ * @brief   SPI bus interface for FreeRTOS.
+ *
+ * @date    10/19/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ *
+ * @addtogroup groupSPI
+ * @{
+ *
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "spi_frt.h"
+#include "qp_port.h"                                        /* for QP support */
+#include "project_includes.h"
+#include "Shared.h"
+#include "SPIBusMgr.h"                      /* For access to the SPIBusMgr AO */
+#include "cplr.h"
+#include "spi.h"
+
+/* Compile-time called macros ------------------------------------------------*/
+Q_DEFINE_THIS_FILE                  /* For QSPY to know the name of this file */
+DBG_DEFINE_THIS_MODULE( DC3_DBG_MODL_SPI ); /* For debug system to ID this module */
+
+/* Private typedefs ----------------------------------------------------------*/
+/* Private defines -----------------------------------------------------------*/
+/* Private macros ------------------------------------------------------------*/
+/* Private variables and Local objects ---------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+
+/******************************************************************************/
+const DC3Error_t SPI_xferFRT(
+      const SPI_Bus_t iBus,
+      const uint8_t flags,
+      const uint16_t len,
+      const uint16_t nBufferSize,
+      const uint8_t* const pTxBuffer,
+      uint8_t* const pRxBuffer,
+      uint16_t* pBytesXfered
+)
+{
+   DC3Error_t status = ERR_NONE; /* Keep track of the errors that may occur.
+                                     This gets returned at the end of the
+                                     function */
+   /* Check buffer sizes */
+   if( len > nBufferSize ) {
+      status = ERR_MEM_BUFFER_LEN;
+      goto SPI_xferFRT_ERR_HANDLER;        /* Stop and jump to error handling */
+   }
+
+   if ( NULL == pTxBuffer || NULL == pRxBuffer ) {
+      status = ERR_MEM_NULL_VALUE;
+      goto SPI_xferFRT_ERR_HANDLER;        /* Stop and jump to error handling */
+   }
+
+   /* Issue a non-blocking call to do the SPI transaction */
+   status = SPI_xfer(
+         _DC3_ACCESS_FRT,                             // const DC3AccessType_t accessType,
+         iBus,                                        // const SPI_Bus_t iBus,
+         flags,                                       // const uint8_t flags,
+         len,                                         // const uint16_t len,
+         nBufferSize,                                 // const uint16_t bufferSize,
+         pTxBuffer,                                   // const uint8_t* const pTxBuffer,
+         pRxBuffer,                                   // uint8_t* const pRxBuffer,
+         pBytesXfered                                 // uint16_t* pBytesXfered
+   );
+
+   if( ERR_NONE != status ) {
+      goto SPI_xferFRT_ERR_HANDLER;        /* Stop and jump to error handling */
+   }
+
+   /* Suspend the task.  Once something has been put into the queue, the AO that
+    * put it there, will wake up this task. */
+   DBG_printf("Suspending Task\n");
+   vTaskSuspend( xHandle_CPLR );
+   DBG_printf("Task resumed\n");
+
+   /* The task has been awakened by the SPIBusMgr AO because it has put an
+    * event into the raw queue */
+   QEvt const *evtSPIDone = QEQueue_get(&CPLR_evtQueue);
+   if (evtSPIDone != (QEvt *)0 ) {
+      LOG_printf("Found expected event in queue\n");
+      switch( evtSPIDone->sig ) {
+         case SPI_BUS_DONE_SIG:
+            DBG_printf("Got SPI_BUS_DONE_SIG\n");
+            *pBytesXfered = ((SPIXferDoneEvt *) evtSPIDone)->len;
+            status = ((SPIXferDoneEvt *) evtSPIDone)->status;
+            MEMCPY(pRxBuffer,
+                  ((SPIXferDoneEvt *) evtSPIDone)->dataBuf,
+                  *pBytesXfered
+            );
+            break;
+         default:
+            WRN_printf("Unknown signal %d\n", evtSPIDone->sig);
+            break;
+      }
+      QF_gc(evtSPIDone);         /* Don't forget to garbage collect the event */
+   } else {
+      WRN_printf("Expected event not found in queue\n");
+   }
+
+SPI_xferFRT_ERR_HANDLER:          /* Handle any error that may have occurred. */
+   ERR_COND_OUTPUT(
+         status,
+         _DC3_ACCESS_FRT,
+         "Error 0x%08x doing a %d byte transaction on %s\n",
+         status,
+         len,
+         CON_spiBusToStr( iBus )
+   );
+   return( status );
+}
+
+/**
+ * @}
+ * end addtogroup groupSPI
+ */
+
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
@@ -0,0 +1,84 @@
+/**
+ * @file    spi_frt.h
+ * @brief   SPI bus interface for FreeRTOS.
+ *
+ * @date    10/19/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ *
+ * @addtogroup groupSPI
+ * @{
+ *
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef SPI_FRT_H_
+#define SPI_FRT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f4xx.h"                                 /* For STM32F4 support */
+#include "spi_defs.h"
+#include "Shared.h"
+
+/* Exported defines ----------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+/* Exported macros -----------------------------------------------------------*/
+/* Exported constants --------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief   A blocking function to do an SPI transaction that should be called
+ * from FreeRTOS threads.
+ *
+ * This function sends an event to the SPIBusMgr AO for the bus to transceive
+ * the data and then suspends the calling task.  Once the AO is finished with
+ * the transaction, it will put an event with the received data (or error) into
+ * the raw queue and wake the task.  This function then resumes and retrieves
+ * the data out of the queue, fills in the appropriate buffers and status and
+ * returns.
+ *
+ * @param [in] iBus: SPI_Bus_t identifier for SPI bus
+ *    @arg SPIBus5: SPI bus 5
+ * @param [in] flags: uint8_t SPI_XFER_FLAG_xxx flags for the transaction.
+ *    @arg SPI_XFER_FLAG_NONE: select, transceive, release.
+ *    @arg SPI_XFER_FLAG_KEEP_CS: leave the chip selected so the next call
+ *    continues the same frame.
+ * @param [in] len: uint16_t how many bytes to transceive.  Can't be more than
+ *             MAX_SPI_XFER_LEN.
+ * @param [in] nBufferSize: size of storage pointed to by both *pTxBuffer and
+ *             *pRxBuffer.  Used for error checking.
+ * @param [in] *pTxBuffer: const uint8_t pointer to the data to send.
+ * @param [out] *pRxBuffer: uint8_t pointer to the buffer to store received
+ *             data.
+ * @param [out] *pBytesXfered: number of bytes transceived as returned from
+ *             the SPIBusMgr AO.
+ * @return DC3Error_t: status of the transaction
+ *    @arg ERR_NONE: if no errors occurred
+ */
+const DC3Error_t SPI_xferFRT(
+      const SPI_Bus_t iBus,
+      const uint8_t flags,
+      const uint16_t len,
+      const uint16_t nBufferSize,
+      const uint8_t* const pTxBuffer,
+      uint8_t* const pRxBuffer,
+      uint16_t* pBytesXfered
+);
+
+/**
+ * @}
+ * end addtogroup groupSPI
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif                                                          /* SPI_FRT_H_ */
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
@@ -316,6 +316,21 @@ DC3Error_t NOR_WriteBuffer(
 
 }
 
+/******************************************************************************/
+DC3Error_t NOR_WriteBytes(
+      uint32_t uwWriteAddress,
+      const uint8_t* pBuffer,
+      uint32_t uwLen
+)
+{
+   /* NOR_WriteBuffer() always writes at least one half-word */
+   if ( 0 == uwLen ) {
+      return( ERR_NONE );
+   }
+
+   return( NOR_WriteBuffer( (uint16_t *)pBuffer, uwWriteAddress, uwLen / 2 ) );
+}
+
 /******************************************************************************/
 uint16_t NOR_ReadHalfWord( uint32_t uwReadAddress )
 {
@@ -347,6 +362,17 @@ void NOR_ReadBuffer(
    }
 }
 
+/******************************************************************************/
+DC3Error_t NOR_ReadBytes(
+      uint32_t uwReadAddress,
+      uint8_t* pBuffer,
+      uint32_t uwLen
+)
+{
+   NOR_ReadBuffer( (uint16_t *)pBuffer, uwReadAddress, uwLen / 2 );
+   return( ERR_NONE );
+}
+
 /******************************************************************************/
 void NOR_ReturnToReadMode( void )
 {
@@ -27,6 +27,25 @@ extern "C" {
 #include "DC3Errors.h"
 
 /* Exported defines ----------------------------------------------------------*/
+
+/**
+  * @brief  FMC NOR Memory size (M29WV128G is 128 Mbit)
+  */
+#define NOR_MEM_SIZE        ((uint32_t)0x01000000)
+
+/**
+  * @brief  FMC NOR erase block size (M29WV128G has uniform 64 KWord blocks)
+  */
+#define NOR_BLOCK_SIZE      ((uint32_t)0x00020000)
+
+/**
+  * @brief  Where the log store lives in the NOR.  The lower half is left for
+  *         raw access and the destructive tests.
+  */
+#define NOR_LOG_START_ADDR  ((uint32_t)0x00800000)
+#define NOR_LOG_N_BLOCKS \
+   ((uint16_t)((NOR_MEM_SIZE - NOR_LOG_START_ADDR) / NOR_BLOCK_SIZE))
+
 /* Exported types ------------------------------------------------------------*/
 /**
   * @brief  FMC NOR ID typedef
@@ -127,6 +146,25 @@ DC3Error_t NOR_WriteBuffer(
       uint32_t uwBufferSize
 );
 
+/**
+ * @brief  Writes a buffer of bytes to the NOR memory.
+ *         Byte oriented wrapper around NOR_WriteBuffer().
+ * @param  [in] uwWriteAddress: uint32_t even NOR memory internal address to
+ *         write to.
+ * @param  [in] *pBuffer: const uint8_t pointer to buffer.
+ * @param  [in] uwLen: uint32_t even number of bytes to write.
+ * @retval DC3Error_t: The returned value can be:
+ *   @arg  ERR_NONE
+ *   @arg  ERR_NOR_ERROR
+ *   @arg  ERR_NOR_TIMEOUT
+ *   @arg  ERR_NOR_BUSY
+ */
+DC3Error_t NOR_WriteBytes(
+      uint32_t uwWriteAddress,
+      const uint8_t* pBuffer,
+      uint32_t uwLen
+);
+
 /**
  * @brief  Reads a half-word from the NOR memory.
  * @param  [in] uwReadAddress: uint32_t NOR memory internal address to read from.
@@ -148,6 +186,21 @@ void NOR_ReadBuffer(
       uint32_t uwBufferSize
 );
 
+/**
+ * @brief  Reads a buffer of bytes from the NOR memory.
+ *         Byte oriented wrapper around NOR_ReadBuffer().
+ * @param  [in] uwReadAddress: uint32_t even NOR memory internal address to read
+ *         from.
+ * @param  [out] *pBuffer: uint8_t pointer to the buffer that receives the data.
+ * @param  [in] uwLen: uint32_t even number of bytes to read.
+ * @retval DC3Error_t: always ERR_NONE.
+ */
+DC3Error_t NOR_ReadBytes(
+      uint32_t uwReadAddress,
+      uint8_t* pBuffer,
+      uint32_t uwLen
+);
+
 /**
  * @brief  Returns the NOR memory to Read mode.
  * @param  None
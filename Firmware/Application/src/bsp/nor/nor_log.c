@@ -0,0 +1,992 @@
+/**
+ * @file    nor_log.c
+ * @brief   Log structured key/record store on top of the NOR flash.
+ *
+ * See nor_log.h for the description.  Nothing in here is allowed to touch the
+ * hardware.  All flash access goes through the functions in NorLogCfg_t.
+ *
+ * Flash layout of an erase block:
+ *    NorLogBlkHdr_t: written right after the block is erased.
+ *    NorLogRecHdr_t + data, padded to 4 bytes: repeated until the block fills.
+ *    Erased flash: where the next record goes.
+ *
+ * @date    10/19/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ *
+ * @addtogroup groupNOR
+ * @{
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "nor_log.h"
+#include <stddef.h>
+#include <string.h>
+
+/* Compile-time called macros ------------------------------------------------*/
+/* Private typedefs ----------------------------------------------------------*/
+
+/**
+ * @brief   Header at the start of every formatted erase block.
+ */
+typedef struct {
+   uint32_t magic;                                     /**< NOR_LOG_BLK_MAGIC */
+   uint32_t eraseCnt;           /**< How many times the block has been erased */
+   uint32_t crc;                               /**< CRC of magic and eraseCnt */
+} NorLogBlkHdr_t;
+
+/**
+ * @brief   Header in front of the data of every record.
+ */
+typedef struct {
+   uint16_t key;                                       /**< Key of the record */
+   uint16_t len;                                      /**< Length of the data */
+   uint32_t seq;                    /**< Sequence number.  Newest record wins */
+   uint32_t crc;                                         /**< CRC of the data */
+   uint16_t type;              /**< NOR_LOG_REC_DATA or NOR_LOG_REC_TOMBSTONE */
+   uint16_t commit;   /**< NOR_LOG_REC_COMMITTED, programmed after everything */
+} NorLogRecHdr_t;
+
+/* Private defines -----------------------------------------------------------*/
+#define NOR_LOG_BLK_MAGIC       ((uint32_t)0x474F4C4E)            /**< "NLOG" */
+#define NOR_LOG_REC_COMMITTED   ((uint16_t)0xC3C3)
+#define NOR_LOG_REC_DATA        ((uint16_t)0xFFFF)
+#define NOR_LOG_REC_TOMBSTONE   ((uint16_t)0x0000)
+#define NOR_LOG_ERASED16        ((uint16_t)0xFFFF)
+#define NOR_LOG_ERASED32        ((uint32_t)0xFFFFFFFF)
+
+/* Private macros ------------------------------------------------------------*/
+
+/**
+ * @brief   Flash space taken up by a record with len bytes of data.
+ */
+#define NOR_LOG_REC_SIZE(len) \
+   ((uint32_t)((sizeof(NorLogRecHdr_t) + (len) + 3) & ~((uint32_t)3)))
+
+/* Private variables and Local objects ---------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+
+/**
+ * @brief   Get the start address of an erase block.
+ * @param [in] *pLog: const NorLog_t pointer to the store.
+ * @param [in] iBlk: uint16_t index of the block.
+ * @return  uint32_t: flash address of the start of the block.
+ */
+static uint32_t NOR_LOG_blkAddr( const NorLog_t *pLog, const uint16_t iBlk );
+
+/**
+ * @brief   Get the erase block a flash address is in.
+ * @param [in] *pLog: const NorLog_t pointer to the store.
+ * @param [in] addr: uint32_t flash address inside the store.
+ * @return  uint16_t: index of the block.
+ */
+static uint16_t NOR_LOG_blkOf( const NorLog_t *pLog, const uint32_t addr );
+
+/**
+ * @brief   Read any number of bytes from an even address.
+ * @param [in] *pLog: const NorLog_t pointer to the store.
+ * @param [in] addr: uint32_t even flash address to read from.
+ * @param [out] *pBuf: uint8_t pointer to where to put the data.
+ * @param [in] len: uint32_t how many bytes to read.
+ * @return  DC3Error_t: whatever the read function returned.
+ */
+static DC3Error_t NOR_LOG_readBytes(
+      const NorLog_t *pLog,
+      const uint32_t addr,
+      uint8_t *pBuf,
+      const uint32_t len
+);
+
+/**
+ * @brief   Program any number of bytes to an even address.  An odd last byte
+ * gets padded with an erased byte.
+ * @param [in] *pLog: const NorLog_t pointer to the store.
+ * @param [in] addr: uint32_t even flash address to program.
+ * @param [in] *pBuf: const uint8_t pointer to the data.
+ * @param [in] len: uint32_t how many bytes to program.
+ * @return  DC3Error_t: whatever the program function returned.
+ */
+static DC3Error_t NOR_LOG_progBytes(
+      const NorLog_t *pLog,
+      const uint32_t addr,
+      const uint8_t *pBuf,
+      const uint32_t len
+);
+
+/**
+ * @brief   Point the index of a key at a new record and move the live byte
+ * counts of the blocks along with it.
+ * @param [in|out] *pLog: NorLog_t pointer to the store.
+ * @param [in] key: uint16_t key of the record.
+ * @param [in] addr: uint32_t flash address of the record.
+ * @param [in] seq: uint32_t sequence number of the record.
+ * @param [in] len: uint16_t data length of the record.
+ * @param [in] deleted: bool true if the record is a tombstone.
+ * @return  None
+ */
+static void NOR_LOG_idxSet(
+      NorLog_t *pLog,
+      const uint16_t key,
+      const uint32_t addr,
+      const uint32_t seq,
+      const uint16_t len,
+      const bool deleted
+);
+
+/**
+ * @brief   Read the header and the record headers of a block to set up its RAM
+ * state and add its records to the index.
+ * @param [in|out] *pLog: NorLog_t pointer to the store.
+ * @param [in] iBlk: uint16_t index of the block.
+ * @return  DC3Error_t: ERR_NONE or whatever the read function returned.
+ */
+static DC3Error_t NOR_LOG_scanBlk( NorLog_t *pLog, const uint16_t iBlk );
+
+/**
+ * @brief   Erase a block and write a new header with its erase count.  Blocks
+ * that fail are marked BAD.
+ * @param [in|out] *pLog: NorLog_t pointer to the store.
+ * @param [in] iBlk: uint16_t index of the block.
+ * @return  DC3Error_t: ERR_NONE or whatever the flash functions returned.
+ */
+static DC3Error_t NOR_LOG_eraseBlk( NorLog_t *pLog, const uint16_t iBlk );
+
+/**
+ * @brief   Count the FREE blocks.
+ * @param [in] *pLog: const NorLog_t pointer to the store.
+ * @return  uint16_t: number of FREE blocks.
+ */
+static uint16_t NOR_LOG_countFree( const NorLog_t *pLog );
+
+/**
+ * @brief   Pick a FREE block by erase count.
+ * @param [in] *pLog: const NorLog_t pointer to the store.
+ * @param [in] bMostWorn: bool true to pick the most worn block, false to pick
+ * the least worn one.
+ * @return  uint16_t: index of the block or NOR_LOG_NO_BLOCK if none are FREE.
+ */
+static uint16_t NOR_LOG_pickFree( const NorLog_t *pLog, const bool bMostWorn );
+
+/**
+ * @brief   Pick the block to garbage collect next.
+ *
+ * DIRTY blocks go first since they only need an erase.  Then the coldest FULL
+ * block if wear leveling is allowed and it is too far behind the most worn
+ * one.  Then the FULL block with the least live data that has something to
+ * reclaim.  Blocks with live data are only picked if there is a FREE block to
+ * move it to.
+ *
+ * @param [in] *pLog: const NorLog_t pointer to the store.
+ * @param [in] bWear: bool true to allow picking a block for wear leveling.
+ * @return  uint16_t: index of the block or NOR_LOG_NO_BLOCK if none.
+ */
+static uint16_t NOR_LOG_pickVictim( const NorLog_t *pLog, const bool bWear );
+
+/**
+ * @brief   Make sure there's an active block with room for a record.
+ *
+ * Writes may not take the last NOR_LOG_RESERVE_BLOCKS free blocks and
+ * garbage collect until they don't have to.  The garbage collection itself
+ * can take any free block.
+ *
+ * @param [in|out] *pLog: NorLog_t pointer to the store.
+ * @param [in] recSize: uint32_t flash space needed by the record.
+ * @param [in] bGc: bool true if called by the garbage collection.
+ * @return  DC3Error_t: ERR_NONE, ERR_NOR_LOG_FULL or a flash error.
+ */
+static DC3Error_t NOR_LOG_reserve(
+      NorLog_t *pLog,
+      const uint32_t recSize,
+      const bool bGc
+);
+
+/**
+ * @brief   Append a record to the active block and point the index at it.
+ * @param [in|out] *pLog: NorLog_t pointer to the store.
+ * @param [in] key: uint16_t key of the record.
+ * @param [in] type: uint16_t NOR_LOG_REC_DATA or NOR_LOG_REC_TOMBSTONE.
+ * @param [in] *pData: const uint8_t pointer to the data.
+ * @param [in] len: uint16_t length of the data.
+ * @return  DC3Error_t: ERR_NONE, ERR_NOR_LOG_FULL or a flash error.
+ */
+static DC3Error_t NOR_LOG_append(
+      NorLog_t *pLog,
+      const uint16_t key,
+      const uint16_t type,
+      const uint8_t *pData,
+      const uint16_t len
+);
+
+/**
+ * @brief   Copy the newest record of a key to the active block as is (same
+ * sequence number) and point the index at the copy.
+ * @param [in|out] *pLog: NorLog_t pointer to the store.
+ * @param [in] key: uint16_t key of the record.
+ * @return  DC3Error_t: ERR_NONE, ERR_NOR_LOG_FULL or a flash error.
+ */
+static DC3Error_t NOR_LOG_moveRec( NorLog_t *pLog, const uint16_t key );
+
+/**
+ * @brief   Garbage collect a single block.
+ * @param [in|out] *pLog: NorLog_t pointer to the store.
+ * @param [in] bWear: bool true to allow picking a block for wear leveling.
+ * @return  DC3Error_t: ERR_NONE, ERR_NOR_LOG_FULL if there was nothing to
+ * collect, or a flash error.
+ */
+static DC3Error_t NOR_LOG_collect( NorLog_t *pLog, const bool bWear );
+
+/* Private functions ---------------------------------------------------------*/
+/******************************************************************************/
+static uint32_t NOR_LOG_blkAddr( const NorLog_t *pLog, const uint16_t iBlk )
+{
+   return( pLog->cfg.startAddr + (uint32_t)iBlk * pLog->cfg.blockSize );
+}
+
+/******************************************************************************/
+static uint16_t NOR_LOG_blkOf( const NorLog_t *pLog, const uint32_t addr )
+{
+   return( (uint16_t)( (addr - pLog->cfg.startAddr) / pLog->cfg.blockSize ) );
+}
+
+/******************************************************************************/
+static DC3Error_t NOR_LOG_readBytes(
+      const NorLog_t *pLog,
+      const uint32_t addr,
+      uint8_t *pBuf,
+      const uint32_t len
+)
+{
+   DC3Error_t status = ERR_NONE;
+   uint32_t evenLen = len & ~((uint32_t)1);
+
+   if ( 0 != evenLen ) {
+      status = pLog->cfg.read( addr, pBuf, evenLen );
+   }
+
+   if ( ERR_NONE == status && evenLen != len ) {
+      uint8_t tail[2];
+      status = pLog->cfg.read( addr + evenLen, tail, sizeof(tail) );
+      pBuf[evenLen] = tail[0];
+   }
+   return( status );
+}
+
+/******************************************************************************/
+static DC3Error_t NOR_LOG_progBytes(
+      const NorLog_t *pLog,
+      const uint32_t addr,
+      const uint8_t *pBuf,
+      const uint32_t len
+)
+{
+   DC3Error_t status = ERR_NONE;
+   uint32_t evenLen = len & ~((uint32_t)1);
+
+   if ( 0 != evenLen ) {
+      status = pLog->cfg.prog( addr, pBuf, evenLen );
+   }
+
+   if ( ERR_NONE == status && evenLen != len ) {
+      uint8_t tail[2] = { pBuf[evenLen], 0xFF };
+      status = pLog->cfg.prog( addr + evenLen, tail, sizeof(tail) );
+   }
+   return( status );
+}
+
+/******************************************************************************/
+static void NOR_LOG_idxSet(
+      NorLog_t *pLog,
+      const uint16_t key,
+      const uint32_t addr,
+      const uint32_t seq,
+      const uint16_t len,
+      const bool deleted
+)
+{
+   NorLogIdx_t *pIdx = &pLog->idx[key];
+
+   if ( NOR_LOG_NO_ADDR != pIdx->addr ) {
+      pLog->blk[NOR_LOG_blkOf( pLog, pIdx->addr )].liveBytes -=
+            NOR_LOG_REC_SIZE( pIdx->len );
+   }
+
+   pIdx->addr    = addr;
+   pIdx->seq     = seq;
+   pIdx->len     = len;
+   pIdx->deleted = deleted;
+   pLog->blk[NOR_LOG_blkOf( pLog, addr )].liveBytes += NOR_LOG_REC_SIZE( len );
+}
+
+/******************************************************************************/
+static DC3Error_t NOR_LOG_scanBlk( NorLog_t *pLog, const uint16_t iBlk )
+{
+   NorLogBlk_t *pBlk = &pLog->blk[iBlk];
+   uint32_t blkAddr = NOR_LOG_blkAddr( pLog, iBlk );
+   NorLogBlkHdr_t blkHdr;
+   NorLogRecHdr_t recHdr;
+
+   DC3Error_t status = pLog->cfg.read(
+         blkAddr,
+         (uint8_t *)&blkHdr,
+         sizeof(blkHdr)
+   );
+   if ( ERR_NONE != status ) {
+      return( status );
+   }
+
+   if ( NOR_LOG_BLK_MAGIC != blkHdr.magic ||
+         blkHdr.crc != pLog->cfg.crc( (const uint8_t *)&blkHdr, 8 ) ) {
+      pBlk->state = NOR_LOG_BLK_DIRTY;   /* Erase count gets fixed up by init */
+      return( ERR_NONE );
+   }
+
+   pBlk->eraseCnt = blkHdr.eraseCnt;
+   pBlk->state    = NOR_LOG_BLK_FREE;
+
+   uint32_t offset = sizeof(NorLogBlkHdr_t);
+   for ( ;; ) {
+      if ( offset + sizeof(recHdr) > pLog->cfg.blockSize ) {
+         pBlk->state = NOR_LOG_BLK_FULL;
+         break;
+      }
+
+      status = pLog->cfg.read(
+            blkAddr + offset,
+            (uint8_t *)&recHdr,
+            sizeof(recHdr)
+      );
+      if ( ERR_NONE != status ) {
+         return( status );
+      }
+
+      if ( NOR_LOG_ERASED16 == recHdr.key    &&
+           NOR_LOG_ERASED16 == recHdr.len    &&
+           NOR_LOG_ERASED32 == recHdr.seq    &&
+           NOR_LOG_ERASED32 == recHdr.crc    &&
+           NOR_LOG_ERASED16 == recHdr.type   &&
+           NOR_LOG_ERASED16 == recHdr.commit ) {
+         break;                           /* End of the records in this block */
+      }
+
+      /* A record that's not committed or doesn't make sense can only be the
+       * last one that was being written when power went out.  Nothing can be
+       * appended after it so just leave the block for garbage collection. */
+      if ( NOR_LOG_REC_COMMITTED != recHdr.commit ||
+            recHdr.len > NOR_LOG_MAX_DATA_LEN ||
+            offset + NOR_LOG_REC_SIZE( recHdr.len ) > pLog->cfg.blockSize ) {
+         pBlk->state = NOR_LOG_BLK_FULL;
+         break;
+      }
+
+      /* Records moved by the garbage collection keep their sequence numbers so
+       * if power went out before the old block was erased, both copies are the
+       * same and it doesn't matter which one is used. */
+      if ( recHdr.key < NOR_LOG_MAX_KEYS &&
+            ( NOR_LOG_NO_ADDR == pLog->idx[recHdr.key].addr ||
+              recHdr.seq > pLog->idx[recHdr.key].seq ) ) {
+         NOR_LOG_idxSet(
+               pLog,
+               recHdr.key,
+               blkAddr + offset,
+               recHdr.seq,
+               recHdr.len,
+               NOR_LOG_REC_TOMBSTONE == recHdr.type
+         );
+      }
+
+      if ( recHdr.seq > pBlk->lastSeq ) {
+         pBlk->lastSeq = recHdr.seq;
+      }
+      if ( recHdr.seq > pLog->seq ) {
+         pLog->seq = recHdr.seq;
+      }
+
+      offset += NOR_LOG_REC_SIZE( recHdr.len );
+   }
+
+   pBlk->wrOffset = offset;
+
+   /* Init picks which one of the partially written blocks stays active */
+   if ( NOR_LOG_BLK_FREE == pBlk->state && offset > sizeof(NorLogBlkHdr_t) ) {
+      pBlk->state = NOR_LOG_BLK_ACTIVE;
+   }
+   return( ERR_NONE );
+}
+
+/******************************************************************************/
+static DC3Error_t NOR_LOG_eraseBlk( NorLog_t *pLog, const uint16_t iBlk )
+{
+   NorLogBlk_t *pBlk = &pLog->blk[iBlk];
+   uint32_t blkAddr = NOR_LOG_blkAddr( pLog, iBlk );
+   NorLogBlkHdr_t blkHdr;
+
+   DC3Error_t status = pLog->cfg.erase( blkAddr );
+   if ( ERR_NONE == status ) {
+      pBlk->eraseCnt++;
+
+      blkHdr.magic    = NOR_LOG_BLK_MAGIC;
+      blkHdr.eraseCnt = pBlk->eraseCnt;
+      blkHdr.crc      = pLog->cfg.crc( (const uint8_t *)&blkHdr, 8 );
+      status = pLog->cfg.prog(
+            blkAddr,
+            (const uint8_t *)&blkHdr,
+            sizeof(blkHdr)
+      );
+   }
+
+   if ( ERR_NONE != status ) {
+      pBlk->state = NOR_LOG_BLK_BAD;
+      return( status );
+   }
+
+   pBlk->state     = NOR_LOG_BLK_FREE;
+   pBlk->wrOffset  = sizeof(NorLogBlkHdr_t);
+   pBlk->liveBytes = 0;
+   pBlk->lastSeq   = 0;
+   return( ERR_NONE );
+}
+
+/******************************************************************************/
+static uint16_t NOR_LOG_countFree( const NorLog_t *pLog )
+{
+   uint16_t nFree = 0;
+   for ( uint16_t i = 0; i < pLog->cfg.nBlocks; i++ ) {
+      if ( NOR_LOG_BLK_FREE == pLog->blk[i].state ) {
+         nFree++;
+      }
+   }
+   return( nFree );
+}
+
+/******************************************************************************/
+static uint16_t NOR_LOG_pickFree( const NorLog_t *pLog, const bool bMostWorn )
+{
+   uint16_t iPick = NOR_LOG_NO_BLOCK;
+
+   for ( uint16_t i = 0; i < pLog->cfg.nBlocks; i++ ) {
+      if ( NOR_LOG_BLK_FREE != pLog->blk[i].state ) {
+         continue;
+      }
+
+      if ( NOR_LOG_NO_BLOCK == iPick ) {
+         iPick = i;
+         continue;
+      }
+
+      uint32_t eraseCnt = pLog->blk[i].eraseCnt;
+      uint32_t pickCnt  = pLog->blk[iPick].eraseCnt;
+      if ( ( bMostWorn && eraseCnt > pickCnt ) ||
+           ( !bMostWorn && eraseCnt < pickCnt ) ) {
+         iPick = i;
+      }
+   }
+   return( iPick );
+}
+
+/******************************************************************************/
+static uint16_t NOR_LOG_pickVictim( const NorLog_t *pLog, const bool bWear )
+{
+   uint32_t capacity   = pLog->cfg.blockSize - sizeof(NorLogBlkHdr_t);
+   bool     bCanMove   = NOR_LOG_countFree( pLog ) > 0;
+   uint32_t maxErase   = 0;
+   uint16_t iColdest   = NOR_LOG_NO_BLOCK;
+   uint16_t iLeastLive = NOR_LOG_NO_BLOCK;
+
+   for ( uint16_t i = 0; i < pLog->cfg.nBlocks; i++ ) {
+      const NorLogBlk_t *pBlk = &pLog->blk[i];
+
+      if ( NOR_LOG_BLK_DIRTY == pBlk->state ) {
+         return( i );
+      }
+
+      if ( NOR_LOG_BLK_BAD == pBlk->state ) {
+         continue;
+      }
+
+      if ( pBlk->eraseCnt > maxErase ) {
+         maxErase = pBlk->eraseCnt;
+      }
+
+      if ( NOR_LOG_BLK_FULL != pBlk->state ||
+            ( 0 != pBlk->liveBytes && !bCanMove ) ) {
+         continue;
+      }
+
+      if ( NOR_LOG_NO_BLOCK == iColdest ||
+            pBlk->eraseCnt < pLog->blk[iColdest].eraseCnt ) {
+         iColdest = i;
+      }
+
+      if ( pBlk->liveBytes < capacity &&
+            ( NOR_LOG_NO_BLOCK == iLeastLive ||
+              pBlk->liveBytes < pLog->blk[iLeastLive].liveBytes ) ) {
+         iLeastLive = i;
+      }
+   }
+
+   if ( bWear && NOR_LOG_NO_BLOCK != iColdest &&
+         pLog->blk[iColdest].eraseCnt + NOR_LOG_WEAR_DELTA < maxErase ) {
+      return( iColdest );
+   }
+   return( iLeastLive );
+}
+
+/******************************************************************************/
+static DC3Error_t NOR_LOG_reserve(
+      NorLog_t *pLog,
+      const uint32_t recSize,
+      const bool bGc
+)
+{
+   DC3Error_t status = ERR_NONE;
+
+   for ( ;; ) {
+      if ( NOR_LOG_NO_BLOCK != pLog->active ) {
+         NorLogBlk_t *pActive = &pLog->blk[pLog->active];
+         if ( pActive->wrOffset + recSize <= pLog->cfg.blockSize ) {
+            return( ERR_NONE );
+         }
+         pActive->state = NOR_LOG_BLK_FULL;
+         pLog->active   = NOR_LOG_NO_BLOCK;
+      }
+
+      if ( bGc || NOR_LOG_countFree( pLog ) > NOR_LOG_RESERVE_BLOCKS ) {
+         break;
+      }
+
+      /* Out of blocks.  Reclaim some space in the foreground.  This may open
+       * a new active block for the records it moves. */
+      status = NOR_LOG_collect( pLog, false );
+      if ( ERR_NONE != status ) {
+         return( status );
+      }
+   }
+
+   /* Moved records tend to be the ones that don't change so put them into the
+    * most worn block and let the new writes wear out the least worn one. */
+   uint16_t iBlk = NOR_LOG_pickFree( pLog, bGc );
+   if ( NOR_LOG_NO_BLOCK == iBlk ) {
+      return( ERR_NOR_LOG_FULL );
+   }
+
+   pLog->blk[iBlk].state = NOR_LOG_BLK_ACTIVE;
+   pLog->active = iBlk;
+   return( ERR_NONE );
+}
+
+/******************************************************************************/
+static DC3Error_t NOR_LOG_append(
+      NorLog_t *pLog,
+      const uint16_t key,
+      const uint16_t type,
+      const uint8_t *pData,
+      const uint16_t len
+)
+{
+   uint32_t recSize = NOR_LOG_REC_SIZE( len );
+   NorLogRecHdr_t recHdr;
+   uint16_t commit = NOR_LOG_REC_COMMITTED;
+
+   DC3Error_t status = NOR_LOG_reserve( pLog, recSize, false );
+   if ( ERR_NONE != status ) {
+      return( status );
+   }
+
+   NorLogBlk_t *pActive = &pLog->blk[pLog->active];
+   uint32_t addr = NOR_LOG_blkAddr( pLog, pLog->active ) + pActive->wrOffset;
+
+   recHdr.key    = key;
+   recHdr.len    = len;
+   recHdr.seq    = ++pLog->seq;
+   recHdr.crc    = NOR_LOG_ERASED32;
+   recHdr.type   = type;
+   recHdr.commit = NOR_LOG_ERASED16;
+   if ( 0 != len ) {
+      recHdr.crc = pLog->cfg.crc( pData, len );
+   }
+
+   /* Move the write offset first so whatever gets programmed is never written
+    * over even if something below fails. */
+   pActive->wrOffset += recSize;
+
+   status = pLog->cfg.prog(
+         addr,
+         (const uint8_t *)&recHdr,
+         offsetof(NorLogRecHdr_t, commit)
+   );
+   if ( ERR_NONE != status ) {
+      goto NOR_LOG_append_ERR_HANDLE;
+   }
+
+   if ( 0 != len ) {
+      status = NOR_LOG_progBytes( pLog, addr + sizeof(recHdr), pData, len );
+      if ( ERR_NONE != status ) {
+         goto NOR_LOG_append_ERR_HANDLE;
+      }
+   }
+
+   status = pLog->cfg.prog(
+         addr + offsetof(NorLogRecHdr_t, commit),
+         (const uint8_t *)&commit,
+         sizeof(commit)
+   );
+   if ( ERR_NONE != status ) {
+      goto NOR_LOG_append_ERR_HANDLE;
+   }
+
+   pActive->lastSeq = recHdr.seq;
+   NOR_LOG_idxSet(
+         pLog,
+         key,
+         addr,
+         recHdr.seq,
+         len,
+         NOR_LOG_REC_TOMBSTONE == type
+   );
+   return( ERR_NONE );
+
+NOR_LOG_append_ERR_HANDLE:        /* Handle any error that may have occurred. */
+   /* Don't append after a half written record */
+   pActive->state = NOR_LOG_BLK_FULL;
+   pLog->active   = NOR_LOG_NO_BLOCK;
+   return( status );
+}
+
+/******************************************************************************/
+static DC3Error_t NOR_LOG_moveRec( NorLog_t *pLog, const uint16_t key )
+{
+   const NorLogIdx_t *pIdx = &pLog->idx[key];
+   uint32_t recSize = NOR_LOG_REC_SIZE( pIdx->len );
+   uint16_t commit = NOR_LOG_REC_COMMITTED;
+   uint16_t erased = NOR_LOG_ERASED16;
+
+   DC3Error_t status = NOR_LOG_reserve( pLog, recSize, true );
+   if ( ERR_NONE != status ) {
+      return( status );
+   }
+
+   NorLogBlk_t *pActive = &pLog->blk[pLog->active];
+   uint32_t src = pIdx->addr;
+   uint32_t dst = NOR_LOG_blkAddr( pLog, pLog->active ) + pActive->wrOffset;
+   pActive->wrOffset += recSize;
+
+   /* Copy the whole record as is except for the commit mark which goes last */
+   uint32_t chunk = 0;
+   for ( uint32_t offset = 0; offset < recSize; offset += chunk ) {
+      chunk = recSize - offset;
+      if ( chunk > NOR_LOG_COPY_BUF_SIZE ) {
+         chunk = NOR_LOG_COPY_BUF_SIZE;
+      }
+
+      status = pLog->cfg.read( src + offset, pLog->copyBuf, chunk );
+      if ( ERR_NONE != status ) {
+         goto NOR_LOG_moveRec_ERR_HANDLE;
+      }
+
+      if ( 0 == offset ) {
+         memcpy(
+               &pLog->copyBuf[offsetof(NorLogRecHdr_t, commit)],
+               &erased,
+               sizeof(erased)
+         );
+      }
+
+      status = pLog->cfg.prog( dst + offset, pLog->copyBuf, chunk );
+      if ( ERR_NONE != status ) {
+         goto NOR_LOG_moveRec_ERR_HANDLE;
+      }
+   }
+
+   status = pLog->cfg.prog(
+         dst + offsetof(NorLogRecHdr_t, commit),
+         (const uint8_t *)&commit,
+         sizeof(commit)
+   );
+   if ( ERR_NONE != status ) {
+      goto NOR_LOG_moveRec_ERR_HANDLE;
+   }
+
+   if ( pIdx->seq > pActive->lastSeq ) {
+      pActive->lastSeq = pIdx->seq;
+   }
+   NOR_LOG_idxSet( pLog, key, dst, pIdx->seq, pIdx->len, pIdx->deleted );
+   return( ERR_NONE );
+
+NOR_LOG_moveRec_ERR_HANDLE:       /* Handle any error that may have occurred. */
+   pActive->state = NOR_LOG_BLK_FULL;
+   pLog->active   = NOR_LOG_NO_BLOCK;
+   return( status );
+}
+
+/******************************************************************************/
+static DC3Error_t NOR_LOG_collect( NorLog_t *pLog, const bool bWear )
+{
+   DC3Error_t status = ERR_NONE;
+
+   uint16_t iVictim = NOR_LOG_pickVictim( pLog, bWear );
+   if ( NOR_LOG_NO_BLOCK == iVictim ) {
+      return( ERR_NOR_LOG_FULL );
+   }
+
+   if ( NOR_LOG_BLK_DIRTY != pLog->blk[iVictim].state ) {
+      for ( uint16_t key = 0; key < NOR_LOG_MAX_KEYS; key++ ) {
+         if ( NOR_LOG_NO_ADDR != pLog->idx[key].addr &&
+               iVictim == NOR_LOG_blkOf( pLog, pLog->idx[key].addr ) ) {
+            status = NOR_LOG_moveRec( pLog, key );
+            if ( ERR_NONE != status ) {
+               return( status );
+            }
+         }
+      }
+   }
+
+   status = NOR_LOG_eraseBlk( pLog, iVictim );
+   if ( ERR_NONE == status ) {
+      pLog->nGcRuns++;
+   }
+   return( status );
+}
+
+/* Public functions ----------------------------------------------------------*/
+/******************************************************************************/
+DC3Error_t NOR_LOG_init( NorLog_t *pLog, const NorLogCfg_t *pCfg )
+{
+   DC3Error_t status = ERR_NONE;
+
+   if ( NULL == pLog ) {
+      return( ERR_NOR_LOG_INVALID_PARAMS );
+   }
+
+   /* A store that failed to init has no blocks so nothing else can do any
+    * damage with it. */
+   memset( pLog, 0, sizeof(*pLog) );
+   pLog->active = NOR_LOG_NO_BLOCK;
+   for ( uint16_t key = 0; key < NOR_LOG_MAX_KEYS; key++ ) {
+      pLog->idx[key].addr = NOR_LOG_NO_ADDR;
+   }
+
+   if ( NULL == pCfg || NULL == pCfg->read || NULL == pCfg->prog ||
+         NULL == pCfg->erase || NULL == pCfg->crc ||
+         pCfg->nBlocks < NOR_LOG_RESERVE_BLOCKS + 1 ||
+         pCfg->nBlocks > NOR_LOG_MAX_BLOCKS ||
+         0 != (pCfg->startAddr & 3) || 0 != (pCfg->blockSize & 3) ||
+         pCfg->blockSize < sizeof(NorLogBlkHdr_t) +
+                           NOR_LOG_REC_SIZE( NOR_LOG_MAX_DATA_LEN ) ) {
+      return( ERR_NOR_LOG_INVALID_PARAMS );
+   }
+
+   pLog->cfg = *pCfg;
+
+   uint32_t maxErase = 0;
+   for ( uint16_t i = 0; i < pLog->cfg.nBlocks; i++ ) {
+      status = NOR_LOG_scanBlk( pLog, i );
+      if ( ERR_NONE != status ) {
+         pLog->cfg.nBlocks = 0;
+         return( status );
+      }
+
+      if ( NOR_LOG_BLK_DIRTY != pLog->blk[i].state &&
+            pLog->blk[i].eraseCnt > maxErase ) {
+         maxErase = pLog->blk[i].eraseCnt;
+      }
+   }
+
+   /* Only the block with the newest records keeps getting appended to.  Any
+    * other partially written block is left over from a power loss. */
+   for ( uint16_t i = 0; i < pLog->cfg.nBlocks; i++ ) {
+      NorLogBlk_t *pBlk = &pLog->blk[i];
+
+      if ( NOR_LOG_BLK_DIRTY == pBlk->state ) {
+         pBlk->eraseCnt = maxErase;  /* Unknown so assume it's the most worn */
+      } else if ( NOR_LOG_BLK_ACTIVE == pBlk->state ) {
+         if ( NOR_LOG_NO_BLOCK == pLog->active ) {
+            pLog->active = i;
+         } else if ( pBlk->lastSeq > pLog->blk[pLog->active].lastSeq ) {
+            pLog->blk[pLog->active].state = NOR_LOG_BLK_FULL;
+            pLog->active = i;
+         } else {
+            pBlk->state = NOR_LOG_BLK_FULL;
+         }
+      }
+   }
+
+   return( ERR_NONE );
+}
+
+/******************************************************************************/
+DC3Error_t NOR_LOG_format( NorLog_t *pLog )
+{
+   DC3Error_t status = ERR_NONE;
+
+   pLog->active = NOR_LOG_NO_BLOCK;
+   for ( uint16_t key = 0; key < NOR_LOG_MAX_KEYS; key++ ) {
+      pLog->idx[key].addr = NOR_LOG_NO_ADDR;
+   }
+
+   for ( uint16_t i = 0; i < pLog->cfg.nBlocks; i++ ) {
+      if ( NOR_LOG_BLK_BAD != pLog->blk[i].state ) {
+         DC3Error_t blkStatus = NOR_LOG_eraseBlk( pLog, i );
+         if ( ERR_NONE != blkStatus ) {
+            status = blkStatus;     /* Keep going and report it at the end */
+         }
+      }
+   }
+   return( status );
+}
+
+/******************************************************************************/
+DC3Error_t NOR_LOG_write(
+      NorLog_t *pLog,
+      const uint16_t key,
+      const uint8_t *pData,
+      const uint16_t len
+)
+{
+   if ( key >= NOR_LOG_MAX_KEYS || len > NOR_LOG_MAX_DATA_LEN ||
+         ( NULL == pData && 0 != len ) ) {
+      return( ERR_NOR_LOG_INVALID_PARAMS );
+   }
+
+   return( NOR_LOG_append( pLog, key, NOR_LOG_REC_DATA, pData, len ) );
+}
+
+/******************************************************************************/
+DC3Error_t NOR_LOG_read(
+      NorLog_t *pLog,
+      const uint16_t key,
+      uint8_t *pBuf,
+      const uint16_t bufSize,
+      uint16_t *pLen
+)
+{
+   NorLogRecHdr_t recHdr;
+
+   if ( key >= NOR_LOG_MAX_KEYS || NULL == pBuf || NULL == pLen ) {
+      return( ERR_NOR_LOG_INVALID_PARAMS );
+   }
+
+   const NorLogIdx_t *pIdx = &pLog->idx[key];
+   if ( NOR_LOG_NO_ADDR == pIdx->addr || pIdx->deleted ) {
+      return( ERR_NOR_LOG_NOT_FOUND );
+   }
+
+   if ( pIdx->len > bufSize ) {
+      return( ERR_MEM_BUFFER_LEN );
+   }
+
+   DC3Error_t status = pLog->cfg.read(
+         pIdx->addr,
+         (uint8_t *)&recHdr,
+         sizeof(recHdr)
+   );
+   if ( ERR_NONE != status ) {
+      return( status );
+   }
+
+   if ( recHdr.key != key || recHdr.len != pIdx->len ||
+         NOR_LOG_REC_COMMITTED != recHdr.commit ) {
+      return( ERR_NOR_LOG_CORRUPT_RECORD );
+   }
+
+   status = NOR_LOG_readBytes(
+         pLog,
+         pIdx->addr + sizeof(recHdr),
+         pBuf,
+         pIdx->len
+   );
+   if ( ERR_NONE != status ) {
+      return( status );
+   }
+
+   if ( 0 != pIdx->len && recHdr.crc != pLog->cfg.crc( pBuf, pIdx->len ) ) {
+      return( ERR_NOR_LOG_CRC_MISMATCH );
+   }
+
+   *pLen = pIdx->len;
+   return( ERR_NONE );
+}
+
+/******************************************************************************/
+DC3Error_t NOR_LOG_delete( NorLog_t *pLog, const uint16_t key )
+{
+   if ( key >= NOR_LOG_MAX_KEYS ) {
+      return( ERR_NOR_LOG_INVALID_PARAMS );
+   }
+
+   if ( NOR_LOG_NO_ADDR == pLog->idx[key].addr || pLog->idx[key].deleted ) {
+      return( ERR_NOR_LOG_NOT_FOUND );
+   }
+
+   /* Older records of this key can still be around in other blocks so the
+    * tombstone has to stay in the log and be moved around like any record. */
+   return( NOR_LOG_append( pLog, key, NOR_LOG_REC_TOMBSTONE, NULL, 0 ) );
+}
+
+/******************************************************************************/
+bool NOR_LOG_isGcNeeded( const NorLog_t *pLog )
+{
+   if ( 0 == pLog->cfg.nBlocks ) {
+      return( false );
+   }
+
+   /* Picks DIRTY and cold blocks no matter how many blocks are free */
+   uint16_t iVictim = NOR_LOG_pickVictim( pLog, true );
+   if ( NOR_LOG_NO_BLOCK == iVictim ) {
+      return( false );
+   }
+
+   return( NOR_LOG_BLK_DIRTY == pLog->blk[iVictim].state ||
+         NOR_LOG_countFree( pLog ) < NOR_LOG_GC_FREE_BLOCKS ||
+         iVictim != NOR_LOG_pickVictim( pLog, false ) );
+}
+
+/******************************************************************************/
+DC3Error_t NOR_LOG_gcStep( NorLog_t *pLog )
+{
+   return( NOR_LOG_collect( pLog, true ) );
+}
+
+/******************************************************************************/
+void NOR_LOG_getStats( const NorLog_t *pLog, NorLogStats_t *pStats )
+{
+   memset( pStats, 0, sizeof(*pStats) );
+   pStats->minEraseCnt = NOR_LOG_ERASED32;
+   pStats->nGcRuns     = pLog->nGcRuns;
+
+   for ( uint16_t i = 0; i < pLog->cfg.nBlocks; i++ ) {
+      const NorLogBlk_t *pBlk = &pLog->blk[i];
+
+      switch ( pBlk->state ) {
+         case NOR_LOG_BLK_DIRTY: pStats->nDirty++; break;
+         case NOR_LOG_BLK_FREE:  pStats->nFree++;  break;
+         case NOR_LOG_BLK_FULL:  pStats->nFull++;  break;
+         case NOR_LOG_BLK_BAD:   pStats->nBad++;   continue;
+         default:                                  break;
+      }
+
+      if ( pBlk->eraseCnt < pStats->minEraseCnt ) {
+         pStats->minEraseCnt = pBlk->eraseCnt;
+      }
+      if ( pBlk->eraseCnt > pStats->maxEraseCnt ) {
+         pStats->maxEraseCnt = pBlk->eraseCnt;
+      }
+
+      if ( NOR_LOG_BLK_FULL == pBlk->state ||
+            NOR_LOG_BLK_ACTIVE == pBlk->state ) {
+         pStats->liveBytes += pBlk->liveBytes;
+         pStats->usedBytes += pBlk->wrOffset - sizeof(NorLogBlkHdr_t);
+      }
+   }
+
+   if ( NOR_LOG_ERASED32 == pStats->minEraseCnt ) {
+      pStats->minEraseCnt = 0;
+   }
+}
+
+/**
+ * @}
+ * end addtogroup groupNOR
+ */
+
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
@@ -0,0 +1,305 @@
+/**
+ * @file    nor_log.h
+ * @brief   Log structured key/record store on top of the NOR flash.
+ *
+ * Records are only ever appended.  Each one gets a header with its key, data
+ * length, a sequence number and a CRC of the data and the newest sequence
+ * number for a key wins.  The header has a commit mark that gets programmed
+ * last so a record that was torn by a power loss is never used.  Deleting a
+ * key appends an empty tombstone record for it.
+ *
+ * The index of where the newest record of each key lives is kept in RAM and is
+ * rebuilt at boot by scanning the record headers of all the blocks.
+ *
+ * Space taken up by old records is reclaimed one erase block at a time by
+ * NOR_LOG_gcStep() which copies the still live records out of a block and
+ * erases it.  The caller is expected to call it when it has nothing better to
+ * do.  Writes only run it themselves if they would otherwise run out of blocks.
+ *
+ * Wear leveling:
+ *    New writes go into the least worn free block.
+ *    Records moved by the garbage collection go into the most worn free block.
+ *    A block holding cold data gets moved once it falls too far behind the
+ *    most worn block.
+ *
+ * This file has no dependencies on the STM32 hardware.  All the flash access
+ * goes through the functions in NorLogCfg_t so the store can be built on a host
+ * against something like a memory mapped file.
+ *
+ * None of the functions are reentrant.  A store should only be accessed by a
+ * single thread.
+ *
+ * @date    10/19/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ *
+ * @addtogroup groupNOR
+ * @{
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef NOR_LOG_H_
+#define NOR_LOG_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "DC3Errors.h"                               /* For DC3 error codes */
+
+/* Exported defines ----------------------------------------------------------*/
+#define NOR_LOG_MAX_BLOCKS      64 /**< Max number of erase blocks in a store */
+#define NOR_LOG_MAX_KEYS        64        /**< Keys have to be less than this */
+#define NOR_LOG_MAX_DATA_LEN    0x2000            /**< Max data in one record */
+#define NOR_LOG_RESERVE_BLOCKS  1            /**< Free blocks kept for the GC */
+#define NOR_LOG_GC_FREE_BLOCKS  4  /**< Collect in background below this many */
+#define NOR_LOG_WEAR_DELTA      256    /**< Erase spread before moving cold */
+#define NOR_LOG_COPY_BUF_SIZE   256 /**< Buffer used when moving live records */
+
+#define NOR_LOG_NO_ADDR         0xFFFFFFFF    /**< Key has never been written */
+#define NOR_LOG_NO_BLOCK        0xFFFF      /**< No block is open for writing */
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief   Read from the flash.
+ * @param [in] addr: uint32_t address to read from.  Always even.
+ * @param [out] *pBuf: uint8_t pointer to where to put the data.
+ * @param [in] len: uint32_t how many bytes to read.  Always even.
+ * @return  DC3Error_t: ERR_NONE if ok.
+ */
+typedef DC3Error_t (*NorLogReadFn_t)(
+      uint32_t addr,
+      uint8_t *pBuf,
+      uint32_t len
+);
+
+/**
+ * @brief   Program erased flash.
+ * @param [in] addr: uint32_t address to program.  Always even.
+ * @param [in] *pBuf: const uint8_t pointer to the data to program.
+ * @param [in] len: uint32_t how many bytes to program.  Always even.
+ * @return  DC3Error_t: ERR_NONE if ok.
+ */
+typedef DC3Error_t (*NorLogProgFn_t)(
+      uint32_t addr,
+      const uint8_t *pBuf,
+      uint32_t len
+);
+
+/**
+ * @brief   Erase a block of flash.
+ * @param [in] blockAddr: uint32_t start address of the block.
+ * @return  DC3Error_t: ERR_NONE if ok.
+ */
+typedef DC3Error_t (*NorLogEraseFn_t)( uint32_t blockAddr );
+
+/**
+ * @brief   CRC function used to check record data.  On the target this is
+ * CRC32_Calc() which uses the STM32 CRC hardware.
+ */
+typedef uint32_t (*NorLogCrcFn_t)( const uint8_t *buffer, uint32_t size );
+
+/**
+ * @brief   Where the store lives and how to get to it.
+ */
+typedef struct {
+   NorLogReadFn_t  read;                             /**< Read from the flash */
+   NorLogProgFn_t  prog;                            /**< Program erased flash */
+   NorLogEraseFn_t erase;                           /**< Erase a single block */
+   NorLogCrcFn_t   crc;                           /**< CRC of the record data */
+   uint32_t        startAddr;           /**< Address of the first erase block */
+   uint32_t        blockSize;               /**< Size of a single erase block */
+   uint16_t        nBlocks;    /**< How many blocks, up to NOR_LOG_MAX_BLOCKS */
+} NorLogCfg_t;
+
+/**
+ * @brief   What an erase block is used for.
+ */
+typedef enum NorLogBlkStates {
+   NOR_LOG_BLK_DIRTY = 0,          /**< Not formatted. Has to be erased first */
+   NOR_LOG_BLK_FREE,                    /**< Erased and formatted, no records */
+   NOR_LOG_BLK_ACTIVE,                  /**< Records are appended to this one */
+   NOR_LOG_BLK_FULL,           /**< No more appends. Can be garbage collected */
+   NOR_LOG_BLK_BAD,                    /**< Failed to erase. Never used again */
+} NorLogBlkState_t;
+
+/**
+ * @brief   RAM state of an erase block.
+ */
+typedef struct {
+   NorLogBlkState_t state;                            /**< What it's used for */
+   uint32_t         eraseCnt;          /**< How many times it has been erased */
+   uint32_t         wrOffset;       /**< Where the next record would go in it */
+   uint32_t         liveBytes;    /**< Bytes of records that are still newest */
+   uint32_t         lastSeq;        /**< Newest sequence number written to it */
+} NorLogBlk_t;
+
+/**
+ * @brief   RAM index entry of a key.
+ */
+typedef struct {
+   uint32_t addr;        /**< Address of the newest record or NOR_LOG_NO_ADDR */
+   uint32_t seq;                    /**< Sequence number of the newest record */
+   uint16_t len;                        /**< Data length of the newest record */
+   bool     deleted;                        /**< Newest record is a tombstone */
+} NorLogIdx_t;
+
+/**
+ * @brief   A log store.
+ */
+typedef struct {
+   NorLogCfg_t cfg;                                       /**< Where it lives */
+   NorLogBlk_t blk[NOR_LOG_MAX_BLOCKS];              /**< State of all blocks */
+   NorLogIdx_t idx[NOR_LOG_MAX_KEYS];                /**< Where the keys live */
+   uint32_t    seq;                            /**< Last sequence number used */
+   uint16_t    active;       /**< Block being appended to or NOR_LOG_NO_BLOCK */
+   uint32_t    nGcRuns;              /**< How many blocks have been collected */
+   uint8_t     copyBuf[NOR_LOG_COPY_BUF_SIZE];/**< For moving live records */
+} NorLog_t;
+
+/**
+ * @brief   Usage of a store.
+ */
+typedef struct {
+   uint16_t nFree;                      /**< Blocks that are erased and ready */
+   uint16_t nFull;                        /**< Blocks waiting to be collected */
+   uint16_t nDirty;                        /**< Blocks that have to be erased */
+   uint16_t nBad;                            /**< Blocks that failed to erase */
+   uint32_t minEraseCnt;                 /**< Erase count of least worn block */
+   uint32_t maxEraseCnt;                  /**< Erase count of most worn block */
+   uint32_t liveBytes;                  /**< Bytes used by the newest records */
+   uint32_t usedBytes;            /**< Bytes used by all records, old and new */
+   uint32_t nGcRuns;                 /**< How many blocks have been collected */
+} NorLogStats_t;
+
+/* Exported macros -----------------------------------------------------------*/
+/* Exported constants --------------------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief   Set up a store and rebuild its index from the flash.
+ *
+ * Blocks that don't have a valid header are marked DIRTY and get erased by the
+ * garbage collection before they are used.  A brand new chip is all DIRTY
+ * blocks so either call NOR_LOG_format() or let NOR_LOG_gcStep() erase them.
+ *
+ * @param [out] *pLog: NorLog_t pointer to the store.
+ * @param [in] *pCfg: const NorLogCfg_t pointer to where the store lives.
+ * @return  DC3Error_t:
+ *    @arg ERR_NONE: the store is ready
+ *    @arg ERR_NOR_LOG_INVALID_PARAMS: bad config
+ *    @arg any error returned by the read function
+ */
+DC3Error_t NOR_LOG_init( NorLog_t *pLog, const NorLogCfg_t *pCfg );
+
+/**
+ * @brief   Erase all the blocks of a store.  All records are lost but the
+ * erase counts are kept.
+ *
+ * @param [in|out] *pLog: NorLog_t pointer to the store.
+ * @return  DC3Error_t: ERR_NONE if all the blocks were erased.
+ */
+DC3Error_t NOR_LOG_format( NorLog_t *pLog );
+
+/**
+ * @brief   Write a new record for a key.
+ *
+ * @param [in|out] *pLog: NorLog_t pointer to the store.
+ * @param [in] key: uint16_t key of the record.  Less than NOR_LOG_MAX_KEYS.
+ * @param [in] *pData: const uint8_t pointer to the data.
+ * @param [in] len: uint16_t length of the data.  Up to NOR_LOG_MAX_DATA_LEN.
+ * @return  DC3Error_t:
+ *    @arg ERR_NONE: the record was written
+ *    @arg ERR_NOR_LOG_INVALID_PARAMS: bad key or length
+ *    @arg ERR_NOR_LOG_FULL: no space left even after garbage collecting
+ *    @arg any error returned by the flash functions
+ */
+DC3Error_t NOR_LOG_write(
+      NorLog_t *pLog,
+      const uint16_t key,
+      const uint8_t *pData,
+      const uint16_t len
+);
+
+/**
+ * @brief   Read the newest record of a key.
+ *
+ * @param [in] *pLog: NorLog_t pointer to the store.
+ * @param [in] key: uint16_t key of the record.
+ * @param [out] *pBuf: uint8_t pointer to where to put the data.
+ * @param [in] bufSize: uint16_t size of the buffer.
+ * @param [out] *pLen: uint16_t pointer to where to put the data length.
+ * @return  DC3Error_t:
+ *    @arg ERR_NONE: the data is in the buffer
+ *    @arg ERR_NOR_LOG_NOT_FOUND: the key was never written or was deleted
+ *    @arg ERR_MEM_BUFFER_LEN: the buffer is too small for the data
+ *    @arg ERR_NOR_LOG_CRC_MISMATCH: the data is corrupt
+ *    @arg ERR_NOR_LOG_CORRUPT_RECORD: the record header is corrupt
+ */
+DC3Error_t NOR_LOG_read(
+      NorLog_t *pLog,
+      const uint16_t key,
+      uint8_t *pBuf,
+      const uint16_t bufSize,
+      uint16_t *pLen
+);
+
+/**
+ * @brief   Delete a key.
+ *
+ * @param [in|out] *pLog: NorLog_t pointer to the store.
+ * @param [in] key: uint16_t key to delete.
+ * @return  DC3Error_t: ERR_NONE, ERR_NOR_LOG_NOT_FOUND if there is nothing to
+ * delete, or any of the errors of NOR_LOG_write().
+ */
+DC3Error_t NOR_LOG_delete( NorLog_t *pLog, const uint16_t key );
+
+/**
+ * @brief   Check if there is any work for NOR_LOG_gcStep().
+ *
+ * @param [in] *pLog: const NorLog_t pointer to the store.
+ * @return  bool: true if there are DIRTY blocks, if free blocks are running low
+ * and some space can be reclaimed, or if cold data should be moved.
+ */
+bool NOR_LOG_isGcNeeded( const NorLog_t *pLog );
+
+/**
+ * @brief   Garbage collect a single erase block.
+ *
+ * Erases a DIRTY block if there is one.  Otherwise, picks a full block (the
+ * one with the least live data or the coldest one if wear leveling needs it),
+ * moves its live records to the active block and erases it.
+ *
+ * @param [in|out] *pLog: NorLog_t pointer to the store.
+ * @return  DC3Error_t:
+ *    @arg ERR_NONE: a block was collected
+ *    @arg ERR_NOR_LOG_FULL: there was nothing to collect
+ *    @arg any error returned by the flash functions
+ */
+DC3Error_t NOR_LOG_gcStep( NorLog_t *pLog );
+
+/**
+ * @brief   Get the usage of a store.
+ *
+ * @param [in] *pLog: const NorLog_t pointer to the store.
+ * @param [out] *pStats: NorLogStats_t pointer to where to put the usage.
+ * @return  None
+ */
+void NOR_LOG_getStats( const NorLog_t *pLog, NorLogStats_t *pStats );
+
+/**
+ * @}
+ * end addtogroup groupNOR
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif                                                          /* NOR_LOG_H_ */
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
@@ -29,6 +29,8 @@
 #include "SerialMgr.h"                                 /* for SerialMgr types */
 #include "time.h"                          /* for processor date/time support */
 #include "i2c.h"                                /* For I2C callback functions */
+#include "spi.h"                                /* For SPI callback functions */
+#include "dma_mem.h"                     /* For memory DMA callback functions */
 #include "serial.h"                          /* For Serial callback functions */
 #include "eth_driver.h"                    /* For Ethernet callback functions */
 
@@ -163,6 +165,54 @@ void DMA1_Stream6_IRQHandler( void )
    portEND_SWITCHING_ISR(lHigherPriorityTaskWoken);/* the end of FreeRTOS ISR */
 }
 
+/******************************************************************************/
+void DMA2_Stream0_IRQHandler( void )
+{
+   QF_CRIT_STAT_TYPE intStat;
+   BaseType_t lHigherPriorityTaskWoken = pdFALSE;
+
+   QF_ISR_ENTRY(intStat);                        /* inform QF about ISR entry */
+
+   DMA_MEM_Callback(); /* Issue the callback function which does the actual work. */
+
+   QF_ISR_EXIT(intStat, lHigherPriorityTaskWoken);/* inform QF about ISR exit */
+
+   /* the usual end of FreeRTOS ISR... */
+   portEND_SWITCHING_ISR(lHigherPriorityTaskWoken);/* the end of FreeRTOS ISR */
+}
+
+/******************************************************************************/
+void DMA2_Stream3_IRQHandler( void )
+{
+   QF_CRIT_STAT_TYPE intStat;
+   BaseType_t lHigherPriorityTaskWoken = pdFALSE;
+
+   QF_ISR_ENTRY(intStat);                        /* inform QF about ISR entry */
+
+   SPI5_DMARxCallback(); /* Issue the callback function which does the actual work. */
+
+   QF_ISR_EXIT(intStat, lHigherPriorityTaskWoken);/* inform QF about ISR exit */
+
+   /* the usual end of FreeRTOS ISR... */
+   portEND_SWITCHING_ISR(lHigherPriorityTaskWoken);/* the end of FreeRTOS ISR */
+}
+
+/******************************************************************************/
+void DMA2_Stream4_IRQHandler( void )
+{
+   QF_CRIT_STAT_TYPE intStat;
+   BaseType_t lHigherPriorityTaskWoken = pdFALSE;
+
+   QF_ISR_ENTRY(intStat);                        /* inform QF about ISR entry */
+
+   SPI5_DMATxCallback(); /* Issue the callback function which does the actual work. */
+
+   QF_ISR_EXIT(intStat, lHigherPriorityTaskWoken);/* inform QF about ISR exit */
+
+   /* the usual end of FreeRTOS ISR... */
+   portEND_SWITCHING_ISR(lHigherPriorityTaskWoken);/* the end of FreeRTOS ISR */
+}
+
 /******************************************************************************/
 void DMA2_Stream7_IRQHandler( void )
 {
@@ -125,6 +125,33 @@ void DMA1_Stream0_IRQHandler( void ) __attribute__((__interrupt__));
  */
 void DMA1_Stream6_IRQHandler( void ) __attribute__((__interrupt__));
 
+/**
+ * @brief   This ISR function handles DMA2 Stream0 interrupt requests.
+ *
+ * This ISR function handles the memory-to-memory DMA completion and errors.
+ * @param  None
+ * @retval None
+ */
+void DMA2_Stream0_IRQHandler( void ) __attribute__((__interrupt__));
+
+/**
+ * @brief   This ISR function handles DMA2 Stream3 interrupt requests.
+ *
+ * This ISR function handles the SPI5 RX DMA completion and errors.
+ * @param  None
+ * @retval None
+ */
+void DMA2_Stream3_IRQHandler( void ) __attribute__((__interrupt__));
+
+/**
+ * @brief   This ISR function handles DMA2 Stream4 interrupt requests.
+ *
+ * This ISR function handles the SPI5 TX DMA errors.
+ * @param  None
+ * @retval None
+ */
+void DMA2_Stream4_IRQHandler( void ) __attribute__((__interrupt__));
+
 /**
  * @brief   This ISR function handles DMA2_Stream7 global interrupt requests.
  *
@@ -133,6 +133,11 @@
        * @ingroup groupSharedBSP
        */
 
+      /**
+       * @defgroup groupDMAMem Memory-to-memory DMA
+       * @ingroup groupSharedBSP
+       */
+
       /**
        * @defgroup groupEthernet Ethernet (DP83848 PHY) driver.
        * @ingroup groupSharedBSP
@@ -202,6 +207,26 @@
             * @ingroup groupDbgCntrl
             */
 
+       /**
+        * @defgroup groupAOProf Active Object dispatch profiling
+        * @ingroup groupSharedSYS
+        */
+
+       /**
+        * @defgroup groupMemStats Event pool and queue usage
+        * @ingroup groupSharedSYS
+        */
+
+       /**
+        * @defgroup groupHealth Health stream metrics
+        * @ingroup groupSharedSYS
+        */
+
+       /**
+        * @defgroup groupCpuLoad CPU load
+        * @ingroup groupSharedSYS
+        */
+
 
 /* Includes ------------------------------------------------------------------*/
 #include "mem_datacopy.h"      /* Very fast STM32 specific MEMCPY declaration */
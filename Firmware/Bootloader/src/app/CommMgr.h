@@ -72,6 +72,47 @@ void CommMgr_ctor(void);
 DC3Error_t Comm_sendToClient(LrgDataEvt* evt);
 
 
+/**
+ * @brief   Check that a range can be streamed back with a DC3MemReadMsg.
+ * The offset has to be word aligned since SDRAM and NOR are read a word (or
+ * half-word) at a time.
+ * @param [in] memSpace: DC3MemSpace_t memory to read from.
+ * @param [in] offset: uint32_t offset into the memory where to start reading.
+ * @param [in] length: uint32_t number of bytes to read.
+ * @return: DC3Error_t indicating status of operation.
+ */
+/*${AOs::Comm_checkMemRan~} ................................................*/
+DC3Error_t Comm_checkMemRange(DC3MemSpace_t memSpace, uint32_t offset, uint32_t length);
+
+
+/**
+ * @brief   Read a single frame from one of the memories readable by DC3MemReadMsg.
+ * The range should already have been checked by Comm_checkMemRange().
+ * @param [in] memSpace: DC3MemSpace_t memory to read from.
+ * @param [in] offset: uint32_t word aligned offset into the memory.
+ * @param [in] len: uint16_t number of bytes to read.
+ * @param [out] *pBuf: uint32_t pointer to a buffer that can hold len bytes
+ * rounded up to a whole word.
+ * @return: DC3Error_t indicating status of operation.
+ */
+/*${AOs::Comm_readMem} .....................................................*/
+DC3Error_t Comm_readMem(DC3MemSpace_t memSpace, uint32_t offset, uint16_t len, uint32_t* pBuf);
+
+
+/**
+ * @brief   Fill in the Done payload of a DC3DiscoverMsg.
+ * Everything comes from the RAM copy of the DB (or from flash) so nothing here
+ * waits on the I2C bus.  A field that can't be read is left empty and the rest
+ * still get filled in.
+ * @param [out] pMsg: DC3DiscoverPayloadMsg pointer to the payload.
+ * @return: DC3Error_t indicating status of operation.  The first error if
+ * some of the fields couldn't be read.  Also put into the errorCode field of
+ * the payload.
+ */
+/*${AOs::Comm_getDiscover} .................................................*/
+DC3Error_t Comm_getDiscover(struct DC3DiscoverPayloadMsg* pMsg);
+
+
 /**< "opaque" pointer to the Active Object */
 extern QActive * const AO_CommMgr;
 
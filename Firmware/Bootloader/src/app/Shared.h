@@ -44,6 +44,9 @@ enum AO_Priorities {
     * all together since there's a loop that iterates through them and will
     * take up the next priority if one is not added here.  You will end up with
     * clashing priorities for your AOs.*/
+   SPIBUS5MGR_PRIORITY,                        /**< Priority of SPIBusMgr AO. */
+   /* Same as with the I2C busses, all the SPI bus priorities have to be kept
+    * together since there's a loop that starts them. */
 
    SERIAL_MGR_PRIORITY,     /**< Priority of SerialMgr AO that handles serial */
 
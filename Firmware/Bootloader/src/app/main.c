@@ -17,6 +17,7 @@
 #include "SerialMgr.h"                           /* for starting SerialMgr AO */
 #include "I2CBusMgr.h"                           /* for starting I2CBusMgr AO */
 #include "I2C1DevMgr.h"                         /* for starting I2C1DevMgr AO */
+#include "SPIBusMgr.h"                           /* for starting SPIBusMgr AO */
 #include "FlashMgr.h"                             /* for starting FlashMgr AO */
 #include "SysMgr.h"                                 /* for starting SysMgr AO */
 
@@ -29,6 +30,8 @@
 #include "bsp_defs.h"
 #include "bsp.h"
 #include "db.h"                                       /* for settings support */
+#include "dma_mem.h"                            /* for memory DMA event types */
+#include "flash.h"                         /* for installing staged FW images */
 
 /* Compile-time called macros ------------------------------------------------*/
 Q_DEFINE_THIS_FILE                  /* For QSPY to know the name of this file */
@@ -44,6 +47,7 @@ CCMRAM_VAR static QEvt const    *l_CommMgrQueueSto[30];          /**< Storage fo
 CCMRAM_VAR static QEvt const    *l_LWIPMgrQueueSto[200];         /**< Storage for LWIPMgr event Queue */
 CCMRAM_VAR static QEvt const    *l_SerialMgrQueueSto[200];       /**< Storage for SerialMgr event Queue */
 CCMRAM_VAR static QEvt const    *l_I2CBusMgrQueueSto[30][MAX_I2C_BUS];    /**< Storage for I2CBusMgr event Queue */
+CCMRAM_VAR static QEvt const    *l_SPIBusMgrQueueSto[MAX_SPI_BUS][30];    /**< Storage for SPIBusMgr event Queue */
 CCMRAM_VAR static QEvt const    *l_I2C1DevMgrQueueSto[30];       /**< Storage for I2C1DevMgr event Queue */
 CCMRAM_VAR static QEvt const    *l_FlashMgrQueueSto[30];         /**< Storage for FlashMgr event Queue */
 CCMRAM_VAR static QEvt const    *l_SysMgrQueueSto[10];           /**< Storage for SysMgr event Queue */
@@ -72,6 +76,7 @@ CCMRAM_VAR static union SmallEvents {
    uint8_t e7[sizeof(DBWriteDoneEvt)];
    uint8_t e8[sizeof(DBReadReqEvt)];
    uint8_t e9[sizeof(DBCheckSetElemEvt)];
+   uint8_t e10[sizeof(DMAMemDoneEvt)];
 } l_smlPoolSto[50];                     /* storage for the small event pool */
 
 /**
@@ -95,6 +100,9 @@ CCMRAM_VAR static union LargeEvents {
    uint8_t e1[sizeof(EthEvt)];
    uint8_t e2[sizeof(LrgDataEvt)];
    uint8_t e3[sizeof(FWDataEvt)];
+   uint8_t e4[sizeof(DBElemsEvt)];
+   uint8_t e5[sizeof(SPIXferReqEvt)];
+   uint8_t e6[sizeof(SPIXferDoneEvt)];
 } l_lrgPoolSto[138];                    /* storage for the large event pool */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -134,6 +142,11 @@ int main(void)
       I2CBusMgr_ctor( i );      /* Start this instance of AO for this bus. */
    }
 
+   /* Same for the SPI busses and the SPIBusMgr AO. */
+   for( uint8_t i = 0; i < MAX_SPI_BUS; ++i ) {
+      SPIBusMgr_ctor( i );      /* Start this instance of AO for this bus. */
+   }
+
    I2C1DevMgr_ctor();
    CommMgr_ctor();
    FlashMgr_ctor();
@@ -150,6 +163,7 @@ int main(void)
    QS_OBJ_DICTIONARY(l_SerialMgrQueueSto);
    QS_OBJ_DICTIONARY(l_LWIPMgrQueueSto);
    QS_OBJ_DICTIONARY(l_I2CBusMgrQueueSto);
+   QS_OBJ_DICTIONARY(l_SPIBusMgrQueueSto);
    QS_OBJ_DICTIONARY(l_I2C1DevMgrQueueSto);
    QS_OBJ_DICTIONARY(l_CommMgrQueueSto);
    QS_OBJ_DICTIONARY(l_FlashMgrQueueSto);
@@ -208,6 +222,17 @@ int main(void)
       );
    }
 
+   /* Same for the SPI busses.  Same WARNING applies. */
+   for( uint8_t i = 0; i < MAX_SPI_BUS; ++i ) {
+      QACTIVE_START(AO_SPIBusMgr[i],
+            SPIBUS5MGR_PRIORITY + i,                                /* priority */
+            l_SPIBusMgrQueueSto[i], Q_DIM(l_SPIBusMgrQueueSto[i]), /* evt queue */
+            (void *)0, 0,                              /* per-thread stack size */
+            (QEvt *)0,                               /* no initialization event */
+            "SPIBusMgr"                                     /* Name of the task */
+      );
+   }
+
    QACTIVE_START(AO_I2C1DevMgr,
          I2C1DEVMGR_PRIORITY,                                    /* priority */
          l_I2C1DevMgrQueueSto, Q_DIM(l_I2C1DevMgrQueueSto),     /* evt queue */
@@ -239,6 +264,17 @@ int main(void)
          (QEvt *)0,                               /* no initialization event */
          "SysMgr"                                        /* Name of the task */
    );
+
+   /* If the Application staged a new FW image before the reset, install it now
+    * before QF starts running and anything else has a chance to touch flash.
+    * This has to be done after the AOs are started since the flash functions
+    * log through the event pools and SerialMgr. */
+   dbg_slow_printf("Checking for staged FW image\n");
+   DC3Error_t status = FLASH_installStagedImage();
+   if( ERR_NONE != status ) {
+      err_slow_printf("Unable to install staged FW image. Error: 0x%08x\n", status);
+   }
+
    log_slow_printf("Starting QPC. All logging from here on out shouldn't show 'SLOW'!!!\n\n");
    QF_run();                                       /* run the QF application */
 
@@ -25,6 +25,7 @@
 #include "i2c.h"                                               /* I2C support */
 #include "serial.h"
 #include "sdram.h"                          /* MT48LC2M3B2B5-7E SDRAM support */
+#include "dma_mem.h"                          /* Memory-to-memory DMA support */
 
 /* Compile-time called macros ------------------------------------------------*/
 Q_DEFINE_THIS_FILE                  /* For QSPY to know the name of this file */
@@ -81,6 +82,9 @@ void BSP_init( void )
    /* 5. Initialize the SDRAM  - this is already init in low_level startup code
    SDRAM_Init();
     */
+
+   /* 6. Initialize the memory-to-memory DMA */
+   DMA_MEM_init();
 }
 
 /******************************************************************************/
@@ -391,6 +395,7 @@ inline void BSP_SysTickCallback( void )
    QS_tickTime_ += QS_tickPeriod_;          /* account for the clock rollover */
 #endif
 
+   TIME_onTick();                         /* tie the timestamps to the RTC */
    QF_TICK(&l_SysTick_Handler);              /* process all armed time events */
 }
 
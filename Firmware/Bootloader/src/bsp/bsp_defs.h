@@ -100,6 +100,7 @@ typedef enum KernelAwareISRs {   /* ISR priorities starting from the highest urg
 	DMA2_Stream7_PRIO,
 	DMA2_Stream4_PRIO,
 	DMA2_Stream3_PRIO,
+	DMA2_Stream0_PRIO,
 	DMA1_Stream6_PRIO,
 	DMA1_Stream0_PRIO,
 	USART1_PRIO,
@@ -29,6 +29,8 @@
 #include "SerialMgr.h"                                 /* for SerialMgr types */
 #include "time.h"                          /* for processor date/time support */
 #include "i2c.h"                                /* For I2C callback functions */
+#include "spi.h"                                /* For SPI callback functions */
+#include "dma_mem.h"                     /* For memory DMA callback functions */
 #include "serial.h"                          /* For Serial callback functions */
 #include "eth_driver.h"                    /* For Ethernet callback functions */
 
@@ -153,6 +155,36 @@ void DMA1_Stream6_IRQHandler( void )
    QK_ISR_EXIT();                           /* inform QK about exiting an ISR */
 }
 
+/******************************************************************************/
+void DMA2_Stream0_IRQHandler( void )
+{
+   QK_ISR_ENTRY();                         /* inform QK about entering an ISR */
+
+   DMA_MEM_Callback(); /* Issue the callback function which does the actual work. */
+
+   QK_ISR_EXIT();                           /* inform QK about exiting an ISR */
+}
+
+/******************************************************************************/
+void DMA2_Stream3_IRQHandler( void )
+{
+   QK_ISR_ENTRY();                         /* inform QK about entering an ISR */
+
+   SPI5_DMARxCallback(); /* Issue the callback function which does the actual work. */
+
+   QK_ISR_EXIT();                           /* inform QK about exiting an ISR */
+}
+
+/******************************************************************************/
+void DMA2_Stream4_IRQHandler( void )
+{
+   QK_ISR_ENTRY();                         /* inform QK about entering an ISR */
+
+   SPI5_DMATxCallback(); /* Issue the callback function which does the actual work. */
+
+   QK_ISR_EXIT();                           /* inform QK about exiting an ISR */
+}
+
 /******************************************************************************/
 void DMA2_Stream7_IRQHandler( void )
 {
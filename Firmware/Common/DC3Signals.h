@@ -19,6 +19,8 @@
 #include "qep_port.h"
 #include "DC3CommApi.h"
 /* Exported defines ----------------------------------------------------------*/
+#define ETH_NO_SESSION        0xFFU /**< LrgDataEvt session for msgs without one */
+
 /* Exported macros -----------------------------------------------------------*/
 /* Exported types ------------------------------------------------------------*/
 
@@ -30,6 +32,8 @@ typedef struct LrgDataEvtTag {
     QEvt       super;
     DC3MsgRoute_t src;                                   /**< Source of the data */
     DC3MsgRoute_t dst;                              /**< Destination of the data */
+    uint8_t    session;   /**< UDP client session (see LWIPMgr) the data came from
+                               or goes back to.  ETH_NO_SESSION if none */
     uint16_t   dataLen;                    /**< Length of the data in dataBuf */
     uint8_t    dataBuf[DC3_MAX_MSG_LEN];       /**< Buffer that holds the data */
 } LrgDataEvt;
@@ -55,6 +59,8 @@ enum CommSignals {
    COMM_MGR_TIMEOUT_SIG,
    COMM_OP_TIMEOUT_SIG,
    MSG_PROCESS_SIG,
+   MEM_READ_NEXT_SIG,
+   COMM_HEALTH_TIMEOUT_SIG,
    BOOT_APPL_SIG,
    BOOT_RESET_SIG,
    COMM_MAX_SIG,
@@ -98,19 +104,14 @@ enum I2CBusMgrSignals {
    I2C_BUS_GLOBAL_TOUT_SIG,
    I2C_BUS_OP_TOUT_SIG,
    I2C_BUS_SETTLE_TIMER_SIG,
-   I2C_BUS_START_BIT_SIG,
-   I2C_BUS_STOP_BIT_SIG,
    I2C_BUS_SELECT_MASTER_SIG,
    I2C_BUS_SET_DIR_TX,
    I2C_BUS_SET_DIR_RX,
    I2C_BUS_SEND_7BIT_ADDR_SIG,
    I2C_BUS_SEND_10BIT_ADDR_SIG,
-   I2C_BUS_SEND_DEV_ADDR_SIG,
    I2C_BUS_READ_MEM_SIG,
    I2C_BUS_WRITE_MEM_SIG,
-   I2C_BUS_DMA_DONE_SIG,
-   I2C_BUS_ACK_EN_SIG,
-   I2C_BUS_ACK_DIS_SIG,
+   I2C_BUS_XFER_DONE_SIG,
    I2C_BUS_DONE_SIG,
    I2C_BUS_MAX_SIG
 };
@@ -127,14 +128,34 @@ enum I2C1DevMgrSignals {
    I2C1_DEV_READ_DONE_SIG,
    I2C1_DEV_WRITE_DONE_SIG,
    I2C1_DEV_PRIVATE_SIG,
+   I2C1_DEV_NEXT_REQ_SIG,
    I2C1_DEV_MAX_SIG
 };
 
+/**
+ * @enum Signals used by SPIBusMgr
+ */
+enum SPIBusMgrSignals {
+   SPI_BUS_XFER_REQ_SIG = I2C1_DEV_MAX_SIG, /** This signal must start at the previous category max signal */
+   SPI_BUS_XFER_DONE_SIG,
+   SPI_BUS_OP_TOUT_SIG,
+   SPI_BUS_DONE_SIG,
+   SPI_BUS_MAX_SIG
+};
+
+/**
+ * @enum Signals used by the memory-to-memory DMA service
+ */
+enum DMAMemSignals {
+   DMA_MEM_DONE_SIG = SPI_BUS_MAX_SIG, /** This signal must start at the previous category max signal */
+   DMA_MEM_MAX_SIG
+};
+
 /**
  * @enum Signals used by FlashMgr
  */
 enum FlashMgrSignals {
-   FLASH_OP_START_SIG = I2C1_DEV_MAX_SIG, /** This signal must start at the previous category max signal */
+   FLASH_OP_START_SIG = DMA_MEM_MAX_SIG, /** This signal must start at the previous category max signal */
    FLASH_DATA_SIG,
    FLASH_DONE_SIG,
    FLASH_ERROR_SIG,
@@ -167,6 +188,11 @@ enum SysMgrSignals {
    DB_INTRNL_FULL_RESET_SIG,
    DB_INTRNL_CHK_ELEM_SIG,
    DB_FLASH_READ_DONE_SIG,
+   DB_GET_ELEMS_SIG,
+   DB_SET_ELEMS_SIG,
+   DB_GET_ELEMS_DONE_SIG,
+   DB_SET_ELEMS_DONE_SIG,
+   DB_COMMIT_TIMEOUT_SIG,
    SYS_MGR_TIMEOUT_SIG,
    DBG_MENU_SIG,
    DBG_LOG_SIG,
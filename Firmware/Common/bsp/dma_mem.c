@@ -0,0 +1,305 @@
+/**
+ * @file    dma_mem.c
+ * @brief   Memory-to-memory DMA copy and fill service.
+ *
+ * See dma_mem.h for the description.  dma_mem_xfer.c decides what each chunk
+ * looks like, this file just programs DMA2 Stream0 with it and keeps the job
+ * queue.
+ *
+ * @date    10/19/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ *
+ * @addtogroup groupDMAMem
+ * @{
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "dma_mem.h"
+#include "bsp.h"
+#include "bsp_defs.h"
+#include "DC3Signals.h"                            /* For signal declarations */
+#include "stm32f4xx.h"
+#include "stm32f4xx_dma.h"                           /* For STM32 DMA support */
+#include "stm32f4xx_rcc.h"                           /* For STM32 RCC support */
+#include <stddef.h>
+
+/* Compile-time called macros ------------------------------------------------*/
+/* Private typedefs ----------------------------------------------------------*/
+
+/**
+ * @brief   A queued job and who to tell when it's done.
+ */
+typedef struct {
+   DMA_MemJob_t job;                                /**< What is left to move */
+   QActive      *pRequester;             /**< Who gets the done event or NULL */
+   uint32_t     tag;                            /**< Passed back in the event */
+   uint32_t     len;                              /**< Original length of job */
+   uint32_t     pattern;       /**< Fill byte in all 4 lanes. Read by the DMA */
+} DMA_MemReq_t;
+
+/* Private defines -----------------------------------------------------------*/
+#define DMA_MEM_STREAM          DMA2_Stream0    /**< Only DMA2 can do mem2mem */
+#define DMA_MEM_CHANNEL         DMA_Channel_0    /**< Ignored in mem2mem mode */
+#define DMA_MEM_IRQ             DMA2_Stream0_IRQn
+#define DMA_MEM_ALL_FLAGS       ( DMA_FLAG_TCIF0 | DMA_FLAG_HTIF0 | \
+                                  DMA_FLAG_TEIF0 | DMA_FLAG_DMEIF0 | \
+                                  DMA_FLAG_FEIF0 )
+
+/* Private macros ------------------------------------------------------------*/
+/* Private variables and Local objects ---------------------------------------*/
+static DMA_MemReq_t     l_dmaMemReqs[DMA_MEM_MAX_JOBS];   /**< Job queue ring */
+static volatile uint8_t l_dmaMemHead = 0;         /**< Job that's running now */
+static volatile uint8_t l_dmaMemCount = 0;     /**< Jobs queued incl. running */
+
+/**
+ * @brief   DMA data sizes indexed by (chunk width >> 1).
+ */
+static const uint32_t l_dmaMemPSize[] = {
+   DMA_PeripheralDataSize_Byte,
+   DMA_PeripheralDataSize_HalfWord,
+   DMA_PeripheralDataSize_Word,
+};
+static const uint32_t l_dmaMemMSize[] = {
+   DMA_MemoryDataSize_Byte,
+   DMA_MemoryDataSize_HalfWord,
+   DMA_MemoryDataSize_Word,
+};
+
+/* Private function prototypes -----------------------------------------------*/
+
+/**
+ * @brief   Start the next chunk of a job on the stream.
+ * @param [in|out] *pReq: DMA_MemReq_t pointer to the job.
+ * @return  bool: true if a chunk was started, false if the job is done.
+ */
+static bool DMA_MEM_startChunk( DMA_MemReq_t *pReq );
+
+/**
+ * @brief   Add a job to the queue and start it if the stream is idle.
+ * @param [in] *pRequester: QActive pointer to who gets the done event.
+ * @param [in] type: DMA_MemJobType_t copy or fill.
+ * @param [in] dst: uint32_t destination address.
+ * @param [in] src: uint32_t source address.  Ignored for fills.
+ * @param [in] value: uint8_t fill byte.  Ignored for copies.
+ * @param [in] len: uint32_t number of bytes.
+ * @param [in] tag: uint32_t passed back in the done event.
+ * @return  DC3Error_t: see DMA_MEM_copy() and DMA_MEM_fill().
+ */
+static DC3Error_t DMA_MEM_queueJob(
+      QActive * const pRequester,
+      const DMA_MemJobType_t type,
+      const uint32_t dst,
+      const uint32_t src,
+      const uint8_t value,
+      const uint32_t len,
+      const uint32_t tag
+);
+
+/* Private functions ---------------------------------------------------------*/
+/******************************************************************************/
+static bool DMA_MEM_startChunk( DMA_MemReq_t *pReq )
+{
+   DMA_MemChunk_t chunk;
+   if ( !DMA_MEM_nextChunk( &pReq->job, &chunk ) ) {
+      return( false );
+   }
+
+   /* The stream turns itself off at the end of the last chunk (or on error)
+    * but the flags from it are still around. */
+   DMA_ClearFlag( DMA_MEM_STREAM, DMA_MEM_ALL_FLAGS );
+
+   DMA_InitTypeDef    DMA_InitStructure;
+   DMA_InitStructure.DMA_Channel             = DMA_MEM_CHANNEL;
+   DMA_InitStructure.DMA_PeripheralBaseAddr  = chunk.src;
+   DMA_InitStructure.DMA_Memory0BaseAddr     = chunk.dst;
+   DMA_InitStructure.DMA_DIR                 = DMA_DIR_MemoryToMemory;
+   DMA_InitStructure.DMA_BufferSize          = chunk.nItems;
+   DMA_InitStructure.DMA_PeripheralInc       = chunk.bSrcInc ?
+         DMA_PeripheralInc_Enable : DMA_PeripheralInc_Disable;
+   DMA_InitStructure.DMA_MemoryInc           = DMA_MemoryInc_Enable;
+   DMA_InitStructure.DMA_PeripheralDataSize  = l_dmaMemPSize[chunk.width >> 1];
+   DMA_InitStructure.DMA_MemoryDataSize      = l_dmaMemMSize[chunk.width >> 1];
+   DMA_InitStructure.DMA_Mode                = DMA_Mode_Normal;
+   /* Let the SPI5 and USART1 streams on DMA2 win the arbitration so a big
+    * copy doesn't starve them. */
+   DMA_InitStructure.DMA_Priority            = DMA_Priority_Low;
+   /* Mem2mem can't run in direct mode.  A full FIFO is exactly one INC4 burst
+    * of words. */
+   DMA_InitStructure.DMA_FIFOMode            = DMA_FIFOMode_Enable;
+   DMA_InitStructure.DMA_FIFOThreshold       = DMA_FIFOThreshold_Full;
+   DMA_InitStructure.DMA_MemoryBurst         = chunk.bDstBurst ?
+         DMA_MemoryBurst_INC4 : DMA_MemoryBurst_Single;
+   DMA_InitStructure.DMA_PeripheralBurst     = chunk.bSrcBurst ?
+         DMA_PeripheralBurst_INC4 : DMA_PeripheralBurst_Single;
+   DMA_Init( DMA_MEM_STREAM, &DMA_InitStructure );
+
+   DMA_ITConfig( DMA_MEM_STREAM, DMA_IT_TC | DMA_IT_TE, ENABLE );
+   DMA_Cmd( DMA_MEM_STREAM, ENABLE );
+   return( true );
+}
+
+/******************************************************************************/
+static DC3Error_t DMA_MEM_queueJob(
+      QActive * const pRequester,
+      const DMA_MemJobType_t type,
+      const uint32_t dst,
+      const uint32_t src,
+      const uint8_t value,
+      const uint32_t len,
+      const uint32_t tag
+)
+{
+   DC3Error_t status = ERR_NONE;
+
+   /* The DMA ISR is the only other thing that touches the queue */
+   QF_INT_DISABLE();
+
+   if ( l_dmaMemCount >= DMA_MEM_MAX_JOBS ) {
+      status = ERR_MEM_DMA_QUEUE_FULL;
+      goto DMA_MEM_queueJob_ERR_HANDLE;   /* Stop and jump to error handling */
+   }
+
+   DMA_MemReq_t *pReq =
+         &l_dmaMemReqs[(l_dmaMemHead + l_dmaMemCount) % DMA_MEM_MAX_JOBS];
+
+   /* Fills read the pattern straight out of the job slot */
+   pReq->pattern = 0x01010101UL * value;
+   status = DMA_MEM_jobInit(
+         &pReq->job,
+         type,
+         dst,
+         DMA_MEM_JOB_FILL == type ? (uint32_t)&pReq->pattern : src,
+         len
+   );
+   if ( ERR_NONE != status ) {
+      goto DMA_MEM_queueJob_ERR_HANDLE;   /* Stop and jump to error handling */
+   }
+
+   pReq->pRequester = pRequester;
+   pReq->tag        = tag;
+   pReq->len        = len;
+
+   /* Nothing was running so nobody else is going to start it */
+   if ( 1 == ++l_dmaMemCount ) {
+      DMA_MEM_startChunk( pReq );
+   }
+
+DMA_MEM_queueJob_ERR_HANDLE:  /* Handle any error that may have occurred. */
+   QF_INT_ENABLE();
+   return( status );
+}
+
+/* Public functions ----------------------------------------------------------*/
+/******************************************************************************/
+void DMA_MEM_init( void )
+{
+   RCC_AHB1PeriphClockCmd( RCC_AHB1Periph_DMA2, ENABLE );
+
+   DMA_Cmd( DMA_MEM_STREAM, DISABLE );
+   DMA_DeInit( DMA_MEM_STREAM );
+
+   l_dmaMemHead  = 0;
+   l_dmaMemCount = 0;
+
+   NVIC_Config( DMA_MEM_IRQ, DMA2_Stream0_PRIO );
+}
+
+/******************************************************************************/
+DC3Error_t DMA_MEM_copy(
+      QActive * const pRequester,
+      void * const pDst,
+      const void * const pSrc,
+      const uint32_t len,
+      const uint32_t tag
+)
+{
+   return( DMA_MEM_queueJob(
+         pRequester,
+         DMA_MEM_JOB_COPY,
+         (uint32_t)pDst,
+         (uint32_t)pSrc,
+         0,
+         len,
+         tag
+   ) );
+}
+
+/******************************************************************************/
+DC3Error_t DMA_MEM_fill(
+      QActive * const pRequester,
+      void * const pDst,
+      const uint8_t value,
+      const uint32_t len,
+      const uint32_t tag
+)
+{
+   return( DMA_MEM_queueJob(
+         pRequester,
+         DMA_MEM_JOB_FILL,
+         (uint32_t)pDst,
+         0,
+         value,
+         len,
+         tag
+   ) );
+}
+
+/******************************************************************************/
+bool DMA_MEM_isBusy( void )
+{
+   return( 0 != l_dmaMemCount );
+}
+
+/******************************************************************************/
+/***                  Callback functions for memory DMA                     ***/
+/******************************************************************************/
+
+/******************************************************************************/
+inline void DMA_MEM_Callback( void )
+{
+   DC3Error_t status = ERR_NONE;
+
+   /* Test on DMA Stream Transfer Error interrupt */
+   if ( RESET != DMA_GetITStatus(DMA_MEM_STREAM, DMA_IT_TEIF0) ) {
+      DMA_ClearITPendingBit( DMA_MEM_STREAM, DMA_IT_TEIF0 );
+      status = ERR_MEM_DMA_TRANSFER_ERROR;
+   } else if ( RESET != DMA_GetITStatus(DMA_MEM_STREAM, DMA_IT_TCIF0) ) {
+      DMA_ClearITPendingBit( DMA_MEM_STREAM, DMA_IT_TCIF0 );
+   } else {
+      return;
+   }
+
+   if ( 0 == l_dmaMemCount ) {
+      return;                                     /* Nothing was running */
+   }
+
+   /* Keep going with the same job unless it failed or this was its last
+    * chunk. */
+   DMA_MemReq_t *pReq = &l_dmaMemReqs[l_dmaMemHead];
+   if ( ERR_NONE == status && DMA_MEM_startChunk( pReq ) ) {
+      return;
+   }
+
+   if ( NULL != pReq->pRequester ) {
+      DMAMemDoneEvt *pEvt = Q_NEW( DMAMemDoneEvt, DMA_MEM_DONE_SIG );
+      pEvt->status = status;
+      pEvt->tag    = pReq->tag;
+      pEvt->len    = pReq->len;
+      QACTIVE_POST( pReq->pRequester, (QEvt *)pEvt, pReq->pRequester );
+   }
+
+   l_dmaMemHead = (l_dmaMemHead + 1) % DMA_MEM_MAX_JOBS;
+   if ( 0 != --l_dmaMemCount ) {
+      /* A queued job always has at least one chunk */
+      DMA_MEM_startChunk( &l_dmaMemReqs[l_dmaMemHead] );
+   }
+}
+
+/**
+ * @}
+ * end addtogroup groupDMAMem
+ */
+
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
@@ -0,0 +1,155 @@
+/**
+ * @file    dma_mem.h
+ * @brief   Memory-to-memory DMA copy and fill service.
+ *
+ * Moves blocks of memory (SRAM, SDRAM, and reads out of the NOR and internal
+ * flash) with DMA2 Stream0 instead of the CPU.  A requester hands over a copy
+ * or fill job and goes on with its business.  When the job is done, the DMA ISR
+ * posts a DMA_MEM_DONE_SIG DMAMemDoneEvt back to the requester with the tag it
+ * passed in so it can tell its jobs apart.
+ *
+ * Jobs are queued and run one at a time in the order they came in.  Each job
+ * gets split into chunks that fit the alignment, burst and NDTR limits of the
+ * memory on both ends (see dma_mem_xfer.h) and the ISR chains the chunks
+ * without any help from the requester.
+ *
+ * @note: Neither end of a job is allowed to be in CCM RAM since the DMA can't
+ * get to it.  The buffers have to stay put until the done event comes back.
+ *
+ * @date    10/19/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ *
+ * @addtogroup groupDMAMem
+ * @{
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef DMA_MEM_H_
+#define DMA_MEM_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "qp_port.h"                                        /* for QP support */
+#include "DC3Errors.h"                               /* For DC3 error codes */
+#include "dma_mem_xfer.h"
+
+/* Exported defines ----------------------------------------------------------*/
+#define DMA_MEM_MAX_JOBS        8             /**< Jobs that can be queued up */
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief   Event sent back to the requester when its job is finished.
+ */
+typedef struct {
+/* protected: */
+   QEvt       super;
+
+/* public: */
+   DC3Error_t status;                                  /**< Result of the job */
+   uint32_t   tag;                      /**< Whatever the requester passed in */
+   uint32_t   len;                            /**< Number of bytes in the job */
+} DMAMemDoneEvt;
+
+/* Exported macros -----------------------------------------------------------*/
+/* Exported constants --------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief   Initialize the memory-to-memory DMA stream and its job queue.
+ *
+ * @param   None
+ * @return: None
+ */
+void DMA_MEM_init( void );
+
+/**
+ * @brief   Queue up a DMA copy.
+ *
+ * @param [in] *pRequester: QActive pointer to the AO that should get the
+ * DMAMemDoneEvt.  NULL if nobody cares when it's done.
+ * @param [out] *pDst: void pointer to where to copy to.
+ * @param [in] *pSrc: const void pointer to where to copy from.
+ * @param [in] len: const uint32_t number of bytes to copy.
+ * @param [in] tag: const uint32_t returned to the requester in the done event.
+ * @return  DC3Error_t status:
+ *    @arg ERR_NONE: job queued.  The done event has the final status.
+ *    @arg ERR_MEM_DMA_INVALID_PARAMS: zero length.
+ *    @arg ERR_MEM_DMA_INVALID_ADDR: buffer outside of DMA reachable memory.
+ *    @arg ERR_MEM_DMA_QUEUE_FULL: too many jobs queued already.
+ */
+DC3Error_t DMA_MEM_copy(
+      QActive * const pRequester,
+      void * const pDst,
+      const void * const pSrc,
+      const uint32_t len,
+      const uint32_t tag
+);
+
+/**
+ * @brief   Queue up a DMA fill.
+ *
+ * @param [in] *pRequester: QActive pointer to the AO that should get the
+ * DMAMemDoneEvt.  NULL if nobody cares when it's done.
+ * @param [out] *pDst: void pointer to the memory to fill.
+ * @param [in] value: const uint8_t value to fill the memory with.
+ * @param [in] len: const uint32_t number of bytes to fill.
+ * @param [in] tag: const uint32_t returned to the requester in the done event.
+ * @return  DC3Error_t status:
+ *    @arg ERR_NONE: job queued.  The done event has the final status.
+ *    @arg ERR_MEM_DMA_INVALID_PARAMS: zero length.
+ *    @arg ERR_MEM_DMA_INVALID_ADDR: buffer outside of DMA writable memory.
+ *    @arg ERR_MEM_DMA_QUEUE_FULL: too many jobs queued already.
+ */
+DC3Error_t DMA_MEM_fill(
+      QActive * const pRequester,
+      void * const pDst,
+      const uint8_t value,
+      const uint32_t len,
+      const uint32_t tag
+);
+
+/**
+ * @brief   Check if the DMA has any jobs queued or running.
+ *
+ * @param   None
+ * @return  bool: true if there's at least one job not done yet.
+ */
+bool DMA_MEM_isBusy( void );
+
+/******************************************************************************/
+/***                  Callback functions for memory DMA                     ***/
+/******************************************************************************/
+
+/**
+ * @brief   DMA2 Stream0 callback.
+ *
+ * Starts the next chunk of the running job or, if that was the last one, posts
+ * the done event and starts the next job in the queue.
+ *
+ * @note: this function is defined as "inline" but not declared as such.  This
+ * is so it can be called externally (by the file that contains the actual ISRs)
+ * and they can still be inlined so as not incur any function call overhead.
+ *
+ * @param   None
+ * @return: None
+ */
+void DMA_MEM_Callback( void );
+
+/**
+ * @}
+ * end addtogroup groupDMAMem
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif                                                         /* DMA_MEM_H_ */
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
@@ -0,0 +1,217 @@
+/**
+ * @file    dma_mem_xfer.c
+ * @brief   Chunk planner for memory-to-memory DMA jobs.
+ *
+ * See dma_mem_xfer.h for the description.  Nothing in here is allowed to touch
+ * the hardware or QP.  dma_mem.c does that based on the returned chunks.
+ *
+ * @date    10/19/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ *
+ * @addtogroup groupDMAMem
+ * @{
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "dma_mem_xfer.h"
+#include <stddef.h>
+
+/* Compile-time called macros ------------------------------------------------*/
+/* Private typedefs ----------------------------------------------------------*/
+
+/**
+ * @brief   A block of the memory map as seen from the DMA2 memory ports.
+ */
+typedef struct {
+   uint32_t start;                                  /**< First byte of region */
+   uint32_t end;                                     /**< Last byte of region */
+   uint8_t  flags;                                 /**< DMA_MEM_RGN_xxx flags */
+} DMA_MemRegion_t;
+
+/* Private defines -----------------------------------------------------------*/
+#define DMA_MEM_RGN_READ        0x01            /**< DMA can read from region */
+#define DMA_MEM_RGN_WRITE       0x02             /**< DMA can write to region */
+#define DMA_MEM_RGN_BURST       0x04          /**< Region handles INC4 bursts */
+
+/* Private macros ------------------------------------------------------------*/
+/* Private variables and Local objects ---------------------------------------*/
+
+/**
+ * @brief   Memory the DMA is allowed to touch.
+ *
+ * CCM RAM (0x10000000) is only on the D-bus of the core and isn't reachable by
+ * any DMA so it's left out on purpose.  The NOR is read only since writing it
+ * takes a command sequence for every halfword, and the FMC runs it as a slow
+ * asynchronous 16 bit device so there's nothing to gain from bursting it.
+ */
+static const DMA_MemRegion_t l_dmaMemRegions[] = {
+   { 0x08000000, 0x081FFFFF, DMA_MEM_RGN_READ | DMA_MEM_RGN_BURST },/* Flash */
+   { 0x20000000, 0x2002FFFF,                     /* SRAM1, SRAM2 and SRAM3 */
+         DMA_MEM_RGN_READ | DMA_MEM_RGN_WRITE | DMA_MEM_RGN_BURST },
+   { 0x60000000, 0x60FFFFFF, DMA_MEM_RGN_READ },      /* NOR on FMC bank 1 */
+   { 0xC0000000, 0xC07FFFFF,                         /* SDRAM on FMC bank 5 */
+         DMA_MEM_RGN_READ | DMA_MEM_RGN_WRITE | DMA_MEM_RGN_BURST },
+};
+
+/* Private function prototypes -----------------------------------------------*/
+
+/**
+ * @brief   Find the flags of the region that holds a whole run of bytes.
+ * @param [in] addr: uint32_t address of the first byte.
+ * @param [in] len: uint32_t number of bytes.
+ * @return  uint8_t: DMA_MEM_RGN_xxx flags of the region or 0 if the run isn't
+ * completely inside any of them.
+ */
+static uint8_t DMA_MEM_regionFlags( const uint32_t addr, const uint32_t len );
+
+/* Private functions ---------------------------------------------------------*/
+/******************************************************************************/
+static uint8_t DMA_MEM_regionFlags( const uint32_t addr, const uint32_t len )
+{
+   for ( uint8_t i = 0; i < sizeof(l_dmaMemRegions)/sizeof(*l_dmaMemRegions);
+         i++ ) {
+      const DMA_MemRegion_t *pRgn = &l_dmaMemRegions[i];
+
+      /* Written so that nothing can wrap past the end of the address space */
+      if ( addr >= pRgn->start && addr <= pRgn->end &&
+            len - 1 <= pRgn->end - addr ) {
+         return( pRgn->flags );
+      }
+   }
+   return( 0 );
+}
+
+/* Public functions ----------------------------------------------------------*/
+/******************************************************************************/
+DC3Error_t DMA_MEM_jobInit(
+      DMA_MemJob_t *pJob,
+      const DMA_MemJobType_t type,
+      const uint32_t dst,
+      const uint32_t src,
+      const uint32_t len
+)
+{
+   if ( NULL == pJob || 0 == len ) {
+      return( ERR_MEM_DMA_INVALID_PARAMS );
+   }
+
+   pJob->len = 0;                      /* Nothing to do unless it checks out */
+
+   const uint8_t dstFlags = DMA_MEM_regionFlags( dst, len );
+   if ( !(dstFlags & DMA_MEM_RGN_WRITE) ) {
+      return( ERR_MEM_DMA_INVALID_ADDR );
+   }
+
+   /* A fill only ever reads the one pattern word */
+   const uint8_t srcFlags = DMA_MEM_regionFlags(
+         src,
+         DMA_MEM_JOB_FILL == type ? sizeof(uint32_t) : len
+   );
+   if ( !(srcFlags & DMA_MEM_RGN_READ) ||
+         ( DMA_MEM_JOB_FILL == type && 0 != (src & 3) ) ) {
+      return( ERR_MEM_DMA_INVALID_ADDR );
+   }
+
+   pJob->type      = type;
+   pJob->src       = src;
+   pJob->dst       = dst;
+   pJob->len       = len;
+   pJob->bDstBurst = (0 != (dstFlags & DMA_MEM_RGN_BURST));
+
+   /* The pattern word is read in place over and over.  Bursting that is
+    * pointless so only the destination side of a fill bursts. */
+   pJob->bSrcBurst = DMA_MEM_JOB_COPY == type &&
+         (0 != (srcFlags & DMA_MEM_RGN_BURST));
+   return( ERR_NONE );
+}
+
+/******************************************************************************/
+bool DMA_MEM_nextChunk( DMA_MemJob_t *pJob, DMA_MemChunk_t *pChunk )
+{
+   if ( 0 == pJob->len ) {
+      return( false );
+   }
+
+   const bool bFill = (DMA_MEM_JOB_FILL == pJob->type);
+
+   /* How far off src and dst are from each other.  Fills don't care since the
+    * pattern is the same in every byte lane. */
+   const uint32_t skew  = bFill ? 0 : (pJob->src ^ pJob->dst);
+   const uint32_t dst   = pJob->dst;
+   const uint32_t len   = pJob->len;
+   uint32_t       nBytes;
+
+   pChunk->bSrcBurst = false;
+   pChunk->bDstBurst = false;
+
+   if ( skew & 1 ) {
+      /* The two will never line up so it's bytes all the way */
+      pChunk->width = 1;
+      nBytes        = len;
+   } else if ( dst & 1 ) {
+      /* One byte head to get both onto a halfword */
+      pChunk->width = 1;
+      nBytes        = 1;
+   } else if ( (skew & 3) || len < 4 ) {
+      /* Halfwords are as good as it gets or this is the tail */
+      pChunk->width = len < 2 ? 1 : 2;
+      nBytes        = len < 2 ? 1 : (len & ~1UL);
+   } else if ( dst & 2 ) {
+      /* One halfword head to get both onto a word */
+      pChunk->width = 2;
+      nBytes        = 2;
+   } else {
+      pChunk->width = 4;
+      nBytes        = len & ~3UL;
+
+      /* Bursts can't cross a 1KB boundary.  Keeping every burst 16 byte
+       * aligned makes sure of that so single words are used up to the first
+       * aligned address of whichever side can burst. */
+      const uint32_t alignTo = pJob->bDstBurst ? dst :
+            ( pJob->bSrcBurst ? pJob->src : 0 );
+      const uint32_t head    = (0 - alignTo) & (DMA_MEM_BURST_BYTES - 1);
+
+      if ( 0 != head ) {
+         if ( nBytes > head ) {
+            nBytes = head;
+         }
+      } else if ( nBytes >= DMA_MEM_BURST_BYTES ) {
+         pChunk->bDstBurst = pJob->bDstBurst;
+         pChunk->bSrcBurst = pJob->bSrcBurst &&
+               0 == (pJob->src & (DMA_MEM_BURST_BYTES - 1));
+         if ( pChunk->bDstBurst || pChunk->bSrcBurst ) {
+            nBytes &= ~(uint32_t)(DMA_MEM_BURST_BYTES - 1);
+         }
+      }
+   }
+
+   /* NDTR limit.  Keep it to whole bursts if bursting. */
+   uint32_t maxItems = DMA_MEM_MAX_ITEMS;
+   if ( pChunk->bDstBurst || pChunk->bSrcBurst ) {
+      maxItems &= ~(uint32_t)(DMA_MEM_BURST_BEATS - 1);
+   }
+   if ( nBytes / pChunk->width > maxItems ) {
+      nBytes = maxItems * pChunk->width;
+   }
+
+   pChunk->src     = pJob->src;
+   pChunk->dst     = dst;
+   pChunk->nItems  = (uint16_t)(nBytes / pChunk->width);
+   pChunk->bSrcInc = !bFill;
+
+   if ( !bFill ) {
+      pJob->src += nBytes;
+   }
+   pJob->dst += nBytes;
+   pJob->len -= nBytes;
+   return( true );
+}
+
+/**
+ * @}
+ * end addtogroup groupDMAMem
+ */
+
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
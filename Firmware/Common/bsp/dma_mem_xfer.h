@@ -0,0 +1,135 @@
+/**
+ * @file    dma_mem_xfer.h
+ * @brief   Chunk planner for memory-to-memory DMA jobs.
+ *
+ * A copy or fill job is an arbitrary run of bytes from one memory region to
+ * another.  The DMA can't take it in one go:
+ *    - NDTR is only 16 bits so a single stream setup moves at most 65535 items.
+ *    - The data width has to match the alignment of both addresses.
+ *    - Bursts are only allowed when neither side crosses a 1KB boundary in the
+ *    middle of a burst and the region behind the address can handle them.
+ * This module splits a job into chunks that the DMA can take as they are: a
+ * byte/halfword head up to the first aligned address, the aligned body as word
+ * transfers (INC4 bursts where allowed), and a halfword/byte tail.  It also
+ * checks that both ends of the job are in memory the DMA can actually reach.
+ *
+ * It doesn't touch any hardware.  dma_mem.c programs the stream from each chunk
+ * and asks for the next one from the transfer complete ISR.  Since there are
+ * no hardware dependencies here, the planner can also be run on a host with a
+ * plain memcpy() in place of the DMA.
+ *
+ * @date    10/19/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ *
+ * @addtogroup groupDMAMem
+ * @{
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef DMA_MEM_XFER_H_
+#define DMA_MEM_XFER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "DC3Errors.h"                               /* For DC3 error codes */
+
+/* Exported defines ----------------------------------------------------------*/
+#define DMA_MEM_MAX_ITEMS       0xFFFF     /**< NDTR limit for a single chunk */
+#define DMA_MEM_BURST_BEATS     4                 /**< Words in an INC4 burst */
+#define DMA_MEM_BURST_BYTES     (DMA_MEM_BURST_BEATS * 4)    /**< Bytes/burst */
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief   Kinds of memory jobs.
+ */
+typedef enum DMA_MemJobTypes {
+   DMA_MEM_JOB_COPY = 0,                  /**< Copy len bytes from src to dst */
+   DMA_MEM_JOB_FILL,                  /**< Write the pattern at src len times */
+} DMA_MemJobType_t;
+
+/**
+ * @brief   What is left of a memory job.
+ */
+typedef struct {
+   DMA_MemJobType_t type;                               /**< Copy or fill job */
+   uint32_t         src;          /**< Next source or address of fill pattern */
+   uint32_t         dst;                                /**< Next destination */
+   uint32_t         len;                              /**< Bytes left to move */
+   bool             bSrcBurst;                   /**< Source region can burst */
+   bool             bDstBurst;              /**< Destination region can burst */
+} DMA_MemJob_t;
+
+/**
+ * @brief   A single stream setup the DMA can take as is.
+ */
+typedef struct {
+   uint32_t src;                                 /**< Peripheral side address */
+   uint32_t dst;                                     /**< Memory side address */
+   uint16_t nItems;                              /**< NDTR, in units of width */
+   uint8_t  width;                            /**< Item size: 1, 2 or 4 bytes */
+   bool     bSrcInc;                 /**< Source increments (false for fills) */
+   bool     bSrcBurst;                          /**< INC4 burst on the source */
+   bool     bDstBurst;                     /**< INC4 burst on the destination */
+} DMA_MemChunk_t;
+
+/* Exported macros -----------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief   Set up a new memory job.
+ *
+ * Checks that the destination (and the source for copies) are completely
+ * inside a region the DMA can reach and notes whether those regions can take
+ * bursts.  For fills, src is the address of a word that holds the fill byte in
+ * all 4 lanes.
+ *
+ * @param [out] *pJob: DMA_MemJob_t pointer to the job to set up.
+ * @param [in] type: DMA_MemJobType_t type of job.
+ * @param [in] dst: uint32_t destination address.
+ * @param [in] src: uint32_t source or fill pattern address.
+ * @param [in] len: uint32_t number of bytes to copy or fill.
+ * @return  DC3Error_t status:
+ *    @arg ERR_NONE: job is ready for DMA_MEM_nextChunk().
+ *    @arg ERR_MEM_DMA_INVALID_PARAMS: NULL job or zero length.
+ *    @arg ERR_MEM_DMA_INVALID_ADDR: an end of the job is outside of DMA
+ *    reachable memory or the destination is read only.
+ */
+DC3Error_t DMA_MEM_jobInit(
+      DMA_MemJob_t *pJob,
+      const DMA_MemJobType_t type,
+      const uint32_t dst,
+      const uint32_t src,
+      const uint32_t len
+);
+
+/**
+ * @brief   Get the next chunk of a job and take it off of the job.
+ *
+ * @param [in|out] *pJob: DMA_MemJob_t pointer to the job.
+ * @param [out] *pChunk: DMA_MemChunk_t pointer to where to put the chunk.
+ * @return  bool:
+ *    @arg true: pChunk is valid and should be started.
+ *    @arg false: nothing left, the job is done.
+ */
+bool DMA_MEM_nextChunk( DMA_MemJob_t *pJob, DMA_MemChunk_t *pChunk );
+
+/**
+ * @}
+ * end addtogroup groupDMAMem
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif                                                    /* DMA_MEM_XFER_H_ */
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
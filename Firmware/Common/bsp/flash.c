@@ -13,14 +13,18 @@
 #include "flash.h"
 #include "project_includes.h"
 #include <stdio.h>
+#include <stddef.h>
+#include <string.h>
 #include "version.h"
 #include "DC3CommApi.h"
+#include "crc32compat.h"
 
 /* Compile-time called macros ------------------------------------------------*/
 DBG_DEFINE_THIS_MODULE( DC3_DBG_MODL_FLASH );/* For debug system to ID this module */
 
 /* Private typedefs ----------------------------------------------------------*/
 /* Private defines -----------------------------------------------------------*/
+#define FLASH_SLOT_COPY_CHUNK                                               1024
 /* Private macros ------------------------------------------------------------*/
 /* Private variables and Local objects ---------------------------------------*/
 /* This stores the fw version and build date to the special section of flash of
@@ -90,6 +94,15 @@ static const uint32_t FLASH_getNextSectorAddr( const uint32_t addr );
   */
 static const uint16_t FLASH_sectorAddrToFlashSect( const uint32_t addr );
 
+/**
+  * @brief  Gets the index of the sector, counting from the first sector of the
+  * Application image, that a given address falls in.
+  * @param [in] const uint32_t address for which to look up the sector
+  * @retval Index of the sector or -1 if the address is outside of the
+  * Application image flash
+  */
+static const int8_t FLASH_getApplSectorIndex( const uint32_t addr );
+
 /**
  * @brief   Read a uint8_t from flash
  * @param [in] addr: const uint32_t address where to read from
@@ -124,6 +137,49 @@ static const uint32_t FLASH_readUint32( const uint32_t addr );
  */
 static const DC3Error_t FLASH_writeUint32( const uint32_t addr, const uint32_t data );
 
+/**
+ * @brief   Fill array of sector base addresses that cover a region of flash.
+ * @param [in] startAddr: const uint32_t start address of the region.
+ * @param [in] size: const uint32_t size of the region.
+ * @param [out] *sectorArrayLoc: uint32_t pointer to the array to fill.
+ * @param [in|out] *nSectors: uint8_t pointer to how many sector base addresses
+ * are already in the array.  This gets incremented for every sector added.
+ * @param [in] sectorArraySize: const uint8_t size of sectorArrayLoc buffer.
+ * @return  DC3Error_t status:
+ *    @arg  ERR_NONE: success
+ *    @arg  other error codes if error occurred
+ */
+static const DC3Error_t FLASH_getSectorsInRange(
+      const uint32_t startAddr,
+      const uint32_t size,
+      uint32_t *sectorArrayLoc,
+      uint8_t *nSectors,
+      const uint8_t sectorArraySize
+);
+
+/**
+ * @brief   Write the Application metadata to the very end of the Application
+ * flash.
+ * The CRC is written last so a partially written set of metadata never passes
+ * the CRC check when booting the Application.
+ * @param [in] size: const uint32_t size of the image.
+ * @param [in] crc: const uint32_t CRC of the image.
+ * @param [in] maj: const uint8_t major version of the image.
+ * @param [in] min: const uint8_t minor version of the image.
+ * @param [in] *datetime: const uint8_t pointer to the build datetime of the
+ * image.  Must be FLASH_APPL_BUILD_DATETIME_LEN bytes.
+ * @return  DC3Error_t status:
+ *    @arg  ERR_NONE: success
+ *    @arg  other error codes if error occurred
+ */
+static const DC3Error_t FLASH_writeApplMetadataFields(
+      const uint32_t size,
+      const uint32_t crc,
+      const uint8_t maj,
+      const uint8_t min,
+      const uint8_t *datetime
+);
+
 /* Private functions ---------------------------------------------------------*/
 
 /******************************************************************************/
@@ -210,6 +266,28 @@ static const uint16_t FLASH_sectorAddrToFlashSect( const uint32_t addr )
    return sector;
 }
 
+/******************************************************************************/
+static const int8_t FLASH_getApplSectorIndex( const uint32_t addr )
+{
+   if( addr < FLASH_APPL_START_ADDR ||
+         addr >= FLASH_APPL_START_ADDR + MAX_APPL_FWIMAGE_SIZE ) {
+      return( -1 );
+   }
+
+   int8_t index = 0;
+   for( uint8_t i=1; i < ADDR_FLASH_SECTORS; i++ ) {
+      if( sectorArray[i-1] < FLASH_APPL_START_ADDR ) {
+         continue;
+      }
+      if( addr >= sectorArray[i-1] && addr < sectorArray[i] ) {
+         return( index );
+      }
+      index++;
+   }
+   /* We should never get here unless a very invalid address gets passed in */
+   return( -1 );
+}
+
 /******************************************************************************/
 const DC3Error_t FLASH_getSectorsToErase(
       uint32_t *sectorArrayLoc,
@@ -236,7 +314,6 @@ const DC3Error_t FLASH_getSectorsToErase(
    }
 
    uint32_t startAddr = 0;
-   uint32_t currAddr = 0;
    /* Check for a valid image type and set the correct starting address */
    if( _DC3_Application == flashImageLoc ) {
       startAddr = FLASH_APPL_START_ADDR;
@@ -247,35 +324,206 @@ const DC3Error_t FLASH_getSectorsToErase(
       return( status );
    }
 
-   /* Set the current address to the start address so that start address can be
-    * used to offset the flash image size. */
-   currAddr = startAddr;
+   *nSectors = 0; /* Clear the counter pointer so caller knows how many filled */
+
+   status = FLASH_getSectorsInRange(
+         startAddr,
+         flashImageSize,
+         sectorArrayLoc,
+         nSectors,
+         sectorArraySize
+   );
+
+   /* If we are doing application, make sure to also erase the very last sector
+    * since we store information about the application image there.  Also
+    * erase the staged slot header so that an image staged earlier doesn't get
+    * installed over the one being flashed now. */
+   if( ERR_NONE == status && _DC3_Application == flashImageLoc ) {
+      sectorArrayLoc[(*nSectors)++] = FLASH_END_ADDR_SECTOR;
+      sectorArrayLoc[(*nSectors)++] = FLASH_SLOT_HDR_ADDR;
+   }
+   return( status );
+}
+
+/******************************************************************************/
+const DC3Error_t FLASH_getStagedSectorsToErase(
+      uint32_t *sectorArrayLoc,
+      uint8_t *nSectors,
+      const uint8_t sectorArraySize,
+      const uint32_t flashImageSize
+)
+{
+   DC3Error_t status = ERR_NONE;
+
+   if ( NULL == sectorArrayLoc || NULL == nSectors ) {
+      status = ERR_MEM_NULL_VALUE;
+      ERR_printf("Sector array is NULL. Error: 0x%08x\n", status);
+      return( status );
+   }
+
+   if( sectorArraySize < ADDR_FLASH_SECTORS ) {
+      status = ERR_MEM_BUFFER_LEN;
+      ERR_printf("Sector array is not long enough. Error: 0x%08x\n", status);
+      return( status );
+   }
 
    *nSectors = 0; /* Clear the counter pointer so caller knows how many filled */
 
-   while( currAddr <= startAddr + flashImageSize ) {
-      /* Get the sector address where the current address resides*/
-      currAddr = FLASH_addrToSectorAddr( currAddr );
+   /* Erase the header first so the old staged image is invalidated before any
+    * of its data is touched. */
+   sectorArrayLoc[(*nSectors)++] = FLASH_SLOT_HDR_ADDR;
 
-      if ( 0 == currAddr ) {
+   status = FLASH_getSectorsInRange(
+         FLASH_SLOT_STAGED_START_ADDR,
+         flashImageSize,
+         sectorArrayLoc,
+         nSectors,
+         sectorArraySize
+   );
+
+   return( status );
+}
+
+/******************************************************************************/
+const DC3Error_t FLASH_getImageSectorCRCs(
+      const DC3BootMode_t flashImageLoc,
+      const uint32_t flashImageSize,
+      uint32_t *crcArray,
+      uint32_t *sizeArray,
+      uint8_t *nSectors,
+      const uint8_t arraySize
+)
+{
+   DC3Error_t status = ERR_NONE;
+
+   if ( NULL == crcArray || NULL == sizeArray || NULL == nSectors ) {
+      status = ERR_MEM_NULL_VALUE;
+      ERR_printf("CRC array is NULL. Error: 0x%08x\n", status);
+      return( status );
+   }
+
+   *nSectors = 0; /* Clear the counter pointer so caller knows how many filled */
+
+   if( _DC3_Application != flashImageLoc ) {
+      status = ERR_FLASH_IMAGE_TYPE_INVALID;
+      ERR_printf("Sector CRCs only available for Application image. Error: 0x%08x\n", status);
+      return( status );
+   }
+
+   if( 0 == flashImageSize || flashImageSize >= MAX_APPL_FWIMAGE_SIZE ) {
+      status = ERR_FLASH_IMAGE_SIZE_INVALID;
+      ERR_printf("Invalid image size %d. Error: 0x%08x\n", flashImageSize, status);
+      return( status );
+   }
+
+   uint32_t endAddr  = FLASH_APPL_START_ADDR + flashImageSize;
+   uint32_t currAddr = FLASH_APPL_START_ADDR;
+
+   while( currAddr < endAddr ) {
+      if( *nSectors >= arraySize ) {
+         status = ERR_MEM_BUFFER_LEN;
+         ERR_printf("CRC array is not long enough. Error: 0x%08x\n", status);
+         return( status );
+      }
+
+      uint32_t nextAddr = FLASH_getNextSectorAddr( currAddr );
+      if ( 0 == nextAddr ) {
          status = ERR_FLASH_SECTOR_ADDR_NOT_FOUND;
          ERR_printf(
                "Sector not found given addr 0x%08x.  Error: 0x%08x\n",
                currAddr, status
          );
+         return( status );
       }
-      DBG_printf("Addr at %d: 0x%08x\n", *nSectors, currAddr);
-      sectorArrayLoc[(*nSectors)++] = currAddr;
 
-      /* Get the address of the next sector */
-      currAddr = FLASH_getNextSectorAddr(currAddr);
+      uint32_t len = ( nextAddr < endAddr ? nextAddr : endAddr ) - currAddr;
+      sizeArray[*nSectors] = len;
+      crcArray[*nSectors]  = CRC32_Calc( (uint8_t *)currAddr, len );
+      DBG_printf("Sector %d at 0x%08x (%d bytes) CRC: 0x%08x\n",
+            *nSectors, currAddr, len, crcArray[*nSectors]);
+      (*nSectors)++;
+
+      currAddr = nextAddr;
    }
 
-   /* If we are doing application, make sure to also erase the very last sector
-    * since we store information about the application image there. */
-   if( _DC3_Application == flashImageLoc ) {
-      sectorArrayLoc[(*nSectors)++] = FLASH_END_ADDR_SECTOR;
+   return( status );
+}
+
+/******************************************************************************/
+const DC3Error_t FLASH_applySectorMask(
+      uint32_t *sectorArrayLoc,
+      uint8_t *nSectors,
+      const uint32_t flashImageSize,
+      const uint32_t sectorMask
+)
+{
+   DC3Error_t status = ERR_NONE;
+
+   if ( NULL == sectorArrayLoc || NULL == nSectors ) {
+      status = ERR_MEM_NULL_VALUE;
+      ERR_printf("Sector array is NULL. Error: 0x%08x\n", status);
+      return( status );
+   }
+
+   if( 0 == sectorMask ) {
+      return( status );                  /* Entire image is getting flashed */
+   }
+
+   /* The mask can't select sectors the image doesn't reach */
+   int8_t lastIndex = FLASH_getApplSectorIndex(
+         FLASH_APPL_START_ADDR + flashImageSize - 1
+   );
+   if( 0 == flashImageSize || lastIndex < 0 ||
+         0 != ( sectorMask >> ( lastIndex + 1 ) ) ) {
+      status = ERR_FLASH_SECTOR_MASK_INVALID;
+      ERR_printf("Sector mask 0x%08x invalid for image size %d. Error: 0x%08x\n",
+            sectorMask, flashImageSize, status);
+      return( status );
+   }
+
+   /* Compact the array in place, keeping the order */
+   uint8_t nKept = 0;
+   for( uint8_t i=0; i < *nSectors; i++ ) {
+      int8_t index = FLASH_getApplSectorIndex( sectorArrayLoc[i] );
+      if( index < 0 || ( index <= lastIndex && ( sectorMask & ( 1UL << index ) ) ) ) {
+         sectorArrayLoc[nKept++] = sectorArrayLoc[i];
+      }
+   }
+   *nSectors = nKept;
+
+   return( status );
+}
+
+/******************************************************************************/
+const DC3Error_t FLASH_getSectorMaskWriteAddr(
+      const uint32_t sectorMask,
+      const uint32_t len,
+      uint32_t *addr
+)
+{
+   DC3Error_t status = ERR_NONE;
+
+   if( 0 == sectorMask ) {
+      return( status );                     /* Entire image is being written */
+   }
+
+   int8_t index = FLASH_getApplSectorIndex( *addr );
+   while( index >= 0 && !( sectorMask & ( 1UL << index ) ) ) {
+      /* Skip over the sectors that aren't getting updated */
+      *addr = FLASH_getNextSectorAddr( *addr );
+      index = FLASH_getApplSectorIndex( *addr );
+   }
+
+   if( index < 0 ) {
+      status = ERR_FLASH_SECTOR_MASK_INVALID;
+      ERR_printf("No more sectors selected by mask 0x%08x. Error: 0x%08x\n",
+            sectorMask, status);
+   } else if( *addr + len > FLASH_getNextSectorAddr( *addr ) ) {
+      status = ERR_FLASH_SECTOR_MASK_INVALID;
+      ERR_printf("FW packet at 0x%08x (%d bytes) spans sectors. Error: 0x%08x\n",
+            *addr, len, status);
    }
+
    return( status );
 }
 
@@ -327,6 +575,9 @@ const DC3Error_t FLASH_validateMetadata(
       status = ERR_FLASH_INVALID_DATETIME_LEN;
    } else if ( fwMetadata->_imageDatetime[0] != '2' &&  fwMetadata->_imageDatetime[0] != '0' ) {
       status = ERR_FLASH_INVALID_DATETIME;
+   } else if ( fwMetadata->_imageCompression != _DC3_COMPRESSION_NONE &&
+         fwMetadata->_imageCompression != _DC3_COMPRESSION_LZSS ) {
+      status = ERR_FLASH_COMPRESSION_INVALID;
    } else if ( fwMetadata->_imageType == _DC3_Application ) {
       /* Make sure that the image is not bigger than the total available flash */
       if ( 0 == fwMetadata->_imageSize ||
@@ -513,6 +764,275 @@ const DC3Error_t FLASH_readBufferUint8(
    return( ERR_NONE );
 }
 
+/******************************************************************************/
+const DC3Error_t FLASH_writeApplMetadata(
+      const struct DC3FlashMetaPayloadMsg const *fwMetadata
+)
+{
+   if( NULL == fwMetadata ) {
+      return( ERR_MEM_NULL_VALUE );
+   }
+
+   if( fwMetadata->_imageDatetime_len != FLASH_APPL_BUILD_DATETIME_LEN ) {
+      return( ERR_FLASH_INVALID_DATETIME_LEN );
+   }
+
+   return(
+         FLASH_writeApplMetadataFields(
+               fwMetadata->_imageSize,
+               fwMetadata->_imageCrc,
+               fwMetadata->_imageMaj,
+               fwMetadata->_imageMin,
+               (const uint8_t *)fwMetadata->_imageDatetime
+         )
+   );
+}
+
+/******************************************************************************/
+const FlashSlotHdr_t *FLASH_getSlotHdr( void )
+{
+   return( (const FlashSlotHdr_t *)FLASH_SLOT_HDR_ADDR );
+}
+
+/******************************************************************************/
+const DC3Error_t FLASH_writeSlotHdr(
+      const struct DC3FlashMetaPayloadMsg const *fwMetadata
+)
+{
+   if( NULL == fwMetadata ) {
+      return( ERR_MEM_NULL_VALUE );
+   }
+
+   if( fwMetadata->_imageDatetime_len != DC3_DATETIME_LEN ) {
+      return( ERR_FLASH_INVALID_DATETIME_LEN );
+   }
+
+   FlashSlotHdr_t hdr;
+   memset( &hdr, 0xFF, sizeof(hdr) );
+   hdr.magic     = FLASH_SLOT_HDR_MAGIC;
+   hdr.imageSize = fwMetadata->_imageSize;
+   hdr.imageCrc  = fwMetadata->_imageCrc;
+   hdr.imageMaj  = fwMetadata->_imageMaj;
+   hdr.imageMin  = fwMetadata->_imageMin;
+   MEMCPY( hdr.imageDatetime, fwMetadata->_imageDatetime, DC3_DATETIME_LEN );
+
+   /* Write everything up to (but not including) the marks */
+   uint16_t bytesWritten = 0;
+   DC3Error_t status = FLASH_writeBuffer(
+         FLASH_SLOT_HDR_ADDR,
+         (const uint8_t *)&hdr,
+         offsetof(FlashSlotHdr_t, stagedMark),
+         &bytesWritten
+   );
+
+   if( ERR_NONE != status ) {
+      ERR_printf("Unable to write slot header. Error: 0x%08x\n", status);
+      return( status );
+   }
+
+   /* This is what makes the staged image visible to the Bootloader */
+   return(
+         FLASH_writeUint32(
+               FLASH_SLOT_HDR_ADDR + offsetof(FlashSlotHdr_t, stagedMark),
+               FLASH_SLOT_MARK
+         )
+   );
+}
+
+/******************************************************************************/
+const DC3Error_t FLASH_installStagedImage( void )
+{
+   DC3Error_t status = ERR_NONE;
+   const FlashSlotHdr_t *hdr = FLASH_getSlotHdr();
+
+   FlashSlotAction_t action = FLASH_SLOT_selectAction(
+         hdr,
+         (const uint8_t *)FLASH_SLOT_STAGED_START_ADDR,
+         (const uint8_t *)FLASH_SLOT_ACTIVE_START_ADDR,
+         CRC32_Calc
+   );
+
+   if( FLASH_SLOT_BOOT_ACTIVE == action ) {
+      return( status );
+   }
+
+   FLASH_Unlock();
+
+   if( FLASH_SLOT_DISCARD_STAGED == action ) {
+      status = ERR_FLASH_STAGED_IMAGE_INVALID;
+      ERR_printf("Staged FW image (size: %d, CRC: 0x%08x) is invalid, discarding. Error: 0x%08x\n",
+            hdr->imageSize, hdr->imageCrc, status);
+
+   } else if( FLASH_SLOT_INSTALL_STAGED == action ) {
+      LOG_printf("Installing staged FW image v%02d.%02d (size: %d, CRC: 0x%08x)\n",
+            hdr->imageMaj, hdr->imageMin, hdr->imageSize, hdr->imageCrc);
+
+      uint32_t sectors[ADDR_FLASH_SECTORS];
+      uint8_t nSectors = 0;
+      status = FLASH_getSectorsInRange(
+            FLASH_SLOT_ACTIVE_START_ADDR,
+            hdr->imageSize,
+            sectors,
+            &nSectors,
+            ADDR_FLASH_SECTORS
+      );
+      sectors[nSectors++] = FLASH_END_ADDR_SECTOR;
+
+      for( uint8_t i = 0; ERR_NONE == status && i < nSectors; i++ ) {
+         status = FLASH_eraseSector( sectors[i] );
+      }
+
+      for( uint32_t offset = 0; ERR_NONE == status && offset < hdr->imageSize;
+            offset += FLASH_SLOT_COPY_CHUNK ) {
+         uint16_t bytesWritten = 0;
+         uint32_t len = hdr->imageSize - offset;
+         if( len > FLASH_SLOT_COPY_CHUNK ) {
+            len = FLASH_SLOT_COPY_CHUNK;
+         }
+         status = FLASH_writeBuffer(
+               FLASH_SLOT_ACTIVE_START_ADDR + offset,
+               (const uint8_t *)(FLASH_SLOT_STAGED_START_ADDR + offset),
+               len,
+               &bytesWritten
+         );
+      }
+
+      if( ERR_NONE == status ) {
+         uint32_t crcCheck = CRC32_Calc(
+               (const uint8_t *)FLASH_SLOT_ACTIVE_START_ADDR,
+               hdr->imageSize
+         );
+         if( crcCheck != hdr->imageCrc ) {
+            status = ERR_FLASH_INVALID_IMAGE_CRC_AFTER_FLASH;
+            ERR_printf("CRC check failed after install. Expected: 0x%08x, calculated: 0x%08x. Error: 0x%08x\n",
+                  hdr->imageCrc, crcCheck, status);
+         }
+      }
+
+      if( ERR_NONE == status ) {
+         status = FLASH_writeApplMetadataFields(
+                  hdr->imageSize,
+                  hdr->imageCrc,
+                  hdr->imageMaj,
+                  hdr->imageMin,
+                  hdr->imageDatetime
+            );
+      }
+
+   } else if( FLASH_SLOT_MARK_INSTALLED == action ) {
+      /* Image was copied on a previous boot.  Only redo the metadata if it
+       * didn't make it to flash (CRC is always written last). */
+      LOG_printf("Staged FW image already in active slot, finishing install\n");
+      if( FLASH_readApplCRC() != hdr->imageCrc ) {
+         status = FLASH_eraseSector( FLASH_END_ADDR_SECTOR );
+         if( ERR_NONE == status ) {
+            status = FLASH_writeApplMetadataFields(
+                  hdr->imageSize,
+                  hdr->imageCrc,
+                  hdr->imageMaj,
+                  hdr->imageMin,
+                  hdr->imageDatetime
+            );
+         }
+      }
+   }
+
+   /* Mark the staged image as consumed unless the install itself failed, in
+    * which case it will be retried on the next boot. */
+   if( ERR_NONE == status || ERR_FLASH_STAGED_IMAGE_INVALID == status ) {
+      DC3Error_t markStatus = FLASH_writeUint32(
+            FLASH_SLOT_HDR_ADDR + offsetof(FlashSlotHdr_t, installedMark),
+            FLASH_SLOT_MARK
+      );
+      if( ERR_NONE == status ) {
+         status = markStatus;
+      }
+   }
+
+   FLASH_Lock();
+
+   if( ERR_NONE == status ) {
+      LOG_printf("Successfully installed staged FW image\n");
+   }
+   return( status );
+}
+
+/******************************************************************************/
+static const DC3Error_t FLASH_getSectorsInRange(
+      const uint32_t startAddr,
+      const uint32_t size,
+      uint32_t *sectorArrayLoc,
+      uint8_t *nSectors,
+      const uint8_t sectorArraySize
+)
+{
+   DC3Error_t status = ERR_NONE;
+
+   /* Set the current address to the start address so that start address can be
+    * used to offset the flash image size. */
+   uint32_t currAddr = startAddr;
+
+   while( currAddr <= startAddr + size ) {
+      /* Get the sector address where the current address resides*/
+      currAddr = FLASH_addrToSectorAddr( currAddr );
+
+      if ( 0 == currAddr ) {
+         status = ERR_FLASH_SECTOR_ADDR_NOT_FOUND;
+         ERR_printf(
+               "Sector not found given addr 0x%08x.  Error: 0x%08x\n",
+               currAddr, status
+         );
+         return( status );
+      }
+
+      /* Leave room for the extra sectors callers append */
+      if( *nSectors + 2 >= sectorArraySize ) {
+         status = ERR_MEM_BUFFER_LEN;
+         ERR_printf("Sector array is not long enough. Error: 0x%08x\n", status);
+         return( status );
+      }
+      DBG_printf("Addr at %d: 0x%08x\n", *nSectors, currAddr);
+      sectorArrayLoc[(*nSectors)++] = currAddr;
+
+      /* Get the address of the next sector */
+      currAddr = FLASH_getNextSectorAddr(currAddr);
+   }
+
+   return( status );
+}
+
+/******************************************************************************/
+static const DC3Error_t FLASH_writeApplMetadataFields(
+      const uint32_t size,
+      const uint32_t crc,
+      const uint8_t maj,
+      const uint8_t min,
+      const uint8_t *datetime
+)
+{
+   DC3Error_t status = FLASH_writeApplSize( size );
+   if( ERR_NONE == status ) {
+      status = FLASH_writeApplMajVer( maj );
+   }
+   if( ERR_NONE == status ) {
+      status = FLASH_writeApplMinVer( min );
+   }
+   if( ERR_NONE == status ) {
+      status = FLASH_writeApplBuildDatetime(
+            datetime,
+            FLASH_APPL_BUILD_DATETIME_LEN
+      );
+   }
+   if( ERR_NONE == status ) {
+      status = FLASH_writeApplCRC( crc );
+   }
+
+   if( ERR_NONE != status ) {
+      ERR_printf("Unable to write Application metadata. Error: 0x%08x\n", status);
+   }
+   return( status );
+}
+
 /******************************************************************************/
 static const uint8_t FLASH_readUint8( const uint32_t addr )
 {
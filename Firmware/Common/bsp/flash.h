@@ -19,6 +19,7 @@
 #include "project_includes.h"
 //#include "flash_info.h"
 #include "DC3CommApi.h"
+#include "flash_slot.h"                /* For staged Application FW slots */
 
 /* Exported defines ----------------------------------------------------------*/
 /* These defines specify where the various flash regions start and end on the
@@ -76,7 +77,7 @@
 #define ADDR_FLASH_SECTOR_23    ((uint32_t)0x081E0000) /**< Addr of Sect 23, 128 KB */
 
 #define ADDR_FLASH_SECTORS       24 /**< Number of sectors in the flash */
-#define MAX_APPL_FWIMAGE_SIZE    0x0001AFFFF /**< Max size of fw image (~1.76 MB) */
+#define MAX_APPL_FWIMAGE_SIZE    FLASH_SLOT_SIZE /**< Max size of fw image (768 KB) */
 
 /* Exported macros -----------------------------------------------------------*/
 /* Exported types ------------------------------------------------------------*/
@@ -112,6 +113,112 @@ const DC3Error_t FLASH_getSectorsToErase(
       const uint32_t flashImageSize
 );
 
+/**
+ * @brief   Find and fill array of sector base addresses of the staged slot.
+ *
+ * Same as FLASH_getSectorsToErase() but for an Application FW image that is
+ * going into the staged slot.  The sector holding the slot header is included
+ * so that any previously staged image is invalidated by the erase.
+ *
+ * @param [out] *sectorArrayLoc: uint32_t pointer to the array to fill with
+ * sector base addresses that are found to erase.
+ * @param [out] *nSectors: uint8_t pointer to how many sector base addresses are
+ * found.
+ * @param [in] sectorArraySize: const uint8_t size of sectorArrayLoc buffer.
+ * @param [in] flashImageSize: const uint32_t that specifies the size of the FW
+ * image.
+ * @return  DC3Error_t status:
+ *    @arg  ERR_NONE: success
+ *    @arg  other error codes if error occurred
+ */
+const DC3Error_t FLASH_getStagedSectorsToErase(
+      uint32_t *sectorArrayLoc,
+      uint8_t *nSectors,
+      const uint8_t sectorArraySize,
+      const uint32_t flashImageSize
+);
+
+/**
+ * @brief   Get the CRC of each flash sector holding part of a FW image.
+ *
+ * Sectors are counted from the start of the image so the first CRC is always
+ * for the first sector of the image.  Every CRC covers a full sector except the
+ * last one which only covers up to imageSize bytes from the start of the image.
+ * This lets the client compare the CRCs against the same ranges of a new image
+ * to find which sectors need to be flashed.
+ *
+ * @param [in] flashImageLoc: const DC3BootMode_t that specifies which FW image.
+ *    @arg _DC3_Application: only the Application image is currently supported.
+ * @param [in] flashImageSize: const uint32_t size of the (new) FW image.
+ * @param [out] *crcArray: uint32_t pointer to the array to fill with CRCs.
+ * @param [out] *sizeArray: uint32_t pointer to the array to fill with how many
+ * bytes each CRC covers.
+ * @param [out] *nSectors: uint8_t pointer to how many CRCs were filled in.
+ * @param [in] arraySize: const uint8_t size of crcArray and sizeArray buffers.
+ * @return  DC3Error_t status:
+ *    @arg  ERR_NONE: success
+ *    @arg  other error codes if error occurred
+ */
+const DC3Error_t FLASH_getImageSectorCRCs(
+      const DC3BootMode_t flashImageLoc,
+      const uint32_t flashImageSize,
+      uint32_t *crcArray,
+      uint32_t *sizeArray,
+      uint8_t *nSectors,
+      const uint8_t arraySize
+);
+
+/**
+ * @brief   Remove the image sectors that don't need to be updated from the
+ * list of sectors to erase.
+ *
+ * Bit N of the mask selects the Nth sector of the image (same order as returned
+ * by FLASH_getImageSectorCRCs()).  Sectors that are not part of the image, such
+ * as the one holding the Application metadata, are always left in the list.
+ *
+ * @param [in|out] *sectorArrayLoc: uint32_t pointer to the array filled in by
+ * FLASH_getSectorsToErase().
+ * @param [in|out] *nSectors: uint8_t pointer to how many sector base addresses
+ * are in sectorArrayLoc.
+ * @param [in] flashImageSize: const uint32_t size of the FW image.
+ * @param [in] sectorMask: const uint32_t bitfield of image sectors to keep.
+ *    @note: 0 keeps all the sectors (entire image is being flashed).
+ * @return  DC3Error_t status:
+ *    @arg  ERR_NONE: success
+ *    @arg  ERR_FLASH_SECTOR_MASK_INVALID: mask selects sectors past the image
+ *    @arg  other error codes if error occurred
+ */
+const DC3Error_t FLASH_applySectorMask(
+      uint32_t *sectorArrayLoc,
+      uint8_t *nSectors,
+      const uint32_t flashImageSize,
+      const uint32_t sectorMask
+);
+
+/**
+ * @brief   Get the address where the next FW data packet of a partial (delta)
+ * FW update should be written.
+ *
+ * If the current address is in an image sector that isn't selected by the mask,
+ * it gets moved up to the start of the next selected sector.  Packets are not
+ * allowed to span sectors since the data for the following sector may not be
+ * sent at all.
+ *
+ * @param [in] sectorMask: const uint32_t bitfield of image sectors being sent.
+ *    @note: 0 means the entire image is being sent and the address is left as is.
+ * @param [in] len: const uint32_t length of the packet to write.
+ * @param [in|out] *addr: uint32_t pointer to the current write address.
+ * @return  DC3Error_t status:
+ *    @arg  ERR_NONE: success
+ *    @arg  ERR_FLASH_SECTOR_MASK_INVALID: no selected sector left or packet
+ *    spans two sectors
+ */
+const DC3Error_t FLASH_getSectorMaskWriteAddr(
+      const uint32_t sectorMask,
+      const uint32_t len,
+      uint32_t *addr
+);
+
 /**
  * @brief   Erase flash section reserved for the specified FW image.
  * @param [in] sectorAddr: const uint32_t sector base address that specifies
@@ -278,5 +385,65 @@ const DC3Error_t FLASH_writeApplBuildDatetime(
       const uint8_t bufferSize
 );
 
+/**
+ * @brief   Write all the Application metadata to the very end of the
+ * Application flash.
+ *
+ * The CRC is written last so that if the write is interrupted, the Application
+ * image will fail the CRC check instead of being booted with bad metadata.
+ *
+ * @param [in] *fwMetadata: const struct DC3FlashMetaPayloadMsg const pointer
+ * to the fw image metadata.
+ * @return  DC3Error_t status:
+ *    @arg  ERR_NONE: success
+ *    @arg  other error codes if error occurred
+ */
+const DC3Error_t FLASH_writeApplMetadata(
+      const struct DC3FlashMetaPayloadMsg const *fwMetadata
+);
+
+/**
+ * @brief   Get the slot header describing the staged Application FW image.
+ * @param   None
+ * @return  FlashSlotHdr_t const pointer to the header in flash.
+ */
+const FlashSlotHdr_t *FLASH_getSlotHdr( void );
+
+/**
+ * @brief   Write the slot header describing the staged Application FW image.
+ *
+ * All the fields are written first and the staged mark is written last so the
+ * Bootloader will never see a partially written header as valid.  The header
+ * sector has to be erased before calling this function.
+ *
+ * @param [in] *fwMetadata: const struct DC3FlashMetaPayloadMsg const pointer
+ * to the metadata of the image that was written to the staged slot.
+ * @return  DC3Error_t status:
+ *    @arg  ERR_NONE: success
+ *    @arg  other error codes if error occurred
+ */
+const DC3Error_t FLASH_writeSlotHdr(
+      const struct DC3FlashMetaPayloadMsg const *fwMetadata
+);
+
+/**
+ * @brief   Install the staged Application FW image if one is pending.
+ *
+ * Meant to be called by the Bootloader on startup before any AOs are running.
+ * If a valid image is staged, the active slot and the Application metadata
+ * sector are erased, the staged image is copied over, the metadata is written,
+ * and finally the slot header is marked as installed.  If power is lost at any
+ * point, the next call will pick up and redo the install since the staged
+ * slot is never modified.  This is a blocking operation.
+ *
+ * @param   None
+ * @return  DC3Error_t status:
+ *    @arg  ERR_NONE: success or nothing to install
+ *    @arg  ERR_FLASH_STAGED_IMAGE_INVALID: staged image failed validation and
+ *    was discarded
+ *    @arg  other error codes if error occurred
+ */
+const DC3Error_t FLASH_installStagedImage( void );
+
 #endif                                                            /* FLASH_H_ */
 /******** Copyright (C) 2015 Harry Rostovtsev. All rights reserved *****END OF FILE****/
@@ -0,0 +1,73 @@
+/**
+ * @file    flash_slot.c
+ * @brief   Contains implementation of the selection logic for the staged (A/B)
+ * Application FW image slots.
+ *
+ * @date    10/18/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "flash_slot.h"
+#include <stddef.h>
+
+/* Compile-time called macros ------------------------------------------------*/
+/* Private typedefs ----------------------------------------------------------*/
+/* Private defines -----------------------------------------------------------*/
+/* Private macros ------------------------------------------------------------*/
+/* Private variables and Local objects ---------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Private functions ---------------------------------------------------------*/
+
+/******************************************************************************/
+bool FLASH_SLOT_isPending( const FlashSlotHdr_t *hdr )
+{
+   if ( NULL == hdr ) {
+      return( false );
+   }
+
+   return(
+         FLASH_SLOT_HDR_MAGIC == hdr->magic &&
+         FLASH_SLOT_MARK == hdr->stagedMark &&
+         FLASH_SLOT_ERASED == hdr->installedMark
+   );
+}
+
+/******************************************************************************/
+FlashSlotAction_t FLASH_SLOT_selectAction(
+      const FlashSlotHdr_t *hdr,
+      const uint8_t *stagedImage,
+      const uint8_t *activeImage,
+      FlashSlotCrcFn_t crcFn
+)
+{
+   if ( !FLASH_SLOT_isPending( hdr ) ) {
+      return( FLASH_SLOT_BOOT_ACTIVE );
+   }
+
+   if ( NULL == stagedImage || NULL == activeImage || NULL == crcFn ) {
+      return( FLASH_SLOT_BOOT_ACTIVE );
+   }
+
+   if ( 0 == hdr->imageSize || hdr->imageSize > FLASH_SLOT_SIZE ||
+         0 == hdr->imageCrc || FLASH_SLOT_ERASED == hdr->imageCrc ) {
+      return( FLASH_SLOT_DISCARD_STAGED );
+   }
+
+   /* The staged image is never modified by the install so if the active slot
+    * already matches, the previous install completed and only the mark is
+    * missing. */
+   if ( hdr->imageCrc == crcFn( activeImage, hdr->imageSize ) ) {
+      return( FLASH_SLOT_MARK_INSTALLED );
+   }
+
+   if ( hdr->imageCrc != crcFn( stagedImage, hdr->imageSize ) ) {
+      return( FLASH_SLOT_DISCARD_STAGED );
+   }
+
+   return( FLASH_SLOT_INSTALL_STAGED );
+}
+
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
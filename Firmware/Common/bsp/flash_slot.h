@@ -0,0 +1,121 @@
+/**
+ * @file    flash_slot.h
+ * @brief   Contains the layout and the selection logic for the staged (A/B)
+ * Application FW image slots on the DC3 (STM32F4 with 2MB of dual bank flash)
+ *
+ * The Application runs from the active slot in bank 1.  While it keeps running,
+ * it can receive a new FW image into the staged slot in bank 2 (read while
+ * write is supported across banks) and then write a slot header describing it.
+ * On the next reboot, the Bootloader looks at the slot header, checks the CRC
+ * of the staged image, and copies it over the active slot.
+ *
+ * This file has no dependencies on the STM32 hardware so the selection logic
+ * can be built and exercised on a host against a simulated flash backend.
+ *
+ * @date    10/18/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef FLASH_SLOT_H_
+#define FLASH_SLOT_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "DC3CommApi.h"
+
+/* Exported defines ----------------------------------------------------------*/
+/* Flash slot layout:
+ * Sect 6  - 11 (bank 1): active Application slot (runs from here)
+ * Sect 12 - 15 (bank 2): unused
+ * Sect 16      (bank 2): staged slot header
+ * Sect 17 - 22 (bank 2): staged Application slot
+ * Sect 23      (bank 2): active Application metadata (size, CRC, version) */
+#define FLASH_SLOT_ACTIVE_START_ADDR      ((uint32_t)0x08040000) /**< Sect 6  */
+#define FLASH_SLOT_STAGED_START_ADDR      ((uint32_t)0x08120000) /**< Sect 17 */
+#define FLASH_SLOT_HDR_ADDR               ((uint32_t)0x08110000) /**< Sect 16 */
+#define FLASH_SLOT_SIZE                   ((uint32_t)0x000C0000) /**< 6x128KB */
+
+#define FLASH_SLOT_HDR_MAGIC              ((uint32_t)0x544F4C53) /**< "SLOT" */
+#define FLASH_SLOT_MARK                   ((uint32_t)0xA5A5A5A5)
+#define FLASH_SLOT_ERASED                 ((uint32_t)0xFFFFFFFF)
+
+/* Exported macros -----------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief   Header stored in front of the staged slot describing its image.
+ *
+ * The marks can only be programmed once after an erase (flash bits only go from
+ * 1 to 0) which makes each of them an atomic flag:
+ *    stagedMark is written last by the Application after all the other fields
+ *    so a partially written header is never considered valid.
+ *    installedMark is written by the Bootloader once the staged image has been
+ *    copied into the active slot and the active metadata has been updated.
+ */
+typedef struct {
+   uint32_t magic;                          /**< FLASH_SLOT_HDR_MAGIC if valid */
+   uint32_t imageSize;                         /**< Size of the staged image */
+   uint32_t imageCrc;                           /**< CRC of the staged image */
+   uint8_t  imageMaj;                 /**< Major version of the staged image */
+   uint8_t  imageMin;                 /**< Minor version of the staged image */
+   uint8_t  imageDatetime[DC3_DATETIME_LEN];/**< Build datetime of the image */
+   uint32_t stagedMark;          /**< FLASH_SLOT_MARK once staging completes */
+   uint32_t installedMark;     /**< FLASH_SLOT_MARK once install completes */
+} FlashSlotHdr_t;
+
+/**
+ * @brief   What the Bootloader should do with the staged slot on startup.
+ */
+typedef enum {
+   FLASH_SLOT_BOOT_ACTIVE = 0,    /**< Nothing staged, leave active slot alone */
+   FLASH_SLOT_INSTALL_STAGED,         /**< Valid image staged, copy to active */
+   FLASH_SLOT_DISCARD_STAGED,     /**< Staged image is corrupt, don't install */
+   FLASH_SLOT_MARK_INSTALLED,  /**< Copy already done but not marked as such */
+} FlashSlotAction_t;
+
+/**
+ * @brief   CRC function used to check images.  On the target this is
+ * CRC32_Calc() which uses the STM32 CRC hardware.
+ */
+typedef uint32_t (*FlashSlotCrcFn_t)( const uint8_t *buffer, uint32_t size );
+
+/* Exported constants --------------------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief   Check whether a slot header describes a staged image that has not
+ * been installed yet.
+ * @param [in] *hdr: const FlashSlotHdr_t pointer to the slot header.
+ * @return  bool: true if an image is waiting to be installed, false otherwise.
+ */
+bool FLASH_SLOT_isPending( const FlashSlotHdr_t *hdr );
+
+/**
+ * @brief   Decide what to do with the staged slot.
+ *
+ * A pending image is only installed if its size fits into a slot and its CRC
+ * matches the one in the header.  If the active slot already holds the staged
+ * image (power was lost after the copy but before installedMark was written),
+ * the install is only marked as done.
+ *
+ * @param [in] *hdr: const FlashSlotHdr_t pointer to the slot header.
+ * @param [in] *stagedImage: const uint8_t pointer to the start of the staged
+ * slot.
+ * @param [in] *activeImage: const uint8_t pointer to the start of the active
+ * slot.
+ * @param [in] crcFn: FlashSlotCrcFn_t function used to calculate image CRCs.
+ * @return  FlashSlotAction_t: action the caller should take.
+ */
+FlashSlotAction_t FLASH_SLOT_selectAction(
+      const FlashSlotHdr_t *hdr,
+      const uint8_t *stagedImage,
+      const uint8_t *activeImage,
+      FlashSlotCrcFn_t crcFn
+);
+
+#endif                                                       /* FLASH_SLOT_H_ */
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
@@ -61,6 +61,28 @@ DBG_DEFINE_THIS_MODULE( DC3_DBG_MODL_I2C_DEV ); /* For debug system to ID this m
 
 /* Private typedefs ----------------------------------------------------------*/
 
+/**
+ * @brief   Copy of an I2C request that is waiting for the bus.
+ */
+typedef struct {
+    QSignal         sig;       /**< I2C1_DEV_RAW_MEM_READ or I2C1_DEV_RAW_MEM_WRITE */
+    I2C_Priority_t  priority;                    /**< Priority of the request */
+    DC3I2CDevice_t  i2cDev;                   /**< Which I2C device to access */
+    DC3AccessType_t accessType;    /**< Where the done event has to be sent */
+    uint16_t        addr;      /**< Internal memory address, including the base */
+    uint16_t        bytes;             /**< How many bytes to read or write */
+    uint8_t         dataBuf[MAX_I2C_WRITE_LEN];  /**< Data to write (writes only) */
+} I2C1DevReq_t;
+
+/**
+ * @brief   One of the read requests served by the read that is on the bus.
+ */
+typedef struct {
+    DC3AccessType_t accessType;    /**< Where the done event has to be sent */
+    uint16_t        addr;      /**< Internal memory address, including the base */
+    uint16_t        bytes;                      /**< How many bytes it wants */
+} I2C1DevReader_t;
+
 /**
  * @brief I2C1DevMgr Active Object (AO) "class" that manages the all the I2C
  * devices on the I2C1 Bus.
@@ -75,11 +97,12 @@ typedef struct {
 /* protected: */
     QActive super;
 
-    /**< Native QF queue for deferred request events. */
-    QEQueue deferredEvtQueue;
+    /**< Requests waiting for the bus.  They are kept in the order they came in and
+     * I2C1DevMgr_startNextReq() picks which one runs next. */
+    I2C1DevReq_t reqs[MAX_I2C_PENDING_REQS];
 
-    /**< Storage for deferred event queue. */
-    QEvt const * deferredEvtQSto[100];
+    /**< Number of requests waiting in the reqs queue */
+    uint8_t nReqs;
 
     /**< Specifies which I2CBus1 device is currently being handled by this AO.
      * This should be set when a new I2C_READ_START or I2C_WRITE_START events come
@@ -151,10 +174,16 @@ typedef struct {
     /**< Keep track of the index into the buffer of data when writing several pages */
     uint8_t writeBufferIndex;
 
-    /**< This is a state machine pointer to an event that will be allocated upon entry
-     * into the busy state by the I2C1_DEV_RAW_MEM_READ signal and used to store the read
-     * i2c data in ReadMem state.  This allows not having a static buffer hanging around.*/
-    I2CReadDoneEvt* i2cReadDoneEvt;
+    /**< Read requests that were merged into the read that is currently on the bus.
+     * Each one gets its own ReadDone evt with its part of the data on exit from the
+     * Busy state. */
+    I2C1DevReader_t readers[MAX_I2C_PENDING_REQS];
+
+    /**< Number of read requests in the readers array */
+    uint8_t nReaders;
+
+    /**< Number of bytes that actually came back from the current read */
+    uint16_t bytesRead;
 
     /**< This is a state machine pointer to an event that will be allocated upon entry
      * into the busy state by the I2C1_DEV_RAW_MEM_WRITE signal and used to send a done
@@ -179,8 +208,8 @@ static QState I2C1DevMgr_Active(I2C1DevMgr * const me, QEvt const * const e);
 
 /**
  * @brief   This state indicates that the I2C is currently busy and cannot
- * process incoming data; incoming events will be deferred in this state and
- * handled once the AO goes back to Idle state.
+ * process incoming data; incoming requests will be queued up in this state and
+ * handled by priority once the AO goes back to Idle state.
  *
  * @param  [in,out] me: Pointer to the state machine
  * @param  [in,out] e:  Pointer to the event being processed.
@@ -189,60 +218,6 @@ static QState I2C1DevMgr_Active(I2C1DevMgr * const me, QEvt const * const e);
  */
 static QState I2C1DevMgr_Busy(I2C1DevMgr * const me, QEvt const * const e);
 
-/**
- * @brief   This state sends the start bit on the I2C bus.
- *
- * @param  [in,out] me: Pointer to the state machine
- * @param  [in,out] e:  Pointer to the event being processed.
- * @return status: QState type that specifies where the state
- * machine is going next.
- */
-static QState I2C1DevMgr_GenerateStart(I2C1DevMgr * const me, QEvt const * const e);
-
-/**
- * @brief   This state sends an address of the I2C device to select the device and
- * selects the TRANSMITTER mode.
- *
- * @param  [in,out] me: Pointer to the state machine
- * @param  [in,out] e:  Pointer to the event being processed.
- * @return status: QState type that specifies where the state
- * machine is going next.
- */
-static QState I2C1DevMgr_Send7BitAddrTxMode(I2C1DevMgr * const me, QEvt const * const e);
-
-/**
- * @brief   This state sends the internal memory address of the selected I2C device
- * that tells the device where the read or write will happen.
- *
- * @param  [in,out] me: Pointer to the state machine
- * @param  [in,out] e:  Pointer to the event being processed.
- * @return status: QState type that specifies where the state
- * machine is going next.
- */
-static QState I2C1DevMgr_SendInternalAddr(I2C1DevMgr * const me, QEvt const * const e);
-
-/**
- * @brief   This state sends the start bit on the I2C bus.
- * Some I2C devices require a second start bit to do random addr operations.
- *
- * @param  [in,out] me: Pointer to the state machine
- * @param  [in,out] e:  Pointer to the event being processed.
- * @return status: QState type that specifies where the state
- * machine is going next.
- */
-static QState I2C1DevMgr_GenerateStart1(I2C1DevMgr * const me, QEvt const * const e);
-
-/**
- * @brief   This state sends an address of the I2C device to select the device and
- * selects the RECEIVER mode.
- *
- * @param  [in,out] me: Pointer to the state machine
- * @param  [in,out] e:  Pointer to the event being processed.
- * @return status: QState type that specifies where the state
- * machine is going next.
- */
-static QState I2C1DevMgr_Send7BitAddrRxMode(I2C1DevMgr * const me, QEvt const * const e);
-
 /**
  * @brief   This state sends the command to read to memory in the selected I2C
  * device.
@@ -302,10 +277,10 @@ static QState I2C1DevMgr_ValidateRequest(I2C1DevMgr * const me, QEvt const * con
  * @brief This state indicates that the I2C bus is currently idle and the
  * incoming msg can be handled.
  * This state is the default rest state of the state machine and can handle
- * various I2C requests.  Upon entry, it also checks the deferred queue to see
- * if any request events are waiting which were posted while I2C bus was busy.
- * if there are any waiting, it will read them out, which automatically posts
- * them and the state machine will go and handle them.
+ * various I2C requests.  Upon entry, it also checks the request queue to see
+ * if any requests came in while the I2C bus was busy.  If there are any waiting,
+ * it posts itself an I2C1_DEV_NEXT_REQ event which starts the next one by
+ * priority (see I2C1DevMgr_startNextReq()).
  *
  * @param  [in,out] me: Pointer to the state machine
  * @param  [in,out] e:  Pointer to the event being processed.
@@ -324,11 +299,70 @@ static I2C1DevMgr l_I2C1DevMgr;   /* the single instance of the active object */
 QActive * const AO_I2C1DevMgr = (QActive *)&l_I2C1DevMgr;/**< "opaque" AO pointer */
 
 /* Private function prototypes -----------------------------------------------*/
+
+/**
+ * @brief   Copy an I2C read or write request into the request queue.
+ * The request event gets recycled as soon as it's handled so everything needed
+ * to run the request later is copied out of it.
+ *
+ * @param  [in,out] me: Pointer to the state machine
+ * @param  [in] e: QEvt pointer to the I2C1_DEV_RAW_MEM_READ or
+ * I2C1_DEV_RAW_MEM_WRITE request event.
+ * @return: None
+ */
+/*${AOs::I2C1DevMgr_queueReq} ..............................................*/
+static void I2C1DevMgr_queueReq(I2C1DevMgr * const me, QEvt const * const e);
+
+/**
+ * @brief   Remove a request from the request queue.
+ * The rest of the requests stay in the order they came in.
+ *
+ * @param  [in,out] me: Pointer to the state machine
+ * @param  [in] idx: uint8_t index of the request in the queue.
+ * @return: None
+ */
+/*${AOs::I2C1DevMgr_removeReq} .............................................*/
+static void I2C1DevMgr_removeReq(I2C1DevMgr * const me, uint8_t idx);
+
+/**
+ * @brief   Find the first request ahead of a given request in the queue that
+ * has to be done before it.
+ * A request can't be moved ahead of an earlier request to the same part of the
+ * same device if either one of them is a write.
+ *
+ * @param  [in] me: Pointer to the state machine
+ * @param  [in] idx: uint8_t index of the request in the queue.
+ * @return: uint8_t index of the first request that has to be done before it or
+ * idx if there are none.
+ */
+/*${AOs::I2C1DevMgr_findConflict} ..........................................*/
+static uint8_t I2C1DevMgr_findConflict(I2C1DevMgr const * const me, uint8_t idx);
+
+/**
+ * @brief   Take the next request out of the request queue and set up the state
+ * machine to run it.
+ * The highest priority request goes first and requests of the same priority go
+ * in the order they came in.  If that request has to wait for an earlier one
+ * (see I2C1DevMgr_findConflict()), the earlier one goes first instead so it
+ * doesn't hold up the higher priority request any longer than it has to.
+ *
+ * A read also picks up all the other queued reads of the same device that
+ * overlap or touch its range as long as they all still fit into a single bus
+ * read.  The data gets split back up between them on exit from Busy state.
+ *
+ * @note: There has to be at least one request in the queue.
+ *
+ * @param  [in,out] me: Pointer to the state machine
+ * @return: None
+ */
+/*${AOs::I2C1DevMgr_startNextReq} ..........................................*/
+static void I2C1DevMgr_startNextReq(I2C1DevMgr * const me);
+
 /* Private functions ---------------------------------------------------------*/
 
 /**
  * @brief C "constructor" for I2C1DevMgr "class".
- * Initializes all the timers and queues used by the AO, sets up a deferral
+ * Initializes all the timers and queues used by the AO, empties the request
  * queue, and sets of the first state.
  * @param [in]: none.
  * @retval: none
@@ -342,16 +376,205 @@ void I2C1DevMgr_ctor(void) {
     QTimeEvt_ctor( &me->i2cOpTimerEvt, I2C1_DEV_OP_TIMEOUT_SIG );
     QTimeEvt_ctor( &me->i2cWriteTimerEvt, I2C1_DEV_POST_WRITE_TIMER_SIG );
 
-    /* Initialize the deferred event queue and storage for it */
-    QEQueue_init(
-        &me->deferredEvtQueue,
-        (QEvt const **)( me->deferredEvtQSto ),
-        Q_DIM(me->deferredEvtQSto)
-    );
+    /* No requests are waiting for the bus yet */
+    me->nReqs    = 0;
+    me->nReaders = 0;
 
     dbg_slow_printf("Constructor\n");
 }
 
+/**
+ * @brief   Copy an I2C read or write request into the request queue.
+ * The request event gets recycled as soon as it's handled so everything needed
+ * to run the request later is copied out of it.
+ *
+ * @param  [in,out] me: Pointer to the state machine
+ * @param  [in] e: QEvt pointer to the I2C1_DEV_RAW_MEM_READ or
+ * I2C1_DEV_RAW_MEM_WRITE request event.
+ * @return: None
+ */
+/*${AOs::I2C1DevMgr_queueReq} ..............................................*/
+static void I2C1DevMgr_queueReq(I2C1DevMgr * const me, QEvt const * const e) {
+    if ( me->nReqs >= MAX_I2C_PENDING_REQS ) {
+        /* notify the request sender that the request was ignored.. */
+        ERR_printf("Unable to queue I2C request\n");
+        return;
+    }
+
+    I2C1DevReq_t *pReq = &me->reqs[me->nReqs];
+    pReq->sig = e->sig;
+    if ( I2C1_DEV_RAW_MEM_READ_SIG == e->sig ) {
+        pReq->i2cDev     = ((I2CReadReqEvt const *)e)->i2cDev;
+        pReq->priority   = ((I2CReadReqEvt const *)e)->priority;
+        pReq->accessType = ((I2CReadReqEvt const *)e)->accessType;
+        pReq->bytes      = ((I2CReadReqEvt const *)e)->bytes;
+        pReq->addr       = I2C_getMemAddr( pReq->i2cDev ) + ((I2CReadReqEvt const *)e)->start;
+    } else {
+        pReq->i2cDev     = ((I2CWriteReqEvt const *)e)->i2cDev;
+        pReq->priority   = ((I2CWriteReqEvt const *)e)->priority;
+        pReq->accessType = ((I2CWriteReqEvt const *)e)->accessType;
+        pReq->bytes      = ((I2CWriteReqEvt const *)e)->bytes;
+        pReq->addr       = I2C_getMemAddr( pReq->i2cDev ) + ((I2CWriteReqEvt const *)e)->start;
+
+        /* Only copy what fits.  Requests that are too big get rejected when validated. */
+        MEMCPY(
+            pReq->dataBuf,
+            ((I2CWriteReqEvt const *)e)->dataBuf,
+            MIN( pReq->bytes, MAX_I2C_WRITE_LEN )
+        );
+    }
+    me->nReqs++;
+}
+
+/**
+ * @brief   Remove a request from the request queue.
+ * The rest of the requests stay in the order they came in.
+ *
+ * @param  [in,out] me: Pointer to the state machine
+ * @param  [in] idx: uint8_t index of the request in the queue.
+ * @return: None
+ */
+/*${AOs::I2C1DevMgr_removeReq} .............................................*/
+static void I2C1DevMgr_removeReq(I2C1DevMgr * const me, uint8_t idx) {
+    for ( uint8_t i = idx; i + 1 < me->nReqs; i++ ) {
+        me->reqs[i] = me->reqs[i + 1];
+    }
+    me->nReqs--;
+}
+
+/**
+ * @brief   Find the first request ahead of a given request in the queue that
+ * has to be done before it.
+ * A request can't be moved ahead of an earlier request to the same part of the
+ * same device if either one of them is a write.
+ *
+ * @param  [in] me: Pointer to the state machine
+ * @param  [in] idx: uint8_t index of the request in the queue.
+ * @return: uint8_t index of the first request that has to be done before it or
+ * idx if there are none.
+ */
+/*${AOs::I2C1DevMgr_findConflict} ..........................................*/
+static uint8_t I2C1DevMgr_findConflict(I2C1DevMgr const * const me, uint8_t idx) {
+    I2C1DevReq_t const *pReq = &me->reqs[idx];
+    for ( uint8_t i = 0; i < idx; i++ ) {
+        I2C1DevReq_t const *pPrev = &me->reqs[i];
+        if ( pPrev->i2cDev == pReq->i2cDev &&
+             ( I2C1_DEV_RAW_MEM_WRITE_SIG == pPrev->sig || I2C1_DEV_RAW_MEM_WRITE_SIG == pReq->sig ) &&
+             pPrev->addr < pReq->addr + pReq->bytes &&
+             pReq->addr < pPrev->addr + pPrev->bytes ) {
+            return i;
+        }
+    }
+    return idx;
+}
+
+/**
+ * @brief   Take the next request out of the request queue and set up the state
+ * machine to run it.
+ * The highest priority request goes first and requests of the same priority go
+ * in the order they came in.  If that request has to wait for an earlier one
+ * (see I2C1DevMgr_findConflict()), the earlier one goes first instead so it
+ * doesn't hold up the higher priority request any longer than it has to.
+ *
+ * A read also picks up all the other queued reads of the same device that
+ * overlap or touch its range as long as they all still fit into a single bus
+ * read.  The data gets split back up between them on exit from Busy state.
+ *
+ * @note: There has to be at least one request in the queue.
+ *
+ * @param  [in,out] me: Pointer to the state machine
+ * @return: None
+ */
+/*${AOs::I2C1DevMgr_startNextReq} ..........................................*/
+static void I2C1DevMgr_startNextReq(I2C1DevMgr * const me) {
+    /* Highest priority goes first.  Ties go to whichever came in first. */
+    uint8_t next = 0;
+    for ( uint8_t i = 1; i < me->nReqs; i++ ) {
+        if ( me->reqs[i].priority > me->reqs[next].priority ) {
+            next = i;
+        }
+    }
+
+    /* Anything it has to wait on goes ahead of it */
+    uint8_t first = I2C1DevMgr_findConflict( me, next );
+    while ( first != next ) {
+        next  = first;
+        first = I2C1DevMgr_findConflict( me, next );
+    }
+
+    I2C1DevReq_t const *pReq = &me->reqs[next];
+    me->iDev       = pReq->i2cDev;
+    me->addrStart  = pReq->addr;
+    me->accessType = pReq->accessType;
+    me->bytesTotal = pReq->bytes;
+    me->addrSize   = I2C_getMemAddrSize(me->iDev);
+    me->bytesRead  = 0;
+    me->nReaders   = 0;
+
+    if ( I2C1_DEV_RAW_MEM_WRITE_SIG == pReq->sig ) {
+        me->i2cDevOp   = I2C_OP_MEM_WRITE;
+        MEMCPY( me->dataBuf, pReq->dataBuf, MIN( me->bytesTotal, MAX_I2C_WRITE_LEN ) );
+        I2C1DevMgr_removeReq( me, next );
+
+        /* Allocate a WriteDone evt that will ALWAYS be sent out upon exit of the Busy state
+         * for write operations. */
+        me->i2cWriteDoneEvt = Q_NEW(I2CWriteDoneEvt, I2C1_DEV_WRITE_DONE_SIG);
+
+        /* Fill out the fields that won't change or to just safe values in case of failure */
+        me->i2cWriteDoneEvt->i2cDev = me->iDev;
+        me->i2cWriteDoneEvt->bytes  = 0;
+        return;
+    }
+
+    me->i2cDevOp   = I2C_OP_MEM_READ;
+    me->readers[me->nReaders].accessType = pReq->accessType;
+    me->readers[me->nReaders].addr       = pReq->addr;
+    me->readers[me->nReaders].bytes      = pReq->bytes;
+    me->nReaders++;
+    I2C1DevMgr_removeReq( me, next );
+
+    /* Don't merge anything into a read that is going to fail validation anyway */
+    bool isMerging = IS_I2C_DEVICE(me->iDev) && 0 != me->bytesTotal &&
+        me->bytesTotal <= MAX_I2C_READ_LEN &&
+        ( me->addrStart + (me->bytesTotal - 1) ) <= I2C_getMaxMemAddr(me->iDev);
+
+    while ( isMerging ) {
+        isMerging = false;
+        for ( uint8_t i = 0; i < me->nReqs; i++ ) {
+            I2C1DevReq_t const *pCand = &me->reqs[i];
+            if ( I2C1_DEV_RAW_MEM_READ_SIG != pCand->sig || me->iDev != pCand->i2cDev ||
+                 0 == pCand->bytes || pCand->addr > me->addrStart + me->bytesTotal ||
+                 pCand->addr + pCand->bytes < me->addrStart ||
+                 i != I2C1DevMgr_findConflict( me, i ) ) {
+                continue;
+            }
+
+            uint16_t start = MIN( me->addrStart, pCand->addr );
+            uint16_t end   = MAX( me->addrStart + me->bytesTotal, pCand->addr + pCand->bytes );
+            if ( end - start > MAX_I2C_READ_LEN || end - 1 > I2C_getMaxMemAddr(me->iDev) ) {
+                continue;
+            }
+
+            me->readers[me->nReaders].accessType = pCand->accessType;
+            me->readers[me->nReaders].addr       = pCand->addr;
+            me->readers[me->nReaders].bytes      = pCand->bytes;
+            me->nReaders++;
+            me->addrStart  = start;
+            me->bytesTotal = end - start;
+            I2C1DevMgr_removeReq( me, i );
+
+            /* The range may have grown enough to touch reads that were skipped so start
+             * over */
+            isMerging = true;
+            break;
+        }
+    }
+
+    if ( me->nReaders > 1 ) {
+        DBG_printf("Merged %d reads into a single %d byte read\n", me->nReaders, me->bytesTotal);
+    }
+}
+
 /**
  * @brief I2C1DevMgr Active Object (AO) "class" that manages the all the I2C
  * devices on the I2C1 Bus.
@@ -374,6 +597,12 @@ static QState I2C1DevMgr_initial(I2C1DevMgr * const me, QEvt const * const e) {
     QS_FUN_DICTIONARY(&I2C1DevMgr_initial);
     QS_FUN_DICTIONARY(&I2C1DevMgr_Active);
     QS_FUN_DICTIONARY(&I2C1DevMgr_Idle);
+    QS_FUN_DICTIONARY(&I2C1DevMgr_Busy);
+    QS_FUN_DICTIONARY(&I2C1DevMgr_ValidateRequest);
+    QS_FUN_DICTIONARY(&I2C1DevMgr_CheckingBus);
+    QS_FUN_DICTIONARY(&I2C1DevMgr_ReadMem);
+    QS_FUN_DICTIONARY(&I2C1DevMgr_WriteMem);
+    QS_FUN_DICTIONARY(&I2C1DevMgr_PostWriteWait);
 
     QActive_subscribe((QActive *)me, I2C1_DEV_RAW_MEM_WRITE_SIG);
     QActive_subscribe((QActive *)me, I2C1_DEV_RAW_MEM_READ_SIG);
@@ -432,8 +661,8 @@ static QState I2C1DevMgr_Active(I2C1DevMgr * const me, QEvt const * const e) {
 
 /**
  * @brief   This state indicates that the I2C is currently busy and cannot
- * process incoming data; incoming events will be deferred in this state and
- * handled once the AO goes back to Idle state.
+ * process incoming data; incoming requests will be queued up in this state and
+ * handled by priority once the AO goes back to Idle state.
  *
  * @param  [in,out] me: Pointer to the state machine
  * @param  [in,out] e:  Pointer to the event being processed.
@@ -474,23 +703,35 @@ static QState I2C1DevMgr_Busy(I2C1DevMgr * const me, QEvt const * const e) {
                 CON_accessToStr(me->accessType) );
 
             if ( I2C_OP_MEM_READ == me->i2cDevOp || I2C_OP_REG_READ == me->i2cDevOp ) {
-                /* Change only the fields that could have changed since */
-                me->i2cReadDoneEvt->status = me->errorCode;
+                /* Every request that was merged into this read gets its own ReadDone evt with
+                 * just the part of the data it asked for. */
+                for ( uint8_t i = 0; i < me->nReaders; i++ ) {
+                    I2CReadDoneEvt *i2cReadDoneEvt = Q_NEW(I2CReadDoneEvt, I2C1_DEV_READ_DONE_SIG);
+                    i2cReadDoneEvt->status = me->errorCode;
+                    i2cReadDoneEvt->i2cDev = me->iDev;
+                    i2cReadDoneEvt->bytes  = 0;
+
+                    uint16_t offset = me->readers[i].addr - me->addrStart;
+                    if ( ERR_NONE == me->errorCode && offset < me->bytesRead ) {
+                        i2cReadDoneEvt->bytes = MIN( me->readers[i].bytes, me->bytesRead - offset );
+                        MEMCPY( i2cReadDoneEvt->dataBuf, &me->dataBuf[offset], i2cReadDoneEvt->bytes );
+                    }
 
-                if ( _DC3_ACCESS_FRT == me->accessType ) {
+                    if ( _DC3_ACCESS_FRT == me->readers[i].accessType ) {
             #if CPLR_APP
-                    /* Post directly to the "raw" queue for FreeRTOS task to read */
-                    QEQueue_postFIFO(&CPLR_evtQueue, (QEvt *)me->i2cReadDoneEvt);
-                    vTaskResume( xHandle_CPLR );
+                        /* Post directly to the "raw" queue for FreeRTOS task to read */
+                        QEQueue_postFIFO(&CPLR_evtQueue, (QEvt *)i2cReadDoneEvt);
+                        vTaskResume( xHandle_CPLR );
             #elif CPLR_BOOT
-                    /* Publish the event so other AOs can get it if they want */
-                    QF_PUBLISH((QEvt *)me->i2cReadDoneEvt, AO_I2C1DevMgr);
+                        /* Publish the event so other AOs can get it if they want */
+                        QF_PUBLISH((QEvt *)i2cReadDoneEvt, AO_I2C1DevMgr);
             #else
                 #error "Invalid build.  CPLR_APP or CPLR_BOOT must be specified"
             #endif
-                } else {
-                    /* Publish the event so other AOs can get it if they want */
-                    QF_PUBLISH((QEvt *)me->i2cReadDoneEvt, AO_I2C1DevMgr);
+                    } else {
+                        /* Publish the event so other AOs can get it if they want */
+                        QF_PUBLISH((QEvt *)i2cReadDoneEvt, AO_I2C1DevMgr);
+                    }
                 }
 
             } else if ( I2C_OP_MEM_WRITE == me->i2cDevOp || I2C_OP_REG_WRITE == me->i2cDevOp ) {
@@ -534,15 +775,9 @@ static QState I2C1DevMgr_Busy(I2C1DevMgr * const me, QEvt const * const e) {
         /* ${AOs::I2C1DevMgr::SM::Active::Busy::I2C1_DEV_RAW_MEM~} */
         case I2C1_DEV_RAW_MEM_READ_SIG: /* intentionally fall through */
         case I2C1_DEV_RAW_MEM_WRITE_SIG: {
-            if (QEQueue_getNFree(&me->deferredEvtQueue) > 0) {
-               /* defer the request - this event will be handled
-                * when the state machine goes back to Idle state */
-               QActive_defer((QActive *)me, &me->deferredEvtQueue, e);
-               DBG_printf("Deferring I2C request until current is done\n");
-            } else {
-               /* notify the request sender that the request was ignored.. */
-               ERR_printf("Unable to defer I2C request\n");
-            }
+            /* Queue the request.  It will be handled by priority when the state machine
+             * goes back to Idle state */
+            I2C1DevMgr_queueReq( me, e );
             status_ = Q_HANDLED();
             break;
         }
@@ -560,317 +795,6 @@ static QState I2C1DevMgr_Busy(I2C1DevMgr * const me, QEvt const * const e) {
     return status_;
 }
 
-/**
- * @brief   This state sends the start bit on the I2C bus.
- *
- * @param  [in,out] me: Pointer to the state machine
- * @param  [in,out] e:  Pointer to the event being processed.
- * @return status: QState type that specifies where the state
- * machine is going next.
- */
-/*${AOs::I2C1DevMgr::SM::Active::Busy::GenerateStart} ......................*/
-static QState I2C1DevMgr_GenerateStart(I2C1DevMgr * const me, QEvt const * const e) {
-    QState status_;
-    switch (e->sig) {
-        /* ${AOs::I2C1DevMgr::SM::Active::Busy::GenerateStart} */
-        case Q_ENTRY_SIG: {
-            /* Set error code */
-            me->errorCode = ERR_I2C1DEV_EV5_TIMEOUT;
-
-            /* Set timer */
-            QTimeEvt_rearm(
-                &me->i2cOpTimerEvt,
-                SEC_TO_TICKS( HL_MAX_TOUT_SEC_I2C_EV5 )
-            );
-
-            /* Directly post an event to the appropriate I2CBusMgr AO */
-            static QEvt const qEvt = { I2C_BUS_START_BIT_SIG, 0U, 0U };
-            QACTIVE_POST(AO_I2CBusMgr[me->iBus], &qEvt, me);
-            status_ = Q_HANDLED();
-            break;
-        }
-        /* ${AOs::I2C1DevMgr::SM::Active::Busy::GenerateStart} */
-        case Q_EXIT_SIG: {
-            QTimeEvt_disarm(&me->i2cOpTimerEvt);
-            status_ = Q_HANDLED();
-            break;
-        }
-        /* ${AOs::I2C1DevMgr::SM::Active::Busy::GenerateStart::I2C_BUS_DONE} */
-        case I2C_BUS_DONE_SIG: {
-            /* Remember the result of each event coming back from I2CBusMgr AO */
-            me->errorCode = ((I2CStatusEvt const *)e)->errorCode;
-            /* ${AOs::I2C1DevMgr::SM::Active::Busy::GenerateStart::I2C_BUS_DONE::[NoErr?]} */
-            if (ERR_NONE == ((I2CStatusEvt const *)e)->errorCode) {
-                status_ = Q_TRAN(&I2C1DevMgr_Send7BitAddrTxMode);
-            }
-            /* ${AOs::I2C1DevMgr::SM::Active::Busy::GenerateStart::I2C_BUS_DONE::[else]} */
-            else {
-                status_ = Q_TRAN(&I2C1DevMgr_Idle);
-            }
-            break;
-        }
-        default: {
-            status_ = Q_SUPER(&I2C1DevMgr_Busy);
-            break;
-        }
-    }
-    return status_;
-}
-
-/**
- * @brief   This state sends an address of the I2C device to select the device and
- * selects the TRANSMITTER mode.
- *
- * @param  [in,out] me: Pointer to the state machine
- * @param  [in,out] e:  Pointer to the event being processed.
- * @return status: QState type that specifies where the state
- * machine is going next.
- */
-/*${AOs::I2C1DevMgr::SM::Active::Busy::Send7BitAddrTxMo~} ..................*/
-static QState I2C1DevMgr_Send7BitAddrTxMode(I2C1DevMgr * const me, QEvt const * const e) {
-    QState status_;
-    switch (e->sig) {
-        /* ${AOs::I2C1DevMgr::SM::Active::Busy::Send7BitAddrTxMo~} */
-        case Q_ENTRY_SIG: {
-            /* Set error code */
-            me->errorCode = ERR_I2C1DEV_EV6_TIMEOUT;
-
-            /* Set timer */
-            QTimeEvt_rearm(
-                &me->i2cOpTimerEvt,
-                SEC_TO_TICKS( HL_MAX_TOUT_SEC_I2C_EV6 )
-            );
-
-            /* Allocate and directly post an event to the appropriate I2CBusMgr AO */
-            I2CAddrEvt *i2cAddrEvt   = Q_NEW( I2CAddrEvt, I2C_BUS_SEND_7BIT_ADDR_SIG );
-            i2cAddrEvt->i2cBus       = me->iBus;
-            i2cAddrEvt->addr         = I2C_getDevAddr(me->iDev);
-            i2cAddrEvt->addrSize     = I2C_getDevAddrSize(me->iDev);
-            i2cAddrEvt->i2cDirection = I2C_Direction_Transmitter;
-            QACTIVE_POST(AO_I2CBusMgr[me->iBus], (QEvt *)i2cAddrEvt, me);
-            status_ = Q_HANDLED();
-            break;
-        }
-        /* ${AOs::I2C1DevMgr::SM::Active::Busy::Send7BitAddrTxMo~} */
-        case Q_EXIT_SIG: {
-            QTimeEvt_disarm(&me->i2cOpTimerEvt);
-            status_ = Q_HANDLED();
-            break;
-        }
-        /* ${AOs::I2C1DevMgr::SM::Active::Busy::Send7BitAddrTxMo~::I2C_BUS_DONE} */
-        case I2C_BUS_DONE_SIG: {
-            /* Remember the result of each event coming back from I2CBusMgr AO */
-            me->errorCode = ((I2CStatusEvt const *)e)->errorCode;
-            /* ${AOs::I2C1DevMgr::SM::Active::Busy::Send7BitAddrTxMo~::I2C_BUS_DONE::[NoErr?]} */
-            if (ERR_NONE == ((I2CStatusEvt const *)e)->errorCode) {
-                status_ = Q_TRAN(&I2C1DevMgr_SendInternalAddr);
-            }
-            /* ${AOs::I2C1DevMgr::SM::Active::Busy::Send7BitAddrTxMo~::I2C_BUS_DONE::[else]} */
-            else {
-                status_ = Q_TRAN(&I2C1DevMgr_Idle);
-            }
-            break;
-        }
-        default: {
-            status_ = Q_SUPER(&I2C1DevMgr_Busy);
-            break;
-        }
-    }
-    return status_;
-}
-
-/**
- * @brief   This state sends the internal memory address of the selected I2C device
- * that tells the device where the read or write will happen.
- *
- * @param  [in,out] me: Pointer to the state machine
- * @param  [in,out] e:  Pointer to the event being processed.
- * @return status: QState type that specifies where the state
- * machine is going next.
- */
-/*${AOs::I2C1DevMgr::SM::Active::Busy::SendInternalAddr} ...................*/
-static QState I2C1DevMgr_SendInternalAddr(I2C1DevMgr * const me, QEvt const * const e) {
-    QState status_;
-    switch (e->sig) {
-        /* ${AOs::I2C1DevMgr::SM::Active::Busy::SendInternalAddr} */
-        case Q_ENTRY_SIG: {
-            /* Set error code */
-            me->errorCode = ERR_I2C1DEV_EV8_TIMEOUT;
-
-            /* Set timer */
-            QTimeEvt_rearm(
-                &me->i2cOpTimerEvt,
-                SEC_TO_TICKS( HL_MAX_TOUT_SEC_I2C_EV8 )
-            );
-
-            /* Allocate and directly post an event to the appropriate I2CBusMgr AO */
-            I2CAddrEvt *i2cAddrEvt   = Q_NEW( I2CAddrEvt, I2C_BUS_SEND_DEV_ADDR_SIG );
-            i2cAddrEvt->i2cBus       = me->iBus;
-            i2cAddrEvt->addr         = me->addrStart;
-            i2cAddrEvt->addrSize     = I2C_getMemAddrSize(me->iDev);
-            i2cAddrEvt->i2cDirection = I2C_Direction_Transmitter;
-            QACTIVE_POST(AO_I2CBusMgr[me->iBus], (QEvt *)i2cAddrEvt, me);
-            status_ = Q_HANDLED();
-            break;
-        }
-        /* ${AOs::I2C1DevMgr::SM::Active::Busy::SendInternalAddr} */
-        case Q_EXIT_SIG: {
-            QTimeEvt_disarm(&me->i2cOpTimerEvt);
-            status_ = Q_HANDLED();
-            break;
-        }
-        /* ${AOs::I2C1DevMgr::SM::Active::Busy::SendInternalAddr::I2C_BUS_DONE} */
-        case I2C_BUS_DONE_SIG: {
-            /* Remember the result of each event coming back from I2CBusMgr AO */
-            me->errorCode = ((I2CStatusEvt const *)e)->errorCode;
-            /* ${AOs::I2C1DevMgr::SM::Active::Busy::SendInternalAddr::I2C_BUS_DONE::[NoErr?]} */
-            if (ERR_NONE == ((I2CStatusEvt const *)e)->errorCode) {
-                /* ${AOs::I2C1DevMgr::SM::Active::Busy::SendInternalAddr::I2C_BUS_DONE::[NoErr?]::[Read?]} */
-                if (I2C_OP_MEM_READ == me->i2cDevOp || I2C_OP_REG_READ == me->i2cDevOp) {
-                    status_ = Q_TRAN(&I2C1DevMgr_GenerateStart1);
-                }
-                /* ${AOs::I2C1DevMgr::SM::Active::Busy::SendInternalAddr::I2C_BUS_DONE::[NoErr?]::[Write?]} */
-                else if (I2C_OP_MEM_WRITE == me->i2cDevOp || I2C_OP_REG_WRITE == me->i2cDevOp) {
-                    status_ = Q_TRAN(&I2C1DevMgr_WriteMem);
-                }
-                else {
-                    status_ = Q_UNHANDLED();
-                }
-            }
-            /* ${AOs::I2C1DevMgr::SM::Active::Busy::SendInternalAddr::I2C_BUS_DONE::[else]} */
-            else {
-                status_ = Q_TRAN(&I2C1DevMgr_Idle);
-            }
-            break;
-        }
-        default: {
-            status_ = Q_SUPER(&I2C1DevMgr_Busy);
-            break;
-        }
-    }
-    return status_;
-}
-
-/**
- * @brief   This state sends the start bit on the I2C bus.
- * Some I2C devices require a second start bit to do random addr operations.
- *
- * @param  [in,out] me: Pointer to the state machine
- * @param  [in,out] e:  Pointer to the event being processed.
- * @return status: QState type that specifies where the state
- * machine is going next.
- */
-/*${AOs::I2C1DevMgr::SM::Active::Busy::GenerateStart1} .....................*/
-static QState I2C1DevMgr_GenerateStart1(I2C1DevMgr * const me, QEvt const * const e) {
-    QState status_;
-    switch (e->sig) {
-        /* ${AOs::I2C1DevMgr::SM::Active::Busy::GenerateStart1} */
-        case Q_ENTRY_SIG: {
-            /* Set error code */
-            me->errorCode = ERR_I2C1DEV_EV5_TIMEOUT;
-
-            /* Set timer */
-            QTimeEvt_rearm(
-                &me->i2cOpTimerEvt,
-                SEC_TO_TICKS( HL_MAX_TOUT_SEC_I2C_EV5 )
-            );
-
-            /* Directly post an event to the appropriate I2CBusMgr AO */
-            static QEvt const qEvt = { I2C_BUS_START_BIT_SIG, 0U, 0U };
-            QACTIVE_POST(AO_I2CBusMgr[me->iBus], &qEvt, me);
-            status_ = Q_HANDLED();
-            break;
-        }
-        /* ${AOs::I2C1DevMgr::SM::Active::Busy::GenerateStart1} */
-        case Q_EXIT_SIG: {
-            QTimeEvt_disarm(&me->i2cOpTimerEvt);
-            status_ = Q_HANDLED();
-            break;
-        }
-        /* ${AOs::I2C1DevMgr::SM::Active::Busy::GenerateStart1::I2C_BUS_DONE} */
-        case I2C_BUS_DONE_SIG: {
-            /* Remember the result of each event coming back from I2CBusMgr AO */
-            me->errorCode = ((I2CStatusEvt const *)e)->errorCode;
-            /* ${AOs::I2C1DevMgr::SM::Active::Busy::GenerateStart1::I2C_BUS_DONE::[NoErr?]} */
-            if (ERR_NONE == ((I2CStatusEvt const *)e)->errorCode) {
-                status_ = Q_TRAN(&I2C1DevMgr_Send7BitAddrRxMode);
-            }
-            /* ${AOs::I2C1DevMgr::SM::Active::Busy::GenerateStart1::I2C_BUS_DONE::[else]} */
-            else {
-                status_ = Q_TRAN(&I2C1DevMgr_Idle);
-            }
-            break;
-        }
-        default: {
-            status_ = Q_SUPER(&I2C1DevMgr_Busy);
-            break;
-        }
-    }
-    return status_;
-}
-
-/**
- * @brief   This state sends an address of the I2C device to select the device and
- * selects the RECEIVER mode.
- *
- * @param  [in,out] me: Pointer to the state machine
- * @param  [in,out] e:  Pointer to the event being processed.
- * @return status: QState type that specifies where the state
- * machine is going next.
- */
-/*${AOs::I2C1DevMgr::SM::Active::Busy::Send7BitAddrRxMo~} ..................*/
-static QState I2C1DevMgr_Send7BitAddrRxMode(I2C1DevMgr * const me, QEvt const * const e) {
-    QState status_;
-    switch (e->sig) {
-        /* ${AOs::I2C1DevMgr::SM::Active::Busy::Send7BitAddrRxMo~} */
-        case Q_ENTRY_SIG: {
-            /* Set error code */
-            me->errorCode = ERR_I2C1DEV_EV6_TIMEOUT;
-
-            /* Set timer */
-            QTimeEvt_rearm(
-                &me->i2cOpTimerEvt,
-                SEC_TO_TICKS( HL_MAX_TOUT_SEC_I2C_EV6 )
-            );
-
-            /* Allocate and directly post an event to the appropriate I2CBusMgr AO */
-            I2CAddrEvt *i2cAddrEvt   = Q_NEW( I2CAddrEvt, I2C_BUS_SEND_7BIT_ADDR_SIG );
-            i2cAddrEvt->i2cBus       = me->iBus;
-            i2cAddrEvt->addr         = I2C_getDevAddr(me->iDev);
-            i2cAddrEvt->addrSize     = I2C_getDevAddrSize(me->iDev);
-            i2cAddrEvt->i2cDirection = I2C_Direction_Receiver;
-            QACTIVE_POST(AO_I2CBusMgr[me->iBus], (QEvt *)i2cAddrEvt, me);
-            status_ = Q_HANDLED();
-            break;
-        }
-        /* ${AOs::I2C1DevMgr::SM::Active::Busy::Send7BitAddrRxMo~} */
-        case Q_EXIT_SIG: {
-            QTimeEvt_disarm(&me->i2cOpTimerEvt);
-            status_ = Q_HANDLED();
-            break;
-        }
-        /* ${AOs::I2C1DevMgr::SM::Active::Busy::Send7BitAddrRxMo~::I2C_BUS_DONE} */
-        case I2C_BUS_DONE_SIG: {
-            /* Remember the result of each event coming back from I2CBusMgr AO */
-            me->errorCode = ((I2CStatusEvt const *)e)->errorCode;
-            /* ${AOs::I2C1DevMgr::SM::Active::Busy::Send7BitAddrRxMo~::I2C_BUS_DONE::[NoErr?]} */
-            if (ERR_NONE == ((I2CStatusEvt const *)e)->errorCode) {
-                status_ = Q_TRAN(&I2C1DevMgr_ReadMem);
-            }
-            /* ${AOs::I2C1DevMgr::SM::Active::Busy::Send7BitAddrRxMo~::I2C_BUS_DONE::[else]} */
-            else {
-                status_ = Q_TRAN(&I2C1DevMgr_Idle);
-            }
-            break;
-        }
-        default: {
-            status_ = Q_SUPER(&I2C1DevMgr_Busy);
-            break;
-        }
-    }
-    return status_;
-}
-
 /**
  * @brief   This state sends the command to read to memory in the selected I2C
  * device.
@@ -900,7 +824,7 @@ static QState I2C1DevMgr_ReadMem(I2C1DevMgr * const me, QEvt const * const e) {
             i2cReadMemEvt->i2cBus           = me->iBus;
             i2cReadMemEvt->addr             = me->addrStart;
             i2cReadMemEvt->addrSize         = I2C_getMemAddrSize(me->iDev);
-            i2cReadMemEvt->memAccessType    = I2C_MEM_DMA;
+            i2cReadMemEvt->devAddr          = I2C_getDevAddr(me->iDev);
             i2cReadMemEvt->bytes            = me->bytesTotal;
             QACTIVE_POST(AO_I2CBusMgr[me->iBus], (QEvt *)i2cReadMemEvt, me);
             status_ = Q_HANDLED();
@@ -921,23 +845,13 @@ static QState I2C1DevMgr_ReadMem(I2C1DevMgr * const me, QEvt const * const e) {
                 /* Set this so the state machine remembers the result */
                 me->errorCode = ERR_NONE;
 
-                //I2CReadDoneEvt *i2cReadDoneEvt = Q_NEW(I2CReadDoneEvt, I2C1_DEV_READ_DONE_SIG);
-                me->i2cReadDoneEvt->status = me->errorCode;
-                me->i2cReadDoneEvt->i2cDev = me->iDev;
-
-                /* Now copy the data from the I2CBus evt to the I2CReadDone evt */
-                me->i2cReadDoneEvt->bytes  = ((I2CBusDataEvt const *)e)->dataLen;
-                MEMCPY(
-                    me->i2cReadDoneEvt->dataBuf,
-                    ((I2CBusDataEvt const *)e)->dataBuf,
-                    me->i2cReadDoneEvt->bytes
-                );
+                /* Hang on to the data.  It gets split up between all the requests that were merged
+                 * into this read on exit from the Busy state */
+                me->bytesRead = MIN( ((I2CBusDataEvt const *)e)->dataLen, MAX_I2C_READ_LEN );
+                MEMCPY( me->dataBuf, ((I2CBusDataEvt const *)e)->dataBuf, me->bytesRead );
 
-                /* Before publishing the event, print out what was read if this debug module is enabled */
-                if( ERR_NONE == me->errorCode ) {
-                    DBG_printfHexStr( me->i2cReadDoneEvt->dataBuf, me->i2cReadDoneEvt->bytes,
-                        "Read %d bytes:\n", me->i2cReadDoneEvt->bytes );
-                }
+                /* Print out what was read if this debug module is enabled */
+                DBG_printfHexStr( me->dataBuf, me->bytesRead, "Read %d bytes:\n", me->bytesRead );
                 status_ = Q_TRAN(&I2C1DevMgr_Idle);
             }
             /* ${AOs::I2C1DevMgr::SM::Active::Busy::ReadMem::I2C_BUS_DONE::[else]} */
@@ -983,7 +897,7 @@ static QState I2C1DevMgr_WriteMem(I2C1DevMgr * const me, QEvt const * const e) {
             i2cWriteMemReqEvt->i2cBus           = me->iBus;
             i2cWriteMemReqEvt->addr             = me->writeMemAddrCurr;
             i2cWriteMemReqEvt->addrSize         = I2C_getMemAddrSize(me->iDev);
-            i2cWriteMemReqEvt->memAccessType    = I2C_MEM_DMA;
+            i2cWriteMemReqEvt->devAddr          = I2C_getDevAddr(me->iDev);
             i2cWriteMemReqEvt->bytes            = me->writeSizeCurr;
             MEMCPY(
                 i2cWriteMemReqEvt->dataBuf,
@@ -1138,7 +1052,17 @@ static QState I2C1DevMgr_CheckingBus(I2C1DevMgr * const me, QEvt const * const e
             me->errorCode = ((I2CStatusEvt const *)e)->errorCode;
             /* ${AOs::I2C1DevMgr::SM::Active::Busy::CheckingBus::I2C_BUS_DONE::[NoErr?]} */
             if (ERR_NONE == me->errorCode) {
-                status_ = Q_TRAN(&I2C1DevMgr_GenerateStart);
+                /* ${AOs::I2C1DevMgr::SM::Active::Busy::CheckingBus::I2C_BUS_DONE::[NoErr?]::[Read?]} */
+                if (I2C_OP_MEM_READ == me->i2cDevOp || I2C_OP_REG_READ == me->i2cDevOp) {
+                    status_ = Q_TRAN(&I2C1DevMgr_ReadMem);
+                }
+                /* ${AOs::I2C1DevMgr::SM::Active::Busy::CheckingBus::I2C_BUS_DONE::[NoErr?]::[Write?]} */
+                else if (I2C_OP_MEM_WRITE == me->i2cDevOp || I2C_OP_REG_WRITE == me->i2cDevOp) {
+                    status_ = Q_TRAN(&I2C1DevMgr_WriteMem);
+                }
+                else {
+                    status_ = Q_UNHANDLED();
+                }
             }
             /* ${AOs::I2C1DevMgr::SM::Active::Busy::CheckingBus::I2C_BUS_DONE::[else]} */
             else {
@@ -1302,10 +1226,10 @@ static QState I2C1DevMgr_ValidateRequest(I2C1DevMgr * const me, QEvt const * con
  * @brief This state indicates that the I2C bus is currently idle and the
  * incoming msg can be handled.
  * This state is the default rest state of the state machine and can handle
- * various I2C requests.  Upon entry, it also checks the deferred queue to see
- * if any request events are waiting which were posted while I2C bus was busy.
- * if there are any waiting, it will read them out, which automatically posts
- * them and the state machine will go and handle them.
+ * various I2C requests.  Upon entry, it also checks the request queue to see
+ * if any requests came in while the I2C bus was busy.  If there are any waiting,
+ * it posts itself an I2C1_DEV_NEXT_REQ event which starts the next one by
+ * priority (see I2C1DevMgr_startNextReq()).
  *
  * @param  [in,out] me: Pointer to the state machine
  * @param  [in,out] e:  Pointer to the event being processed.
@@ -1318,61 +1242,34 @@ static QState I2C1DevMgr_Idle(I2C1DevMgr * const me, QEvt const * const e) {
     switch (e->sig) {
         /* ${AOs::I2C1DevMgr::SM::Active::Idle} */
         case Q_ENTRY_SIG: {
-            /* recall the request from the private requestQueue */
-            QActive_recall(
-                (QActive *)me,
-                &me->deferredEvtQueue
-            );
-
+            /* Start on the next request if any came in while the bus was busy */
+            if ( me->nReqs > 0 ) {
+                static QEvt const qEvt = { I2C1_DEV_NEXT_REQ_SIG, 0U, 0U };
+                QACTIVE_POST((QActive *)me, &qEvt, me);
+            }
             status_ = Q_HANDLED();
             break;
         }
         /* ${AOs::I2C1DevMgr::SM::Active::Idle::I2C1_DEV_RAW_MEM~} */
-        case I2C1_DEV_RAW_MEM_READ_SIG: {
-            /* Store all the data from the event and look up a few things */
-
-            /* I2C1Dev AO will figure out the correct mem address */
-            me->iDev       = ((I2CReadReqEvt const *)e)->i2cDev;
-            me->addrStart  = I2C_getMemAddr( me->iDev  ) + ((I2CReadReqEvt const *)e)->start;
-            me->accessType = ((I2CReadReqEvt const *)e)->accessType;
-            me->bytesTotal = ((I2CReadReqEvt const *)e)->bytes;
-            me->addrSize   = I2C_getMemAddrSize(me->iDev);
-            me->i2cDevOp   = I2C_OP_MEM_READ;
-
-            /* Allocate a ReadDone evt that will ALWAYS be sent out upon exit of the Busy state
-             * for read operations. */
-            me->i2cReadDoneEvt = Q_NEW(I2CReadDoneEvt, I2C1_DEV_READ_DONE_SIG);
-
-            /* Fill out the fields that won't change or to just safe values in case of failure */
-            me->i2cReadDoneEvt->i2cDev = me->iDev;
-            me->i2cReadDoneEvt->bytes  = 0;
+        case I2C1_DEV_RAW_MEM_READ_SIG: /* intentionally fall through */
+        case I2C1_DEV_RAW_MEM_WRITE_SIG: {
+            /* Go through the request queue so this request gets picked by priority along
+             * with anything else that's waiting */
+            I2C1DevMgr_queueReq( me, e );
+            I2C1DevMgr_startNextReq( me );
             status_ = Q_TRAN(&I2C1DevMgr_ValidateRequest);
             break;
         }
-        /* ${AOs::I2C1DevMgr::SM::Active::Idle::I2C1_DEV_RAW_MEM~} */
-        case I2C1_DEV_RAW_MEM_WRITE_SIG: {
-            /* Store all the data from the event and look up a few things */
-
-            /* I2C1Dev AO will figure out the correct mem address */
-            me->iDev       = ((I2CWriteReqEvt const *)e)->i2cDev;
-            me->addrStart  = I2C_getMemAddr( me->iDev ) + ((I2CWriteReqEvt const *)e)->start;
-            me->accessType = ((I2CWriteReqEvt const *)e)->accessType;
-            me->bytesTotal = ((I2CWriteReqEvt const *)e)->bytes;
-            me->addrSize   = I2C_getMemAddrSize(me->iDev);
-            me->i2cDevOp   = I2C_OP_MEM_WRITE;
-
-            /* This event will disappear after it's handled so the data must be copied to local buffer*/
-            MEMCPY( me->dataBuf, ((I2CWriteReqEvt const *)e)->dataBuf, me->bytesTotal );
-
-            /* Allocate a WriteDone evt that will ALWAYS be sent out upon exit of the Busy state
-             * for write operations. */
-            me->i2cWriteDoneEvt = Q_NEW(I2CWriteDoneEvt, I2C1_DEV_WRITE_DONE_SIG);
-
-            /* Fill out the fields that won't change or to just safe values in case of failure */
-            me->i2cWriteDoneEvt->i2cDev = me->iDev;
-            me->i2cWriteDoneEvt->bytes  = 0;
-
-            status_ = Q_TRAN(&I2C1DevMgr_ValidateRequest);
+        /* ${AOs::I2C1DevMgr::SM::Active::Idle::I2C1_DEV_NEXT_RE~} */
+        case I2C1_DEV_NEXT_REQ_SIG: {
+            /* ${AOs::I2C1DevMgr::SM::Active::Idle::I2C1_DEV_NEXT_RE~::[ReqWaiting?]} */
+            if (me->nReqs > 0) {
+                I2C1DevMgr_startNextReq( me );
+                status_ = Q_TRAN(&I2C1DevMgr_ValidateRequest);
+            }
+            else {
+                status_ = Q_UNHANDLED();
+            }
             break;
         }
         default: {
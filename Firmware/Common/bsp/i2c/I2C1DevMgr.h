@@ -70,6 +70,9 @@ typedef struct {
     /**< Specifies whether the request came from FreeRTOS thread or another AO */
     DC3AccessType_t accessType;
 
+    /**< Priority of the request.  Higher priority requests get the bus first */
+    I2C_Priority_t priority;
+
     /**< Which I2C device to read */
     DC3I2CDevice_t i2cDev;
 } I2CReadReqEvt;
@@ -94,6 +97,9 @@ typedef struct {
     /**< Specifies whether the request came from FreeRTOS thread or another AO */
     DC3AccessType_t accessType;
 
+    /**< Priority of the request.  Higher priority requests get the bus first */
+    I2C_Priority_t priority;
+
     /**< Which I2C device to read */
     DC3I2CDevice_t i2cDev;
 } I2CWriteReqEvt;
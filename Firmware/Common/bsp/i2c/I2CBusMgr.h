@@ -134,11 +134,8 @@ typedef struct {
     /**< Specifies whether the address is 1 byte (8 bit) or 2 bytes (10 or 16 bit) */
     uint8_t addrSize;
 
-    /**< Specifies how to access the internal memory of an I2C device:
-     *   @arg I2C_MEM_BYTE
-     *   @arg I2C_MEM_DMA
-     */
-    I2C_MemAccess_t memAccessType;
+    /**< Address of the I2C device on the bus. */
+    uint16_t devAddr;
 
     /**< How many bytes to read */
     uint16_t bytes;
@@ -162,11 +159,8 @@ typedef struct {
     /**< Specifies whether the address is 1 byte (8 bit) or 2 bytes (10 or 16 bit) */
     uint8_t addrSize;
 
-    /**< Specifies how to access the internal memory of an I2C device:
-     *   @arg I2C_MEM_BYTE
-     *   @arg I2C_MEM_DMA
-     */
-    I2C_MemAccess_t memAccessType;
+    /**< Address of the I2C device on the bus. */
+    uint16_t devAddr;
 
     /**< How many bytes to read */
     uint16_t bytes;
@@ -0,0 +1,507 @@
+/*****************************************************************************
+* Model: SPIBusMgr.qm
+* File:  ./SPIBusMgr_gen.c
+*
+* This code has been generated by QM tool (see state-machine.com/qm).
+* DO NOT EDIT THIS FILE MANUALLY. All your changes will be lost.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+* or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+* for more details.
+*****************************************************************************/
+/*${.::SPIBusMgr_gen.c} ....................................................*/
+/**
+ * @file    SPIBusMgr.c
+ * @brief   Declarations for functions for the SPIBusMgr AO.
+ * This state machine handles all I/O on the SPI bus.  It can be instantiated
+ * several times with a different bus for a parameter.  Requests are full
+ * duplex transactions that are run by DMA.  Requests that come in while a
+ * transaction is running are queued up and run in the order they came in.
+ * A transaction can leave the chip selected so that several requests make up
+ * a single SPI frame.  This AO doesn't know anything about the actual SPI
+ * devices on the bus.
+ *
+ * @note 1: If editing this file, please make sure to update the SPIBusMgr.qm
+ * model.  The generated code from that model should be very similar to the
+ * code in this file.
+ *
+ * @date    10/19/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ *
+ * @addtogroup groupSPI
+ * @{
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "SPIBusMgr.h"
+#include "project_includes.h"           /* Includes common to entire project. */
+#include "bsp.h"          /* For seconds to bsp tick conversion (SEC_TO_TICK) */
+#include "mem_stats.h"                    /* For pool and queue usage records */
+#if CPLR_APP
+#include "cplr.h"                  /* For the FreeRTOS task and its raw queue */
+#elif CPLR_BOOT
+
+#else
+    #error "Invalid build.  CPLR_APP or CPLR_BOOT must be specified"
+#endif
+
+/* Compile-time called macros ------------------------------------------------*/
+Q_DEFINE_THIS_FILE                  /* For QSPY to know the name of this file */
+DBG_DEFINE_THIS_MODULE( DC3_DBG_MODL_SPI ); /* For debug system to ID this module */
+
+/* Private typedefs ----------------------------------------------------------*/
+
+/**
+ * @brief SPIBusMgr Active Object (AO) "class" that manages an SPI bus.
+ * This AO manages the SPI bus and all events associated with it. It
+ * has exclusive access to the SPI bus and the DMA ISR handlers will let
+ * the AO know that the transaction has completed.  See SPIBusMgr.qm for
+ * diagram and model.
+ */
+/*${AOs::SPIBusMgr} ........................................................*/
+typedef struct {
+/* protected: */
+    QActive super;
+
+    /**< QPC timer Used to timeout SPI transactions if the DMA never finishes. */
+    QTimeEvt spiOpTimerEvt;
+
+    /**< Which SPI bus this AO is responsible for.  This variable is set on
+         startup and is used to index into the structure that holds all the
+         SPI bus settings. */
+    SPI_Bus_t iBus;
+
+    /**< Keep track of last error that occurs. */
+    DC3Error_t errorCode;
+
+    /**< How many bytes the current transaction moves. */
+    uint16_t len;
+
+    /**< SPI_XFER_FLAG_xxx flags of the current transaction. */
+    uint8_t flags;
+
+    /**< How the current request was made so the result goes back the same way. */
+    DC3AccessType_t accessType;
+
+    /**< Native QF queue for transaction requests that come in while busy. */
+    QEQueue deferredEvtQueue;
+
+    /**< Storage for deferred event queue. */
+    QEvt const * deferredEvtQSto[20];
+} SPIBusMgr;
+
+/* protected: */
+static QState SPIBusMgr_initial(SPIBusMgr * const me, QEvt const * const e);
+
+/**
+ * @brief This state is a catch-all Active state.
+ * If any signals need to be handled that do not cause state transitions and
+ * are common to the entire AO, they should be handled here.
+ *
+ * @param  [in,out] me: Pointer to the state machine
+ * @param  [in,out] e:  Pointer to the event being processed.
+ * @return status_: QState type that specifies where the state
+ * machine is going next.
+ */
+static QState SPIBusMgr_Active(SPIBusMgr * const me, QEvt const * const e);
+
+/**
+ * @brief This state indicates that the SPI bus is currently idle and the
+ * incoming request can be handled.
+ * This state is the default rest state of the state machine.  Upon entry, it
+ * also checks the deferred queue to see if any requests are waiting which were
+ * posted while the SPI bus was busy.  If there are any waiting, it will read
+ * one out, which automatically posts it and the state machine will go and
+ * handle it.
+ *
+ * @param  [in,out] me: Pointer to the state machine
+ * @param  [in,out] e:  Pointer to the event being processed.
+ * @return status: QState type that specifies where the state
+ * machine is going next.
+ */
+static QState SPIBusMgr_Idle(SPIBusMgr * const me, QEvt const * const e);
+
+/**
+ * @brief   This state indicates that the SPI bus is currently busy and cannot
+ * process incoming requests; incoming requests will be deferred in this state
+ * and handled once the AO goes back to Idle state.
+ *
+ * @param  [in,out] me: Pointer to the state machine
+ * @param  [in,out] e:  Pointer to the event being processed.
+ * @return status: QState type that specifies where the state
+ * machine is going next.
+ */
+static QState SPIBusMgr_Busy(SPIBusMgr * const me, QEvt const * const e);
+
+/**
+ * @brief This is a Wait state for a DMA driven SPI transaction.
+ *
+ * On entry, this state selects the chip (unless the last transaction kept it
+ * selected) and starts both DMA streams.  From then on the DMA ISRs run the
+ * transaction and post a single SPI_BUS_XFER_DONE event when it's over,
+ * whether it worked or not.  The operation timer only catches transactions
+ * where the DMA never finished.
+ *
+ * On exit, the result (and the received data) is sent back to whoever made the
+ * request.
+ *
+ * @param  [in,out] me: Pointer to the state machine
+ * @param  [in,out] e:  Pointer to the event being processed.
+ * @return status_: QState type that specifies where the state
+ * machine is going next.
+ */
+static QState SPIBusMgr_WaitForXfer(SPIBusMgr * const me, QEvt const * const e);
+
+/* Private defines -----------------------------------------------------------*/
+/* Private macros ------------------------------------------------------------*/
+/* Private variables and Local objects ---------------------------------------*/
+static SPIBusMgr l_SPIBusMgr[MAX_SPI_BUS]; /* the single instance of the active object */
+
+/* Global-scope objects ------------------------------------------------------*/
+QActive * const AO_SPIBusMgr[MAX_SPI_BUS] = {
+    (QActive *)&l_SPIBusMgr[SPIBus5], /* "opaque" AO pointer to the SPIBusMgr for SPI5 */
+};
+extern SPI_BusSettings_t s_SPI_Bus[MAX_SPI_BUS];
+
+/* Private function prototypes -----------------------------------------------*/
+
+/**
+ * @brief   Send the result of a transaction back to whoever requested it.
+ * FreeRTOS requests get it put directly into the CPLR task's queue in the
+ * Application.  Everybody else gets it published.
+ *
+ * @param  [in] me: Pointer to the state machine
+ * @param  [in] accessType: DC3AccessType_t of the request.
+ * @param  [in] status: DC3Error_t result of the transaction.
+ * @param  [in] len: uint16_t how many bytes of received data to send back.
+ * @return: None
+ */
+/*${AOs::SPIBusMgr_sendDone} ...............................................*/
+static void SPIBusMgr_sendDone(SPIBusMgr const * const me, DC3AccessType_t accessType, DC3Error_t status, uint16_t len);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief C "constructor" for SPIBusMgr "class".
+ * Initializes all the timers and queues used by the AO, sets up a deferral
+ * queue, and sets of the first state.
+ * @param  [in] iBus: SPI_Bus_t type that specifies which SPI bus this AO is
+ * responsible for.
+ * @retval None
+ */
+/*${AOs::SPIBusMgr_ctor} ...................................................*/
+void SPIBusMgr_ctor(SPI_Bus_t iBus) {
+    SPIBusMgr *me = &l_SPIBusMgr[iBus]; // Get the local pointer to the external instance
+    me->iBus = iBus;  // Store which SPI bus this instance of the AO is handling
+
+    QActive_ctor( &me->super, (QStateHandler)&SPIBusMgr_initial );
+
+    /* Initialize the deferred event queue and storage for it */
+    QEQueue_init(
+        &me->deferredEvtQueue,
+        (QEvt const **)( me->deferredEvtQSto ),
+        Q_DIM(me->deferredEvtQSto)
+    );
+    MEM_STATS_regQueue( &me->deferredEvtQueue, "SPIBusMgrDefer" );
+
+    QTimeEvt_ctor( &me->spiOpTimerEvt, SPI_BUS_OP_TOUT_SIG );
+
+    dbg_slow_printf("Constructor\n");
+}
+
+/**
+ * @brief   Send the result of a transaction back to whoever requested it.
+ * FreeRTOS requests get it put directly into the CPLR task's queue in the
+ * Application.  Everybody else gets it published.
+ *
+ * @param  [in] me: Pointer to the state machine
+ * @param  [in] accessType: DC3AccessType_t of the request.
+ * @param  [in] status: DC3Error_t result of the transaction.
+ * @param  [in] len: uint16_t how many bytes of received data to send back.
+ * @return: None
+ */
+/*${AOs::SPIBusMgr_sendDone} ...............................................*/
+static void SPIBusMgr_sendDone(SPIBusMgr const * const me, DC3AccessType_t accessType, DC3Error_t status, uint16_t len) {
+    SPIXferDoneEvt *evt = Q_NEW( SPIXferDoneEvt, SPI_BUS_DONE_SIG );
+    evt->spiBus = me->iBus;
+    evt->status = status;
+    evt->len    = len;
+    MEMCPY( evt->dataBuf, s_SPI_Bus[me->iBus].pRxBuffer, evt->len );
+
+    if ( _DC3_ACCESS_FRT == accessType ) {
+    #if CPLR_APP
+        /* Post directly to the "raw" queue for FreeRTOS task to read */
+        QEQueue_postFIFO(&CPLR_evtQueue, (QEvt *)evt);
+        vTaskResume( xHandle_CPLR );
+    #elif CPLR_BOOT
+        /* Publish the event so other AOs can get it if they want */
+        QF_PUBLISH((QEvt *)evt, me);
+    #else
+        #error "Invalid build.  CPLR_APP or CPLR_BOOT must be specified"
+    #endif
+    } else {
+        /* Publish the event so other AOs can get it if they want */
+        QF_PUBLISH((QEvt *)evt, me);
+    }
+}
+
+/**
+ * @brief SPIBusMgr Active Object (AO) "class" that manages an SPI bus.
+ * This AO manages the SPI bus and all events associated with it. It
+ * has exclusive access to the SPI bus and the DMA ISR handlers will let
+ * the AO know that the transaction has completed.  See SPIBusMgr.qm for
+ * diagram and model.
+ */
+/*${AOs::SPIBusMgr} ........................................................*/
+/*${AOs::SPIBusMgr::SM} ....................................................*/
+static QState SPIBusMgr_initial(SPIBusMgr * const me, QEvt const * const e) {
+    /* ${AOs::SPIBusMgr::SM::initial} */
+    (void)e;        /* suppress the compiler warning about unused parameter */
+
+    me->errorCode = ERR_NONE; // Initialize error code to no error.
+
+    QS_OBJ_DICTIONARY(&l_SPIBusMgr);
+    QS_FUN_DICTIONARY(&QHsm_top);
+    QS_FUN_DICTIONARY(&SPIBusMgr_initial);
+    QS_FUN_DICTIONARY(&SPIBusMgr_Active);
+    QS_FUN_DICTIONARY(&SPIBusMgr_Idle);
+    QS_FUN_DICTIONARY(&SPIBusMgr_Busy);
+    QS_FUN_DICTIONARY(&SPIBusMgr_WaitForXfer);
+    return Q_TRAN(&SPIBusMgr_Idle);
+}
+
+/**
+ * @brief This state is a catch-all Active state.
+ * If any signals need to be handled that do not cause state transitions and
+ * are common to the entire AO, they should be handled here.
+ *
+ * @param  [in,out] me: Pointer to the state machine
+ * @param  [in,out] e:  Pointer to the event being processed.
+ * @return status_: QState type that specifies where the state
+ * machine is going next.
+ */
+/*${AOs::SPIBusMgr::SM::Active} ............................................*/
+static QState SPIBusMgr_Active(SPIBusMgr * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        /* ${AOs::SPIBusMgr::SM::Active} */
+        case Q_ENTRY_SIG: {
+            /* Post the timer and disarm it right away so it can be rearmed at any point
+             * without worrying asserts. */
+            QTimeEvt_postIn(
+                &me->spiOpTimerEvt,
+                (QActive *)me,
+                SEC_TO_TICKS( LL_MAX_TOUT_SEC_SPI_XFER )
+            );
+            QTimeEvt_disarm(&me->spiOpTimerEvt);
+
+            SPI_BusInit( me->iBus ); /* Initialize the SPI bus and its DMA */
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm_top);
+            break;
+        }
+    }
+    return status_;
+}
+
+/**
+ * @brief This state indicates that the SPI bus is currently idle and the
+ * incoming request can be handled.
+ * This state is the default rest state of the state machine.  Upon entry, it
+ * also checks the deferred queue to see if any requests are waiting which were
+ * posted while the SPI bus was busy.  If there are any waiting, it will read
+ * one out, which automatically posts it and the state machine will go and
+ * handle it.
+ *
+ * @param  [in,out] me: Pointer to the state machine
+ * @param  [in,out] e:  Pointer to the event being processed.
+ * @return status: QState type that specifies where the state
+ * machine is going next.
+ */
+/*${AOs::SPIBusMgr::SM::Active::Idle} ......................................*/
+static QState SPIBusMgr_Idle(SPIBusMgr * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        /* ${AOs::SPIBusMgr::SM::Active::Idle} */
+        case Q_ENTRY_SIG: {
+            DBG_printf("SPIBusMgr for %s back in Idle\n", CON_spiBusToStr( me->iBus ));
+
+            /* recall the next request from the private requestQueue */
+            QActive_recall(
+                (QActive *)me,
+                &me->deferredEvtQueue
+            );
+            status_ = Q_HANDLED();
+            break;
+        }
+        /* ${AOs::SPIBusMgr::SM::Active::Idle::SPI_BUS_XFER_REQ} */
+        case SPI_BUS_XFER_REQ_SIG: {
+            /* Store the transaction settings from the event */
+            me->accessType = ((SPIXferReqEvt const *)e)->accessType;
+            me->flags      = ((SPIXferReqEvt const *)e)->flags;
+            me->len        = MIN( ((SPIXferReqEvt const *)e)->len, MAX_SPI_XFER_LEN );
+            me->errorCode  = ERR_NONE;
+
+            /* Copy the data right into the TX buffer for this SPI Bus. */
+            MEMCPY(
+                s_SPI_Bus[me->iBus].pTxBuffer,
+                ((SPIXferReqEvt const *)e)->dataBuf,
+                me->len
+            );
+            status_ = Q_TRAN(&SPIBusMgr_WaitForXfer);
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&SPIBusMgr_Active);
+            break;
+        }
+    }
+    return status_;
+}
+
+/**
+ * @brief   This state indicates that the SPI bus is currently busy and cannot
+ * process incoming requests; incoming requests will be deferred in this state
+ * and handled once the AO goes back to Idle state.
+ *
+ * @param  [in,out] me: Pointer to the state machine
+ * @param  [in,out] e:  Pointer to the event being processed.
+ * @return status: QState type that specifies where the state
+ * machine is going next.
+ */
+/*${AOs::SPIBusMgr::SM::Active::Busy} ......................................*/
+static QState SPIBusMgr_Busy(SPIBusMgr * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        /* ${AOs::SPIBusMgr::SM::Active::Busy} */
+        case Q_EXIT_SIG: {
+            QTimeEvt_disarm( &me->spiOpTimerEvt ); /* Disarm timer on exit */
+            status_ = Q_HANDLED();
+            break;
+        }
+        /* ${AOs::SPIBusMgr::SM::Active::Busy::SPI_BUS_XFER_REQ} */
+        case SPI_BUS_XFER_REQ_SIG: {
+            if (QEQueue_getNFree(&me->deferredEvtQueue) > 0) {
+               /* defer the request - this event will be handled
+                * when the state machine goes back to Idle state */
+               QActive_defer((QActive *)me, &me->deferredEvtQueue, e);
+            } else {
+               /* notify the request sender that the request was ignored.. */
+               ERR_printf("Unable to defer SPI request on %s\n", CON_spiBusToStr( me->iBus ));
+               SPIBusMgr_sendDone(
+                   me,
+                   ((SPIXferReqEvt const *)e)->accessType,
+                   ERR_SPI_BUSY,
+                   0
+               );
+            }
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&SPIBusMgr_Active);
+            break;
+        }
+    }
+    return status_;
+}
+
+/**
+ * @brief This is a Wait state for a DMA driven SPI transaction.
+ *
+ * On entry, this state selects the chip (unless the last transaction kept it
+ * selected) and starts both DMA streams.  From then on the DMA ISRs run the
+ * transaction and post a single SPI_BUS_XFER_DONE event when it's over,
+ * whether it worked or not.  The operation timer only catches transactions
+ * where the DMA never finished.
+ *
+ * On exit, the result (and the received data) is sent back to whoever made the
+ * request.
+ *
+ * @param  [in,out] me: Pointer to the state machine
+ * @param  [in,out] e:  Pointer to the event being processed.
+ * @return status_: QState type that specifies where the state
+ * machine is going next.
+ */
+/*${AOs::SPIBusMgr::SM::Active::Busy::WaitForXfer} .........................*/
+static QState SPIBusMgr_WaitForXfer(SPIBusMgr * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        /* ${AOs::SPIBusMgr::SM::Active::Busy::WaitForXfer} */
+        case Q_ENTRY_SIG: {
+            /* Post an operation timer on entry */
+            QTimeEvt_rearm(
+                &me->spiOpTimerEvt,
+                SEC_TO_TICKS( LL_MAX_TOUT_SEC_SPI_XFER )
+            );
+
+            /* The DMA ISRs take it from here.  Even if the transaction can't be started,
+             * the SPI_BUS_XFER_DONE event still gets posted with the error. */
+            SPI_StartXfer( me->iBus, me->len, me->flags );
+            status_ = Q_HANDLED();
+            break;
+        }
+        /* ${AOs::SPIBusMgr::SM::Active::Busy::WaitForXfer} */
+        case Q_EXIT_SIG: {
+            /* Timer disarmed in parent state */
+
+            /* Make sure the DMA lets go of the bus no matter how this state is left.  This
+             * does nothing if the transaction already finished. */
+            SPI_AbortXfer( me->iBus );
+
+            SPIBusMgr_sendDone(
+                me,
+                me->accessType,
+                me->errorCode,
+                ( ERR_NONE == me->errorCode ) ? me->len : 0
+            );
+            status_ = Q_HANDLED();
+            break;
+        }
+        /* ${AOs::SPIBusMgr::SM::Active::Busy::WaitForXfer::SPI_BUS_XFER_DON~} */
+        case SPI_BUS_XFER_DONE_SIG: {
+            me->errorCode = SPI_getXferStatus( me->iBus );
+            if ( ERR_NONE != me->errorCode ) {
+                ERR_printf(
+                    "Transaction failed on %s.  Error: 0x%08x\n",
+                    CON_spiBusToStr( me->iBus ),
+                    me->errorCode
+                );
+            }
+            status_ = Q_TRAN(&SPIBusMgr_Idle);
+            break;
+        }
+        /* ${AOs::SPIBusMgr::SM::Active::Busy::WaitForXfer::SPI_BUS_OP_TOUT} */
+        case SPI_BUS_OP_TOUT_SIG: {
+            me->errorCode = SPI_getXferStatus( me->iBus );
+            ERR_printf(
+                "Transaction timeout on %s.  Error: 0x%08x\n",
+                CON_spiBusToStr( me->iBus ),
+                me->errorCode
+            );
+            status_ = Q_TRAN(&SPIBusMgr_Idle);
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&SPIBusMgr_Busy);
+            break;
+        }
+    }
+    return status_;
+}
+
+
+/**
+ * @} end addtogroup groupSPI
+ */
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
@@ -0,0 +1,124 @@
+/*****************************************************************************
+* Model: SPIBusMgr.qm
+* File:  ./SPIBusMgr_gen.h
+*
+* This code has been generated by QM tool (see state-machine.com/qm).
+* DO NOT EDIT THIS FILE MANUALLY. All your changes will be lost.
+*
+* This program is open source software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License as published
+* by the Free Software Foundation.
+*
+* This program is distributed in the hope that it will be useful, but
+* WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+* or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+* for more details.
+*****************************************************************************/
+/*${.::SPIBusMgr_gen.h} ....................................................*/
+/**
+ * @file    SPIBusMgr.c
+ * @brief   Declarations for functions for the SPIBusMgr AO.
+ * This state machine handles all I/O on the SPI bus.  It can be instantiated
+ * several times with a different bus for a parameter.  Requests are full
+ * duplex transactions that are run by DMA.  Requests that come in while a
+ * transaction is running are queued up and run in the order they came in.
+ * A transaction can leave the chip selected so that several requests make up
+ * a single SPI frame.  This AO doesn't know anything about the actual SPI
+ * devices on the bus.
+ *
+ * @note 1: If editing this file, please make sure to update the SPIBusMgr.qm
+ * model.  The generated code from that model should be very similar to the
+ * code in this file.
+ *
+ * @date    10/19/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ *
+ * @addtogroup groupSPI
+ * @{
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef SPIBUSMGR_H_
+#define SPIBUSMGR_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include "qp_port.h"                                        /* for QP support */
+#include "Shared.h"                                   /*  Common Declarations */
+#include "spi.h"                                  /* For SPI bus declarations */
+
+/* Exported defines ----------------------------------------------------------*/
+/* Exported macros -----------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief Event struct type for requesting a transaction on an SPI bus.
+ */
+/*${Events::SPIXferReqEvt} .................................................*/
+typedef struct {
+/* protected: */
+    QEvt super;
+
+    /**< Which SPI bus the transaction is for. */
+    SPI_Bus_t spiBus;
+
+    /**< How the request was made.  The result goes back the same way. */
+    DC3AccessType_t accessType;
+
+    /**< SPI_XFER_FLAG_xxx flags for the transaction. */
+    uint8_t flags;
+
+    /**< How many bytes to transceive. */
+    uint16_t len;
+
+    /**< Data to clock out. */
+    uint8_t dataBuf[MAX_SPI_XFER_LEN];
+} SPIXferReqEvt;
+
+/**
+ * @brief Event struct type for the result of a transaction on an SPI bus.
+ */
+/*${Events::SPIXferDoneEvt} ................................................*/
+typedef struct {
+/* protected: */
+    QEvt super;
+
+    /**< Which SPI bus the transaction was on. */
+    SPI_Bus_t spiBus;
+
+    /**< Result error code of the transaction.  ERR_NONE if OK. */
+    DC3Error_t status;
+
+    /**< How many bytes were transceived. */
+    uint16_t len;
+
+    /**< Data that was clocked in. */
+    uint8_t dataBuf[MAX_SPI_XFER_LEN];
+} SPIXferDoneEvt;
+
+
+/* Exported constants --------------------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief C "constructor" for SPIBusMgr "class".
+ * Initializes all the timers and queues used by the AO, sets up a deferral
+ * queue, and sets of the first state.
+ * @param  [in] iBus: SPI_Bus_t type that specifies which SPI bus this AO is
+ * responsible for.
+ * @retval None
+ */
+/*${AOs::SPIBusMgr_ctor} ...................................................*/
+void SPIBusMgr_ctor(SPI_Bus_t iBus);
+
+
+/**< "opaque" pointer to the Active Object */
+extern QActive * const AO_SPIBusMgr[MAX_SPI_BUS];
+
+
+/**
+ * @} end addtogroup groupSPI
+ */
+#endif                                                        /* SPIBUSMGR_H_ */
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
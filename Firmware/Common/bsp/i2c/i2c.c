@@ -123,6 +123,13 @@ I2C_BusSettings_t s_I2C_Bus[MAX_I2C_BUS] =
             I2C_Direction_Transmitter, /**< bTransDirection */
             0,                         /**< nBytesExpected */
             0,                         /**< nBytesCurrent */
+
+            /* Interrupt driven transfer */
+            { I2C_XFER_IDLE },         /**< xfer */
+
+            /* Health counters */
+            0,                         /**< nErrors */
+            0,                         /**< nRecoveries */
       }
 };
 
@@ -185,6 +192,34 @@ static DC3Error_t I2C_writePageBLK(
       uint16_t bytesToWrite
 );
 
+/**
+ * @brief  Do what the i2c_xfer engine asked for to the I2C peripheral.
+ *
+ * This is the only place where the engine's actions touch the hardware.  It's
+ * called from the I2C event and error ISRs, the DMA ISRs, and once from
+ * I2C_StartXfer() to kick the transfer off.
+ *
+ * @param [in] iBus: I2C_Bus_t type specifying the I2C bus.
+ *    @arg I2CBus1
+ * @param [in] sr1: uint16_t value of SR1 that the engine was given.  If ADDR is
+ * set, it gets cleared here at the right point of the sequence.
+ * @param [in] act: I2C_XferAction_t action returned by the engine.
+ * @return: None
+ */
+static void I2C_doXferAction(
+      const I2C_Bus_t iBus,
+      const uint16_t sr1,
+      I2C_XferAction_t act
+);
+
+/**
+ * @brief  Turn off everything an interrupt driven transfer was using.
+ * @param [in] iBus: I2C_Bus_t type specifying the I2C bus.
+ *    @arg I2CBus1
+ * @return: None
+ */
+static void I2C_endXfer( const I2C_Bus_t iBus );
+
 /**
  * @brief  I2C error handling callback for slow blocking I2C bus access
  * functions.
@@ -262,6 +297,13 @@ void I2C_BusInit( I2C_Bus_t iBus )
    DMA_DeInit( s_I2C_Bus[iBus].i2c_dma_tx_stream );
 
    /* 4. Set up interrupts -------------------------------------------------- */
+   /* Set up Interrupt controller to handle I2C Event interrupts.  These only get
+    * enabled in the I2C peripheral while a transfer is running. */
+   NVIC_Config(
+         s_I2C_Bus[iBus].i2c_ev_irq_num,
+         s_I2C_Bus[iBus].i2c_ev_irq_prio
+   );
+
    /* Set up Interrupt controller to handle I2C Error interrupts */
    NVIC_Config(
          s_I2C_Bus[iBus].i2c_er_irq_num,
@@ -351,6 +393,8 @@ void I2C_BusDeInit( I2C_Bus_t iBus )
 /******************************************************************************/
 void I2C_BusInitForRecovery( I2C_Bus_t iBus )
 {
+   s_I2C_Bus[iBus].nRecoveries++;
+
    /* 1. DeInit the I2C bus */
    I2C_BusDeInit( iBus );
 
@@ -435,8 +479,6 @@ void I2C_StartDMARead( I2C_Bus_t iBus, uint16_t wReadLen )
    DMA_InitStructure.DMA_Memory0BaseAddr     = (uint32_t)s_I2C_Bus[iBus].pRxBuffer;
    DMA_InitStructure.DMA_BufferSize          = s_I2C_Bus[iBus].nBytesExpected;
 
-   DBG_printf("Attempting to read via DMA %d bytes\n", DMA_InitStructure.DMA_BufferSize);
-
    /* Initialize the DMA with the filled in structure */
    DMA_Init( s_I2C_Bus[iBus].i2c_dma_rx_stream, &DMA_InitStructure );
 
@@ -491,8 +533,6 @@ void I2C_StartDMAWrite( I2C_Bus_t iBus, uint16_t wWriteLen )
    DMA_InitStructure.DMA_Memory0BaseAddr     = (uint32_t)s_I2C_Bus[iBus].pTxBuffer;
    DMA_InitStructure.DMA_BufferSize          = s_I2C_Bus[iBus].nBytesExpected;
 
-   DBG_printf("Attempting to write via DMA %d bytes\n", DMA_InitStructure.DMA_BufferSize);
-
    /* Initialize the DMA with the filled in structure */
    DMA_Init( s_I2C_Bus[iBus].i2c_dma_tx_stream, &DMA_InitStructure );
 
@@ -512,6 +552,170 @@ void I2C_StartDMAWrite( I2C_Bus_t iBus, uint16_t wWriteLen )
    DMA_Cmd( s_I2C_Bus[iBus].i2c_dma_tx_stream, ENABLE );
 }
 
+/******************************************************************************/
+DC3Error_t I2C_StartXfer(
+      const I2C_Bus_t iBus,
+      const uint8_t devAddr,
+      const uint16_t memAddr,
+      const uint8_t memAddrSize,
+      const I2C_XferDir_t dir,
+      const uint16_t len
+)
+{
+   /* Check inputs */
+   assert_param( IS_I2C_BUS( iBus ) );
+
+   uint8_t *pBuf = s_I2C_Bus[iBus].pTxBuffer;
+   uint16_t maxLen = MAX_I2C_WRITE_LEN;
+   if ( I2C_XFER_READ == dir ) {
+      pBuf = s_I2C_Bus[iBus].pRxBuffer;
+      maxLen = MAX_I2C_READ_LEN;
+   }
+
+   I2C_XferAction_t act = I2C_XferStart(
+         &s_I2C_Bus[iBus].xfer,
+         devAddr,
+         memAddr,
+         memAddrSize,
+         dir,
+         pBuf,
+         ( len > maxLen ) ? 0 : len          /* Too long gets rejected as 0 */
+   );
+
+   /* The engine is all set up so the ISRs can take over from here */
+   if ( !(act.acts & I2C_XFER_ACT_DONE) ) {
+      I2C_ClearFlag( s_I2C_Bus[iBus].i2c_bus, I2C_FLAG_AF | I2C_FLAG_ARLO | I2C_FLAG_BERR );
+      I2C_ITConfig( s_I2C_Bus[iBus].i2c_bus, I2C_IT_EVT, ENABLE );
+   }
+
+   I2C_doXferAction( iBus, 0, act );
+
+   return( ( act.acts & I2C_XFER_ACT_DONE ) ? s_I2C_Bus[iBus].xfer.status : ERR_NONE );
+}
+
+/******************************************************************************/
+void I2C_AbortXfer( const I2C_Bus_t iBus )
+{
+   /* Check inputs */
+   assert_param( IS_I2C_BUS( iBus ) );
+
+   /* Nothing to do if the transfer already finished */
+   if ( !I2C_XferIsBusy( &s_I2C_Bus[iBus].xfer ) ) {
+      return;
+   }
+
+   /* Keep the ISRs from running the transfer any further before anything else */
+   I2C_endXfer( iBus );
+   s_I2C_Bus[iBus].xfer.state = I2C_XFER_IDLE;
+
+   I2C_GenerateSTOP( s_I2C_Bus[iBus].i2c_bus, ENABLE );
+}
+
+/******************************************************************************/
+DC3Error_t I2C_getXferStatus( const I2C_Bus_t iBus )
+{
+   /* Check inputs */
+   assert_param( IS_I2C_BUS( iBus ) );
+
+   return( s_I2C_Bus[iBus].xfer.status );
+}
+
+/******************************************************************************/
+uint32_t I2C_getErrorCount( const I2C_Bus_t iBus )
+{
+   /* Check inputs */
+   assert_param( IS_I2C_BUS( iBus ) );
+
+   return( s_I2C_Bus[iBus].nErrors );
+}
+
+/******************************************************************************/
+uint32_t I2C_getRecoveryCount( const I2C_Bus_t iBus )
+{
+   /* Check inputs */
+   assert_param( IS_I2C_BUS( iBus ) );
+
+   return( s_I2C_Bus[iBus].nRecoveries );
+}
+
+/******************************************************************************/
+static void I2C_doXferAction(
+      const I2C_Bus_t iBus,
+      const uint16_t sr1,
+      I2C_XferAction_t act
+)
+{
+   I2C_TypeDef *i2c = s_I2C_Bus[iBus].i2c_bus;
+
+   /* These two have to happen before ADDR gets cleared */
+   if ( act.acts & I2C_XFER_ACT_ACK_OFF ) {
+      I2C_AcknowledgeConfig( i2c, DISABLE );
+   }
+
+   if ( act.acts & I2C_XFER_ACT_DMA_RX ) {
+      /* The DMA TC interrupt is the only one left to wait for.  Don't let a BTF
+       * from a DMA that fell behind keep firing the event ISR. */
+      I2C_ITConfig( i2c, I2C_IT_EVT, DISABLE );
+      I2C_DMALastTransferCmd( i2c, ENABLE );  /* Have the I2C NACK the last byte */
+      I2C_StartDMARead( iBus, s_I2C_Bus[iBus].xfer.len );
+   }
+
+   /* ADDR is cleared by reading SR2 after SR1.  Do it even if the engine didn't
+    * want it or the interrupt would keep firing. */
+   if ( sr1 & I2C_XFER_SR1_ADDR ) {
+      (void)I2C_ReadRegister( i2c, I2C_Register_SR2 );
+   }
+
+   if ( act.acts & I2C_XFER_ACT_SEND_BYTE ) {
+      I2C_SendData( i2c, act.byte );
+   }
+
+   if ( act.acts & I2C_XFER_ACT_DMA_TX ) {
+      I2C_StartDMAWrite( iBus, s_I2C_Bus[iBus].xfer.len );
+   }
+
+   if ( act.acts & I2C_XFER_ACT_START ) {
+      I2C_GenerateSTART( i2c, ENABLE );
+   }
+
+   if ( act.acts & I2C_XFER_ACT_STOP ) {
+      I2C_GenerateSTOP( i2c, ENABLE );
+   }
+
+   if ( act.acts & I2C_XFER_ACT_BUF_IT_ON ) {
+      I2C_ITConfig( i2c, I2C_IT_BUF, ENABLE );
+   }
+
+   if ( act.acts & I2C_XFER_ACT_READ_BYTE ) {
+      act = I2C_XferOnRxByte( &s_I2C_Bus[iBus].xfer, I2C_ReceiveData( i2c ) );
+   }
+
+   if ( act.acts & I2C_XFER_ACT_DONE ) {
+      I2C_endXfer( iBus );
+
+      /* Don't transport the result with the event.  The appropriate I2CBusMgr
+       * AO will get it with I2C_getXferStatus() and copy out the data from the
+       * buffers.  Nobody else is allowed to touch this bus so there's no
+       * contention. */
+      static QEvt const qEvt = { I2C_BUS_XFER_DONE_SIG, 0U, 0U };
+      QACTIVE_POST(AO_I2CBusMgr[iBus], &qEvt, AO_I2CBusMgr[iBus]);
+   }
+}
+
+/******************************************************************************/
+static void I2C_endXfer( const I2C_Bus_t iBus )
+{
+   I2C_ITConfig( s_I2C_Bus[iBus].i2c_bus, I2C_IT_EVT | I2C_IT_BUF, DISABLE );
+
+   DMA_Cmd( s_I2C_Bus[iBus].i2c_dma_rx_stream, DISABLE );
+   DMA_Cmd( s_I2C_Bus[iBus].i2c_dma_tx_stream, DISABLE );
+   I2C_DMACmd( s_I2C_Bus[iBus].i2c_bus, DISABLE );
+   I2C_DMALastTransferCmd( s_I2C_Bus[iBus].i2c_bus, DISABLE );
+
+   /* Re-Enable Acknowledgment to be ready for another reception */
+   I2C_AcknowledgeConfig( s_I2C_Bus[iBus].i2c_bus, ENABLE );
+}
+
 /******************************************************************************/
 /***                      Blocking functions for I2C                        ***/
 /* These functions block when called and should only be called before any AOs */
@@ -855,55 +1059,17 @@ inline void I2C1_DMAReadCallback( void )
 {
    /* Test on DMA Stream Transfer Complete interrupt */
    if ( RESET != DMA_GetITStatus(DMA1_Stream0, DMA_IT_TCIF0) ) {
-      /* Start of STM32 I2C HW bug workaround:
-       * This is a workaround for the STM32 I2C hardware bug.  You have to send
-       * the STOP bit before receiving the last byte.  In the case of DMA xfers,
-       * this means doing it before you shut off the DMA stream.
-       * See the STM32 errata for more details. - HR */
-
-      I2C_AcknowledgeConfig( I2C1, DISABLE);        /* Disable Acknowledgment */
-
-      /* Disable DMA so it doesn't keep outputting the buffer. */
-      //      DMA_Cmd( DMA1_Stream0, DISABLE );
-      I2C_GenerateSTOP(I2C1, ENABLE);                        /* Generate Stop */
-
-      /* Wait for the byte to be received.
-       * Note: There's really no way around waiting for this flag to be reset
-       * outside of the ISR since you have to do this BEFORE you shut off DMA
-       * which has to be done in this ISR. Thankfully, this flag gets reset
-       * fairly quickly (125 times through the loop). - HR. */
-      uint16_t nI2CBusTimeout = MAX_I2C_TIMEOUT;
-      while(I2C_GetFlagStatus(I2C1, I2C_FLAG_RXNE) == RESET) {
-         if((nI2CBusTimeout--) == 0) {
-            ERR_printf("Timeout waiting for I2C Stop bit flag reset!\n");
-
-            /* Error condition.  Make sure to do proper cleanup*/
-            goto I2C1_DMAReadCallback_cleanup;
-         }
-      }
-
-      I2C_AcknowledgeConfig(I2C1, ENABLE);        /* Re-enable Acknowledgment */
-      /* End of STM32 I2C HW bug workaround */
-
-      /* Disable DMA so it doesn't keep outputting the buffer. */
-      DMA_Cmd( DMA1_Stream0, DISABLE );
-
-      /* Don't transport the data with the event.  The appropriate I2CBusMgr AO
-       * will handle copying out the data from the buffers.  Nobody else is
-       * allowed to touch this bus so there's no contention. */
-      static QEvt const qEvt = { I2C_BUS_DMA_DONE_SIG, 0U, 0U };
-      QACTIVE_POST(AO_I2CBusMgr[I2CBus1], &qEvt, AO_I2CBusMgr[I2CBus1]);
-
-      //      DBG_printf("%d loop iters\n", MAX_I2C_TIMEOUT - nI2CBusTimeout);
-
-      /* Tag for a common exit from this handler.  DON'T call return.  Instead, use
-       * goto I2C1_DMAReadCallback_cleanup;
-       * This allows for always correctly clearing the interrupt status bits. Else
-       * things will lock up. */
-      I2C1_DMAReadCallback_cleanup:
-
       /* Clear DMA Stream Transfer Complete interrupt pending bit */
       DMA_ClearITPendingBit( DMA1_Stream0, DMA_IT_TCIF0 );
+
+      /* With DMA LAST set, the peripheral already NACKed the last byte so there
+       * is no need to wait around for RXNE here.  The engine asks for the STOP
+       * and the done event. */
+      I2C_doXferAction(
+            I2CBus1,
+            0,
+            I2C_XferOnDmaDone( &s_I2C_Bus[I2CBus1].xfer )
+      );
    }
 }
 
@@ -912,56 +1078,31 @@ inline void I2C1_DMAWriteCallback( void )
 {
    /* Test on DMA Stream Transfer Complete interrupt */
    if ( RESET != DMA_GetITStatus(DMA1_Stream6, DMA_IT_TCIF6) ) {
-
-      /* Wait for the byte to be sent over the I2C bus.
-       * Note: There's really no way around waiting for this flag to be reset
-       * outside of the ISR since you have to do this BEFORE you shut off DMA
-       * which has to be done in this ISR. Thankfully, this flag gets reset
-       * fairly quickly (125 times through the loop at 100kHz and 57 at 400kHz).
-       * - HR. */
-      uint16_t nI2CBusTimeout = MAX_I2C_TIMEOUT;
-      while(I2C_GetFlagStatus(I2C1, I2C_FLAG_BTF) == RESET) {
-         if((nI2CBusTimeout--) == 0) {
-            ERR_printf("Timeout waiting for I2C Stop bit flag reset!\n");
-
-            /* Error condition.  Make sure to do proper cleanup*/
-            goto I2C1_DMAWriteCallback_cleanup;
-         }
-      }
-
-      I2C_GenerateSTOP(I2C1, ENABLE);                        /* Generate Stop */
-
-      DMA_Cmd( DMA1_Stream6, DISABLE );            /* Disable the DMA stream. */
-
-      /* Directly post event to the correct I2CBusMgr AO instance indicating
-       * that the DMA is finished. Let it decide what to do. */
-      static QEvt const qEvt = { I2C_BUS_DMA_DONE_SIG, 0U, 0U };
-      QACTIVE_POST(AO_I2CBusMgr[I2CBus1], &qEvt, AO_I2CBusMgr[I2CBus1]);
-
-      DBG_printf("%d loop iters\n", MAX_I2C_TIMEOUT - nI2CBusTimeout);
-
-      /* Tag for a common exit from this handler.  DON'T call return.  Instead, use
-       * goto I2C1_DMAWriteCallback_cleanup;
-       * This allows for always correctly clearing the interrupt status bits. Else
-       * things will lock up. */
-      I2C1_DMAWriteCallback_cleanup:
       /* Clear DMA Stream Transfer Complete interrupt pending bit */
       DMA_ClearITPendingBit( DMA1_Stream6, DMA_IT_TCIF6 );
+
+      /* The last byte is still going out over the bus.  Instead of spinning on
+       * BTF here, the engine waits for the BTF event interrupt to send STOP. */
+      I2C_doXferAction(
+            I2CBus1,
+            0,
+            I2C_XferOnDmaDone( &s_I2C_Bus[I2CBus1].xfer )
+      );
    }
 }
 
 /******************************************************************************/
 inline void I2C1_EventCallback( void )
 {
-//   QF_CRIT_STAT_TYPE intStat;
-//   BaseType_t lHigherPriorityTaskWoken = pdFALSE;
-//
-//   QF_ISR_ENTRY(intStat);                        /* inform QF about ISR entry */
-//
-//   QF_ISR_EXIT(intStat, lHigherPriorityTaskWoken);/* inform QF about ISR exit */
-//
-//   /* the usual end of FreeRTOS ISR... */
-//   portEND_SWITCHING_ISR(lHigherPriorityTaskWoken);
+   /* Reading SR1 is the first half of clearing ADDR.  I2C_doXferAction() does
+    * the second half at the right point of the sequence. */
+   uint16_t sr1 = I2C_ReadRegister(I2C1, I2C_Register_SR1);
+
+   I2C_doXferAction(
+         I2CBus1,
+         sr1,
+         I2C_XferOnEvent( &s_I2C_Bus[I2CBus1].xfer, sr1 )
+   );
 }
 
 /******************************************************************************/
@@ -972,9 +1113,22 @@ inline void I2C1_ErrorEventCallback( void )
    if (regVal != 0x0000) {
       /* Clears error flags */
       I2C1->SR1 &= 0x00FF;
-
-      ERR_printf("I2C Error: 0x%04x.  Resetting error bits\n", regVal);
-      I2C_BusInit( I2CBus1 );
+      s_I2C_Bus[I2CBus1].nErrors++;
+
+      if ( I2C_XferIsBusy( &s_I2C_Bus[I2CBus1].xfer ) ) {
+         /* Let the transfer fail so the I2CBusMgr AO gets the error right away
+          * instead of waiting for its timeout. */
+         DMA_Cmd( DMA1_Stream0, DISABLE );
+         DMA_Cmd( DMA1_Stream6, DISABLE );
+         I2C_doXferAction(
+               I2CBus1,
+               0,
+               I2C_XferOnError( &s_I2C_Bus[I2CBus1].xfer, regVal )
+         );
+      } else {
+         ERR_printf("I2C Error: 0x%04x.  Resetting error bits\n", regVal);
+         I2C_BusInit( I2CBus1 );
+      }
    }
 }
 
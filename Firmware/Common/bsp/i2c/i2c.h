@@ -157,6 +157,82 @@ void I2C_StartDMARead( I2C_Bus_t iBus, uint16_t wReadLen );
  */
 void I2C_StartDMAWrite( I2C_Bus_t iBus, uint16_t wWriteLen );
 
+/**
+ * @brief   Start an interrupt driven memory transfer on the specified I2C bus.
+ *
+ * This function kicks off the whole transfer (START, device address, internal
+ * memory address, repeated START and data for reads, STOP).  The I2C event and
+ * DMA ISRs run it from there using the i2c_xfer engine and post a single
+ * I2C_BUS_XFER_DONE_SIG to the I2CBusMgr AO for this bus when it's over.  Use
+ * I2C_getXferStatus() to get the result.
+ *
+ * @param [in]  iBus: I2C_Bus_t identifier for I2C bus
+ *    @arg  I2CBus1
+ * @param [in]  devAddr: uint8_t address of the device on the I2C bus.
+ * @param [in]  memAddr: uint16_t internal memory address of the device.
+ * @param [in]  memAddrSize: uint8_t size of the memory address memAddr.
+ *    @arg 1: a 1 byte address.
+ *    @arg 2: a 2 byte address.
+ * @param [in]  dir: I2C_XferDir_t direction of the data.
+ *    @arg  I2C_XFER_READ: data ends up in s_I2C_Bus[iBus].pRxBuffer
+ *    @arg  I2C_XFER_WRITE: data has to already be in s_I2C_Bus[iBus].pTxBuffer
+ * @param [in]  len: uint16_t how many bytes to read or write.
+ *
+ * @return DC3Error_t: status of starting the transfer.
+ *    @arg ERR_NONE: if the transfer was started.  The done event still gets
+ *    posted if it wasn't.
+ */
+DC3Error_t I2C_StartXfer(
+      const I2C_Bus_t iBus,
+      const uint8_t devAddr,
+      const uint16_t memAddr,
+      const uint8_t memAddrSize,
+      const I2C_XferDir_t dir,
+      const uint16_t len
+);
+
+/**
+ * @brief   Abort the interrupt driven transfer on the specified I2C bus.
+ *
+ * This function stops the ISRs from doing anything else with the transfer and
+ * puts a STOP on the bus.  It's meant for timeouts.  It does nothing if the
+ * transfer already finished.
+ *
+ * @param [in]  iBus: I2C_Bus_t identifier for I2C bus
+ *    @arg  I2CBus1
+ * @return: None
+ */
+void I2C_AbortXfer( const I2C_Bus_t iBus );
+
+/**
+ * @brief   Get the status of the last interrupt driven transfer.
+ *
+ * @param [in]  iBus: I2C_Bus_t identifier for I2C bus
+ *    @arg  I2CBus1
+ * @return DC3Error_t: ERR_NONE if the transfer finished fine.  If it hasn't
+ * finished, this is the timeout error for the step it's stuck on.
+ */
+DC3Error_t I2C_getXferStatus( const I2C_Bus_t iBus );
+
+/**
+ * @brief   Get the number of error interrupts the I2C bus had since boot.
+ *
+ * @param [in]  iBus: I2C_Bus_t identifier for I2C bus
+ *    @arg  I2CBus1
+ * @return uint32_t: number of error interrupts (bus error, arbitration loss,
+ * NACK, overrun, etc).
+ */
+uint32_t I2C_getErrorCount( const I2C_Bus_t iBus );
+
+/**
+ * @brief   Get the number of times the I2C bus was set up for recovery.
+ *
+ * @param [in]  iBus: I2C_Bus_t identifier for I2C bus
+ *    @arg  I2CBus1
+ * @return uint32_t: number of calls to I2C_BusInitForRecovery().
+ */
+uint32_t I2C_getRecoveryCount( const I2C_Bus_t iBus );
+
 
 /**
  * @brief   Get the string representation of the I2C Bus.
@@ -251,13 +327,6 @@ DC3Error_t I2C_writeBufferBLK( /* TODO: does this belong in i2c_dev? */
  * is so it can be called externally (by the file that contains the actual ISRs)
  * and they can still be inlined so as not incur any function call overhead.
  *
- * @note: There is a I2C1_DMAReadCallback_cleanup tag defined within this
- * handler.  Use it for a common exit from this handler.  DON'T call return.
- * Instead, use
- * goto I2C1_DMAReadCallback_cleanup;
- * This allows for always correctly clearing the interrupt status bits. Else
- * things will lock up.
- *
  * @param   None
  * @return: None
  */
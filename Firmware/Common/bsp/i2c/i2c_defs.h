@@ -28,11 +28,13 @@ extern "C" {
 #include "bsp_defs.h"
 #include "Shared.h"
 #include "stm32f4xx_i2c.h"                           /* For STM32 DMA support */
+#include "i2c_xfer.h"                         /* For the I2C transfer engine */
 
 /* Exported defines ----------------------------------------------------------*/
 #define I2C_SPEED            400000                 /**< Speed of the I2C Bus */
 #define MAX_I2C_WRITE_LEN    128  /**< Max size of the I2C buffer for writing */
 #define MAX_I2C_READ_LEN     128  /**< Max size of the I2C buffer for reading */
+#define MAX_I2C_PENDING_REQS 16   /**< Max requests an I2C device AO can hold */
 
 #define EEPROM_PAGE_SIZE   8    /**< Size of the page in bytes on the EEPROM */
 
@@ -50,13 +52,16 @@ typedef enum I2C_Operations {
    /* Insert more I2C operations here... */
 } I2C_Operation_t;
 /**
- * I2C device internal memory access types
+ * \enum I2C_Priority_t
+ * Priorities of requests to the I2C device AOs.  Higher priority requests
+ * are handled first.  Requests of the same priority are handled in order.
  */
-typedef enum I2C_MemAccess {
-   I2C_MEM_BYTE  = 0,                   /**< Access memory one byte at a time */
-   I2C_MEM_DMA,                                    /**< Access memory via DMA */
-   /* Insert more I2C access types here... */
-} I2C_MemAccess_t;
+typedef enum I2C_Priorities {
+   I2C_PRIO_BULK  = 0,    /**< Large transfers, mostly from client requests */
+   I2C_PRIO_NORMAL,                          /**< Regular writes and accesses */
+   I2C_PRIO_URGENT,          /**< Small reads the control path is waiting on */
+   /* Insert more I2C priorities here... */
+} I2C_Priority_t;
 
 /**
  * \enum I2C_Bus_t
@@ -131,6 +136,13 @@ typedef struct I2C_BusSettings
    uint16_t                nBytesExpected; /**< How many bytes expected to TX or RX. */
    uint16_t                nBytesCurrent; /**< How many bytes have already been TXed or RXed. */
 
+   /* Interrupt driven transfer */
+   I2C_Xfer_t              xfer;            /**< Transfer run by the I2C ISRs */
+
+   /* Health counters */
+   uint32_t                nErrors;              /**< Error interrupts on bus */
+   uint32_t                nRecoveries;         /**< Bus recoveries attempted */
+
 } I2C_BusSettings_t;
 
 /**
@@ -270,6 +270,7 @@ const DC3Error_t I2C_readDevMem(
          i2cReadReqEvt->start          = offset;
          i2cReadReqEvt->bytes          = bytesToRead;
          i2cReadReqEvt->accessType     = accessType;
+         i2cReadReqEvt->priority       = I2C_PRIO_NORMAL;
          QACTIVE_POST(AO_I2C1DevMgr, (QEvt *)(i2cReadReqEvt), AO_I2C1DevMgr);
          break;
       case _DC3_ACCESS_NONE:                    /* Intentionally fall through */
@@ -356,6 +357,7 @@ const DC3Error_t I2C_writeDevMem(
          i2cWriteReqEvt->start            = offset;
          i2cWriteReqEvt->bytes            = bytesToWrite;
          i2cWriteReqEvt->accessType       = accessType;
+         i2cWriteReqEvt->priority         = I2C_PRIO_NORMAL;
          MEMCPY(
                i2cWriteReqEvt->dataBuf,
                pBuffer,
@@ -0,0 +1,286 @@
+/**
+ * @file    i2c_xfer.c
+ * @brief   Interrupt driven I2C master transfer engine.
+ *
+ * See i2c_xfer.h for the description.  Nothing in here is allowed to touch the
+ * hardware or QP.  i2c.c does that based on the returned actions.
+ *
+ * @date    10/18/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ *
+ * @addtogroup groupI2C
+ * @{
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "i2c_xfer.h"
+#include <stddef.h>
+
+/* Compile-time called macros ------------------------------------------------*/
+/* Private typedefs ----------------------------------------------------------*/
+/* Private defines -----------------------------------------------------------*/
+/* Private macros ------------------------------------------------------------*/
+/* Private variables and Local objects ---------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+
+/**
+ * @brief   Build an action.
+ * @param [in] acts: uint16_t I2C_XFER_ACT_xxx flags.
+ * @param [in] byte: uint8_t byte for I2C_XFER_ACT_SEND_BYTE.
+ * @return  I2C_XferAction_t: the action.
+ */
+static I2C_XferAction_t I2C_xferAct( const uint16_t acts, const uint8_t byte );
+
+/**
+ * @brief   Move a transfer to DONE.
+ * @param [in|out] *pXfer: I2C_Xfer_t pointer to the transfer.
+ * @param [in] status: DC3Error_t result of the transfer.
+ * @param [in] acts: uint16_t any I2C_XFER_ACT_xxx flags that still have to be
+ * done to the peripheral.
+ * @return  I2C_XferAction_t: the action with I2C_XFER_ACT_DONE added.
+ */
+static I2C_XferAction_t I2C_xferFinish(
+      I2C_Xfer_t *pXfer,
+      const DC3Error_t status,
+      const uint16_t acts
+);
+
+/**
+ * @brief   Send the next byte of the internal memory address, MSB first.
+ * @param [in|out] *pXfer: I2C_Xfer_t pointer to the transfer.
+ * @return  I2C_XferAction_t: what to do to the peripheral.
+ */
+static I2C_XferAction_t I2C_xferSendMemAddr( I2C_Xfer_t *pXfer );
+
+/**
+ * @brief   Move on to the data phase once the memory address is sent.
+ * Reads need a repeated START to turn the bus around.  Writes just keep going.
+ * @param [in|out] *pXfer: I2C_Xfer_t pointer to the transfer.
+ * @return  I2C_XferAction_t: what to do to the peripheral.
+ */
+static I2C_XferAction_t I2C_xferStartData( I2C_Xfer_t *pXfer );
+
+/* Private functions ---------------------------------------------------------*/
+/******************************************************************************/
+static I2C_XferAction_t I2C_xferAct( const uint16_t acts, const uint8_t byte )
+{
+   I2C_XferAction_t act;
+   act.acts = acts;
+   act.byte = byte;
+   return( act );
+}
+
+/******************************************************************************/
+static I2C_XferAction_t I2C_xferFinish(
+      I2C_Xfer_t *pXfer,
+      const DC3Error_t status,
+      const uint16_t acts
+)
+{
+   pXfer->state  = I2C_XFER_DONE;
+   pXfer->status = status;
+   return( I2C_xferAct( acts | I2C_XFER_ACT_DONE, 0 ) );
+}
+
+/******************************************************************************/
+static I2C_XferAction_t I2C_xferSendMemAddr( I2C_Xfer_t *pXfer )
+{
+   uint8_t byte = (uint8_t)(pXfer->memAddr & 0x00FF);
+   if ( pXfer->memAddrSize - pXfer->memAddrSent == 2 ) {
+      byte = (uint8_t)((pXfer->memAddr & 0xFF00) >> 8);
+   }
+   pXfer->memAddrSent++;
+
+   pXfer->state  = I2C_XFER_MEM_ADDR;
+   pXfer->status = ERR_I2CBUS_EV8_TIMEOUT;
+   return( I2C_xferAct( I2C_XFER_ACT_SEND_BYTE, byte ) );
+}
+
+/******************************************************************************/
+static I2C_XferAction_t I2C_xferStartData( I2C_Xfer_t *pXfer )
+{
+   if ( I2C_XFER_READ == pXfer->dir ) {
+      pXfer->state  = I2C_XFER_RESTART;
+      pXfer->status = ERR_I2CBUS_EV5_TIMEOUT;
+      return( I2C_xferAct( I2C_XFER_ACT_START, 0 ) );
+   }
+
+   pXfer->status = ERR_I2CBUS_WRITE_BYTE_TIMEOUT;
+
+   /* Not worth setting up DMA for a single byte */
+   if ( 1 == pXfer->len ) {
+      pXfer->state = I2C_XFER_DATA_TX_END;
+      return( I2C_xferAct( I2C_XFER_ACT_SEND_BYTE, pXfer->pBuf[0] ) );
+   }
+
+   pXfer->state = I2C_XFER_DATA_TX;
+   return( I2C_xferAct( I2C_XFER_ACT_DMA_TX, 0 ) );
+}
+
+/* Public functions ----------------------------------------------------------*/
+/******************************************************************************/
+I2C_XferAction_t I2C_XferStart(
+      I2C_Xfer_t *pXfer,
+      const uint8_t devAddr,
+      const uint16_t memAddr,
+      const uint8_t memAddrSize,
+      const I2C_XferDir_t dir,
+      uint8_t *pBuf,
+      const uint16_t len
+)
+{
+   pXfer->devAddr     = devAddr & 0xFE;
+   pXfer->memAddr     = memAddr;
+   pXfer->memAddrSize = memAddrSize;
+   pXfer->memAddrSent = 0;
+   pXfer->dir         = dir;
+   pXfer->pBuf        = pBuf;
+   pXfer->len         = len;
+
+   if ( NULL == pBuf || 0 == len || ( 1 != memAddrSize && 2 != memAddrSize ) ||
+         ( I2C_XFER_READ != dir && I2C_XFER_WRITE != dir ) ) {
+      return( I2C_xferFinish( pXfer, ERR_I2CBUS_INVALID_PARAMS_FOR_XFER, I2C_XFER_ACT_NONE ) );
+   }
+
+   pXfer->state  = I2C_XFER_START;
+   pXfer->status = ERR_I2CBUS_EV5_TIMEOUT;
+   return( I2C_xferAct( I2C_XFER_ACT_START, 0 ) );
+}
+
+/******************************************************************************/
+I2C_XferAction_t I2C_XferOnEvent( I2C_Xfer_t *pXfer, const uint16_t sr1 )
+{
+   switch( pXfer->state ) {
+      case I2C_XFER_START:
+         if ( sr1 & I2C_XFER_SR1_SB ) {
+            pXfer->state  = I2C_XFER_DEV_ADDR_TX;
+            pXfer->status = ERR_I2CBUS_EV6_TIMEOUT;
+            return( I2C_xferAct( I2C_XFER_ACT_SEND_BYTE, pXfer->devAddr ) );
+         }
+         break;
+
+      case I2C_XFER_DEV_ADDR_TX:
+         if ( sr1 & I2C_XFER_SR1_ADDR ) {
+            return( I2C_xferSendMemAddr( pXfer ) );
+         }
+         break;
+
+      case I2C_XFER_MEM_ADDR:
+         if ( sr1 & I2C_XFER_SR1_BTF ) {
+            if ( pXfer->memAddrSent < pXfer->memAddrSize ) {
+               return( I2C_xferSendMemAddr( pXfer ) );
+            }
+            return( I2C_xferStartData( pXfer ) );
+         }
+         break;
+
+      case I2C_XFER_RESTART:
+         if ( sr1 & I2C_XFER_SR1_SB ) {
+            pXfer->state  = I2C_XFER_DEV_ADDR_RX;
+            pXfer->status = ERR_I2CBUS_EV6_TIMEOUT;
+            return( I2C_xferAct( I2C_XFER_ACT_SEND_BYTE, pXfer->devAddr | 0x01 ) );
+         }
+         break;
+
+      case I2C_XFER_DEV_ADDR_RX:
+         if ( sr1 & I2C_XFER_SR1_ADDR ) {
+            pXfer->status = ERR_I2CBUS_RXNE_FLAG_TIMEOUT;
+
+            /* DMA can't NACK a single byte in time so that one is done by hand.
+             * NACK and STOP have to be set up around clearing ADDR. See the
+             * STM32F4 reference manual on master receiver mode. */
+            if ( 1 == pXfer->len ) {
+               pXfer->state = I2C_XFER_DATA_RX_BYTE;
+               return( I2C_xferAct(
+                     I2C_XFER_ACT_ACK_OFF | I2C_XFER_ACT_STOP | I2C_XFER_ACT_BUF_IT_ON, 0 ) );
+            }
+
+            pXfer->state = I2C_XFER_DATA_RX;
+            return( I2C_xferAct( I2C_XFER_ACT_DMA_RX, 0 ) );
+         }
+         break;
+
+      case I2C_XFER_DATA_TX_END:
+         if ( sr1 & I2C_XFER_SR1_BTF ) {
+            return( I2C_xferFinish( pXfer, ERR_NONE, I2C_XFER_ACT_STOP ) );
+         }
+         break;
+
+      case I2C_XFER_DATA_RX_BYTE:
+         if ( sr1 & I2C_XFER_SR1_RXNE ) {
+            return( I2C_xferAct( I2C_XFER_ACT_READ_BYTE, 0 ) );
+         }
+         break;
+
+      case I2C_XFER_IDLE:
+      case I2C_XFER_DATA_TX:           /* DMA owns the peripheral in these */
+      case I2C_XFER_DATA_RX:
+      case I2C_XFER_DONE:
+      default:
+         break;
+   }
+
+   return( I2C_xferAct( I2C_XFER_ACT_NONE, 0 ) );
+}
+
+/******************************************************************************/
+I2C_XferAction_t I2C_XferOnRxByte( I2C_Xfer_t *pXfer, const uint8_t byte )
+{
+   if ( I2C_XFER_DATA_RX_BYTE != pXfer->state ) {
+      return( I2C_xferAct( I2C_XFER_ACT_NONE, 0 ) );
+   }
+
+   pXfer->pBuf[0] = byte;
+   return( I2C_xferFinish( pXfer, ERR_NONE, I2C_XFER_ACT_NONE ) );   /* STOP already sent */
+}
+
+/******************************************************************************/
+I2C_XferAction_t I2C_XferOnDmaDone( I2C_Xfer_t *pXfer )
+{
+   if ( I2C_XFER_DATA_TX == pXfer->state ) {
+      /* The last byte is still on the wire.  STOP goes out once BTF says it's
+       * gone. */
+      pXfer->state = I2C_XFER_DATA_TX_END;
+   } else if ( I2C_XFER_DATA_RX == pXfer->state ) {
+      /* With LAST set, the peripheral already NACKed the last byte.  STOP has
+       * to follow the DMA EOT. */
+      return( I2C_xferFinish( pXfer, ERR_NONE, I2C_XFER_ACT_STOP ) );
+   }
+
+   return( I2C_xferAct( I2C_XFER_ACT_NONE, 0 ) );
+}
+
+/******************************************************************************/
+I2C_XferAction_t I2C_XferOnError( I2C_Xfer_t *pXfer, const uint16_t sr1 )
+{
+   if ( !I2C_XferIsBusy( pXfer ) ) {
+      return( I2C_xferAct( I2C_XFER_ACT_NONE, 0 ) );
+   }
+
+   if ( sr1 & I2C_XFER_SR1_ARLO ) {
+      /* The peripheral already dropped back to slave mode so no STOP */
+      return( I2C_xferFinish( pXfer, ERR_I2CBUS_ARB_LOST, I2C_XFER_ACT_NONE ) );
+   }
+
+   if ( sr1 & I2C_XFER_SR1_AF ) {
+      /* EEPROMs NACK their address while they are busy with a write cycle */
+      return( I2C_xferFinish( pXfer, ERR_I2CBUS_NACK, I2C_XFER_ACT_STOP ) );
+   }
+
+   return( I2C_xferFinish( pXfer, ERR_I2CBUS_BUS_ERROR, I2C_XFER_ACT_STOP ) );
+}
+
+/******************************************************************************/
+bool I2C_XferIsBusy( const I2C_Xfer_t *pXfer )
+{
+   return( I2C_XFER_IDLE != pXfer->state && I2C_XFER_DONE != pXfer->state );
+}
+
+/**
+ * @}
+ * end addtogroup groupI2C
+ */
+
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
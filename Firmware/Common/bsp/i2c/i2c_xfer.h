@@ -0,0 +1,203 @@
+/**
+ * @file    i2c_xfer.h
+ * @brief   Interrupt driven I2C master transfer engine.
+ *
+ * This is the state logic for a complete I2C memory transfer:
+ *    START, device address, internal memory address, (repeated START, device
+ *    address,) data, STOP.
+ * It doesn't touch any hardware.  The I2C event/error ISRs and the DMA ISRs
+ * feed it the SR1 flags (EV5 = SB, EV6 = ADDR, EV8 = BTF, etc) and it tells
+ * them what to do to the peripheral next.  All multi-byte data phases are done
+ * by DMA and the only thing left for the AO is a single completion event.
+ *
+ * Since there are no hardware dependencies here, the engine can also be driven
+ * by a simulated I2C peripheral on a host that replays SR1 event sequences.
+ *
+ * @date    10/18/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ *
+ * @addtogroup groupI2C
+ * @{
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef I2C_XFER_H_
+#define I2C_XFER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "DC3Errors.h"                               /* For DC3 error codes */
+
+/* Exported defines ----------------------------------------------------------*/
+
+/* SR1 flags the engine cares about.  These are the same bits as the STM32F4
+ * I2C SR1 register so the ISRs can pass the register value straight through. */
+#define I2C_XFER_SR1_SB       0x0001                 /**< EV5: START was sent */
+#define I2C_XFER_SR1_ADDR     0x0002       /**< EV6: device ACKed its address */
+#define I2C_XFER_SR1_BTF      0x0004       /**< EV8_2: byte transfer finished */
+#define I2C_XFER_SR1_RXNE     0x0040                  /**< EV7: byte received */
+#define I2C_XFER_SR1_TXE      0x0080                    /**< EV8: DR is empty */
+#define I2C_XFER_SR1_BERR     0x0100                           /**< Bus error */
+#define I2C_XFER_SR1_ARLO     0x0200                    /**< Arbitration lost */
+#define I2C_XFER_SR1_AF       0x0400                  /**< NACK (ack failure) */
+#define I2C_XFER_SR1_OVR      0x0800                    /**< Overrun/underrun */
+#define I2C_XFER_SR1_TIMEOUT  0x4000               /**< SCL held low too long */
+
+/* Things the ISR has to do to the peripheral.  More than one can be requested
+ * at a time and the ISR has to do them in the order they are listed here. */
+#define I2C_XFER_ACT_NONE       0x0000                     /**< Nothing to do */
+#define I2C_XFER_ACT_ACK_OFF    0x0001 /**< NACK next byte. Before ADDR clear */
+#define I2C_XFER_ACT_DMA_RX     0x0002 /**< RX DMA w/ LAST. Before ADDR clear */
+#define I2C_XFER_ACT_SEND_BYTE  0x0004 /**< Write I2C_XferAction_t.byte to DR */
+#define I2C_XFER_ACT_DMA_TX     0x0008                  /**< Start the TX DMA */
+#define I2C_XFER_ACT_START      0x0010         /**< Generate (repeated) START */
+#define I2C_XFER_ACT_STOP       0x0020                   /**< Generate a STOP */
+#define I2C_XFER_ACT_BUF_IT_ON  0x0040        /**< Enable RXNE/TXE interrupts */
+#define I2C_XFER_ACT_READ_BYTE  0x0080     /**< Pass DR to I2C_XferOnRxByte() */
+#define I2C_XFER_ACT_DONE       0x0100   /**< Transfer is over. Check status. */
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief   Direction of the data phase of a transfer.
+ */
+typedef enum I2C_XferDirs {
+   I2C_XFER_WRITE = 0,                 /**< Write data to the device's memory */
+   I2C_XFER_READ,                     /**< Read data from the device's memory */
+} I2C_XferDir_t;
+
+/**
+ * @brief   Phases of a transfer.  Each one is waiting for a specific event.
+ */
+typedef enum I2C_XferStates {
+   I2C_XFER_IDLE = 0,                            /**< No transfer in progress */
+   I2C_XFER_START,                            /**< Waiting for SB after START */
+   I2C_XFER_DEV_ADDR_TX,                   /**< Waiting for ADDR (write addr) */
+   I2C_XFER_MEM_ADDR,                    /**< Waiting for BTF (mem addr byte) */
+   I2C_XFER_RESTART,                     /**< Waiting for SB (repeated START) */
+   I2C_XFER_DEV_ADDR_RX,                    /**< Waiting for ADDR (read addr) */
+   I2C_XFER_DATA_TX,                        /**< Waiting for TX DMA to finish */
+   I2C_XFER_DATA_TX_END,                /**< Waiting for BTF (last data byte) */
+   I2C_XFER_DATA_RX,                        /**< Waiting for RX DMA to finish */
+   I2C_XFER_DATA_RX_BYTE,                 /**< Waiting for RXNE (1 byte read) */
+   I2C_XFER_DONE,                        /**< Finished. Status has the result */
+} I2C_XferState_t;
+
+/**
+ * @brief   What the ISR has to do to the peripheral next.
+ */
+typedef struct {
+   uint16_t acts;                  /**< I2C_XFER_ACT_xxx flags OR'ed together */
+   uint8_t  byte;                        /**< Byte for I2C_XFER_ACT_SEND_BYTE */
+} I2C_XferAction_t;
+
+/**
+ * @brief   A single I2C memory transfer.
+ */
+typedef struct {
+   I2C_XferState_t state;                     /**< Which phase the xfer is in */
+   I2C_XferDir_t   dir;                                    /**< Read or write */
+   uint8_t         devAddr;              /**< 8 bit dev addr. R/W bit ignored */
+   uint16_t        memAddr;                  /**< Internal mem addr to access */
+   uint8_t         memAddrSize;              /**< Mem addr size. 1 or 2 bytes */
+   uint8_t         memAddrSent;               /**< Mem addr bytes sent so far */
+   uint8_t         *pBuf;                     /**< Data to write or read into */
+   uint16_t        len;                           /**< How many bytes to move */
+   DC3Error_t      status;                  /**< Result, or what it waits for */
+} I2C_Xfer_t;
+
+/* Exported macros -----------------------------------------------------------*/
+/* Exported constants --------------------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief   Set up a new transfer and get the action that kicks it off.
+ *
+ * @param [out] *pXfer: I2C_Xfer_t pointer to the transfer.
+ * @param [in] devAddr: uint8_t 8 bit address of the I2C device.
+ * @param [in] memAddr: uint16_t internal memory address to access.
+ * @param [in] memAddrSize: uint8_t size of the memory address.  1 or 2 bytes.
+ * @param [in] dir: I2C_XferDir_t direction of the data phase.
+ * @param [in] *pBuf: uint8_t pointer to the data to write or where to read it
+ * to.  Has to stay around until the transfer is DONE.
+ * @param [in] len: uint16_t how many bytes to move.  Can't be 0.
+ * @return  I2C_XferAction_t: what to do to the peripheral.  This is either a
+ * START or DONE if the parameters are bad.
+ */
+I2C_XferAction_t I2C_XferStart(
+      I2C_Xfer_t *pXfer,
+      const uint8_t devAddr,
+      const uint16_t memAddr,
+      const uint8_t memAddrSize,
+      const I2C_XferDir_t dir,
+      uint8_t *pBuf,
+      const uint16_t len
+);
+
+/**
+ * @brief   Handle an I2C event interrupt.
+ *
+ * Flags that the current phase isn't waiting for are ignored.  A phase that
+ * never gets its event has to be timed out by whoever started the transfer.
+ *
+ * @param [in|out] *pXfer: I2C_Xfer_t pointer to the transfer.
+ * @param [in] sr1: uint16_t value of the SR1 register.
+ * @return  I2C_XferAction_t: what to do to the peripheral.
+ */
+I2C_XferAction_t I2C_XferOnEvent( I2C_Xfer_t *pXfer, const uint16_t sr1 );
+
+/**
+ * @brief   Hand the engine the byte of a single byte read.
+ *
+ * Call this after I2C_XferOnEvent() when the transfer is in the
+ * I2C_XFER_DATA_RX_BYTE state and RXNE is set.
+ *
+ * @param [in|out] *pXfer: I2C_Xfer_t pointer to the transfer.
+ * @param [in] byte: uint8_t value read from DR.
+ * @return  I2C_XferAction_t: what to do to the peripheral.
+ */
+I2C_XferAction_t I2C_XferOnRxByte( I2C_Xfer_t *pXfer, const uint8_t byte );
+
+/**
+ * @brief   Handle a DMA transfer complete interrupt for either direction.
+ *
+ * @param [in|out] *pXfer: I2C_Xfer_t pointer to the transfer.
+ * @return  I2C_XferAction_t: what to do to the peripheral.
+ */
+I2C_XferAction_t I2C_XferOnDmaDone( I2C_Xfer_t *pXfer );
+
+/**
+ * @brief   Handle an I2C error interrupt.
+ *
+ * @param [in|out] *pXfer: I2C_Xfer_t pointer to the transfer.
+ * @param [in] sr1: uint16_t value of the SR1 register.
+ * @return  I2C_XferAction_t: what to do to the peripheral.
+ */
+I2C_XferAction_t I2C_XferOnError( I2C_Xfer_t *pXfer, const uint16_t sr1 );
+
+/**
+ * @brief   Check if a transfer is in progress.
+ *
+ * @param [in] *pXfer: const I2C_Xfer_t pointer to the transfer.
+ * @return  bool: true if the transfer was started and isn't DONE yet.
+ */
+bool I2C_XferIsBusy( const I2C_Xfer_t *pXfer );
+
+/**
+ * @}
+ * end addtogroup groupI2C
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif                                                        /* I2C_XFER_H_ */
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
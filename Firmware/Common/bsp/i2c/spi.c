@@ -19,6 +19,7 @@
 #include "stm32f4xx_it.h"
 #include "project_includes.h"
 #include "Shared.h"
+#include "SPIBusMgr.h"                                 /* For SPI event types */
 #include "stm32f4xx.h"
 #include "stm32f4xx_dma.h"                           /* For STM32 DMA support */
 #include "stm32f4xx_spi.h"                           /* For STM32 SPI support */
@@ -117,10 +118,48 @@ SPI_BusSettings_t s_SPI_Bus[MAX_SPI_BUS] =
             &spi1TxBuffer[0],          /**< *pTxBuffer */
             0,                         /**< nTxindex */
 
+            /* DMA driven transactions */
+            { SPI_XFER_IDLE },         /**< xfer */
       }
 };
 
 /* Private function prototypes -----------------------------------------------*/
+
+/**
+ * @brief  Set up and start both DMA streams for a full duplex transaction.
+ *
+ * The RX stream has to be running before the TX stream starts clocking data
+ * out or the first byte that comes back is lost.
+ *
+ * @param [in] iBus: SPI_Bus_t type specifying the SPI bus.
+ *    @arg SPIBus5
+ * @param [in] len: uint16_t how many bytes to transceive.
+ * @return: None
+ */
+static void SPI_startDMA( const SPI_Bus_t iBus, const uint16_t len );
+
+/**
+ * @brief  Turn off everything a DMA driven transaction was using.
+ * @param [in] iBus: SPI_Bus_t type specifying the SPI bus.
+ *    @arg SPIBus5
+ * @return: None
+ */
+static void SPI_stopDMA( const SPI_Bus_t iBus );
+
+/**
+ * @brief  Do what the spi_xfer engine asked for to the SPI peripheral.
+ *
+ * The actions are done in the order they are listed in spi_xfer.h.  This gets
+ * called from the DMA ISRs and once from SPI_StartXfer() to kick the
+ * transaction off.
+ *
+ * @param [in] iBus: SPI_Bus_t type specifying the SPI bus.
+ *    @arg SPIBus5
+ * @param [in] acts: uint16_t SPI_XFER_ACT_xxx flags returned by the engine.
+ * @return: None
+ */
+static void SPI_doXferAction( const SPI_Bus_t iBus, const uint16_t acts );
+
 /* Private functions ---------------------------------------------------------*/
 
 /******************************************************************************/
@@ -134,12 +173,13 @@ void SPI_BusInit( SPI_Bus_t iBus )
 
    /* Enable GPIO pin clocks */
    RCC_AHB1PeriphClockCmd(
-         s_SPI_Bus[iBus].sck_clk | s_SPI_Bus[iBus].miso_clk | s_SPI_Bus[iBus].mosi_clk,
+         s_SPI_Bus[iBus].sck_clk | s_SPI_Bus[iBus].miso_clk |
+         s_SPI_Bus[iBus].mosi_clk | s_SPI_Bus[iBus].nss_clk,
          ENABLE
    );
 
    /* Enable DMA clock */
-   //   RCC_AHB1PeriphClockCmd(SPIx_DMA_CLK, ENABLE);
+   RCC_AHB1PeriphClockCmd( s_SPI_Bus[iBus].spi_dma_clk, ENABLE );
 
    /* SPI GPIO Configuration --------------------------------------------------*/
    /* GPIO Deinitialisation */
@@ -170,6 +210,15 @@ void SPI_BusInit( SPI_Bus_t iBus )
    GPIO_InitStructure.GPIO_Pin = s_SPI_Bus[iBus].mosi_pin;
    GPIO_Init(s_SPI_Bus[iBus].mosi_port, &GPIO_InitStructure);
 
+   /* SPI NSS pin configuration.  NSS is software managed (chip select) so it's
+    * a plain output that starts out deselected. */
+   GPIO_InitStructure.GPIO_Mode = GPIO_Mode_OUT;
+   GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_UP;
+   GPIO_InitStructure.GPIO_Pin  = s_SPI_Bus[iBus].nss_pin;
+   GPIO_Init(s_SPI_Bus[iBus].nss_port, &GPIO_InitStructure);
+   SPI_NSS_high( iBus );
+   s_SPI_Bus[iBus].xfer.csSelected = false;
+
    /* SPI configuration -------------------------------------------------------*/
    SPI_I2S_DeInit(s_SPI_Bus[iBus].spi_bus);
 
@@ -179,49 +228,47 @@ void SPI_BusInit( SPI_Bus_t iBus )
    SPI_InitStructure.SPI_CPOL = SPI_CPOL_Low;
    SPI_InitStructure.SPI_CPHA = SPI_CPHA_1Edge;
    SPI_InitStructure.SPI_NSS = SPI_NSS_Soft;
-   SPI_InitStructure.SPI_BaudRatePrescaler = SPI_BaudRatePrescaler_256;
+   SPI_InitStructure.SPI_BaudRatePrescaler = SPI_BaudRatePrescaler_8; /* 11.25MHz off the 90MHz APB2 */
    SPI_InitStructure.SPI_FirstBit = SPI_FirstBit_MSB;
    SPI_InitStructure.SPI_CRCPolynomial = 0;
 
    SPI_Init( s_SPI_Bus[iBus].spi_bus, &SPI_InitStructure );
    SPI_Cmd( s_SPI_Bus[iBus].spi_bus, ENABLE );
 
-   /* DMA configuration -------------------------------------------------------*/
-   //   DMA_InitTypeDef DMA_InitStructure;
-   //   /* Deinitialize DMA Streams */
-   //   DMA_DeInit(SPIx_TX_DMA_STREAM);
-   //   DMA_DeInit(SPIx_RX_DMA_STREAM);
-   //
-   //   /* Configure DMA Initialization Structure */
-   //   DMA_InitStructure.DMA_BufferSize = BUFFERSIZE ;
-   //   DMA_InitStructure.DMA_FIFOMode = DMA_FIFOMode_Disable ;
-   //   DMA_InitStructure.DMA_FIFOThreshold = DMA_FIFOThreshold_1QuarterFull ;
-   //   DMA_InitStructure.DMA_MemoryBurst = DMA_MemoryBurst_Single ;
-   //   DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
-   //   DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
-   //   DMA_InitStructure.DMA_Mode = DMA_Mode_Normal;
-   //   DMA_InitStructure.DMA_PeripheralBaseAddr =(uint32_t) (&(SPIx->DR)) ;
-   //   DMA_InitStructure.DMA_PeripheralBurst = DMA_PeripheralBurst_Single;
-   //   DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
-   //   DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
-   //   DMA_InitStructure.DMA_Priority = DMA_Priority_High;
-   //   /* Configure TX DMA */
-   //   DMA_InitStructure.DMA_Channel = SPIx_TX_DMA_CHANNEL ;
-   //   DMA_InitStructure.DMA_DIR = DMA_DIR_MemoryToPeripheral ;
-   //   DMA_InitStructure.DMA_Memory0BaseAddr =(uint32_t)aTxBuffer ;
-   //   DMA_Init(SPIx_TX_DMA_STREAM, &DMA_InitStructure);
-   //   /* Configure RX DMA */
-   //   DMA_InitStructure.DMA_Channel = SPIx_RX_DMA_CHANNEL ;
-   //   DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralToMemory ;
-   //   DMA_InitStructure.DMA_Memory0BaseAddr =(uint32_t)aRxBuffer ;
-   //   DMA_Init(SPIx_RX_DMA_STREAM, &DMA_InitStructure);
+   /* DMA configuration.  SPI_startDMA() sets the streams up per transaction */
+   DMA_Cmd( s_SPI_Bus[iBus].spi_dma_rx_stream, DISABLE );
+   DMA_DeInit( s_SPI_Bus[iBus].spi_dma_rx_stream );
+
+   DMA_Cmd( s_SPI_Bus[iBus].spi_dma_tx_stream, DISABLE );
+   DMA_DeInit( s_SPI_Bus[iBus].spi_dma_tx_stream );
+
+   /* Initialize the IRQ and priorities for SPI DMA */
+   NVIC_Config(
+         s_SPI_Bus[iBus].spi_dma_rx_irq_num,
+         s_SPI_Bus[iBus].spi_dma_rx_irq_prio
+   );
 
+   NVIC_Config(
+         s_SPI_Bus[iBus].spi_dma_tx_irq_num,
+         s_SPI_Bus[iBus].spi_dma_tx_irq_prio
+   );
 }
 
 /******************************************************************************/
 void SPI_BusDeInit( SPI_Bus_t iBus )
 {
-
+   /* Stop any transaction and let go of the chip */
+   SPI_stopDMA( iBus );
+   SPI_NSS_high( iBus );
+   s_SPI_Bus[iBus].xfer.state      = SPI_XFER_IDLE;
+   s_SPI_Bus[iBus].xfer.csSelected = false;
+
+   DMA_DeInit( s_SPI_Bus[iBus].spi_dma_rx_stream );
+   DMA_DeInit( s_SPI_Bus[iBus].spi_dma_tx_stream );
+
+   /* DeInit the SPI IP */
+   SPI_Cmd( s_SPI_Bus[iBus].spi_bus, DISABLE );
+   SPI_I2S_DeInit( s_SPI_Bus[iBus].spi_bus );
 }
 
 /******************************************************************************/
@@ -364,9 +411,281 @@ SPI_transceive_ERR_HANDLE:        /* Handle any error that may have occurred. */
    return( status );
 }
 
+/******************************************************************************/
+DC3Error_t SPI_StartXfer(
+      const SPI_Bus_t iBus,
+      const uint16_t len,
+      const uint8_t flags
+)
+{
+   /* Check inputs */
+   assert_param( IS_SPI_BUS( iBus ) );
+
+   uint16_t acts = SPI_XferStart(
+         &s_SPI_Bus[iBus].xfer,
+         s_SPI_Bus[iBus].pTxBuffer,
+         s_SPI_Bus[iBus].pRxBuffer,
+         ( len > MAX_SPI_LEN ) ? 0 : len,    /* Too long gets rejected as 0 */
+         flags
+   );
+
+   SPI_doXferAction( iBus, acts );
+
+   return( ( acts & SPI_XFER_ACT_DONE ) ? s_SPI_Bus[iBus].xfer.status : ERR_NONE );
+}
+
+/******************************************************************************/
+void SPI_AbortXfer( const SPI_Bus_t iBus )
+{
+   /* Check inputs */
+   assert_param( IS_SPI_BUS( iBus ) );
+
+   /* Nothing to do if the transaction already finished.  This also leaves a
+    * chip that was kept selected on purpose alone. */
+   if ( !SPI_XferIsBusy( &s_SPI_Bus[iBus].xfer ) ) {
+      return;
+   }
+
+   SPI_doXferAction( iBus, SPI_XferAbort( &s_SPI_Bus[iBus].xfer ) );
+}
+
+/******************************************************************************/
+DC3Error_t SPI_getXferStatus( const SPI_Bus_t iBus )
+{
+   /* Check inputs */
+   assert_param( IS_SPI_BUS( iBus ) );
+
+   return( s_SPI_Bus[iBus].xfer.status );
+}
+
+/******************************************************************************/
+const DC3Error_t SPI_xfer(
+      const DC3AccessType_t accessType,
+      const SPI_Bus_t iBus,
+      const uint8_t flags,
+      const uint16_t len,
+      const uint16_t bufferSize,
+      const uint8_t* const pTxBuffer,
+      uint8_t* const pRxBuffer,
+      uint16_t* pBytesXfered
+)
+{
+   DC3Error_t status = ERR_NONE; /* Keep track of the errors that may occur.
+                                     This gets returned at the end of the
+                                     function */
+   uint16_t bytesRXed = 0;
+
+   switch( accessType ) {
+      case _DC3_ACCESS_BARE:
+         /* Perform a blocking transaction. Buffers and buffer sizes will be
+          * checked in there. */
+         status = SPI_transceive(
+               iBus,                                // const SPI_Bus_t iBus,
+               len,                                 // const uint16_t bytesToTX,
+               bufferSize,                          // const uint16_t bufferTXSize,
+               pTxBuffer,                           // const uint8_t* const pBufferTX,
+               pBytesXfered,                        // uint16_t* pBytesTXed,
+               len,                                 // const uint16_t bytesToRX,
+               bufferSize,                          // const uint16_t bufferRXSize,
+               pRxBuffer,                           // uint8_t* const pBufferRX,
+               &bytesRXed                           // uint16_t* pBytesRXed
+         );
+         break;
+      case _DC3_ACCESS_QPC:                     /* Intentionally fall through */
+      case _DC3_ACCESS_FRT:
+         ; /* Fix for comments immediately following a case label */
+         if ( len > MAX_SPI_XFER_LEN || len > bufferSize ) {
+            status = ERR_MEM_BUFFER_LEN;
+            goto SPI_xfer_ERR_HANDLE;      /* Stop and jump to error handling */
+         }
+
+         if ( NULL == pTxBuffer ) {
+            status = ERR_MEM_NULL_VALUE;
+            goto SPI_xfer_ERR_HANDLE;      /* Stop and jump to error handling */
+         }
+
+         /* It is the responsibility of the caller of this function with
+          * accessType QPC to know what event to listen for in response to this
+          * request.  See SPIBusMgr AO for details. */
+
+         /* Create the event and directly post it to the right AO. */
+         SPIXferReqEvt *spiXferReqEvt  = Q_NEW(SPIXferReqEvt, SPI_BUS_XFER_REQ_SIG);
+         spiXferReqEvt->spiBus         = iBus;
+         spiXferReqEvt->accessType     = accessType;
+         spiXferReqEvt->flags          = flags;
+         spiXferReqEvt->len            = len;
+         MEMCPY( spiXferReqEvt->dataBuf, pTxBuffer, len );
+         QACTIVE_POST(AO_SPIBusMgr[iBus], (QEvt *)(spiXferReqEvt), AO_SPIBusMgr[iBus]);
+         break;
+      case _DC3_ACCESS_NONE:                    /* Intentionally fall through */
+      default:
+         status = ERR_INVALID_ACCESS_TYPE;
+         goto SPI_xfer_ERR_HANDLE;         /* Stop and jump to error handling */
+         break;
+   }
+
+SPI_xfer_ERR_HANDLE:              /* Handle any error that may have occurred. */
+   ERR_COND_OUTPUT( status, accessType,
+      "Requesting a %d byte transaction on SPI bus %s via %s: Error 0x%08x\n",
+      len, CON_spiBusToStr( iBus ), CON_accessToStr(accessType), status );
+   return( status );
+}
+
+/******************************************************************************/
+static void SPI_startDMA( const SPI_Bus_t iBus, const uint16_t len )
+{
+   /* Throw away anything left over in DR so it doesn't end up as the first
+    * received byte */
+   (void)SPI_I2S_ReceiveData( s_SPI_Bus[iBus].spi_bus );
+
+   /* Clear out the DMA settings */
+   DMA_Cmd( s_SPI_Bus[iBus].spi_dma_rx_stream, DISABLE );
+   DMA_DeInit( s_SPI_Bus[iBus].spi_dma_rx_stream );
+   DMA_Cmd( s_SPI_Bus[iBus].spi_dma_tx_stream, DISABLE );
+   DMA_DeInit( s_SPI_Bus[iBus].spi_dma_tx_stream );
+
+   /* Common settings for both directions.  No FIFO since the SPI DR is a single
+    * byte and everything has to go out the moment it's there. */
+   DMA_InitTypeDef    DMA_InitStructure;
+   DMA_InitStructure.DMA_Channel             = s_SPI_Bus[iBus].spi_dma_channel;
+   DMA_InitStructure.DMA_PeripheralBaseAddr  = s_SPI_Bus[iBus].spi_dma_dr_addr;
+   DMA_InitStructure.DMA_PeripheralInc       = DMA_PeripheralInc_Disable;
+   DMA_InitStructure.DMA_MemoryInc           = DMA_MemoryInc_Enable;
+   DMA_InitStructure.DMA_PeripheralDataSize  = DMA_PeripheralDataSize_Byte;
+   DMA_InitStructure.DMA_MemoryDataSize      = DMA_MemoryDataSize_Byte;
+   DMA_InitStructure.DMA_Mode                = DMA_Mode_Normal;
+   DMA_InitStructure.DMA_Priority            = DMA_Priority_High;
+   DMA_InitStructure.DMA_FIFOMode            = DMA_FIFOMode_Disable;
+   DMA_InitStructure.DMA_FIFOThreshold       = DMA_FIFOThreshold_1QuarterFull;
+   DMA_InitStructure.DMA_MemoryBurst         = DMA_MemoryBurst_Single;
+   DMA_InitStructure.DMA_PeripheralBurst     = DMA_PeripheralBurst_Single;
+   DMA_InitStructure.DMA_BufferSize          = len;
+
+   /* RX stream.  Its transfer complete is the end of the transaction. */
+   DMA_InitStructure.DMA_DIR                 = DMA_DIR_PeripheralToMemory;
+   DMA_InitStructure.DMA_Memory0BaseAddr     = (uint32_t)s_SPI_Bus[iBus].xfer.pRx;
+   DMA_Init( s_SPI_Bus[iBus].spi_dma_rx_stream, &DMA_InitStructure );
+   DMA_ITConfig( s_SPI_Bus[iBus].spi_dma_rx_stream, DMA_IT_TC | DMA_IT_TE, ENABLE );
+
+   /* TX stream.  Only errors matter here. */
+   DMA_InitStructure.DMA_DIR                 = DMA_DIR_MemoryToPeripheral;
+   DMA_InitStructure.DMA_Memory0BaseAddr     = (uint32_t)s_SPI_Bus[iBus].xfer.pTx;
+   DMA_Init( s_SPI_Bus[iBus].spi_dma_tx_stream, &DMA_InitStructure );
+   DMA_ITConfig( s_SPI_Bus[iBus].spi_dma_tx_stream, DMA_IT_TE, ENABLE );
+
+   /* Clear any pending flags on both streams */
+   DMA_ClearFlag(
+         s_SPI_Bus[iBus].spi_dma_rx_stream,
+         s_SPI_Bus[iBus].spi_dma_rx_flags
+   );
+   DMA_ClearFlag(
+         s_SPI_Bus[iBus].spi_dma_tx_stream,
+         s_SPI_Bus[iBus].spi_dma_tx_flags
+   );
+
+   /* RX first, then TX.  The SPI starts clocking as soon as TX DMA feeds DR. */
+   DMA_Cmd( s_SPI_Bus[iBus].spi_dma_rx_stream, ENABLE );
+   DMA_Cmd( s_SPI_Bus[iBus].spi_dma_tx_stream, ENABLE );
+   SPI_I2S_DMACmd(
+         s_SPI_Bus[iBus].spi_bus,
+         SPI_I2S_DMAReq_Rx | SPI_I2S_DMAReq_Tx,
+         ENABLE
+   );
+}
+
+/******************************************************************************/
+static void SPI_stopDMA( const SPI_Bus_t iBus )
+{
+   DMA_ITConfig( s_SPI_Bus[iBus].spi_dma_rx_stream, DMA_IT_TC | DMA_IT_TE, DISABLE );
+   DMA_ITConfig( s_SPI_Bus[iBus].spi_dma_tx_stream, DMA_IT_TE, DISABLE );
+
+   DMA_Cmd( s_SPI_Bus[iBus].spi_dma_rx_stream, DISABLE );
+   DMA_Cmd( s_SPI_Bus[iBus].spi_dma_tx_stream, DISABLE );
+   SPI_I2S_DMACmd(
+         s_SPI_Bus[iBus].spi_bus,
+         SPI_I2S_DMAReq_Rx | SPI_I2S_DMAReq_Tx,
+         DISABLE
+   );
+}
+
+/******************************************************************************/
+static void SPI_doXferAction( const SPI_Bus_t iBus, const uint16_t acts )
+{
+   if ( acts & SPI_XFER_ACT_CS_SELECT ) {
+      SPI_NSS_low( iBus );
+   }
+
+   if ( acts & SPI_XFER_ACT_DMA ) {
+      SPI_startDMA( iBus, s_SPI_Bus[iBus].xfer.len );
+   }
+
+   if ( acts & SPI_XFER_ACT_DMA_STOP ) {
+      SPI_stopDMA( iBus );
+   }
+
+   if ( acts & SPI_XFER_ACT_CS_RELEASE ) {
+      SPI_NSS_high( iBus );
+   }
+
+   if ( acts & SPI_XFER_ACT_DONE ) {
+      /* Don't transport the result with the event.  The appropriate SPIBusMgr
+       * AO will get it with SPI_getXferStatus() and copy out the data from the
+       * buffers.  Nobody else is allowed to touch this bus so there's no
+       * contention. */
+      static QEvt const qEvt = { SPI_BUS_XFER_DONE_SIG, 0U, 0U };
+      QACTIVE_POST(AO_SPIBusMgr[iBus], &qEvt, AO_SPIBusMgr[iBus]);
+   }
+}
+
+/******************************************************************************/
+/***                      Callback functions for SPI                        ***/
+/******************************************************************************/
+
+/******************************************************************************/
+inline void SPI5_DMARxCallback( void )
+{
+   /* Test on DMA Stream Transfer Error interrupt */
+   if ( RESET != DMA_GetITStatus(DMA2_Stream3, DMA_IT_TEIF3) ) {
+      DMA_ClearITPendingBit( DMA2_Stream3, DMA_IT_TEIF3 );
+
+      SPI_doXferAction(
+            SPIBus5,
+            SPI_XferOnError( &s_SPI_Bus[SPIBus5].xfer, ERR_SPI_DMA_TRANSFER_ERROR )
+      );
+   }
+
+   /* Test on DMA Stream Transfer Complete interrupt */
+   if ( RESET != DMA_GetITStatus(DMA2_Stream3, DMA_IT_TCIF3) ) {
+      /* Clear DMA Stream Transfer Complete interrupt pending bit */
+      DMA_ClearITPendingBit( DMA2_Stream3, DMA_IT_TCIF3 );
+
+      /* The last byte is in so the TX side is long done as well.  The engine
+       * releases the chip (unless told to keep it) and asks for the done
+       * event. */
+      SPI_doXferAction(
+            SPIBus5,
+            SPI_XferOnDmaDone( &s_SPI_Bus[SPIBus5].xfer )
+      );
+   }
+}
+
+/******************************************************************************/
+inline void SPI5_DMATxCallback( void )
+{
+   /* Test on DMA Stream Transfer Error interrupt */
+   if ( RESET != DMA_GetITStatus(DMA2_Stream4, DMA_IT_TEIF4) ) {
+      DMA_ClearITPendingBit( DMA2_Stream4, DMA_IT_TEIF4 );
+
+      SPI_doXferAction(
+            SPIBus5,
+            SPI_XferOnError( &s_SPI_Bus[SPIBus5].xfer, ERR_SPI_DMA_TRANSFER_ERROR )
+      );
+   }
+}
+
 /**
  * @}
- * end addtogroup groupI2C
+ * end addtogroup groupSPI
  */
 
 /******** Copyright (C) 2014 Harry Rostovtsev. All rights reserved *****END OF FILE****/
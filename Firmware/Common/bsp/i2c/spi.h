@@ -30,13 +30,13 @@ extern "C" {
 /* Exported types ------------------------------------------------------------*/
 /* Exported macros -----------------------------------------------------------*/
 /**
- * @brief   Macro to determine if an I2C bus is defined in the system
- * @param [in] BUS:  I2C_Bus_t type I2C bus specifier.
+ * @brief   Macro to determine if an SPI bus is defined in the system
+ * @param [in] BUS:  SPI_Bus_t type SPI bus specifier.
  * @retval
  *    1: Bus exists and is valid
  *    0: Bus doesn't exist or isn't defined
  */
-#define IS_SPI_BUS(BUS) ((BUS) == SPIBus1)
+#define IS_SPI_BUS(BUS) ((BUS) == SPIBus5)
 
 /* Exported constants --------------------------------------------------------*/
 /* Exported variables --------------------------------------------------------*/
@@ -140,10 +140,138 @@ DC3Error_t SPI_transceive(
       uint16_t* pBytesRXed
 );
 
+/**
+ * @brief   Start a DMA driven transaction on the specified SPI bus.
+ *
+ * This function selects the chip (unless the last transaction left it selected)
+ * and clocks len bytes out of s_SPI_Bus[iBus].pTxBuffer and into
+ * s_SPI_Bus[iBus].pRxBuffer at the same time.  The DMA ISRs run it from there
+ * using the spi_xfer engine and post a single SPI_BUS_XFER_DONE_SIG to the
+ * SPIBusMgr AO for this bus when it's over.  Use SPI_getXferStatus() to get
+ * the result.
+ *
+ * @param [in]  iBus: SPI_Bus_t identifier for SPI bus
+ *    @arg SPIBus5: SPI bus 5
+ * @param [in]  len: uint16_t how many bytes to transceive.
+ * @param [in]  flags: uint8_t SPI_XFER_FLAG_xxx flags for the transaction.
+ *    @arg SPI_XFER_FLAG_NONE: select, transceive, release.
+ *    @arg SPI_XFER_FLAG_KEEP_CS: leave the chip selected so the next
+ *    transaction continues the same frame.
+ *
+ * @return DC3Error_t: status of starting the transaction.
+ *    @arg ERR_NONE: if the transaction was started.  The done event still gets
+ *    posted if it wasn't.
+ */
+DC3Error_t SPI_StartXfer(
+      const SPI_Bus_t iBus,
+      const uint16_t len,
+      const uint8_t flags
+);
+
+/**
+ * @brief   Abort the DMA driven transaction on the specified SPI bus.
+ *
+ * This function stops the DMA and releases the chip.  It's meant for timeouts.
+ * It does nothing if the transaction already finished so a chip that was kept
+ * selected on purpose stays that way.
+ *
+ * @param [in]  iBus: SPI_Bus_t identifier for SPI bus
+ *    @arg SPIBus5: SPI bus 5
+ * @return: None
+ */
+void SPI_AbortXfer( const SPI_Bus_t iBus );
+
+/**
+ * @brief   Get the status of the last DMA driven transaction.
+ *
+ * @param [in]  iBus: SPI_Bus_t identifier for SPI bus
+ *    @arg SPIBus5: SPI bus 5
+ * @return DC3Error_t: ERR_NONE if the transaction finished fine.  If it hasn't
+ * finished, this is ERR_SPI_DMA_TIMEOUT.
+ */
+DC3Error_t SPI_getXferStatus( const SPI_Bus_t iBus );
+
+/**
+ * @brief  Common function to do an SPI transaction using any access.
+ *
+ * This function is the common entry point to transceive a buffer on an SPI bus
+ * using any accessType (BARE, QPC, or FRT).
+ *
+ * @note:  This function needs to be wrapped in FRT function to listen for the
+ * appropriate event that the transaction is finished.
+ *
+ * @param  [in] accessType: const DC3AccessType_t that specifies how the
+ * function is being accessed.
+ *    @arg _DC3_ACCESS_BARE: blocking access that is slow.  Don't use once the
+ *                           RTOS is running.  Flags are ignored.
+ *    @arg _DC3_ACCESS_QPC:  non-blocking, event based access.
+ *    @arg _DC3_ACCESS_FRT:  non-blocking, but waits on queue to know the status.
+ *
+ * @param [in] iBus: SPI_Bus_t identifier for SPI bus
+ *    @arg SPIBus5: SPI bus 5
+ *
+ * @param [in] flags: uint8_t SPI_XFER_FLAG_xxx flags for the transaction.
+ *
+ * @param [in] len: const uint16_t how many bytes to transceive.  Can't be more
+ * than MAX_SPI_XFER_LEN for QPC and FRT accesses.
+ *
+ * @param [in] bufferSize: uint16_t size of both the TX and RX buffers.
+ *
+ * @param [in] *pTxBuffer: const uint8_t pointer to the data to send.
+ *
+ * @param [out] *pRxBuffer: uint8_t pointer to the buffer to store received
+ * data.  Only filled in here for BARE access.
+ *
+ * @param [out] *pBytesXfered: uint16_t pointer specifying how many bytes were
+ * actually transceived.  Only filled in here for BARE access.
+ *
+ * @return DC3Error_t: status of the transaction request operation
+ *    @arg ERR_NONE: if no errors occurred
+ */
+const DC3Error_t SPI_xfer(
+      const DC3AccessType_t accessType,
+      const SPI_Bus_t iBus,
+      const uint8_t flags,
+      const uint16_t len,
+      const uint16_t bufferSize,
+      const uint8_t* const pTxBuffer,
+      uint8_t* const pRxBuffer,
+      uint16_t* pBytesXfered
+);
+
 /******************************************************************************/
 /***                      Callback functions for SPI                        ***/
 /******************************************************************************/
 
+/**
+ * @brief   SPI5 DMA RX callback function
+ *
+ * This function should only be called from the ISR that handles the DMA ISR
+ * that handles the DMA stream that handles this functionality.
+ *
+ * @note: this function is defined as "inline" but not declared as such.  This
+ * is so it can be called externally (by the file that contains the actual ISRs)
+ * and they can still be inlined so as not incur any function call overhead.
+ *
+ * @param   None
+ * @return: None
+ */
+void SPI5_DMARxCallback( void );
+
+/**
+ * @brief   SPI5 DMA TX callback function
+ *
+ * This function should only be called from the ISR that handles the DMA ISR
+ * that handles the DMA stream that handles this functionality.
+ *
+ * @note: this function is defined as "inline" but not declared as such.  This
+ * is so it can be called externally (by the file that contains the actual ISRs)
+ * and they can still be inlined so as not incur any function call overhead.
+ *
+ * @param   None
+ * @return: None
+ */
+void SPI5_DMATxCallback( void );
 
 /**
  * @}
@@ -28,9 +28,11 @@ extern "C" {
 #include "stm32f4xx_spi.h"                           /* For STM32 SPI support */
 #include "bsp_defs.h"
 #include "Shared.h"
+#include "spi_xfer.h"                         /* For the SPI transaction engine */
 
 /* Exported defines ----------------------------------------------------------*/
 #define MAX_SPI_LEN 512                  /**< Max SPI trans/rec size in bytes */
+#define MAX_SPI_XFER_LEN 256    /**< Max size of a queued SPIBusMgr transaction */
 
 /* Exported types ------------------------------------------------------------*/
 
@@ -111,6 +113,9 @@ typedef struct SPI_BusSettings
    uint8_t*            pTxBuffer;                     /**< SPI TX data buffer.*/
    uint16_t            nTxIndex;          /**< SPI TX data buffer used length.*/
 
+   /* DMA driven transactions */
+   SPI_Xfer_t          xfer;         /**< Transaction run by the SPI DMA ISRs */
+
 } SPI_BusSettings_t;
 
 
@@ -0,0 +1,147 @@
+/**
+ * @file    spi_xfer.c
+ * @brief   DMA driven SPI master transaction engine.
+ *
+ * See spi_xfer.h for the description.  Nothing in here is allowed to touch the
+ * hardware or QP.  spi.c does that based on the returned actions.
+ *
+ * @date    10/19/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ *
+ * @addtogroup groupSPI
+ * @{
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "spi_xfer.h"
+#include <stddef.h>
+
+/* Compile-time called macros ------------------------------------------------*/
+/* Private typedefs ----------------------------------------------------------*/
+/* Private defines -----------------------------------------------------------*/
+/* Private macros ------------------------------------------------------------*/
+/* Private variables and Local objects ---------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+
+/**
+ * @brief   Move a transaction to DONE.
+ * @param [in|out] *pXfer: SPI_Xfer_t pointer to the transaction.
+ * @param [in] status: DC3Error_t result of the transaction.
+ * @param [in] acts: uint16_t any SPI_XFER_ACT_xxx flags that still have to be
+ * done to the peripheral.
+ * @return  uint16_t: the actions with SPI_XFER_ACT_DONE added.
+ */
+static uint16_t SPI_xferFinish(
+      SPI_Xfer_t *pXfer,
+      const DC3Error_t status,
+      uint16_t acts
+);
+
+/* Private functions ---------------------------------------------------------*/
+/******************************************************************************/
+static uint16_t SPI_xferFinish(
+      SPI_Xfer_t *pXfer,
+      const DC3Error_t status,
+      uint16_t acts
+)
+{
+   /* Only a good transaction gets to hold on to the chip */
+   if ( pXfer->csSelected &&
+         ( ERR_NONE != status || !(pXfer->flags & SPI_XFER_FLAG_KEEP_CS) ) ) {
+      acts |= SPI_XFER_ACT_CS_RELEASE;
+      pXfer->csSelected = false;
+   }
+
+   pXfer->state  = SPI_XFER_DONE;
+   pXfer->status = status;
+   return( acts | SPI_XFER_ACT_DONE );
+}
+
+/* Public functions ----------------------------------------------------------*/
+/******************************************************************************/
+uint16_t SPI_XferStart(
+      SPI_Xfer_t *pXfer,
+      const uint8_t *pTx,
+      uint8_t *pRx,
+      const uint16_t len,
+      const uint8_t flags
+)
+{
+   pXfer->pTx   = pTx;
+   pXfer->pRx   = pRx;
+   pXfer->len   = len;
+   pXfer->flags = flags;
+
+   if ( NULL == pTx || NULL == pRx || 0 == len ) {
+      return( SPI_xferFinish(
+            pXfer,
+            ERR_SPI_INVALID_PARAMS_FOR_XFER,
+            SPI_XFER_ACT_NONE
+      ) );
+   }
+
+   uint16_t acts = SPI_XFER_ACT_DMA;
+   if ( !pXfer->csSelected ) {
+      acts |= SPI_XFER_ACT_CS_SELECT;
+      pXfer->csSelected = true;
+   }
+
+   pXfer->state  = SPI_XFER_DATA;
+   pXfer->status = ERR_SPI_DMA_TIMEOUT;
+   return( acts );
+}
+
+/******************************************************************************/
+uint16_t SPI_XferOnDmaDone( SPI_Xfer_t *pXfer )
+{
+   if ( SPI_XFER_DATA != pXfer->state ) {
+      return( SPI_XFER_ACT_NONE );
+   }
+
+   /* The SPI is idle once the last byte is in so there's nothing to wait for
+    * before touching NSS. */
+   return( SPI_xferFinish( pXfer, ERR_NONE, SPI_XFER_ACT_DMA_STOP ) );
+}
+
+/******************************************************************************/
+uint16_t SPI_XferOnError( SPI_Xfer_t *pXfer, const DC3Error_t error )
+{
+   if ( !SPI_XferIsBusy( pXfer ) ) {
+      return( SPI_XFER_ACT_NONE );
+   }
+
+   return( SPI_xferFinish( pXfer, error, SPI_XFER_ACT_DMA_STOP ) );
+}
+
+/******************************************************************************/
+uint16_t SPI_XferAbort( SPI_Xfer_t *pXfer )
+{
+   uint16_t acts = SPI_XFER_ACT_NONE;
+
+   if ( SPI_XferIsBusy( pXfer ) ) {
+      acts |= SPI_XFER_ACT_DMA_STOP;
+      pXfer->state = SPI_XFER_IDLE;
+   }
+
+   if ( pXfer->csSelected ) {
+      acts |= SPI_XFER_ACT_CS_RELEASE;
+      pXfer->csSelected = false;
+   }
+
+   return( acts );
+}
+
+/******************************************************************************/
+bool SPI_XferIsBusy( const SPI_Xfer_t *pXfer )
+{
+   return( SPI_XFER_DATA == pXfer->state );
+}
+
+/**
+ * @}
+ * end addtogroup groupSPI
+ */
+
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
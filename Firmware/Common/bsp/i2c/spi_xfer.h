@@ -0,0 +1,163 @@
+/**
+ * @file    spi_xfer.h
+ * @brief   DMA driven SPI master transaction engine.
+ *
+ * This is the state logic for a single full duplex SPI transaction:
+ *    select the chip, clock len bytes out of the TX buffer and into the RX
+ *    buffer at the same time, release the chip.
+ * It doesn't touch any hardware.  spi.c starts the transaction, the DMA ISRs
+ * tell it when the data is done (or failed) and it tells them what to do to the
+ * NSS pin and the DMA next.  Both directions are done by DMA and the only thing
+ * left for the AO is a single completion event.
+ *
+ * A transaction can keep the chip selected when it's done so that the next one
+ * continues the same SPI frame (command first, then the data for it, etc).
+ *
+ * Since there are no hardware dependencies here, the engine can also be driven
+ * by a loopback SPI model on a host that copies TX into RX and "finishes" the
+ * DMA.
+ *
+ * @date    10/19/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ *
+ * @addtogroup groupSPI
+ * @{
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef SPI_XFER_H_
+#define SPI_XFER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "DC3Errors.h"                               /* For DC3 error codes */
+
+/* Exported defines ----------------------------------------------------------*/
+
+/* Transaction flags */
+#define SPI_XFER_FLAG_NONE      0x00           /**< Plain select/xfer/release */
+#define SPI_XFER_FLAG_KEEP_CS   0x01  /**< Leave chip selected after the xfer */
+
+/* Things the ISR has to do to the peripheral.  More than one can be requested
+ * at a time and the ISR has to do them in the order they are listed here. */
+#define SPI_XFER_ACT_NONE       0x0000                     /**< Nothing to do */
+#define SPI_XFER_ACT_CS_SELECT  0x0001                 /**< Drive NSS pin low */
+#define SPI_XFER_ACT_DMA        0x0002      /**< Start RX then TX DMA for len */
+#define SPI_XFER_ACT_DMA_STOP   0x0004             /**< Stop both DMA streams */
+#define SPI_XFER_ACT_CS_RELEASE 0x0008                /**< Drive NSS pin high */
+#define SPI_XFER_ACT_DONE       0x0010   /**< Transfer is over. Check status. */
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief   Phases of a transaction.
+ */
+typedef enum SPI_XferStates {
+   SPI_XFER_IDLE = 0,                         /**< No transaction in progress */
+   SPI_XFER_DATA,                       /**< Waiting for the RX DMA to finish */
+   SPI_XFER_DONE,                        /**< Finished. Status has the result */
+} SPI_XferState_t;
+
+/**
+ * @brief   A single SPI transaction.
+ */
+typedef struct {
+   SPI_XferState_t state;              /**< Which phase the transaction is in */
+   uint8_t         flags;                 /**< SPI_XFER_FLAG_xxx for this one */
+   bool            csSelected;     /**< Chip still selected from the last one */
+   const uint8_t   *pTx;                               /**< Data to clock out */
+   uint8_t         *pRx;                    /**< Where to put clocked in data */
+   uint16_t        len;                           /**< How many bytes to move */
+   DC3Error_t      status;                  /**< Result, or what it waits for */
+} SPI_Xfer_t;
+
+/* Exported macros -----------------------------------------------------------*/
+/* Exported constants --------------------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief   Set up a new transaction and get the action that kicks it off.
+ *
+ * The chip only gets selected if the previous transaction didn't leave it
+ * that way.
+ *
+ * @param [in|out] *pXfer: SPI_Xfer_t pointer to the transaction.
+ * @param [in] *pTx: const uint8_t pointer to the data to clock out.  Has to
+ * stay around until the transaction is DONE.
+ * @param [out] *pRx: uint8_t pointer to where to put the clocked in data.  Has
+ * to stay around until the transaction is DONE.
+ * @param [in] len: uint16_t how many bytes to move.  Can't be 0.
+ * @param [in] flags: uint8_t SPI_XFER_FLAG_xxx flags OR'ed together.
+ * @return  uint16_t: SPI_XFER_ACT_xxx flags for what to do to the peripheral.
+ * This is either a chip select and DMA or DONE if the parameters are bad.
+ */
+uint16_t SPI_XferStart(
+      SPI_Xfer_t *pXfer,
+      const uint8_t *pTx,
+      uint8_t *pRx,
+      const uint16_t len,
+      const uint8_t flags
+);
+
+/**
+ * @brief   Handle a DMA transfer complete interrupt of the RX stream.
+ *
+ * In full duplex the last RX byte comes in after the last TX byte has gone
+ * out so this is the only completion that matters.
+ *
+ * @param [in|out] *pXfer: SPI_Xfer_t pointer to the transaction.
+ * @return  uint16_t: SPI_XFER_ACT_xxx flags for what to do to the peripheral.
+ */
+uint16_t SPI_XferOnDmaDone( SPI_Xfer_t *pXfer );
+
+/**
+ * @brief   Handle a DMA transfer error of either stream.
+ *
+ * The chip always gets released on errors, even if the transaction wanted to
+ * keep it.
+ *
+ * @param [in|out] *pXfer: SPI_Xfer_t pointer to the transaction.
+ * @param [in] error: DC3Error_t what went wrong.
+ * @return  uint16_t: SPI_XFER_ACT_xxx flags for what to do to the peripheral.
+ */
+uint16_t SPI_XferOnError( SPI_Xfer_t *pXfer, const DC3Error_t error );
+
+/**
+ * @brief   Give up on the current transaction (timeouts) or release a chip
+ * that was left selected.
+ *
+ * The status is left alone if the transaction is in progress so the caller can
+ * still tell what it was waiting for.
+ *
+ * @param [in|out] *pXfer: SPI_Xfer_t pointer to the transaction.
+ * @return  uint16_t: SPI_XFER_ACT_xxx flags for what to do to the peripheral.
+ * Never includes SPI_XFER_ACT_DONE.
+ */
+uint16_t SPI_XferAbort( SPI_Xfer_t *pXfer );
+
+/**
+ * @brief   Check if a transaction is in progress.
+ *
+ * @param [in] *pXfer: const SPI_Xfer_t pointer to the transaction.
+ * @return  bool: true if the transaction was started and isn't DONE yet.
+ */
+bool SPI_XferIsBusy( const SPI_Xfer_t *pXfer );
+
+/**
+ * @}
+ * end addtogroup groupSPI
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif                                                        /* SPI_XFER_H_ */
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
@@ -47,6 +47,7 @@
 #include "bsp_defs.h"
 #include "project_includes.h"                     /* Projec specific includes */
 #include "CommMgr.h"
+#include "qs_udp.h"                                /* QS trace output over UDP */
 #if CPLR_APP
 #include "cplr.h"
 #elif CPLR_BOOT
@@ -81,6 +82,23 @@ struct echo_state {
     struct pbuf *p;                              /**< pbuf (chain) to recycle */
 };
 
+/**
+ * \struct Keep track of a UDP client.  There's one per remote IP address and
+ * port so replies can go back to whoever sent the request.
+ */
+typedef struct {
+    ip_addr_t addr;                              /**< IP address of the client */
+    uint16_t  port;                /**< UDP port of the client.  0 if not used */
+    uint32_t  lastSeenMs;          /**< sessionClkMs when it last sent a msg */
+    uint8_t   queued;   /**< Msgs handed to CommMgr that aren't done with yet */
+    uint8_t   maxQueued;                   /**< Most msgs ever queued at once */
+    uint16_t  rateCurr;           /**< Msgs received so far in this second */
+    uint16_t  ratePeak;              /**< Most msgs received in any one second */
+    uint32_t  nRx;                                  /**< Msgs received from it */
+    uint32_t  nTx;                                      /**< Msgs sent to it */
+    uint32_t  nDropped;          /**< Msgs dropped since its queue was full */
+} LWIPSession_t;
+
 
 /**
  * \brief LWIPMgr "class"
@@ -143,6 +161,52 @@ typedef struct {
 
     /**< Local timer for TCP send timeout. */
     QTimeEvt te_TcpSend;
+
+    /**< Address of the host that ETH_UDP_PUSH msgs go to. */
+    ip_addr_t pushAddr;
+
+    /**< UDP port of the host that ETH_UDP_PUSH msgs go to.  0 if none. */
+    uint16_t pushPort;
+
+    /**< Msg (with its header) being put together from the TCP sys stream. */
+    uint8_t sysRxBuf[DC3_ETH_FRAME_HDR_LEN + DC3_MAX_MSG_LEN];
+
+    /**< Number of bytes in sysRxBuf so far. */
+    uint16_t sysRxLen;
+
+    /**< Number of bytes sysRxBuf needs: just the header until it's in and then
+     the header and the whole msg. */
+    uint16_t sysRxWant;
+
+    /**< TCP sys stream data not taken into sysRxBuf yet. */
+    struct pbuf *sysRxHeld;
+
+    /**< Number of bytes already taken from the first pbuf of sysRxHeld. */
+    uint16_t sysRxOffset;
+
+    /**< Number of msgs from the TCP sys port CommMgr isn't done with yet. */
+    uint8_t sysInFlight;
+
+    /**< Native QF queue for msgs waiting for room to go out on the TCP sys port. */
+    QEQueue sysTxQueue;
+
+    /**< Storage for the TCP sys port send queue. */
+    QEvt const * sysTxQSto[DC3_MEM_READ_MAX_CREDITS + 8];
+
+    /**< UDP clients the board is talking to. */
+    LWIPSession_t sessions[LWIP_MAX_SESSIONS];
+
+    /**< Session that sent the last UDP msg.  Msgs without a session go to it. */
+    uint8_t lastSession;
+
+    /**< Ms counted by the slow tick.  Used to age the sessions. */
+    uint32_t sessionClkMs;
+
+    /**< Ms into the current second of the session rate accounting. */
+    uint16_t sessionRateMs;
+
+    /**< UDP msgs dropped because of a full session queue or session table. */
+    uint32_t sessionDrops;
 } LWIPMgr;
 
 /* Keeps track of what port is used by logging TCP connection */
@@ -215,6 +279,24 @@ static QState LWIPMgr_Sending(LWIPMgr * const me, QEvt const * const e);
 /* Private defines -----------------------------------------------------------*/
 #define LWIP_SLOW_TICK_MS       TCP_TMR_INTERVAL
 
+/**< Max number of msgs from the TCP sys port that CommMgr gets handed at a time.
+ * The rest wait in the TCP window so this has to stay below the depth of the
+ * deferred queue in CommMgr. */
+#define LWIP_SYS_MAX_IN_FLIGHT  4
+
+/**< Number of large events the TCP sys port leaves in the pool for everybody
+ * else.  CommMgr needs a few of them to reply to the msgs it gets handed. */
+#define LWIP_SYS_POOL_MARGIN    8U
+
+/**< Max number of msgs from one UDP session that CommMgr gets handed at a time.
+ * Any more than that get dropped so one client can't fill up the deferred queue
+ * in CommMgr for everybody else. */
+#define LWIP_SESSION_MAX_QUEUED 4
+
+/**< How long a UDP session with nothing in CommMgr lasts without hearing from
+ * its client. */
+#define LWIP_SESSION_IDLE_MS    60000U
+
 /* Private macros ------------------------------------------------------------*/
 /* Private variables and Local objects ---------------------------------------*/
 static LWIPMgr l_LWIPMgr;       /* the single instance of the active object */
@@ -350,6 +432,108 @@ static void LWIP_tcpClose(struct tcp_pcb * tpcb, struct echo_state * es);
 /*${AOs::LWIP_tcpError} ....................................................*/
 static void LWIP_tcpError(void * arg, err_t err);
 
+/* TCP sys port functions */
+
+/**
+ * @brief: Take msgs out of the TCP sys stream and hand them to CommMgr.
+ * Only the data that's taken out gets acknowledged with tcp_recved() so the
+ * sender is held off by the TCP window whenever CommMgr has enough msgs
+ * already or the event pool is running low.  Whatever is left gets picked up
+ * the next time this is called.
+ *
+ * @param [in|out] *me: LWIPMgr pointer to the AO.
+ *
+ * @return bool: false if the stream had a bad header and can't be trusted
+ * anymore.  True otherwise.
+ */
+static bool LWIPMgr_sysRxPull( LWIPMgr * const me );
+
+/**
+ * @brief: Write out as many of the msgs waiting for the TCP sys port as fit
+ * into the TCP send buffer.
+ *
+ * @param [in|out] *me: LWIPMgr pointer to the AO.
+ *
+ * @return None
+ */
+static void LWIPMgr_sysTxDrain( LWIPMgr * const me );
+
+/**
+ * @brief: Move both directions of the TCP sys port along and drop the
+ * connection if the stream can't be trusted anymore.
+ *
+ * @param [in|out] *me: LWIPMgr pointer to the AO.
+ *
+ * @return None
+ */
+static void LWIPMgr_sysService( LWIPMgr * const me );
+
+/**
+ * @brief: Throw away everything that was in progress on the TCP sys port once
+ * the connection is gone.
+ *
+ * @param [in|out] *me: LWIPMgr pointer to the AO.
+ *
+ * @return None
+ */
+static void LWIPMgr_sysReset( LWIPMgr * const me );
+
+/**
+ * @brief: Find the UDP session of a client or start a new one.  If the table
+ * is full, the session that's been quiet the longest is dropped unless all of
+ * them still have msgs in CommMgr.
+ *
+ * @param [in|out] *me: LWIPMgr pointer to the AO.
+ * @param [in] *addr: ip_addr pointer to the IP address of the client.
+ * @param [in] port: u16_t UDP port of the client.
+ *
+ * @return uint8_t: index of the session or ETH_NO_SESSION if there's no room.
+ */
+static uint8_t LWIPMgr_sessionGet(
+      LWIPMgr * const me,
+      struct ip_addr *addr,
+      u16_t port
+);
+
+/**
+ * @brief: Get the UDP session a msg should go to.
+ *
+ * @param [in|out] *me: LWIPMgr pointer to the AO.
+ * @param [in] session: uint8_t index of the session.  ETH_NO_SESSION for the
+ * one that sent the last msg.
+ *
+ * @return LWIPSession_t pointer to the session or NULL if it's not in use.
+ */
+static LWIPSession_t *LWIPMgr_sessionFor(
+      LWIPMgr * const me,
+      uint8_t session
+);
+
+/**
+ * @brief: Print what a UDP session did and take it out of the table.
+ *
+ * @param [in|out] *me: LWIPMgr pointer to the AO.
+ * @param [in] session: uint8_t index of the session.
+ * @param [in] *why: const char pointer to why it's going away.
+ *
+ * @return None
+ */
+static void LWIPMgr_sessionEnd(
+      LWIPMgr * const me,
+      uint8_t session,
+      const char *why
+);
+
+/**
+ * @brief: Move the UDP session clock along.  Every second, the rates are
+ * rolled over and the sessions that went quiet are dropped.
+ *
+ * @param [in|out] *me: LWIPMgr pointer to the AO.
+ *
+ * @return None
+ */
+static void LWIPMgr_sessionTick( LWIPMgr * const me );
+
 
 /* UDP functions */
 /**
@@ -358,8 +542,7 @@ static void LWIP_tcpError(void * arg, err_t err);
   *             creates a new MsgEvt event (for CommStack) and publishes it to
   *             the shared CommStackMgr AO. IT SHOULD NOT BE CALLED DIRECTLY.
   *
-  * @param  arg: a pointer to arg.  (Not currently used but in the original
-  *             implementation of the callback.
+  * @param  arg: a pointer to the LWIPMgr AO.
   * @param  upcb: a pointer to the udb structure containing UDP connect data.
   * @param  p:  a pointer to the pbuf containing the received data.
   * @param  addr: a pointer to struct containing the IP data.
@@ -399,6 +582,13 @@ void LWIPMgr_ctor(void) {
         (QEvt const **)( me->deferredEvtQSto ),
         Q_DIM(me->deferredEvtQSto)
     );
+
+    /* Initialize the TCP sys port send queue and storage for it */
+    QEQueue_init(
+        &me->sysTxQueue,
+        (QEvt const **)( me->sysTxQSto ),
+        Q_DIM(me->sysTxQSto)
+    );
 }
 
 /**
@@ -469,6 +659,17 @@ static QState LWIPMgr_initial(LWIPMgr * const me, QEvt const * const e) {
     me->upcb = udp_new();
     udp_bind(me->upcb, IP_ADDR_ANY, LWIPMgr_cliPort);
     udp_recv(me->upcb, &udp_rx_handler, me);
+    ip_addr_set_zero(&me->pushAddr);
+    me->pushPort = 0;                                  /* Nobody to push to yet */
+    memset(me->sessions, 0, sizeof(me->sessions));
+    me->lastSession   = ETH_NO_SESSION;
+    me->sessionClkMs  = 0;
+    me->sessionRateMs = 0;
+    me->sessionDrops  = 0;
+
+    #ifdef Q_SPY
+    QS_UDP_init();                /* Port for hosts to collect the QS trace from */
+    #endif
 
     /* Set up TCP related PCB  for system connnection */
     me->tpcb_sys = tcp_new();
@@ -483,6 +684,13 @@ static QState LWIPMgr_initial(LWIPMgr * const me, QEvt const * const e) {
     me->tpcb_sys = tcp_listen(me->tpcb_sys);
     tcp_accept(me->tpcb_sys, LWIP_tcpAccept);
 
+    LWIPMgr_es_sys  = NULL;
+    me->sysRxHeld   = NULL;
+    me->sysRxOffset = 0;
+    me->sysRxLen    = 0;
+    me->sysRxWant   = DC3_ETH_FRAME_HDR_LEN;  /* Every msg starts with its header */
+    me->sysInFlight = 0;
+
     /* Set up TCP related PCB  for log/dbg connnection */
     me->tpcb_log = tcp_new();
     if (me->tpcb_log == NULL) {
@@ -551,18 +759,37 @@ static QState LWIPMgr_Active(LWIPMgr * const me, QEvt const * const e) {
         /* ${AOs::LWIPMgr::SM::Active::ETH_UDP_SEND, CL~} */
         case ETH_UDP_SEND_SIG: /* intentionally fall through */
         case CLI_SEND_DATA_SIG: {
-            /* Event posted that will include (inside it) a msg to send */
-            if (me->upcb->remote_port != (uint16_t)0) {
-                struct pbuf *p = pbuf_new(
-                    (u8_t *)((LrgDataEvt const *)e)->dataBuf,
-                    ((LrgDataEvt const *)e)->dataLen
-                );
-                if (p != (struct pbuf *)0) {
-                    udp_send(me->upcb, p);
-                    pbuf_free(p);                   /* don't leak the pbuf! */
+            /* ${AOs::LWIPMgr::SM::Active::ETH_UDP_SEND, CL~::[SysTcp?]} */
+            if (_DC3_EthSys == ((LrgDataEvt const *)e)->dst) {
+                /* The msg goes out behind whatever is already waiting for the window */
+                if (NULL == LWIPMgr_es_sys) {
+                    WRN_printf("No connection on TCP sys port %d, dropping msg\n",
+                        LWIPMgr_sysPort);
+                } else if (!QEQueue_post(&me->sysTxQueue, e, 1U)) {
+                    ERR_printf("TCP sys send queue full, dropping msg\n");
+                } else {
+                    LWIPMgr_sysTxDrain(me);
                 }
+                status_ = Q_HANDLED();
+            }
+            /* ${AOs::LWIPMgr::SM::Active::ETH_UDP_SEND, CL~::[else]} */
+            else {
+                /* Event posted that will include (inside it) a msg to send.  It goes back to
+                 * the session the request came from. */
+                LWIPSession_t *s = LWIPMgr_sessionFor(me, ((LrgDataEvt const *)e)->session);
+                if (NULL != s) {
+                    struct pbuf *p = pbuf_new(
+                        (u8_t *)((LrgDataEvt const *)e)->dataBuf,
+                        ((LrgDataEvt const *)e)->dataLen
+                    );
+                    if (p != (struct pbuf *)0) {
+                        udp_sendto(me->upcb, p, &s->addr, s->port);
+                        s->nTx++;
+                        pbuf_free(p);                   /* don't leak the pbuf! */
+                    }
+                }
+                status_ = Q_HANDLED();
             }
-            status_ = Q_HANDLED();
             break;
         }
         /* ${AOs::LWIPMgr::SM::Active::LWIP_RX_READY} */
@@ -632,6 +859,16 @@ static QState LWIPMgr_Active(LWIPMgr * const me, QEvt const * const e) {
                 autoip_tmr();
             }
             #endif
+
+            #ifdef Q_SPY
+            QS_UDP_flush();          /* Send the QS trace the idle task staged so far */
+            #endif
+
+            /* Pick the TCP sys port back up if it ran out of events or lwIP mem */
+            LWIPMgr_sysService(me);
+
+            /* Roll over the session rates and drop the sessions that went quiet */
+            LWIPMgr_sessionTick(me);
             status_ = Q_HANDLED();
             break;
         }
@@ -641,6 +878,58 @@ static QState LWIPMgr_Active(LWIPMgr * const me, QEvt const * const e) {
             status_ = Q_HANDLED();
             break;
         }
+        /* ${AOs::LWIPMgr::SM::Active::ETH_UDP_PUSH_SUB} */
+        case ETH_UDP_PUSH_SUB_SIG: {
+            /* Latch the address of the session that asked for the pushes.  It's copied
+             * so the pushes keep going even if the session gets dropped later. */
+            LWIPSession_t const *s = LWIPMgr_sessionFor(
+                me,
+                ((EthPushSubEvt const *)e)->session
+            );
+            if (((EthPushSubEvt const *)e)->bEnable && NULL != s) {
+                ip_addr_copy(me->pushAddr, s->addr);
+                me->pushPort = ( 0 != ((EthPushSubEvt const *)e)->port ) ?
+                    ((EthPushSubEvt const *)e)->port : s->port;
+            } else {
+                ip_addr_set_zero(&me->pushAddr);
+                me->pushPort = 0;
+            }
+            status_ = Q_HANDLED();
+            break;
+        }
+        /* ${AOs::LWIPMgr::SM::Active::ETH_UDP_PUSH} */
+        case ETH_UDP_PUSH_SIG: {
+            /* Event posted that will include (inside it) a msg to push */
+            if (me->pushPort != (uint16_t)0) {
+                struct pbuf *p = pbuf_new(
+                    (u8_t *)((LrgDataEvt const *)e)->dataBuf,
+                    ((LrgDataEvt const *)e)->dataLen
+                );
+                if (p != (struct pbuf *)0) {
+                    udp_sendto(me->upcb, p, &me->pushAddr, me->pushPort);
+                    pbuf_free(p);                   /* don't leak the pbuf! */
+                }
+            }
+            status_ = Q_HANDLED();
+            break;
+        }
+        /* ${AOs::LWIPMgr::SM::Active::ETH_MSG_DONE} */
+        case ETH_MSG_DONE_SIG: {
+            /* CommMgr is done with one of the msgs from the TCP sys port or a UDP session */
+            if (_DC3_EthSys == ((EthMsgDoneEvt const *)e)->route) {
+                if (me->sysInFlight > 0) {
+                    me->sysInFlight--;
+                }
+                LWIPMgr_sysService(me);
+            } else if (((EthMsgDoneEvt const *)e)->session < LWIP_MAX_SESSIONS) {
+                LWIPSession_t *s = &me->sessions[((EthMsgDoneEvt const *)e)->session];
+                if (s->queued > 0) {
+                    s->queued--;
+                }
+            }
+            status_ = Q_HANDLED();
+            break;
+        }
         default: {
             status_ = Q_SUPER(&QHsm_top);
             break;
@@ -997,6 +1286,10 @@ static err_t LWIP_tcpAccept(
             LOG_printf("New connection accepted on log/debug port %d\n", newpcb->local_port);
         } else if ( LWIPMgr_sysPort == newpcb->local_port ) {
             LWIPMgr_es_sys = es; /* Tell the opaque pointer about this new structure. */
+            /* Msgs are small and each one waits on the last so Nagle would only
+             * add delay.  Sent acks keep the send queue draining. */
+            tcp_nagle_disable(newpcb);
+            tcp_sent(newpcb, LWIP_tcpSent);
             LOG_printf("New connection accepted on system port %d\n", newpcb->local_port);
         } else {
             ERR_printf("Unknown port number %d\n", newpcb->local_port );
@@ -1060,6 +1353,17 @@ static err_t LWIP_tcpRecv(
         }
         ret_err = err;
         ERR_printf("Unknown error\n");
+    } else if ( LWIPMgr_sysPort == tpcb->local_port && ES_CLOSING != es->state ) {
+        /* The sys port is a stream of framed msgs.  Hold on to the data until
+         * it's taken out so TCP flow control can throttle the sender. */
+        es->state = ES_RECEIVED;
+        if ( NULL == l_LWIPMgr.sysRxHeld ) {
+            l_LWIPMgr.sysRxHeld = p;
+        } else {
+            pbuf_cat(l_LWIPMgr.sysRxHeld, p);
+        }
+        LWIPMgr_sysService(&l_LWIPMgr);
+        ret_err = ERR_OK;
     } else if(es->state == ES_ACCEPTED) {
         /* first data chunk in p->payload */
         es->state = ES_RECEIVED;
@@ -1071,31 +1375,6 @@ static err_t LWIP_tcpRecv(
                 "Received data on LOG port %d. Ignoring.\n",
                 tpcb->local_port
             );
-        } else if ( LWIPMgr_sysPort == tpcb->local_port ) {
-            LOG_printf(
-                "Received data on SYS port %d.\n",
-                tpcb->local_port
-            );
-
-    #if CPLR_APP
-            EthEvt *ethEvt = Q_NEW(EthEvt, CPLR_ETH_SYS_TEST_SIG);
-
-            /* Fill the msg payload with payload (the actual received msg)*/
-            ethEvt->msg_len = (p->tot_len)-1;
-            MEMCPY(
-                  ethEvt->msg,
-                  p->payload,
-                  ethEvt->msg_len
-            );
-            ethEvt->msg_src = _DC3_EthSys;
-
-            /* Post directly to the "raw" queue for FreeRTOS task to read */
-            QEQueue_postFIFO(&CPLR_evtQueue, (QEvt *)ethEvt);
-    #elif CPLR_BOOT
-        LOG_printf("Ignoring.\n");
-    #else
-        #error "Invalid build.  CPLR_APP or CPLR_BOOT must be specified"
-    #endif
         } else {
             LOG_printf(
                 "Received data on unknown port %d.  Discarding.\n",
@@ -1118,30 +1397,6 @@ static err_t LWIP_tcpRecv(
                     "Received data on LOG port %d. Ignoring.\n",
                     tpcb->local_port
                 );
-            } else if ( LWIPMgr_sysPort == tpcb->local_port ) {
-                DBG_printf(
-                    "Received data on SYS port %d.\n",
-                    tpcb->local_port
-                );
-    #if CPLR_APP
-                EthEvt *ethEvt = Q_NEW(EthEvt, CPLR_ETH_SYS_TEST_SIG);
-
-                /* Fill the msg payload with payload (the actual received msg)*/
-                ethEvt->msg_len = (p->tot_len)-1;
-                MEMCPY(
-                      ethEvt->msg,
-                      p->payload,
-                      ethEvt->msg_len
-                );
-                ethEvt->msg_src = _DC3_EthSys;
-
-                /* Post directly to the "raw" queue for FreeRTOS task to read */
-                QEQueue_postFIFO(&CPLR_evtQueue, (QEvt *)ethEvt);
-    #elif CPLR_BOOT
-                LOG_printf("Ignoring.\n");
-    #else
-        #error "Invalid build.  CPLR_APP or CPLR_BOOT must be specified"
-    #endif
             } else {
                 LOG_printf(
                     "Received data on unknown port %d.  Discarding.\n",
@@ -1257,6 +1512,11 @@ static err_t LWIP_tcpSent(
     LWIP_UNUSED_ARG(len);
     es = (struct echo_state *)arg;
     es->retries = 0;
+    if ( LWIPMgr_sysPort == tpcb->local_port ) {
+        /* Acked data made room for more msgs on the sys port */
+        LWIPMgr_sysTxDrain(&l_LWIPMgr);
+        return ERR_OK;
+    }
     if(es->p != NULL) {
         /* still got pbufs to send */
         tcp_sent(tpcb, LWIP_tcpSent);
@@ -1333,6 +1593,7 @@ static void LWIP_tcpClose(struct tcp_pcb * tpcb, struct echo_state * es) {
             LOG_printf("Log/Dbg TCP Connection on port %d closed\n", tpcb->local_port);
         } else if ( LWIPMgr_sysPort == tpcb->local_port ) {
             LWIPMgr_es_sys = NULL;
+            LWIPMgr_sysReset(&l_LWIPMgr);
             LOG_printf("System TCP Connection on port %d closed\n", tpcb->local_port);
         } else {
             WRN_printf(
@@ -1366,6 +1627,7 @@ static void LWIP_tcpError(void * arg, err_t err) {
             LOG_printf("Log/Dbg TCP Connection on port %d closed\n", es->pcb->local_port);
         } else if ( LWIPMgr_sysPort == es->pcb->local_port ) {
             LWIPMgr_es_sys = NULL;
+            LWIPMgr_sysReset(&l_LWIPMgr);
             LOG_printf("System TCP Connection on port %d closed\n", es->pcb->local_port);
         } else {
             WRN_printf(
@@ -1378,6 +1640,309 @@ static void LWIP_tcpError(void * arg, err_t err) {
     ERR_printf("Handling error, freeing memory\n");
 }
 
+/* TCP sys port msg reassembly ...............................................*/
+static bool LWIPMgr_sysRxPull( LWIPMgr * const me )
+{
+    uint16_t taken = 0;
+    bool inSync = true;
+
+    for (;;) {
+        /* A whole msg goes to CommMgr before any more of the stream is taken */
+        if ( me->sysRxLen == me->sysRxWant &&
+             me->sysRxWant > DC3_ETH_FRAME_HDR_LEN ) {
+            LrgDataEvt *msgEvt = NULL;
+            if ( me->sysInFlight < LWIP_SYS_MAX_IN_FLIGHT ) {
+                Q_NEW_X(msgEvt, LrgDataEvt, LWIP_SYS_POOL_MARGIN, CLI_RECEIVED_SIG);
+            }
+            if ( NULL == msgEvt ) {
+                break;                  /* Try again once CommMgr catches up */
+            }
+
+            msgEvt->dataLen = me->sysRxWant - DC3_ETH_FRAME_HDR_LEN;
+            MEMCPY(
+                msgEvt->dataBuf,
+                &me->sysRxBuf[DC3_ETH_FRAME_HDR_LEN],
+                msgEvt->dataLen
+            );
+            msgEvt->src = _DC3_EthSys;
+            msgEvt->dst = _DC3_EthSys;
+            msgEvt->session = ETH_NO_SESSION;
+            QACTIVE_POST( AO_CommMgr, (QEvt *)(msgEvt), AO_LWIPMgr );
+
+            me->sysInFlight++;
+            me->sysRxLen  = 0;
+            me->sysRxWant = DC3_ETH_FRAME_HDR_LEN;
+        }
+
+        if ( NULL == me->sysRxHeld ) {
+            break;
+        }
+
+        uint16_t len = me->sysRxHeld->len - me->sysRxOffset;
+        if ( len > me->sysRxWant - me->sysRxLen ) {
+            len = me->sysRxWant - me->sysRxLen;
+        }
+        MEMCPY(
+            &me->sysRxBuf[me->sysRxLen],
+            (uint8_t *)me->sysRxHeld->payload + me->sysRxOffset,
+            len
+        );
+        me->sysRxLen    += len;
+        me->sysRxOffset += len;
+        taken           += len;
+
+        /* Let go of every pbuf as soon as it's used up */
+        if ( me->sysRxOffset >= me->sysRxHeld->len ) {
+            struct pbuf *next = me->sysRxHeld->next;
+            if ( NULL != next ) {
+                pbuf_ref( next );        /* Keeps the rest of the chain around */
+            }
+            pbuf_free( me->sysRxHeld );
+            me->sysRxHeld   = next;
+            me->sysRxOffset = 0;
+        }
+
+        /* Once the header is in, the msg length says how much more to take */
+        if ( DC3_ETH_FRAME_HDR_LEN == me->sysRxWant &&
+             DC3_ETH_FRAME_HDR_LEN == me->sysRxLen ) {
+            uint16_t msgLen = ((uint16_t)me->sysRxBuf[0] << 8) | me->sysRxBuf[1];
+            if ( 0 == msgLen || msgLen > DC3_MAX_MSG_LEN ) {
+                ERR_printf("Bad msg length %d on TCP sys port %d\n",
+                    msgLen, LWIPMgr_sysPort);
+                inSync = false;
+                break;
+            }
+            me->sysRxWant = DC3_ETH_FRAME_HDR_LEN + msgLen;
+        }
+    }
+
+    if ( taken > 0 && NULL != LWIPMgr_es_sys ) {
+        tcp_recved( LWIPMgr_es_sys->pcb, taken );        /* Open the window back up */
+    }
+    return( inSync );
+}
+
+/* TCP sys port msg sender ...................................................*/
+static void LWIPMgr_sysTxDrain( LWIPMgr * const me )
+{
+    bool bWritten = false;
+
+    while ( !QEQueue_isEmpty( &me->sysTxQueue ) ) {
+        LrgDataEvt const *evt = (LrgDataEvt const *)me->sysTxQueue.frontEvt;
+
+        /* Msgs for a connection that's gone just get thrown away */
+        if ( NULL != LWIPMgr_es_sys ) {
+            struct tcp_pcb *pcb = LWIPMgr_es_sys->pcb;
+            uint16_t frameLen = DC3_ETH_FRAME_HDR_LEN + evt->dataLen;
+            if ( tcp_sndbuf( pcb ) < frameLen ||
+                 tcp_sndqueuelen( pcb ) >= TCP_SND_QUEUELEN ) {
+                break;            /* Try again once some of it gets acked */
+            }
+
+            /* Header and msg go in with a single write so a lack of lwIP mem
+             * can't leave half a msg in the stream. */
+            uint8_t frame[DC3_ETH_FRAME_HDR_LEN + DC3_MAX_MSG_LEN];
+            frame[0] = (uint8_t)( evt->dataLen >> 8 );
+            frame[1] = (uint8_t)( evt->dataLen );
+            MEMCPY( &frame[DC3_ETH_FRAME_HDR_LEN], evt->dataBuf, evt->dataLen );
+            if ( ERR_OK != tcp_write( pcb, frame, frameLen, TCP_WRITE_FLAG_COPY ) ) {
+                break;                   /* Out of lwIP mem, try again later */
+            }
+            bWritten = true;
+        }
+
+        QF_gc( QEQueue_get( &me->sysTxQueue ) );
+    }
+
+    /* Don't wait for the TCP timer to send out what was just written */
+    if ( bWritten ) {
+        tcp_output( LWIPMgr_es_sys->pcb );
+    }
+}
+
+/* TCP sys port service ......................................................*/
+static void LWIPMgr_sysService( LWIPMgr * const me )
+{
+    if ( !LWIPMgr_sysRxPull( me ) && NULL != LWIPMgr_es_sys ) {
+        LWIP_tcpClose( LWIPMgr_es_sys->pcb, LWIPMgr_es_sys );
+    }
+    LWIPMgr_sysTxDrain( me );
+}
+
+/* TCP sys port reset ........................................................*/
+static void LWIPMgr_sysReset( LWIPMgr * const me )
+{
+    if ( NULL != me->sysRxHeld ) {
+        pbuf_free( me->sysRxHeld );
+        me->sysRxHeld = NULL;
+    }
+    me->sysRxOffset = 0;
+    me->sysRxLen    = 0;
+    me->sysRxWant   = DC3_ETH_FRAME_HDR_LEN;
+
+    /* The msgs CommMgr already has still get their ETH_msgDone() calls so
+     * sysInFlight is left alone. */
+    while ( !QEQueue_isEmpty( &me->sysTxQueue ) ) {
+        QF_gc( QEQueue_get( &me->sysTxQueue ) );
+    }
+}
+
+/* UDP session lookup ........................................................*/
+static uint8_t LWIPMgr_sessionGet(
+      LWIPMgr * const me,
+      struct ip_addr *addr,
+      u16_t port
+)
+{
+    uint8_t iFree   = ETH_NO_SESSION;
+    uint8_t iOldest = ETH_NO_SESSION;
+
+    for ( uint8_t i = 0; i < LWIP_MAX_SESSIONS; i++ ) {
+        LWIPSession_t const *s = &me->sessions[i];
+        if ( 0 == s->port ) {
+            if ( ETH_NO_SESSION == iFree ) {
+                iFree = i;
+            }
+        } else if ( port == s->port && ip_addr_cmp( addr, &s->addr ) ) {
+            return( i );
+        } else if ( 0 == s->queued && ( ETH_NO_SESSION == iOldest ||
+                    me->sessionClkMs - s->lastSeenMs >
+                    me->sessionClkMs - me->sessions[iOldest].lastSeenMs ) ) {
+            iOldest = i;                /* Replies still owed keep a session */
+        }
+    }
+
+    if ( ETH_NO_SESSION == iFree ) {
+        if ( ETH_NO_SESSION == iOldest ) {
+            return( ETH_NO_SESSION );
+        }
+        LWIPMgr_sessionEnd( me, iOldest, "replaced" );
+        iFree = iOldest;
+    }
+
+    LWIPSession_t *s = &me->sessions[iFree];
+    memset( s, 0, sizeof(*s) );
+    ip_addr_copy( s->addr, *addr );
+    s->port = port;
+    s->lastSeenMs = me->sessionClkMs;
+    DBG_printf("UDP session %d started for %d.%d.%d.%d:%d\n", iFree,
+          ip4_addr1_16(&s->addr), ip4_addr2_16(&s->addr),
+          ip4_addr3_16(&s->addr), ip4_addr4_16(&s->addr), s->port);
+    return( iFree );
+}
+
+/* UDP session for a msg .....................................................*/
+static LWIPSession_t *LWIPMgr_sessionFor(
+      LWIPMgr * const me,
+      uint8_t session
+)
+{
+    if ( ETH_NO_SESSION == session ) {
+        session = me->lastSession;
+    }
+
+    if ( session >= LWIP_MAX_SESSIONS || 0 == me->sessions[session].port ) {
+        return( NULL );
+    }
+    return( &me->sessions[session] );
+}
+
+/* UDP session end ...........................................................*/
+static void LWIPMgr_sessionEnd(
+      LWIPMgr * const me,
+      uint8_t session,
+      const char *why
+)
+{
+    LWIPSession_t *s = &me->sessions[session];
+    if ( s->rateCurr > s->ratePeak ) {
+        s->ratePeak = s->rateCurr;
+    }
+
+    DBG_printf("UDP session %d for %d.%d.%d.%d:%d %s: rx %lu, tx %lu, dropped %lu, max queued %d, peak %d msgs/s\n",
+          session, ip4_addr1_16(&s->addr), ip4_addr2_16(&s->addr),
+          ip4_addr3_16(&s->addr), ip4_addr4_16(&s->addr), s->port, why,
+          s->nRx, s->nTx, s->nDropped, s->maxQueued, s->ratePeak);
+
+    memset( s, 0, sizeof(*s) );
+    if ( me->lastSession == session ) {
+        me->lastSession = ETH_NO_SESSION;
+    }
+}
+
+/* UDP session clock .........................................................*/
+static void LWIPMgr_sessionTick( LWIPMgr * const me )
+{
+    me->sessionClkMs  += LWIP_SLOW_TICK_MS;
+    me->sessionRateMs += LWIP_SLOW_TICK_MS;
+    if ( me->sessionRateMs < 1000U ) {
+        return;
+    }
+    me->sessionRateMs = 0;
+
+    for ( uint8_t i = 0; i < LWIP_MAX_SESSIONS; i++ ) {
+        LWIPSession_t *s = &me->sessions[i];
+        if ( 0 == s->port ) {
+            continue;
+        }
+
+        if ( s->rateCurr > s->ratePeak ) {
+            s->ratePeak = s->rateCurr;
+        }
+        s->rateCurr = 0;
+
+        if ( 0 == s->queued &&
+             me->sessionClkMs - s->lastSeenMs >= LWIP_SESSION_IDLE_MS ) {
+            LWIPMgr_sessionEnd( me, i, "timed out" );
+        }
+    }
+}
+
+/* Ethernet msg completion ...................................................*/
+void ETH_msgDone( const DC3MsgRoute_t route, const uint8_t session )
+{
+   /* Only msgs from the TCP sys port and the UDP sessions are counted */
+   if ( _DC3_EthSys != route && _DC3_EthCli != route ) {
+      return;
+   }
+
+   EthMsgDoneEvt *doneEvt = Q_NEW( EthMsgDoneEvt, ETH_MSG_DONE_SIG );
+   doneEvt->route   = route;
+   doneEvt->session = session;
+   QACTIVE_POST( AO_LWIPMgr, (QEvt *)(doneEvt), 0 );
+}
+
+/* Ethernet session stats ....................................................*/
+uint8_t ETH_getSessionCount( void )
+{
+   uint8_t nSessions = 0;
+
+   /* Read from outside the AO.  A session coming or going mid-count is fine. */
+   for ( uint8_t i = 0; i < LWIP_MAX_SESSIONS; i++ ) {
+      if ( 0 != l_LWIPMgr.sessions[i].port ) {
+         nSessions++;
+      }
+   }
+   return( nSessions );
+}
+
+/******************************************************************************/
+uint32_t ETH_getSessionDropCount( void )
+{
+   return( l_LWIPMgr.sessionDrops );
+}
+
+/******************************************************************************/
+uint32_t ETH_getIpAddr( void )
+{
+   /* Still the impossible value LWIPMgr starts with until DHCP (or the static
+    * address) comes through */
+   if ( 0xFFFFFFFF == l_LWIPMgr.ip_addr ) {
+      return( 0 );
+   }
+   return( ntohl( l_LWIPMgr.ip_addr ) );
+}
+
 /* Ethernet UDP message sender .................................................*/
 DC3Error_t ETH_SendUdp(
       const uint8_t* const dataBuf,
@@ -1392,6 +1957,7 @@ DC3Error_t ETH_SendUdp(
    ethEvt->dataLen = dataLen;
    ethEvt->dst = _DC3_NoRoute;
    ethEvt->src = _DC3_EthCli;                  /* UDP only sent from this port */
+   ethEvt->session = ETH_NO_SESSION;       /* Goes to whoever sent the last msg */
 
    /* 3. Directly post to the LWIPMgr AO. */
    QACTIVE_POST(
@@ -1402,6 +1968,54 @@ DC3Error_t ETH_SendUdp(
    return( ERR_NONE );
 }
 
+/* Ethernet UDP push subscription ..............................................*/
+DC3Error_t ETH_subscribeUdpPush(
+      const uint8_t session,
+      const uint16_t port
+)
+{
+   EthPushSubEvt *subEvt = Q_NEW(EthPushSubEvt, ETH_UDP_PUSH_SUB_SIG);
+   subEvt->bEnable = true;
+   subEvt->session = session;
+   subEvt->port = port;
+   QACTIVE_POST( AO_LWIPMgr, (QEvt *)(subEvt), 0 );
+   return( ERR_NONE );
+}
+
+/******************************************************************************/
+DC3Error_t ETH_unsubscribeUdpPush( void )
+{
+   EthPushSubEvt *subEvt = Q_NEW(EthPushSubEvt, ETH_UDP_PUSH_SUB_SIG);
+   subEvt->bEnable = false;
+   subEvt->session = ETH_NO_SESSION;
+   subEvt->port = 0;
+   QACTIVE_POST( AO_LWIPMgr, (QEvt *)(subEvt), 0 );
+   return( ERR_NONE );
+}
+
+/* Ethernet UDP message pusher ................................................*/
+DC3Error_t ETH_pushUdp(
+      const uint8_t* const dataBuf,
+      const uint16_t const dataLen
+)
+{
+   /* Pushes can be dropped so don't take the last events in the pool */
+   LrgDataEvt *ethEvt;
+   Q_NEW_X(ethEvt, LrgDataEvt, 2U, ETH_UDP_PUSH_SIG);
+   if ( NULL == ethEvt ) {
+      return( ERR_MEM_NULL_VALUE );
+   }
+
+   MEMCPY(ethEvt->dataBuf, dataBuf, dataLen);
+   ethEvt->dataLen = dataLen;
+   ethEvt->dst = _DC3_EthCli;
+   ethEvt->src = _DC3_EthCli;
+   ethEvt->session = ETH_NO_SESSION;
+
+   QACTIVE_POST( AO_LWIPMgr, (QEvt *)(ethEvt), 0 );
+   return( ERR_NONE );
+}
+
 /* UDP handler ...............................................................*/
 static void udp_rx_handler(
       void *arg,
@@ -1411,31 +2025,58 @@ static void udp_rx_handler(
       u16_t port
 )
 {
-    /* 1. Construct a new msg event indicating that a msg has been received */
+    LWIPMgr *me = (LWIPMgr *)arg;
+
+    /* 1. Find the session of the client.  The pcb isn't connected to it since
+     * that would keep lwIP from handing it msgs from any other client. */
+    uint8_t session = LWIPMgr_sessionGet( me, addr, port );
+    if ( ETH_NO_SESSION == session ) {
+        me->sessionDrops++;      /* Every session still has msgs in CommMgr */
+        pbuf_free(p);
+        return;
+    }
+
+    LWIPSession_t *s = &me->sessions[session];
+    s->lastSeenMs = me->sessionClkMs;
+    s->nRx++;
+    if ( s->rateCurr < UINT16_MAX ) {
+        s->rateCurr++;
+    }
+    me->lastSession = session;
+
+    if ( s->queued >= LWIP_SESSION_MAX_QUEUED ) {
+        s->nDropped++;
+        me->sessionDrops++;
+        pbuf_free(p);
+        return;
+    }
+
+    /* 2. Construct a new msg event indicating that a msg has been received */
     LrgDataEvt *msgEvt = Q_NEW(LrgDataEvt, CLI_RECEIVED_SIG);
 
-    /* 2. Fill the msg payload and get the msg source and length */
+    /* 3. Fill the msg payload and get the msg source and length */
     MEMCPY(msgEvt->dataBuf, p->payload, p->len);
     msgEvt->dataLen = p->len;
     msgEvt->src = _DC3_EthCli;
     msgEvt->dst = _DC3_EthCli;
+    msgEvt->session = session;
 
 //    DBG_printf("Received %d bytes (%s) on UDP\n", msgEvt->dataLen, msgEvt->dataBuf);
 
-    /* 3.Publish the newly created event */
-//    QF_PUBLISH((QEvent *)msgEvt, AO_LWIPMgr);
-
-    /* 3. Directly post event to CommStackMgr */
+    /* 4. Directly post event to CommStackMgr */
     QACTIVE_POST(
             AO_CommMgr,
             (QEvt *)(msgEvt),
             AO_LWIPMgr
       );
 
-    /* 4. connect to the remote host */
-    udp_connect(upcb, addr, port);
+    /* 5. Held until CommMgr calls ETH_msgDone() for it */
+    s->queued++;
+    if ( s->queued > s->maxQueued ) {
+        s->maxQueued = s->queued;
+    }
 
-    /* 5. Free up the pbuf */
+    /* 6. Free up the pbuf */
     pbuf_free(p);
 }
 /**
@@ -49,6 +49,8 @@
 #include "Shared.h"
 
 /* Exported defines ----------------------------------------------------------*/
+#define LWIP_MAX_SESSIONS       4        /**< Max number of UDP clients at once */
+
 /* Exported macros -----------------------------------------------------------*/
 /* Exported types ------------------------------------------------------------*/
 /*! \enum LWIPMgr Signals
@@ -61,6 +63,9 @@ enum LWIPMgrSignals {
     ETH_TCP_DATA_RECV_SIG,
     TCP_DONE_SIG,
     TCP_TIMEOUT_SIG,
+    ETH_UDP_PUSH_SUB_SIG,
+    ETH_UDP_PUSH_SIG,
+    ETH_MSG_DONE_SIG,
     MAX_PUB_SIG,                                  /* the last published signal */
 };
 
@@ -84,6 +89,41 @@ typedef struct {
 } EthEvt;
 
 
+/**
+ * \struct Event struct type for starting and stopping UDP pushes to a host.
+ */
+/*${Events::EthPushSubEvt} .................................................*/
+typedef struct {
+/* protected: */
+    QEvt super;
+
+    /**< Whether to start or stop pushing. */
+    bool bEnable;
+
+    /**< UDP session of the host to push to. */
+    uint8_t session;
+
+    /**< UDP port of the host to push to.  0 for the port it sent the request from. */
+    uint16_t port;
+} EthPushSubEvt;
+
+
+/**
+ * \struct Event struct type for telling LWIPMgr CommMgr is done with a msg.
+ */
+/*${Events::EthMsgDoneEvt} .................................................*/
+typedef struct {
+/* protected: */
+    QEvt super;
+
+    /**< Where the msg came from. */
+    DC3MsgRoute_t route;
+
+    /**< UDP session the msg came from.  ETH_NO_SESSION if none. */
+    uint8_t session;
+} EthMsgDoneEvt;
+
+
 /* Exported constants --------------------------------------------------------*/
 /* Exported functions --------------------------------------------------------*/
 
@@ -118,6 +158,87 @@ DC3Error_t ETH_SendUdp(
       const uint16_t const dataLen
 );
 
+/**
+ * @brief    Start pushing UDP msgs to a host.
+ * The host is the one behind the UDP session that asked for the pushes.  The
+ * pushes stay with it even if other hosts send msgs to the board later or the
+ * session goes away.  Only one host gets pushes at a time.
+ *
+ * @param [in]  session: UDP session of the host that asked for the pushes.
+ * @param [in]  port: UDP port of the host to push to.  0 for the port the host
+ * sent the request from.
+ *
+ * @return DC3Error_t: status of the request
+ */
+DC3Error_t ETH_subscribeUdpPush(
+      const uint8_t session,
+      const uint16_t port
+);
+
+/**
+ * @brief    Stop pushing UDP msgs.  ETH_pushUdp() drops them after this.
+ *
+ * @param    None
+ * @return DC3Error_t: status of the request
+ */
+DC3Error_t ETH_unsubscribeUdpPush( void );
+
+/**
+ * @brief    Push a UDP msg to the host set by ETH_subscribeUdpPush().
+ * Unlike ETH_SendUdp(), this doesn't go to whoever sent the last msg and it
+ * won't take the last events out of the pool.  Pushes are periodic and a
+ * dropped one is replaced by the next.
+ *
+ * @param [in] *dataBuf: const uint8_t pointer to the buffer of data to push.
+ * @param [in]  dataLen: length of data to push.
+ *
+ * @return DC3Error_t: status of push
+ *    @arg ERR_NONE: msg handed to the LWIPMgr AO.
+ *    @arg ERR_MEM_NULL_VALUE: no event available to carry it.
+ */
+DC3Error_t ETH_pushUdp(
+      const uint8_t* const dataBuf,
+      const uint16_t const dataLen
+);
+
+/**
+ * @brief    Let LWIPMgr know CommMgr is done with a msg it got from it.
+ * LWIPMgr only hands CommMgr a few msgs at a time from the TCP sys port and
+ * from each UDP session so it has to be called once for every one of them.
+ * Msgs from anywhere else are ignored so it's safe to call for any msg.
+ *
+ * @param [in]  route: DC3MsgRoute_t the msg came from.
+ * @param [in]  session: uint8_t UDP session the msg came from.
+ * @return   None
+ */
+void ETH_msgDone( const DC3MsgRoute_t route, const uint8_t session );
+
+/**
+ * @brief    Get the number of UDP sessions currently in the session table.
+ *
+ * @param    None
+ * @return   uint8_t: number of sessions.
+ */
+uint8_t ETH_getSessionCount( void );
+
+/**
+ * @brief    Get the number of UDP msgs dropped because their session had too
+ * many msgs waiting on CommMgr or there was no room for a new session.
+ *
+ * @param    None
+ * @return   uint32_t: number of msgs dropped since boot.
+ */
+uint32_t ETH_getSessionDropCount( void );
+
+/**
+ * @brief    Get the IP address the DC3 currently has.
+ *
+ * @param    None
+ * @return   uint32_t: IP address in host byte order.  0 if the DC3 doesn't have
+ * one yet.
+ */
+uint32_t ETH_getIpAddr( void );
+
 /**
  * @}
  * end addtogroup groupLWIP_QPC_Eth
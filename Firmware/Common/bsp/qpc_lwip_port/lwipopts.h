@@ -457,9 +457,12 @@ The STM32F207 allows computing and verifying the IP, UDP, TCP and ICMP checksums
 // ---------- Statistics options ----------
 //
 //****************************************************************************
-#define LWIP_STATS						      0
+/* The counters are sent out in the health stream (see health.c).  Use 32 bit
+ * counters so they don't wrap every 64K frames. */
+#define LWIP_STATS                        1
+#define LWIP_STATS_LARGE                  1
 //#define LWIP_STATS_DISPLAY              0
-#define LINK_STATS                        0
+#define LINK_STATS                        1
 //#define ETHARP_STATS                    (LWIP_ARP)
 //#define IP_STATS                        1
 //#define IPFRAG_STATS                    (IP_REASSEMBLY || IP_FRAG)
@@ -468,7 +471,7 @@ The STM32F207 allows computing and verifying the IP, UDP, TCP and ICMP checksums
 //#define UDP_STATS                       (LWIP_UDP)
 //#define TCP_STATS                       (LWIP_TCP)
 //#define MEM_STATS           ((MEM_LIBC_MALLOC == 0) && (MEM_USE_POOLS == 0))
-//#define MEMP_STATS                      (MEMP_MEM_MALLOC == 0)
+#define MEMP_STATS                        0  /* Not sent so don't pay for them */
 //#define SYS_STATS                       (NO_SYS == 0)
 
 //****************************************************************************
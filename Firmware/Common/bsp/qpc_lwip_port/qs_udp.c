@@ -0,0 +1,259 @@
+/**
+ * @file    qs_udp.c
+ * @brief   QS software trace output over UDP.
+ *
+ * See qs_udp.h for the description.
+ *
+ * The staging buffers are a ring.  The idle task fills the one at l_qsUdpTail
+ * and marks it ready once it's full, LWIPMgr sends the ready ones starting at
+ * l_qsUdpHead.  The tail only moves on to a buffer that isn't ready so the
+ * order of the stream is kept.  If all of them are waiting to be sent, the
+ * idle task leaves the data in the QS buffer.
+ *
+ * Both sides only change the ring with interrupts disabled.  The copy out of
+ * the QS buffer has to be in there anyway since QS_getBlock() isn't protected
+ * and it's at most QS_UDP_BUF_SIZE bytes.
+ *
+ * @date    10/19/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ *
+ * @addtogroup groupLWIP_QPC_Eth
+ * @{
+ */
+
+#define LWIP_ALLOWED     /* This must be set before the include to allow LWIP */
+
+/* Includes ------------------------------------------------------------------*/
+#include "qs_udp.h"
+#include "lwip.h"                                               /* lwIP stack */
+#include <string.h>
+
+#ifdef Q_SPY
+
+/* Compile-time called macros ------------------------------------------------*/
+Q_DEFINE_THIS_FILE                  /* For QSPY to know the name of this file */
+
+/* Private typedefs ----------------------------------------------------------*/
+
+/**
+ * @brief   A staging buffer.  Holds up to one datagram of the QS stream.
+ */
+typedef struct {
+   volatile uint16_t len;                            /**< Bytes staged so far */
+   volatile bool     bReady;            /**< Full or flushed, waiting to send */
+   uint8_t           data[QS_UDP_BUF_SIZE];                /**< The QS stream */
+} QsUdpBuf_t;
+
+/* Private defines -----------------------------------------------------------*/
+/* Private macros ------------------------------------------------------------*/
+/* Private variables and Local objects ---------------------------------------*/
+static struct udp_pcb *l_qsUdpPcb = NULL;           /**< Pcb hosts connect to */
+static volatile bool   l_qsUdpOn = false;            /**< A host is connected */
+static QsUdpBuf_t      l_qsUdpBufs[QS_UDP_N_BUFS];   /**< Staging buffer ring */
+static volatile uint8_t l_qsUdpHead = 0;             /**< Next buffer to send */
+static volatile uint8_t l_qsUdpTail = 0;          /**< Buffer being filled up */
+
+/* Private function prototypes -----------------------------------------------*/
+
+/**
+ * @brief   Move the tail on to the next buffer unless that one is still
+ * waiting to be sent.  Has to be called with interrupts disabled.
+ * @param   None
+ * @return  None
+ */
+static void QS_UDP_advance( void );
+
+/**
+ * @brief   Drop everything that's staged.
+ * @param   None
+ * @return  None
+ */
+static void QS_UDP_reset( void );
+
+/**
+ * @brief   lwIP callback for datagrams sent to QS_UDP_PORT.  Connects the pcb
+ * to the sender or, for QS_UDP_CMD_STOP, disconnects it.
+ *
+ * @param [in] *arg: void pointer to an argument (unused).
+ * @param [in] *upcb: udp_pcb pointer to the pcb the datagram came in on.
+ * @param [in] *p: pbuf pointer to the datagram.
+ * @param [in] *addr: ip_addr pointer to the address of the sender.
+ * @param [in] port: u16_t port of the sender.
+ * @return  None
+ */
+static void QS_UDP_rxHandler(
+      void *arg,
+      struct udp_pcb *upcb,
+      struct pbuf *p,
+      struct ip_addr *addr,
+      u16_t port
+);
+
+/* Private functions ---------------------------------------------------------*/
+/******************************************************************************/
+static void QS_UDP_advance( void )
+{
+   const uint8_t next = ( l_qsUdpTail + 1 ) % QS_UDP_N_BUFS;
+   if ( !l_qsUdpBufs[next].bReady ) {
+      l_qsUdpTail = next;
+   }
+}
+
+/******************************************************************************/
+static void QS_UDP_reset( void )
+{
+   QF_INT_DISABLE();
+   for ( uint8_t i = 0; i < QS_UDP_N_BUFS; i++ ) {
+      l_qsUdpBufs[i].len    = 0;
+      l_qsUdpBufs[i].bReady = false;
+   }
+   l_qsUdpHead = 0;
+   l_qsUdpTail = 0;
+   QF_INT_ENABLE();
+}
+
+/******************************************************************************/
+static void QS_UDP_rxHandler(
+      void *arg,
+      struct udp_pcb *upcb,
+      struct pbuf *p,
+      struct ip_addr *addr,
+      u16_t port
+)
+{
+   (void)arg;
+   const bool bStop = ( 1 == p->tot_len ) &&
+         ( QS_UDP_CMD_STOP == *(uint8_t *)p->payload );
+   pbuf_free( p );                                  /* don't leak the pbuf! */
+
+   if ( bStop ) {
+      l_qsUdpOn = false;
+      udp_disconnect( upcb );
+      QS_UDP_setFilters( false );
+      QS_UDP_reset();
+   } else {
+      /* A host that's already connected may send again, it just moves the
+       * stream to wherever the last start came from. */
+      udp_connect( upcb, addr, port );
+      if ( !l_qsUdpOn ) {
+         QS_UDP_setFilters( true );
+         l_qsUdpOn = true;
+      }
+   }
+}
+
+/* Public functions ----------------------------------------------------------*/
+/******************************************************************************/
+void QS_UDP_init( void )
+{
+   QS_UDP_reset();
+
+   l_qsUdpPcb = udp_new();
+   Q_ASSERT( NULL != l_qsUdpPcb );
+   udp_bind( l_qsUdpPcb, IP_ADDR_ANY, QS_UDP_PORT );
+   udp_recv( l_qsUdpPcb, &QS_UDP_rxHandler, NULL );
+}
+
+/******************************************************************************/
+void QS_UDP_setFilters( const bool bStreaming )
+{
+   QS_FILTER_OFF(QS_ALL_RECORDS);
+
+   QS_FILTER_ON(QS_SIG_DICT);
+   QS_FILTER_ON(QS_OBJ_DICT);
+   QS_FILTER_ON(QS_FUN_DICT);
+   QS_FILTER_ON(QS_USR_DICT);
+   QS_FILTER_ON(QS_ASSERT_FAIL);
+
+   if ( bStreaming ) {
+      /* State machine steps: when each one started, how it ended, where */
+      QS_FILTER_ON(QS_QEP_INIT_TRAN);
+      QS_FILTER_ON(QS_QEP_DISPATCH);
+      QS_FILTER_ON(QS_QEP_TRAN);
+      QS_FILTER_ON(QS_QEP_INTERN_TRAN);
+      QS_FILTER_ON(QS_QEP_IGNORED);
+
+      /* AO queues: when an event was posted and when the AO got to it */
+      QS_FILTER_ON(QS_QF_ACTIVE_POST_FIFO);
+      QS_FILTER_ON(QS_QF_ACTIVE_POST_LIFO);
+      QS_FILTER_ON(QS_QF_ACTIVE_POST_ATTEMPT);
+      QS_FILTER_ON(QS_QF_ACTIVE_GET);
+      QS_FILTER_ON(QS_QF_ACTIVE_GET_LAST);
+   }
+}
+
+/******************************************************************************/
+void QS_UDP_onIdle( void )
+{
+   if ( !l_qsUdpOn ) {
+      return;                     /* keep the dictionaries for the next host */
+   }
+
+   QF_INT_DISABLE();
+   QsUdpBuf_t *pBuf = &l_qsUdpBufs[l_qsUdpTail];
+   if ( pBuf->bReady ) {       /* couldn't move on when this one filled up */
+      QS_UDP_advance();
+      pBuf = &l_qsUdpBufs[l_qsUdpTail];
+   }
+
+   if ( !pBuf->bReady ) {
+      uint16_t nBytes = QS_UDP_BUF_SIZE - pBuf->len;
+      uint8_t const *pBlock = QS_getBlock( &nBytes );
+      if ( NULL != pBlock ) {
+         memcpy( &pBuf->data[pBuf->len], pBlock, nBytes );
+         pBuf->len += nBytes;
+         if ( QS_UDP_BUF_SIZE == pBuf->len ) {
+            pBuf->bReady = true;
+            QS_UDP_advance();
+         }
+      }
+   }
+   QF_INT_ENABLE();
+}
+
+/******************************************************************************/
+void QS_UDP_flush( void )
+{
+   if ( !l_qsUdpOn ) {
+      return;
+   }
+
+   /* Send what's been staged so far too so a quiet trace still shows up */
+   QF_INT_DISABLE();
+   QsUdpBuf_t *pTail = &l_qsUdpBufs[l_qsUdpTail];
+   if ( !pTail->bReady && 0 != pTail->len ) {
+      pTail->bReady = true;
+      QS_UDP_advance();
+   }
+   QF_INT_ENABLE();
+
+   /* Ready buffers aren't touched by the idle task so no need to lock them */
+   while ( l_qsUdpBufs[l_qsUdpHead].bReady ) {
+      QsUdpBuf_t *pBuf = &l_qsUdpBufs[l_qsUdpHead];
+      struct pbuf *p = pbuf_new( pBuf->data, pBuf->len );
+      if ( p == (struct pbuf *)0 ) {
+         break;                     /* out of lwIP memory, retry next tick */
+      }
+      udp_send( l_qsUdpPcb, p );
+      pbuf_free( p );                               /* don't leak the pbuf! */
+
+      QF_INT_DISABLE();
+      pBuf->len    = 0;
+      pBuf->bReady = false;
+      if ( l_qsUdpHead != l_qsUdpTail ) {  /* else the idle task refills it */
+         l_qsUdpHead = ( l_qsUdpHead + 1 ) % QS_UDP_N_BUFS;
+      }
+      QF_INT_ENABLE();
+   }
+}
+
+#endif                                                               /* Q_SPY */
+
+/**
+ * @}
+ * end addtogroup groupLWIP_QPC_Eth
+ */
+
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
@@ -0,0 +1,110 @@
+/**
+ * @file    qs_udp.h
+ * @brief   QS software trace output over UDP.
+ *
+ * The idle task drains the QS buffer into a few staging buffers and LWIPMgr
+ * sends whatever is staged on every LWIP_SLOW_TICK, one datagram per buffer.
+ * The idle task never touches lwIP (it isn't reentrant) and LWIPMgr never
+ * touches the QS buffer, so the trace only costs idle time and a udp_send()
+ * per datagram.
+ *
+ * A host starts the stream by sending any datagram to QS_UDP_PORT and stops it
+ * by sending a single QS_UDP_CMD_STOP byte.  The datagrams are the raw (HDLC
+ * framed) QS stream so they can be written to disk as they come.  A lost
+ * datagram shows up as a gap in the QS record sequence numbers.
+ *
+ * While no host is connected only the dictionaries and failed asserts are
+ * traced.  The dictionaries wait in the QS buffer for the first host and
+ * nothing else gets recorded while nobody's listening.
+ *
+ * Timestamps are the low 32 bits of TIME_getTimestamp() (us).
+ *
+ * @note: only exists in Q_SPY builds.
+ *
+ * @date    10/19/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ *
+ * @addtogroup groupLWIP_QPC_Eth
+ * @{
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef QS_UDP_H_
+#define QS_UDP_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "qp_port.h"                                        /* for QP support */
+#include <stdbool.h>
+
+/* Exported defines ----------------------------------------------------------*/
+#define QS_UDP_PORT             1503       /**< Port the board takes hosts on */
+#define QS_UDP_CMD_STOP         0x00         /**< Datagram to stop the stream */
+#define QS_UDP_BUF_SIZE         512            /**< Max bytes in one datagram */
+#define QS_UDP_N_BUFS           4          /**< Staging buffers between sends */
+
+/* Exported types ------------------------------------------------------------*/
+/* Exported macros -----------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+#ifdef Q_SPY
+
+/**
+ * @brief   Open the UDP port hosts connect to.
+ *
+ * Has to be called by LWIPMgr after lwIP is up.
+ *
+ * @param   None
+ * @return: None
+ */
+void QS_UDP_init( void );
+
+/**
+ * @brief   Set the QS global filter.
+ *
+ * @param [in] bStreaming: const bool true to trace the records the collector
+ * needs (state machine steps and AO queue posts and gets), false to only keep
+ * the dictionaries and asserts.
+ * @return: None
+ */
+void QS_UDP_setFilters( const bool bStreaming );
+
+/**
+ * @brief   Move a block of the QS buffer into the staging buffers.
+ *
+ * Called from the idle hook.  Does nothing while no host is connected.
+ *
+ * @param   None
+ * @return: None
+ */
+void QS_UDP_onIdle( void );
+
+/**
+ * @brief   Send everything that's staged to the connected host.
+ *
+ * Called by LWIPMgr on every LWIP_SLOW_TICK.  A buffer that can't get a pbuf
+ * stays staged until the next tick.
+ *
+ * @param   None
+ * @return: None
+ */
+void QS_UDP_flush( void );
+
+#endif                                                               /* Q_SPY */
+
+/**
+ * @}
+ * end addtogroup groupLWIP_QPC_Eth
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif                                                           /* QS_UDP_H_ */
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
@@ -38,6 +38,7 @@
 #include "project_includes.h"         /* Includes common to entire project. */
 #include "bsp.h"        /* For seconds to bsp tick conversion (SEC_TO_TICK) */
 #include "serial.h"                           /* For low level serial support */
+#include "mem_stats.h"                    /* For pool and queue usage records */
 
 /* Compile-time called macros ------------------------------------------------*/
 Q_DEFINE_THIS_FILE;                 /* For QSPY to know the name of this file */
@@ -139,6 +140,7 @@ void SerialMgr_ctor(void) {
         (QEvt const **)( me->deferredEvtQSto ),
         Q_DIM(me->deferredEvtQSto)
     );
+    MEM_STATS_regQueue( &me->deferredEvtQueue, "SerialMgrDefer" );
 }
 
 /**
@@ -310,6 +312,7 @@ static QState SerialMgr_Busy(SerialMgr * const me, QEvt const * const e) {
         }
         /* ${AOs::SerialMgr::SM::Active::Busy::UART_DMA_TIMEOUT} */
         case UART_DMA_TIMEOUT_SIG: {
+            Serial_countTxDrop( SERIAL_UART1 );
             err_slow_printf("UART DMA timeout occurred\n");
             status_ = Q_TRAN(&SerialMgr_Idle);
             break;
@@ -325,6 +328,7 @@ static QState SerialMgr_Busy(SerialMgr * const me, QEvt const * const e) {
                QActive_defer((QActive *)me, &me->deferredEvtQueue, e);
             } else {
                /* notify the request sender that the request was ignored.. */
+               Serial_countTxDrop( SERIAL_UART1 );
                err_slow_printf("Unable to defer UART_DMA_START request\n");
             }
             status_ = Q_HANDLED();
@@ -85,6 +85,10 @@ static USART_Settings_t a_UARTSettings[SERIAL_MAX] =
             0,                         /**< indexTX */
             &Uart1RxBuffer[0],         /**< *bufferTX */
             0,                         /**< indexRX */
+
+            /* Health counters */
+            0,                         /**< nRxDrops */
+            0,                         /**< nTxDrops */
       }
 };
 
@@ -269,6 +273,7 @@ DC3Error_t Serial_sendBase64Enc(
    );
 
    if(encDataLen < 1) {
+      a_UARTSettings[ serPort ].nTxDrops++;
       err_slow_printf("Encoding failed\n");
       return ERR_SERIAL_MSG_BASE64_ENC_FAILED;
    }
@@ -286,6 +291,7 @@ DC3Error_t Serial_sendRaw(
 )
 {
    if ( dataLen >= DC3_MAX_MSG_LEN ) {                     /* Check the length */
+      a_UARTSettings[ serPort ].nTxDrops++;
       return ERR_SERIAL_MSG_TOO_LONG;
    }
 
@@ -333,6 +339,24 @@ DC3Error_t Serial_sendRaw(
    return ERR_NONE;
 }
 
+/******************************************************************************/
+void Serial_countTxDrop( const SerialPort_T serPort )
+{
+   a_UARTSettings[ serPort ].nTxDrops++;
+}
+
+/******************************************************************************/
+uint32_t Serial_getRxDropCount( const SerialPort_T serPort )
+{
+   return( a_UARTSettings[ serPort ].nRxDrops );
+}
+
+/******************************************************************************/
+uint32_t Serial_getTxDropCount( const SerialPort_T serPort )
+{
+   return( a_UARTSettings[ serPort ].nTxDrops );
+}
+
 /******************************************************************************/
 /***                      Callback functions for Serial/UART                ***/
 /******************************************************************************/
@@ -410,6 +434,7 @@ inline void Serial_UART1Callback(void)
                   DC3_MAX_MSG_LEN
             );
             a_UARTSettings[SERIAL_UART1].indexRX = 0;       /* Reset the RX buffer */
+            a_UARTSettings[SERIAL_UART1].nRxDrops++;
          } else {
             /* If any other data is recieved, add it to the buffer */
             a_UARTSettings[SERIAL_UART1].bufferRX[ a_UARTSettings[SERIAL_UART1].indexRX++ ] = data;
@@ -64,6 +64,10 @@ typedef struct USART_Settings
     uint16_t            indexTX;   /**< Serial port in data buffer used length. */
     char                *bufferRX;             /**< Serial port in data buffer. */
     uint16_t            indexRX;   /**< Serial port in data buffer used length. */
+
+    /* Health counters */
+    uint32_t            nRxDrops;         /**< Msgs dropped on RX (too long) */
+    uint32_t            nTxDrops;              /**< Msgs that never went out */
 } USART_Settings_t;
 
 /**
@@ -186,6 +190,35 @@ DC3Error_t Serial_sendRaw(
       const DevAccess_t devAcc
 );
 
+/**
+ * @brief   Count a msg that never made it out of the serial port.
+ *
+ * Serial_sendRaw() and Serial_sendBase64Enc() count their own failures.  This
+ * is for the ones that get dropped later, after they were handed off to the
+ * SerialMgr AO (no room to defer them or a DMA timeout).
+ *
+ * @param [in]  serPort: a USART_Port type that specifies the serial port
+ * @return: None
+ */
+void Serial_countTxDrop( const SerialPort_T serPort );
+
+/**
+ * @brief   Get the number of msgs dropped on RX since boot.
+ *
+ * @param [in]  serPort: a USART_Port type that specifies the serial port
+ * @return  uint32_t: msgs thrown out for being longer than DC3_MAX_MSG_LEN.
+ */
+uint32_t Serial_getRxDropCount( const SerialPort_T serPort );
+
+/**
+ * @brief   Get the number of msgs dropped on TX since boot.
+ *
+ * @param [in]  serPort: a USART_Port type that specifies the serial port
+ * @return  uint32_t: msgs that were too long, failed to encode, couldn't be
+ * queued up by the SerialMgr AO, or timed out in the DMA.
+ */
+uint32_t Serial_getTxDropCount( const SerialPort_T serPort );
+
 /**
  * @brief   Serial DMA send callback function
  *
@@ -30,7 +30,33 @@ DBG_DEFINE_THIS_MODULE( DC3_DBG_MODL_TIME ); /* For debug system to ID this modu
 
 /* Private typedefs ----------------------------------------------------------*/
 /* Private defines -----------------------------------------------------------*/
+#define TIME_SECS_PER_DAY       86400U        /**< RTC wraps back to 00:00:00 */
+
+/**
+ * @brief   How long past a full second TIME_fromTimestamp() waits for the RTC
+ * to tick over before it stops waiting and counts the seconds itself.  The
+ * LSI is good to a few ms a second once calibrated and the tick is 1 ms. Past
+ * this, nothing is calling TIME_onTick() yet (like before the scheduler
+ * starts).
+ */
+#define TIME_ANCHOR_SLACK_US    50000U
+
 /* Private macros ------------------------------------------------------------*/
+
+/**
+ * @brief   Two BCD digits (like in the RTC registers) to binary.
+ */
+#define TIME_BCD2BIN( bcd_ )    ( ((bcd_) >> 4) * 10 + ((bcd_) & 0x0F) )
+
+/**
+ * @brief   Critical section around the timestamp state.  It's just a few
+ * instructions so it masks everything, which lets timestamps be taken from any
+ * ISR.
+ */
+#define TIME_CRIT_ENTRY( primask_ )  do { primask_ = __get_PRIMASK();         \
+                                          __disable_irq(); } while (0)
+#define TIME_CRIT_EXIT( primask_ )   __set_PRIMASK( primask_ )
+
 /* Private variables and Local objects ---------------------------------------*/
 RTC_InitTypeDef RTC_InitStructure;   /**< Init structure for RTC, must be accessible by local functions to get the synch prediv used to set up RTC */
 
@@ -38,6 +64,12 @@ __IO uint32_t   uwLsiFreq = 0;       /**< Measured LSI frequency */
 __IO uint32_t   uwCaptureNumber = 0; /**< Counter to keep track of captures on TIM5 used to measure LSI frequency, shared with ISR. */
 __IO uint32_t   uwPeriodValue = 0;   /**< Calculated period value of LSI output, shared with ISR. */
 
+static uint32_t l_timeHigh = 0;                /**< Upper 32 bits of the time */
+static uint32_t l_timeLast = 0;                /**< TIM2 count when last read */
+static uint64_t l_timeAnchorTs = 0;      /**< Timestamp when RTC secs changed */
+static uint32_t l_timeAnchorSecs = 0;        /**< RTC seconds of the day then */
+static uint32_t l_timeRtcSecs = 0;     /**< RTC seconds seen by TIME_onTick() */
+
 /* Private function prototypes -----------------------------------------------*/
 /**
  * @brief  Configures TIM5 to measure the LSI oscillator frequency.
@@ -55,6 +87,28 @@ __IO uint32_t   uwPeriodValue = 0;   /**< Calculated period value of LSI output,
  */
 static uint32_t TIME_getLSIFrequency( void );
 
+/**
+ * @brief  Get the clock of the timers on APB1 (TIM2 to TIM7, TIM12 to TIM14).
+ * @param  None
+ * @retval Clock frequency of the timers in Hz.
+ */
+static uint32_t TIME_getAPB1TimerClk( void );
+
+/**
+ * @brief  Start TIM2 counting at TIME_TS_HZ.
+ * @note 1: This function should only be called by the TIME_Init() function.
+ * @param  None
+ * @retval None
+ */
+static void TIME_initTimestamp( void );
+
+/**
+ * @brief  Read the seconds of the day from the RTC.
+ * @param  None
+ * @retval Seconds since 00:00:00.
+ */
+static uint32_t TIME_getRtcSecs( void );
+
 /* Private functions ---------------------------------------------------------*/
 
 /******************************************************************************/
@@ -137,6 +191,62 @@ void TIME_Init( void )
 
    /* Enable the subsecond timer */
 //   TIME_subSecondTimer_Init();
+
+   /* The RTC second just started since setting the time resets its
+    * prescalers so this is as good an anchor as any until the first tick. */
+   TIME_initTimestamp();
+   l_timeRtcSecs    = TIME_getRtcSecs();
+   l_timeAnchorSecs = l_timeRtcSecs;
+   l_timeAnchorTs   = TIME_getTimestamp();
+}
+
+/******************************************************************************/
+static uint32_t TIME_getAPB1TimerClk( void )
+{
+   RCC_ClocksTypeDef  RCC_ClockFreq;
+   RCC_GetClocksFreq(&RCC_ClockFreq);
+
+   /* Get PCLK1 prescaler */
+   if (0 == (RCC->CFGR & RCC_CFGR_PPRE1) ) {
+      /* PCLK1 prescaler equal to 1 => TIMCLK = PCLK1 */
+      return ( RCC_ClockFreq.PCLK1_Frequency );
+   } else {
+      /* PCLK1 prescaler different from 1 => TIMCLK = 2 * PCLK1 */
+      return ( 2 * RCC_ClockFreq.PCLK1_Frequency );
+   }
+}
+
+/******************************************************************************/
+static void TIME_initTimestamp( void )
+{
+   RCC_APB1PeriphClockCmd( RCC_APB1Periph_TIM2, ENABLE );
+
+   /* TIM2 is 32 bits wide.  Count up at TIME_TS_HZ through the whole range
+    * without any interrupts.  Overflows are caught in software. */
+   TIM_TimeBaseInitTypeDef TIM_TimeBaseStructure;
+   TIM_TimeBaseStructInit( &TIM_TimeBaseStructure );
+   TIM_TimeBaseStructure.TIM_Prescaler     =
+         TIME_getAPB1TimerClk() / TIME_TS_HZ - 1;
+   TIM_TimeBaseStructure.TIM_Period        = 0xFFFFFFFF;
+   TIM_TimeBaseStructure.TIM_ClockDivision = TIM_CKD_DIV1;
+   TIM_TimeBaseStructure.TIM_CounterMode   = TIM_CounterMode_Up;
+   TIM_TimeBaseInit( TIM2, &TIM_TimeBaseStructure );
+
+   TIM_Cmd( TIM2, ENABLE );
+}
+
+/******************************************************************************/
+static uint32_t TIME_getRtcSecs( void )
+{
+   /* Read the register directly instead of through RTC_GetTime() since this
+    * runs on every tick.  Reading TR freezes DR until it's read too. */
+   const uint32_t tr = RTC->TR;
+   (void)RTC->DR;
+
+   const uint32_t hours = TIME_BCD2BIN( (tr & (RTC_TR_HT | RTC_TR_HU)) >> 16 );
+   const uint32_t mins  = TIME_BCD2BIN( (tr & (RTC_TR_MNT | RTC_TR_MNU)) >> 8 );
+   const uint32_t secs  = TIME_BCD2BIN( tr & (RTC_TR_ST | RTC_TR_SU) );
+   return ( hours * 3600 + mins * 60 + secs );
 }
 
 /******************************************************************************/
@@ -187,54 +297,83 @@ static uint32_t TIME_getLSIFrequency( void )
     * It is not used again after this by the TIME module. */
    TIM_DeInit( TIM5 );
 
-   /* Compute the LSI frequency, depending on TIM5 input clock frequency (PCLK1)*/
-   /* Get SYSCLK, HCLK and PCLKx frequency */
-   RCC_ClocksTypeDef  RCC_ClockFreq;
-   RCC_GetClocksFreq(&RCC_ClockFreq);
-
-   /* Get PCLK1 prescaler */
-   if (0 == (RCC->CFGR & RCC_CFGR_PPRE1) ) {
-      /* PCLK1 prescaler equal to 1 => TIMCLK = PCLK1 */
-      return ((RCC_ClockFreq.PCLK1_Frequency / uwPeriodValue) * 8);
-   } else {
-      /* PCLK1 prescaler different from 1 => TIMCLK = 2 * PCLK1 */
-      return (((2 * RCC_ClockFreq.PCLK1_Frequency) / uwPeriodValue) * 8) ;
-   }
+   /* Compute the LSI frequency, depending on TIM5 input clock frequency */
+   return ((TIME_getAPB1TimerClk() / uwPeriodValue) * 8);
 }
 
 /******************************************************************************/
 stm32Time_t TIME_getTime( void )
 {
-   stm32Time_t time;
-   RTC_TimeTypeDef RTC_TimeStructure;
+   return ( TIME_fromTimestamp( TIME_getTimestamp() ) );
+}
 
-   /* Get the current Time and Date */
-   RTC_GetTime(RTC_Format_BIN, &RTC_TimeStructure);
+/******************************************************************************/
+uint64_t TIME_getTimestamp( void )
+{
+   uint32_t primask;
+   TIME_CRIT_ENTRY( primask );
+   const uint32_t now = TIM2->CNT;
+   if ( now < l_timeLast ) {
+      l_timeHigh++;                                  /* TIM2 wrapped around */
+   }
+   l_timeLast = now;
+   const uint64_t timestamp = ((uint64_t)l_timeHigh << 32) | now;
+   TIME_CRIT_EXIT( primask );
 
-   /* Unfreeze the RTC DR Register.  Why this isn't done by the STM32 library
-    * for this function but IS for the RTC_GetSubSecond(), I'll never know.
-    * Also, this register is automatically "refrozen" as soon as your read it */
-   (void)RTC->DR;
+   return ( timestamp );
+}
 
-   /* Hours, minutes, and seconds are stored in the exact same format as in the
-    * structure so we can use direct assignment. */
-   time.hour_min_sec = RTC_TimeStructure;
-
-   /* Sub-second depends on the frequency used by the clock and the fracSec
-    * holds the down-counted timer, which then needs to be normalized using the
-    * synch frequency prediv scalar.  The formula for this is:
-    *
-    * Second fraction = ( PREDIV_S - SS ) / ( PREDIV_S + 1 )
-    */
-   uint32_t fracSec = RTC_GetSubSecond();
-   time.sub_sec = (uint32_t)( 1000 * (
-         (float)(RTC_InitStructure.RTC_SynchPrediv  - fracSec) /
-         (float)(RTC_InitStructure.RTC_SynchPrediv + 1))
-   );
+/******************************************************************************/
+stm32Time_t TIME_fromTimestamp( const uint64_t timestamp )
+{
+   stm32Time_t time;
+   uint32_t primask;
+
+   TIME_CRIT_ENTRY( primask );
+   const uint64_t anchorTs   = l_timeAnchorTs;
+   uint32_t       secs       = l_timeAnchorSecs;
+   TIME_CRIT_EXIT( primask );
+
+   const uint64_t delta = ( timestamp > anchorTs ) ? timestamp - anchorTs : 0;
+   if ( delta < TIME_TS_HZ ) {
+      time.sub_us = (uint32_t)delta;
+   } else if ( delta < TIME_TS_HZ + TIME_ANCHOR_SLACK_US ) {
+      /* The RTC is about to tick over.  Don't get ahead of it or the time will
+       * jump back once it does. */
+      time.sub_us = TIME_TS_HZ - 1;
+   } else {
+      /* No one is keeping the anchor up to date so count the seconds here */
+      secs       += (uint32_t)( delta / TIME_TS_HZ );
+      time.sub_us = (uint32_t)( delta % TIME_TS_HZ );
+   }
+   secs %= TIME_SECS_PER_DAY;
+
+   time.hour_min_sec.RTC_Hours   = (uint8_t)( secs / 3600 );
+   time.hour_min_sec.RTC_Minutes = (uint8_t)( (secs / 60) % 60 );
+   time.hour_min_sec.RTC_Seconds = (uint8_t)( secs % 60 );
+   time.hour_min_sec.RTC_H12     = RTC_H12_AM;
+   time.sub_sec                  = time.sub_us / 1000;
 
    return (time);
 }
 
+/******************************************************************************/
+void TIME_onTick( void )
+{
+   /* Reading the timestamp every tick is also what catches TIM2 wrapping */
+   const uint64_t now  = TIME_getTimestamp();
+   const uint32_t secs = TIME_getRtcSecs();
+
+   if ( secs != l_timeRtcSecs ) {
+      uint32_t primask;
+      TIME_CRIT_ENTRY( primask );
+      l_timeAnchorTs   = now;
+      l_timeAnchorSecs = secs;
+      TIME_CRIT_EXIT( primask );
+      l_timeRtcSecs    = secs;
+   }
+}
+
 /**
  * @}
  * end addtogroup groupTime
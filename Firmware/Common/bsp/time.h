@@ -18,6 +18,18 @@
  * This module also calibrates the prescalar to the RTC by measuring the RTC
  * clock frequency and adjusting for any drift.  TIM5 is used for this and is
  * disabled immediately after so it could be used later if desired.
+ *
+ * Timestamps come from TIM2, a 32 bit timer free-running at 1 MHz, which is
+ * extended to 64 bits in software.  Reading one is a register read, unlike
+ * reading the RTC which goes through its shadow registers and only has the
+ * resolution of its synchronous prescaler (~4 ms off the LSI).  The DWT cycle
+ * counter isn't used since it stops while the core sleeps in the idle hook.
+ *
+ * Timestamps are tied to the RTC once a second by TIME_onTick(), which notes
+ * the timestamp at which the RTC seconds changed.  TIME_getTime() and
+ * TIME_fromTimestamp() then turn a timestamp into wall clock time with a bit of
+ * math instead of reading the RTC, so code that needs a time (logging,
+ * profiling, tracing) can just grab a timestamp and convert it later, if ever.
  */
 
 /* Define to prevent recursive inclusion -------------------------------------*/
@@ -28,6 +40,8 @@
 #include "stm32f4xx.h"                                 /* For STM32F4 support */
 
 /* Exported defines ----------------------------------------------------------*/
+#define TIME_TS_HZ              1000000U           /**< Timestamps are in us */
+
 /* Exported macros -----------------------------------------------------------*/
 /* Exported types ------------------------------------------------------------*/
 
@@ -40,6 +54,7 @@ typedef struct
 {
    RTC_TimeTypeDef   hour_min_sec;   /**< STM32 Time struct with h, m, and s. */
    uint32_t          sub_sec;    /**< uint32_t subsecond timer from 0 - 1000. */
+   uint32_t          sub_us;     /**< uint32_t microseconds from 0 - 999999. */
 }stm32Time_t;
 
 /* Exported constants --------------------------------------------------------*/
@@ -50,7 +65,7 @@ typedef struct
  * This function:
  *   -# initializes the RTC.
  *   -# calibrates the RTC using TIM5 to account for clock drift.
- *   -# initializes a subsecond timer using TIM7.
+ *   -# starts the timestamp timer (TIM2) and ties it to the RTC.
  *
  * @note 1: This function should be called only once and only in the beginning.
  *
@@ -61,11 +76,51 @@ void TIME_Init( void );
 
 /**
  * @brief   Return a structure containing the current time.
+ *
+ * Same as TIME_fromTimestamp( TIME_getTimestamp() ).
+ *
  * @param  None
  * @return time: a time_T structure containing the current time.
  */
 stm32Time_t TIME_getTime( void );
 
+/**
+ * @brief   Get a timestamp.
+ *
+ * Safe to call from any context, including ISRs above the kernel's interrupt
+ * mask.
+ *
+ * @param  None
+ * @return uint64_t: microseconds (TIME_TS_HZ) since TIME_Init().  Doesn't wrap.
+ */
+uint64_t TIME_getTimestamp( void );
+
+/**
+ * @brief   Turn a timestamp into wall clock time.
+ *
+ * Uses the last time TIME_onTick() saw the RTC seconds change.  The seconds
+ * always match the RTC, which is why the sub-second part stops just short of
+ * the next second if the RTC is a little late getting there.
+ *
+ * @param [in] timestamp: const uint64_t timestamp from TIME_getTimestamp().
+ * It should be from after the last second started or the sub-second part is
+ * 0.
+ * @return time: a time_T structure containing the time of the timestamp.
+ */
+stm32Time_t TIME_fromTimestamp( const uint64_t timestamp );
+
+/**
+ * @brief   Tie the timestamps to the RTC.
+ *
+ * Has to be called from the system tick.  Every call reads the RTC seconds
+ * and, when they change, notes the current timestamp.  It also keeps the
+ * 32 bit timer from wrapping (every ~71 minutes) without being noticed.
+ *
+ * @param  None
+ * @return None
+ */
+void TIME_onTick( void );
+
 /**
  * @}
  * end addtogroup groupTime
@@ -29,7 +29,7 @@
  * @email   rost0031@gmail.com
  * Copyright (C) 2015 Harry Rostovtsev. All rights reserved.
  *
- * @addtogroup groupBsp
+ * @addtogroup groupSys
  * @{
  */
 
@@ -41,6 +41,7 @@
 #include "CommMgr.h"
 #include "crc32compat.h"
 #include "sdram.h"
+#include "lzss.h"
 
 /* Compile-time called macros ------------------------------------------------*/
 Q_DEFINE_THIS_FILE;                 /* For QSPY to know the name of this file */
@@ -90,17 +91,35 @@ typedef struct {
     /**< Index into the flashSectorsToErase array for when we are erasing flash */
     uint8_t flashSectorsToEraseIndex;
 
+    /**< Set if a FW upgrade was aborted and can be resumed */
+    bool fwResumeValid;
+
+    /**< Metadata of the FW image of the aborted FW upgrade */
+    struct DC3FlashMetaPayloadMsg fwResumeMetadata;
+
+    /**< Highest contiguous FW data packet written before the FW upgrade was aborted */
+    uint16_t fwResumePacket;
+
+    /**< Flash address where the packet after fwResumePacket goes */
+    uint32_t fwResumeAddr;
+
+    /**< How many sectors in flashSectorsToErase were already erased before the abort */
+    uint8_t fwResumeErasedNum;
+
     /**< Used for timing out the entire FW upgrade process in FlashMgr object. */
     QTimeEvt flashTimerEvt;
 
     /**< Used for timing out individual operations on flash in FlashMgr object. */
     QTimeEvt flashOpTimerEvt;
 
-    /**< Buffer with FW data to flash */
-    uint8_t fwDataToFlash[112];
+    /**< Buffer with FW data to flash.  Big enough for a decoded LZSS block */
+    uint8_t fwDataToFlash[LZSS_MAX_BLOCK_DECODED_LEN];
 
     /**< Length of data in fwDataToFlash buffer */
-    uint8_t fwDataToFlashLen;
+    uint16_t fwDataToFlashLen;
+
+    /**< Flash address where the FW image starts */
+    uint32_t fwImageStartAddr;
 
     /**< Used for timing out the Ram test in case it gets stuck for some reason. */
     QTimeEvt ramTimerEvt;
@@ -285,17 +304,20 @@ static QState FlashMgr_initial(FlashMgr * const me, QEvt const * const e) {
     /* ${AOs::FlashMgr::SM::initial} */
     (void)e;        /* suppress the compiler warning about unused parameter */
 
-    QS_OBJ_DICTIONARY(&l_CommMgr);
+    QS_OBJ_DICTIONARY(&l_FlashMgr);
     QS_FUN_DICTIONARY(&QHsm_top);
-    QS_FUN_DICTIONARY(&CommMgr_initial);
-    QS_FUN_DICTIONARY(&CommMgr_Active);
-
-    QS_FUN_DICTIONARY(&CommMgr_Idle);
-    QS_FUN_DICTIONARY(&CommMgr_Busy);
-    QS_FUN_DICTIONARY(&CommMgr_PrepFlash);
-    QS_FUN_DICTIONARY(&CommMgr_WaitingForFWData);
-    QS_FUN_DICTIONARY(&CommMgr_WritingFlash);
-    QS_FUN_DICTIONARY(&CommMgr_FinalizingFlash);
+    QS_FUN_DICTIONARY(&FlashMgr_initial);
+    QS_FUN_DICTIONARY(&FlashMgr_Active);
+    QS_FUN_DICTIONARY(&FlashMgr_Idle);
+    QS_FUN_DICTIONARY(&FlashMgr_BusyFlash);
+    QS_FUN_DICTIONARY(&FlashMgr_PrepFlash);
+    QS_FUN_DICTIONARY(&FlashMgr_ErasingSector);
+    QS_FUN_DICTIONARY(&FlashMgr_WaitingForFWData);
+    QS_FUN_DICTIONARY(&FlashMgr_WritingFlash);
+    QS_FUN_DICTIONARY(&FlashMgr_BusyRam);
+    QS_FUN_DICTIONARY(&FlashMgr_AddrBusTest);
+    QS_FUN_DICTIONARY(&FlashMgr_DeviceTest);
+    QS_FUN_DICTIONARY(&FlashMgr_DataBusTest);
 
     QActive_subscribe((QActive *)me, FLASH_OP_START_SIG);
     QActive_subscribe((QActive *)me, FLASH_DATA_SIG);
@@ -392,6 +414,8 @@ static QState FlashMgr_Idle(FlashMgr * const me, QEvt const * const e) {
             me->fwFlashMetadata._imageSize = ((FWMetaEvt const *)e)->imageSize;
             me->fwFlashMetadata._imageType = ((FWMetaEvt const *)e)->imageType;
             me->fwFlashMetadata._imageNumPackets = ((FWMetaEvt const *)e)->imageNumPackets;
+            me->fwFlashMetadata._imageSectorMask = ((FWMetaEvt const *)e)->imageSectorMask;
+            me->fwFlashMetadata._imageCompression = ((FWMetaEvt const *)e)->imageCompression;
             me->fwFlashMetadata._imageDatetime_len = ((FWMetaEvt const *)e)->imageDatetimeLen;
             MEMCPY(
                 me->fwFlashMetadata._imageDatetime,
@@ -458,9 +482,23 @@ static QState FlashMgr_BusyFlash(FlashMgr * const me, QEvt const * const e) {
 
             FLASH_Lock();     /* Always lock the flash on exit */
 
+            /* If the FW upgrade got aborted while erasing or receiving data, remember how far it got so
+             * that another attempt with the same image can pick up from there instead of erasing and
+             * sending everything again. */
+            if (ERR_NONE != me->errorCode && 0 != me->fwPacketExp && me->fwPacketCurr < me->fwPacketExp) {
+                MEMCPY(&me->fwResumeMetadata, &me->fwFlashMetadata, sizeof(me->fwResumeMetadata));
+                me->fwResumePacket    = me->fwPacketCurr;
+                me->fwResumeAddr      = me->flashAddrCurr;
+                me->fwResumeErasedNum = me->flashSectorsToEraseIndex;
+                me->fwResumeValid     = true;
+                LOG_printf("FW upgrade aborted after packet %d of %d, it can be resumed\n",
+                    me->fwResumePacket, me->fwPacketExp);
+            }
+
             /* Always send a flash status event to the CommMgr AO with the current error code */
             FlashStatusEvt *evt = Q_NEW(FlashStatusEvt, FLASH_OP_DONE_SIG);
             evt->errorCode = me->errorCode;
+            evt->seqCurr   = me->fwPacketCurr;
             QACTIVE_POST(AO_CommMgr, (QEvt *)(evt), AO_FlashMgr);
             status_ = Q_HANDLED();
             break;
@@ -522,6 +560,8 @@ static QState FlashMgr_PrepFlash(FlashMgr * const me, QEvt const * const e) {
             LOG_printf("Type: %d\n", me->fwFlashMetadata._imageType);
             LOG_printf("Datetime: %s\n", me->fwFlashMetadata._imageDatetime);
             LOG_printf("Number of packets: %d\n", me->fwFlashMetadata._imageNumPackets);
+            LOG_printf("Sector mask: 0x%08x\n", me->fwFlashMetadata._imageSectorMask);
+            LOG_printf("Compression: %d\n", me->fwFlashMetadata._imageCompression);
 
             /* Do some sanity checking on the FW image metadata */
             me->errorCode = FLASH_validateMetadata(&(me->fwFlashMetadata));
@@ -539,7 +579,37 @@ static QState FlashMgr_PrepFlash(FlashMgr * const me, QEvt const * const e) {
 
                 /* Set the start address which will get used later when the fw packets start coming in*/
                 if (me->fwFlashMetadata._imageType == _DC3_Application ) {
+                #if CPLR_APP
+                    /* The Application is running from the active slot so the image goes into the
+                     * staged slot and gets installed by the Bootloader on the next reboot */
+                    me->errorCode = FLASH_getStagedSectorsToErase(
+                        me->flashSectorsToErase,
+                        &(me->flashSectorsToEraseNum),
+                        ADDR_FLASH_SECTORS,
+                        me->fwFlashMetadata._imageSize
+                    );
+                    me->flashAddrCurr = FLASH_SLOT_STAGED_START_ADDR;
+
+                    /* The staged slot gets installed on its own so it always has to be written in full */
+                    if (ERR_NONE == me->errorCode && 0 != me->fwFlashMetadata._imageSectorMask) {
+                        me->errorCode = ERR_FLASH_SECTOR_MASK_INVALID;
+                        ERR_printf("Partial FW updates are only supported by the Bootloader. Error: 0x%08x\n", me->errorCode);
+                    }
+                #elif CPLR_BOOT
+                    /* For a partial FW update, only erase the image sectors that are getting rewritten */
+                    if (ERR_NONE == me->errorCode) {
+                        me->errorCode = FLASH_applySectorMask(
+                            me->flashSectorsToErase,
+                            &(me->flashSectorsToEraseNum),
+                            me->fwFlashMetadata._imageSize,
+                            me->fwFlashMetadata._imageSectorMask
+                        );
+                    }
                     me->flashAddrCurr = FLASH_APPL_START_ADDR;
+                #else
+                    #error "Invalid build.  CPLR_APP or CPLR_BOOT must be specified"
+                #endif
+                    me->fwImageStartAddr = me->flashAddrCurr;
                     me->fwPacketExp   = me->fwFlashMetadata._imageNumPackets;
                     DBG_printf("Expecting %d FW data packets\n", me->fwPacketExp);
                 } else {
@@ -547,13 +617,37 @@ static QState FlashMgr_PrepFlash(FlashMgr * const me, QEvt const * const e) {
                     ERR_printf("FW image type %d currently not supported for FW upgrades, error: 0x%08x\n",
                         me->fwFlashMetadata._imageType, me->errorCode);
                 }
+
+                /* Pick up an aborted FW upgrade of the same image where it left off.  The same image always
+                 * gets the same list of sectors so it's safe to skip the ones that were already erased. */
+                if (ERR_NONE == me->errorCode && me->fwResumeValid &&
+                    me->fwResumeMetadata._imageCrc       == me->fwFlashMetadata._imageCrc &&
+                    me->fwResumeMetadata._imageSize      == me->fwFlashMetadata._imageSize &&
+                    me->fwResumeMetadata._imageType      == me->fwFlashMetadata._imageType &&
+                    me->fwResumeMetadata._imageSectorMask == me->fwFlashMetadata._imageSectorMask &&
+                    me->fwResumeMetadata._imageCompression == me->fwFlashMetadata._imageCompression &&
+                    me->fwResumeMetadata._imageNumPackets == me->fwFlashMetadata._imageNumPackets) {
+                    me->flashSectorsToEraseIndex = me->fwResumeErasedNum;
+                    me->fwPacketCurr             = me->fwResumePacket;
+                    me->flashAddrCurr            = me->fwResumeAddr;
+                    LOG_printf("Resuming FW upgrade after packet %d (%d of %d sectors already erased)\n",
+                        me->fwPacketCurr, me->flashSectorsToEraseIndex, me->flashSectorsToEraseNum);
+                }
+                me->fwResumeValid = false;   /* Gets saved again on exit if this attempt is aborted too */
                 /* ${AOs::FlashMgr::SM::Active::BusyFlash::PrepFlash::FLASH_NEXT_STEP::[MetadataValid?]::[SectorsValid?]} */
                 if (ERR_NONE == me->errorCode && me->flashSectorsToEraseNum > 1) {
                     LOG_printf("List of %d sectors (by address) to erase:\n", me->flashSectorsToEraseNum);
                     for( uint8_t i=0; i < me->flashSectorsToEraseNum; i++ ) {
                         LOG_printf("Sector at address at 0x%08x\n", me->flashSectorsToErase[i]);
                     }
-                    status_ = Q_TRAN(&FlashMgr_ErasingSector);
+                    /* ${AOs::FlashMgr::SM::Active::BusyFlash::PrepFlash::FLASH_NEXT_STEP::[MetadataValid?]::[SectorsValid?]::[MoreToErase?]} */
+                    if (me->flashSectorsToEraseIndex < me->flashSectorsToEraseNum) {
+                        status_ = Q_TRAN(&FlashMgr_ErasingSector);
+                    }
+                    /* ${AOs::FlashMgr::SM::Active::BusyFlash::PrepFlash::FLASH_NEXT_STEP::[MetadataValid?]::[SectorsValid?]::[else]} */
+                    else {
+                        status_ = Q_TRAN(&FlashMgr_WaitingForFWData);
+                    }
                 }
                 /* ${AOs::FlashMgr::SM::Active::BusyFlash::PrepFlash::FLASH_NEXT_STEP::[MetadataValid?]::[else]} */
                 else {
@@ -693,6 +787,7 @@ static QState FlashMgr_WaitingForFWData(FlashMgr * const me, QEvt const * const
              * CommMgr know we are ready for a data packet. */
             FlashStatusEvt *evt = Q_NEW(FlashStatusEvt, FLASH_OP_DONE_SIG);
             evt->errorCode = me->errorCode;
+            evt->seqCurr   = me->fwPacketCurr;
             QACTIVE_POST(AO_CommMgr, (QEvt *)(evt), AO_FlashMgr);
 
             me->errorCode = ERR_FLASH_WAIT_FOR_DATA_TIMEOUT; /* Set the timeout error code*/
@@ -721,13 +816,57 @@ static QState FlashMgr_WaitingForFWData(FlashMgr * const me, QEvt const * const
                 uint32_t CRCValue = CRC32_Calc(((FWDataEvt const *)e)->dataBuf, ((FWDataEvt const *)e)->dataLen);
                 /* ${AOs::FlashMgr::SM::Active::BusyFlash::WaitingForFWData::FLASH_DATA::[ValidSeq?]::[ValidCRC?]} */
                 if (CRCValue == ((FWDataEvt const *)e)->dataCRC) {
-                    me->fwDataToFlashLen = ((FWDataEvt const *)e)->dataLen;
-                    MEMCPY(
-                        me->fwDataToFlash,
-                        ((FWDataEvt const *)e)->dataBuf,
-                        me->fwDataToFlashLen
-                    );
-                    status_ = Q_TRAN(&FlashMgr_WritingFlash);
+                    me->errorCode = ERR_NONE;
+                    if (_DC3_COMPRESSION_LZSS == me->fwFlashMetadata._imageCompression) {
+                        /* Everything decoded before this block is already in flash right in front of where it
+                         * goes so matches that reach back past the start of the block are read from there. */
+                        size_t historyLen = me->flashAddrCurr - me->fwImageStartAddr;
+                        if (historyLen > LZSS_WINDOW_SIZE) {
+                            historyLen = LZSS_WINDOW_SIZE;
+                        }
+                        size_t decodedLen = 0;
+                        LzssStatus_t lzssStatus = LZSS_decodeBlock(
+                            ((FWDataEvt const *)e)->dataBuf,
+                            ((FWDataEvt const *)e)->dataLen,
+                            (const uint8_t *)(me->flashAddrCurr - historyLen),
+                            historyLen,
+                            me->fwDataToFlash,
+                            sizeof(me->fwDataToFlash),
+                            &decodedLen
+                        );
+                        me->fwDataToFlashLen = (uint16_t)decodedLen;
+                        if (LZSS_OK != lzssStatus) {
+                            me->errorCode = ERR_FLASH_INVALID_FW_PACKET_DATA;
+                            ERR_printf("Unable to decode fw packet: %d (LZSS error %d)\n",
+                                ((FWDataEvt const *)e)->seqCurr, lzssStatus);
+                        }
+                    } else {
+                        me->fwDataToFlashLen = ((FWDataEvt const *)e)->dataLen;
+                        MEMCPY(
+                            me->fwDataToFlash,
+                            ((FWDataEvt const *)e)->dataBuf,
+                            me->fwDataToFlashLen
+                        );
+                    }
+
+                    /* For a partial FW update, skip over the sectors that aren't being sent */
+                    if (ERR_NONE == me->errorCode) {
+                        me->errorCode = FLASH_getSectorMaskWriteAddr(
+                            me->fwFlashMetadata._imageSectorMask,
+                            me->fwDataToFlashLen,
+                            &(me->flashAddrCurr)
+                        );
+                    }
+                    /* ${AOs::FlashMgr::SM::Active::BusyFlash::WaitingForFWData::FLASH_DATA::[ValidSeq?]::[ValidCRC?]::[ValidAddr?]} */
+                    if (ERR_NONE == me->errorCode) {
+                        status_ = Q_TRAN(&FlashMgr_WritingFlash);
+                    }
+                    /* ${AOs::FlashMgr::SM::Active::BusyFlash::WaitingForFWData::FLASH_DATA::[ValidSeq?]::[ValidCRC?]::[else]} */
+                    else {
+                        ERR_printf("Unable to process fw packet: %d. Error: 0x%08x\n",
+                            ((FWDataEvt const *)e)->seqCurr, me->errorCode);
+                        status_ = Q_TRAN(&FlashMgr_Idle);
+                    }
                 }
                 /* ${AOs::FlashMgr::SM::Active::BusyFlash::WaitingForFWData::FLASH_DATA::[ValidSeq?]::[else]} */
                 else {
@@ -817,61 +956,43 @@ static QState FlashMgr_WritingFlash(FlashMgr * const me, QEvt const * const e) {
                 DBG_printf("No more fw packets expected\n");
                 /* Do a check of the FW image and compare all the CRCs and sizes */
                 CRC_ResetDR();
+                #if CPLR_APP
+                uint32_t crcCheck = CRC32_Calc(
+                    (uint8_t *)FLASH_SLOT_STAGED_START_ADDR,
+                    me->fwFlashMetadata._imageSize
+                );
+                #elif CPLR_BOOT
                 uint32_t crcCheck = CRC32_Calc(
                     (uint8_t *)FLASH_APPL_START_ADDR,
                     me->fwFlashMetadata._imageSize
                 );
+                #else
+                    #error "Invalid build.  CPLR_APP or CPLR_BOOT must be specified"
+                #endif
                 /* ${AOs::FlashMgr::SM::Active::BusyFlash::WritingFlash::FLASH_DONE::[else]::[CRCMatch?]} */
                 if (me->fwFlashMetadata._imageCrc == crcCheck) {
                     DBG_printf("CRCs of the FW image match, writing metadata...\n");
-                    me->errorCode = FLASH_writeApplSize( me->fwFlashMetadata._imageSize );
+                    #if CPLR_APP
+                    /* Only the slot header gets written here.  The Bootloader writes the Application
+                     * metadata when it installs the staged image on the next reboot. */
+                    me->errorCode = FLASH_writeSlotHdr( &(me->fwFlashMetadata) );
+                    #elif CPLR_BOOT
+                    me->errorCode = FLASH_writeApplMetadata( &(me->fwFlashMetadata) );
+                    #else
+                        #error "Invalid build.  CPLR_APP or CPLR_BOOT must be specified"
+                    #endif
                     /* ${AOs::FlashMgr::SM::Active::BusyFlash::WritingFlash::FLASH_DONE::[else]::[CRCMatch?]::[NoError?]} */
                     if (ERR_NONE == me->errorCode) {
-                        me->errorCode = FLASH_writeApplCRC( me->fwFlashMetadata._imageCrc );
-                        /* ${AOs::FlashMgr::SM::Active::BusyFlash::WritingFlash::FLASH_DONE::[else]::[CRCMatch?]::[NoError?]::[NoError?]} */
-                        if (ERR_NONE == me->errorCode) {
-                            me->errorCode = FLASH_writeApplMajVer( me->fwFlashMetadata._imageMaj );
-                            /* ${AOs::FlashMgr::SM::Active::BusyFlash::WritingFlash::FLASH_DONE::[else]::[CRCMatch?]::[NoError?]::[NoError?]::[NoError?]} */
-                            if (ERR_NONE == me->errorCode) {
-                                me->errorCode = FLASH_writeApplMinVer( me->fwFlashMetadata._imageMin );
-                                /* ${AOs::FlashMgr::SM::Active::BusyFlash::WritingFlash::FLASH_DONE::[else]::[CRCMatch?]::[NoError?]::[NoError?]::[NoError?]::[NoError?]} */
-                                if (ERR_NONE == me->errorCode) {
-                                    me->errorCode = FLASH_writeApplBuildDatetime(
-                                        (uint8_t *)me->fwFlashMetadata._imageDatetime,
-                                        me->fwFlashMetadata._imageDatetime_len
-                                    );
-                                    /* ${AOs::FlashMgr::SM::Active::BusyFlash::WritingFlash::FLASH_DONE::[else]::[CRCMatch?]::[NoError?]::[NoError?]::[NoError?]::[NoError?]::[NoError?]} */
-                                    if (ERR_NONE == me->errorCode) {
-                                        LOG_printf("Successfully finished upgrading FW!\n");
-                                        status_ = Q_TRAN(&FlashMgr_Idle);
-                                    }
-                                    /* ${AOs::FlashMgr::SM::Active::BusyFlash::WritingFlash::FLASH_DONE::[else]::[CRCMatch?]::[NoError?]::[NoError?]::[NoError?]::[NoError?]::[else]} */
-                                    else {
-                                        ERR_printf("Unable to write image build datetime after flashing. Error: 0x%08x.\n", me->errorCode);
-                                        status_ = Q_TRAN(&FlashMgr_Idle);
-                                    }
-                                }
-                                /* ${AOs::FlashMgr::SM::Active::BusyFlash::WritingFlash::FLASH_DONE::[else]::[CRCMatch?]::[NoError?]::[NoError?]::[NoError?]::[else]} */
-                                else {
-                                    ERR_printf("Unable to write image Minor Version after flashing. Error: 0x%08x.\n", me->errorCode);
-                                    status_ = Q_TRAN(&FlashMgr_Idle);
-                                }
-                            }
-                            /* ${AOs::FlashMgr::SM::Active::BusyFlash::WritingFlash::FLASH_DONE::[else]::[CRCMatch?]::[NoError?]::[NoError?]::[else]} */
-                            else {
-                                ERR_printf("Unable to write image Major Version after flashing. Error: 0x%08x.\n", me->errorCode);
-                                status_ = Q_TRAN(&FlashMgr_Idle);
-                            }
-                        }
-                        /* ${AOs::FlashMgr::SM::Active::BusyFlash::WritingFlash::FLASH_DONE::[else]::[CRCMatch?]::[NoError?]::[else]} */
-                        else {
-                            ERR_printf("Unable to write image CRC after flashing. Error: 0x%08x.\n", me->errorCode);
-                            status_ = Q_TRAN(&FlashMgr_Idle);
-                        }
+                        #if CPLR_APP
+                        LOG_printf("Successfully staged FW! It will be installed on the next reboot.\n");
+                        #elif CPLR_BOOT
+                        LOG_printf("Successfully finished upgrading FW!\n");
+                        #endif
+                        status_ = Q_TRAN(&FlashMgr_Idle);
                     }
                     /* ${AOs::FlashMgr::SM::Active::BusyFlash::WritingFlash::FLASH_DONE::[else]::[CRCMatch?]::[else]} */
                     else {
-                        ERR_printf("Unable to write image size after flashing. Error: 0x%08x.\n", me->errorCode);
+                        ERR_printf("Unable to write image metadata after flashing. Error: 0x%08x.\n", me->errorCode);
                         status_ = Q_TRAN(&FlashMgr_Idle);
                     }
                 }
@@ -1123,7 +1244,7 @@ static QState FlashMgr_DataBusTest(FlashMgr * const me, QEvt const * const e) {
 
 
 /**
- * @} end addtogroup groupBsp
+ * @} end addtogroup groupSys
  */
 
 /******** Copyright (C) 2015 Harry Rostovtsev. All rights reserved *****END OF FILE****/
@@ -29,7 +29,7 @@
  * @email   rost0031@gmail.com
  * Copyright (C) 2015 Harry Rostovtsev. All rights reserved.
  *
- * @addtogroup groupBsp
+ * @addtogroup groupSys
  * @{
  */
 
@@ -97,6 +97,12 @@ typedef struct {
 
     /**< Total number of FW data packets expected */
     uint16_t imageNumPackets;
+
+    /**< Bitfield of image sectors to update.  0 to update the entire image */
+    uint32_t imageSectorMask;
+
+    /**< How the data in the FW data packets is encoded */
+    DC3Compression_t imageCompression;
 } FWMetaEvt;
 
 /**< Event type that transports metadata about the FW upgrade */
@@ -107,6 +113,9 @@ typedef struct {
 
     /**< Status of the FlashMgr operation completion. */
     DC3Error_t errorCode;
+
+    /**< Last FW data packet written to flash.  Lets the client resume a FW upgrade. */
+    uint16_t seqCurr;
 } FlashStatusEvt;
 
 /**< Event type that transports data about the RAM test */
@@ -145,7 +154,7 @@ extern QActive * const AO_FlashMgr;
 
 
 /**
- * @} end addtogroup groupBsp
+ * @} end addtogroup groupSys
  */
 
 #endif                                                         /* FLASHMGR_H_ */
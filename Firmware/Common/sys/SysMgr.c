@@ -41,6 +41,7 @@
 #include "Shared.h"
 #include "i2c_dev.h"
 #include "version.h"
+#include "mem_stats.h"                    /* For pool and queue usage records */
 #if CPLR_APP
 #include "cplr.h"
 #elif CPLR_BOOT
@@ -78,6 +79,9 @@ typedef struct {
     /**< QPC timer Used to timeout DB accesses. */
     QTimeEvt dbTimerEvt;
 
+    /**< QPC timer Used to collect DB writes before committing them to EEPROM. */
+    QTimeEvt dbCommitTimerEvt;
+
     /**< Access type of current request (used for DB access) */
     DC3AccessType_t accessType;
 
@@ -93,6 +97,9 @@ typedef struct {
     /**< DB element to get or set with the current request (used for DB access to guarantee a reply) */
     DC3DBElem_t dbElem;
 
+    /**< List of DB elements to get or set with the current multi-element request */
+    DB_ElemList_t elemList;
+
     /**< Flag that keeps track of whether DB is valid.  Starts out false but gets set to
      * true after checking. */
     bool isDBValid;
@@ -173,6 +180,30 @@ static QState SysMgr_DBFullReset(SysMgr * const me, QEvt const * const e);
  */
 static QState SysMgr_DBCheckAndSetElem(SysMgr * const me, QEvt const * const e);
 
+/**
+ * @brief    Get or set a list of DB elements.
+ * Reads are combined into as few device accesses as possible and writes go to
+ * the EEPROM in a single write.
+ *
+ * @param  [in|out] me: Pointer to the state machine
+ * @param  [in|out]  e:  Pointer to the event being processed.
+ * @return status: QState type that specifies where the state
+ * machine is going next.
+ */
+static QState SysMgr_DBElemsAccess(SysMgr * const me, QEvt const * const e);
+
+/**
+ * @brief    Commit DB writes staged in the RAM shadow to the EEPROM.
+ * The parent's I2C1_DEV_WRITE_DONE handler keeps going until every run of dirty
+ * pages has been written.
+ *
+ * @param  [in|out] me: Pointer to the state machine
+ * @param  [in|out]  e:  Pointer to the event being processed.
+ * @return status: QState type that specifies where the state
+ * machine is going next.
+ */
+static QState SysMgr_DBCommit(SysMgr * const me, QEvt const * const e);
+
 
 /* Private defines -----------------------------------------------------------*/
 #define MAX_RETRIES     5       /**< Max number of times to retry operations. */
@@ -207,9 +238,14 @@ void SysMgr_ctor(void) {
         (QEvt const **)( me->deferredEvtQSto ),
         Q_DIM(me->deferredEvtQSto)
     );
+    MEM_STATS_regQueue( &me->deferredEvtQueue, "SysMgrDefer" );
 
     QTimeEvt_ctor( &me->sysTimerEvt, SYS_MGR_TIMEOUT_SIG );
     QTimeEvt_ctor( &me->dbTimerEvt, DB_ACCESS_TIMEOUT_SIG );
+    QTimeEvt_ctor( &me->dbCommitTimerEvt, DB_COMMIT_TIMEOUT_SIG );
+
+    /* Fill the RAM shadow of the DB so DB reads don't have to touch I2C bus */
+    DB_initShadow();
 }
 
 
@@ -222,10 +258,17 @@ static QState SysMgr_initial(SysMgr * const me, QEvt const * const e) {
     /* ${AOs::SysMgr::SM::initial} */
     (void)e;        /* suppress the compiler warning about unused parameter */
 
-    QS_OBJ_DICTIONARY(&l_CommMgr);
+    QS_OBJ_DICTIONARY(&l_SysMgr);
     QS_FUN_DICTIONARY(&QHsm_top);
-    QS_FUN_DICTIONARY(&CommMgr_initial);
-    QS_FUN_DICTIONARY(&CommMgr_Active);
+    QS_FUN_DICTIONARY(&SysMgr_initial);
+    QS_FUN_DICTIONARY(&SysMgr_Active);
+    QS_FUN_DICTIONARY(&SysMgr_Idle);
+    QS_FUN_DICTIONARY(&SysMgr_Busy);
+    QS_FUN_DICTIONARY(&SysMgr_AccessingDB);
+    QS_FUN_DICTIONARY(&SysMgr_DBFullReset);
+    QS_FUN_DICTIONARY(&SysMgr_DBCheckAndSetElem);
+    QS_FUN_DICTIONARY(&SysMgr_DBElemsAccess);
+    QS_FUN_DICTIONARY(&SysMgr_DBCommit);
 
     /* Subscribe to I2C read and write done signals since it will be publishing them */
     QActive_subscribe((QActive *)me, I2C1_DEV_READ_DONE_SIG);
@@ -233,6 +276,8 @@ static QState SysMgr_initial(SysMgr * const me, QEvt const * const e) {
     QActive_subscribe((QActive *)me, DB_GET_ELEM_SIG);
     QActive_subscribe((QActive *)me, DB_SET_ELEM_SIG);
     QActive_subscribe((QActive *)me, DB_FULL_RESET_SIG);
+    QActive_subscribe((QActive *)me, DB_GET_ELEMS_SIG);
+    QActive_subscribe((QActive *)me, DB_SET_ELEMS_SIG);
 
     me->isDBValid = false;
     me->dbVersionDef = DB_VERSION_DEF;
@@ -303,6 +348,13 @@ static QState SysMgr_Active(SysMgr * const me, QEvt const * const e) {
                 SEC_TO_TICKS( HL_MAX_TOUT_SEC_SYS_MGR )
             );
             QTimeEvt_disarm(&me->dbTimerEvt);
+
+            QTimeEvt_postIn(
+                &me->dbCommitTimerEvt,
+                (QActive *)me,
+                SEC_TO_TICKS( HL_MAX_TOUT_SEC_SYS_MGR )
+            );
+            QTimeEvt_disarm(&me->dbCommitTimerEvt);
             status_ = Q_HANDLED();
             break;
         }
@@ -412,6 +464,36 @@ static QState SysMgr_Idle(SysMgr * const me, QEvt const * const e) {
             status_ = Q_TRAN(&SysMgr_DBCheckAndSetElem);
             break;
         }
+        /* ${AOs::SysMgr::SM::Active::Idle::DB_GET_ELEMS} */
+        case DB_GET_ELEMS_SIG: {
+            DBG_printf("DB_GET_ELEMS for %d elements\n", ((DBElemsEvt const *)e)->elemList.nElems);
+
+            MEMCPY(&me->elemList, &((DBElemsEvt const *)e)->elemList, sizeof(me->elemList));
+            me->dbElem = me->elemList.elems[0];
+            me->dbCmd = DB_OP_READ_ELEMS;
+            me->accessType = me->elemList.accessType;
+            status_ = Q_TRAN(&SysMgr_DBElemsAccess);
+            break;
+        }
+        /* ${AOs::SysMgr::SM::Active::Idle::DB_SET_ELEMS} */
+        case DB_SET_ELEMS_SIG: {
+            DBG_printf("DB_SET_ELEMS for %d elements\n", ((DBElemsEvt const *)e)->elemList.nElems);
+
+            MEMCPY(&me->elemList, &((DBElemsEvt const *)e)->elemList, sizeof(me->elemList));
+            me->dbElem = me->elemList.elems[0];
+            me->dbCmd = DB_OP_WRITE_ELEMS;
+            me->accessType = me->elemList.accessType;
+            status_ = Q_TRAN(&SysMgr_DBElemsAccess);
+            break;
+        }
+        /* ${AOs::SysMgr::SM::Active::Idle::DB_COMMIT_TIMEOU~} */
+        case DB_COMMIT_TIMEOUT_SIG: {
+            me->dbElem = _DC3_DB_MAGIC_WORD;
+            me->dbCmd = DB_OP_INTERNAL;
+            me->accessType = _DC3_ACCESS_QPC;
+            status_ = Q_TRAN(&SysMgr_DBCommit);
+            break;
+        }
         default: {
             status_ = Q_SUPER(&SysMgr_Active);
             break;
@@ -462,7 +544,10 @@ static QState SysMgr_Busy(SysMgr * const me, QEvt const * const e) {
         /* ${AOs::SysMgr::SM::Active::Busy::DB_SET_ELEM, DB_~} */
         case DB_SET_ELEM_SIG: /* intentionally fall through */
         case DB_GET_ELEM_SIG: /* intentionally fall through */
-        case DB_INTRNL_CHK_ELEM_SIG: {
+        case DB_INTRNL_CHK_ELEM_SIG: /* intentionally fall through */
+        case DB_GET_ELEMS_SIG: /* intentionally fall through */
+        case DB_SET_ELEMS_SIG: /* intentionally fall through */
+        case DB_COMMIT_TIMEOUT_SIG: {
             if (QEQueue_getNFree(&me->deferredEvtQueue) > 0) {
                /* defer the request - this event will be handled
                 * when the state machine goes back to Idle state */
@@ -570,6 +655,31 @@ static QState SysMgr_AccessingDB(SysMgr * const me, QEvt const * const e) {
                 #error "Invalid build.  CPLR_APP or CPLR_BOOT must be specified"
             #endif
 
+                } else {
+                    /* Publish the event so other AOs can get it if they want */
+                    QF_PUBLISH((QEvt *)evt, AO_SysMgr);
+                }
+            } else if ( me->dbCmd == DB_OP_READ_ELEMS || me->dbCmd == DB_OP_WRITE_ELEMS ) {
+                DBElemsEvt *evt = Q_NEW(
+                    DBElemsEvt,
+                    (DB_OP_READ_ELEMS == me->dbCmd) ? DB_GET_ELEMS_DONE_SIG : DB_SET_ELEMS_DONE_SIG
+                );
+                evt->status = me->errorCode;
+                MEMCPY(&evt->elemList, &me->elemList, sizeof(evt->elemList));
+                DBG_printf("Publishing %s done for %d elements with error 0x%08x\n",
+                    CON_dbOpToStr(me->dbCmd), evt->elemList.nElems, evt->status);
+
+                if ( _DC3_ACCESS_FRT == me->accessType ) {
+            #if CPLR_APP
+                    /* Post directly to the "raw" queue for FreeRTOS task to read */
+                    QEQueue_postFIFO(&CPLR_evtQueue, (QEvt *)evt);
+                    vTaskResume( xHandle_CPLR );
+            #elif CPLR_BOOT
+                    /* Publish the event so other AOs can get it if they want */
+                    QF_PUBLISH((QEvt *)evt, AO_SysMgr);
+            #else
+                #error "Invalid build.  CPLR_APP or CPLR_BOOT must be specified"
+            #endif
                 } else {
                     /* Publish the event so other AOs can get it if they want */
                     QF_PUBLISH((QEvt *)evt, AO_SysMgr);
@@ -610,6 +720,18 @@ static QState SysMgr_AccessingDB(SysMgr * const me, QEvt const * const e) {
                 "FAILED %s (%d) operation on DB elem %s via %s: Error 0x%08x\n",
                 CON_dbOpToStr(me->dbCmd), me->dbCmd, CON_dbElemToStr( me->dbElem ),
                 CON_accessToStr(me->accessType),  me->errorCode );
+
+            /* Anything that's still only in the RAM shadow gets committed to the EEPROM when the
+             * commit timer expires.  A running timer is left alone so a steady stream of writes
+             * can't keep pushing the commit out.  Failed commits are retried a bit later. */
+            if ( DB_isDirty() && 0 == QTimeEvt_ctr(&me->dbCommitTimerEvt) ) {
+                QTimeEvt_rearm(
+                    &me->dbCommitTimerEvt,
+                    ( ERR_NONE == me->errorCode ) ?
+                        MS_TO_TICKS( LL_MAX_TIME_MS_DB_WRITE_COMBINE ) :
+                        SEC_TO_TICKS( LL_MAX_TIME_SEC_BETWEEN_RETRIES )
+                );
+            }
             status_ = Q_HANDLED();
             break;
         }
@@ -653,19 +775,29 @@ static QState SysMgr_AccessingDB(SysMgr * const me, QEvt const * const e) {
         }
         /* ${AOs::SysMgr::SM::Active::Busy::AccessingDB::DB_WRITE} */
         case DB_WRITE_SIG: {
-            /* This is a common function that will do a proper read based on access type and
-             * element.  Arguments for buffer size and buffer can be 0 and NULL, respectively
-             * since the function will post an event to do the read and it allocates its own
-             * buffer space.  Once the read is complete, an event will be posted that signifies
-             * the competion of the read and the data will be contained within those events.
-             * See I2C1_DEV_READ/WRITE_DONE_SIG and DB_FLASH_READ_DONE_SIG handlers. */
-            me->errorCode = DB_write(
+            /* Stage the write in the RAM shadow and reply right away.  The commit timer armed on
+             * the way out of AccessingDB writes it to the EEPROM along with any other writes that
+             * come in before it expires.  Without a shadow, the write goes straight through to the
+             * EEPROM and the reply waits for the I2C1_DEV_WRITE_DONE_SIG. */
+            me->errorCode = DB_stage(
                 ((DBWriteReqEvt const *)e)->dbElem,         // Element to write
-                ((DBWriteReqEvt const *)e)->accessType,     // Access type to use
                 MAX_DB_ELEM_SIZE,                           // Max size of buffer
                 ((DBWriteReqEvt const *)e)->dataBuf         // Buffer containing data to write
             );
 
+            if ( ERR_DB_NOT_INIT == me->errorCode ) {
+                me->errorCode = DB_write(
+                    ((DBWriteReqEvt const *)e)->dbElem,         // Element to write
+                    ((DBWriteReqEvt const *)e)->accessType,     // Access type to use
+                    MAX_DB_ELEM_SIZE,                           // Max size of buffer
+                    ((DBWriteReqEvt const *)e)->dataBuf         // Buffer containing data to write
+                );
+            } else {
+                /* Self post to let the exit condition handle the sending back to requester */
+                QEvt *evt = Q_NEW(QEvt, DB_OP_DONE_SIG);
+                QACTIVE_POST(AO_SysMgr, evt, me);
+            }
+
             /* This will only print out if me->errorCode is not ERR_NONE */
             ERR_COND_OUTPUT(
                 me->errorCode,
@@ -700,11 +832,20 @@ static QState SysMgr_AccessingDB(SysMgr * const me, QEvt const * const e) {
         }
         /* ${AOs::SysMgr::SM::Active::Busy::AccessingDB::I2C1_DEV_WRITE_D~} */
         case I2C1_DEV_WRITE_DONE_SIG: {
-            me->errorCode = ((I2CWriteDoneEvt const *) e)->status;
+            /* Writes of the RAM shadow may take more than one I2C write.  This posts the next
+             * one if there's anything left. */
+            bool isDone = true;
+            me->errorCode = DB_writeDone(
+                ((I2CWriteDoneEvt const *) e)->status,
+                _DC3_ACCESS_QPC,
+                &isDone
+            );
 
-            /* Self post to let the exit condition handle the sending back to requester */
-            QEvt *evt = Q_NEW(QEvt, DB_OP_DONE_SIG);
-            QACTIVE_POST(AO_SysMgr, evt, me);
+            if ( ERR_NONE != me->errorCode || isDone ) {
+                /* Self post to let the exit condition handle the sending back to requester */
+                QEvt *evt = Q_NEW(QEvt, DB_OP_DONE_SIG);
+                QACTIVE_POST(AO_SysMgr, evt, me);
+            }
             status_ = Q_HANDLED();
             break;
         }
@@ -844,9 +985,18 @@ static QState SysMgr_DBCheckAndSetElem(SysMgr * const me, QEvt const * const e)
                         me->errorCode = DB_getEepromDefaultElem(
                             me->dbElem, me->accessType, MAX_DB_ELEM_SIZE, me->dataBuf );
                         if ( ERR_NONE == me->errorCode ) {
-                            /* If no errors, write the default to EEPROM */
-                            DB_write( me->dbElem, me->accessType,
-                                DB_getElemSize(me->dbElem), me->dataBuf );
+                            /* If no errors, stage the default so all the elements fixed at startup
+                             * go to the EEPROM together.  Without a shadow, write it straight through. */
+                            me->errorCode = DB_stage(
+                                me->dbElem, DB_getElemSize(me->dbElem), me->dataBuf );
+                            if ( ERR_DB_NOT_INIT == me->errorCode ) {
+                                me->errorCode = DB_write( me->dbElem, me->accessType,
+                                    DB_getElemSize(me->dbElem), me->dataBuf );
+                            } else {
+                                /* Self post to get back to Idle */
+                                QEvt *evt = Q_NEW(QEvt, DB_OP_DONE_SIG);
+                                QACTIVE_POST(AO_SysMgr, evt, me);
+                            }
                         }
                         break;
                     }
@@ -890,6 +1040,108 @@ static QState SysMgr_DBCheckAndSetElem(SysMgr * const me, QEvt const * const e)
     return status_;
 }
 
+/**
+ * @brief    Get or set a list of DB elements.
+ * Reads are combined into as few device accesses as possible and writes go to
+ * the EEPROM in a single write.
+ *
+ * @param  [in|out] me: Pointer to the state machine
+ * @param  [in|out]  e:  Pointer to the event being processed.
+ * @return status: QState type that specifies where the state
+ * machine is going next.
+ */
+/*${AOs::SysMgr::SM::Active::Busy::AccessingDB::DBElemsAccess} .............*/
+static QState SysMgr_DBElemsAccess(SysMgr * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        /* ${AOs::SysMgr::SM::Active::Busy::AccessingDB::DBElemsAccess} */
+        case Q_ENTRY_SIG: {
+            /* Elements that don't need the I2C bus are done right away.  The rest come back
+             * via I2C1_DEV_READ_DONE (reads) or the parent's I2C1_DEV_WRITE_DONE (writes). */
+            bool isDone = false;
+            if ( DB_OP_READ_ELEMS == me->dbCmd ) {
+                me->errorCode = DB_readElems( &me->elemList, _DC3_ACCESS_QPC, &isDone );
+            } else {
+                me->errorCode = DB_writeElems( &me->elemList, _DC3_ACCESS_QPC );
+            }
+
+            if ( ERR_NONE != me->errorCode || isDone ) {
+                /* Self post to let the exit condition handle the sending back to requester */
+                QEvt *evt = Q_NEW(QEvt, DB_OP_DONE_SIG);
+                QACTIVE_POST(AO_SysMgr, evt, me);
+            } else {
+                me->errorCode = ERR_DB_ACCESS_TIMEOUT;       /* Still waiting on the I2C bus */
+            }
+            status_ = Q_HANDLED();
+            break;
+        }
+        /* ${AOs::SysMgr::SM::Active::Busy::AccessingDB::DBElemsAccess::I2C1_DEV_READ_DO~} */
+        case I2C1_DEV_READ_DONE_SIG: {
+            bool isDone = false;
+            me->errorCode = DB_readElemsDone(
+                &me->elemList,
+                _DC3_ACCESS_QPC,
+                ((I2CReadDoneEvt const *) e)->status,
+                ((I2CReadDoneEvt const *) e)->dataBuf,
+                ((I2CReadDoneEvt const *) e)->bytes,
+                &isDone
+            );
+
+            if ( ERR_NONE != me->errorCode || isDone ) {
+                /* Self post to let the exit condition handle the sending back to requester */
+                QEvt *evt = Q_NEW(QEvt, DB_OP_DONE_SIG);
+                QACTIVE_POST(AO_SysMgr, evt, me);
+            } else {
+                me->errorCode = ERR_DB_ACCESS_TIMEOUT;       /* Still waiting on the I2C bus */
+            }
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&SysMgr_AccessingDB);
+            break;
+        }
+    }
+    return status_;
+}
+
+/**
+ * @brief    Commit DB writes staged in the RAM shadow to the EEPROM.
+ * The parent's I2C1_DEV_WRITE_DONE handler keeps going until every run of dirty
+ * pages has been written.
+ *
+ * @param  [in|out] me: Pointer to the state machine
+ * @param  [in|out]  e:  Pointer to the event being processed.
+ * @return status: QState type that specifies where the state
+ * machine is going next.
+ */
+/*${AOs::SysMgr::SM::Active::Busy::AccessingDB::DBCommit} ..................*/
+static QState SysMgr_DBCommit(SysMgr * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        /* ${AOs::SysMgr::SM::Active::Busy::AccessingDB::DBCommit} */
+        case Q_ENTRY_SIG: {
+            bool isDone = false;
+            me->errorCode = DB_commit( _DC3_ACCESS_QPC, &isDone );
+
+            if ( ERR_NONE != me->errorCode || isDone ) {
+                /* Self post to get back to Idle */
+                QEvt *evt = Q_NEW(QEvt, DB_OP_DONE_SIG);
+                QACTIVE_POST(AO_SysMgr, evt, me);
+            } else {
+                me->errorCode = ERR_DB_ACCESS_TIMEOUT;       /* Still waiting on the I2C bus */
+            }
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&SysMgr_AccessingDB);
+            break;
+        }
+    }
+    return status_;
+}
+
 
 /**
  * @} end addtogroup groupSys
@@ -132,6 +132,22 @@ typedef struct {
     DC3DBElem_t dbElem;
 } DBCheckSetElemEvt;
 
+/**
+ * @brief Event struct type for requesting a get or set of several DB elements
+ * at once and for returning the results of it.
+ */
+/*${Events::DBElemsEvt} ....................................................*/
+typedef struct {
+/* protected: */
+    QEvt super;
+
+    /**< List of DB elements along with their data */
+    DB_ElemList_t elemList;
+
+    /**< Status of the operation */
+    DC3Error_t status;
+} DBElemsEvt;
+
 
 /* Exported constants --------------------------------------------------------*/
 /* Exported functions --------------------------------------------------------*/
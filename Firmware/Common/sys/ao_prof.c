@@ -0,0 +1,459 @@
+/**
+ * @file    ao_prof.c
+ * @brief   Active Object dispatch and queue wait profiling.
+ *
+ * See ao_prof.h for the description.
+ *
+ * Waits are timed with a small ring of post timestamps for each AO that
+ * mirrors the front of the event queue of that AO.  The first nStamps events
+ * in the queue have a timestamp in the ring (oldest at the tail) and the
+ * nUntimed events behind them don't.  A FIFO post only gets a timestamp if
+ * there are no untimed events ahead of it.  A LIFO post always gets one and, if
+ * the ring is full, pushes the timestamp of the last timed event out so that
+ * event becomes untimed.  This way the ring always lines up with the queue no
+ * matter how deep it gets.
+ *
+ * @date    10/19/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ *
+ * @addtogroup groupAOProf
+ * @{
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "ao_prof.h"
+#include <string.h>
+
+#ifdef DC3_AO_PROF
+#if defined(__arm__)
+#include "stm32f4xx.h"                   /* For DWT and CoreDebug registers */
+#else
+#include <time.h>                                   /* For clock_gettime() */
+#endif
+#endif                                                        /* DC3_AO_PROF */
+
+/* Compile-time called macros ------------------------------------------------*/
+/* Private typedefs ----------------------------------------------------------*/
+
+/**
+ * @brief   Everything that is kept for a single AO.
+ */
+typedef struct {
+   AOProfAo_t ao;                                     /**< The public profile */
+   uint32_t   stamps[AO_PROF_WAIT_DEPTH];    /**< Post times of queued events */
+   uint8_t    tail;                    /**< Stamp of the event at queue front */
+   uint8_t    nStamps;                      /**< Stamps in the ring right now */
+   uint16_t   nUntimed;            /**< Queued events behind the stamped ones */
+} AOProfSlot_t;
+
+/* Private defines -----------------------------------------------------------*/
+/* Private macros ------------------------------------------------------------*/
+
+/**
+ * @brief   Critical section for the parts that aren't already called from
+ * inside of a QF critical section.
+ */
+#ifdef QF_CRIT_STAT_TYPE
+#define AO_PROF_CRIT_STAT       QF_CRIT_STAT_TYPE critStat_;
+#define AO_PROF_CRIT_ENTRY()    QF_CRIT_ENTRY(critStat_)
+#define AO_PROF_CRIT_EXIT()     QF_CRIT_EXIT(critStat_)
+#else
+#define AO_PROF_CRIT_STAT
+#define AO_PROF_CRIT_ENTRY()    QF_CRIT_ENTRY(dummy)
+#define AO_PROF_CRIT_EXIT()     QF_CRIT_EXIT(dummy)
+#endif
+
+/* Private variables and Local objects ---------------------------------------*/
+#ifdef DC3_AO_PROF
+static AOProfSlot_t l_aoProfSlots[AO_PROF_MAX_AO];    /**< Indexed by AO prio */
+static AOProfSig_t  l_aoProfSigs[AO_PROF_MAX_SIGS];   /**< Hashed (prio, sig) */
+static uint32_t     l_aoProfSigDropped = 0;    /**< Dispatches with no record */
+#endif                                                        /* DC3_AO_PROF */
+
+/* Private function prototypes -----------------------------------------------*/
+#ifdef DC3_AO_PROF
+
+/**
+ * @brief   Get the current time.
+ * @param   None
+ * @return  uint32_t: time in ticks.  Only the difference of two of these
+ * means anything.
+ */
+static inline uint32_t AO_PROF_now( void );
+
+/**
+ * @brief   Add a time to a set of statistics.
+ * @param [in|out] *pStats: AOProfStats_t pointer to the statistics.
+ * @param [in] ticks: const uint32_t time in ticks.
+ * @return  None
+ */
+static void AO_PROF_addSample( AOProfStats_t *pStats, const uint32_t ticks );
+
+/**
+ * @brief   Find the record of a signal of an AO and add it if it's not there.
+ * @param [in] prio: const uint8_t priority of the AO.
+ * @param [in] sig: const QSignal signal.
+ * @return  AOProfSig_t pointer to the record or NULL if the table is full.
+ */
+static AOProfSig_t *AO_PROF_findSig( const uint8_t prio, const QSignal sig );
+
+/**
+ * @brief   Check if an AO has anything worth reporting.
+ * @param [in] *pSlot: const AOProfSlot_t pointer to the AO.
+ * @return  bool: true if the AO was started or has any times recorded.
+ */
+static bool AO_PROF_isAoUsed( const AOProfSlot_t *pSlot );
+
+#endif                                                        /* DC3_AO_PROF */
+
+/* Private functions ---------------------------------------------------------*/
+#ifdef DC3_AO_PROF
+
+/******************************************************************************/
+static inline uint32_t AO_PROF_now( void )
+{
+#if defined(__arm__)
+   return( DWT->CYCCNT );
+#else
+   struct timespec ts;
+   clock_gettime( CLOCK_MONOTONIC, &ts );
+
+   /* Wraps every ~4.3 seconds which is fine since only differences are used */
+   return( (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec) );
+#endif
+}
+
+/******************************************************************************/
+static void AO_PROF_addSample( AOProfStats_t *pStats, const uint32_t ticks )
+{
+   if ( 0 == pStats->count || ticks < pStats->min ) {
+      pStats->min = ticks;
+   }
+   if ( ticks > pStats->max ) {
+      pStats->max = ticks;
+   }
+   pStats->count++;
+   pStats->total += ticks;
+   pStats->hist[AO_PROF_histBucket( ticks )]++;
+}
+
+/******************************************************************************/
+static AOProfSig_t *AO_PROF_findSig( const uint8_t prio, const QSignal sig )
+{
+   /* Open addressing with linear probing.  Records are only ever added (until
+    * a reset clears all of them) so the first empty one ends the search. */
+   uint16_t idx = (uint16_t)((prio * 37U + sig) % AO_PROF_MAX_SIGS);
+   for ( uint16_t i = 0; i < AO_PROF_MAX_SIGS; i++ ) {
+      AOProfSig_t *pSig = &l_aoProfSigs[idx];
+      if ( 0 == pSig->count ) {
+         pSig->prio = prio;
+         pSig->sig  = sig;
+         return( pSig );
+      }
+      if ( prio == pSig->prio && sig == pSig->sig ) {
+         return( pSig );
+      }
+      idx = (idx + 1) % AO_PROF_MAX_SIGS;
+   }
+   return( NULL );
+}
+
+/******************************************************************************/
+static bool AO_PROF_isAoUsed( const AOProfSlot_t *pSlot )
+{
+   return( NULL != pSlot->ao.name || 0 != pSlot->ao.dispatch.count ||
+         0 != pSlot->ao.wait.count || 0 != pSlot->ao.waitUntimed );
+}
+
+#endif                                                        /* DC3_AO_PROF */
+
+/* Public functions ----------------------------------------------------------*/
+/******************************************************************************/
+uint8_t AO_PROF_histBucket( const uint32_t ticks )
+{
+   /* Bucket is the bit length of the time past the first bucket */
+   const uint8_t bits = (0 == ticks) ? 0 : (uint8_t)(32 - __builtin_clz(ticks));
+   if ( bits <= DC3_PROF_HIST_MIN_BITS ) {
+      return( 0 );
+   }
+   if ( bits - DC3_PROF_HIST_MIN_BITS >= DC3_PROF_HIST_BUCKETS ) {
+      return( DC3_PROF_HIST_BUCKETS - 1 );
+   }
+   return( bits - DC3_PROF_HIST_MIN_BITS );
+}
+
+#ifdef DC3_AO_PROF
+
+/******************************************************************************/
+void AO_PROF_init( void )
+{
+#if defined(__arm__)
+   /* The cycle counter is part of the trace block which is off out of reset
+    * unless a debugger turned it on. */
+   CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+   DWT->CYCCNT       = 0;
+   DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+}
+
+/******************************************************************************/
+uint32_t AO_PROF_getTickHz( void )
+{
+#if defined(__arm__)
+   return( SystemCoreClock );
+#else
+   return( 1000000000UL );
+#endif
+}
+
+/******************************************************************************/
+void AO_PROF_setName( uint_fast8_t prio, char const *name )
+{
+   if ( prio < AO_PROF_MAX_AO ) {
+      l_aoProfSlots[prio].ao.prio = (uint8_t)prio;
+      l_aoProfSlots[prio].ao.name = name;
+   }
+}
+
+/******************************************************************************/
+void AO_PROF_onPost( uint_fast8_t prio, bool lifo )
+{
+   /* Called from inside the QF critical section of the post */
+   if ( prio >= AO_PROF_MAX_AO ) {
+      return;
+   }
+
+   AOProfSlot_t *pSlot = &l_aoProfSlots[prio];
+   const uint32_t now  = AO_PROF_now();
+
+   if ( lifo ) {
+      if ( AO_PROF_WAIT_DEPTH == pSlot->nStamps ) {
+         /* The last timed event loses its stamp to make room */
+         pSlot->nStamps--;
+         pSlot->nUntimed++;
+      }
+      pSlot->tail = (pSlot->tail + AO_PROF_WAIT_DEPTH - 1) % AO_PROF_WAIT_DEPTH;
+      pSlot->stamps[pSlot->tail] = now;
+      pSlot->nStamps++;
+   } else if ( 0 == pSlot->nUntimed && pSlot->nStamps < AO_PROF_WAIT_DEPTH ) {
+      pSlot->stamps[(pSlot->tail + pSlot->nStamps) % AO_PROF_WAIT_DEPTH] = now;
+      pSlot->nStamps++;
+   } else {
+      pSlot->nUntimed++;
+   }
+}
+
+/******************************************************************************/
+void AO_PROF_onGet( uint_fast8_t prio )
+{
+   /* Called from inside the QF critical section of the get */
+   if ( prio >= AO_PROF_MAX_AO ) {
+      return;
+   }
+
+   AOProfSlot_t *pSlot = &l_aoProfSlots[prio];
+
+   if ( 0 != pSlot->nStamps ) {
+      AO_PROF_addSample(
+            &pSlot->ao.wait,
+            AO_PROF_now() - pSlot->stamps[pSlot->tail]
+      );
+      pSlot->tail = (pSlot->tail + 1) % AO_PROF_WAIT_DEPTH;
+      pSlot->nStamps--;
+   } else {
+      if ( 0 != pSlot->nUntimed ) {
+         pSlot->nUntimed--;
+      }
+      pSlot->ao.waitUntimed++;
+   }
+}
+
+/******************************************************************************/
+uint32_t AO_PROF_dispatchBegin( void )
+{
+   return( AO_PROF_now() );
+}
+
+/******************************************************************************/
+void AO_PROF_dispatchEnd( uint_fast8_t prio, QSignal sig, uint32_t start )
+{
+   const uint32_t ticks = AO_PROF_now() - start;
+
+   if ( prio >= AO_PROF_MAX_AO ) {
+      return;
+   }
+
+   AO_PROF_CRIT_STAT
+   AO_PROF_CRIT_ENTRY();
+
+   AO_PROF_addSample( &l_aoProfSlots[prio].ao.dispatch, ticks );
+
+   AOProfSig_t *pSig = AO_PROF_findSig( (uint8_t)prio, sig );
+   if ( NULL != pSig ) {
+      if ( 0 == pSig->count || ticks < pSig->min ) {
+         pSig->min = ticks;
+      }
+      if ( ticks > pSig->max ) {
+         pSig->max = ticks;
+      }
+      pSig->count++;
+      pSig->total += ticks;
+   } else {
+      l_aoProfSigDropped++;
+   }
+
+   AO_PROF_CRIT_EXIT();
+}
+
+/******************************************************************************/
+uint16_t AO_PROF_getAoCount( void )
+{
+   uint16_t count = 0;
+   for ( uint8_t prio = 0; prio < AO_PROF_MAX_AO; prio++ ) {
+      if ( AO_PROF_isAoUsed( &l_aoProfSlots[prio] ) ) {
+         count++;
+      }
+   }
+   return( count );
+}
+
+/******************************************************************************/
+DC3Error_t AO_PROF_getAo( const uint16_t index, AOProfAo_t *pAo )
+{
+   DC3Error_t status = ERR_PROF_INVALID_INDEX;
+   uint16_t   found  = 0;
+
+   AO_PROF_CRIT_STAT
+   AO_PROF_CRIT_ENTRY();
+   for ( uint8_t prio = 0; prio < AO_PROF_MAX_AO; prio++ ) {
+      if ( AO_PROF_isAoUsed( &l_aoProfSlots[prio] ) && index == found++ ) {
+         *pAo      = l_aoProfSlots[prio].ao;
+         pAo->prio = prio;
+         status    = ERR_NONE;
+         break;
+      }
+   }
+   AO_PROF_CRIT_EXIT();
+
+   return( status );
+}
+
+/******************************************************************************/
+uint16_t AO_PROF_getSigCount( void )
+{
+   uint16_t count = 0;
+   for ( uint16_t i = 0; i < AO_PROF_MAX_SIGS; i++ ) {
+      if ( 0 != l_aoProfSigs[i].count ) {
+         count++;
+      }
+   }
+   return( count );
+}
+
+/******************************************************************************/
+DC3Error_t AO_PROF_getSig( const uint16_t index, AOProfSig_t *pSig )
+{
+   DC3Error_t status = ERR_PROF_INVALID_INDEX;
+   uint16_t   found  = 0;
+
+   AO_PROF_CRIT_STAT
+   AO_PROF_CRIT_ENTRY();
+   for ( uint16_t i = 0; i < AO_PROF_MAX_SIGS; i++ ) {
+      if ( 0 != l_aoProfSigs[i].count && index == found++ ) {
+         *pSig  = l_aoProfSigs[i];
+         status = ERR_NONE;
+         break;
+      }
+   }
+   AO_PROF_CRIT_EXIT();
+
+   return( status );
+}
+
+/******************************************************************************/
+uint32_t AO_PROF_getSigDropped( void )
+{
+   return( l_aoProfSigDropped );
+}
+
+/******************************************************************************/
+void AO_PROF_reset( void )
+{
+   AO_PROF_CRIT_STAT
+   AO_PROF_CRIT_ENTRY();
+
+   /* Leave the names and the stamp rings alone.  The rings still line up with
+    * the queues so the events in them keep getting timed. */
+   for ( uint8_t prio = 0; prio < AO_PROF_MAX_AO; prio++ ) {
+      AOProfAo_t *pAo = &l_aoProfSlots[prio].ao;
+      memset( &pAo->dispatch, 0, sizeof(pAo->dispatch) );
+      memset( &pAo->wait, 0, sizeof(pAo->wait) );
+      pAo->waitUntimed = 0;
+   }
+   memset( l_aoProfSigs, 0, sizeof(l_aoProfSigs) );
+   l_aoProfSigDropped = 0;
+
+   AO_PROF_CRIT_EXIT();
+}
+
+#else                                                         /* DC3_AO_PROF */
+
+/* Built without the profiling.  The QF port doesn't call any of the hooks so
+ * all that's left is to let the readers know there's nothing to read. */
+
+/******************************************************************************/
+void AO_PROF_init( void )
+{
+}
+
+/******************************************************************************/
+uint32_t AO_PROF_getTickHz( void )
+{
+   return( 0 );
+}
+
+/******************************************************************************/
+uint16_t AO_PROF_getAoCount( void )
+{
+   return( 0 );
+}
+
+/******************************************************************************/
+DC3Error_t AO_PROF_getAo( const uint16_t index, AOProfAo_t *pAo )
+{
+   return( ERR_PROF_NOT_ENABLED );
+}
+
+/******************************************************************************/
+uint16_t AO_PROF_getSigCount( void )
+{
+   return( 0 );
+}
+
+/******************************************************************************/
+DC3Error_t AO_PROF_getSig( const uint16_t index, AOProfSig_t *pSig )
+{
+   return( ERR_PROF_NOT_ENABLED );
+}
+
+/******************************************************************************/
+uint32_t AO_PROF_getSigDropped( void )
+{
+   return( 0 );
+}
+
+/******************************************************************************/
+void AO_PROF_reset( void )
+{
+}
+
+#endif                                                        /* DC3_AO_PROF */
+
+/**
+ * @}
+ * end addtogroup groupAOProf
+ */
+
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
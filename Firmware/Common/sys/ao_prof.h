@@ -0,0 +1,202 @@
+/**
+ * @file    ao_prof.h
+ * @brief   Active Object dispatch and queue wait profiling.
+ *
+ * When the Application is built with AO_PROF=1 (which defines DC3_AO_PROF),
+ * the QF port times every event an Active Object dispatches and how long that
+ * event sat in the queue of the AO from the moment it was posted.  This module
+ * keeps the statistics:
+ *    - per AO: count, min, max, and average of both the dispatch and the wait
+ *    times, and a log2 histogram of each (see DC3_PROF_HIST_MIN_BITS).
+ *    - per signal of each AO: count, min, max, and average dispatch time.
+ *
+ * On the board the times are DWT cycle counts.  On a POSIX host (QP posix
+ * port) they come from clock_gettime() in ns so the same reports can be made
+ * in a simulation.  AO_PROF_getTickHz() says which.
+ *
+ * The QF port calls the AO_PROF_onPost(), AO_PROF_onGet(),
+ * AO_PROF_dispatchBegin(), AO_PROF_dispatchEnd(), and AO_PROF_setName() hooks.
+ * They are declared in qf_port.h so the QP library can be built without this
+ * file and are not meant to be called by anything else.
+ *
+ * @note 1: Times are wall clock, so a dispatch that gets preempted by a higher
+ * priority AO or an ISR includes the time spent there.  The wait time includes
+ * the time the AO spent dispatching the events ahead of it in the queue.
+ *
+ * @note 2: Each AO keeps the post timestamps of only the first
+ * AO_PROF_WAIT_DEPTH events in its queue.  Events queued behind a full ring
+ * are still dispatched and timed but their wait is counted as untimed.
+ *
+ * @date    10/19/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ *
+ * @addtogroup groupAOProf
+ * @{
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef AO_PROF_H_
+#define AO_PROF_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "qp_port.h"                                        /* for QP support */
+#include "DC3CommApi.h"                          /* For histogram definitions */
+#include "DC3Errors.h"                               /* For DC3 error codes */
+
+/* Exported defines ----------------------------------------------------------*/
+#define AO_PROF_MAX_AO          16    /**< AOs are tracked by prio below this */
+#define AO_PROF_MAX_SIGS        64   /**< (AO, signal) pairs that are tracked */
+#define AO_PROF_WAIT_DEPTH      16      /**< Post timestamps kept for each AO */
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief   Timing statistics of a single kind of interval.
+ */
+typedef struct {
+   uint32_t count;                                 /**< Number of times timed */
+   uint32_t min;                                      /**< Shortest, in ticks */
+   uint32_t max;                                       /**< Longest, in ticks */
+   uint64_t total;                          /**< Sum of all of them, in ticks */
+   uint32_t hist[DC3_PROF_HIST_BUCKETS];                  /**< log2 histogram */
+} AOProfStats_t;
+
+/**
+ * @brief   Profile of a single Active Object.
+ */
+typedef struct {
+   uint8_t       prio;                                 /**< QF priority of AO */
+   const char   *name;                /**< Task name of AO or NULL if not set */
+   AOProfStats_t dispatch;                                /**< Dispatch times */
+   AOProfStats_t wait;                       /**< Times from post to dispatch */
+   uint32_t      waitUntimed;        /**< Dispatched events with no timestamp */
+} AOProfAo_t;
+
+/**
+ * @brief   Dispatch profile of a single signal of a single Active Object.
+ */
+typedef struct {
+   uint8_t  prio;                                      /**< QF priority of AO */
+   QSignal  sig;                                    /**< Signal of the events */
+   uint32_t count;                                /**< Number of events timed */
+   uint32_t min;                                      /**< Shortest, in ticks */
+   uint32_t max;                                       /**< Longest, in ticks */
+   uint64_t total;                          /**< Sum of all of them, in ticks */
+} AOProfSig_t;
+
+/* Exported macros -----------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief   Start the time source used by the profiling.
+ *
+ * Turns on the DWT cycle counter on the board.  Has to be called before the
+ * AOs get started.  Does nothing if the profiling isn't built in.
+ *
+ * @param   None
+ * @return: None
+ */
+void AO_PROF_init( void );
+
+/**
+ * @brief   Get the frequency of the ticks all the profiling times are in.
+ *
+ * @param   None
+ * @return  uint32_t: ticks per second (the CPU clock on the board or 1e9 on a
+ * POSIX host).
+ */
+uint32_t AO_PROF_getTickHz( void );
+
+/**
+ * @brief   Get the number of AOs that have a profile.
+ *
+ * @param   None
+ * @return  uint16_t: number of AO records available through AO_PROF_getAo().
+ */
+uint16_t AO_PROF_getAoCount( void );
+
+/**
+ * @brief   Get a copy of the profile of an AO.
+ *
+ * The copy is taken in a critical section so all the fields are consistent
+ * with each other.
+ *
+ * @param [in] index: const uint16_t index of the AO record, from 0 to
+ * AO_PROF_getAoCount() - 1.  AOs are ordered from the lowest priority up.
+ * @param [out] *pAo: AOProfAo_t pointer to where to copy the profile to.
+ * @return  DC3Error_t status:
+ *    @arg ERR_NONE: success.
+ *    @arg ERR_PROF_NOT_ENABLED: the profiling isn't built in.
+ *    @arg ERR_PROF_INVALID_INDEX: no AO record at this index.
+ */
+DC3Error_t AO_PROF_getAo( const uint16_t index, AOProfAo_t *pAo );
+
+/**
+ * @brief   Get the number of (AO, signal) pairs that have a profile.
+ *
+ * @param   None
+ * @return  uint16_t: number of signal records available through
+ * AO_PROF_getSig().
+ */
+uint16_t AO_PROF_getSigCount( void );
+
+/**
+ * @brief   Get a copy of the dispatch profile of a signal of an AO.
+ *
+ * @param [in] index: const uint16_t index of the signal record, from 0 to
+ * AO_PROF_getSigCount() - 1.  The order is not meaningful.
+ * @param [out] *pSig: AOProfSig_t pointer to where to copy the profile to.
+ * @return  DC3Error_t status:
+ *    @arg ERR_NONE: success.
+ *    @arg ERR_PROF_NOT_ENABLED: the profiling isn't built in.
+ *    @arg ERR_PROF_INVALID_INDEX: no signal record at this index.
+ */
+DC3Error_t AO_PROF_getSig( const uint16_t index, AOProfSig_t *pSig );
+
+/**
+ * @brief   Get the number of (AO, signal) pairs that couldn't be tracked.
+ *
+ * @param   None
+ * @return  uint32_t: dispatches that weren't counted in any signal record
+ * because all AO_PROF_MAX_SIGS records were taken.  They are still counted in
+ * the AO records.
+ */
+uint32_t AO_PROF_getSigDropped( void );
+
+/**
+ * @brief   Clear all the statistics.
+ *
+ * The AO names are kept.  Events already in the queues when this is called
+ * are still timed when they get dispatched and their whole wait is counted.
+ *
+ * @param   None
+ * @return: None
+ */
+void AO_PROF_reset( void );
+
+/**
+ * @brief   Figure out which histogram bucket a time goes into.
+ *
+ * @param [in] ticks: const uint32_t time in ticks.
+ * @return  uint8_t: bucket index from 0 to DC3_PROF_HIST_BUCKETS - 1.
+ */
+uint8_t AO_PROF_histBucket( const uint32_t ticks );
+
+/**
+ * @}
+ * end addtogroup groupAOProf
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif                                                          /* AO_PROF_H_ */
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
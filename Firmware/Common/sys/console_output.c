@@ -42,7 +42,7 @@ const char invalidStr[] = "Invalid";
  * This function takes in an output buffer and inputs to create the first part
  * (preamble) of the debug logging message:
  *
- * DBG_LEVEL-HH:MM:SS:XXX-SomeFunctionName():fileLineNumber:
+ * DBG_LEVEL-HH:MM:SS:UUUUUU-SomeFunctionName():fileLineNumber:
  *
  * @param [out] *pOutputSize: uint16_t pointer to the final output length that is
  * in the pOutputBuffer when the function returns.
@@ -95,7 +95,7 @@ static void CON_formatPreamble(
  * This function takes in an output buffer and inputs to create the debug
  * logging message:
  *
- * DBG_LEVEL-HH:MM:SS:XXX-SomeFunctionName():fileLineNumber:<passed user input here>
+ * DBG_LEVEL-HH:MM:SS:UUUUUU-SomeFunctionName():fileLineNumber:<passed user input here>
  *
  * This is a special function in that it takes a va_list args instead of standard
  * variadic arguments.  Do not call this directly without using va_list and
@@ -168,13 +168,13 @@ static void CON_formatPreamble(
    *pOutputSize += snprintf(
          &pOutputBuffer[*pOutputSize],
          outputBufferSize,
-         "%s%s-%02d:%02d:%02d:%03d-%s():%d:",
+         "%s%s-%02d:%02d:%02d:%06d-%s():%d:",
          CON_dbgLvlToStr(dbgLvl),
          pLvlMod,
          time.hour_min_sec.RTC_Hours,
          time.hour_min_sec.RTC_Minutes,
          time.hour_min_sec.RTC_Seconds,
-         (int)time.sub_sec,
+         (int)time.sub_us,
          pFuncName,
          wLineNumber
    );
@@ -572,6 +572,21 @@ const char* const CON_msgNameToStr( const DC3MsgName_t msg )
       case _DC3DBGetElemMsg:           return("DBGetElem");             break;
       case _DC3DBSetElemMsg:           return("DBSetElem");             break;
       case _DC3DBDataPayloadMsg:       return("DBDataPayload");         break;
+      case _DC3FlashSectorCrcMsg:      return("FlashSectorCrc");        break;
+      case _DC3FlashSectorCrcPayloadMsg: return("FlashSectorCrcPayload"); break;
+      case _DC3MemReadMsg:             return("MemRead");               break;
+      case _DC3MemDataPayloadMsg:      return("MemDataPayload");        break;
+      case _DC3DBGetElemsMsg:          return("DBGetElems");            break;
+      case _DC3DBSetElemsMsg:          return("DBSetElems");            break;
+      case _DC3DBElemsPayloadMsg:      return("DBElemsPayload");        break;
+      case _DC3ProfMsg:                return("Prof");                  break;
+      case _DC3ProfPayloadMsg:         return("ProfPayload");           break;
+      case _DC3MemStatsMsg:            return("MemStats");              break;
+      case _DC3MemStatsPayloadMsg:     return("MemStatsPayload");       break;
+      case _DC3HealthMsg:              return("Health");                break;
+      case _DC3HealthPayloadMsg:       return("HealthPayload");         break;
+      case _DC3DiscoverMsg:            return("Discover");              break;
+      case _DC3DiscoverPayloadMsg:     return("DiscoverPayload");       break;
 
       /* Add more message name translations here*/
       default:                         return(invalidStr);              break;
@@ -632,6 +647,8 @@ const char* const CON_dbOpToStr( const DB_Operation_t op )
       case DB_OP_READ:     return("DB_OP_READ");      break;
       case DB_OP_WRITE:    return("DB_OP_WRITE");     break;
       case DB_OP_INTERNAL: return("DB_OP_INTERNAL");  break;
+      case DB_OP_READ_ELEMS:  return("DB_OP_READ_ELEMS");  break;
+      case DB_OP_WRITE_ELEMS: return("DB_OP_WRITE_ELEMS"); break;
       case DB_OP_MAX:                           /* Intentionally fall through */
       case DB_OP_NONE:                          /* Intentionally fall through */
       default:             return("Invalid");         break;
@@ -62,7 +62,7 @@
  * @note 1: Do not call this function directly.  Instead, call on of the
  * DBG/LOG/WRN/ERR/CON_printf() macros.  Printout from these looks something
  * like:
- * DBG_LEVEL-HH:MM:SS:XXX-SomeFunctionName():fileLineNumber: User message here
+ * DBG_LEVEL-HH:MM:SS:UUUUUU-SomeFunctionName():fileLineNumber: User message here
  *
  * @note 2: Instead of directly printing to the serial console, it creates a
  * SerDataEvt and sends the data to be output to serial via DMA.  This prevents
@@ -132,20 +132,20 @@ void CON_output(
  * @note 1: Do not call this function directly.  Instead, call on of the
  * DBG/LOG/WRN/ERR/CON_printfHexStr() macros.  Printout from these looks
  * something like:
- * DBG_LEVEL-HH:MM:SS:XXX-SomeFunctionName():fileLineNumber:User message here
- * DBG_LEVEL-HH:MM:SS:XXX-SomeFunctionName():fileLineNumber:[0000] 16 bytes
- * DBG_LEVEL-HH:MM:SS:XXX-SomeFunctionName():fileLineNumber:[0010] 16 bytes
+ * DBG_LEVEL-HH:MM:SS:UUUUUU-SomeFunctionName():fileLineNumber:User message here
+ * DBG_LEVEL-HH:MM:SS:UUUUUU-SomeFunctionName():fileLineNumber:[0000] 16 bytes
+ * DBG_LEVEL-HH:MM:SS:UUUUUU-SomeFunctionName():fileLineNumber:[0010] 16 bytes
  * ...
  * etc
  * ...
  *
  * or a real life example:
  *
- * DBG-00:06:40:361-I2C1DevMgr_Busy():462:Attempting to write 52 bytes:
- * DBG-00:06:40:361-I2C1DevMgr_Busy():462:[0000]: 0xdb 0xc8 0xfe 0xde 0x01 0x00 0xac 0x1b 0x00 0x4b 0x00 0x01 0x32 0x30 0x31 0x35
- * DBG-00:06:40:361-I2C1DevMgr_Busy():462:[0010]: 0x30 0x38 0x31 0x39 0x31 0x37 0x30 0x34 0x33 0x36 0x00 0x00 0x00 0x00 0x00 0x00
- * DBG-00:06:40:361-I2C1DevMgr_Busy():462:[0020]: 0x00 0x00 0x00 0x00 0x00 0x00 0x00 0x00 0x00 0x00 0x00 0x00 0xe9 0x3a 0x00 0x00
- * DBG-00:06:40:361-I2C1DevMgr_Busy():462:[0030]: 0x03 0x00 0x00 0x00
+ * DBG-00:06:40:361274-I2C1DevMgr_Busy():462:Attempting to write 52 bytes:
+ * DBG-00:06:40:361274-I2C1DevMgr_Busy():462:[0000]: 0xdb 0xc8 0xfe 0xde 0x01 0x00 0xac 0x1b 0x00 0x4b 0x00 0x01 0x32 0x30 0x31 0x35
+ * DBG-00:06:40:361274-I2C1DevMgr_Busy():462:[0010]: 0x30 0x38 0x31 0x39 0x31 0x37 0x30 0x34 0x33 0x36 0x00 0x00 0x00 0x00 0x00 0x00
+ * DBG-00:06:40:361274-I2C1DevMgr_Busy():462:[0020]: 0x00 0x00 0x00 0x00 0x00 0x00 0x00 0x00 0x00 0x00 0x00 0x00 0xe9 0x3a 0x00 0x00
+ * DBG-00:06:40:361274-I2C1DevMgr_Busy():462:[0030]: 0x03 0x00 0x00 0x00
  *
  * @note 2: when printing to a @CON debug level, no data is prepended to the front
  * of the buffer.  This should be used to do menu output to the console.
@@ -271,20 +271,20 @@ void CON_slow_output(
  * @note 2: Do not call this function directly.  Instead, call on of the
  * DBG/LOG/WRN/ERR/CON_printfHexStr() macros.  Printout from these looks
  * something like:
- * DBG_LEVEL-HH:MM:SS:XXX-SomeFunctionName():fileLineNumber:User message here
- * DBG_LEVEL-HH:MM:SS:XXX-SomeFunctionName():fileLineNumber:[0000] 16 bytes
- * DBG_LEVEL-HH:MM:SS:XXX-SomeFunctionName():fileLineNumber:[0010] 16 bytes
+ * DBG_LEVEL-HH:MM:SS:UUUUUU-SomeFunctionName():fileLineNumber:User message here
+ * DBG_LEVEL-HH:MM:SS:UUUUUU-SomeFunctionName():fileLineNumber:[0000] 16 bytes
+ * DBG_LEVEL-HH:MM:SS:UUUUUU-SomeFunctionName():fileLineNumber:[0010] 16 bytes
  * ...
  * etc
  * ...
  *
  * or a real life example:
  *
- * DBG-SLOW-00:06:40:361-I2C1DevMgr_Busy():462:Attempting to write 52 bytes:
- * DBG-SLOW-00:06:40:361-I2C1DevMgr_Busy():462:[0000]: 0xdb 0xc8 0xfe 0xde 0x01 0x00 0xac 0x1b 0x00 0x4b 0x00 0x01 0x32 0x30 0x31 0x35
- * DBG-SLOW-00:06:40:361-I2C1DevMgr_Busy():462:[0010]: 0x30 0x38 0x31 0x39 0x31 0x37 0x30 0x34 0x33 0x36 0x00 0x00 0x00 0x00 0x00 0x00
- * DBG-SLOW-00:06:40:361-I2C1DevMgr_Busy():462:[0020]: 0x00 0x00 0x00 0x00 0x00 0x00 0x00 0x00 0x00 0x00 0x00 0x00 0xe9 0x3a 0x00 0x00
- * DBG-SLOW-00:06:40:361-I2C1DevMgr_Busy():462:[0030]: 0x03 0x00 0x00 0x00
+ * DBG-SLOW-00:06:40:361274-I2C1DevMgr_Busy():462:Attempting to write 52 bytes:
+ * DBG-SLOW-00:06:40:361274-I2C1DevMgr_Busy():462:[0000]: 0xdb 0xc8 0xfe 0xde 0x01 0x00 0xac 0x1b 0x00 0x4b 0x00 0x01 0x32 0x30 0x31 0x35
+ * DBG-SLOW-00:06:40:361274-I2C1DevMgr_Busy():462:[0010]: 0x30 0x38 0x31 0x39 0x31 0x37 0x30 0x34 0x33 0x36 0x00 0x00 0x00 0x00 0x00 0x00
+ * DBG-SLOW-00:06:40:361274-I2C1DevMgr_Busy():462:[0020]: 0x00 0x00 0x00 0x00 0x00 0x00 0x00 0x00 0x00 0x00 0x00 0x00 0xe9 0x3a 0x00 0x00
+ * DBG-SLOW-00:06:40:361274-I2C1DevMgr_Busy():462:[0030]: 0x03 0x00 0x00 0x00
  *
  * @param  [in] dbgLvl: a DC3DbgLevel_t variable that specifies the logging
  * level to use.
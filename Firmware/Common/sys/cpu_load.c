@@ -0,0 +1,257 @@
+/**
+ * @file    cpu_load.c
+ * @brief   CPU load of the whole board and of every FreeRTOS task priority.
+ *
+ * See cpu_load.h for the description.
+ *
+ * The window is timed with the tick (wall clock) and only the cycles of the
+ * tasks that aren't idle are counted, which is what keeps this right even
+ * though the cycle counter stops in __WFI().
+ *
+ * Both hooks run with the FreeRTOS interrupt mask set (PendSV for the switch,
+ * SysTick for the tick, which is at the max syscall priority) so they can't
+ * interrupt each other.  Readers use a QF critical section.
+ *
+ * @date    10/19/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ *
+ * @addtogroup groupCpuLoad
+ * @{
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "cpu_load.h"
+#include "sys_shared.h"                                    /* For MIN() macro */
+#include "stm32f4xx.h"                     /* For DWT and CoreDebug registers */
+#include <string.h>
+
+/* Compile-time called macros ------------------------------------------------*/
+Q_DEFINE_THIS_FILE                  /* For QSPY to know the name of this file */
+
+/* Private typedefs ----------------------------------------------------------*/
+/* Private defines -----------------------------------------------------------*/
+#define CPU_LOAD_WINDOW_TICKS   configTICK_RATE_HZ     /**< Ticks in a window */
+
+/* Private macros ------------------------------------------------------------*/
+
+/**
+ * @brief   Critical section around reading the windows.  Masks the same
+ * interrupts as the FreeRTOS kernel does so both hooks are kept out.
+ */
+#ifdef QF_CRIT_STAT_TYPE
+#define CPU_LOAD_CRIT_STAT      QF_CRIT_STAT_TYPE critStat_;
+#define CPU_LOAD_CRIT_ENTRY()   QF_CRIT_ENTRY(critStat_)
+#define CPU_LOAD_CRIT_EXIT()    QF_CRIT_EXIT(critStat_)
+#else
+#define CPU_LOAD_CRIT_STAT
+#define CPU_LOAD_CRIT_ENTRY()   QF_CRIT_ENTRY(dummy)
+#define CPU_LOAD_CRIT_EXIT()    QF_CRIT_EXIT(dummy)
+#endif
+
+/* Private variables and Local objects ---------------------------------------*/
+static uint32_t l_cpuLoadLast = 0;          /**< DWT count at the last switch */
+static uint8_t  l_cpuLoadPrio = tskIDLE_PRIORITY;   /**< Priority running now */
+static uint32_t l_cpuLoadTicks = 0;               /**< Ticks into this window */
+static uint32_t l_cpuLoadCycles[CPU_LOAD_MAX_PRIO];   /**< This window so far */
+static void    *l_cpuLoadTasks[CPU_LOAD_MAX_PRIO];   /**< Last task at a prio */
+
+/**< Share of each priority in the last CPU_LOAD_WINDOWS windows, in 0.01% */
+static uint16_t l_cpuLoadWins[CPU_LOAD_WINDOWS][CPU_LOAD_MAX_PRIO];
+static uint8_t  l_cpuLoadWinLast = 0;        /**< Most recently closed window */
+static uint8_t  l_cpuLoadNWins = 0;            /**< Windows closed, up to max */
+
+static uint16_t l_cpuLoadPeak[CPU_LOAD_MAX_PRIO];     /**< Window of the peak */
+static uint16_t l_cpuLoadPeakLoad = 0;           /**< Load of watched at peak */
+static bool     l_cpuLoadPeakSet = false;           /**< A peak has been kept */
+static int16_t  l_cpuLoadWatch = -1;        /**< Watched prio or -1 for total */
+
+/* Private function prototypes -----------------------------------------------*/
+
+/**
+ * @brief   Add the cycles since the last switch to the running priority.
+ * @param   None
+ * @return  None
+ */
+static inline void CPU_LOAD_account( void );
+
+/**
+ * @brief   Total of a window (everything but idle).
+ * @param [in] *pWin: const uint16_t pointer to the shares of a window.
+ * @return  uint16_t: load in 0.01%.
+ */
+static uint16_t CPU_LOAD_winTotal( const uint16_t *pWin );
+
+/**
+ * @brief   Average share of a priority over the kept windows.
+ * @param [in] prio: const uint8_t FreeRTOS priority or -1 for the total.
+ * @return  uint16_t: load in 0.01%.  Has to have at least one window.
+ */
+static uint16_t CPU_LOAD_avg( const int16_t prio );
+
+/* Private functions ---------------------------------------------------------*/
+/******************************************************************************/
+static inline void CPU_LOAD_account( void )
+{
+   const uint32_t now = DWT->CYCCNT;
+   l_cpuLoadCycles[l_cpuLoadPrio] += now - l_cpuLoadLast;
+   l_cpuLoadLast = now;
+}
+
+/******************************************************************************/
+static uint16_t CPU_LOAD_winTotal( const uint16_t *pWin )
+{
+   return( CPU_LOAD_FULL - pWin[tskIDLE_PRIORITY] );
+}
+
+/******************************************************************************/
+static uint16_t CPU_LOAD_avg( const int16_t prio )
+{
+   uint32_t sum = 0;
+   for ( uint8_t i = 0; i < l_cpuLoadNWins; i++ ) {
+      sum += ( prio < 0 ) ? CPU_LOAD_winTotal( l_cpuLoadWins[i] ) :
+            l_cpuLoadWins[i][prio];
+   }
+   return( (uint16_t)( sum / l_cpuLoadNWins ) );
+}
+
+/* Public functions ----------------------------------------------------------*/
+/******************************************************************************/
+void CPU_LOAD_init( void )
+{
+   /* The cycle counter is part of the trace block which is off out of reset
+    * unless a debugger turned it on.  AO_PROF_init() may have done this too. */
+   CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+   DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+   l_cpuLoadLast     = DWT->CYCCNT;
+}
+
+/******************************************************************************/
+void CPU_LOAD_setWatchPrio( const uint8_t prio )
+{
+   Q_REQUIRE( prio < CPU_LOAD_MAX_PRIO );
+   l_cpuLoadWatch = prio;
+}
+
+/******************************************************************************/
+void CPU_LOAD_onSwitchIn( unsigned long prio, void *pTask )
+{
+   CPU_LOAD_account();
+   l_cpuLoadPrio = (uint8_t)prio;
+   l_cpuLoadTasks[l_cpuLoadPrio] = pTask;
+}
+
+/******************************************************************************/
+void CPU_LOAD_onTick( void )
+{
+   if ( ++l_cpuLoadTicks < CPU_LOAD_WINDOW_TICKS ) {
+      return;
+   }
+   l_cpuLoadTicks = 0;
+
+   CPU_LOAD_account();
+
+   /* A window is always a second of wall clock no matter how many cycles
+    * the counter saw in it. */
+   const uint8_t win = ( 0 == l_cpuLoadNWins ) ? 0 :
+         ( l_cpuLoadWinLast + 1 ) % CPU_LOAD_WINDOWS;
+   uint16_t *pWin = l_cpuLoadWins[win];
+   uint32_t busy = 0;
+   for ( uint8_t prio = 0; prio < CPU_LOAD_MAX_PRIO; prio++ ) {
+      uint64_t share = (uint64_t)l_cpuLoadCycles[prio] * CPU_LOAD_FULL /
+            SystemCoreClock;
+      pWin[prio] = (uint16_t)MIN( share, CPU_LOAD_FULL );
+      if ( tskIDLE_PRIORITY != prio ) {
+         busy += pWin[prio];
+      }
+      l_cpuLoadCycles[prio] = 0;
+   }
+   pWin[tskIDLE_PRIORITY] = CPU_LOAD_FULL -
+         (uint16_t)MIN( busy, CPU_LOAD_FULL );
+
+   l_cpuLoadWinLast = win;
+   if ( l_cpuLoadNWins < CPU_LOAD_WINDOWS ) {
+      l_cpuLoadNWins++;
+   }
+
+   const uint16_t load = ( l_cpuLoadWatch < 0 ) ? CPU_LOAD_winTotal( pWin ) :
+         pWin[l_cpuLoadWatch];
+   if ( !l_cpuLoadPeakSet || load >= l_cpuLoadPeakLoad ) {
+      memcpy( l_cpuLoadPeak, pWin, sizeof(l_cpuLoadPeak) );
+      l_cpuLoadPeakLoad = load;
+      l_cpuLoadPeakSet  = true;
+   }
+}
+
+/******************************************************************************/
+uint16_t CPU_LOAD_getTotal( const bool b10s )
+{
+   uint16_t load = CPU_LOAD_NA;
+   CPU_LOAD_CRIT_STAT
+   CPU_LOAD_CRIT_ENTRY();
+   if ( 0 != l_cpuLoadNWins ) {
+      load = b10s ? CPU_LOAD_avg( -1 ) :
+            CPU_LOAD_winTotal( l_cpuLoadWins[l_cpuLoadWinLast] );
+   }
+   CPU_LOAD_CRIT_EXIT();
+   return( load );
+}
+
+/******************************************************************************/
+uint16_t CPU_LOAD_getCount( void )
+{
+   uint16_t nRecs = 0;
+   for ( uint8_t prio = 0; prio < CPU_LOAD_MAX_PRIO; prio++ ) {
+      if ( NULL != l_cpuLoadTasks[prio] ) {
+         nRecs++;
+      }
+   }
+   return( nRecs );
+}
+
+/******************************************************************************/
+DC3Error_t CPU_LOAD_get( const uint16_t index, CpuLoadRec_t *pRec )
+{
+   uint16_t n = index;
+   for ( uint8_t prio = 0; prio < CPU_LOAD_MAX_PRIO; prio++ ) {
+      if ( NULL == l_cpuLoadTasks[prio] || 0 != n-- ) {
+         continue;
+      }
+
+      pRec->prio = prio;
+      pRec->name = pcTaskGetTaskName( (TaskHandle_t)l_cpuLoadTasks[prio] );
+
+      CPU_LOAD_CRIT_STAT
+      CPU_LOAD_CRIT_ENTRY();
+      if ( 0 == l_cpuLoadNWins ) {
+         pRec->load1s   = CPU_LOAD_NA;
+         pRec->load10s  = CPU_LOAD_NA;
+         pRec->loadPeak = CPU_LOAD_NA;
+      } else {
+         pRec->load1s   = l_cpuLoadWins[l_cpuLoadWinLast][prio];
+         pRec->load10s  = CPU_LOAD_avg( prio );
+         pRec->loadPeak = l_cpuLoadPeakSet ? l_cpuLoadPeak[prio] : CPU_LOAD_NA;
+      }
+      CPU_LOAD_CRIT_EXIT();
+      return( ERR_NONE );
+   }
+   return( ERR_PROF_INVALID_INDEX );
+}
+
+/******************************************************************************/
+void CPU_LOAD_reset( void )
+{
+   CPU_LOAD_CRIT_STAT
+   CPU_LOAD_CRIT_ENTRY();
+   l_cpuLoadPeakSet  = false;
+   l_cpuLoadPeakLoad = 0;
+   CPU_LOAD_CRIT_EXIT();
+}
+
+/**
+ * @}
+ * end addtogroup groupCpuLoad
+ */
+
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
@@ -0,0 +1,164 @@
+/**
+ * @file    cpu_load.h
+ * @brief   CPU load of the whole board and of every FreeRTOS task priority.
+ *
+ * Every time FreeRTOS switches tasks (traceTASK_SWITCHED_IN() in
+ * FreeRTOSConfig.h), the DWT cycles since the last switch get added to the
+ * priority of the task that was running.  Once a second the tick hook closes
+ * the window and turns the cycles of each priority into its share of that
+ * second.  The last CPU_LOAD_WINDOWS of these are kept for the 10 s average.
+ *
+ * The load is reported as:
+ *    - the total: everything but the idle task, over the last 1 s and 10 s.
+ *    - per priority: the share of each priority over the last 1 s and 10 s.
+ *    - the peak: the share of each priority in the 1 s window where the
+ *    priority set with CPU_LOAD_setWatchPrio() (the CPLR task) was busiest.
+ *    This shows what else was running while it was loaded.
+ *
+ * All the AOs and the CPLR task have their own priority so a priority is the
+ * same thing as a task here.  The idle task is priority 0.
+ *
+ * @note 1: The cycle counter stops while the core sleeps in __WFI() in the
+ * idle hook, so the idle share isn't counted.  It's whatever the other
+ * priorities didn't use.
+ *
+ * @note 2: ISRs aren't tasks.  Their time goes to whichever task they
+ * interrupted, or to idle if nothing was running.
+ *
+ * @date    10/19/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ *
+ * @addtogroup groupCpuLoad
+ * @{
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef CPU_LOAD_H_
+#define CPU_LOAD_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "qp_port.h"                                        /* for QP support */
+#include "DC3Errors.h"                                 /* For DC3 error codes */
+
+/* Exported defines ----------------------------------------------------------*/
+#define CPU_LOAD_MAX_PRIO       configMAX_PRIORITIES /**< FreeRTOS priorities */
+#define CPU_LOAD_WINDOWS        10            /**< 1 s windows in the average */
+#define CPU_LOAD_FULL           10000             /**< 100% in units of 0.01% */
+#define CPU_LOAD_NA             0xFFFF          /**< No window has closed yet */
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief   CPU load of a single FreeRTOS priority.  Loads are in 0.01%.
+ */
+typedef struct {
+   uint8_t     prio;                                   /**< FreeRTOS priority */
+   const char *name;                       /**< Name of the task at this prio */
+   uint16_t    load1s;                          /**< Share of the last second */
+   uint16_t    load10s;     /**< Average share of the last CPU_LOAD_WINDOWS s */
+   uint16_t    loadPeak;         /**< Share when the watched prio was busiest */
+} CpuLoadRec_t;
+
+/* Exported macros -----------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief   Start the cycle counter the load is measured with.
+ *
+ * Has to be called before the scheduler starts.
+ *
+ * @param   None
+ * @return: None
+ */
+void CPU_LOAD_init( void );
+
+/**
+ * @brief   Set the priority whose busiest second is kept as the peak.
+ *
+ * Until this is called, the peak is the second the board as a whole was
+ * busiest.
+ *
+ * @param [in] prio: const uint8_t FreeRTOS priority to watch.
+ * @return: None
+ */
+void CPU_LOAD_setWatchPrio( const uint8_t prio );
+
+/**
+ * @brief   Account for the task that was just switched out.
+ *
+ * Called by FreeRTOS from traceTASK_SWITCHED_IN() with the scheduler's
+ * interrupt mask set.  Not meant to be called by anything else.  It's declared
+ * in FreeRTOSConfig.h with plain types since it's used before the FreeRTOS
+ * types exist.
+ *
+ * @param [in] prio: unsigned long priority of the task switched in.
+ * @param [in] *pTask: void pointer to the TCB (task handle) of that task.
+ * @return: None
+ */
+void CPU_LOAD_onSwitchIn( unsigned long prio, void *pTask );
+
+/**
+ * @brief   Close the window once a second has passed.
+ *
+ * Called from vApplicationTickHook().
+ *
+ * @param   None
+ * @return: None
+ */
+void CPU_LOAD_onTick( void );
+
+/**
+ * @brief   Get the total CPU load (everything but the idle task).
+ *
+ * @param [in] b10s: const bool false for the last second, true for the
+ * average over the last CPU_LOAD_WINDOWS seconds.
+ * @return  uint16_t: load in 0.01% or CPU_LOAD_NA if no window closed yet.
+ */
+uint16_t CPU_LOAD_getTotal( const bool b10s );
+
+/**
+ * @brief   Get the number of priorities that have a record.
+ *
+ * @param   None
+ * @return  uint16_t: number of records available through CPU_LOAD_get().
+ */
+uint16_t CPU_LOAD_getCount( void );
+
+/**
+ * @brief   Get the load of a priority.
+ *
+ * @param [in] index: const uint16_t index of the record, from 0 to
+ * CPU_LOAD_getCount() - 1.  Priorities are ordered from the lowest (idle) up.
+ * @param [out] *pRec: CpuLoadRec_t pointer to where to put the record.
+ * @return  DC3Error_t status:
+ *    @arg ERR_NONE: success.
+ *    @arg ERR_PROF_INVALID_INDEX: no record at this index.
+ */
+DC3Error_t CPU_LOAD_get( const uint16_t index, CpuLoadRec_t *pRec );
+
+/**
+ * @brief   Forget the peak so a new one can be caught.
+ *
+ * @param   None
+ * @return: None
+ */
+void CPU_LOAD_reset( void );
+
+/**
+ * @}
+ * end addtogroup groupCpuLoad
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif                                                         /* CPU_LOAD_H_ */
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
@@ -30,6 +30,20 @@ Q_DEFINE_THIS_FILE                  /* For QSPY to know the name of this file */
 DBG_DEFINE_THIS_MODULE( DC3_DBG_MODL_DB );  /* For debug system to ID this module */
 
 /* Private typedefs ----------------------------------------------------------*/
+
+/**
+ * RAM shadow of the parts of the DB that live on the I2C EEPROM chip.
+ */
+typedef struct {
+   bool isValid;          /**< Shadow was filled from the devices successfully */
+   SettingsDB_t settings;         /**< Main (RW) EEPROM section of the DB */
+   uint8_t snRom[16];                            /**< RO SNR section of EEPROM */
+   uint8_t uiRom[8];                            /**< RO UI64 section of EEPROM */
+   uint32_t dirtyPages;    /**< EEPROM pages (bit per page) changed in RAM that
+                                haven't been confirmed written to the EEPROM */
+   uint32_t pendingPages;     /**< Dirty pages covered by the write in flight */
+} DB_Shadow_t;
+
 /* Private defines -----------------------------------------------------------*/
 /* Private macros ------------------------------------------------------------*/
 /**< Macro to get size of the element stored in the EEPROM memory */
@@ -37,6 +51,7 @@ DBG_DEFINE_THIS_MODULE( DC3_DBG_MODL_DB );  /* For debug system to ID this modul
 
 /**< Macro to get the offset of the element stored in the EEPROM memory */
 #define DB_LOC_OF_ELEM(s,m)      offsetof(s, m)
+
 /* Private variables and Local objects ---------------------------------------*/
 
 /**< Array to specify where all the DB elements reside */
@@ -90,10 +105,339 @@ static const SettingsDB_t DB_defaultEepromSettings = {
       .dbgDevices = DB_DBG_DEVICES_DEF
 };
 
+/**< RAM shadow of the I2C resident part of the DB.  Filled by DB_initShadow() */
+static DB_Shadow_t l_dbShadow;
+
 /* Private function prototypes -----------------------------------------------*/
 const DC3Error_t DB_initToDefault( const DC3AccessType_t accessType );
+
+/**
+ * @brief   Get the RAM shadow of the I2C device a DB location lives on.
+ * @param [in] loc: DB_ElemLoc_t location of the element.
+ * @param [out] *pSize: size_t pointer to the size of the shadow.
+ * @return  uint8_t*: pointer to the shadow or NULL if the location isn't
+ * shadowed.
+ */
+static uint8_t* DB_getShadow( const DB_ElemLoc_t loc, size_t *pSize );
+
+/**
+ * @brief   Write the dirty pages of the shadow through to the EEPROM.
+ *
+ * Only runs of consecutive dirty pages get written.  Every page costs a full
+ * EEPROM write cycle so clean pages in between dirty ones are skipped instead
+ * of being written along with them.  Blocking (BARE) accesses write all the
+ * runs before returning.  Other accesses post the write for the first run only
+ * and DB_writeDone() starts the next one once it's done.
+ *
+ * @param [in] accessType: DC3AccessType_t access to use for the write.
+ * @param [out] *pIsDone: bool pointer that gets set to true if there's nothing
+ * left to write and no write was posted.
+ * @return  DC3Error_t: status of the write (or of posting it for non-blocking
+ * accesses).
+ */
+static const DC3Error_t DB_flushShadow(
+      const DC3AccessType_t accessType,
+      bool* pIsDone
+);
+
+/**
+ * @brief   Mark the EEPROM pages of the shadow covered by a range as dirty.
+ * @param [in] offset: uint32_t offset of the range into the EEPROM.
+ * @param [in] size: size_t length of the range.
+ * @return  None
+ */
+static void DB_markDirty( const uint32_t offset, const size_t size );
+
+/**
+ * @brief   Update an EEPROM element in the shadow and mark its pages dirty.
+ * @param [in] elem: DC3DBElem_t element to update.  Has to live in DB_EEPROM.
+ * @param [in] *pBuffer: const uint8_t pointer to the new value.
+ * @return  None
+ */
+static void DB_setShadowElem(
+      const DC3DBElem_t elem,
+      const uint8_t* const pBuffer
+);
+
+/**
+ * @brief   Check the list of elements of a DB_readElems()/DB_writeElems()
+ * request and add up how much data they take.
+ * @param [in] *pList: const DB_ElemList_t pointer to the list.
+ * @param [out] *pDataLen: uint16_t pointer to the total size of the elements.
+ * @return  DC3Error_t: ERR_NONE if the list is valid, error otherwise.
+ */
+static const DC3Error_t DB_chkElemList(
+      const DB_ElemList_t* const pList,
+      uint16_t* pDataLen
+);
+
+/**
+ * @brief   Read all the listed elements that live on the next I2C device that
+ * has any, starting at pList->currLoc, with one combined read.
+ * @param [in|out] *pList: DB_ElemList_t pointer to the list.
+ * @param [in] accessType: DC3AccessType_t how to access the device.
+ * @param [out] *pIsDone: bool pointer set to true once there's nothing left to
+ * read from any I2C device.
+ * @return  DC3Error_t: status of the read (or of posting it for non-blocking
+ * accesses).
+ */
+static const DC3Error_t DB_readElemsNextDev(
+      DB_ElemList_t* pList,
+      const DC3AccessType_t accessType,
+      bool* pIsDone
+);
+
+/**
+ * @brief   Copy all the listed elements living on pList->currLoc out of the
+ * data returned by a combined read.
+ * @param [in|out] *pList: DB_ElemList_t pointer to the list.
+ * @param [in] *pData: const uint8_t pointer to the data that was read.  Starts
+ * at pList->currStart.
+ * @param [in] bytes: uint16_t number of bytes in pData.
+ * @return  DC3Error_t: ERR_NONE or ERR_DB_ELEM_LENGTH_READ_MISMATCH if the
+ * read came back short.
+ */
+static const DC3Error_t DB_copyElemsFromDev(
+      DB_ElemList_t* pList,
+      const uint8_t* const pData,
+      const uint16_t bytes
+);
 /* Private functions ---------------------------------------------------------*/
 
+/******************************************************************************/
+static uint8_t* DB_getShadow( const DB_ElemLoc_t loc, size_t *pSize )
+{
+   switch( loc ) {
+      case DB_EEPROM:
+         *pSize = sizeof(l_dbShadow.settings);
+         return( (uint8_t *)&l_dbShadow.settings );
+      case DB_SN_ROM:
+         *pSize = sizeof(l_dbShadow.snRom);
+         return( l_dbShadow.snRom );
+      case DB_UI_ROM:
+         *pSize = sizeof(l_dbShadow.uiRom);
+         return( l_dbShadow.uiRom );
+      default:
+         *pSize = 0;
+         return( NULL );
+   }
+}
+
+/******************************************************************************/
+static const DC3Error_t DB_flushShadow(
+      const DC3AccessType_t accessType,
+      bool* pIsDone
+)
+{
+   DC3Error_t status = ERR_NONE;
+   const uint8_t pageSize = I2C_getPageSize( DB_I2C_devices[DB_EEPROM] );
+   *pIsDone = false;
+
+   while ( 0 != l_dbShadow.dirtyPages ) {
+      uint8_t firstPage = 0;
+      while ( !(l_dbShadow.dirtyPages & (1UL << firstPage)) ) {
+         firstPage++;
+      }
+      uint8_t lastPage = firstPage;
+      while ( lastPage < 31 && (l_dbShadow.dirtyPages & (1UL << (lastPage + 1))) ) {
+         lastPage++;
+      }
+
+      uint16_t start = firstPage * pageSize;
+      uint16_t end = (lastPage + 1) * pageSize;
+      if ( end > sizeof(l_dbShadow.settings) ) {
+         end = sizeof(l_dbShadow.settings);
+      }
+      l_dbShadow.pendingPages =
+            (0xFFFFFFFFUL >> (31 - lastPage)) & (0xFFFFFFFFUL << firstPage);
+
+      if ( _DC3_ACCESS_BARE != accessType ) {
+         /* Create the event and directly post it to the right AO. */
+         I2CWriteReqEvt *i2cWriteReqEvt = Q_NEW(I2CWriteReqEvt, I2C1_DEV_RAW_MEM_WRITE_SIG);
+         i2cWriteReqEvt->i2cDev         = DB_I2C_devices[DB_EEPROM];
+         i2cWriteReqEvt->start          = start;
+         i2cWriteReqEvt->bytes          = end - start;
+         i2cWriteReqEvt->accessType     = accessType;
+         i2cWriteReqEvt->priority       = I2C_PRIO_NORMAL;
+         MEMCPY(i2cWriteReqEvt->dataBuf, (uint8_t *)&l_dbShadow.settings + start, end - start);
+         QACTIVE_POST(AO_I2C1DevMgr, (QEvt *)(i2cWriteReqEvt), SysMgr_AO);
+         return( status );          /* DB_writeDone() picks up the next run */
+      }
+
+      uint16_t bytesWritten = 0;
+      status = I2C_writeDevMem(
+            accessType,
+            DB_I2C_devices[DB_EEPROM],
+            start,
+            end - start,
+            end - start,
+            (uint8_t *)&l_dbShadow.settings + start,
+            &bytesWritten
+      );
+      if ( ERR_NONE == status && bytesWritten != end - start ) {
+         status = ERR_DB_ELEM_LENGTH_WRITE_MISMATCH;
+      }
+      if ( ERR_NONE != status ) {
+         l_dbShadow.pendingPages = 0;      /* Failed pages stay dirty for later */
+         break;
+      }
+      l_dbShadow.dirtyPages &= ~l_dbShadow.pendingPages;
+      l_dbShadow.pendingPages = 0;
+   }
+
+   *pIsDone = true;
+   return( status );
+}
+
+/******************************************************************************/
+static void DB_markDirty( const uint32_t offset, const size_t size )
+{
+   const uint8_t pageSize = I2C_getPageSize( DB_I2C_devices[DB_EEPROM] );
+   for ( uint32_t page = offset / pageSize; page <= (offset + size - 1) / pageSize; page++ ) {
+      l_dbShadow.dirtyPages |= (1UL << page);
+   }
+}
+
+/******************************************************************************/
+static void DB_setShadowElem(
+      const DC3DBElem_t elem,
+      const uint8_t* const pBuffer
+)
+{
+   MEMCPY( (uint8_t *)&l_dbShadow.settings + settingsDB[elem].offset,
+         pBuffer, settingsDB[elem].size );
+   DB_markDirty( settingsDB[elem].offset, settingsDB[elem].size );
+}
+
+/******************************************************************************/
+static const DC3Error_t DB_chkElemList(
+      const DB_ElemList_t* const pList,
+      uint16_t* pDataLen
+)
+{
+   *pDataLen = 0;
+
+   if ( 0 == pList->nElems ) {
+      return( ERR_DB_ELEM_SIZE_UNDERFLOW );
+   }
+   if ( pList->nElems > _DC3_DB_MAX_ELEM ) {
+      return( ERR_DB_ELEM_SIZE_OVERFLOW );
+   }
+
+   for ( uint8_t i = 0; i < pList->nElems; i++ ) {
+      if ( pList->elems[i] >= _DC3_DB_MAX_ELEM ) {
+         return( ERR_DB_ELEM_NOT_FOUND );
+      }
+      *pDataLen += settingsDB[pList->elems[i]].size;
+   }
+
+   if ( *pDataLen > DC3_DB_ELEMS_MAX_DATA_LEN ) {
+      return( ERR_DB_ELEM_SIZE_OVERFLOW );
+   }
+   return( ERR_NONE );
+}
+
+/******************************************************************************/
+static const DC3Error_t DB_readElemsNextDev(
+      DB_ElemList_t* pList,
+      const DC3AccessType_t accessType,
+      bool* pIsDone
+)
+{
+   DC3Error_t status = ERR_NONE;
+   *pIsDone = false;
+
+   /* Nothing has to come over the bus if the shadow has everything */
+   if ( l_dbShadow.isValid ) {
+      *pIsDone = true;
+      return( status );
+   }
+
+   for ( ; pList->currLoc < DB_GPIO; pList->currLoc++ ) {
+
+      /* Find the span of the device that covers all the elements on it */
+      uint16_t start = UINT16_MAX;
+      uint16_t end = 0;
+      for ( uint8_t i = 0; i < pList->nElems; i++ ) {
+         const SettingsDB_Desc_t *pDesc = &settingsDB[pList->elems[i]];
+         if ( pDesc->loc == pList->currLoc ) {
+            if ( pDesc->offset < start ) {
+               start = pDesc->offset;
+            }
+            if ( pDesc->offset + pDesc->size > end ) {
+               end = pDesc->offset + pDesc->size;
+            }
+         }
+      }
+
+      if ( 0 == end ) {
+         continue;                      /* Nothing was requested from here */
+      }
+      if ( end - start > MAX_I2C_READ_LEN ) {
+         return( ERR_DB_ELEM_SIZE_OVERFLOW );
+      }
+      pList->currStart = start;
+
+      if ( _DC3_ACCESS_BARE == accessType ) {
+         uint8_t buffer[MAX_I2C_READ_LEN];
+         uint16_t bytesRead = 0;
+         status = I2C_readDevMem(
+               accessType,
+               DB_I2C_devices[pList->currLoc],
+               start,
+               end - start,
+               sizeof(buffer),
+               buffer,
+               &bytesRead
+         );
+         if ( ERR_NONE != status ) {
+            return( status );
+         }
+         status = DB_copyElemsFromDev( pList, buffer, bytesRead );
+         if ( ERR_NONE != status ) {
+            return( status );
+         }
+      } else {
+         /* Create the event and directly post it to the right AO. */
+         I2CReadReqEvt *i2cReadReqEvt  = Q_NEW(I2CReadReqEvt, I2C1_DEV_RAW_MEM_READ_SIG);
+         i2cReadReqEvt->i2cDev         = DB_getI2CDev(pList->currLoc);
+         i2cReadReqEvt->start          = start;
+         i2cReadReqEvt->bytes          = end - start;
+         i2cReadReqEvt->accessType     = accessType;
+         i2cReadReqEvt->priority       = I2C_PRIO_URGENT;
+         QACTIVE_POST(AO_I2C1DevMgr, (QEvt *)(i2cReadReqEvt), SysMgr_AO);
+         return( status );              /* DB_readElemsDone() picks it up */
+      }
+   }
+
+   *pIsDone = true;
+   return( status );
+}
+
+/******************************************************************************/
+static const DC3Error_t DB_copyElemsFromDev(
+      DB_ElemList_t* pList,
+      const uint8_t* const pData,
+      const uint16_t bytes
+)
+{
+   uint16_t dataOffset = 0;
+
+   for ( uint8_t i = 0; i < pList->nElems; i++ ) {
+      const SettingsDB_Desc_t *pDesc = &settingsDB[pList->elems[i]];
+      if ( pDesc->loc == pList->currLoc ) {
+         if ( pDesc->offset + pDesc->size - pList->currStart > bytes ) {
+            return( ERR_DB_ELEM_LENGTH_READ_MISMATCH );
+         }
+         MEMCPY( &pList->dataBuf[dataOffset],
+               &pData[pDesc->offset - pList->currStart], pDesc->size );
+      }
+      dataOffset += pList->elemLen[i];
+   }
+
+   return( ERR_NONE );
+}
+
 /******************************************************************************/
 const DC3Error_t DB_isValid( const DC3AccessType_t accessType )
 {
@@ -153,6 +497,17 @@ DB_isValid_ERR_HANDLE:            /* Handle any error that may have occurred. */
 const DC3Error_t DB_initToDefault( const DC3AccessType_t accessType )
 {
    DC3Error_t status = ERR_NONE;            /* keep track of success/failure */
+   bool isDone = false;
+
+   /* With a shadow, the whole default DB goes out as a single write instead of
+    * one write (and one EEPROM write cycle wait) per element. */
+   if ( l_dbShadow.isValid &&
+         (_DC3_ACCESS_BARE == accessType || _DC3_ACCESS_QPC == accessType) ) {
+      MEMCPY(&l_dbShadow.settings, &DB_defaultEepromSettings, sizeof(l_dbShadow.settings));
+      DB_markDirty( 0, sizeof(l_dbShadow.settings) );
+      status = DB_flushShadow( accessType, &isDone );
+      goto DB_initToDefault_ERR_HANDLE;    /* Stop and jump to error handling */
+   }
 
    switch( accessType ) {
       case _DC3_ACCESS_BARE:
@@ -195,6 +550,7 @@ const DC3Error_t DB_initToDefault( const DC3AccessType_t accessType )
          i2cWriteReqEvt->start           = DB_getElemOffset(_DC3_DB_MAGIC_WORD);
          i2cWriteReqEvt->bytes           = sizeof(DB_defaultEepromSettings);
          i2cWriteReqEvt->accessType      = accessType;
+         i2cWriteReqEvt->priority        = I2C_PRIO_NORMAL;
          MEMCPY(i2cWriteReqEvt->dataBuf, &DB_defaultEepromSettings, sizeof(DB_defaultEepromSettings));
          QACTIVE_POST(AO_I2C1DevMgr, (QEvt *)(i2cWriteReqEvt), SysMgr_AO);
          goto DB_initToDefault_ERR_HANDLE; /* Stop and jump to error handling */
@@ -237,7 +593,32 @@ const DC3Error_t DB_read(
       case DB_EEPROM:                           /* Intentionally fall through */
       case DB_SN_ROM:                           /* Intentionally fall through */
       case DB_UI_ROM:
-         if ( _DC3_ACCESS_BARE == accessType ) {
+         if ( l_dbShadow.isValid ) {
+            /* Serve the element from RAM without touching the I2C bus */
+            size_t shadowSize = 0;
+            const uint8_t *pShadow = DB_getShadow( loc, &shadowSize ) + settingsDB[elem].offset;
+
+            if ( _DC3_ACCESS_BARE == accessType ) {
+               if ( NULL == pBuffer ) {
+                  status = ERR_MEM_NULL_VALUE;
+                  goto DB_read_ERR_HANDLE; /* Stop and jump to error handling */
+               }
+               if ( bufSize < settingsDB[elem].size ) {
+                  status = ERR_MEM_BUFFER_LEN;
+                  goto DB_read_ERR_HANDLE; /* Stop and jump to error handling */
+               }
+               MEMCPY( pBuffer, pShadow, settingsDB[elem].size );
+            } else {
+               /* Whoever asked for the non-blocking read is waiting for the
+                * same event the I2C1DevMgr AO would have sent */
+               I2CReadDoneEvt *i2cReadDoneEvt = Q_NEW(I2CReadDoneEvt, I2C1_DEV_READ_DONE_SIG);
+               i2cReadDoneEvt->i2cDev         = DB_getI2CDev(loc);
+               i2cReadDoneEvt->bytes          = settingsDB[elem].size;
+               i2cReadDoneEvt->status         = ERR_NONE;
+               MEMCPY( i2cReadDoneEvt->dataBuf, pShadow, settingsDB[elem].size );
+               QACTIVE_POST(AO_SysMgr, (QEvt *)(i2cReadDoneEvt), AO_SysMgr);
+            }
+         } else if ( _DC3_ACCESS_BARE == accessType ) {
             uint16_t bytesRead = 0;
             status = I2C_readDevMem(
                   accessType,                   // const DC3AccessType_t accType,
@@ -263,6 +644,7 @@ const DC3Error_t DB_read(
             i2cReadReqEvt->start          = settingsDB[elem].offset;
             i2cReadReqEvt->bytes          = settingsDB[elem].size;
             i2cReadReqEvt->accessType     = accessType;
+            i2cReadReqEvt->priority       = I2C_PRIO_URGENT;
             QACTIVE_POST(AO_I2C1DevMgr, (QEvt *)(i2cReadReqEvt), SysMgr_AO);
          }
          break;
@@ -313,7 +695,22 @@ const DC3Error_t DB_write(
    /* 2. Call the location dependent functions to write the data to DB */
    switch( loc ) {
       case DB_EEPROM:
-         if ( _DC3_ACCESS_BARE == accessType ) {
+         if ( l_dbShadow.isValid ) {
+            if ( NULL == pBuffer ) {
+               status = ERR_MEM_NULL_VALUE;
+               goto DB_write_ERR_HANDLE;   /* Stop and jump to error handling */
+            }
+            if ( bufSize < settingsDB[elem].size ) {
+               status = ERR_MEM_BUFFER_LEN;
+               goto DB_write_ERR_HANDLE;   /* Stop and jump to error handling */
+            }
+
+            /* Update RAM first so reads see the new value right away and then
+             * write the changed pages through to the EEPROM */
+            bool isDone = false;
+            DB_setShadowElem( elem, pBuffer );
+            status = DB_flushShadow( accessType, &isDone );
+         } else if ( _DC3_ACCESS_BARE == accessType ) {
             uint16_t bytesWritten = 0;
             status = I2C_writeDevMem(
                   accessType,                         // const DC3AccessType_t accessType,
@@ -339,6 +736,7 @@ const DC3Error_t DB_write(
             i2cWriteReqEvt->start          = settingsDB[elem].offset;
             i2cWriteReqEvt->bytes          = settingsDB[elem].size;
             i2cWriteReqEvt->accessType     = accessType;
+            i2cWriteReqEvt->priority       = I2C_PRIO_NORMAL;
             MEMCPY(i2cWriteReqEvt->dataBuf, pBuffer, i2cWriteReqEvt->bytes);
             QACTIVE_POST(AO_I2C1DevMgr, (QEvt *)(i2cWriteReqEvt), SysMgr_AO);
          }
@@ -365,6 +763,139 @@ DB_write_ERR_HANDLE:              /* Handle any error that may have occurred. */
    return( status );
 }
 
+/******************************************************************************/
+const DC3Error_t DB_readElems(
+      DB_ElemList_t* pList,
+      const DC3AccessType_t accessType,
+      bool* pIsDone
+)
+{
+   DC3Error_t status = ERR_NONE;
+   uint16_t dataOffset = 0;
+   *pIsDone = false;
+
+   /* 1. Make sure all the elements exist and fit */
+   status = DB_chkElemList( pList, &(pList->dataLen) );
+   if ( ERR_NONE != status ) {
+      goto DB_readElems_ERR_HANDLE;        /* Stop and jump to error handling */
+   }
+
+   /* 2. Read everything that doesn't have to come over the I2C bus right away
+    * and leave room for the rest. */
+   for ( uint8_t i = 0; i < pList->nElems; i++ ) {
+      DC3DBElem_t elem = pList->elems[i];
+      pList->elemLen[i] = settingsDB[elem].size;
+
+      if ( settingsDB[elem].loc >= DB_GPIO || l_dbShadow.isValid ) {
+         status = DB_read(
+               elem,
+               _DC3_ACCESS_BARE,
+               pList->elemLen[i],
+               &pList->dataBuf[dataOffset]
+         );
+         if ( ERR_NONE != status ) {
+            goto DB_readElems_ERR_HANDLE;  /* Stop and jump to error handling */
+         }
+      }
+      dataOffset += pList->elemLen[i];
+   }
+
+   /* 3. Read the rest with one combined read per I2C device */
+   pList->currLoc = DB_EEPROM;
+   status = DB_readElemsNextDev( pList, accessType, pIsDone );
+
+DB_readElems_ERR_HANDLE:          /* Handle any error that may have occurred. */
+   ERR_COND_OUTPUT( status, accessType,
+         "DB read of %d elements from DB: Error 0x%08x\n",
+         pList->nElems, status );
+   return( status );
+}
+
+/******************************************************************************/
+const DC3Error_t DB_readElemsDone(
+      DB_ElemList_t* pList,
+      const DC3AccessType_t accessType,
+      const DC3Error_t status,
+      const uint8_t* const pData,
+      const uint16_t bytes,
+      bool* pIsDone
+)
+{
+   DC3Error_t statusRead = status;
+   *pIsDone = false;
+
+   if ( ERR_NONE != statusRead ) {
+      goto DB_readElemsDone_ERR_HANDLE;    /* Stop and jump to error handling */
+   }
+
+   statusRead = DB_copyElemsFromDev( pList, pData, bytes );
+   if ( ERR_NONE != statusRead ) {
+      goto DB_readElemsDone_ERR_HANDLE;    /* Stop and jump to error handling */
+   }
+
+   /* Move on to the next device */
+   pList->currLoc++;
+   statusRead = DB_readElemsNextDev( pList, accessType, pIsDone );
+
+DB_readElemsDone_ERR_HANDLE:      /* Handle any error that may have occurred. */
+   ERR_COND_OUTPUT( statusRead, accessType,
+         "DB read of %d elements from DB: Error 0x%08x\n",
+         pList->nElems, statusRead );
+   return( statusRead );
+}
+
+/******************************************************************************/
+const DC3Error_t DB_writeElems(
+      const DB_ElemList_t* const pList,
+      const DC3AccessType_t accessType
+)
+{
+   DC3Error_t status = ERR_NONE;
+   uint16_t dataLen = 0;
+   uint16_t dataOffset = 0;
+   bool isDone = false;
+
+   /* The shadow is what lets all the elements go out in a single write */
+   if ( !l_dbShadow.isValid ) {
+      status = ERR_DB_NOT_INIT;
+      goto DB_writeElems_ERR_HANDLE;       /* Stop and jump to error handling */
+   }
+
+   /* 1. Check everything before touching the shadow so a bad list doesn't
+    * leave it half updated. */
+   status = DB_chkElemList( pList, &dataLen );
+   if ( ERR_NONE != status ) {
+      goto DB_writeElems_ERR_HANDLE;       /* Stop and jump to error handling */
+   }
+   if ( dataLen != pList->dataLen ) {
+      status = ERR_DB_ELEM_LENGTH_WRITE_MISMATCH;
+      goto DB_writeElems_ERR_HANDLE;       /* Stop and jump to error handling */
+   }
+   for ( uint8_t i = 0; i < pList->nElems; i++ ) {
+      if ( DB_EEPROM != settingsDB[pList->elems[i]].loc ) {
+         status = ERR_DB_ELEM_IS_READ_ONLY;
+         goto DB_writeElems_ERR_HANDLE;    /* Stop and jump to error handling */
+      }
+      if ( pList->elemLen[i] != settingsDB[pList->elems[i]].size ) {
+         status = ERR_DB_ELEM_LENGTH_WRITE_MISMATCH;
+         goto DB_writeElems_ERR_HANDLE;    /* Stop and jump to error handling */
+      }
+   }
+
+   /* 2. Update all the elements in RAM and write them out together */
+   for ( uint8_t i = 0; i < pList->nElems; i++ ) {
+      DB_setShadowElem( pList->elems[i], &pList->dataBuf[dataOffset] );
+      dataOffset += pList->elemLen[i];
+   }
+   status = DB_flushShadow( accessType, &isDone );
+
+DB_writeElems_ERR_HANDLE:         /* Handle any error that may have occurred. */
+   ERR_COND_OUTPUT( status, accessType,
+         "DB write of %d elements to DB: Error 0x%08x\n",
+         pList->nElems, status );
+   return( status );
+}
+
 /******************************************************************************/
 const DC3Error_t DB_chkElem(
       const DC3DBElem_t elem,
@@ -622,6 +1153,178 @@ DB_readFlash_ERR_HANDLE:           /* Handle any error that may have occurred */
    return( status );
 }
 
+/******************************************************************************/
+const DC3Error_t DB_initShadow( void )
+{
+   DC3Error_t status = ERR_NONE;
+   DB_ElemLoc_t loc = DB_EEPROM;
+
+   l_dbShadow.isValid = false;
+   l_dbShadow.dirtyPages = 0;
+   l_dbShadow.pendingPages = 0;
+
+   for ( loc = DB_EEPROM; loc < DB_GPIO; loc++ ) {
+      size_t shadowSize = 0;
+      uint8_t *pShadow = DB_getShadow( loc, &shadowSize );
+      uint16_t bytesRead = 0;
+
+      status = I2C_readDevMem(
+            _DC3_ACCESS_BARE,
+            DB_I2C_devices[loc],
+            0,
+            shadowSize,
+            shadowSize,
+            pShadow,
+            &bytesRead
+      );
+      if ( ERR_NONE != status ) {
+         goto DB_initShadow_ERR_HANDLE;    /* Stop and jump to error handling */
+      }
+      if ( bytesRead != shadowSize ) {
+         status = ERR_DB_ELEM_LENGTH_READ_MISMATCH;
+         goto DB_initShadow_ERR_HANDLE;    /* Stop and jump to error handling */
+      }
+   }
+
+   l_dbShadow.isValid = true;
+
+DB_initShadow_ERR_HANDLE:         /* Handle any error that may have occurred. */
+   ERR_COND_OUTPUT( status, _DC3_ACCESS_BARE,
+         "Filling RAM shadow of DB from %s: Error 0x%08x\n",
+         CON_i2cDevToStr( DB_I2C_devices[loc] ), status );
+   return( status );
+}
+
+/******************************************************************************/
+const DC3Error_t DB_stage(
+      const DC3DBElem_t elem,
+      const size_t bufSize,
+      const uint8_t* const pBuffer
+)
+{
+   DC3Error_t status = ERR_NONE;
+
+   if ( !l_dbShadow.isValid ) {
+      status = ERR_DB_NOT_INIT;
+      goto DB_stage_ERR_HANDLE;            /* Stop and jump to error handling */
+   }
+   if ( DB_EEPROM != settingsDB[elem].loc ) {
+      status = ERR_DB_ELEM_IS_READ_ONLY;
+      goto DB_stage_ERR_HANDLE;            /* Stop and jump to error handling */
+   }
+   if ( NULL == pBuffer ) {
+      status = ERR_MEM_NULL_VALUE;
+      goto DB_stage_ERR_HANDLE;            /* Stop and jump to error handling */
+   }
+   if ( bufSize < settingsDB[elem].size ) {
+      status = ERR_MEM_BUFFER_LEN;
+      goto DB_stage_ERR_HANDLE;            /* Stop and jump to error handling */
+   }
+
+   /* Writing back the value that's already there doesn't cost a page write */
+   if ( 0 != memcmp( (uint8_t *)&l_dbShadow.settings + settingsDB[elem].offset,
+         pBuffer, settingsDB[elem].size ) ) {
+      DB_setShadowElem( elem, pBuffer );
+   }
+
+DB_stage_ERR_HANDLE:              /* Handle any error that may have occurred. */
+   /* Not having a shadow isn't an error here, it just means the caller has to
+    * fall back to DB_write() */
+   if ( ERR_DB_NOT_INIT != status ) {
+      ERR_COND_OUTPUT( status, _DC3_ACCESS_QPC,
+            "Staging DB write of element %s (%d): Error 0x%08x\n",
+            CON_dbElemToStr( elem ), elem, status );
+   }
+   return( status );
+}
+
+/******************************************************************************/
+const DC3Error_t DB_commit( const DC3AccessType_t accessType, bool* pIsDone )
+{
+   DC3Error_t status = ERR_NONE;
+   *pIsDone = true;
+
+   if ( l_dbShadow.isValid ) {
+      status = DB_flushShadow( accessType, pIsDone );
+   }
+
+   ERR_COND_OUTPUT( status, accessType,
+         "Committing staged DB writes to EEPROM: Error 0x%08x\n", status );
+   return( status );
+}
+
+/******************************************************************************/
+const bool DB_isDirty( void )
+{
+   return( l_dbShadow.isValid && 0 != l_dbShadow.dirtyPages );
+}
+
+/******************************************************************************/
+const DC3Error_t DB_readCached(
+      const DC3DBElem_t elem,
+      const size_t bufSize,
+      uint8_t* pBuffer,
+      uint16_t* pResultLen
+)
+{
+   DC3Error_t status = ERR_NONE;
+   *pResultLen = 0;
+
+   /* Without the shadow, the I2C resident elements would need a blocking read
+    * of the I2C bus which can't be done from an AO. */
+   if ( settingsDB[elem].loc < DB_GPIO && !l_dbShadow.isValid ) {
+      return( ERR_DB_NOT_INIT );
+   }
+
+   status = DB_read( elem, _DC3_ACCESS_BARE, bufSize, pBuffer );
+   if ( ERR_NONE == status ) {
+      *pResultLen = settingsDB[elem].size;
+   }
+   return( status );
+}
+
+/******************************************************************************/
+const DC3Error_t DB_writeDone(
+      const DC3Error_t status,
+      const DC3AccessType_t accessType,
+      bool* pIsDone
+)
+{
+   *pIsDone = true;
+   if ( ERR_NONE != status ) {
+      /* Pages that didn't make it stay dirty and go out with the next commit */
+      l_dbShadow.pendingPages = 0;
+      return( status );
+   }
+
+   l_dbShadow.dirtyPages &= ~l_dbShadow.pendingPages;
+   l_dbShadow.pendingPages = 0;
+
+   /* Start on the next run of dirty pages, if there is one */
+   return( DB_commit( accessType, pIsDone ) );
+}
+
+/******************************************************************************/
+void DB_syncShadow(
+      const DC3I2CDevice_t iDev,
+      const uint16_t offset,
+      const uint16_t bytes,
+      const uint8_t* const pBuffer
+)
+{
+   /* Only the main EEPROM section is writable */
+   if ( !l_dbShadow.isValid || _DC3_EEPROM != iDev ||
+         offset >= sizeof(l_dbShadow.settings) ) {
+      return;
+   }
+
+   uint16_t len = bytes;
+   if ( offset + len > sizeof(l_dbShadow.settings) ) {
+      len = sizeof(l_dbShadow.settings) - offset;
+   }
+   MEMCPY( (uint8_t *)&l_dbShadow.settings + offset, pBuffer, len );
+}
+
 /******************************************************************************/
 const bool DB_isArraysMatch(
       const uint8_t*  dt1,
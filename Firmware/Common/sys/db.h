@@ -83,6 +83,8 @@ typedef enum DB_Operations {
    DB_OP_WRITE,                                   /**< Writing to settings DB */
    DB_OP_INTERNAL,                        /**< Internal only setting used for DB
                                               validation. No response is sent */
+   DB_OP_READ_ELEMS,              /**< Reading a list of elements from the DB */
+   DB_OP_WRITE_ELEMS,               /**< Writing a list of elements to the DB */
    /* Insert more I2C operations here... */
    DB_OP_MAX
 } DB_Operation_t;
@@ -133,6 +135,24 @@ typedef struct {
    uint8_t  dbgDevices;                           /**< Debug devices bitfield */
 } SettingsDB_t;
 
+/**
+ * List of DB elements that get accessed together by a single request.
+ */
+typedef struct {
+   DC3AccessType_t accessType;   /**< How the requester is accessing the DB */
+   uint8_t  nElems;                           /**< Number of elements in elems */
+   DC3DBElem_t elems[_DC3_DB_MAX_ELEM];                 /**< Elements to access */
+   uint8_t  elemLen[_DC3_DB_MAX_ELEM];  /**< Bytes each element takes up in
+                                              dataBuf */
+   uint8_t  dataBuf[DC3_DB_ELEMS_MAX_DATA_LEN];   /**< Values of all elements
+                                              packed in the order of elems */
+   uint16_t dataLen;                         /**< Length of data in dataBuf */
+   DB_ElemLoc_t currLoc;        /**< I2C device the read in progress is from.
+                                     Only used by DB_readElems() */
+   uint16_t currStart;    /**< Offset the read in progress starts at.  Only
+                               used by DB_readElems() */
+} DB_ElemList_t;
+
 /* Exported constants --------------------------------------------------------*/
 /* Exported functions --------------------------------------------------------*/
 
@@ -245,6 +265,87 @@ const DC3Error_t DB_write(
       const uint8_t* const pBuffer
 );
 
+/**
+ * @brief   Start reading a list of elements from DB settings.
+ *
+ * Elements that don't have to come over the I2C bus (flash or anything already
+ * in the RAM shadow of the DB) are read right away.  The rest are read with a
+ * single combined read per I2C device that covers all of the requested
+ * elements on that device.  For non-blocking access, the read of the first
+ * device is posted to the I2C1DevMgr AO and every I2C1_DEV_READ_DONE has to be
+ * passed to DB_readElemsDone() until it reports that the list is done.
+ *
+ * @param  [in|out] *pList: DB_ElemList_t pointer to the list of elements.
+ * The elemLen and dataBuf fields get filled in with the results.
+ * @param  [in] accessType: DC3AccessType_t that specifies how to access the
+ * I2C devices.
+ *    @arg _DC3_ACCESS_BARE: blocking access that is slow.  Don't use once the
+ *                            RTOS is running.
+ *    @arg _DC3_ACCESS_QPC:   non-blocking, event based access.
+ * @param  [out] *pIsDone: bool pointer that gets set to true if all the
+ * elements have been read.
+ * @return DC3Error_t: status of the read operation
+ *    @arg ERR_NONE: if no errors occurred
+ *    other errors if found.
+ */
+const DC3Error_t DB_readElems(
+      DB_ElemList_t* pList,
+      const DC3AccessType_t accessType,
+      bool* pIsDone
+);
+
+/**
+ * @brief   Continue reading a list of elements once a combined I2C read that
+ * DB_readElems() started has finished.
+ *
+ * @param  [in|out] *pList: DB_ElemList_t pointer to the list of elements.
+ * @param  [in] accessType: DC3AccessType_t that specifies how to access the
+ * I2C devices.  Has to be the same one passed to DB_readElems().
+ * @param  [in] status: DC3Error_t status of the I2C read.
+ * @param  [in] *pData: uint8_t pointer to the data that was read.
+ * @param  [in] bytes: uint16_t number of bytes that were read.
+ * @param  [out] *pIsDone: bool pointer that gets set to true if all the
+ * elements have been read.
+ * @return DC3Error_t: status of the read operation
+ *    @arg ERR_NONE: if no errors occurred
+ *    other errors if found.
+ */
+const DC3Error_t DB_readElemsDone(
+      DB_ElemList_t* pList,
+      const DC3AccessType_t accessType,
+      const DC3Error_t status,
+      const uint8_t* const pData,
+      const uint16_t bytes,
+      bool* pIsDone
+);
+
+/**
+ * @brief   Write a list of elements to DB settings.
+ *
+ * All the elements are updated in the RAM shadow of the DB first and then
+ * written out to the EEPROM with a single write.  Nothing is changed if any of
+ * the elements can't be written.
+ *
+ * @note: All the elements have to live in the RW part of the EEPROM and the RAM
+ * shadow of the DB has to be valid.
+ *
+ * @param  [in] *pList: DB_ElemList_t pointer to the list of elements and their
+ * values.
+ * @param  [in] accessType: DC3AccessType_t that specifies how to access the
+ * I2C devices.
+ *    @arg _DC3_ACCESS_BARE: blocking access that is slow.  Don't use once the
+ *                            RTOS is running.
+ *    @arg _DC3_ACCESS_QPC:   non-blocking, event based access.  The write is
+ *                            done once I2C1_DEV_WRITE_DONE comes back.
+ * @return DC3Error_t: status of the write operation
+ *    @arg ERR_NONE: if no errors occurred
+ *    other errors if found.
+ */
+const DC3Error_t DB_writeElems(
+      const DB_ElemList_t* const pList,
+      const DC3AccessType_t accessType
+);
+
 /**
  * @brief   Check an element in the settings DB against default or compiled in.
  *
@@ -384,6 +485,139 @@ const DC3Error_t DB_readFlash(
       uint16_t* pResultLen
 );
 
+/**
+ * @brief   Fill the RAM shadow of the settings DB from the I2C devices.
+ *
+ * This function reads the main EEPROM section of the DB as well as the RO SN
+ * and UI64 sections into RAM.  Once this is done, DB_read() serves all the
+ * elements that live in those sections from RAM and never touches the I2C bus.
+ * DB_write() keeps the shadow up to date and writes the changes through to the
+ * EEPROM.  If this function fails, the DB falls back to reading the devices
+ * directly on every access.
+ *
+ * @note: This uses blocking (bare metal) access so it should only be called at
+ * startup before the RTOS and QF are running.
+ *
+ * @param  None
+ * @return DC3Error_t: status of the read operation
+ *    @arg ERR_NONE: if no errors occurred
+ *    other errors if found.
+ */
+const DC3Error_t DB_initShadow( void );
+
+/**
+ * @brief   Stage a write of an EEPROM element in the RAM shadow.
+ *
+ * The new value is visible to DB_read() right away but nothing is written to
+ * the EEPROM until DB_commit() is called.  This lets several element writes
+ * that land on the same EEPROM pages share a single page write (and the post
+ * write wait that comes with it) instead of paying for one each.  Writing the
+ * value an element already has doesn't dirty anything.
+ *
+ * @param  [in] elem: DC3DBElem_t element to write.  Has to live in the EEPROM.
+ * @param  [in] bufSize: size_t size of the buffer.
+ * @param  [in] *pBuffer: const uint8_t pointer to the new value.
+ * @return DC3Error_t: status of the operation
+ *    @arg ERR_NONE: if the write was staged.
+ *    @arg ERR_DB_NOT_INIT: if there's no shadow.  Use DB_write() instead.
+ *    other errors if found.
+ */
+const DC3Error_t DB_stage(
+      const DC3DBElem_t elem,
+      const size_t bufSize,
+      const uint8_t* const pBuffer
+);
+
+/**
+ * @brief   Write everything staged in the RAM shadow out to the EEPROM.
+ *
+ * Only whole runs of dirty pages get written.  Blocking (BARE) accesses write
+ * everything before returning.  Non-blocking accesses post the write of the
+ * first run and whoever gets the I2C1_DEV_WRITE_DONE event has to pass it to
+ * DB_writeDone() to continue with the rest.
+ *
+ * @param  [in] accessType: DC3AccessType_t access to use for the write.
+ * @param  [out] *pIsDone: bool pointer that gets set to true if everything
+ * has been written (or there was nothing to write) and no write is pending.
+ * @return DC3Error_t: status of the operation
+ *    @arg ERR_NONE: if no errors occurred
+ *    other errors if found.
+ */
+const DC3Error_t DB_commit( const DC3AccessType_t accessType, bool* pIsDone );
+
+/**
+ * @brief   Check whether the RAM shadow has changes that haven't made it to
+ * the EEPROM yet.
+ *
+ * @param  None
+ * @return bool: true if a DB_commit() is needed, false otherwise.
+ */
+const bool DB_isDirty( void );
+
+/**
+ * @brief   Read an element right away without waiting on the I2C bus.
+ *
+ * Elements that live on the I2C devices come from the RAM shadow and the rest
+ * come from wherever they live (flash, etc).  Safe to call from any AO.
+ *
+ * @param  [in] elem: DC3DBElem_t element to read.
+ * @param  [in] bufSize: size_t size of the pBuffer.
+ * @param  [out] *pBuffer: uint8_t pointer to a buffer where to store the
+ * element.  Has to be at least as big as the element.
+ * @param  [out] *pResultLen: uint16_t pointer to the length of the element
+ * stored in the buffer on return.  0 if it couldn't be read.
+ * @return DC3Error_t: status of the read operation
+ *    @arg ERR_NONE: if no errors occurred
+ *    @arg ERR_DB_NOT_INIT: if the element lives on an I2C device and there's no
+ *    shadow to read it from.
+ *    other errors if found.
+ */
+const DC3Error_t DB_readCached(
+      const DC3DBElem_t elem,
+      const size_t bufSize,
+      uint8_t* pBuffer,
+      uint16_t* pResultLen
+);
+
+/**
+ * @brief   Finish a write of the RAM shadow to the EEPROM.
+ *
+ * Non-blocking writes of the shadow don't know whether they actually made it
+ * to the EEPROM until the I2C1_DEV_WRITE_DONE event comes back.  Whoever gets
+ * that event (SysMgr) should call this function with its status.  If there
+ * are more dirty pages left, the write of the next run gets posted.  Pages
+ * that failed to get written stay dirty and are written again by the next
+ * commit.
+ *
+ * @param  [in] status: DC3Error_t status of the write.
+ * @param  [in] accessType: DC3AccessType_t access to use for the next write.
+ * @param  [out] *pIsDone: bool pointer that gets set to true if no more writes
+ * are pending.
+ * @return DC3Error_t: status of the write or of posting the next one.
+ */
+const DC3Error_t DB_writeDone(
+      const DC3Error_t status,
+      const DC3AccessType_t accessType,
+      bool* pIsDone
+);
+
+/**
+ * @brief   Update the RAM shadow after something other than the DB wrote to
+ * one of the I2C devices the DB lives on.
+ *
+ * @param  [in] iDev: DC3I2CDevice_t device that was written.
+ * @param  [in] offset: uint16_t offset from the beginning of the device.
+ * @param  [in] bytes: uint16_t number of bytes written.
+ * @param  [in] *pBuffer: uint8_t pointer to the data that was written.
+ * @return None
+ */
+void DB_syncShadow(
+      const DC3I2CDevice_t iDev,
+      const uint16_t offset,
+      const uint16_t bytes,
+      const uint8_t* const pBuffer
+);
+
 /**
  * @brief   Checks 2 arrays of same length to see if their contents match.
  *
@@ -0,0 +1,166 @@
+/**
+ * @file    health.c
+ * @brief   Snapshot of the health counters of the board for the health stream.
+ *
+ * See health.h for the description.
+ *
+ * @date    10/19/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ *
+ * @addtogroup groupHealth
+ * @{
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "health.h"
+#include "mem_stats.h"                    /* For pool and queue usage records */
+#include "i2c.h"                               /* For I2C bus health counters */
+#include "serial.h"                          /* For serial port drop counters */
+#include "cpu_load.h"                                     /* For the CPU load */
+#include "LWIPMgr.h"                              /* For UDP session counters */
+
+/* Only the counters are read here, which doesn't touch the (non-reentrant)
+ * lwIP stack itself, so lwip.h and its LWIP_ALLOWED check aren't needed. */
+#include "lwip/opt.h"
+#include "lwip/stats.h"
+
+/* Compile-time called macros ------------------------------------------------*/
+Q_DEFINE_THIS_FILE                  /* For QSPY to know the name of this file */
+
+/* Private typedefs ----------------------------------------------------------*/
+/* Private defines -----------------------------------------------------------*/
+/* Private macros ------------------------------------------------------------*/
+/* Private variables and Local objects ---------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+
+/**
+ * @brief   Fill in the lwIP counters of a health msg.
+ * @param [out] *stats: unsigned long pointer to the stats of the msg.
+ * @return  None
+ */
+static void HEALTH_fillLwip( unsigned long *stats );
+
+/**
+ * @brief   Append the pool and queue records to a health msg.
+ * @param [in|out] *pMsg: DC3HealthPayloadMsg pointer to the payload.  The
+ * header has to be filled in already.
+ * @return  None
+ */
+static void HEALTH_fillMem( struct DC3HealthPayloadMsg *pMsg );
+
+/* Private functions ---------------------------------------------------------*/
+/******************************************************************************/
+static void HEALTH_fillLwip( unsigned long *stats )
+{
+   /* Anything lwIP isn't built to count stays not available */
+   for ( uint8_t i = DC3_HEALTH_ETH_RX; i <= DC3_HEALTH_LWIP_MEM_ERRS; i++ ) {
+      stats[i] = DC3_HEALTH_STAT_NA;
+   }
+
+#if LWIP_STATS
+   /* Counters are 32 bit (LWIP_STATS_LARGE) so each read is atomic.  They
+    * don't have to be consistent with each other. */
+#if LINK_STATS
+   stats[DC3_HEALTH_ETH_RX]       = lwip_stats.link.recv;
+   stats[DC3_HEALTH_ETH_TX]       = lwip_stats.link.xmit;
+   stats[DC3_HEALTH_ETH_DROPS]    = lwip_stats.link.drop + lwip_stats.link.err;
+#endif
+#if IP_STATS
+   stats[DC3_HEALTH_IP_DROPS]     = lwip_stats.ip.drop;
+#endif
+#if UDP_STATS
+   stats[DC3_HEALTH_UDP_DROPS]    = lwip_stats.udp.drop;
+#endif
+#if TCP_STATS
+   stats[DC3_HEALTH_TCP_DROPS]    = lwip_stats.tcp.drop;
+#endif
+#if MEM_STATS
+   stats[DC3_HEALTH_LWIP_MEM_ERRS] = lwip_stats.mem.err;
+#endif
+#endif                                                          /* LWIP_STATS */
+}
+
+/******************************************************************************/
+static void HEALTH_fillMem( struct DC3HealthPayloadMsg *pMsg )
+{
+   MemStatsRec_t rec;
+
+   /* Stacks come last and take a scan each so they are left out */
+   uint16_t nRecs = MEM_STATS_getCount() - MEM_STATS_getStackCount();
+
+   if ( nRecs > DC3_HEALTH_MAX_MEM_RECS ) {
+      nRecs = DC3_HEALTH_MAX_MEM_RECS;
+   }
+
+   /* mem_stats already orders them pools first, then queues */
+   for ( uint16_t i = 0; i < nRecs; i++ ) {
+      if ( ERR_NONE != MEM_STATS_get( i, &rec ) ) {
+         break;
+      }
+
+      if ( _DC3_MEM_STATS_EVT_POOL == rec.kind ||
+           _DC3_MEM_STATS_MEM_POOL == rec.kind ) {
+         pMsg->_stats[DC3_HEALTH_N_POOLS]++;
+      } else {
+         pMsg->_stats[DC3_HEALTH_N_QUEUES]++;
+      }
+
+      pMsg->_stats[pMsg->_stats_repeated_len++] = DC3_HEALTH_MEM_REC(
+            rec.stats[DC3_MEM_STAT_FREE],
+            rec.stats[DC3_MEM_STAT_MIN_FREE]
+      );
+   }
+}
+
+/* Public functions ----------------------------------------------------------*/
+/******************************************************************************/
+uint32_t HEALTH_getUptimeMs( void )
+{
+   return( (uint32_t)( ((uint64_t)xTaskGetTickCount() * 1000U) /
+         configTICK_RATE_HZ ) );
+}
+
+/******************************************************************************/
+void HEALTH_fill( struct DC3HealthPayloadMsg *pMsg )
+{
+   unsigned long *stats = pMsg->_stats;
+
+   Q_ASSERT(
+         DC3_HEALTH_HDR_LEN + DC3_HEALTH_MAX_MEM_RECS <= Q_DIM(pMsg->_stats)
+   );
+
+   pMsg->_uptimeMs = HEALTH_getUptimeMs();
+
+   for ( uint8_t i = 0; i < DC3_HEALTH_HDR_LEN; i++ ) {
+      stats[i] = 0;
+   }
+   pMsg->_stats_repeated_len = DC3_HEALTH_HDR_LEN;
+
+   const uint16_t load = CPU_LOAD_getTotal( false );
+   stats[DC3_HEALTH_CPU_LOAD] = ( CPU_LOAD_NA == load ) ? DC3_HEALTH_STAT_NA :
+         load;
+
+   for ( I2C_Bus_t iBus = I2CBus1; iBus < MAX_I2C_BUS; iBus++ ) {
+      stats[DC3_HEALTH_I2C_ERRS]       += I2C_getErrorCount( iBus );
+      stats[DC3_HEALTH_I2C_RECOVERIES] += I2C_getRecoveryCount( iBus );
+   }
+
+   for ( SerialPort_T port = SERIAL_UART1; port < SERIAL_MAX; port++ ) {
+      stats[DC3_HEALTH_SER_RX_DROPS] += Serial_getRxDropCount( port );
+      stats[DC3_HEALTH_SER_TX_DROPS] += Serial_getTxDropCount( port );
+   }
+
+   HEALTH_fillLwip( stats );
+   stats[DC3_HEALTH_ETH_SESSIONS]      = ETH_getSessionCount();
+   stats[DC3_HEALTH_ETH_SESSION_DROPS] = ETH_getSessionDropCount();
+   HEALTH_fillMem( pMsg );
+}
+
+/**
+ * @}
+ * end addtogroup groupHealth
+ */
+
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
@@ -0,0 +1,74 @@
+/**
+ * @file    health.h
+ * @brief   Snapshot of the health counters of the board for the health stream.
+ *
+ * Gathers the counters that other modules already keep into the stats field of
+ * a DC3HealthPayloadMsg (see DC3HealthStat_t in DC3CommApi.h for the layout):
+ *    - CPU load over the last second from cpu_load.h.
+ *    - I2C bus error and recovery counts.
+ *    - serial RX and TX drop counts.
+ *    - lwIP link, IP, UDP, TCP, and heap counters.
+ *    - free and fewest ever free of every pool and queue from mem_stats.h, up
+ *    to DC3_HEALTH_MAX_MEM_RECS of them.
+ *
+ * Nothing is counted here.  CommMgr calls HEALTH_fill() every time the health
+ * timer goes off and pushes the result over UDP so a host can watch many
+ * boards without polling each one.
+ *
+ * @date    10/19/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ *
+ * @addtogroup groupHealth
+ * @{
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef HEALTH_H_
+#define HEALTH_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "qp_port.h"                                        /* for QP support */
+#include "DC3CommApi.h"                               /* For the stats layout */
+
+/* Exported defines ----------------------------------------------------------*/
+/* Exported types ------------------------------------------------------------*/
+/* Exported macros -----------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief   Get the time since boot.
+ *
+ * @param   None
+ * @return  uint32_t: ms since the scheduler started.  Wraps after ~49 days.
+ */
+uint32_t HEALTH_getUptimeMs( void );
+
+/**
+ * @brief   Fill in the uptime and the stats of a health msg.
+ *
+ * The errorCode, intervalMs, port, and seq fields are left alone for the
+ * caller to set.
+ *
+ * @param [out] *pMsg: DC3HealthPayloadMsg pointer to the payload to fill.
+ * @return: None
+ */
+void HEALTH_fill( struct DC3HealthPayloadMsg *pMsg );
+
+/**
+ * @}
+ * end addtogroup groupHealth
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif                                                           /* HEALTH_H_ */
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
@@ -0,0 +1,429 @@
+/**
+ * @file    mem_stats.c
+ * @brief   Usage and high-water marks of the event pools, event queues, and
+ * stacks.
+ *
+ * See mem_stats.h for the description.  Nothing is counted here.  QMPool and
+ * QEQueue already keep the counters so this only finds them and copies them
+ * out when asked.  The stacks are the exception: the part of them that was
+ * never touched is found by scanning for the fill pattern.
+ *
+ * @date    10/19/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ *
+ * @addtogroup groupMemStats
+ * @{
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "mem_stats.h"
+#include "stm32f4xx.h"                                     /* For __get_MSP() */
+
+/* Compile-time called macros ------------------------------------------------*/
+Q_DEFINE_THIS_FILE                  /* For QSPY to know the name of this file */
+
+/* Private typedefs ----------------------------------------------------------*/
+
+/**
+ * @brief   A registered pool or queue.
+ */
+typedef struct {
+   const void *pObj;                      /**< QMPool or QEQueue it refers to */
+   const char *name;                                  /**< Name given with it */
+} MemStatsReg_t;
+
+/**
+ * @brief   A registered task that isn't an AO.
+ */
+typedef struct {
+   void       *pTask;                           /**< TaskHandle_t of the task */
+   uint32_t    stackBytes;                       /**< Stack size it was given */
+} MemStatsTask_t;
+
+/* Private defines -----------------------------------------------------------*/
+
+/**
+ * @brief   Limits of the main stack from the linker script.  It grows down
+ * from _estack and _Min_Stack_Size bytes are set aside for it.  The lowest two
+ * bits of _estack are dropped the same way the core does when it loads the MSP.
+ */
+#define MEM_STATS_MAIN_TOP      ( (uint32_t)&_estack & ~3U )
+#define MEM_STATS_MAIN_SIZE     ( (uint32_t)&_Min_Stack_Size )
+#define MEM_STATS_MAIN_BOTTOM   ( MEM_STATS_MAIN_TOP - MEM_STATS_MAIN_SIZE )
+
+/**
+ * @brief   Bytes under the stack pointer left alone when painting the main
+ * stack.  Keeps the frame of MEM_STATS_paintMainStack() itself out of it.
+ */
+#define MEM_STATS_PAINT_MARGIN  64U
+
+/* Private macros ------------------------------------------------------------*/
+
+/**
+ * @brief   Critical section around reading the counters of a pool or queue.
+ * Same as the one QMPool and QEQueue update them in.
+ */
+#ifdef QF_CRIT_STAT_TYPE
+#define MEM_STATS_CRIT_STAT     QF_CRIT_STAT_TYPE critStat_;
+#define MEM_STATS_CRIT_ENTRY()  QF_CRIT_ENTRY(critStat_)
+#define MEM_STATS_CRIT_EXIT()   QF_CRIT_EXIT(critStat_)
+#else
+#define MEM_STATS_CRIT_STAT
+#define MEM_STATS_CRIT_ENTRY()  QF_CRIT_ENTRY(dummy)
+#define MEM_STATS_CRIT_EXIT()   QF_CRIT_EXIT(dummy)
+#endif
+
+/* Private variables and Local objects ---------------------------------------*/
+static MemStatsReg_t l_memStatsPools[MEM_STATS_MAX_POOLS];   /**< Other pools */
+static uint8_t       l_memStatsNPools = 0;          /**< Used l_memStatsPools */
+static MemStatsReg_t l_memStatsQueues[MEM_STATS_MAX_QUEUES]; /**< Raw/defer */
+static uint8_t       l_memStatsNQueues = 0;        /**< Used l_memStatsQueues */
+static MemStatsTask_t l_memStatsTasks[MEM_STATS_MAX_TASKS];      /**< Not AOs */
+static uint8_t       l_memStatsNTasks = 0;          /**< Used l_memStatsTasks */
+static uint32_t      l_memStatsAoStackBytes = 0;   /**< Stack size of each AO */
+static bool          l_memStatsMainPainted = false;      /**< MSP was painted */
+
+extern uint32_t      _estack;          /**< Top of main stack (linker script) */
+extern uint32_t      _Min_Stack_Size;     /**< Its size. Only address is used */
+
+/* Private function prototypes -----------------------------------------------*/
+
+/**
+ * @brief   Fill in a record from a memory pool.
+ * @param [in] *pPool: const QMPool pointer to the pool.
+ * @param [in] id: const uint32_t QF pool ID or 0.
+ * @param [out] *pRec: MemStatsRec_t pointer to the record.
+ * @return  None
+ */
+static void MEM_STATS_fromPool(
+      QMPool const *pPool,
+      const uint32_t id,
+      MemStatsRec_t *pRec
+);
+
+/**
+ * @brief   Fill in a record from an event queue.
+ * @param [in] *pQueue: const QEQueue pointer to the queue.
+ * @param [in] id: const uint32_t QF priority of the AO or 0.
+ * @param [out] *pRec: MemStatsRec_t pointer to the record.
+ * @return  None
+ */
+static void MEM_STATS_fromQueue(
+      QEQueue const *pQueue,
+      const uint32_t id,
+      MemStatsRec_t *pRec
+);
+
+/**
+ * @brief   Count the started Active Objects.
+ * @param   None
+ * @return  uint16_t: number of AOs registered with QF.
+ */
+static uint16_t MEM_STATS_aoCount( void );
+
+/**
+ * @brief   Find the Nth started Active Object.
+ * @param [in] n: uint16_t how many started AOs to skip.
+ * @return  uint8_t: QF priority of the AO or 0 if there aren't that many.
+ */
+static uint8_t MEM_STATS_nthAoPrio( uint16_t n );
+
+/**
+ * @brief   Count the task stacks.
+ * @param   None
+ * @return  uint16_t: number of task stack records.
+ */
+static uint16_t MEM_STATS_taskCount( void );
+
+#if CPLR_APP
+/**
+ * @brief   Fill in a record from the stack of a FreeRTOS task.
+ * @param [in] *pTask: void pointer to the TaskHandle_t of the task.
+ * @param [in] stackBytes: const uint32_t stack size of the task in bytes.
+ * @param [out] *pRec: MemStatsRec_t pointer to the record.
+ * @return  None
+ */
+static void MEM_STATS_fromTask(
+      void *pTask,
+      const uint32_t stackBytes,
+      MemStatsRec_t *pRec
+);
+#endif                                                            /* CPLR_APP */
+
+/**
+ * @brief   Fill in a record from the main stack.
+ * @param [out] *pRec: MemStatsRec_t pointer to the record.
+ * @return  None
+ */
+static void MEM_STATS_fromMainStack( MemStatsRec_t *pRec );
+
+/* Private functions ---------------------------------------------------------*/
+/******************************************************************************/
+static void MEM_STATS_fromPool(
+      QMPool const *pPool,
+      const uint32_t id,
+      MemStatsRec_t *pRec
+)
+{
+   MEM_STATS_CRIT_STAT
+   pRec->stats[DC3_MEM_STAT_ID]        = id;
+   pRec->stats[DC3_MEM_STAT_BLK_SIZE]  = pPool->blockSize;
+   pRec->stats[DC3_MEM_STAT_TOTAL]     = pPool->nTot;
+
+   MEM_STATS_CRIT_ENTRY();
+   pRec->stats[DC3_MEM_STAT_FREE]      = pPool->nFree;
+   pRec->stats[DC3_MEM_STAT_MIN_FREE]  = pPool->nMin;
+   pRec->stats[DC3_MEM_STAT_GETS]      = pPool->nGet;
+   pRec->stats[DC3_MEM_STAT_GET_FAILS] = pPool->nGetFail;
+   MEM_STATS_CRIT_EXIT();
+}
+
+/******************************************************************************/
+static void MEM_STATS_fromQueue(
+      QEQueue const *pQueue,
+      const uint32_t id,
+      MemStatsRec_t *pRec
+)
+{
+   MEM_STATS_CRIT_STAT
+   pRec->stats[DC3_MEM_STAT_ID]        = id;
+   pRec->stats[DC3_MEM_STAT_BLK_SIZE]  = 0;
+   /* The front event sits outside of the ring.  QEQueue_init() counts it. */
+   pRec->stats[DC3_MEM_STAT_TOTAL]     = pQueue->end + 1;
+
+   MEM_STATS_CRIT_ENTRY();
+   pRec->stats[DC3_MEM_STAT_FREE]      = pQueue->nFree;
+   pRec->stats[DC3_MEM_STAT_MIN_FREE]  = pQueue->nMin;
+   MEM_STATS_CRIT_EXIT();
+
+   pRec->stats[DC3_MEM_STAT_GETS]      = 0;
+   pRec->stats[DC3_MEM_STAT_GET_FAILS] = 0;
+}
+
+/******************************************************************************/
+static uint16_t MEM_STATS_aoCount( void )
+{
+   uint16_t nAOs = 0;
+   for ( uint8_t prio = 1; prio <= QF_MAX_ACTIVE; prio++ ) {
+      if ( NULL != QF_active_[prio] ) {
+         nAOs++;
+      }
+   }
+   return( nAOs );
+}
+
+/******************************************************************************/
+static uint8_t MEM_STATS_nthAoPrio( uint16_t n )
+{
+   for ( uint8_t prio = 1; prio <= QF_MAX_ACTIVE; prio++ ) {
+      if ( NULL != QF_active_[prio] && 0 == n-- ) {
+         return( prio );
+      }
+   }
+   return( 0 );
+}
+
+/******************************************************************************/
+static uint16_t MEM_STATS_taskCount( void )
+{
+#if CPLR_APP
+   /* The idle task, every AO, and the registered ones */
+   return( 1 + MEM_STATS_aoCount() + l_memStatsNTasks );
+#else
+   return( 0 );                       /* No tasks without FreeRTOS */
+#endif
+}
+
+#if CPLR_APP
+/******************************************************************************/
+static void MEM_STATS_fromTask(
+      void *pTask,
+      const uint32_t stackBytes,
+      MemStatsRec_t *pRec
+)
+{
+   /* FreeRTOS filled the stack when it created the task.  The high-water mark
+    * is the number of words at the bottom that still have the fill in them. */
+   TaskHandle_t task = (TaskHandle_t)pTask;
+   const uint32_t unused = uxTaskGetStackHighWaterMark( task ) *
+         sizeof(StackType_t);
+
+   pRec->kind                          = _DC3_MEM_STATS_TASK_STACK;
+   pRec->name                          = pcTaskGetTaskName( task );
+   pRec->stats[DC3_MEM_STAT_ID]        = uxTaskPriorityGet( task );
+   pRec->stats[DC3_MEM_STAT_BLK_SIZE]  = 0;
+   pRec->stats[DC3_MEM_STAT_TOTAL]     = stackBytes;
+   pRec->stats[DC3_MEM_STAT_FREE]      = unused;
+   pRec->stats[DC3_MEM_STAT_MIN_FREE]  = unused;
+   pRec->stats[DC3_MEM_STAT_GETS]      = 0;
+   pRec->stats[DC3_MEM_STAT_GET_FAILS] = 0;
+}
+#endif                                                            /* CPLR_APP */
+
+/******************************************************************************/
+static void MEM_STATS_fromMainStack( MemStatsRec_t *pRec )
+{
+   /* Same as uxTaskGetStackHighWaterMark(): count up from the bottom until the
+    * fill is gone.  ISRs can use the stack while this runs but they only ever
+    * make the untouched part smaller so it doesn't matter which they see. */
+   const uint8_t *pByte = (const uint8_t *)MEM_STATS_MAIN_BOTTOM;
+   const uint8_t *pTop  = (const uint8_t *)MEM_STATS_MAIN_TOP;
+   while ( pByte < pTop && MEM_STATS_STACK_FILL == *pByte ) {
+      pByte++;
+   }
+   const uint32_t unused = (uint32_t)pByte - MEM_STATS_MAIN_BOTTOM;
+
+   pRec->kind                          = _DC3_MEM_STATS_MAIN_STACK;
+   pRec->name                          = "MSP";
+   pRec->stats[DC3_MEM_STAT_ID]        = 0;
+   pRec->stats[DC3_MEM_STAT_BLK_SIZE]  = 0;
+   pRec->stats[DC3_MEM_STAT_TOTAL]     = MEM_STATS_MAIN_SIZE;
+   pRec->stats[DC3_MEM_STAT_FREE]      = unused;
+   pRec->stats[DC3_MEM_STAT_MIN_FREE]  = unused;
+   pRec->stats[DC3_MEM_STAT_GETS]      = 0;
+   pRec->stats[DC3_MEM_STAT_GET_FAILS] = 0;
+}
+
+/* Public functions ----------------------------------------------------------*/
+/******************************************************************************/
+void MEM_STATS_regPool( QMPool const *pPool, const char *name )
+{
+   /* Only called from main() and AO constructors before QF_run() */
+   Q_ASSERT( l_memStatsNPools < MEM_STATS_MAX_POOLS );
+   l_memStatsPools[l_memStatsNPools].pObj = pPool;
+   l_memStatsPools[l_memStatsNPools].name = name;
+   l_memStatsNPools++;
+}
+
+/******************************************************************************/
+void MEM_STATS_regQueue( QEQueue const *pQueue, const char *name )
+{
+   Q_ASSERT( l_memStatsNQueues < MEM_STATS_MAX_QUEUES );
+   l_memStatsQueues[l_memStatsNQueues].pObj = pQueue;
+   l_memStatsQueues[l_memStatsNQueues].name = name;
+   l_memStatsNQueues++;
+}
+
+/******************************************************************************/
+void MEM_STATS_setAoStackSize( const uint32_t stackBytes )
+{
+   l_memStatsAoStackBytes = stackBytes;
+}
+
+/******************************************************************************/
+void MEM_STATS_regTask( void *pTask, const uint32_t stackBytes )
+{
+   Q_ASSERT( l_memStatsNTasks < MEM_STATS_MAX_TASKS );
+   l_memStatsTasks[l_memStatsNTasks].pTask      = pTask;
+   l_memStatsTasks[l_memStatsNTasks].stackBytes = stackBytes;
+   l_memStatsNTasks++;
+}
+
+/******************************************************************************/
+void MEM_STATS_paintMainStack( void )
+{
+   uint8_t *pByte = (uint8_t *)MEM_STATS_MAIN_BOTTOM;
+   uint8_t *pEnd  = (uint8_t *)( __get_MSP() - MEM_STATS_PAINT_MARGIN );
+   while ( pByte < pEnd ) {
+      *pByte++ = MEM_STATS_STACK_FILL;
+   }
+   l_memStatsMainPainted = true;
+}
+
+/******************************************************************************/
+uint16_t MEM_STATS_getCount( void )
+{
+   return( QF_getPoolNum() + l_memStatsNPools + MEM_STATS_aoCount() +
+         l_memStatsNQueues + MEM_STATS_getStackCount() );
+}
+
+/******************************************************************************/
+uint16_t MEM_STATS_getStackCount( void )
+{
+   return( MEM_STATS_taskCount() + ( l_memStatsMainPainted ? 1 : 0 ) );
+}
+
+/******************************************************************************/
+DC3Error_t MEM_STATS_get( const uint16_t index, MemStatsRec_t *pRec )
+{
+   uint16_t n = index;
+
+   if ( n < QF_getPoolNum() ) {
+      pRec->kind = _DC3_MEM_STATS_EVT_POOL;
+      pRec->name = NULL;
+      MEM_STATS_fromPool( QF_getPool( n + 1 ), n + 1, pRec );
+      return( ERR_NONE );
+   }
+   n -= QF_getPoolNum();
+
+   if ( n < l_memStatsNPools ) {
+      pRec->kind = _DC3_MEM_STATS_MEM_POOL;
+      pRec->name = l_memStatsPools[n].name;
+      MEM_STATS_fromPool( l_memStatsPools[n].pObj, 0, pRec );
+      return( ERR_NONE );
+   }
+   n -= l_memStatsNPools;
+
+   const uint16_t nAOs = MEM_STATS_aoCount();
+   if ( n < nAOs ) {
+      const uint8_t prio = MEM_STATS_nthAoPrio( n );
+      pRec->kind = _DC3_MEM_STATS_AO_QUEUE;
+#if CPLR_APP
+      /* Every AO is a FreeRTOS task named in QACTIVE_START() */
+      pRec->name = pcTaskGetTaskName( QF_active_[prio]->thread );
+#else
+      pRec->name = NULL;
+#endif
+      MEM_STATS_fromQueue( &QF_active_[prio]->eQueue, prio, pRec );
+      return( ERR_NONE );
+   }
+   n -= nAOs;
+
+   if ( n < l_memStatsNQueues ) {
+      pRec->kind = _DC3_MEM_STATS_EVT_QUEUE;
+      pRec->name = l_memStatsQueues[n].name;
+      MEM_STATS_fromQueue( l_memStatsQueues[n].pObj, 0, pRec );
+      return( ERR_NONE );
+   }
+   n -= l_memStatsNQueues;
+
+#if CPLR_APP
+   if ( 0 == n ) {
+      /* Only asked for once the scheduler is running so the idle task exists */
+      MEM_STATS_fromTask( xTaskGetIdleTaskHandle(),
+            configMINIMAL_STACK_SIZE * sizeof(StackType_t), pRec );
+      return( ERR_NONE );
+   }
+   n -= 1;
+
+   if ( n < nAOs ) {
+      MEM_STATS_fromTask( QF_active_[MEM_STATS_nthAoPrio( n )]->thread,
+            l_memStatsAoStackBytes, pRec );
+      return( ERR_NONE );
+   }
+   n -= nAOs;
+
+   if ( n < l_memStatsNTasks ) {
+      MEM_STATS_fromTask( l_memStatsTasks[n].pTask,
+            l_memStatsTasks[n].stackBytes, pRec );
+      return( ERR_NONE );
+   }
+   n -= l_memStatsNTasks;
+#endif
+
+   if ( 0 == n && l_memStatsMainPainted ) {
+      MEM_STATS_fromMainStack( pRec );
+      return( ERR_NONE );
+   }
+
+   return( ERR_MEM_STATS_INVALID_INDEX );
+}
+
+/**
+ * @}
+ * end addtogroup groupMemStats
+ */
+
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
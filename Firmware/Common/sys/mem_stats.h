@@ -0,0 +1,174 @@
+/**
+ * @file    mem_stats.h
+ * @brief   Usage and high-water marks of the event pools, event queues, and
+ * stacks.
+ *
+ * QF already keeps the fewest free blocks/entries each pool and queue ever had.
+ * This module collects those, along with the allocation counters of the pools,
+ * into records that can be sent to a client so the pools, queues, and stacks
+ * in main.c can be sized from real numbers instead of guesses.  The records
+ * are, in order:
+ *    - every QF event pool (the ones Q_NEW() allocates from).
+ *    - every other QMPool registered with MEM_STATS_regPool().
+ *    - the event queue of every started Active Object, lowest priority first.
+ *    - every raw or defer QEQueue registered with MEM_STATS_regQueue().
+ *    - the stack of the idle task, of every started Active Object (lowest
+ *    priority first), and of every other task registered with
+ *    MEM_STATS_regTask().  Application only.
+ *    - the main stack (MSP), once MEM_STATS_paintMainStack() has run.
+ *
+ * Defer queues live inside of the AOs so each AO registers its own from its
+ * constructor.
+ *
+ * Stacks are measured in bytes.  FreeRTOS already fills every task stack with
+ * MEM_STATS_STACK_FILL when it creates the task (configCHECK_FOR_STACK_OVERFLOW
+ * is 2) and uxTaskGetStackHighWaterMark() finds how much of it was never
+ * touched.  The main stack is only used by main() before the scheduler starts
+ * and by the ISRs after, so it gets painted the same way at the top of main()
+ * and scanned here.  Neither knows how much is free right now so the free
+ * count of a stack is its high-water mark.  Scanning takes time proportional
+ * to the size of the stack so stacks aren't part of the health stream.
+ *
+ * @date    10/19/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ *
+ * @addtogroup groupMemStats
+ * @{
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef MEM_STATS_H_
+#define MEM_STATS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "qp_port.h"                                        /* for QP support */
+#include "DC3CommApi.h"                              /* For the record layout */
+#include "DC3Errors.h"                                 /* For DC3 error codes */
+
+/* Exported defines ----------------------------------------------------------*/
+#define MEM_STATS_MAX_POOLS     2        /**< QMPools that aren't event pools */
+#define MEM_STATS_MAX_QUEUES    8             /**< Raw and defer event queues */
+#define MEM_STATS_MAX_TASKS     2   /**< Tasks that aren't AOs (besides idle) */
+#define MEM_STATS_STACK_FILL    0xA5U         /**< Same as tskSTACK_FILL_BYTE */
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief   Usage of a single pool, queue, or stack.
+ */
+typedef struct {
+   DC3MemStatsKind_t kind;                    /**< What this record describes */
+   const char       *name;                   /**< Name or NULL if it has none */
+   uint32_t          stats[DC3_MEM_STATS_LEN];   /**< Indexed by DC3MemStat_t */
+} MemStatsRec_t;
+
+/* Exported macros -----------------------------------------------------------*/
+/* Exported variables --------------------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief   Add a memory pool that isn't an event pool to the records.
+ *
+ * @param [in] *pPool: const QMPool pointer to an initialized pool.
+ * @param [in] *name: const char pointer to a name that stays around.
+ * @return: None
+ */
+void MEM_STATS_regPool( QMPool const *pPool, const char *name );
+
+/**
+ * @brief   Add a raw or defer event queue to the records.
+ *
+ * Queues of Active Objects are found through QF and don't need this.
+ *
+ * @param [in] *pQueue: const QEQueue pointer to an initialized queue.
+ * @param [in] *name: const char pointer to a name that stays around.
+ * @return: None
+ */
+void MEM_STATS_regQueue( QEQueue const *pQueue, const char *name );
+
+/**
+ * @brief   Set the stack size every Active Object is started with.
+ *
+ * The stacks of AOs are found through QF but FreeRTOS doesn't keep their size
+ * anywhere it can be read from.
+ *
+ * @param [in] stackBytes: const uint32_t stack size in bytes as given to
+ * QACTIVE_START().
+ * @return: None
+ */
+void MEM_STATS_setAoStackSize( const uint32_t stackBytes );
+
+/**
+ * @brief   Add the stack of a FreeRTOS task that isn't an Active Object.
+ *
+ * @param [in] *pTask: void pointer to the TaskHandle_t of the task.  It's a
+ * void pointer since the Bootloader doesn't have FreeRTOS.
+ * @param [in] stackBytes: const uint32_t stack size in bytes.  Note that
+ * xTaskCreate() takes its size in words.
+ * @return: None
+ */
+void MEM_STATS_regTask( void *pTask, const uint32_t stackBytes );
+
+/**
+ * @brief   Fill the unused part of the main stack with MEM_STATS_STACK_FILL.
+ *
+ * Has to be called first thing in main(), while the main stack is as shallow
+ * as it will ever be.  Only the part below the current stack pointer is
+ * painted so nothing in use gets overwritten.
+ *
+ * @param   None
+ * @return: None
+ */
+void MEM_STATS_paintMainStack( void );
+
+/**
+ * @brief   Get the number of records.
+ *
+ * @param   None
+ * @return  uint16_t: number of records available through MEM_STATS_get().
+ */
+uint16_t MEM_STATS_getCount( void );
+
+/**
+ * @brief   Get the number of stack records.
+ *
+ * They are always the last ones.
+ *
+ * @param   None
+ * @return  uint16_t: number of records that are stacks.
+ */
+uint16_t MEM_STATS_getStackCount( void );
+
+/**
+ * @brief   Get a copy of a record.
+ *
+ * The counters of each pool or queue are read in a critical section so they
+ * are consistent with each other.  Stack records scan the stack so they take
+ * longer than the rest.
+ *
+ * @param [in] index: const uint16_t index of the record, from 0 to
+ * MEM_STATS_getCount() - 1.
+ * @param [out] *pRec: MemStatsRec_t pointer to where to put the record.
+ * @return  DC3Error_t status:
+ *    @arg ERR_NONE: success.
+ *    @arg ERR_MEM_STATS_INVALID_INDEX: no record at this index.
+ */
+DC3Error_t MEM_STATS_get( const uint16_t index, MemStatsRec_t *pRec );
+
+/**
+ * @}
+ * end addtogroup groupMemStats
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif                                                        /* MEM_STATS_H_ */
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
@@ -143,6 +143,18 @@ typedef struct {
     * \sa QF_getPoolMin().
     */
     QMPoolCtr nMin;
+
+    /*! number of blocks handed out since this pool has been initialized */
+    /**
+    * \description
+    * together with \c nGetFail this tells how busy the pool is, which
+    * \c nMin alone doesn't.
+    * \sa QF_getPool().
+    */
+    uint32_t nGet;
+
+    /*! number of times a block couldn't be handed out within the margin */
+    uint32_t nGetFail;
 } QMPool;
 
 /* public functions: */
@@ -157,6 +169,12 @@ void *QMPool_get(QMPool * const me, uint_fast16_t const margin);
 /*! Recycles a memory block back to a memory pool. */
 void QMPool_put(QMPool * const me, void *b);
 
+/*! Obtain the number of event pools initialized with QF_poolInit(). */
+uint_fast8_t QF_getPoolNum(void);
+
+/*! Obtain read-only access to the given event pool. */
+QMPool const *QF_getPool(uint_fast8_t const poolId);
+
 /*! Memory pool element to allocate correctly aligned storage
 * for QMPool class.
 */
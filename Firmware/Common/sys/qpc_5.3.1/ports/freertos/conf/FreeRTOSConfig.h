@@ -143,12 +143,19 @@ See http://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html. */
 #define configMAX_SYSCALL_INTERRUPT_PRIORITY    ( configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY << (8 - configPRIO_BITS) )
 
 #define INCLUDE_vTaskPrioritySet         0
-#define INCLUDE_uxTaskPriorityGet        0
+#define INCLUDE_uxTaskPriorityGet        1
 #define INCLUDE_vTaskDelete              1
 #define INCLUDE_vTaskCleanUpResources    0
 #define INCLUDE_vTaskSuspend             1
 #define INCLUDE_vTaskDelayUntil          0
 #define INCLUDE_vTaskDelay               1
+#define INCLUDE_pcTaskGetTaskName        1
+
+/* Stack high-water marks (see mem_stats.h in the application).  The stacks are
+already filled when the tasks are created since configCHECK_FOR_STACK_OVERFLOW
+is 2 so these only add the functions that read them. */
+#define INCLUDE_uxTaskGetStackHighWaterMark 1
+#define INCLUDE_xTaskGetIdleTaskHandle   1
 
 /* Definitions that map the FreeRTOS port interrupt handlers to their CMSIS
 standard names. */
@@ -156,4 +163,12 @@ standard names. */
 #define xPortPendSVHandler PendSV_Handler
 #define xPortSysTickHandler SysTick_Handler
 
+/* CPU load accounting (see cpu_load.h in the application).  Every task switch
+charges the cycles since the last one to the priority of the task that was
+running.  pxCurrentTCB is only visible inside of tasks.c, which is the only
+place this is expanded. */
+extern void CPU_LOAD_onSwitchIn( unsigned long prio, void *pTask );
+#define traceTASK_SWITCHED_IN() \
+    CPU_LOAD_onSwitchIn( pxCurrentTCB->uxPriority, (void *)pxCurrentTCB )
+
 #endif /* FREERTOS_CONFIG_H */
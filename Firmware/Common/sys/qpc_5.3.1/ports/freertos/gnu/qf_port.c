@@ -67,7 +67,13 @@ static void task_function(void *pvParameters) { /* FreeRTOS signature */
 
     while (act->thread != (TaskHandle_t)0) {
         QEvt const *e = QActive_get_(act);
+#ifdef DC3_AO_PROF
+        uint32_t start = AO_PROF_dispatchBegin();
         QMSM_DISPATCH(&act->super, e);
+        AO_PROF_dispatchEnd(act->prio, e->sig, start);
+#else
+        QMSM_DISPATCH(&act->super, e);
+#endif
         QF_gc(e); /* check if the event is garbage, and collect it if so */
     }
 
@@ -92,6 +98,9 @@ void QActive_start_(QActive * const me, uint_fast8_t prio,
 
     me->prio = prio;  /* save the QF priority */
     QF_add_(me);      /* make QF aware of this active object */
+#ifdef DC3_AO_PROF
+    AO_PROF_setName(prio, taskName); /* label the stats of this AO */
+#endif
     QMSM_INIT(&me->super, ie); /* execute initial transition */
 
     /* create the FreeRTOS.org task for the AO */
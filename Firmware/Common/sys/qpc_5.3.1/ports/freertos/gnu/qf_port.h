@@ -58,6 +58,16 @@
 #include "qmpool.h"    /* this QP port uses the native QF memory pool */
 #include "qf.h"        /* QF platform-independent public interface */
 
+/* Dispatch profiling hooks, see NOTE4.  Defined by the application. */
+#ifdef DC3_AO_PROF
+    void     AO_PROF_onPost(uint_fast8_t prio, bool lifo);
+    void     AO_PROF_onGet(uint_fast8_t prio);
+    uint32_t AO_PROF_dispatchBegin(void);
+    void     AO_PROF_dispatchEnd(uint_fast8_t prio, QSignal sig,
+                                 uint32_t start);
+    void     AO_PROF_setName(uint_fast8_t prio, char const *name);
+#endif
+
 /* FreeRTOS "extras" for handling ISRs for FreeRTOS/ARM-Cortex-M */
 typedef struct {
     BaseType_t volatile isrNest;
@@ -125,6 +135,13 @@ extern FreeRTOSExtras FreeRTOS_extras;
 
     #define QACTIVE_EQUEUE_ONEMPTY_(me_) ((void)0)
 
+    /* event queue hooks for the dispatch profiling, see NOTE4 */
+    #ifdef DC3_AO_PROF
+        #define QF_ACTIVE_POST_HOOK_(me_, lifo_) \
+            AO_PROF_onPost((me_)->prio, (lifo_))
+        #define QF_ACTIVE_GET_HOOK_(me_)  AO_PROF_onGet((me_)->prio)
+    #endif
+
     /* native QF event pool operations */
     #define QF_EPOOL_TYPE_            QMPool
     #define QF_EPOOL_INIT_(p_, poolSto_, poolSize_, evtSize_) \
@@ -155,6 +172,14 @@ extern FreeRTOSExtras FreeRTOS_extras;
 * port uses a dummy "FreeRTOSConfig.h" from the "config" sub-directory, so that
 * applications can still use their own (and potentially different) FreeRTOS
 * configuration at compile time.
+*
+* NOTE4:
+* When the application is built with DC3_AO_PROF defined (AO_PROF=1 on the
+* make command line), this port times every dispatch of every active object
+* and how long each event sat in the queue before it got dispatched.  The
+* AO_PROF_xxx() functions that keep the statistics live in the application
+* (Firmware/Common/sys/ao_prof.c) so this library and the application have
+* to be built with the same setting.
 */
 
 #endif /* qf_port_h */
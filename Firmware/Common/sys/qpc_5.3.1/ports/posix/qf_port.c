@@ -101,7 +101,13 @@ static void *thread_routine(void *arg) { /* the expected POSIX signature */
     /* loop until m_thread is cleared in QActive_stop() */
     do {
         QEvt const *e = QActive_get_(act); /* wait for the event */
+#ifdef DC3_AO_PROF
+        uint32_t start = AO_PROF_dispatchBegin();
         QMSM_DISPATCH(&act->super, e);     /* dispatch to the SM */
+        AO_PROF_dispatchEnd(act->prio, e->sig, start);
+#else
+        QMSM_DISPATCH(&act->super, e);     /* dispatch to the SM */
+#endif
         QF_gc(e);    /* check if the event is garbage, and collect it if so */
     } while (act->thread != (uint8_t)0);
     QF_remove_(act); /* remove this object from any subscriptions */
@@ -125,6 +131,9 @@ void QActive_start_(QActive * const me, uint_fast8_t prio,
 
     me->prio = (uint8_t)prio;
     QF_add_(me); /* make QF aware of this active object */
+#ifdef DC3_AO_PROF
+    AO_PROF_setName(prio, taskName); /* label the stats of this AO */
+#endif
     QMSM_INIT(&me->super, ie); /* execute the initial transition */
 
     pthread_attr_init(&attr);
@@ -63,6 +63,16 @@
 #include "qmpool.h"     /* Linux needs memory-pool */
 #include "qf.h"         /* QF platform-independent public interface */
 
+/* Dispatch profiling hooks, see NOTE02.  Defined by the application. */
+#ifdef DC3_AO_PROF
+    void     AO_PROF_onPost(uint_fast8_t prio, bool lifo);
+    void     AO_PROF_onGet(uint_fast8_t prio);
+    uint32_t AO_PROF_dispatchBegin(void);
+    void     AO_PROF_dispatchEnd(uint_fast8_t prio, QSignal sig,
+                                 uint32_t start);
+    void     AO_PROF_setName(uint_fast8_t prio, char const *name);
+#endif
+
 void QF_setTickRate(uint32_t ticksPerSec); /* set clock tick rate */
 void QF_onClockTick(void); /* clock tick callback (provided in the app) */
 
@@ -82,6 +92,13 @@ extern pthread_mutex_t QF_pThreadMutex_; /* mutex for QF critical section */
 
     #define QACTIVE_EQUEUE_ONEMPTY_(me_) ((void)0)
 
+    /* event queue hooks for the dispatch profiling, see NOTE02 */
+    #ifdef DC3_AO_PROF
+        #define QF_ACTIVE_POST_HOOK_(me_, lifo_) \
+            AO_PROF_onPost((me_)->prio, (lifo_))
+        #define QF_ACTIVE_GET_HOOK_(me_)  AO_PROF_onGet((me_)->prio)
+    #endif
+
     /* native QF event pool operations */
     #define QF_EPOOL_TYPE_            QMPool
     #define QF_EPOOL_INIT_(p_, poolSto_, poolSize_, evtSize_) \
@@ -120,6 +137,15 @@ extern pthread_mutex_t QF_pThreadMutex_; /* mutex for QF critical section */
 * also subject to priority inversions. However, the p-thread mutex
 * implementation, such as Linux p-threads, should support the priority-
 * inheritance protocol.
+*
+* NOTE02:
+* When the application is built with DC3_AO_PROF defined (AO_PROF=1 on the
+* make command line), this port times every dispatch of every active object
+* and how long each event sat in the queue before it got dispatched.  The
+* AO_PROF_xxx() functions that keep the statistics live in the application
+* (Firmware/Common/sys/ao_prof.c), which uses clock_gettime() on POSIX instead
+* of the DWT cycle counter. This library and the application have to be built
+* with the same setting.
 */
 
 #endif /* qf_port_h */
@@ -139,6 +139,8 @@ bool QActive_post_(QActive * const me, QEvt const * const e,
             me->eQueue.nMin = nFree;    /* update minimum so far */
         }
 
+        QF_ACTIVE_POST_HOOK_(me, false); /* before the AO can run */
+
         /* empty queue? */
         if (me->eQueue.frontEvt == (QEvt const *)0) {
             me->eQueue.frontEvt = e;    /* deliver event directly */
@@ -114,6 +114,7 @@ QEvt const *QActive_get_(QActive * const me) {
             QS_2U8_(e->poolId_, e->refCtr_); /* pool Id & ref Count */
         QS_END_NOCRIT_()
     }
+    QF_ACTIVE_GET_HOOK_(me);
     QF_CRIT_EXIT_();
     return e;
 }
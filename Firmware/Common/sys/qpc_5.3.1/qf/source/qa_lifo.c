@@ -101,6 +101,8 @@ void QActive_postLIFO_(QActive * const me, QEvt const * const e) {
         me->eQueue.nMin = nFree; /* update minimum so far */
     }
 
+    QF_ACTIVE_POST_HOOK_(me, true); /* before the AO can run */
+
     frontEvt = me->eQueue.frontEvt; /* read volatile into the temporary */
     me->eQueue.frontEvt = e; /* deliver the event directly to the front */
 
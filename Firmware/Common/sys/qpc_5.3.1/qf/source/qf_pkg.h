@@ -123,6 +123,31 @@ typedef struct QFreeBlock {
 */
 #define QF_PTR_RANGE_(x_, min_, max_)  (((min_) <= (x_)) && ((x_) <= (max_)))
 
+/* active object event queue hooks ******************************************/
+#ifndef QF_ACTIVE_POST_HOOK_
+    /*! hook invoked when an event gets inserted into the queue of an AO */
+    /**
+    * \description
+    * Called from QActive_post_() (\a lifo_ false) and QActive_postLIFO_()
+    * (\a lifo_ true) inside the critical section, right after the event
+    * has been accepted and before the AO gets signalled. A QF port can
+    * define this macro in qf_port.h, e.g., to time how long events wait in
+    * the queue. The default does nothing.
+    */
+    #define QF_ACTIVE_POST_HOOK_(me_, lifo_) ((void)0)
+#endif
+
+#ifndef QF_ACTIVE_GET_HOOK_
+    /*! hook invoked when an AO removes an event from its queue */
+    /**
+    * \description
+    * Called from QActive_get_() inside the critical section, right after
+    * the event has been removed from the queue.
+    * \sa #QF_ACTIVE_POST_HOOK_
+    */
+    #define QF_ACTIVE_GET_HOOK_(me_)         ((void)0)
+#endif
+
 /****************************************************************************/
 #ifdef Q_SPY  /* QS software tracing enabled? */
 
@@ -1,7 +1,7 @@
 /**
 * \file
 * \ingroup qf
-* \brief QMPool_get() and QF_getPoolMin() implementation.
+* \brief QMPool_get(), QF_getPoolMin(), and QF_getPool() implementation.
 * \cond
 ******************************************************************************
 * Product: QF/C
@@ -114,6 +114,7 @@ void *QMPool_get(QMPool * const me, uint_fast16_t const margin) {
         }
 
         me->free_head = fb_next; /* set the head to the next free block */
+        ++me->nGet;              /* one more block handed out */
 
         QS_BEGIN_NOCRIT_(QS_QF_MPOOL_GET, QS_priv_.mpObjFilter, me->start)
             QS_TIME_();         /* timestamp */
@@ -126,6 +127,7 @@ void *QMPool_get(QMPool * const me, uint_fast16_t const margin) {
     /* don't have enough free blocks at this point */
     else {
         fb = (QFreeBlock *)0;
+        ++me->nGetFail;          /* one more allocation that didn't fit */
 
         QS_BEGIN_NOCRIT_(QS_QF_MPOOL_GET_ATTEMPT,
                          QS_priv_.mpObjFilter, me->start)
@@ -167,3 +169,41 @@ uint_fast16_t QF_getPoolMin(uint_fast8_t const poolId) {
 
     return min;
 }
+
+/****************************************************************************/
+/**
+* \description
+* This function obtains the number of event pools initialized so far with
+* QF_poolInit(), so that the pools can be iterated with QF_getPool().
+*
+* \returns the number of initialized event pools.
+*/
+uint_fast8_t QF_getPoolNum(void) {
+    return QF_maxPool_;
+}
+
+/****************************************************************************/
+/**
+* \description
+* This function gives read-only access to the given event pool, e.g., to
+* report the block size, the number of blocks, the low watermark and the
+* allocation counters of the pool.
+*
+* \arguments
+* \arg[in] \c poolId  event pool ID in the range 1..QF_maxPool_, where
+*             QF_maxPool_ is the number of event pools initialized
+*             with the function QF_poolInit().
+*
+* \returns pointer to the event pool.
+*
+* \note The counters in the pool keep changing, so the caller has to read
+* them in a critical section if it needs them to be consistent.
+*/
+QMPool const *QF_getPool(uint_fast8_t const poolId) {
+
+    /** \pre the poolId must be in range */
+    Q_REQUIRE_ID(300, ((uint_fast8_t)1 <= poolId)
+                      && (poolId <= QF_maxPool_));
+
+    return &QF_pool_[poolId - (uint_fast8_t)1];
+}
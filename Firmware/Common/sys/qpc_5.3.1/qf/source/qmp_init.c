@@ -126,6 +126,8 @@ void QMPool_init(QMPool * const me, void * const poolSto,
     fb->next  = (QFreeBlock *)0; /* the last link points to NULL */
     me->nFree = me->nTot;        /* all blocks are free */
     me->nMin  = me->nTot;        /* the minimum number of free blocks */
+    me->nGet     = (uint32_t)0;  /* nothing handed out yet */
+    me->nGetFail = (uint32_t)0;
     me->start = poolSto;         /* the original start this pool buffer */
     me->end   = fb;              /* the last block in this pool */
 
@@ -0,0 +1,56 @@
+/**
+ * @file    cc.h
+ * @brief   lwIP compiler/platform port for building lwIP on a PC.
+ *
+ * Stands in for qpc_lwip_port/arch/cc.h, which types u32_t as unsigned long and
+ * so only works where long is 32 bits.  Everything else in arch/ comes from the
+ * real port since the bench dir is searched first.
+ *
+ * @date    10/19/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ */
+#ifndef __CC_H__
+#define __CC_H__
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef uint8_t     u8_t;
+typedef int8_t      s8_t;
+typedef uint16_t    u16_t;
+typedef int16_t     s16_t;
+typedef uint32_t    u32_t;
+typedef int32_t     s32_t;
+typedef uintptr_t   mem_ptr_t;
+
+#define U16_F "hu"
+#define S16_F "hd"
+#define X16_F "hx"
+#define U32_F "u"
+#define S32_F "d"
+#define X32_F "x"
+#define SZT_F "zu"
+
+#ifndef BYTE_ORDER
+#define BYTE_ORDER LITTLE_ENDIAN
+#endif
+
+#define PACK_STRUCT_BEGIN
+#define PACK_STRUCT_STRUCT __attribute__ ((__packed__))
+#define PACK_STRUCT_END
+#define PACK_STRUCT_FIELD(x) x
+
+#define LWIP_PLATFORM_DIAG(x)   do { printf x; } while(0)
+
+/* A failed assert means the numbers of the run can't be trusted so stop */
+#define LWIP_PLATFORM_ASSERT(msg)                                             \
+   do {                                                                       \
+      fprintf(stderr, "lwIP assert \"%s\" at %s:%d\n", msg, __FILE__, __LINE__);\
+      abort();                                                                \
+   } while(0)
+
+#endif                                                          /* __CC_H__ */
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
@@ -0,0 +1,583 @@
+/**
+ * @file    bench_peer.c
+ * @brief   The host PC end of the simulated wire for the lwIP bench.
+ *
+ * See bench_peer.h for the description.
+ *
+ * @date    10/19/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include <string.h>
+
+#include "bench_peer.h"
+#include "bench_sim.h"
+
+#include "lwip/opt.h"                 /* For the addresses of the board only */
+
+/* Private typedefs ----------------------------------------------------------*/
+
+/**
+ * @brief   A UDP reply from the board being put back together.
+ */
+typedef struct {
+   bool     used;
+   uint16_t id;                                   /**< IP id of the reply */
+   uint16_t got;                         /**< Bytes of IP payload so far */
+   uint16_t total;       /**< Bytes of IP payload, 0 until the last frag */
+   uint64_t startUs;                 /**< When the first frag came in */
+   uint8_t  buf[PEER_UDP_MAX + 8];                  /**< UDP hdr + data */
+} PeerReass_t;
+
+/**
+ * @brief   State of the TCP connection to the board.
+ */
+typedef enum {
+   PEER_TCP_CLOSED = 0,
+   PEER_TCP_SYN_SENT,
+   PEER_TCP_ESTABLISHED
+} PeerTcpState_t;
+
+/* Private defines -----------------------------------------------------------*/
+#define PEER_ETH_HLEN        14
+#define PEER_IP_HLEN         20
+#define PEER_UDP_HLEN        8
+#define PEER_TCP_HLEN        20
+#define PEER_ETH_MTU         1500
+#define PEER_REASS_SLOTS     8
+#define PEER_TCP_PORT        50000            /**< Local port of the PC */
+#define PEER_TCP_WND         65535        /**< Window of the PC, no scaling */
+
+#define PEER_ETHTYPE_IP      0x0800
+#define PEER_ETHTYPE_ARP     0x0806
+#define PEER_PROTO_TCP       6
+#define PEER_PROTO_UDP       17
+
+#define PEER_TCP_FIN         0x01
+#define PEER_TCP_SYN         0x02
+#define PEER_TCP_RST         0x04
+#define PEER_TCP_PSH         0x08
+#define PEER_TCP_ACK         0x10
+
+/* Private macros ------------------------------------------------------------*/
+#define PEER_GET16(p)        ( (uint16_t)(((p)[0] << 8) | (p)[1]) )
+#define PEER_GET32(p)        ( ((uint32_t)PEER_GET16(p) << 16) | PEER_GET16((p) + 2) )
+
+/* Private variables and Local objects ---------------------------------------*/
+static const uint8_t l_macBoard[6] = {
+      DEF_MAC_ADDR0, DEF_MAC_ADDR1, DEF_MAC_ADDR2,
+      DEF_MAC_ADDR3, DEF_MAC_ADDR4, DEF_MAC_ADDR5
+};
+static const uint8_t l_macPeer[6]  = { 0x02, 0x00, 0x00, 0x00, 0x00, PEER_IPADDR3 };
+static const uint8_t l_ipBoard[4]  = {
+      STATIC_IPADDR0, STATIC_IPADDR1, STATIC_IPADDR2, STATIC_IPADDR3
+};
+static const uint8_t l_ipPeer[4]   = {
+      STATIC_IPADDR0, STATIC_IPADDR1, STATIC_IPADDR2, PEER_IPADDR3
+};
+
+static PeerUdpRecv_t  l_udpRecv;
+static PeerTcpRecv_t  l_tcpRecv;
+static PeerStats_t    l_stats;
+static PeerReass_t    l_reass[PEER_REASS_SLOTS];
+static uint16_t       l_ipId;
+
+static PeerTcpState_t l_tcpState;
+static uint16_t       l_tcpDstPort;
+static uint32_t       l_sndNxt;
+static uint32_t       l_rcvNxt;
+static uint8_t        l_ackEvery;
+static uint32_t       l_ackDelayUs;
+static uint8_t        l_ackPending;         /* Segments not acked so far */
+static uint64_t       l_ackDueUs;
+
+/* Private function prototypes -----------------------------------------------*/
+
+/**
+ * @brief   Write a 16 bit value in network order.
+ * @param [out] *p: uint8_t pointer to where to write it.
+ * @param [in] v: uint16_t value.
+ * @return  None
+ */
+static void PEER_put16( uint8_t *p, const uint16_t v );
+
+/**
+ * @brief   Write a 32 bit value in network order.
+ * @param [out] *p: uint8_t pointer to where to write it.
+ * @param [in] v: uint32_t value.
+ * @return  None
+ */
+static void PEER_put32( uint8_t *p, const uint32_t v );
+
+/**
+ * @brief   Add a buffer to a ones complement sum.
+ * @param [in] sum: uint32_t sum so far.
+ * @param [in] *p: const uint8_t pointer to the buffer.
+ * @param [in] len: uint16_t length of the buffer.
+ * @return  uint32_t: new sum, not folded.
+ */
+static uint32_t PEER_sum( uint32_t sum, const uint8_t *p, uint16_t len );
+
+/**
+ * @brief   Fold a ones complement sum into a checksum.
+ * @param [in] sum: uint32_t sum.
+ * @return  uint16_t: checksum.
+ */
+static uint16_t PEER_fold( uint32_t sum );
+
+/**
+ * @brief   Fill in the ethernet and IP headers of a frame and send it.
+ * @param [in|out] *frame: uint8_t pointer to the frame with the IP payload
+ * already at PEER_ETH_HLEN + PEER_IP_HLEN.
+ * @param [in] proto: uint8_t IP protocol.
+ * @param [in] payloadLen: uint16_t length of the IP payload.
+ * @return  None
+ */
+static void PEER_ipSend(
+      uint8_t *frame,
+      const uint8_t proto,
+      const uint16_t payloadLen
+);
+
+/**
+ * @brief   Send a TCP segment with no data to the board.
+ * @param [in] flags: uint8_t TCP flags.
+ * @return  None
+ */
+static void PEER_tcpSendCtrl( const uint8_t flags );
+
+/**
+ * @brief   Ask for the MAC address of the board like a PC does before it sends
+ * anything.  The board learns the address of the PC from it.
+ * @param   None
+ * @return  None
+ */
+static void PEER_arpRequest( void );
+
+/**
+ * @brief   Handle an ARP frame.
+ * @param [in] *arp: const uint8_t pointer to the ARP packet.
+ * @param [in] len: uint16_t length of the packet.
+ * @return  None
+ */
+static void PEER_arpInput( const uint8_t *arp, const uint16_t len );
+
+/**
+ * @brief   Handle a UDP datagram or a fragment of one.
+ * @param [in] *ip: const uint8_t pointer to the IP header.
+ * @param [in] *payload: const uint8_t pointer to the IP payload.
+ * @param [in] len: uint16_t length of the IP payload.
+ * @return  None
+ */
+static void PEER_udpInput(
+      const uint8_t *ip,
+      const uint8_t *payload,
+      const uint16_t len
+);
+
+/**
+ * @brief   Handle a TCP segment.
+ * @param [in] *tcp: const uint8_t pointer to the TCP header.
+ * @param [in] len: uint16_t length of the segment with the header.
+ * @return  None
+ */
+static void PEER_tcpInput( const uint8_t *tcp, const uint16_t len );
+
+/* Private functions ---------------------------------------------------------*/
+/******************************************************************************/
+static void PEER_put16( uint8_t *p, const uint16_t v )
+{
+   p[0] = (uint8_t)( v >> 8 );
+   p[1] = (uint8_t)( v );
+}
+
+/******************************************************************************/
+static void PEER_put32( uint8_t *p, const uint32_t v )
+{
+   PEER_put16( p, (uint16_t)( v >> 16 ) );
+   PEER_put16( p + 2, (uint16_t)v );
+}
+
+/******************************************************************************/
+static uint32_t PEER_sum( uint32_t sum, const uint8_t *p, uint16_t len )
+{
+   while ( len > 1 ) {
+      sum += PEER_GET16( p );
+      p   += 2;
+      len -= 2;
+   }
+   if ( len ) {
+      sum += (uint32_t)p[0] << 8;
+   }
+   return sum;
+}
+
+/******************************************************************************/
+static uint16_t PEER_fold( uint32_t sum )
+{
+   while ( sum >> 16 ) {
+      sum = ( sum & 0xFFFF ) + ( sum >> 16 );
+   }
+   return (uint16_t)~sum;
+}
+
+/******************************************************************************/
+static void PEER_ipSend(
+      uint8_t *frame,
+      const uint8_t proto,
+      const uint16_t payloadLen
+)
+{
+   uint8_t *ip = &frame[PEER_ETH_HLEN];
+
+   memcpy( &frame[0], l_macBoard, 6 );
+   memcpy( &frame[6], l_macPeer, 6 );
+   PEER_put16( &frame[12], PEER_ETHTYPE_IP );
+
+   ip[0] = 0x45;                                  /* IPv4, no options */
+   ip[1] = 0;
+   PEER_put16( &ip[2], PEER_IP_HLEN + payloadLen );
+   PEER_put16( &ip[4], l_ipId++ );
+   PEER_put16( &ip[6], 0x4000 );                         /* Don't fragment */
+   ip[8] = 64;
+   ip[9] = proto;
+   PEER_put16( &ip[10], 0 );
+   memcpy( &ip[12], l_ipPeer, 4 );
+   memcpy( &ip[16], l_ipBoard, 4 );
+   PEER_put16( &ip[10], PEER_fold( PEER_sum( 0, ip, PEER_IP_HLEN ) ) );
+
+   SIM_sendToBoard( frame, PEER_ETH_HLEN + PEER_IP_HLEN + payloadLen );
+}
+
+/******************************************************************************/
+static void PEER_tcpSendCtrl( const uint8_t flags )
+{
+   uint8_t  frame[PEER_ETH_HLEN + PEER_IP_HLEN + PEER_TCP_HLEN + 4];
+   uint8_t *tcp = &frame[PEER_ETH_HLEN + PEER_IP_HLEN];
+   uint8_t  hlen = PEER_TCP_HLEN;
+
+   PEER_put16( &tcp[0], PEER_TCP_PORT );
+   PEER_put16( &tcp[2], l_tcpDstPort );
+   PEER_put32( &tcp[4], l_sndNxt );
+   PEER_put32( &tcp[8], ( flags & PEER_TCP_ACK ) ? l_rcvNxt : 0 );
+   tcp[13] = flags;
+   PEER_put16( &tcp[14], PEER_TCP_WND );
+   PEER_put16( &tcp[16], 0 );
+   PEER_put16( &tcp[18], 0 );
+   if ( flags & PEER_TCP_SYN ) {                   /* MSS option of a PC */
+      tcp[20] = 2;
+      tcp[21] = 4;
+      PEER_put16( &tcp[22], PEER_ETH_MTU - PEER_IP_HLEN - PEER_TCP_HLEN );
+      hlen += 4;
+   }
+   tcp[12] = (uint8_t)( ( hlen / 4 ) << 4 );
+
+   /* Pseudo header, then the segment */
+   uint32_t sum = PEER_sum( 0, l_ipPeer, 4 );
+   sum = PEER_sum( sum, l_ipBoard, 4 );
+   sum += PEER_PROTO_TCP + hlen;
+   PEER_put16( &tcp[16], PEER_fold( PEER_sum( sum, tcp, hlen ) ) );
+
+   if ( flags & PEER_TCP_ACK ) {
+      l_stats.tcpAcks++;
+      l_ackPending = 0;
+      l_ackDueUs   = SIM_NEVER;
+   }
+   PEER_ipSend( frame, PEER_PROTO_TCP, hlen );
+}
+
+/******************************************************************************/
+static void PEER_arpRequest( void )
+{
+   uint8_t  frame[PEER_ETH_HLEN + 28];
+   uint8_t *req = &frame[PEER_ETH_HLEN];
+
+   memset( &frame[0], 0xFF, 6 );
+   memcpy( &frame[6], l_macPeer, 6 );
+   PEER_put16( &frame[12], PEER_ETHTYPE_ARP );
+
+   PEER_put16( &req[0], 1 );                                /* Ethernet */
+   PEER_put16( &req[2], PEER_ETHTYPE_IP );
+   req[4] = 6;
+   req[5] = 4;
+   PEER_put16( &req[6], 1 );                                  /* Request */
+   memcpy( &req[8], l_macPeer, 6 );
+   memcpy( &req[14], l_ipPeer, 4 );
+   memset( &req[18], 0, 6 );
+   memcpy( &req[24], l_ipBoard, 4 );
+
+   SIM_sendToBoard( frame, sizeof(frame) );
+}
+
+/******************************************************************************/
+static void PEER_arpInput( const uint8_t *arp, const uint16_t len )
+{
+   uint8_t  frame[PEER_ETH_HLEN + 28];
+   uint8_t *rep = &frame[PEER_ETH_HLEN];
+
+   /* Only requests for the PC */
+   if ( len < 28 || PEER_GET16( &arp[6] ) != 1 || memcmp( &arp[24], l_ipPeer, 4 ) ) {
+      return;
+   }
+
+   memcpy( &frame[0], &arp[8], 6 );
+   memcpy( &frame[6], l_macPeer, 6 );
+   PEER_put16( &frame[12], PEER_ETHTYPE_ARP );
+
+   memcpy( rep, arp, 6 );                /* Same HW type, proto, and sizes */
+   PEER_put16( &rep[6], 2 );                                     /* Reply */
+   memcpy( &rep[8], l_macPeer, 6 );
+   memcpy( &rep[14], l_ipPeer, 4 );
+   memcpy( &rep[18], &arp[8], 10 );                 /* Sender becomes target */
+
+   l_stats.arpReplies++;
+   SIM_sendToBoard( frame, sizeof(frame) );
+}
+
+/******************************************************************************/
+static void PEER_udpInput(
+      const uint8_t *ip,
+      const uint8_t *payload,
+      const uint16_t len
+)
+{
+   uint16_t id     = PEER_GET16( &ip[4] );
+   uint16_t frag   = PEER_GET16( &ip[6] );
+   uint16_t offset = ( frag & 0x1FFF ) * 8;
+   bool     more   = ( frag & 0x2000 ) != 0;
+   PeerReass_t *r  = NULL;
+
+   if ( 0 == offset && !more ) {                         /* Not fragmented */
+      if ( len >= PEER_UDP_HLEN && NULL != l_udpRecv ) {
+         l_udpRecv( PEER_GET16( &payload[0] ), &payload[PEER_UDP_HLEN], len - PEER_UDP_HLEN );
+      }
+      return;
+   }
+
+   /* Find the reply this belongs to, or the slot that waited longest */
+   for ( uint8_t i = 0; i < PEER_REASS_SLOTS; i++ ) {
+      if ( l_reass[i].used && l_reass[i].id == id ) {
+         r = &l_reass[i];
+         break;
+      }
+   }
+   if ( NULL == r ) {
+      r = &l_reass[0];
+      for ( uint8_t i = 0; i < PEER_REASS_SLOTS; i++ ) {
+         if ( !l_reass[i].used ) {
+            r = &l_reass[i];
+            break;
+         }
+         if ( l_reass[i].startUs < r->startUs ) {
+            r = &l_reass[i];
+         }
+      }
+      if ( r->used ) {
+         l_stats.udpFragDrops++;               /* Never got all the frags */
+      }
+      memset( r, 0, offsetof(PeerReass_t, buf) );
+      r->used    = true;
+      r->id      = id;
+      r->startUs = SIM_nowUs();
+   }
+
+   if ( offset + len > sizeof(r->buf) ) {
+      l_stats.udpFragDrops++;
+      r->used = false;
+      return;
+   }
+   memcpy( &r->buf[offset], payload, len );
+   r->got += len;
+   if ( !more ) {
+      r->total = offset + len;
+   }
+
+   if ( r->total != 0 && r->got == r->total ) {
+      r->used = false;
+      if ( NULL != l_udpRecv ) {
+         l_udpRecv( PEER_GET16( &r->buf[0] ), &r->buf[PEER_UDP_HLEN], r->total - PEER_UDP_HLEN );
+      }
+   }
+}
+
+/******************************************************************************/
+static void PEER_tcpInput( const uint8_t *tcp, const uint16_t len )
+{
+   if ( len < PEER_TCP_HLEN || PEER_GET16( &tcp[2] ) != PEER_TCP_PORT ) {
+      return;
+   }
+
+   uint32_t seq   = PEER_GET32( &tcp[4] );
+   uint8_t  hlen  = ( tcp[12] >> 4 ) * 4;
+   uint8_t  flags = tcp[13];
+   uint16_t dlen  = len - hlen;
+
+   if ( flags & PEER_TCP_RST ) {
+      l_stats.tcpRsts++;
+      l_tcpState = PEER_TCP_CLOSED;
+      return;
+   }
+
+   if ( PEER_TCP_SYN_SENT == l_tcpState ) {
+      if ( ( flags & ( PEER_TCP_SYN | PEER_TCP_ACK ) ) == ( PEER_TCP_SYN | PEER_TCP_ACK ) ) {
+         l_rcvNxt = seq + 1;
+         l_sndNxt++;                                    /* The SYN is acked */
+         l_tcpState = PEER_TCP_ESTABLISHED;
+         PEER_tcpSendCtrl( PEER_TCP_ACK );
+      }
+      return;
+   }
+
+   if ( PEER_TCP_ESTABLISHED != l_tcpState ) {
+      return;
+   }
+
+   if ( dlen > 0 ) {
+      int32_t skip = (int32_t)( l_rcvNxt - seq );
+      if ( skip < 0 || skip >= dlen ) {
+         /* A hole in front of it or all of it seen already */
+         l_stats.tcpOoo++;
+         PEER_tcpSendCtrl( PEER_TCP_ACK );
+         return;
+      }
+
+      l_stats.tcpSegs++;
+      l_rcvNxt += dlen - skip;
+      if ( NULL != l_tcpRecv ) {
+         l_tcpRecv( &tcp[hlen + skip], dlen - skip );
+      }
+
+      if ( ++l_ackPending >= l_ackEvery ) {
+         PEER_tcpSendCtrl( PEER_TCP_ACK );
+      } else if ( SIM_NEVER == l_ackDueUs ) {
+         l_ackDueUs = SIM_nowUs() + l_ackDelayUs;
+      }
+   }
+
+   if ( flags & PEER_TCP_FIN ) {
+      l_rcvNxt++;
+      PEER_tcpSendCtrl( PEER_TCP_ACK );
+   }
+}
+
+/* Exported functions --------------------------------------------------------*/
+/******************************************************************************/
+void PEER_init( const PeerUdpRecv_t udpRecv, const PeerTcpRecv_t tcpRecv )
+{
+   l_udpRecv    = udpRecv;
+   l_tcpRecv    = tcpRecv;
+   l_ipId       = 1;
+   l_tcpState   = PEER_TCP_CLOSED;
+   l_ackPending = 0;
+   l_ackDueUs   = SIM_NEVER;
+   memset( &l_stats, 0, sizeof(l_stats) );
+   memset( l_reass, 0, sizeof(l_reass) );
+   PEER_arpRequest();
+}
+
+/******************************************************************************/
+void PEER_input( const uint8_t *frame, const uint16_t len )
+{
+   if ( len < PEER_ETH_HLEN ) {
+      return;
+   }
+
+   const uint8_t *pl = &frame[PEER_ETH_HLEN];
+   uint16_t plLen    = len - PEER_ETH_HLEN;
+
+   switch ( PEER_GET16( &frame[12] ) ) {
+      case PEER_ETHTYPE_ARP:
+         PEER_arpInput( pl, plLen );
+         break;
+
+      case PEER_ETHTYPE_IP: {
+         uint8_t  ihl   = ( pl[0] & 0x0F ) * 4;
+         uint16_t total = PEER_GET16( &pl[2] );
+         if ( plLen < PEER_IP_HLEN || total > plLen || total < ihl
+               || memcmp( &pl[16], l_ipPeer, 4 ) ) {
+            break;
+         }
+         if ( PEER_PROTO_UDP == pl[9] ) {
+            PEER_udpInput( pl, &pl[ihl], total - ihl );
+         } else if ( PEER_PROTO_TCP == pl[9] ) {
+            PEER_tcpInput( &pl[ihl], total - ihl );
+         }
+         break;
+      }
+
+      default:
+         break;
+   }
+}
+
+/******************************************************************************/
+uint64_t PEER_nextDueUs( void )
+{
+   return l_ackDueUs;
+}
+
+/******************************************************************************/
+void PEER_service( void )
+{
+   if ( SIM_NEVER != l_ackDueUs && SIM_nowUs() >= l_ackDueUs ) {
+      PEER_tcpSendCtrl( PEER_TCP_ACK );
+   }
+}
+
+/******************************************************************************/
+void PEER_udpSend(
+      const uint16_t srcPort,
+      const uint16_t dstPort,
+      const uint8_t *data,
+      uint16_t len
+)
+{
+   uint8_t  frame[PEER_ETH_HLEN + PEER_ETH_MTU];
+   uint8_t *udp = &frame[PEER_ETH_HLEN + PEER_IP_HLEN];
+
+   if ( len > PEER_ETH_MTU - PEER_IP_HLEN - PEER_UDP_HLEN ) {
+      len = PEER_ETH_MTU - PEER_IP_HLEN - PEER_UDP_HLEN;
+   }
+
+   PEER_put16( &udp[0], srcPort );
+   PEER_put16( &udp[2], dstPort );
+   PEER_put16( &udp[4], PEER_UDP_HLEN + len );
+   PEER_put16( &udp[6], 0 );                   /* No checksum is allowed */
+   memcpy( &udp[PEER_UDP_HLEN], data, len );
+
+   PEER_ipSend( frame, PEER_PROTO_UDP, PEER_UDP_HLEN + len );
+}
+
+/******************************************************************************/
+void PEER_tcpConnect(
+      const uint16_t dstPort,
+      const uint8_t ackEvery,
+      const uint32_t ackDelayUs
+)
+{
+   l_tcpDstPort = dstPort;
+   l_ackEvery   = ackEvery ? ackEvery : 1;
+   l_ackDelayUs = ackDelayUs;
+   l_sndNxt     = 0x10000000;
+   l_rcvNxt     = 0;
+   l_tcpState   = PEER_TCP_SYN_SENT;
+   PEER_tcpSendCtrl( PEER_TCP_SYN );
+}
+
+/******************************************************************************/
+bool PEER_tcpIsConnected( void )
+{
+   return PEER_TCP_ESTABLISHED == l_tcpState;
+}
+
+/******************************************************************************/
+const PeerStats_t* PEER_getStats( void )
+{
+   return &l_stats;
+}
+
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
@@ -0,0 +1,146 @@
+/**
+ * @file    bench_peer.h
+ * @brief   The host PC end of the simulated wire for the lwIP bench.
+ *
+ * Just enough of a network stack to drive the board and to count what comes
+ * back without using any of the board's lwIP memory for it:
+ *    - answers the ARP requests of the board.
+ *    - sends UDP datagrams and puts fragmented replies back together.
+ *    - opens one TCP connection to the board and receives on it.  It acks
+ *    every ackEvery segments or after ackDelayUs, whichever comes first, like
+ *    the delayed ack of a PC does.  Segments out of order get dropped and a
+ *    duplicate ack sent right away.
+ *
+ * The PC sends nothing on its own other than the ARP request for the board it
+ * starts with.  IP and TCP checksums get filled in so the pcap looks right, UDP
+ * goes without.  The board is built with CHECKSUM_BY_HARDWARE so it doesn't
+ * check them either way.
+ *
+ * @date    10/19/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef BENCH_PEER_H_
+#define BENCH_PEER_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Exported defines ----------------------------------------------------------*/
+#define PEER_IPADDR3         100   /**< Host part of the IP addr of the PC */
+#define PEER_UDP_MAX         8192  /**< Largest UDP reply put back together */
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief   Callback for a UDP datagram from the board.
+ * @param [in] srcPort: uint16_t port of the board it came from.
+ * @param [in] *data: const uint8_t pointer to the payload.
+ * @param [in] len: uint16_t length of the payload.
+ */
+typedef void (*PeerUdpRecv_t)(
+      const uint16_t srcPort,
+      const uint8_t *data,
+      const uint16_t len
+);
+
+/**
+ * @brief   Callback for in order data from the board on the TCP connection.
+ * @param [in] *data: const uint8_t pointer to the data.
+ * @param [in] len: uint16_t length of the data.
+ */
+typedef void (*PeerTcpRecv_t)( const uint8_t *data, const uint16_t len );
+
+/**
+ * @brief   What the PC counted.
+ */
+typedef struct {
+   uint32_t arpReplies;                    /**< ARP requests answered */
+   uint32_t udpFragDrops;   /**< UDP replies that couldn't be put together */
+   uint32_t tcpSegs;                 /**< TCP segments with data received */
+   uint32_t tcpOoo;       /**< TCP segments dropped for being out of order */
+   uint32_t tcpAcks;                                 /**< TCP acks sent */
+   uint32_t tcpRsts;                           /**< TCP resets received */
+} PeerStats_t;
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief   Reset the PC end and ARP for the board.
+ * @param [in] udpRecv: PeerUdpRecv_t callback for UDP replies.
+ * @param [in] tcpRecv: PeerTcpRecv_t callback for TCP data.
+ * @return  None
+ */
+void PEER_init( const PeerUdpRecv_t udpRecv, const PeerTcpRecv_t tcpRecv );
+
+/**
+ * @brief   Handle a frame the board sent.  Called by the wire.
+ * @param [in] *frame: const uint8_t pointer to the ethernet frame.
+ * @param [in] len: uint16_t length of the frame.
+ * @return  None
+ */
+void PEER_input( const uint8_t *frame, const uint16_t len );
+
+/**
+ * @brief   Get the time the delayed ack is due.
+ * @param   None
+ * @return  uint64_t: the time in us, SIM_NEVER if no ack is waiting.
+ */
+uint64_t PEER_nextDueUs( void );
+
+/**
+ * @brief   Send the delayed ack if it's due.
+ * @param   None
+ * @return  None
+ */
+void PEER_service( void );
+
+/**
+ * @brief   Send a UDP datagram to the board.
+ * @param [in] srcPort: uint16_t port on the PC.
+ * @param [in] dstPort: uint16_t port on the board.
+ * @param [in] *data: const uint8_t pointer to the payload.
+ * @param [in] len: uint16_t length of the payload.  Anything that doesn't fit
+ * in one frame is cut off.
+ * @return  None
+ */
+void PEER_udpSend(
+      const uint16_t srcPort,
+      const uint16_t dstPort,
+      const uint8_t *data,
+      uint16_t len
+);
+
+/**
+ * @brief   Open the TCP connection to the board.
+ * @param [in] dstPort: uint16_t port on the board.
+ * @param [in] ackEvery: uint8_t segments to get before acking right away.
+ * @param [in] ackDelayUs: uint32_t longest an ack waits for more segments.
+ * @return  None
+ */
+void PEER_tcpConnect(
+      const uint16_t dstPort,
+      const uint8_t ackEvery,
+      const uint32_t ackDelayUs
+);
+
+/**
+ * @brief   Check if the TCP connection is open.
+ * @param   None
+ * @return  bool: true if the handshake is done and no reset came.
+ */
+bool PEER_tcpIsConnected( void );
+
+/**
+ * @brief   Get the counters of the PC end.
+ * @param   None
+ * @return  const PeerStats_t*: pointer to the counters.
+ */
+const PeerStats_t* PEER_getStats( void );
+
+#endif                                                      /* BENCH_PEER_H_ */
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
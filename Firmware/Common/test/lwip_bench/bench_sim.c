@@ -0,0 +1,464 @@
+/**
+ * @file    bench_sim.c
+ * @brief   Simulated wire between the board's lwIP and a host PC for the bench.
+ *
+ * See bench_sim.h for the description.
+ *
+ * @date    10/19/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+
+#include "bench_sim.h"
+#include "bench_peer.h"
+
+#include "lwip/opt.h"
+#include "lwip/pbuf.h"
+#include "lwip/stats.h"
+#include "lwip/ip.h"
+#include "netif/etharp.h"
+
+/* Private typedefs ----------------------------------------------------------*/
+
+/**
+ * @brief   A frame on the wire.
+ */
+typedef struct {
+   uint64_t doneNs;               /**< When the last bit leaves the sender */
+   uint64_t dueUs;                /**< When the receiver gets the frame */
+   uint16_t len;                                  /**< Length of the frame */
+   uint8_t  data[SIM_FRAME_MAX];                               /**< Frame */
+} SimFrame_t;
+
+/**
+ * @brief   Frames going one way, oldest first.
+ */
+typedef struct {
+   SimFrame_t ring[1024];
+   uint16_t   head;                                 /**< Oldest frame */
+   uint16_t   count;                    /**< Frames on the wire right now */
+   uint64_t   freeNs;           /**< When the sender can start the next one */
+} SimWire_t;
+
+/* Private defines -----------------------------------------------------------*/
+#define SIM_WIRE_OVERHEAD    24 /**< Preamble, SFD, FCS, and inter-frame gap */
+#define SIM_MIN_FRAME        60      /**< Shorter frames get padded to this */
+
+/* Private macros ------------------------------------------------------------*/
+/* Private variables and Local objects ---------------------------------------*/
+static uint64_t      l_nowUs;                                 /* Virtual time */
+static uint32_t      l_linkMbit;
+static uint32_t      l_latencyUs;
+static SimWire_t     l_wire[SIM_DIRS];
+static SimStats_t    l_stats;
+static FILE         *l_pcap;
+static struct netif  l_netif;
+
+/* Private function prototypes -----------------------------------------------*/
+
+/**
+ * @brief   Put a frame on the wire.
+ * @param [in] dir: SimDir_t which way the frame goes.
+ * @param [in] *frame: const uint8_t pointer to the frame.
+ * @param [in] len: uint16_t length of the frame.
+ * @return  None
+ */
+static void SIM_queue( const SimDir_t dir, const uint8_t *frame, uint16_t len );
+
+/**
+ * @brief   Hand a frame that arrived to the board.
+ * @param [in] *frame: const uint8_t pointer to the frame.
+ * @param [in] len: uint16_t length of the frame.
+ * @return  None
+ */
+static void SIM_boardReceive( const uint8_t *frame, const uint16_t len );
+
+/**
+ * @brief   Write a frame to the pcap file.
+ * @param [in] *f: const SimFrame_t pointer to the frame.
+ * @return  None
+ */
+static void SIM_pcapWrite( const SimFrame_t *f );
+
+/**
+ * @brief   Fill in the checksums the MAC of the board fills in.
+ *
+ * With CHECKSUM_BY_HARDWARE lwIP leaves them 0.  Only done so the pcap looks
+ * right, nothing on the PC checks them.
+ *
+ * @param [in|out] *frame: uint8_t pointer to the frame.
+ * @param [in] len: uint16_t length of the frame.
+ * @return  None
+ */
+static void SIM_insertChecksums( uint8_t *frame, const uint16_t len );
+
+/**
+ * @brief   Add a buffer to a ones complement sum.
+ * @param [in] sum: uint32_t sum so far.
+ * @param [in] *p: const uint8_t pointer to the buffer.
+ * @param [in] len: uint16_t length of the buffer.
+ * @return  uint32_t: new sum, not folded.
+ */
+static uint32_t SIM_sum( uint32_t sum, const uint8_t *p, uint16_t len );
+
+/**
+ * @brief   Fold a ones complement sum into a checksum.
+ * @param [in] sum: uint32_t sum.
+ * @return  uint16_t: checksum.
+ */
+static uint16_t SIM_fold( uint32_t sum );
+
+/**
+ * @brief   linkoutput of the board netif.  Does what low_level_transmit() does.
+ * @param [in] *netif: struct netif pointer to the board netif.
+ * @param [in] *p: struct pbuf pointer to the frame.
+ * @return  err_t: ERR_OK.  Like on the board, a lost frame is not reported.
+ */
+static err_t SIM_linkOutput( struct netif *netif, struct pbuf *p );
+
+/**
+ * @brief   init of the board netif.  Does what ethernetif_init() does.
+ * @param [in] *netif: struct netif pointer to the board netif.
+ * @return  err_t: ERR_OK.
+ */
+static err_t SIM_netifInit( struct netif *netif );
+
+/* Private functions ---------------------------------------------------------*/
+/******************************************************************************/
+static void SIM_queue( const SimDir_t dir, const uint8_t *frame, uint16_t len )
+{
+   SimWire_t *w = &l_wire[dir];
+   if ( w->count >= sizeof(w->ring) / sizeof(w->ring[0]) || len > SIM_FRAME_MAX ) {
+      l_stats.wireDrops++;
+      return;
+   }
+
+   SimFrame_t *f = &w->ring[(w->head + w->count) % (sizeof(w->ring) / sizeof(w->ring[0]))];
+   uint64_t nowNs = l_nowUs * 1000;
+   uint32_t bits  = ((len < SIM_MIN_FRAME ? SIM_MIN_FRAME : len) + SIM_WIRE_OVERHEAD) * 8;
+
+   f->doneNs = ( w->freeNs > nowNs ? w->freeNs : nowNs ) + bits * 1000 / l_linkMbit;
+   f->dueUs  = ( f->doneNs + 999 ) / 1000 + l_latencyUs;
+   f->len    = len;
+   memcpy( f->data, frame, len );
+
+   w->freeNs = f->doneNs;
+   w->count++;
+}
+
+/******************************************************************************/
+static void SIM_boardReceive( const uint8_t *frame, const uint16_t len )
+{
+   uint16_t l = 0;
+
+   struct pbuf *p = pbuf_alloc( PBUF_RAW, len + ETH_PAD_SIZE, PBUF_POOL );
+   if ( NULL == p ) {
+      l_stats.rxNoPbuf++;
+      LINK_STATS_INC( link.memerr );
+      LINK_STATS_INC( link.drop );
+      return;
+   }
+
+#if ETH_PAD_SIZE
+   pbuf_header( p, -ETH_PAD_SIZE );                    /* drop the padding word */
+#endif
+   for ( struct pbuf *q = p; q != NULL; q = q->next ) {
+      memcpy( q->payload, &frame[l], q->len );
+      l += q->len;
+   }
+#if ETH_PAD_SIZE
+   pbuf_header( p, ETH_PAD_SIZE );                  /* reclaim the padding word */
+#endif
+
+   LINK_STATS_INC( link.recv );
+   if ( ethernet_input( p, &l_netif ) != ERR_OK ) {
+      pbuf_free( p );
+   }
+}
+
+/******************************************************************************/
+static void SIM_pcapWrite( const SimFrame_t *f )
+{
+   uint32_t rec[4] = {
+         (uint32_t)( f->dueUs / 1000000 ),
+         (uint32_t)( f->dueUs % 1000000 ),
+         f->len,
+         f->len
+   };
+   fwrite( rec, sizeof(rec), 1, l_pcap );
+   fwrite( f->data, f->len, 1, l_pcap );
+}
+
+/******************************************************************************/
+static uint32_t SIM_sum( uint32_t sum, const uint8_t *p, uint16_t len )
+{
+   while ( len > 1 ) {
+      sum += (uint32_t)( p[0] << 8 | p[1] );
+      p   += 2;
+      len -= 2;
+   }
+   if ( len ) {
+      sum += (uint32_t)p[0] << 8;
+   }
+   return sum;
+}
+
+/******************************************************************************/
+static uint16_t SIM_fold( uint32_t sum )
+{
+   while ( sum >> 16 ) {
+      sum = ( sum & 0xFFFF ) + ( sum >> 16 );
+   }
+   return (uint16_t)~sum;
+}
+
+/******************************************************************************/
+static void SIM_insertChecksums( uint8_t *frame, const uint16_t len )
+{
+   uint8_t *ip = &frame[SIZEOF_ETH_HDR - ETH_PAD_SIZE];
+   if ( len < SIZEOF_ETH_HDR - ETH_PAD_SIZE + 20 || 0x08 != frame[12] || 0x00 != frame[13] ) {
+      return;
+   }
+
+   uint16_t ihl   = ( ip[0] & 0x0F ) * 4;
+   uint16_t total = (uint16_t)( ip[2] << 8 | ip[3] );
+   uint32_t sum;
+
+#if !CHECKSUM_GEN_IP
+   ip[10] = ip[11] = 0;
+   sum = SIM_fold( SIM_sum( 0, ip, ihl ) );
+   ip[10] = (uint8_t)( sum >> 8 );
+   ip[11] = (uint8_t)sum;
+#endif
+
+   /* Like the MAC, only whole datagrams get the TCP/UDP checksum */
+   if ( ( ip[6] & 0x3F ) || ip[7] || total < ihl ) {
+      return;
+   }
+   uint8_t *l4 = ip + ihl;
+   uint16_t l4Len = total - ihl;
+   uint8_t *cs = NULL;
+   if ( IP_PROTO_TCP == ip[9] && !CHECKSUM_GEN_TCP && l4Len >= 20 ) {
+      cs = &l4[16];
+   } else if ( IP_PROTO_UDP == ip[9] && !CHECKSUM_GEN_UDP && l4Len >= 8 ) {
+      cs = &l4[6];
+   }
+   if ( NULL == cs ) {
+      return;
+   }
+
+   cs[0] = cs[1] = 0;
+   sum = SIM_sum( 0, &ip[12], 8 ) + ip[9] + l4Len;
+   sum = SIM_fold( SIM_sum( sum, l4, l4Len ) );
+   if ( 0 == sum && IP_PROTO_UDP == ip[9] ) {
+      sum = 0xFFFF;                       /* 0 means no checksum for UDP */
+   }
+   cs[0] = (uint8_t)( sum >> 8 );
+   cs[1] = (uint8_t)sum;
+}
+
+/******************************************************************************/
+static err_t SIM_linkOutput( struct netif *netif, struct pbuf *p )
+{
+   uint8_t  frame[SIM_FRAME_MAX];
+   uint16_t l = 0;
+   (void)netif;
+
+   /* Every frame that hasn't left yet is holding a DMA descriptor */
+   SimWire_t *w = &l_wire[SIM_TO_PEER];
+   uint16_t busy = 0;
+   for ( uint16_t i = 0; i < w->count; i++ ) {
+      if ( w->ring[(w->head + i) % (sizeof(w->ring) / sizeof(w->ring[0]))].doneNs > l_nowUs * 1000 ) {
+         busy++;
+      }
+   }
+   if ( busy >= SIM_TX_DESCS ) {
+      l_stats.txDescDrops++;
+      LINK_STATS_INC( link.drop );
+      return ERR_OK;
+   }
+
+#if ETH_PAD_SIZE
+   pbuf_header( p, -ETH_PAD_SIZE );                    /* drop the padding word */
+#endif
+   for ( struct pbuf *q = p; q != NULL && l + q->len <= SIM_FRAME_MAX; q = q->next ) {
+      memcpy( &frame[l], q->payload, q->len );
+      l += q->len;
+   }
+#if ETH_PAD_SIZE
+   pbuf_header( p, ETH_PAD_SIZE );                  /* reclaim the padding word */
+#endif
+
+   SIM_insertChecksums( frame, l );
+   SIM_queue( SIM_TO_PEER, frame, l );
+   LINK_STATS_INC( link.xmit );
+   return ERR_OK;
+}
+
+/******************************************************************************/
+static err_t SIM_netifInit( struct netif *netif )
+{
+   netif->name[0]    = IFNAME0[0];
+   netif->name[1]    = IFNAME1[0];
+   netif->output     = etharp_output;
+   netif->linkoutput = SIM_linkOutput;
+   netif->mtu        = 1500;
+   netif->flags      = NETIF_FLAG_BROADCAST | NETIF_FLAG_ETHARP | NETIF_FLAG_LINK_UP;
+
+   netif->hwaddr_len = ETHARP_HWADDR_LEN;
+   netif->hwaddr[0]  = DEF_MAC_ADDR0;
+   netif->hwaddr[1]  = DEF_MAC_ADDR1;
+   netif->hwaddr[2]  = DEF_MAC_ADDR2;
+   netif->hwaddr[3]  = DEF_MAC_ADDR3;
+   netif->hwaddr[4]  = DEF_MAC_ADDR4;
+   netif->hwaddr[5]  = DEF_MAC_ADDR5;
+   return ERR_OK;
+}
+
+/* Exported functions --------------------------------------------------------*/
+/******************************************************************************/
+bool SIM_init(
+      const uint32_t linkMbit,
+      const uint32_t latencyUs,
+      const char *pcapFile
+)
+{
+   struct ip_addr ipaddr, netmask, gw;
+
+   l_nowUs     = 0;
+   l_linkMbit  = linkMbit;
+   l_latencyUs = latencyUs;
+   memset( l_wire, 0, sizeof(l_wire) );
+   memset( &l_stats, 0, sizeof(l_stats) );
+
+   if ( NULL != pcapFile ) {
+      /* Classic pcap header: usec timestamps, ethernet link type */
+      const uint32_t hdr[6] = { 0xa1b2c3d4, 0x00040002, 0, 0, 65535, 1 };
+      l_pcap = fopen( pcapFile, "wb" );
+      if ( NULL == l_pcap ) {
+         return false;
+      }
+      fwrite( hdr, sizeof(hdr), 1, l_pcap );
+   }
+
+   IP4_ADDR( &ipaddr,  STATIC_IPADDR0, STATIC_IPADDR1, STATIC_IPADDR2, STATIC_IPADDR3 );
+   IP4_ADDR( &netmask, STATIC_NET_MASK0, STATIC_NET_MASK1, STATIC_NET_MASK2, STATIC_NET_MASK3 );
+   IP4_ADDR( &gw,      STATIC_GW_IPADDR0, STATIC_GW_IPADDR1, STATIC_GW_IPADDR2, STATIC_GW_IPADDR3 );
+
+   netif_add( &l_netif, &ipaddr, &netmask, &gw, NULL, SIM_netifInit, ethernet_input );
+   netif_set_default( &l_netif );
+   netif_set_up( &l_netif );
+   return true;
+}
+
+/******************************************************************************/
+void SIM_close( void )
+{
+   if ( NULL != l_pcap ) {
+      fclose( l_pcap );
+      l_pcap = NULL;
+   }
+}
+
+/******************************************************************************/
+uint64_t SIM_nowUs( void )
+{
+   return l_nowUs;
+}
+
+/******************************************************************************/
+void SIM_advance( const uint64_t us )
+{
+   if ( us > l_nowUs && SIM_NEVER != us ) {
+      l_nowUs = us;
+   }
+}
+
+/******************************************************************************/
+void SIM_sendToBoard( const uint8_t *frame, const uint16_t len )
+{
+   SIM_queue( SIM_TO_BOARD, frame, len );
+}
+
+/******************************************************************************/
+uint64_t SIM_nextDueUs( void )
+{
+   uint64_t next = SIM_NEVER;
+   for ( uint8_t d = 0; d < SIM_DIRS; d++ ) {
+      if ( l_wire[d].count > 0 && l_wire[d].ring[l_wire[d].head].dueUs < next ) {
+         next = l_wire[d].ring[l_wire[d].head].dueUs;
+      }
+   }
+   return next;
+}
+
+/******************************************************************************/
+void SIM_deliverDue( void )
+{
+   bool delivered;
+   do {
+      /* Delivering a frame can put new ones on the wire so start over each
+       * time and always take the oldest one of the two directions */
+      delivered = false;
+      SimDir_t dir = SIM_DIRS;
+      uint64_t due = l_nowUs + 1;
+      for ( uint8_t d = 0; d < SIM_DIRS; d++ ) {
+         if ( l_wire[d].count > 0 && l_wire[d].ring[l_wire[d].head].dueUs < due ) {
+            due = l_wire[d].ring[l_wire[d].head].dueUs;
+            dir = (SimDir_t)d;
+         }
+      }
+
+      if ( SIM_DIRS != dir ) {
+         SimWire_t  *w = &l_wire[dir];
+         SimFrame_t  f = w->ring[w->head];
+         w->head = ( w->head + 1 ) % ( sizeof(w->ring) / sizeof(w->ring[0]) );
+         w->count--;
+
+         l_stats.frames[dir]++;
+         l_stats.bytes[dir] += f.len;
+         if ( NULL != l_pcap ) {
+            SIM_pcapWrite( &f );
+         }
+
+         if ( SIM_TO_BOARD == dir ) {
+            SIM_boardReceive( f.data, f.len );
+         } else {
+            PEER_input( f.data, f.len );
+         }
+         delivered = true;
+      }
+   } while ( delivered );
+}
+
+/******************************************************************************/
+const SimStats_t* SIM_getStats( void )
+{
+   return &l_stats;
+}
+
+/******************************************************************************/
+struct netif* SIM_getNetif( void )
+{
+   return &l_netif;
+}
+
+/******************************************************************************/
+u32_t sys_now( void )
+{
+   return (u32_t)( l_nowUs / 1000 );
+}
+
+/******************************************************************************/
+void * MEM_DataCopy( void * destination, const void * source, uint16_t num )
+{
+   /* memcpy.S on the board, same length limit */
+   return memcpy( destination, source, num );
+}
+
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
@@ -0,0 +1,142 @@
+/**
+ * @file    bench_sim.h
+ * @brief   Simulated wire between the board's lwIP and a host PC for the bench.
+ *
+ * Time is virtual.  Nothing runs between events so a run takes as long as the
+ * stack takes to process it, not as long as the time it covers, and the results
+ * are the same every time.  The wire models:
+ *    - the link rate, with the preamble, FCS, and inter-frame gap counted.
+ *    - a one-way latency for the switch and the stack of the PC.
+ *    - the ETH_TXBUFNB TX DMA descriptors of the board.  A frame sent while all
+ *    of them are still on the wire is lost like on the board.
+ *    - the RX side of the board: every frame is copied into a PBUF_POOL chain
+ *    like low_level_receive() does and dropped if the pool is empty.
+ *
+ * The board side is a netif handed to lwIP, the PC side is bench_peer.c.  Both
+ * directions can be written to a pcap file to look at with Wireshark.
+ *
+ * @date    10/19/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef BENCH_SIM_H_
+#define BENCH_SIM_H_
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "lwip/netif.h"
+
+/* Exported defines ----------------------------------------------------------*/
+#define SIM_FRAME_MAX        1514      /**< Largest frame without the FCS */
+#define SIM_TX_DESCS         5         /**< ETH_TXBUFNB in stm32f4x7_eth.h */
+#define SIM_NEVER            UINT64_MAX   /**< No event pending */
+
+/* Exported types ------------------------------------------------------------*/
+
+/**
+ * @brief   Direction of a frame on the wire.
+ */
+typedef enum {
+   SIM_TO_PEER = 0,                             /**< Sent by the board */
+   SIM_TO_BOARD,                                  /**< Sent by the PC */
+   SIM_DIRS
+} SimDir_t;
+
+/**
+ * @brief   What the wire and the board driver counted.
+ */
+typedef struct {
+   uint32_t frames[SIM_DIRS];                  /**< Frames delivered */
+   uint64_t bytes[SIM_DIRS];                    /**< Bytes delivered */
+   uint32_t txDescDrops;     /**< Board frames lost to busy TX descriptors */
+   uint32_t rxNoPbuf;      /**< Frames to the board lost to an empty pool */
+   uint32_t wireDrops;         /**< Frames lost to a full wire queue (bug) */
+} SimStats_t;
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief   Set up the wire and add the board netif to lwIP.
+ *
+ * lwip_init() has to be called first.  The board gets the static IP address
+ * and MAC address from lwipopts.h.
+ *
+ * @param [in] linkMbit: uint32_t link rate in Mbit/s.
+ * @param [in] latencyUs: uint32_t one-way latency on top of the link rate.
+ * @param [in] *pcapFile: const char pointer to the name of the pcap file to
+ * write, NULL for none.
+ * @return  bool: true if success, false if the pcap file couldn't be opened.
+ */
+bool SIM_init(
+      const uint32_t linkMbit,
+      const uint32_t latencyUs,
+      const char *pcapFile
+);
+
+/**
+ * @brief   Flush and close the pcap file, if any.
+ * @param   None
+ * @return  None
+ */
+void SIM_close( void );
+
+/**
+ * @brief   Get the virtual time.
+ * @param   None
+ * @return  uint64_t: us since the start of the run.
+ */
+uint64_t SIM_nowUs( void );
+
+/**
+ * @brief   Move the virtual time forward.
+ * @param [in] us: uint64_t time to move to.  Earlier times are ignored.
+ * @return  None
+ */
+void SIM_advance( const uint64_t us );
+
+/**
+ * @brief   Put a frame from the PC on the wire to the board.
+ * @param [in] *frame: const uint8_t pointer to the ethernet frame.
+ * @param [in] len: uint16_t length of the frame.
+ * @return  None
+ */
+void SIM_sendToBoard( const uint8_t *frame, const uint16_t len );
+
+/**
+ * @brief   Get the time the next frame arrives at either end.
+ * @param   None
+ * @return  uint64_t: the time in us, SIM_NEVER if the wire is empty.
+ */
+uint64_t SIM_nextDueUs( void );
+
+/**
+ * @brief   Deliver every frame that has arrived by now.
+ *
+ * Frames to the board go into ethernet_input(), frames to the PC into
+ * PEER_input().
+ *
+ * @param   None
+ * @return  None
+ */
+void SIM_deliverDue( void );
+
+/**
+ * @brief   Get the counters of the wire and the board driver.
+ * @param   None
+ * @return  const SimStats_t*: pointer to the counters.
+ */
+const SimStats_t* SIM_getStats( void );
+
+/**
+ * @brief   Get the board netif.
+ * @param   None
+ * @return  struct netif*: pointer to the netif added by SIM_init().
+ */
+struct netif* SIM_getNetif( void );
+
+#endif                                                       /* BENCH_SIM_H_ */
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
@@ -0,0 +1,1000 @@
+/**
+ * @file    lwip_bench.c
+ * @brief   Host bench for tuning lwipopts.h against throughput.
+ *
+ * Builds the lwIP the board uses with the board's lwipopts.h (plus the option
+ * set being measured, see the Makefile) and runs it against a simulated PC over
+ * a simulated wire (see bench_sim.h and bench_peer.h).  The board side does
+ * what LWIPMgr does with lwIP:
+ *    - UDP on the cli port: every request is taken out of its pbuf right away
+ *    and the reply sent thinkUs later from a pbuf_new() style PBUF_RAM, the way
+ *    CommMgr replies.  Replies wait in a queue as deep as the deferred queue of
+ *    LWIPMgr.
+ *    - TCP on the log port: log lines wait in that same size of queue and get
+ *    copied with pbuf_new() and tcp_write() whenever tcp_sndbuf() has room.
+ *    Like LWIPMgr, nothing calls tcp_output() (-O to try it) so data goes out
+ *    when an ack comes in or on the poll of tcp_slowtmr().
+ *    - tcp_tmr() every TCP_TMR_INTERVAL ms, etharp_tmr() every ARP_TMR_INTERVAL.
+ *
+ * The PC keeps depth UDP requests in flight (closed loop) and receives the log
+ * stream, either at a set rate of lines or as fast as the board can send them.
+ * At the end it reports UDP request rate and round trip times, log throughput
+ * and line latency (from the line being queued to the PC having all of it),
+ * and how close every lwIP pool and the heap came to running out.
+ *
+ * Times are virtual and the CPU of the board isn't modeled.  What comes out is
+ * how the buffers, windows, and timers of the option set limit the traffic,
+ * not how fast the board runs the stack.
+ *
+ * @date    10/19/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+
+#include "bench_sim.h"
+#include "bench_peer.h"
+
+#include "lwip/opt.h"
+#include "lwip/init.h"
+#include "lwip/mem.h"
+#include "lwip/memp.h"
+#include "lwip/pbuf.h"
+#include "lwip/stats.h"
+#include "lwip/tcp.h"
+#include "lwip/tcp_impl.h"
+#include "lwip/udp.h"
+#include "netif/etharp.h"
+
+/* Private typedefs ----------------------------------------------------------*/
+
+/**
+ * @brief   Which traffic to run.
+ */
+typedef enum {
+   BENCH_UDP  = 0x01,                        /**< UDP request/response only */
+   BENCH_TCP  = 0x02,                             /**< TCP log stream only */
+   BENCH_BOTH = 0x03                        /**< Both at once, the default */
+} BenchWorkload_t;
+
+/**
+ * @brief   Settings of a run.
+ */
+typedef struct {
+   BenchWorkload_t workload;
+   uint32_t durationMs;                        /**< Virtual length of run */
+   uint32_t linkMbit;
+   uint32_t latencyUs;                               /**< One-way latency */
+   uint16_t udpDepth;                  /**< UDP requests kept in flight */
+   uint16_t udpReqLen;
+   uint16_t udpRespLen;
+   uint32_t udpThinkUs;       /**< From request to reply on the board */
+   uint32_t udpTimeoutMs;              /**< Same as the 2 s of the client */
+   uint16_t logLineLen;
+   uint32_t logRate;             /**< Lines per sec, 0 for as fast as can */
+   uint16_t logQueueLen;   /**< Log lines the board holds before dropping */
+   bool     logOutput;        /**< Call tcp_output() after every tcp_write */
+   uint8_t  ackEvery;               /**< PC acks every this many segments */
+   uint32_t ackDelayMs;             /**< ...or after this long, delayed ack */
+   const char *pcap;
+   const char *csvSet;         /**< Name of the set to print a CSV row for */
+} BenchCfg_t;
+
+/**
+ * @brief   A UDP reply the board still owes.
+ */
+typedef struct {
+   uint32_t       tag;                       /**< From the request, echoed */
+   struct ip_addr addr;
+   u16_t          port;
+   uint64_t       dueUs;
+} BenchReply_t;
+
+/**
+ * @brief   A UDP request of the PC in flight.
+ */
+typedef struct {
+   bool     active;
+   uint32_t tag;
+   uint64_t sentUs;
+} BenchReq_t;
+
+/**
+ * @brief   Same as echo_state of LWIPMgr so the heap sees the same use.
+ */
+typedef struct {
+   uint8_t         state;
+   uint8_t         retries;
+   struct tcp_pcb *pcb;
+   struct pbuf    *p;
+} BenchEs_t;
+
+/**
+ * @brief   A growing list of samples.
+ */
+typedef struct {
+   uint32_t *v;
+   size_t    n;
+   size_t    cap;
+} BenchSamples_t;
+
+/* Private defines -----------------------------------------------------------*/
+#define BENCH_LOG_PORT       1501               /**< LWIPMgr_logPort */
+#define BENCH_CLI_PORT       1502               /**< LWIPMgr_cliPort */
+#define BENCH_PC_UDP_PORT    50001
+#define BENCH_QUEUE_MAX      100    /**< deferredEvtQSto depth of LWIPMgr */
+#define BENCH_UDP_DEPTH_MAX  64
+#define BENCH_TAG_LEN        4       /**< UDP tag at the start of req/reply */
+#define BENCH_STAMP_LEN      8    /**< Queue time at the start of a log line */
+
+/* Private macros ------------------------------------------------------------*/
+#define BENCH_MIN(a, b)      ( (a) < (b) ? (a) : (b) )
+
+/* Private variables and Local objects ---------------------------------------*/
+static BenchCfg_t l_cfg = {
+      .workload     = BENCH_BOTH,
+      .durationMs   = 10000,
+      .linkMbit     = 100,
+      .latencyUs    = 100,
+      .udpDepth     = 1,
+      .udpReqLen    = 64,
+      .udpRespLen   = 256,
+      .udpThinkUs   = 200,
+      .udpTimeoutMs = 2000,
+      .logLineLen   = 128,
+      .logRate      = 0,
+      .logQueueLen  = BENCH_QUEUE_MAX,
+      .logOutput    = false,
+      .ackEvery     = 2,
+      .ackDelayMs   = 40,
+      .pcap         = NULL,
+      .csvSet       = NULL,
+};
+
+/* The board */
+static struct udp_pcb *l_udpPcb;
+static BenchReply_t    l_replies[BENCH_QUEUE_MAX];
+static uint16_t        l_replyHead;
+static uint16_t        l_replyCount;
+static BenchEs_t      *l_logEs;
+static uint64_t        l_logQueue[BENCH_QUEUE_MAX];      /* Queue times */
+static uint16_t        l_logHead;
+static uint16_t        l_logCount;
+static uint64_t        l_logNextUs;
+static uint32_t        l_arpTmr;
+
+/* The PC */
+static BenchReq_t      l_reqs[BENCH_UDP_DEPTH_MAX];
+static uint32_t        l_nextTag;
+static uint8_t         l_lineStamp[BENCH_STAMP_LEN];
+static uint16_t        l_lineGot;
+static uint64_t        l_tcpUpUs;
+
+/* Results */
+static BenchSamples_t  l_rtts;                                         /* us */
+static BenchSamples_t  l_lineLats;                                     /* us */
+static uint32_t        l_udpTimeouts;
+static uint32_t        l_udpQueueDrops;   /* Board reply queue was full */
+static uint32_t        l_udpNoMem;        /* No pbuf for the reply, retried */
+static uint32_t        l_udpSendErrs;            /* udp_sendto() failed */
+static uint64_t        l_logBytes;                  /* Received by the PC */
+static uint32_t        l_logQueued;
+static uint32_t        l_logDropped;       /* Board log queue was full */
+static uint32_t        l_logNoMem;        /* No pbuf to copy the line to */
+static uint32_t        l_logWriteErrs;          /* tcp_write() ERR_MEM */
+
+/* Private function prototypes -----------------------------------------------*/
+
+/**
+ * @brief   Add a sample to a set.
+ * @param [in|out] *s: BenchSamples_t pointer to the set.  Grows as needed.
+ * @param [in] v: uint32_t sample.
+ * @return  None
+ */
+static void BENCH_sampleAdd( BenchSamples_t *s, const uint32_t v );
+
+/**
+ * @brief   Get a percentile of a set.
+ * @param [in|out] *s: BenchSamples_t pointer to the set.  Gets sorted.
+ * @param [in] pct: uint8_t percentile, 0 to 100.
+ * @return  uint32_t: the sample at pct, 0 if the set is empty.
+ */
+static uint32_t BENCH_samplePct( BenchSamples_t *s, const uint8_t pct );
+
+/**
+ * @brief   Get the average of a set.
+ * @param [in] *s: const BenchSamples_t pointer to the set.
+ * @return  uint32_t: the average, 0 if the set is empty.
+ */
+static uint32_t BENCH_sampleAvg( const BenchSamples_t *s );
+
+/**
+ * @brief   qsort compare for uint32_t.
+ * @param [in] *a: const void pointer to the first value.
+ * @param [in] *b: const void pointer to the second value.
+ * @return  int: <0, 0 or >0 like qsort wants.
+ */
+static int      BENCH_cmpU32( const void *a, const void *b );
+
+/**
+ * @brief   Bring up lwIP and the pcbs of the board the way LWIPMgr does.
+ * @param   None
+ * @return  None
+ */
+static void     BENCH_boardInit( void );
+
+/**
+ * @brief   UDP recv callback of the board.  Queues the reply the way LWIPMgr
+ * queues a msg for the app.
+ * @param [in] *arg: void pointer, not used.
+ * @param [in] *upcb: udp_pcb pointer it came in on.
+ * @param [in] *p: pbuf pointer to the request.  Freed here.
+ * @param [in] *addr: ip_addr pointer of the PC.
+ * @param [in] port: u16_t port of the PC.
+ * @return  None
+ */
+static void     BENCH_boardUdpRecv(
+      void *arg,
+      struct udp_pcb *upcb,
+      struct pbuf *p,
+      struct ip_addr *addr,
+      u16_t port
+);
+
+/**
+ * @brief   Send the UDP replies that are due.  Tries again a tick later if
+ * there's no memory for one.
+ * @param   None
+ * @return  None
+ */
+static void     BENCH_boardReply( void );
+
+/**
+ * @brief   TCP accept callback of the board, same as LWIP_tcpAccept.
+ * @param [in] *arg: void pointer, not used.
+ * @param [in] *newpcb: tcp_pcb pointer of the new connection.
+ * @param [in] err: err_t from lwIP.
+ * @return  err_t: ERR_OK if accepted, ERR_MEM if the state couldn't be had.
+ */
+static err_t    BENCH_boardAccept( void *arg, struct tcp_pcb *newpcb, err_t err );
+
+/**
+ * @brief   TCP recv callback of the board.  Throws away data, closes on FIN.
+ * @param [in] *arg: void pointer to the BenchEs_t of the connection.
+ * @param [in] *tpcb: tcp_pcb pointer of the connection.
+ * @param [in] *p: pbuf pointer to the data, NULL on FIN.
+ * @param [in] err: err_t from lwIP.
+ * @return  err_t: ERR_OK
+ */
+static err_t    BENCH_boardTcpRecv(
+      void *arg,
+      struct tcp_pcb *tpcb,
+      struct pbuf *p,
+      err_t err
+);
+
+/**
+ * @brief   TCP sent callback of the board.  Writes more log lines.
+ * @param [in] *arg: void pointer to the BenchEs_t of the connection.
+ * @param [in] *tpcb: tcp_pcb pointer of the connection.
+ * @param [in] len: u16_t bytes acked.
+ * @return  err_t: ERR_OK
+ */
+static err_t    BENCH_boardTcpSent( void *arg, struct tcp_pcb *tpcb, u16_t len );
+
+/**
+ * @brief   TCP poll callback of the board.  Writes more log lines.
+ * @param [in] *arg: void pointer to the BenchEs_t of the connection.
+ * @param [in] *tpcb: tcp_pcb pointer of the connection.
+ * @return  err_t: ERR_OK
+ */
+static err_t    BENCH_boardTcpPoll( void *arg, struct tcp_pcb *tpcb );
+
+/**
+ * @brief   TCP err callback of the board.  The pcb is gone so forget it.
+ * @param [in] *arg: void pointer to the BenchEs_t of the connection.
+ * @param [in] err: err_t from lwIP.
+ * @return  None
+ */
+static void     BENCH_boardTcpErr( void *arg, err_t err );
+
+/**
+ * @brief   Write queued log lines to the log connection the way the log port
+ * does, until lwIP won't take any more.
+ * @param   None
+ * @return  None
+ */
+static void     BENCH_boardLogSend( void );
+
+/**
+ * @brief   Queue the log lines made since the last call.
+ * @param [in] endUs: uint64_t time in us after which no more lines get made.
+ * @return  None
+ */
+static void     BENCH_boardLogGen( const uint64_t endUs );
+
+/**
+ * @brief   Run the lwIP timers the way LWIP_SLOW_TICK does.
+ * @param   None
+ * @return  None
+ */
+static void     BENCH_boardTick( void );
+
+/**
+ * @brief   Send a UDP request from the PC.
+ * @param [in|out] *r: BenchReq_t pointer to the request slot to use.
+ * @return  None
+ */
+static void     BENCH_pcUdpSend( BenchReq_t *r );
+
+/**
+ * @brief   PC callback for a UDP reply.  Matches it to its request by tag.
+ * @param [in] srcPort: uint16_t port of the board it came from.
+ * @param [in] *data: const uint8_t pointer to the payload.
+ * @param [in] len: uint16_t length of the payload.
+ * @return  None
+ */
+static void     BENCH_pcUdpRecv(
+      const uint16_t srcPort,
+      const uint8_t *data,
+      const uint16_t len
+);
+
+/**
+ * @brief   Time out UDP requests and send new ones into the free slots.
+ * @param [in] endUs: uint64_t time in us after which no new requests go out.
+ * @return  None
+ */
+static void     BENCH_pcUdpService( const uint64_t endUs );
+
+/**
+ * @brief   PC callback for log data.  Splits it into lines and times them.
+ * @param [in] *data: const uint8_t pointer to the data.
+ * @param [in] len: uint16_t length of the data.
+ * @return  None
+ */
+static void     BENCH_pcTcpRecv( const uint8_t *data, const uint16_t len );
+
+/**
+ * @brief   Get the time the bench itself next has something to do.
+ * @param   None
+ * @return  uint64_t: the time in us, SIM_NEVER if nothing is waiting.
+ */
+static uint64_t BENCH_nextDueUs( void );
+
+/**
+ * @brief   Print the results of a run for a person to read.
+ * @param   None
+ * @return  None
+ */
+static void     BENCH_report( void );
+
+/**
+ * @brief   Print the results of a run as one CSV row.
+ * @param [in] header: bool true to print the header row instead.
+ * @return  None
+ */
+static void     BENCH_csv( const bool header );
+
+/**
+ * @brief   Print how to use the bench.
+ * @param [in] *appName: const char pointer to the name it was run as.
+ * @return  None
+ */
+static void     BENCH_usage( const char *appName );
+
+/**
+ * @brief   Names of the memp pools in memp_t order.
+ */
+static const char * const l_mempNames[MEMP_MAX] = {
+#define LWIP_MEMPOOL(name,num,size,desc)  desc,
+#include "lwip/memp_std.h"
+};
+
+/* Private functions ---------------------------------------------------------*/
+/******************************************************************************/
+static void BENCH_sampleAdd( BenchSamples_t *s, const uint32_t v )
+{
+   if ( s->n == s->cap ) {
+      s->cap = s->cap ? s->cap * 2 : 1024;
+      s->v   = realloc( s->v, s->cap * sizeof(s->v[0]) );
+      if ( NULL == s->v ) {
+         fprintf( stderr, "Out of memory for samples\n" );
+         exit( 1 );
+      }
+   }
+   s->v[s->n++] = v;
+}
+
+/******************************************************************************/
+static int BENCH_cmpU32( const void *a, const void *b )
+{
+   uint32_t x = *(const uint32_t *)a;
+   uint32_t y = *(const uint32_t *)b;
+   return ( x > y ) - ( x < y );
+}
+
+/******************************************************************************/
+static uint32_t BENCH_samplePct( BenchSamples_t *s, const uint8_t pct )
+{
+   if ( 0 == s->n ) {
+      return 0;
+   }
+   qsort( s->v, s->n, sizeof(s->v[0]), BENCH_cmpU32 );
+   return s->v[BENCH_MIN( s->n - 1, s->n * pct / 100 )];
+}
+
+/******************************************************************************/
+static uint32_t BENCH_sampleAvg( const BenchSamples_t *s )
+{
+   uint64_t sum = 0;
+   for ( size_t i = 0; i < s->n; i++ ) {
+      sum += s->v[i];
+   }
+   return s->n ? (uint32_t)( sum / s->n ) : 0;
+}
+
+/******************************************************************************/
+static void BENCH_boardInit( void )
+{
+   if ( l_cfg.workload & BENCH_UDP ) {
+      l_udpPcb = udp_new();
+      udp_bind( l_udpPcb, IP_ADDR_ANY, BENCH_CLI_PORT );
+      udp_recv( l_udpPcb, BENCH_boardUdpRecv, NULL );
+   }
+
+   if ( l_cfg.workload & BENCH_TCP ) {
+      struct tcp_pcb *pcb = tcp_new();
+      tcp_bind( pcb, IP_ADDR_ANY, BENCH_LOG_PORT );
+      pcb = tcp_listen( pcb );
+      tcp_accept( pcb, BENCH_boardAccept );
+   }
+}
+
+/******************************************************************************/
+static void BENCH_boardUdpRecv(
+      void *arg,
+      struct udp_pcb *upcb,
+      struct pbuf *p,
+      struct ip_addr *addr,
+      u16_t port
+)
+{
+   uint32_t tag = 0;
+   (void)arg;
+   (void)upcb;
+
+   /* LWIPMgr copies the msg into an event and frees the pbuf right away */
+   pbuf_copy_partial( p, &tag, sizeof(tag), 0 );
+   pbuf_free( p );
+
+   if ( l_replyCount >= BENCH_QUEUE_MAX ) {
+      l_udpQueueDrops++;
+      return;
+   }
+   BenchReply_t *r = &l_replies[( l_replyHead + l_replyCount++ ) % BENCH_QUEUE_MAX];
+   r->tag   = tag;
+   r->addr  = *addr;
+   r->port  = port;
+   r->dueUs = SIM_nowUs() + l_cfg.udpThinkUs;
+}
+
+/******************************************************************************/
+static void BENCH_boardReply( void )
+{
+   while ( l_replyCount > 0 && l_replies[l_replyHead].dueUs <= SIM_nowUs() ) {
+      BenchReply_t *r = &l_replies[l_replyHead];
+
+      struct pbuf *p = pbuf_alloc( PBUF_TRANSPORT, l_cfg.udpRespLen, PBUF_RAM );
+      if ( NULL == p ) {
+         /* LWIPMgr waits in Sending and tries again */
+         l_udpNoMem++;
+         r->dueUs = SIM_nowUs() + TCP_TMR_INTERVAL * 1000;
+         return;
+      }
+      memset( p->payload, 'r', p->len );
+      pbuf_take( p, &r->tag, sizeof(r->tag) );
+
+      if ( ERR_OK != udp_sendto( l_udpPcb, p, &r->addr, r->port ) ) {
+         l_udpSendErrs++;
+      }
+      pbuf_free( p );
+
+      l_replyHead = ( l_replyHead + 1 ) % BENCH_QUEUE_MAX;
+      l_replyCount--;
+   }
+}
+
+/******************************************************************************/
+static err_t BENCH_boardAccept( void *arg, struct tcp_pcb *newpcb, err_t err )
+{
+   (void)arg;
+   (void)err;
+
+   tcp_setprio( newpcb, TCP_PRIO_MIN );
+   BenchEs_t *es = (BenchEs_t *)mem_malloc( sizeof(BenchEs_t) );
+   if ( NULL == es ) {
+      return ERR_MEM;
+   }
+   memset( es, 0, sizeof(*es) );
+   es->pcb = newpcb;
+
+   tcp_arg( newpcb, es );
+   tcp_recv( newpcb, BENCH_boardTcpRecv );
+   tcp_err( newpcb, BENCH_boardTcpErr );
+   tcp_poll( newpcb, BENCH_boardTcpPoll, 0 );
+   tcp_sent( newpcb, BENCH_boardTcpSent );
+   l_logEs = es;
+   return ERR_OK;
+}
+
+/******************************************************************************/
+static err_t BENCH_boardTcpRecv(
+      void *arg,
+      struct tcp_pcb *tpcb,
+      struct pbuf *p,
+      err_t err
+)
+{
+   (void)arg;
+   (void)err;
+
+   if ( NULL == p ) {                               /* The PC closed it */
+      tcp_arg( tpcb, NULL );
+      tcp_close( tpcb );
+      mem_free( l_logEs );
+      l_logEs = NULL;
+      return ERR_OK;
+   }
+   tcp_recved( tpcb, p->tot_len );
+   pbuf_free( p );
+   return ERR_OK;
+}
+
+/******************************************************************************/
+static err_t BENCH_boardTcpSent( void *arg, struct tcp_pcb *tpcb, u16_t len )
+{
+   (void)arg;
+   (void)tpcb;
+   (void)len;
+   BENCH_boardLogSend();
+   return ERR_OK;
+}
+
+/******************************************************************************/
+static err_t BENCH_boardTcpPoll( void *arg, struct tcp_pcb *tpcb )
+{
+   (void)arg;
+   (void)tpcb;
+   BENCH_boardLogSend();
+   return ERR_OK;
+}
+
+/******************************************************************************/
+static void BENCH_boardTcpErr( void *arg, err_t err )
+{
+   (void)err;
+   mem_free( arg );
+   l_logEs = NULL;
+}
+
+/******************************************************************************/
+static void BENCH_boardLogSend( void )
+{
+   if ( NULL == l_logEs ) {
+      return;
+   }
+
+   struct tcp_pcb *pcb = l_logEs->pcb;
+   while ( l_logCount > 0 && l_cfg.logLineLen <= tcp_sndbuf( pcb ) ) {
+      /* Same double copy as LWIP_tcpSend(): into a pbuf_new() and then into
+       * the segment by tcp_write() */
+      struct pbuf *p = pbuf_alloc( PBUF_TRANSPORT, l_cfg.logLineLen, PBUF_RAM );
+      if ( NULL == p ) {
+         l_logNoMem++;
+         break;
+      }
+      memset( p->payload, 'l', p->len );
+      pbuf_take( p, &l_logQueue[l_logHead], BENCH_STAMP_LEN );
+
+      err_t err = tcp_write( pcb, p->payload, p->len, TCP_WRITE_FLAG_COPY );
+      pbuf_free( p );
+      if ( ERR_OK != err ) {
+         l_logWriteErrs++;
+         break;
+      }
+      l_logHead = ( l_logHead + 1 ) % BENCH_QUEUE_MAX;
+      l_logCount--;
+   }
+
+   if ( l_cfg.logOutput ) {
+      tcp_output( pcb );
+   }
+}
+
+/******************************************************************************/
+static void BENCH_boardLogGen( const uint64_t endUs )
+{
+   uint64_t now   = SIM_nowUs();
+   bool     added = false;
+
+   if ( NULL == l_logEs || now >= endUs ) {
+      return;
+   }
+
+   if ( 0 == l_cfg.logRate ) {                        /* Keep it full */
+      while ( l_logCount < l_cfg.logQueueLen ) {
+         l_logQueue[( l_logHead + l_logCount++ ) % BENCH_QUEUE_MAX] = now;
+         l_logQueued++;
+         added = true;
+      }
+   } else {
+      while ( l_logNextUs <= now ) {
+         if ( l_logCount < l_cfg.logQueueLen ) {
+            l_logQueue[( l_logHead + l_logCount++ ) % BENCH_QUEUE_MAX] = l_logNextUs;
+            l_logQueued++;
+            added = true;
+         } else {
+            l_logDropped++;
+         }
+         l_logNextUs += 1000000 / l_cfg.logRate;
+      }
+   }
+
+   if ( added ) {
+      BENCH_boardLogSend();
+   }
+}
+
+/******************************************************************************/
+static void BENCH_boardTick( void )
+{
+   /* Same as LWIP_SLOW_TICK_SIG in LWIPMgr */
+   tcp_tmr();
+
+   l_arpTmr += TCP_TMR_INTERVAL;
+   if ( l_arpTmr >= ARP_TMR_INTERVAL ) {
+      l_arpTmr = 0;
+      etharp_tmr();
+   }
+}
+
+/******************************************************************************/
+static void BENCH_pcUdpSend( BenchReq_t *r )
+{
+   uint8_t req[1472];
+   uint16_t len = BENCH_MIN( sizeof(req), l_cfg.udpReqLen );
+
+   memset( req, 'q', len );
+   r->active = true;
+   r->tag    = l_nextTag++;
+   r->sentUs = SIM_nowUs();
+   memcpy( req, &r->tag, BENCH_MIN( len, BENCH_TAG_LEN ) );
+   PEER_udpSend( BENCH_PC_UDP_PORT, BENCH_CLI_PORT, req, len );
+}
+
+/******************************************************************************/
+static void BENCH_pcUdpRecv(
+      const uint16_t srcPort,
+      const uint8_t *data,
+      const uint16_t len
+)
+{
+   uint32_t tag;
+
+   if ( BENCH_CLI_PORT != srcPort || len < BENCH_TAG_LEN ) {
+      return;
+   }
+   memcpy( &tag, data, sizeof(tag) );
+
+   for ( uint16_t i = 0; i < l_cfg.udpDepth; i++ ) {
+      if ( l_reqs[i].active && l_reqs[i].tag == tag ) {
+         BENCH_sampleAdd( &l_rtts, (uint32_t)( SIM_nowUs() - l_reqs[i].sentUs ) );
+         l_reqs[i].active = false;
+         break;
+      }
+   }
+}
+
+/******************************************************************************/
+static void BENCH_pcUdpService( const uint64_t endUs )
+{
+   for ( uint16_t i = 0; i < l_cfg.udpDepth; i++ ) {
+      BenchReq_t *r = &l_reqs[i];
+      if ( r->active && SIM_nowUs() >= r->sentUs + l_cfg.udpTimeoutMs * 1000ULL ) {
+         l_udpTimeouts++;
+         r->active = false;
+      }
+      if ( !r->active && SIM_nowUs() < endUs ) {
+         BENCH_pcUdpSend( r );
+      }
+   }
+}
+
+/******************************************************************************/
+static void BENCH_pcTcpRecv( const uint8_t *data, const uint16_t len )
+{
+   l_logBytes += len;
+
+   /* Lines are all the same length so only the stamp needs to be kept */
+   for ( uint16_t i = 0; i < len; i++ ) {
+      if ( l_lineGot < BENCH_STAMP_LEN ) {
+         l_lineStamp[l_lineGot] = data[i];
+      }
+      if ( ++l_lineGot == l_cfg.logLineLen ) {
+         uint64_t queuedUs;
+         memcpy( &queuedUs, l_lineStamp, sizeof(queuedUs) );
+         BENCH_sampleAdd( &l_lineLats, (uint32_t)( SIM_nowUs() - queuedUs ) );
+         l_lineGot = 0;
+      }
+   }
+}
+
+/******************************************************************************/
+static uint64_t BENCH_nextDueUs( void )
+{
+   uint64_t next = SIM_NEVER;
+
+   for ( uint16_t i = 0; i < l_cfg.udpDepth; i++ ) {
+      if ( l_reqs[i].active ) {
+         next = BENCH_MIN( next, l_reqs[i].sentUs + l_cfg.udpTimeoutMs * 1000ULL );
+      }
+   }
+   if ( l_replyCount > 0 ) {
+      next = BENCH_MIN( next, l_replies[l_replyHead].dueUs );
+   }
+   if ( NULL != l_logEs && 0 != l_cfg.logRate ) {
+      next = BENCH_MIN( next, l_logNextUs );
+   }
+   return next;
+}
+
+/******************************************************************************/
+static void BENCH_report( void )
+{
+   const SimStats_t  *sim  = SIM_getStats();
+   const PeerStats_t *peer = PEER_getStats();
+   double secs = l_cfg.durationMs / 1000.0;
+
+   printf( "lwIP bench: %u ms at %u Mbit/s, %u us one-way\n",
+         l_cfg.durationMs, l_cfg.linkMbit, l_cfg.latencyUs );
+   printf( "Options: MEM_SIZE=%u MEMP_NUM_PBUF=%u PBUF_POOL_SIZE=%u "
+         "MEMP_NUM_TCP_PCB=%u MEMP_NUM_TCP_SEG=%u\n",
+         (unsigned)MEM_SIZE, (unsigned)MEMP_NUM_PBUF, (unsigned)PBUF_POOL_SIZE,
+         (unsigned)MEMP_NUM_TCP_PCB, (unsigned)MEMP_NUM_TCP_SEG );
+   printf( "         TCP_MSS=%u TCP_WND=%u TCP_SND_BUF=%u TCP_SND_QUEUELEN=%u "
+         "TCP_TMR_INTERVAL=%u\n\n",
+         (unsigned)TCP_MSS, (unsigned)TCP_WND, (unsigned)TCP_SND_BUF,
+         (unsigned)TCP_SND_QUEUELEN, (unsigned)TCP_TMR_INTERVAL );
+
+   if ( l_cfg.workload & BENCH_UDP ) {
+      printf( "UDP request/response: %u in flight, %u byte requests, "
+            "%u byte replies, %u us to reply\n",
+            l_cfg.udpDepth, l_cfg.udpReqLen, l_cfg.udpRespLen, l_cfg.udpThinkUs );
+      printf( "   replies:   %zu (%.0f/s)\n", l_rtts.n, l_rtts.n / secs );
+      printf( "   rtt (us):  min %u, avg %u, p99 %u, max %u\n",
+            BENCH_samplePct( &l_rtts, 0 ), BENCH_sampleAvg( &l_rtts ),
+            BENCH_samplePct( &l_rtts, 99 ), BENCH_samplePct( &l_rtts, 100 ) );
+      printf( "   lost:      %u timed out, %u reply queue full, "
+            "%u udp_sendto() errors, %u retries for a pbuf\n\n",
+            l_udpTimeouts, l_udpQueueDrops, l_udpSendErrs, l_udpNoMem );
+   }
+
+   if ( l_cfg.workload & BENCH_TCP ) {
+      double upSecs = ( l_cfg.durationMs * 1000.0 - l_tcpUpUs ) / 1000000.0;
+      printf( "TCP log stream: %u byte lines, %s, tcp_output() %s\n",
+            l_cfg.logLineLen, l_cfg.logRate ? "at a set rate" : "as fast as it goes",
+            l_cfg.logOutput ? "after every write" : "never called (as on the board)" );
+      if ( 0 == l_tcpUpUs ) {
+         printf( "   never connected\n\n" );
+      } else {
+         printf( "   received:  %llu bytes (%.1f kB/s), %zu of %u lines queued\n",
+               (unsigned long long)l_logBytes, l_logBytes / upSecs / 1000.0,
+               l_lineLats.n, l_logQueued );
+         printf( "   latency (ms): avg %.1f, p99 %.1f, max %.1f\n",
+               BENCH_sampleAvg( &l_lineLats ) / 1000.0,
+               BENCH_samplePct( &l_lineLats, 99 ) / 1000.0,
+               BENCH_samplePct( &l_lineLats, 100 ) / 1000.0 );
+         printf( "   lost:      %u lines log queue full, %u retries for a pbuf, "
+               "%u tcp_write() errors\n",
+               l_logDropped, l_logNoMem, l_logWriteErrs );
+         printf( "   PC:        %u segments, %u acks, %u out of order or repeated, "
+               "%u resets\n\n",
+               peer->tcpSegs, peer->tcpAcks, peer->tcpOoo, peer->tcpRsts );
+      }
+   }
+
+   printf( "Memory:            size   max used   errors\n" );
+   printf( "   %-14s %7u   %8u   %6u%s\n", "heap",
+         (unsigned)lwip_stats.mem.avail, (unsigned)lwip_stats.mem.max,
+         (unsigned)lwip_stats.mem.err,
+         lwip_stats.mem.err ? "   <- ran out" : "" );
+   for ( uint8_t i = 0; i < MEMP_MAX; i++ ) {
+      printf( "   %-14s %7u   %8u   %6u%s\n", l_mempNames[i],
+            (unsigned)lwip_stats.memp[i].avail, (unsigned)lwip_stats.memp[i].max,
+            (unsigned)lwip_stats.memp[i].err,
+            lwip_stats.memp[i].err ? "   <- ran out" : "" );
+   }
+
+   printf( "\nWire: %u frames to the PC, %u to the board, "
+         "%u lost to busy TX descriptors, %u lost to an empty PBUF_POOL\n",
+         sim->frames[SIM_TO_PEER], sim->frames[SIM_TO_BOARD],
+         sim->txDescDrops, sim->rxNoPbuf );
+   if ( sim->wireDrops || peer->udpFragDrops ) {
+      printf( "Bench: %u frames didn't fit on the wire, %u replies lost in "
+            "reassembly.  Results are suspect.\n",
+            sim->wireDrops, peer->udpFragDrops );
+   }
+}
+
+/******************************************************************************/
+static void BENCH_csv( const bool header )
+{
+   if ( header ) {
+      printf( "set,udp_per_s,udp_rtt_avg_us,udp_rtt_p99_us,udp_timeouts,"
+            "log_kB_per_s,log_lat_avg_ms,log_lat_p99_ms,log_dropped,"
+            "heap_max,heap_errs,pbuf_max,pbuf_errs,pbuf_pool_max,pbuf_pool_errs,"
+            "tcp_seg_max,tcp_seg_errs,tx_drops,rx_drops\n" );
+      return;
+   }
+
+   double secs   = l_cfg.durationMs / 1000.0;
+   double upSecs = l_tcpUpUs ? ( l_cfg.durationMs * 1000.0 - l_tcpUpUs ) / 1000000.0 : 1;
+   printf( "%s,%.0f,%u,%u,%u,%.1f,%.1f,%.1f,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u\n",
+         l_cfg.csvSet,
+         l_rtts.n / secs, BENCH_sampleAvg( &l_rtts ), BENCH_samplePct( &l_rtts, 99 ),
+         l_udpTimeouts,
+         l_logBytes / upSecs / 1000.0,
+         BENCH_sampleAvg( &l_lineLats ) / 1000.0,
+         BENCH_samplePct( &l_lineLats, 99 ) / 1000.0,
+         l_logDropped,
+         (unsigned)lwip_stats.mem.max, (unsigned)lwip_stats.mem.err,
+         (unsigned)lwip_stats.memp[MEMP_PBUF].max, (unsigned)lwip_stats.memp[MEMP_PBUF].err,
+         (unsigned)lwip_stats.memp[MEMP_PBUF_POOL].max,
+         (unsigned)lwip_stats.memp[MEMP_PBUF_POOL].err,
+         (unsigned)lwip_stats.memp[MEMP_TCP_SEG].max,
+         (unsigned)lwip_stats.memp[MEMP_TCP_SEG].err,
+         SIM_getStats()->txDescDrops, SIM_getStats()->rxNoPbuf );
+}
+
+/******************************************************************************/
+static void BENCH_usage( const char *appName )
+{
+   printf(
+      "Usage: %s [options]\n"
+      "   -w udp|tcp|both  traffic to run (%s)\n"
+      "   -t ms            virtual length of the run (%u)\n"
+      "   -b Mbit          link rate (%u)\n"
+      "   -u us            one-way latency of switch and PC (%u)\n"
+      "   -d n             UDP requests in flight, up to %u (%u)\n"
+      "   -q bytes         UDP request size (%u)\n"
+      "   -r bytes         UDP reply size, over 1472 gets fragmented (%u)\n"
+      "   -k us            time the board takes to reply (%u)\n"
+      "   -l bytes         log line size (%u)\n"
+      "   -L lines         log lines per sec, 0 for as fast as it goes (%u)\n"
+      "   -Q n             log lines the board holds, up to %u (%u)\n"
+      "   -O               call tcp_output() after every tcp_write()\n"
+      "   -a n             PC acks every n segments (%u)\n"
+      "   -A ms            PC delayed ack time (%u)\n"
+      "   -p file          write the wire to a pcap file\n"
+      "   -c set           print one CSV row for the named option set\n"
+      "   -H               print the CSV header and exit\n",
+      appName, "both", l_cfg.durationMs, l_cfg.linkMbit, l_cfg.latencyUs,
+      BENCH_UDP_DEPTH_MAX, l_cfg.udpDepth, l_cfg.udpReqLen, l_cfg.udpRespLen,
+      l_cfg.udpThinkUs, l_cfg.logLineLen, l_cfg.logRate, BENCH_QUEUE_MAX,
+      l_cfg.logQueueLen, l_cfg.ackEvery, l_cfg.ackDelayMs
+   );
+}
+
+/* Exported functions --------------------------------------------------------*/
+/******************************************************************************/
+int main( int argc, char *argv[] )
+{
+   int opt;
+   while ( -1 != ( opt = getopt( argc, argv, "w:t:b:u:d:q:r:k:l:L:Q:Oa:A:p:c:Hh" ) ) ) {
+      switch ( opt ) {
+         case 'w':
+            if ( 0 == strcmp( optarg, "udp" ) ) {
+               l_cfg.workload = BENCH_UDP;
+            } else if ( 0 == strcmp( optarg, "tcp" ) ) {
+               l_cfg.workload = BENCH_TCP;
+            } else if ( 0 == strcmp( optarg, "both" ) ) {
+               l_cfg.workload = BENCH_BOTH;
+            } else {
+               BENCH_usage( argv[0] );
+               return 1;
+            }
+            break;
+         case 't': l_cfg.durationMs  = strtoul( optarg, NULL, 0 ); break;
+         case 'b': l_cfg.linkMbit    = strtoul( optarg, NULL, 0 ); break;
+         case 'u': l_cfg.latencyUs   = strtoul( optarg, NULL, 0 ); break;
+         case 'd': l_cfg.udpDepth    = strtoul( optarg, NULL, 0 ); break;
+         case 'q': l_cfg.udpReqLen   = strtoul( optarg, NULL, 0 ); break;
+         case 'r': l_cfg.udpRespLen  = strtoul( optarg, NULL, 0 ); break;
+         case 'k': l_cfg.udpThinkUs  = strtoul( optarg, NULL, 0 ); break;
+         case 'l': l_cfg.logLineLen  = strtoul( optarg, NULL, 0 ); break;
+         case 'L': l_cfg.logRate     = strtoul( optarg, NULL, 0 ); break;
+         case 'Q': l_cfg.logQueueLen = strtoul( optarg, NULL, 0 ); break;
+         case 'O': l_cfg.logOutput   = true;                       break;
+         case 'a': l_cfg.ackEvery    = strtoul( optarg, NULL, 0 ); break;
+         case 'A': l_cfg.ackDelayMs  = strtoul( optarg, NULL, 0 ); break;
+         case 'p': l_cfg.pcap        = optarg;                     break;
+         case 'c': l_cfg.csvSet      = optarg;                     break;
+         case 'H':
+            BENCH_csv( true );
+            return 0;
+         default:
+            BENCH_usage( argv[0] );
+            return ( 'h' == opt ) ? 0 : 1;
+      }
+   }
+
+   if ( l_cfg.udpDepth < 1 || l_cfg.udpDepth > BENCH_UDP_DEPTH_MAX
+         || l_cfg.udpRespLen < BENCH_TAG_LEN || l_cfg.udpRespLen > PEER_UDP_MAX
+         || l_cfg.logLineLen < BENCH_STAMP_LEN || l_cfg.logLineLen > TCP_SND_BUF
+         || l_cfg.logQueueLen < 1 || l_cfg.logQueueLen > BENCH_QUEUE_MAX
+         || l_cfg.linkMbit < 1 || l_cfg.durationMs < 1 ) {
+      fprintf( stderr, "Option out of range\n" );
+      BENCH_usage( argv[0] );
+      return 1;
+   }
+
+   lwip_init();
+   if ( !SIM_init( l_cfg.linkMbit, l_cfg.latencyUs, l_cfg.pcap ) ) {
+      fprintf( stderr, "Unable to open %s\n", l_cfg.pcap );
+      return 1;
+   }
+   PEER_init( BENCH_pcUdpRecv, BENCH_pcTcpRecv );
+   BENCH_boardInit();
+
+   if ( l_cfg.workload & BENCH_TCP ) {
+      PEER_tcpConnect( BENCH_LOG_PORT, l_cfg.ackEvery, l_cfg.ackDelayMs * 1000 );
+   }
+
+   uint64_t endUs  = l_cfg.durationMs * 1000ULL;
+   uint64_t tickUs = TCP_TMR_INTERVAL * 1000ULL;
+   while ( SIM_nowUs() < endUs ) {
+      if ( 0 == l_tcpUpUs && PEER_tcpIsConnected() ) {
+         l_tcpUpUs   = SIM_nowUs();
+         l_logNextUs = l_tcpUpUs;
+      }
+
+      /* Everything that's due by now, then on to the next thing due */
+      if ( l_cfg.workload & BENCH_UDP ) {
+         BENCH_pcUdpService( endUs );
+      }
+      BENCH_boardReply();
+      BENCH_boardLogGen( endUs );
+
+      uint64_t next = BENCH_MIN( SIM_nextDueUs(), PEER_nextDueUs() );
+      next = BENCH_MIN( next, BENCH_nextDueUs() );
+      next = BENCH_MIN( next, BENCH_MIN( tickUs, endUs ) );
+      if ( next <= SIM_nowUs() ) {
+         next = SIM_nowUs() + 1;
+      }
+      SIM_advance( next );
+
+      SIM_deliverDue();
+      PEER_service();
+      if ( SIM_nowUs() >= tickUs ) {
+         BENCH_boardTick();
+         tickUs += TCP_TMR_INTERVAL * 1000ULL;
+      }
+   }
+
+   if ( NULL != l_cfg.csvSet ) {
+      BENCH_csv( false );
+   } else {
+      BENCH_report();
+   }
+   SIM_close();
+   return 0;
+}
+
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/
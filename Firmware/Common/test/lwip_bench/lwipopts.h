@@ -0,0 +1,27 @@
+/**
+ * @file    lwipopts.h
+ * @brief   lwIP options for the host bench: the board's lwipopts.h plus the
+ * overrides of the option set being measured.
+ *
+ * The bench dir is searched before qpc_lwip_port so lwIP picks this file up in
+ * place of the board's.  bench_opts.h is written by the Makefile from OPTS and
+ * is empty for the options the board ships with.
+ *
+ * @date    10/19/2026
+ * @author  Harry Rostovtsev
+ * @email   rost0031@gmail.com
+ * Copyright (C) 2026 Harry Rostovtsev. All rights reserved.
+ */
+#ifndef LWIP_BENCH_OPTS_H_
+#define LWIP_BENCH_OPTS_H_
+
+#include "../../bsp/qpc_lwip_port/lwipopts.h"
+#include "bench_opts.h"
+
+/* The board doesn't pay for pool stats but they are what the bench reports.
+ * Only counters get added, none of the pools change size. */
+#undef  MEMP_STATS
+#define MEMP_STATS                        1
+
+#endif                                                  /* LWIP_BENCH_OPTS_H_ */
+/******** Copyright (C) 2026 Harry Rostovtsev. All rights reserved *****END OF FILE****/